@@ -6,7 +6,7 @@
 
 #import <Foundation/Foundation.h>
 
-@interface DownloadManager : NSObject <NSURLSessionDownloadDelegate>
+@interface DownloadManager : NSObject <NSURLSessionDownloadDelegate, NSURLSessionDataDelegate>
 
 @property (nonatomic, copy) void (^progressCallback)(int64_t totalBytesWritten, int64_t totalBytesExpectedToWrite);
 @property (nonatomic, copy) void (^completionCallback)(NSString *filePath, NSError *error);
@@ -14,9 +14,20 @@
 @property (nonatomic, assign) NSInteger retryCount;
 @property (nonatomic, copy) NSString *originalURLString;
 
+// Streaming mode: received bytes are handed over in order as they arrive, nothing touches disk
+@property (nonatomic, copy) void (^dataCallback)(NSData *data);
+@property (nonatomic, copy) void (^streamCompletionCallback)(NSError *error);
+
 - (void)startDownloadFromURL:(NSString *)urlString
              progressHandler:(void (^)(int64_t, int64_t))progressHandler
            completionHandler:(void (^)(NSString *, NSError *))completionHandler
              destinationPath:(NSString *)destinationPath;
 
+// Streams the response body to dataHandler (called serially, in order) instead of writing a file.
+// Retries only happen before the first byte arrives, so dataHandler never sees duplicated data.
+- (void)startStreamingFromURL:(NSString *)urlString
+              progressHandler:(void (^)(int64_t, int64_t))progressHandler
+                  dataHandler:(void (^)(NSData *data))dataHandler
+            completionHandler:(void (^)(NSError *error))completionHandler;
+
 @end
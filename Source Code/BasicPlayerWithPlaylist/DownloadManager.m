@@ -7,6 +7,8 @@
 
 @implementation DownloadManager {
     NSURLSession *_session;
+    int64_t _streamBytesReceived;
+    int64_t _streamBytesExpected;
 }
 
 - (instancetype)init {
@@ -38,28 +40,15 @@
     return self;
 }
 
-- (void)startDownloadFromURL:(NSString *)urlString
-             progressHandler:(void (^)(int64_t, int64_t))progressHandler
-           completionHandler:(void (^)(NSString *, NSError *))completionHandler
-             destinationPath:(NSString *)destinationPath {
-
-    self.progressCallback = progressHandler;
-    self.completionCallback = completionHandler;
-    self.destinationPath = destinationPath;
-    self.originalURLString = urlString; // Save for retry attempts
+// Builds the GET request shared by file downloads and streaming
+- (NSMutableURLRequest *)requestForURLString:(NSString *)urlString {
 
     // Create URL with proper encoding
     NSString *escapedUrlString = [urlString stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLQueryAllowedCharacterSet]];
     NSURL *url = [NSURL URLWithString:escapedUrlString];
     
     if (!url) {
-        NSError *error = [NSError errorWithDomain:@"DownloadManagerErrorDomain" 
-                                            code:1001 
-                                        userInfo:@{NSLocalizedDescriptionKey: @"Invalid URL format"}];
-        if (self.completionCallback) {
-            self.completionCallback(nil, error);
-        }
-        return;
+        return nil;
     }
     
     // Create request with custom headers for better compatibility
@@ -88,6 +77,30 @@
     NSLog(@"Starting download with timeout: %.1f seconds", [request timeoutInterval]);
     NSLog(@"URL: %@", url.absoluteString);
     
+    return request;
+}
+
+- (void)startDownloadFromURL:(NSString *)urlString
+             progressHandler:(void (^)(int64_t, int64_t))progressHandler
+           completionHandler:(void (^)(NSString *, NSError *))completionHandler
+             destinationPath:(NSString *)destinationPath {
+
+    self.progressCallback = progressHandler;
+    self.completionCallback = completionHandler;
+    self.destinationPath = destinationPath;
+    self.originalURLString = urlString; // Save for retry attempts
+
+    NSMutableURLRequest *request = [self requestForURLString:urlString];
+    if (!request) {
+        NSError *error = [NSError errorWithDomain:@"DownloadManagerErrorDomain" 
+                                            code:1001 
+                                        userInfo:@{NSLocalizedDescriptionKey: @"Invalid URL format"}];
+        if (self.completionCallback) {
+            self.completionCallback(nil, error);
+        }
+        return;
+    }
+    
     // Create download task with our custom request
     NSURLSessionDownloadTask *downloadTask = [_session downloadTaskWithRequest:request];
     
@@ -101,6 +114,36 @@
     [downloadTask resume];
 }
 
+- (void)startStreamingFromURL:(NSString *)urlString
+              progressHandler:(void (^)(int64_t, int64_t))progressHandler
+                  dataHandler:(void (^)(NSData *data))dataHandler
+            completionHandler:(void (^)(NSError *error))completionHandler {
+
+    self.progressCallback = progressHandler;
+    self.dataCallback = dataHandler;
+    self.streamCompletionCallback = completionHandler;
+    self.originalURLString = urlString; // Save for retry attempts
+    _streamBytesReceived = 0;
+    _streamBytesExpected = NSURLResponseUnknownLength;
+
+    NSMutableURLRequest *request = [self requestForURLString:urlString];
+    if (!request) {
+        NSError *error = [NSError errorWithDomain:@"DownloadManagerErrorDomain" 
+                                            code:1001 
+                                        userInfo:@{NSLocalizedDescriptionKey: @"Invalid URL format"}];
+        if (self.streamCompletionCallback) {
+            self.streamCompletionCallback(error);
+        }
+        return;
+    }
+    
+    // Data task delivers the body in memory as it arrives
+    NSURLSessionDataTask *dataTask = [_session dataTaskWithRequest:request];
+    [dataTask setTaskDescription:@"M3U Playlist Stream"];
+    [dataTask setPriority:NSURLSessionTaskPriorityHigh];
+    [dataTask resume];
+}
+
 // Progress callback
 - (void)URLSession:(NSURLSession *)session
       downloadTask:(NSURLSessionDownloadTask *)downloadTask
@@ -129,11 +172,46 @@ didFinishDownloadingToURL:(NSURL *)location {
     }
 }
 
+#pragma mark - Streaming (data task) callbacks
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+
+    _streamBytesExpected = response.expectedContentLength;
+    completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveData:(NSData *)data {
+
+    // The delegate queue is serial, so chunks reach dataCallback in order
+    _streamBytesReceived += data.length;
+    if (self.dataCallback) {
+        self.dataCallback(data);
+    }
+    if (self.progressCallback) {
+        self.progressCallback(_streamBytesReceived, _streamBytesExpected);
+    }
+}
+
 // Handle task completion with possible error
 - (void)URLSession:(NSURLSession *)session 
               task:(NSURLSessionTask *)task 
 didCompleteWithError:(NSError *)error {
     
+    BOOL isStream = [task isKindOfClass:[NSURLSessionDataTask class]];
+    
+    if (isStream && !error) {
+        NSLog(@"Stream finished: %lld bytes", _streamBytesReceived);
+        if (self.streamCompletionCallback) {
+            self.streamCompletionCallback(nil);
+        }
+        return;
+    }
+    
     if (error) {
         NSLog(@"Download task error: %@ (code: %ld, domain: %@)", 
              [error localizedDescription], (long)error.code, error.domain);
@@ -171,6 +249,11 @@ didCompleteWithError:(NSError *)error {
             shouldRetry = YES;
         }
         
+        // A stream that already delivered bytes cannot be restarted without duplicating them
+        if (isStream && task.countOfBytesReceived > 0) {
+            shouldRetry = NO;
+        }
+        
         if (shouldRetry && self.retryCount < MAX_RETRY_COUNT && self.originalURLString) {
             // Calculate backoff time: 2^retry_count seconds (exponential backoff)
             // First retry: 2 seconds, second: 4 seconds, third: 8 seconds, fourth: 16 seconds, fifth: 32 seconds
@@ -185,11 +268,19 @@ didCompleteWithError:(NSError *)error {
             // Retry after delay
             dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), 
                           dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-                // Create a new download task
-                [self startDownloadFromURL:self.originalURLString
-                          progressHandler:self.progressCallback
-                        completionHandler:self.completionCallback
-                          destinationPath:self.destinationPath];
+                if (isStream) {
+                    // Create a new data task
+                    [self startStreamingFromURL:self.originalURLString
+                                progressHandler:self.progressCallback
+                                    dataHandler:self.dataCallback
+                              completionHandler:self.streamCompletionCallback];
+                } else {
+                    // Create a new download task
+                    [self startDownloadFromURL:self.originalURLString
+                              progressHandler:self.progressCallback
+                            completionHandler:self.completionCallback
+                              destinationPath:self.destinationPath];
+                }
             });
             
             // Don't call completion yet since we're retrying
@@ -197,7 +288,13 @@ didCompleteWithError:(NSError *)error {
         }
         
         // If we're not retrying or out of retries, call completion with error
-        if (self.completionCallback) {
+        if (isStream) {
+            NSLog(@"Stream failed with error: %@ (code: %ld) after %lld bytes", 
+                 [error localizedDescription], (long)error.code, _streamBytesReceived);
+            if (self.streamCompletionCallback) {
+                self.streamCompletionCallback(error);
+            }
+        } else if (self.completionCallback) {
             // Only call completion with error if the completion wasn't already called in didFinishDownloadingToURL
             if ([task isKindOfClass:[NSURLSessionDownloadTask class]]) {
                 NSURLSessionDownloadTask *downloadTask = (NSURLSessionDownloadTask *)task;
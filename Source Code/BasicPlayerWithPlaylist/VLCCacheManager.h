@@ -23,6 +23,13 @@ typedef NS_ENUM(NSInteger, VLCCacheType) {
 // Cache completion blocks
 typedef void (^VLCCacheCompletion)(BOOL success, NSError * _Nullable error);
 typedef void (^VLCCacheLoadCompletion)(id _Nullable data, BOOL success, NSError * _Nullable error);
+// displayNames maps guide channel ids to their XMLTV display names; nil for caches without them
+typedef void (^VLCEPGCacheLoadCompletion)(NSDictionary * _Nullable epgData, NSDictionary * _Nullable displayNames,
+                                          BOOL success, NSError * _Nullable error);
+
+// Cache keys starting with this prefix get a cache file of their own (one per playlist source);
+// any other key maps to the default cache file
+extern NSString * const VLCCacheSourceKeyPrefix;
 
 @interface VLCCacheManager : NSObject
 
@@ -44,13 +51,46 @@ typedef void (^VLCCacheLoadCompletion)(id _Nullable data, BOOL success, NSError
 - (void)loadChannelsFromCache:(NSString *)sourceURL
                    completion:(VLCCacheLoadCompletion)completion;
 
+// Expired caches are still a valid base for a delta refresh
+- (void)loadChannelsFromCache:(NSString *)sourceURL
+                 allowExpired:(BOOL)allowExpired
+                   completion:(VLCCacheLoadCompletion)completion;
+
+// Sources with their own refresh schedule decide how old their cache may be
+- (void)loadChannelsFromCache:(NSString *)sourceURL
+                validityHours:(NSTimeInterval)validityHours
+                   completion:(VLCCacheLoadCompletion)completion;
+
+// Rewrites the channel cache re-serializing only changedChannels; unchanged entries
+// reuse their stored dictionaries (matched by entryIdentity)
+- (void)updateChannelCache:(NSArray<VLCChannel *> *)channels
+           changedChannels:(NSArray<VLCChannel *> *)changedChannels
+                 sourceURL:(NSString *)sourceURL
+                completion:(VLCCacheCompletion _Nullable)completion;
+
 - (void)saveEPGToCache:(NSDictionary *)epgData
              sourceURL:(NSString *)sourceURL
             completion:(VLCCacheCompletion _Nullable)completion;
 
+// Keeps the guide channels' display names next to the programmes, so matching by tvg-name and
+// by fuzzy name still works after the guide comes from the cache
+- (void)saveEPGToCache:(NSDictionary *)epgData
+          displayNames:(NSDictionary * _Nullable)displayNames
+             sourceURL:(NSString *)sourceURL
+            completion:(VLCCacheCompletion _Nullable)completion;
+
 - (void)loadEPGFromCache:(NSString *)sourceURL
               completion:(VLCCacheLoadCompletion)completion;
 
+// Guide sources with their own refresh schedule decide how old their cache may be
+- (void)loadEPGFromCache:(NSString *)sourceURL
+           validityHours:(NSTimeInterval)validityHours
+              completion:(VLCCacheLoadCompletion)completion;
+
+- (void)loadEPGAndDisplayNamesFromCache:(NSString *)sourceURL
+                          validityHours:(NSTimeInterval)validityHours
+                             completion:(VLCEPGCacheLoadCompletion)completion;
+
 // Cache validation
 - (BOOL)isChannelCacheValid:(NSString *)sourceURL;
 - (BOOL)isEPGCacheValid:(NSString *)sourceURL;
@@ -8,6 +8,15 @@
 
 #import "VLCCacheManager.h"
 #import "VLCChannel.h"
+#import "VLCChannelStore.h"
+
+// 1.4: URLs are stored as an index into "urlPrefixes" plus a suffix
+static NSString * const VLCChannelCacheVersion = @"1.4";
+
+// 1.1: "displayNames" keeps each guide channel's display names
+static NSString * const VLCEPGCacheVersion = @"1.1";
+
+NSString * const VLCCacheSourceKeyPrefix = @"source:";
 
 #if TARGET_OS_IOS || TARGET_OS_TV
 #import <CommonCrypto/CommonDigest.h>
@@ -127,21 +136,24 @@
         
         // Create cache dictionary
         NSMutableDictionary *cacheDict = [[NSMutableDictionary alloc] init];
-        [cacheDict setObject:@"1.2" forKey:@"cacheVersion"];
+        [cacheDict setObject:VLCChannelCacheVersion forKey:@"cacheVersion"];
         [cacheDict setObject:[NSDate date] forKey:@"cacheDate"];
         [cacheDict setObject:(sourceURL ?: @"") forKey:@"sourceURL"];
         
-        // Serialize channels efficiently
+        // Serialize channels efficiently; URLs share their prefixes through the encoder
         NSMutableArray *serializedChannels = [[NSMutableArray alloc] initWithCapacity:channels.count];
+        VLCURLPrefixEncoder *urlEncoder = [[VLCURLPrefixEncoder alloc] init];
         
         for (VLCChannel *channel in channels) {
             @autoreleasepool {
-                NSDictionary *serializedChannel = [self serializeChannel:channel];
+                NSDictionary *serializedChannel = [self serializeChannel:channel urlEncoder:urlEncoder];
                 [serializedChannels addObject:serializedChannel];
             }
         }
         
         [cacheDict setObject:serializedChannels forKey:@"channels"];
+        [cacheDict setObject:urlEncoder.prefixes forKey:@"urlPrefixes"];
+        [urlEncoder release];
         
         // Write to cache file
         NSString *cacheFilePath = [self cacheFilePathForType:VLCCacheTypeChannels sourceURL:sourceURL];
@@ -149,7 +161,7 @@
         // SAFETY: Ensure directory exists before writing (in case background creation hasn't completed)
         [self createDirectoryIfNeeded:self.channelCacheDirectory];
         
-        BOOL success = [cacheDict writeToFile:cacheFilePath atomically:YES];
+        BOOL success = [self writeChannelCache:cacheDict toFile:cacheFilePath];
         
         if (success) {
             NSLog(@"✅ [CACHE] Successfully saved channels cache to %@", cacheFilePath);
@@ -168,15 +180,132 @@
     }
 }
 
+- (void)updateChannelCache:(NSArray<VLCChannel *> *)channels
+           changedChannels:(NSArray<VLCChannel *> *)changedChannels
+                 sourceURL:(NSString *)sourceURL
+                completion:(VLCCacheCompletion)completion {
+    
+    if (!channels || channels.count == 0) {
+        [self saveChannelsToCache:channels sourceURL:sourceURL completion:completion];
+        return;
+    }
+    
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [self performChannelCacheUpdate:channels changedChannels:changedChannels sourceURL:sourceURL completion:completion];
+    });
+}
+
+- (void)performChannelCacheUpdate:(NSArray<VLCChannel *> *)channels
+                  changedChannels:(NSArray<VLCChannel *> *)changedChannels
+                        sourceURL:(NSString *)sourceURL
+                       completion:(VLCCacheCompletion)completion {
+    
+    @autoreleasepool {
+        NSString *cacheFilePath = [self cacheFilePathForType:VLCCacheTypeChannels sourceURL:sourceURL];
+        NSDictionary *existingCache = [NSDictionary dictionaryWithContentsOfFile:cacheFilePath];
+        NSArray *existingChannels = [existingCache objectForKey:@"channels"];
+        
+        if (![[existingCache objectForKey:@"cacheVersion"] isEqualToString:VLCChannelCacheVersion] || !existingChannels) {
+            NSLog(@"💾 [CACHE] No reusable channel cache - writing a full cache");
+            [self performChannelCacheSave:channels sourceURL:sourceURL completion:completion];
+            return;
+        }
+        
+        // Reuse the stored dictionaries of unchanged entries, keyed by entry identity
+        NSMutableDictionary<NSNumber *, NSDictionary *> *existingByIdentity = [[NSMutableDictionary alloc] initWithCapacity:existingChannels.count];
+        for (NSDictionary *serializedChannel in existingChannels) {
+            NSNumber *identity = [serializedChannel objectForKey:@"entryIdentity"];
+            if (identity && [identity longLongValue] != 0) {
+                [existingByIdentity setObject:serializedChannel forKey:identity];
+            }
+        }
+        
+        NSMutableSet<NSNumber *> *changedIdentities = [[NSMutableSet alloc] initWithCapacity:changedChannels.count];
+        for (VLCChannel *channel in changedChannels) {
+            [changedIdentities addObject:@((long long)channel.entryIdentity)];
+        }
+        
+        NSMutableArray *serializedChannels = [[NSMutableArray alloc] initWithCapacity:channels.count];
+        NSUInteger reusedCount = 0;
+        
+        // Reused dictionaries point into the stored prefix list, so new prefixes are appended to it
+        VLCURLPrefixEncoder *urlEncoder = [[VLCURLPrefixEncoder alloc] initWithPrefixes:[existingCache objectForKey:@"urlPrefixes"]];
+        
+        for (VLCChannel *channel in channels) {
+            @autoreleasepool {
+                NSNumber *identity = @((long long)channel.entryIdentity);
+                NSDictionary *serializedChannel = nil;
+                if (channel.entryIdentity != 0 && ![changedIdentities containsObject:identity]) {
+                    serializedChannel = [existingByIdentity objectForKey:identity];
+                }
+                if (serializedChannel) {
+                    reusedCount++;
+                } else {
+                    serializedChannel = [self serializeChannel:channel urlEncoder:urlEncoder];
+                }
+                [serializedChannels addObject:serializedChannel];
+            }
+        }
+        
+        NSMutableDictionary *cacheDict = [[NSMutableDictionary alloc] init];
+        [cacheDict setObject:VLCChannelCacheVersion forKey:@"cacheVersion"];
+        [cacheDict setObject:[NSDate date] forKey:@"cacheDate"];
+        [cacheDict setObject:(sourceURL ?: @"") forKey:@"sourceURL"];
+        [cacheDict setObject:serializedChannels forKey:@"channels"];
+        [cacheDict setObject:urlEncoder.prefixes forKey:@"urlPrefixes"];
+        [urlEncoder release];
+        
+        [self createDirectoryIfNeeded:self.channelCacheDirectory];
+        BOOL success = [self writeChannelCache:cacheDict toFile:cacheFilePath];
+        
+        if (success) {
+            NSLog(@"✅ [CACHE] Updated channels cache: %lu reused, %lu serialized", 
+                  (unsigned long)reusedCount, (unsigned long)(channels.count - reusedCount));
+            [self updateCacheSizes];
+        } else {
+            NSLog(@"❌ [CACHE] Failed to update channels cache");
+        }
+        
+        [existingByIdentity release];
+        [changedIdentities release];
+        [serializedChannels release];
+        [cacheDict release];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completion) {
+                completion(success, success ? nil : [NSError errorWithDomain:@"VLCCacheManager" 
+                                                                        code:3002 
+                                                                    userInfo:@{NSLocalizedDescriptionKey: @"Failed to write cache file"}]);
+            }
+        });
+    }
+}
+
+- (void)loadChannelsFromCache:(NSString *)sourceURL
+                   completion:(VLCCacheLoadCompletion)completion {
+    [self loadChannelsFromCache:sourceURL allowExpired:NO completion:completion];
+}
+
 - (void)loadChannelsFromCache:(NSString *)sourceURL
+                 allowExpired:(BOOL)allowExpired
+                   completion:(VLCCacheLoadCompletion)completion {
+    
+    [self loadChannelsFromCache:sourceURL
+                  validityHours:(allowExpired ? DBL_MAX : self.channelCacheValidityHours)
+                     completion:completion];
+}
+
+- (void)loadChannelsFromCache:(NSString *)sourceURL
+                validityHours:(NSTimeInterval)validityHours
                    completion:(VLCCacheLoadCompletion)completion {
     
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        [self performChannelCacheLoad:sourceURL completion:completion];
+        [self performChannelCacheLoad:sourceURL validityHours:validityHours completion:completion];
     });
 }
 
 - (void)performChannelCacheLoad:(NSString *)sourceURL
+                  validityHours:(NSTimeInterval)validityHours
                      completion:(VLCCacheLoadCompletion)completion {
     
     @autoreleasepool {
@@ -195,7 +324,7 @@
         }
         
         // Check cache validity
-        if (![self isChannelCacheValid:sourceURL]) {
+        if (validityHours < DBL_MAX && ![self isChannelCacheValid:sourceURL validityHours:validityHours]) {
             NSLog(@"💾 [CACHE] Channel cache is expired");
             dispatch_async(dispatch_get_main_queue(), ^{
                 if (completion) {
@@ -255,11 +384,13 @@
         NSLog(@"🚀 [CACHE-PERF] Starting deserialization of %lu channels", (unsigned long)serializedChannels.count);
         
         NSMutableArray *channels = [[NSMutableArray alloc] initWithCapacity:serializedChannels.count];
+        VLCChannelStore *store = [[VLCChannelStore alloc] init];
+        VLCURLPrefixEncoder *urlEncoder = [[VLCURLPrefixEncoder alloc] initWithPrefixes:[cacheDict objectForKey:@"urlPrefixes"]];
         
         NSUInteger processedCount = 0;
         for (NSDictionary *serializedChannel in serializedChannels) {
             @autoreleasepool {
-                VLCChannel *channel = [self deserializeChannel:serializedChannel];
+                VLCChannel *channel = [self deserializeChannel:serializedChannel intoStore:store urlEncoder:urlEncoder];
                 if (channel) {
                     [channels addObject:channel];
                 }
@@ -277,6 +408,15 @@
         NSLog(@"🚀 [CACHE-PERF] Deserialization completed in %.3f seconds (%.1f channels/sec)", 
               deserializeTime, serializedChannels.count / deserializeTime);
         
+        // Channels keep the store alive
+        [store finishAppending];
+        NSLog(@"🚀 [CACHE-PERF] Channel store: %.1f MB for %lu channels (%.0f bytes/channel + facades), %lu URL prefixes sharing %.1f MB",
+              store.bytesAllocated / 1024.0 / 1024.0, (unsigned long)channels.count,
+              channels.count > 0 ? (double)store.bytesAllocated / channels.count : 0.0,
+              (unsigned long)store.urlPrefixCount, store.urlBytesShared / 1024.0 / 1024.0);
+        [store release];
+        [urlEncoder release];
+        
         NSLog(@"✅ [CACHE] Successfully loaded %lu channels from cache", (unsigned long)channels.count);
         
         dispatch_async(dispatch_get_main_queue(), ^{
@@ -290,6 +430,13 @@
 - (void)saveEPGToCache:(NSDictionary *)epgData
              sourceURL:(NSString *)sourceURL
             completion:(VLCCacheCompletion)completion {
+    [self saveEPGToCache:epgData displayNames:nil sourceURL:sourceURL completion:completion];
+}
+
+- (void)saveEPGToCache:(NSDictionary *)epgData
+          displayNames:(NSDictionary *)displayNames
+             sourceURL:(NSString *)sourceURL
+            completion:(VLCCacheCompletion)completion {
     
     if (!epgData || epgData.count == 0) {
         NSLog(@"⚠️ [CACHE] No EPG data to save");
@@ -302,11 +449,12 @@
     }
     
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        [self performEPGCacheSave:epgData sourceURL:sourceURL completion:completion];
+        [self performEPGCacheSave:epgData displayNames:displayNames sourceURL:sourceURL completion:completion];
     });
 }
 
 - (void)performEPGCacheSave:(NSDictionary *)epgData
+               displayNames:(NSDictionary *)displayNames
                   sourceURL:(NSString *)sourceURL
                  completion:(VLCCacheCompletion)completion {
     
@@ -315,7 +463,7 @@
         
         // Create cache dictionary
         NSMutableDictionary *cacheDict = [[NSMutableDictionary alloc] init];
-        [cacheDict setObject:@"1.0" forKey:@"epgCacheVersion"];
+        [cacheDict setObject:VLCEPGCacheVersion forKey:@"epgCacheVersion"];
         [cacheDict setObject:[NSDate date] forKey:@"epgCacheDate"];
         [cacheDict setObject:(sourceURL ?: @"") forKey:@"sourceURL"];
         
@@ -344,6 +492,17 @@
         
         [cacheDict setObject:serializedEPGData forKey:@"epgData"];
         
+        // Only arrays of strings go into the property list
+        NSMutableDictionary *serializedNames = [[NSMutableDictionary alloc] initWithCapacity:displayNames.count];
+        for (NSString *channelId in displayNames) {
+            NSArray *names = [displayNames objectForKey:channelId];
+            if ([channelId isKindOfClass:[NSString class]] && [names isKindOfClass:[NSArray class]] && names.count > 0) {
+                [serializedNames setObject:[[names copy] autorelease] forKey:channelId];
+            }
+        }
+        [cacheDict setObject:serializedNames forKey:@"displayNames"];
+        [serializedNames release];
+        
         // Write to cache file  
         NSString *cacheFilePath = [self cacheFilePathForType:VLCCacheTypeEPG sourceURL:sourceURL];
         
@@ -372,14 +531,32 @@
 
 - (void)loadEPGFromCache:(NSString *)sourceURL
               completion:(VLCCacheLoadCompletion)completion {
+    [self loadEPGFromCache:sourceURL validityHours:self.epgCacheValidityHours completion:completion];
+}
+
+- (void)loadEPGFromCache:(NSString *)sourceURL
+           validityHours:(NSTimeInterval)validityHours
+              completion:(VLCCacheLoadCompletion)completion {
+    [self loadEPGAndDisplayNamesFromCache:sourceURL validityHours:validityHours
+                               completion:^(NSDictionary *epgData, NSDictionary *displayNames, BOOL success, NSError *error) {
+        if (completion) {
+            completion(epgData, success, error);
+        }
+    }];
+}
+
+- (void)loadEPGAndDisplayNamesFromCache:(NSString *)sourceURL
+                          validityHours:(NSTimeInterval)validityHours
+                             completion:(VLCEPGCacheLoadCompletion)completion {
     
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        [self performEPGCacheLoad:sourceURL completion:completion];
+        [self performEPGCacheLoad:sourceURL validityHours:validityHours completion:completion];
     });
 }
 
 - (void)performEPGCacheLoad:(NSString *)sourceURL
-                 completion:(VLCCacheLoadCompletion)completion {
+              validityHours:(NSTimeInterval)validityHours
+                 completion:(VLCEPGCacheLoadCompletion)completion {
     
     @autoreleasepool {
         NSString *cacheFilePath = [self cacheFilePathForType:VLCCacheTypeEPG sourceURL:sourceURL];
@@ -395,7 +572,7 @@
             
             dispatch_async(dispatch_get_main_queue(), ^{
                 if (completion) {
-                    completion(nil, NO, [NSError errorWithDomain:@"VLCCacheManager" 
+                    completion(nil, nil, NO, [NSError errorWithDomain:@"VLCCacheManager" 
                                                             code:3009 
                                                         userInfo:@{NSLocalizedDescriptionKey: @"EPG cache file not found"}]);
                 }
@@ -404,16 +581,15 @@
         }
         
         // Check cache validity
-        if (![self isEPGCacheValid:sourceURL]) {
+        if (![self isEPGCacheValid:sourceURL validityHours:validityHours]) {
             NSDate *cacheDate = [self cacheDate:VLCCacheTypeEPG sourceURL:sourceURL];
             NSTimeInterval timeSinceCache = cacheDate ? [[NSDate date] timeIntervalSinceDate:cacheDate] : -1;
-            NSTimeInterval validityHours = self.epgCacheValidityHours;
             
             NSLog(@"💾 [CACHE] EPG cache is expired - Cache date: %@, Hours since cache: %.1f, Validity: %.1f hours", 
                   cacheDate, timeSinceCache / 3600.0, validityHours);
             dispatch_async(dispatch_get_main_queue(), ^{
                 if (completion) {
-                    completion(nil, NO, [NSError errorWithDomain:@"VLCCacheManager" 
+                    completion(nil, nil, NO, [NSError errorWithDomain:@"VLCCacheManager" 
                                                             code:3010 
                                                         userInfo:@{NSLocalizedDescriptionKey: @"EPG cache is expired"}]);
                 }
@@ -427,7 +603,7 @@
             NSLog(@"❌ [CACHE] Failed to load EPG cache from %@", cacheFilePath);
             dispatch_async(dispatch_get_main_queue(), ^{
                 if (completion) {
-                    completion(nil, NO, [NSError errorWithDomain:@"VLCCacheManager" 
+                    completion(nil, nil, NO, [NSError errorWithDomain:@"VLCCacheManager" 
                                                             code:3011 
                                                         userInfo:@{NSLocalizedDescriptionKey: @"Failed to read EPG cache file"}]);
                 }
@@ -441,7 +617,7 @@
             NSLog(@"❌ [CACHE] No EPG data in cache");
             dispatch_async(dispatch_get_main_queue(), ^{
                 if (completion) {
-                    completion(nil, NO, [NSError errorWithDomain:@"VLCCacheManager" 
+                    completion(nil, nil, NO, [NSError errorWithDomain:@"VLCCacheManager" 
                                                             code:3012 
                                                         userInfo:@{NSLocalizedDescriptionKey: @"No EPG data in cache"}]);
                 }
@@ -449,11 +625,18 @@
             return;
         }
         
-        NSLog(@"✅ [CACHE] Successfully loaded EPG data from cache (%lu channels)", (unsigned long)epgData.count);
+        // Caches older than 1.1 have no display names
+        NSDictionary *displayNames = nil;
+        if ([[cacheDict objectForKey:@"epgCacheVersion"] isEqualToString:VLCEPGCacheVersion]) {
+            displayNames = [cacheDict objectForKey:@"displayNames"];
+        }
+        
+        NSLog(@"✅ [CACHE] Successfully loaded EPG data from cache (%lu channels, %lu with display names)",
+              (unsigned long)epgData.count, (unsigned long)displayNames.count);
         
         dispatch_async(dispatch_get_main_queue(), ^{
             if (completion) {
-                completion(epgData, YES, nil);
+                completion(epgData, displayNames, YES, nil);
             }
         });
     }
@@ -462,21 +645,29 @@
 #pragma mark - Cache Validation
 
 - (BOOL)isChannelCacheValid:(NSString *)sourceURL {
+    return [self isChannelCacheValid:sourceURL validityHours:self.channelCacheValidityHours];
+}
+
+- (BOOL)isChannelCacheValid:(NSString *)sourceURL validityHours:(NSTimeInterval)validityHours {
     NSDate *cacheDate = [self cacheDate:VLCCacheTypeChannels sourceURL:sourceURL];
     if (!cacheDate) return NO;
     
     NSTimeInterval timeSinceCache = [[NSDate date] timeIntervalSinceDate:cacheDate];
-    NSTimeInterval validitySeconds = self.channelCacheValidityHours * 3600.0;
+    NSTimeInterval validitySeconds = validityHours * 3600.0;
     
     return timeSinceCache <= validitySeconds;
 }
 
 - (BOOL)isEPGCacheValid:(NSString *)sourceURL {
+    return [self isEPGCacheValid:sourceURL validityHours:self.epgCacheValidityHours];
+}
+
+- (BOOL)isEPGCacheValid:(NSString *)sourceURL validityHours:(NSTimeInterval)validityHours {
     NSDate *cacheDate = [self cacheDate:VLCCacheTypeEPG sourceURL:sourceURL];
     if (!cacheDate) return NO;
     
     NSTimeInterval timeSinceCache = [[NSDate date] timeIntervalSinceDate:cacheDate];
-    NSTimeInterval validitySeconds = self.epgCacheValidityHours * 3600.0;
+    NSTimeInterval validitySeconds = validityHours * 3600.0;
     
     return timeSinceCache <= validitySeconds;
 }
@@ -536,6 +727,11 @@
 }
 
 - (NSString *)sanitizedCacheFileName:(NSString *)sourceURL {
+    // Additional playlist sources each get their own file, named by a hash of their URL
+    if ([sourceURL hasPrefix:VLCCacheSourceKeyPrefix]) {
+        return [NSString stringWithFormat:@"source_%@", [self md5HashForString:[sourceURL substringFromIndex:VLCCacheSourceKeyPrefix.length]]];
+    }
+    
     // Always use "default" for consistency with existing cache files
     // This ensures cache files are found regardless of URL complexity
     return @"default";
@@ -753,16 +949,33 @@
 
 #pragma mark - Serialization
 
-- (NSDictionary *)serializeChannel:(VLCChannel *)channel {
+// Binary plists store each distinct string and number once, which keeps the repeated
+// keys, groups and URL prefix indexes of a large playlist out of the file
+- (BOOL)writeChannelCache:(NSDictionary *)cacheDict toFile:(NSString *)filePath {
+    NSError *error = nil;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:cacheDict
+                                                              format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0
+                                                               error:&error];
+    if (!data) {
+        NSLog(@"❌ [CACHE] Failed to serialize channels cache: %@", error.localizedDescription);
+        return NO;
+    }
+    NSLog(@"💾 [CACHE] Channels cache is %.1f MB", data.length / 1024.0 / 1024.0);
+    return [data writeToFile:filePath atomically:YES];
+}
+
+- (NSDictionary *)serializeChannel:(VLCChannel *)channel urlEncoder:(VLCURLPrefixEncoder *)urlEncoder {
     if (!channel) return nil;
     
     NSMutableDictionary *dict = [[NSMutableDictionary alloc] init];
     
     if (channel.name) [dict setObject:channel.name forKey:@"name"];
-    if (channel.url) [dict setObject:channel.url forKey:@"url"];
+    [urlEncoder setURL:channel.url inDictionary:dict];
     if (channel.group) [dict setObject:channel.group forKey:@"group"];
     if (channel.logo) [dict setObject:channel.logo forKey:@"logo"];
     if (channel.channelId) [dict setObject:channel.channelId forKey:@"channelId"];
+    if (channel.tvgName) [dict setObject:channel.tvgName forKey:@"tvgName"];
     if (channel.category) [dict setObject:channel.category forKey:@"category"];
     
     // Timeshift properties
@@ -771,31 +984,48 @@
     if (channel.catchupSource) [dict setObject:channel.catchupSource forKey:@"catchupSource"];
     if (channel.catchupTemplate) [dict setObject:channel.catchupTemplate forKey:@"catchupTemplate"];
     
-    return dict;
+    // Delta refresh fingerprints, stored signed so every plist reader round-trips all 64 bits
+    if (channel.entryFingerprint) [dict setObject:@((long long)channel.entryFingerprint) forKey:@"entryFingerprint"];
+    if (channel.entryIdentity) [dict setObject:@((long long)channel.entryIdentity) forKey:@"entryIdentity"];
+    
+    return [dict autorelease];
+}
+
+// Span over a string's UTF-8 bytes; valid while the current autorelease pool lives
+static VLCM3USpan VLCCacheSpanFromString(id value) {
+    VLCM3USpan span = { NULL, 0 };
+    if ([value isKindOfClass:[NSString class]]) {
+        span.bytes = [(NSString *)value UTF8String];
+        span.length = span.bytes ? strlen(span.bytes) : 0;
+    }
+    return span;
 }
 
-- (VLCChannel *)deserializeChannel:(NSDictionary *)dict {
+- (VLCChannel *)deserializeChannel:(NSDictionary *)dict intoStore:(VLCChannelStore *)store urlEncoder:(VLCURLPrefixEncoder *)urlEncoder {
     if (!dict) return nil;
     
-    VLCChannel *channel = [[VLCChannel alloc] init];
-    
-    channel.name = [dict objectForKey:@"name"];
-    channel.url = [dict objectForKey:@"url"];
-    channel.group = [dict objectForKey:@"group"];
-    channel.logo = [dict objectForKey:@"logo"];
-    channel.channelId = [dict objectForKey:@"channelId"];
-    channel.category = [dict objectForKey:@"category"];
+    VLCChannelStoreRow row;
+    memset(&row, 0, sizeof(row));
+    row.strings[VLCChannelStoreFieldName] = VLCCacheSpanFromString([dict objectForKey:@"name"]);
+    row.strings[VLCChannelStoreFieldURL] = VLCCacheSpanFromString([urlEncoder URLFromDictionary:dict]);
+    row.strings[VLCChannelStoreFieldLogo] = VLCCacheSpanFromString([dict objectForKey:@"logo"]);
+    row.strings[VLCChannelStoreFieldChannelId] = VLCCacheSpanFromString([dict objectForKey:@"channelId"]);
+    row.strings[VLCChannelStoreFieldTvgName] = VLCCacheSpanFromString([dict objectForKey:@"tvgName"]);
+    row.group = [dict objectForKey:@"group"];
+    row.category = [dict objectForKey:@"category"];
     
     // Timeshift properties
-    channel.supportsCatchup = [[dict objectForKey:@"supportsCatchup"] boolValue];
-    channel.catchupDays = [[dict objectForKey:@"catchupDays"] integerValue];
-    channel.catchupSource = [dict objectForKey:@"catchupSource"];
-    channel.catchupTemplate = [dict objectForKey:@"catchupTemplate"];
+    row.supportsCatchup = [[dict objectForKey:@"supportsCatchup"] boolValue];
+    row.catchupDays = [[dict objectForKey:@"catchupDays"] integerValue];
+    row.strings[VLCChannelStoreFieldCatchupSource] = VLCCacheSpanFromString([dict objectForKey:@"catchupSource"]);
+    row.strings[VLCChannelStoreFieldCatchupTemplate] = VLCCacheSpanFromString([dict objectForKey:@"catchupTemplate"]);
     
-    // Initialize programs array
-    channel.programs = [[NSMutableArray alloc] init];
+    // Delta refresh fingerprints (absent in caches written before 1.3)
+    row.entryFingerprint = (uint64_t)[[dict objectForKey:@"entryFingerprint"] longLongValue];
+    row.entryIdentity = (uint64_t)[[dict objectForKey:@"entryIdentity"] longLongValue];
     
-    return channel;
+    // Programs are attached later by EPG matching; facades start without an array
+    return [store appendRow:&row];
 }
 
 - (NSDictionary *)serializeProgram:(id)program {
@@ -2,15 +2,22 @@
 #import "PlatformBridge.h"
 
 @class VLCProgram;
+@class VLCChannelStore;
 
+// Channels parsed from a playlist are facades over a VLCChannelStore row: playlist fields are
+// read from the store on access and writes go back to the row. Channels created with -init
+// keep their own fields. Either way `programs` stays nil until EPG data is attached.
 @interface VLCChannel : NSObject
 
+- (instancetype)initWithStore:(VLCChannelStore *)store row:(uint32_t)row;
+
 @property (nonatomic, retain) NSString *name;
 @property (nonatomic, retain) NSString *url;
 @property (nonatomic, retain) NSString *group;
 @property (nonatomic, retain) NSString *logo;
 @property (nonatomic, retain) NSString *channelId;
-@property (nonatomic, retain) NSMutableArray *programs;
+@property (nonatomic, retain) NSString *tvgName;           // Playlist tvg-name, the guide's name for the channel
+@property (nonatomic, retain) NSArray<VLCProgram *> *programs;  // Shared, never copied: treat as immutable
 @property (nonatomic, retain) NSString *logoUrl;
 @property (nonatomic, retain) NSString *category;
 
@@ -20,6 +27,10 @@
 @property (nonatomic, retain) NSString *catchupSource;     // Catch-up source type (e.g., "default", "append", "shift")
 @property (nonatomic, retain) NSString *catchupTemplate;   // URL template for catch-up streams
 
+// Playlist entry fingerprints (0 = unknown). Used by delta refresh to find changed entries.
+@property (nonatomic, assign) uint64_t entryFingerprint;  // Hash of #EXTINF line + URL
+@property (nonatomic, assign) uint64_t entryIdentity;     // Hash of URL (+ occurrence for repeated URLs)
+
 // Movie metadata properties
 @property (nonatomic, retain) NSString *movieId;
 @property (nonatomic, retain) NSString *movieDescription;
@@ -52,4 +63,39 @@
  */
 - (VLCProgram *)nextProgram;
 
+// Guide lookups by UTC seconds. The channel keeps an interval index over `programs`, built on
+// first use and rebuilt when the array is replaced or its count changes, so each lookup is a
+// binary search. Programmes whose times are edited after that need `programs` reassigned.
+
+/**
+ * Returns the program airing at timestamp, or nil
+ */
+- (VLCProgram *)programAtTimestamp:(int64_t)timestamp;
+
+/**
+ * Returns the program airing at timestamp, else the next one to start, else the last one
+ * (what -currentProgram returns for now)
+ */
+- (VLCProgram *)currentProgramAtTimestamp:(int64_t)timestamp;
+
+/**
+ * Returns the first program to start after timestamp, or nil
+ */
+- (VLCProgram *)nextProgramAfterTimestamp:(int64_t)timestamp;
+
+/**
+ * Returns the programs overlapping [startTimestamp, endTimestamp) in start order
+ */
+- (NSArray<VLCProgram *> *)programsFromTimestamp:(int64_t)startTimestamp toTimestamp:(int64_t)endTimestamp;
+
+/**
+ * Fills programs[0..range.length) with -currentProgramAtTimestamp: for channels in range, for
+ * list rows drawn together. Slots past the end of channels or holding other objects get nil.
+ * @return The number of slots that got a program
+ */
++ (NSUInteger)getCurrentPrograms:(VLCProgram **)programs
+                     forChannels:(NSArray *)channels
+                           range:(NSRange)range
+                     atTimestamp:(int64_t)timestamp;
+
 @end 
\ No newline at end of file
@@ -1,248 +1,504 @@
 #import "VLCChannel.h"
+#import "VLCChannelStore.h"
 #import "VLCProgram.h"
+#import "VLCProgramIndex.h"
+#import "VLCProgramStore.h"
+#import "VLCSnapshot.h"
 
-@implementation VLCChannel
-
-@synthesize name = _name;
-@synthesize url = _url;
-@synthesize group = _group;
-@synthesize logo = _logo;
-@synthesize channelId = _channelId;
-@synthesize programs = _programs;
-@synthesize logoUrl = _logoUrl;
-@synthesize category = _category;
-@synthesize supportsCatchup = _supportsCatchup;
-@synthesize catchupDays = _catchupDays;
-@synthesize catchupSource = _catchupSource;
-@synthesize catchupTemplate = _catchupTemplate;
-@synthesize movieId = _movieId;
-@synthesize movieDescription = _movieDescription;
-@synthesize movieGenre = _movieGenre;
-@synthesize movieDuration = _movieDuration;
-@synthesize movieYear = _movieYear;
-@synthesize movieRating = _movieRating;
-@synthesize movieDirector = _movieDirector;
-@synthesize movieCast = _movieCast;
-@synthesize hasLoadedMovieInfo = _hasLoadedMovieInfo;
-@synthesize hasStartedFetchingMovieInfo = _hasStartedFetchingMovieInfo;
-@synthesize cachedPosterImage = _cachedPosterImage;
+// Playlist fields held by the channel itself instead of a store row: every field of a
+// channel created with -init, and values a store row cannot take (strings over 64 KB)
+typedef struct {
+    uint32_t localFields;                           // VLCChannelLocalField bits
+    NSString *strings[VLCChannelStoreFieldCount];
+    NSString *group;
+    NSString *category;
+    BOOL supportsCatchup;
+    NSInteger catchupDays;
+    uint64_t entryFingerprint;
+    uint64_t entryIdentity;
+} VLCChannelLocalFields;
+
+enum {
+    VLCChannelLocalGroup = 1u << VLCChannelStoreFieldCount,
+    VLCChannelLocalCategory = VLCChannelLocalGroup << 1,
+    VLCChannelLocalSupportsCatchup = VLCChannelLocalGroup << 2,
+    VLCChannelLocalCatchupDays = VLCChannelLocalGroup << 3,
+    VLCChannelLocalEntryFingerprint = VLCChannelLocalGroup << 4,
+    VLCChannelLocalEntryIdentity = VLCChannelLocalGroup << 5
+};
+
+// Movie metadata and artwork; only VOD channels the user opened ever allocate this
+typedef struct {
+    NSString *logoUrl;
+    NSString *movieId;
+    NSString *movieDescription;
+    NSString *movieGenre;
+    NSString *movieDuration;
+    NSString *movieYear;
+    NSString *movieRating;
+    NSString *movieDirector;
+    NSString *movieCast;
+    id cachedPosterImage;
+    BOOL hasLoadedMovieInfo;
+    BOOL hasStartedFetchingMovieInfo;
+} VLCChannelExtras;
+
+// Allocates *slot once, even when two threads get here at the same time
+static void *VLCChannelEnsureStruct(void **slot, size_t size) {
+    void *existing = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    if (existing) {
+        return existing;
+    }
+    void *fresh = calloc(1, size);
+    if (__atomic_compare_exchange_n(slot, &existing, fresh, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return fresh;
+    }
+    free(fresh);
+    return existing;
+}
+
+static inline void VLCChannelAssign(id *slot, id value) {
+    if (*slot == value) return;
+    id old = *slot;
+    *slot = [value retain];
+    [old release];
+}
+
+// Timestamp of a guide entry's start or end; entries are VLCPrograms or NSDictionaries with
+// startTime/endTime dates
+static int64_t VLCChannelProgramTimestamp(id program, BOOL end) {
+    if ([program isKindOfClass:[VLCProgram class]]) {
+        return end ? [(VLCProgram *)program endTimestamp] : [(VLCProgram *)program startTimestamp];
+    }
+    if ([program isKindOfClass:[NSDictionary class]]) {
+        NSDate *date = [(NSDictionary *)program objectForKey:end ? @"endTime" : @"startTime"];
+        if ([date isKindOfClass:[NSDate class]]) {
+            return (int64_t)floor([date timeIntervalSince1970]);
+        }
+    }
+    return VLC_PROGRAM_NO_TIMESTAMP;
+}
+
+static int64_t VLCChannelCurrentTimestamp(void) {
+    return (int64_t)floor(CFAbsoluteTimeGetCurrent() + kCFAbsoluteTimeIntervalSince1970);
+}
+
+// Interval index over one programs array. It retains the array, so positions stay valid
+// when the channel is given a new one while a lookup is running. Guide lists bring their own
+// index, which is borrowed rather than rebuilt for every channel showing the list.
+@interface VLCChannelProgramIndex : NSObject {
+@public
+    NSArray *_programs;
+    NSUInteger _count;
+    const VLCProgramIndex *_index;  // NULL when out of memory; lookups then find nothing
+    VLCProgramIndex *_ownIndex;     // Built here for arrays that are not guide lists
+}
+- (instancetype)initWithPrograms:(NSArray *)programs;
+@end
+
+@implementation VLCChannelProgramIndex
+
+- (instancetype)initWithPrograms:(NSArray *)programs {
+    self = [super init];
+    if (self) {
+        _programs = [programs retain];
+        _count = programs.count;
+        if ([programs isKindOfClass:[VLCProgramList class]]) {
+            _index = [(VLCProgramList *)programs programIndex];
+        } else {
+            VLCProgramInterval *intervals = malloc((_count ? _count : 1) * sizeof(VLCProgramInterval));
+            if (intervals) {
+                for (NSUInteger i = 0; i < _count; i++) {
+                    id program = [programs objectAtIndex:i];
+                    intervals[i].start = VLCChannelProgramTimestamp(program, NO);
+                    intervals[i].end = VLCChannelProgramTimestamp(program, YES);
+                }
+                _ownIndex = VLCProgramIndexCreate(intervals, _count);
+                _index = _ownIndex;
+                free(intervals);
+            }
+        }
+        if (!_index) {
+            NSLog(@"⚠️ [EPG] Not enough memory to index %lu programs", (unsigned long)_count);
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    VLCProgramIndexFree(_ownIndex);
+    [_programs release];
+    [super dealloc];
+}
+
+- (id)programAtPosition:(size_t)position {
+    return position == VLC_PROGRAM_INDEX_NONE ? nil : [_programs objectAtIndex:position];
+}
+
+@end
+
+@interface VLCChannel () {
+    NSArray<VLCProgram *> *_programs;
+    VLCChannelProgramIndex *_programIndex;
+}
+@end
+
+@implementation VLCChannel {
+    VLCChannelStore *_store;
+    uint32_t _row;
+    VLCChannelLocalFields *_local;
+    VLCChannelExtras *_extras;
+}
 
 - (instancetype)init {
+    // Standalone channel: everything lives in the local fields, allocated on first write
+    return [super init];
+}
+
+- (instancetype)initWithStore:(VLCChannelStore *)store row:(uint32_t)row {
     self = [super init];
     if (self) {
-        _name = @"";
-        _url = @"";
-        _group = @"";
-        _logo = @"";
-        _channelId = @"";
-        _programs = [[NSMutableArray alloc] init];
+        _store = [store retain];
+        _row = row;
     }
     return self;
 }
 
 - (void)dealloc {
-    [_name release];
-    [_url release];
-    [_group release];
-    [_logo release];
-    [_channelId release];
+    if (_local) {
+        for (NSUInteger i = 0; i < VLCChannelStoreFieldCount; i++) {
+            [_local->strings[i] release];
+        }
+        [_local->group release];
+        [_local->category release];
+        free(_local);
+    }
+    if (_extras) {
+        [_extras->logoUrl release];
+        [_extras->movieId release];
+        [_extras->movieDescription release];
+        [_extras->movieGenre release];
+        [_extras->movieDuration release];
+        [_extras->movieYear release];
+        [_extras->movieRating release];
+        [_extras->movieDirector release];
+        [_extras->movieCast release];
+        [_extras->cachedPosterImage release];
+        free(_extras);
+    }
     [_programs release];
-    [_logoUrl release];
-    [_category release];
-    [_catchupSource release];
-    [_catchupTemplate release];
-    [_movieId release];
-    [_movieDescription release];
-    [_movieGenre release];
-    [_movieDuration release];
-    [_movieYear release];
-    [_movieRating release];
-    [_movieDirector release];
-    [_movieCast release];
-    [_cachedPosterImage release];
+    [_programIndex release];
+    [_store release];
     [super dealloc];
 }
 
-// Add current program method
-- (VLCProgram *)currentProgram {
-    if (!self.programs || self.programs.count == 0) {
+#pragma mark - Field Storage
+
+- (VLCChannelLocalFields *)localFields {
+    return VLCChannelEnsureStruct((void **)&_local, sizeof(VLCChannelLocalFields));
+}
+
+- (VLCChannelExtras *)extras {
+    return VLCChannelEnsureStruct((void **)&_extras, sizeof(VLCChannelExtras));
+}
+
+- (BOOL)hasLocalField:(uint32_t)field {
+    VLCChannelLocalFields *local = __atomic_load_n(&_local, __ATOMIC_ACQUIRE);
+    return local && (__atomic_load_n(&local->localFields, __ATOMIC_ACQUIRE) & field);
+}
+
+- (void)markLocalField:(uint32_t)field local:(BOOL)isLocal {
+    if (isLocal) {
+        __atomic_fetch_or(&[self localFields]->localFields, field, __ATOMIC_RELEASE);
+    } else if (_local) {
+        __atomic_fetch_and(&_local->localFields, ~field, __ATOMIC_RELEASE);
+    }
+}
+
+- (NSString *)stringForField:(VLCChannelStoreField)field defaultValue:(NSString *)defaultValue {
+    if ([self hasLocalField:1u << field]) {
+        return _local->strings[field];
+    }
+    if (_store) {
+        return [_store stringForField:field row:_row] ?: defaultValue;
+    }
+    return defaultValue;
+}
+
+- (void)setString:(NSString *)value forField:(VLCChannelStoreField)field {
+    if (_store && [_store setString:value forField:field row:_row]) {
+        [self markLocalField:1u << field local:NO];
+        return;
+    }
+    VLCChannelAssign(&[self localFields]->strings[field], value);
+    [self markLocalField:1u << field local:YES];
+}
+
+#pragma mark - Playlist Fields
+
+// Defaults match what -init used to assign: empty strings for the core fields, nil otherwise
+- (NSString *)name { return [self stringForField:VLCChannelStoreFieldName defaultValue:@""]; }
+- (void)setName:(NSString *)name { [self setString:name forField:VLCChannelStoreFieldName]; }
+
+- (NSString *)url { return [self stringForField:VLCChannelStoreFieldURL defaultValue:@""]; }
+- (void)setUrl:(NSString *)url { [self setString:url forField:VLCChannelStoreFieldURL]; }
+
+- (NSString *)logo { return [self stringForField:VLCChannelStoreFieldLogo defaultValue:@""]; }
+- (void)setLogo:(NSString *)logo { [self setString:logo forField:VLCChannelStoreFieldLogo]; }
+
+- (NSString *)channelId { return [self stringForField:VLCChannelStoreFieldChannelId defaultValue:@""]; }
+- (void)setChannelId:(NSString *)channelId { [self setString:channelId forField:VLCChannelStoreFieldChannelId]; }
+
+- (NSString *)tvgName { return [self stringForField:VLCChannelStoreFieldTvgName defaultValue:nil]; }
+- (void)setTvgName:(NSString *)tvgName { [self setString:tvgName forField:VLCChannelStoreFieldTvgName]; }
+
+- (NSString *)catchupSource { return [self stringForField:VLCChannelStoreFieldCatchupSource defaultValue:nil]; }
+- (void)setCatchupSource:(NSString *)catchupSource { [self setString:catchupSource forField:VLCChannelStoreFieldCatchupSource]; }
+
+- (NSString *)catchupTemplate { return [self stringForField:VLCChannelStoreFieldCatchupTemplate defaultValue:nil]; }
+- (void)setCatchupTemplate:(NSString *)catchupTemplate { [self setString:catchupTemplate forField:VLCChannelStoreFieldCatchupTemplate]; }
+
+- (NSString *)group {
+    if ([self hasLocalField:VLCChannelLocalGroup]) return _local->group;
+    return _store ? ([_store groupAtRow:_row] ?: @"") : @"";
+}
+
+- (void)setGroup:(NSString *)group {
+    if (_store) {
+        [_store setGroup:group atRow:_row];
+        [self markLocalField:VLCChannelLocalGroup local:NO];
+        return;
+    }
+    VLCChannelAssign(&[self localFields]->group, group);
+    [self markLocalField:VLCChannelLocalGroup local:YES];
+}
+
+- (NSString *)category {
+    if ([self hasLocalField:VLCChannelLocalCategory]) return _local->category;
+    return _store ? [_store categoryAtRow:_row] : nil;
+}
+
+- (void)setCategory:(NSString *)category {
+    if (_store) {
+        [_store setCategory:category atRow:_row];
+        [self markLocalField:VLCChannelLocalCategory local:NO];
+        return;
+    }
+    VLCChannelAssign(&[self localFields]->category, category);
+    [self markLocalField:VLCChannelLocalCategory local:YES];
+}
+
+- (BOOL)supportsCatchup {
+    if (_store) return [_store supportsCatchupAtRow:_row];
+    return _local ? _local->supportsCatchup : NO;
+}
+
+- (void)setSupportsCatchup:(BOOL)supportsCatchup {
+    if (_store) {
+        [_store setSupportsCatchup:supportsCatchup atRow:_row];
+    } else {
+        [self localFields]->supportsCatchup = supportsCatchup;
+    }
+}
+
+- (NSInteger)catchupDays {
+    if (_store) return [_store catchupDaysAtRow:_row];
+    return _local ? _local->catchupDays : 0;
+}
+
+- (void)setCatchupDays:(NSInteger)catchupDays {
+    if (_store) {
+        [_store setCatchupDays:catchupDays atRow:_row];
+    } else {
+        [self localFields]->catchupDays = catchupDays;
+    }
+}
+
+- (uint64_t)entryFingerprint {
+    if (_store) return [_store entryFingerprintAtRow:_row];
+    return _local ? _local->entryFingerprint : 0;
+}
+
+- (void)setEntryFingerprint:(uint64_t)entryFingerprint {
+    if (_store) {
+        [_store setEntryFingerprint:entryFingerprint atRow:_row];
+    } else {
+        [self localFields]->entryFingerprint = entryFingerprint;
+    }
+}
+
+- (uint64_t)entryIdentity {
+    if (_store) return [_store entryIdentityAtRow:_row];
+    return _local ? _local->entryIdentity : 0;
+}
+
+- (void)setEntryIdentity:(uint64_t)entryIdentity {
+    if (_store) {
+        [_store setEntryIdentity:entryIdentity atRow:_row];
+    } else {
+        [self localFields]->entryIdentity = entryIdentity;
+    }
+}
+
+#pragma mark - Movie Metadata
+
+- (NSString *)logoUrl { return _extras ? _extras->logoUrl : nil; }
+- (void)setLogoUrl:(NSString *)logoUrl { VLCChannelAssign(&[self extras]->logoUrl, logoUrl); }
+
+- (NSString *)movieId { return _extras ? _extras->movieId : nil; }
+- (void)setMovieId:(NSString *)movieId { VLCChannelAssign(&[self extras]->movieId, movieId); }
+
+- (NSString *)movieDescription { return _extras ? _extras->movieDescription : nil; }
+- (void)setMovieDescription:(NSString *)movieDescription { VLCChannelAssign(&[self extras]->movieDescription, movieDescription); }
+
+- (NSString *)movieGenre { return _extras ? _extras->movieGenre : nil; }
+- (void)setMovieGenre:(NSString *)movieGenre { VLCChannelAssign(&[self extras]->movieGenre, movieGenre); }
+
+- (NSString *)movieDuration { return _extras ? _extras->movieDuration : nil; }
+- (void)setMovieDuration:(NSString *)movieDuration { VLCChannelAssign(&[self extras]->movieDuration, movieDuration); }
+
+- (NSString *)movieYear { return _extras ? _extras->movieYear : nil; }
+- (void)setMovieYear:(NSString *)movieYear { VLCChannelAssign(&[self extras]->movieYear, movieYear); }
+
+- (NSString *)movieRating { return _extras ? _extras->movieRating : nil; }
+- (void)setMovieRating:(NSString *)movieRating { VLCChannelAssign(&[self extras]->movieRating, movieRating); }
+
+- (NSString *)movieDirector { return _extras ? _extras->movieDirector : nil; }
+- (void)setMovieDirector:(NSString *)movieDirector { VLCChannelAssign(&[self extras]->movieDirector, movieDirector); }
+
+- (NSString *)movieCast { return _extras ? _extras->movieCast : nil; }
+- (void)setMovieCast:(NSString *)movieCast { VLCChannelAssign(&[self extras]->movieCast, movieCast); }
+
+- (BOOL)hasLoadedMovieInfo { return _extras ? _extras->hasLoadedMovieInfo : NO; }
+- (void)setHasLoadedMovieInfo:(BOOL)hasLoadedMovieInfo { [self extras]->hasLoadedMovieInfo = hasLoadedMovieInfo; }
+
+- (BOOL)hasStartedFetchingMovieInfo { return _extras ? _extras->hasStartedFetchingMovieInfo : NO; }
+- (void)setHasStartedFetchingMovieInfo:(BOOL)hasStartedFetchingMovieInfo { [self extras]->hasStartedFetchingMovieInfo = hasStartedFetchingMovieInfo; }
+
+#if TARGET_OS_OSX
+- (NSImage *)cachedPosterImage { return _extras ? _extras->cachedPosterImage : nil; }
+- (void)setCachedPosterImage:(NSImage *)cachedPosterImage { VLCChannelAssign(&[self extras]->cachedPosterImage, cachedPosterImage); }
+#else
+- (UIImage *)cachedPosterImage { return _extras ? _extras->cachedPosterImage : nil; }
+- (void)setCachedPosterImage:(UIImage *)cachedPosterImage { VLCChannelAssign(&[self extras]->cachedPosterImage, cachedPosterImage); }
+#endif
+
+#pragma mark - Programme Index
+
+// Matching replaces programs on a background queue while the UI reads them; both the array and
+// its index are published snapshots, so neither side waits for the other
+- (NSArray<VLCProgram *> *)programs {
+    return VLCSnapshotLoad((id *)&_programs);
+}
+
+- (void)setPrograms:(NSArray<VLCProgram *> *)programs {
+    VLCSnapshotPublish((id *)&_programs, programs);
+    VLCSnapshotPublish((id *)&_programIndex, nil);
+}
+
+// Index for the current programs array; nil when there are no programs
+- (VLCChannelProgramIndex *)currentProgramIndex {
+    NSArray *programs = VLCSnapshotLoad((id *)&_programs);
+    NSUInteger count = programs.count;
+    if (count == 0) {
         return nil;
     }
-    
-    NSDate *now = [NSDate date];
-    
-    for (id program in self.programs) {
-        NSDate *startTime = nil;
-        NSDate *endTime = nil;
-        
-        if ([program isKindOfClass:[VLCProgram class]]) {
-            VLCProgram *vlcProgram = (VLCProgram *)program;
-            startTime = vlcProgram.startTime;
-            endTime = vlcProgram.endTime;
-        } else if ([program isKindOfClass:[NSDictionary class]]) {
-            NSDictionary *programDict = (NSDictionary *)program;
-            startTime = [programDict objectForKey:@"startTime"];
-            endTime = [programDict objectForKey:@"endTime"];
-        }
-        
-        if (startTime && endTime && [now compare:startTime] != NSOrderedAscending && 
-            [now compare:endTime] == NSOrderedAscending) {
-            return program;
-        }
+    VLCChannelProgramIndex *index = VLCSnapshotLoad((id *)&_programIndex);
+    if (index && index->_programs == programs && index->_count == count) {
+        return index;
     }
-    
-    // If no current program, return the next upcoming one
-    NSArray *sortedPrograms = [self.programs sortedArrayUsingComparator:^NSComparisonResult(id a, id b) {
-        NSDate *startTimeA = nil;
-        NSDate *startTimeB = nil;
-        
-        if ([a isKindOfClass:[VLCProgram class]]) {
-            startTimeA = [(VLCProgram *)a startTime];
-        } else if ([a isKindOfClass:[NSDictionary class]]) {
-            startTimeA = [(NSDictionary *)a objectForKey:@"startTime"];
-        }
-        
-        if ([b isKindOfClass:[VLCProgram class]]) {
-            startTimeB = [(VLCProgram *)b startTime];
-        } else if ([b isKindOfClass:[NSDictionary class]]) {
-            startTimeB = [(NSDictionary *)b objectForKey:@"startTime"];
-        }
-        
-        if (!startTimeA || !startTimeB) return NSOrderedSame;
-        return [startTimeA compare:startTimeB];
-    }];
-    
-    for (id program in sortedPrograms) {
-        NSDate *startTime = nil;
-        if ([program isKindOfClass:[VLCProgram class]]) {
-            startTime = [(VLCProgram *)program startTime];
-        } else if ([program isKindOfClass:[NSDictionary class]]) {
-            startTime = [(NSDictionary *)program objectForKey:@"startTime"];
+    index = [[[VLCChannelProgramIndex alloc] initWithPrograms:programs] autorelease];
+    VLCSnapshotPublish((id *)&_programIndex, index);
+    return index;
+}
+
+- (VLCProgram *)programAtTimestamp:(int64_t)timestamp {
+    VLCChannelProgramIndex *index = [self currentProgramIndex];
+    return index ? [index programAtPosition:VLCProgramIndexFind(index->_index, timestamp)] : nil;
+}
+
+- (VLCProgram *)currentProgramAtTimestamp:(int64_t)timestamp {
+    VLCChannelProgramIndex *index = [self currentProgramIndex];
+    if (!index) {
+        return nil;
+    }
+    if (VLCProgramIndexCount(index->_index) == 0) {
+        // No entry has usable times
+        return [index->_programs lastObject];
+    }
+    size_t position = VLCProgramIndexFind(index->_index, timestamp);
+    if (position == VLC_PROGRAM_INDEX_NONE) {
+        // If no current program, return the next upcoming one
+        position = VLCProgramIndexFindNext(index->_index, timestamp);
+    }
+    if (position == VLC_PROGRAM_INDEX_NONE) {
+        // If no upcoming program, return the most recent one
+        position = VLCProgramIndexFindLast(index->_index);
+    }
+    return [index programAtPosition:position];
+}
+
+- (NSArray<VLCProgram *> *)programsFromTimestamp:(int64_t)startTimestamp toTimestamp:(int64_t)endTimestamp {
+    VLCChannelProgramIndex *index = [self currentProgramIndex];
+    if (!index) {
+        return @[];
+    }
+    size_t positions[64];
+    size_t count = VLCProgramIndexFindRange(index->_index, startTimestamp, endTimestamp, positions, 64);
+    size_t *found = positions;
+    if (count > 64) {
+        found = malloc(count * sizeof(size_t));
+        if (!found) {
+            return @[];
         }
-        
-        if (startTime && [now compare:startTime] == NSOrderedAscending) {
-            return program;
+        VLCProgramIndexFindRange(index->_index, startTimestamp, endTimestamp, found, count);
+    }
+    NSMutableArray *programs = [NSMutableArray arrayWithCapacity:count];
+    for (size_t i = 0; i < count; i++) {
+        [programs addObject:[index->_programs objectAtIndex:found[i]]];
+    }
+    if (found != positions) {
+        free(found);
+    }
+    return programs;
+}
+
++ (NSUInteger)getCurrentPrograms:(VLCProgram **)programs
+                     forChannels:(NSArray *)channels
+                           range:(NSRange)range
+                     atTimestamp:(int64_t)timestamp {
+    NSUInteger channelCount = channels.count;
+    NSUInteger found = 0;
+    for (NSUInteger i = 0; i < range.length; i++) {
+        NSUInteger channelIndex = range.location + i;
+        id channel = channelIndex < channelCount ? [channels objectAtIndex:channelIndex] : nil;
+        programs[i] = [channel isKindOfClass:[VLCChannel class]] ? [channel currentProgramAtTimestamp:timestamp] : nil;
+        if (programs[i]) {
+            found++;
         }
     }
-    
-    // If no upcoming program, return the most recent one
-    return [sortedPrograms lastObject];
+    return found;
+}
+
+- (VLCProgram *)currentProgram {
+    return [self currentProgramAtTimestamp:VLCChannelCurrentTimestamp()];
 }
 
-// Add current program method with time offset
 - (VLCProgram *)currentProgramWithTimeOffset:(NSInteger)offsetHours {
-    if (!self.programs || self.programs.count == 0) {
-        return nil;
-    }
-    
-    NSDate *now = [NSDate date];
-    
     // Apply time offset in opposite direction to correctly find current program
     // When user has EPG offset (e.g., +1 hour), it means EPG times are 1 hour ahead of local time
     // So to find the current program, we need to subtract the offset from current time
     // to match against the EPG program times
-    NSTimeInterval offsetSeconds = -offsetHours * 3600 ; // Convert hours to seconds and negate
-    NSDate *adjustedNow = [now dateByAddingTimeInterval:offsetSeconds];
-    
-    //NSLog(@"currentProgramWithTimeOffset: offsetHours=%ld, now=%@, adjustedNow=%@", 
-    //      (long)offsetHours, now, adjustedNow);
-    
-    for (id program in self.programs) {
-        // Safety check: handle both VLCProgram objects and dictionaries
-        NSDate *startTime = nil;
-        NSDate *endTime = nil;
-        
-        if ([program isKindOfClass:[VLCProgram class]]) {
-            VLCProgram *vlcProgram = (VLCProgram *)program;
-            startTime = vlcProgram.startTime;
-            endTime = vlcProgram.endTime;
-        } else if ([program isKindOfClass:[NSDictionary class]]) {
-            NSDictionary *programDict = (NSDictionary *)program;
-            startTime = [programDict objectForKey:@"startTime"];
-            endTime = [programDict objectForKey:@"endTime"];
-        }
-        
-        if (startTime && endTime) {
-            // Check if the adjusted current time falls within this program's time range
-            if ([adjustedNow compare:startTime] != NSOrderedAscending && 
-                [adjustedNow compare:endTime] == NSOrderedAscending) {
-                
-                //NSLog(@"Found current program: %@ (%@ - %@)", 
-                //      program.title, startTime, endTime);
-                return program;
-            }
-        }
-    }
-    
-    // If no current program, return the next upcoming one
-    NSArray *sortedPrograms = [self.programs sortedArrayUsingComparator:^NSComparisonResult(id a, id b) {
-        NSDate *startTimeA = nil;
-        NSDate *startTimeB = nil;
-        
-        if ([a isKindOfClass:[VLCProgram class]]) {
-            startTimeA = [(VLCProgram *)a startTime];
-        } else if ([a isKindOfClass:[NSDictionary class]]) {
-            startTimeA = [(NSDictionary *)a objectForKey:@"startTime"];
-        }
-        
-        if ([b isKindOfClass:[VLCProgram class]]) {
-            startTimeB = [(VLCProgram *)b startTime];
-        } else if ([b isKindOfClass:[NSDictionary class]]) {
-            startTimeB = [(NSDictionary *)b objectForKey:@"startTime"];
-        }
-        
-        if (!startTimeA || !startTimeB) return NSOrderedSame;
-        return [startTimeA compare:startTimeB];
-    }];
-    
-    for (id program in sortedPrograms) {
-        NSDate *startTime = nil;
-        if ([program isKindOfClass:[VLCProgram class]]) {
-            startTime = [(VLCProgram *)program startTime];
-        } else if ([program isKindOfClass:[NSDictionary class]]) {
-            startTime = [(NSDictionary *)program objectForKey:@"startTime"];
-        }
-        
-        if (startTime && [adjustedNow compare:startTime] == NSOrderedAscending) {
-            //NSLog(@"Found next program: %@ (%@ - %@)", 
-                  //program.title, startTime, endTime);
-            return program;
-        }
-    }
-    
-    // If no upcoming program, return the most recent one
-    VLCProgram *lastProgram = [sortedPrograms lastObject];
-    if (lastProgram) {
-        //NSLog(@"Returning last program: %@ (%@ - %@)", 
-              //lastProgram.title, lastProgram.startTime, lastProgram.endTime);
-    }
-    return lastProgram;
+    return [self currentProgramAtTimestamp:VLCChannelCurrentTimestamp() - (int64_t)offsetHours * 3600];
+}
+
+- (VLCProgram *)nextProgramAfterTimestamp:(int64_t)timestamp {
+    VLCChannelProgramIndex *index = [self currentProgramIndex];
+    return index ? [index programAtPosition:VLCProgramIndexFindNext(index->_index, timestamp)] : nil;
 }
 
-// Add next program method
 - (VLCProgram *)nextProgram {
-    NSDate *now = [NSDate date];
-    VLCProgram *nextProgram = nil;
-    NSTimeInterval shortestDiff = DBL_MAX;
-    
-    for (id program in _programs) {
-        NSDate *startTime = nil;
-        if ([program isKindOfClass:[VLCProgram class]]) {
-            startTime = [(VLCProgram *)program startTime];
-        } else if ([program isKindOfClass:[NSDictionary class]]) {
-            startTime = [(NSDictionary *)program objectForKey:@"startTime"];
-        }
-        
-        if (startTime && [startTime compare:now] == NSOrderedDescending) {
-            NSTimeInterval diff = [startTime timeIntervalSinceDate:now];
-            if (diff < shortestDiff) {
-                shortestDiff = diff;
-                nextProgram = program;
-            }
-        }
-    }
-    
-    return nextProgram;
+    return [self nextProgramAfterTimestamp:VLCChannelCurrentTimestamp()];
 }
 
-@end 
+@end
@@ -0,0 +1,238 @@
+//
+//  VLCChannelClassifier.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable Channel Classifier - Platform Independent (plain C)
+//  Decides TV / MOVIES / SERIES from raw name, group and URL bytes without allocating
+//
+
+#include "VLCChannelClassifier.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    char *pattern;                  // Lowercased copy
+    size_t length;
+    VLCClassifierField field;
+    VLCChannelCategory category;
+} VLCClassifierRule;
+
+// Container formats that mark a URL as a VOD file rather than a live stream
+static const char *const VLCMovieExtensions[] = {
+    "mp4", "mkv", "avi", "mov", "m4v", "wmv", "flv", "webm", "ogv", "3gp", "m2ts",
+    "ts", "vob", "divx", "xvid", "rmvb", "asf", "mpg", "mpeg", "m2v", "mts"
+};
+
+#define VLC_MOVIE_EXTENSION_COUNT (sizeof(VLCMovieExtensions) / sizeof(VLCMovieExtensions[0]))
+#define VLC_MAX_EXTENSION_LENGTH 4
+
+struct VLCChannelClassifier {
+    VLCClassifierRule *rules;
+    size_t ruleCount;
+    size_t ruleCapacity;
+    // Extensions packed into one integer each (lowercase, zero padded), sorted for bsearch
+    uint32_t extensionKeys[VLC_MOVIE_EXTENSION_COUNT];
+};
+
+#pragma mark - Helpers
+
+static inline char VLCClassifierLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+static inline int VLCClassifierIsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Delimiters around an episode marker: whitespace, '-' and '.'
+static inline int VLCClassifierIsDelimiter(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v' || c == '-' || c == '.';
+}
+
+// Packs up to VLC_MAX_EXTENSION_LENGTH bytes into a key; returns 0 when the extension is too long
+static uint32_t VLCClassifierExtensionKey(const char *extension, size_t length) {
+    if (length == 0 || length > VLC_MAX_EXTENSION_LENGTH) {
+        return 0;
+    }
+    uint32_t key = 0;
+    for (size_t i = 0; i < VLC_MAX_EXTENSION_LENGTH; i++) {
+        key = (key << 8) | (uint8_t)(i < length ? VLCClassifierLower(extension[i]) : 0);
+    }
+    return key;
+}
+
+static int VLCClassifierCompareKeys(const void *lhs, const void *rhs) {
+    uint32_t a = *(const uint32_t *)lhs;
+    uint32_t b = *(const uint32_t *)rhs;
+    return (a > b) - (a < b);
+}
+
+// ASCII case-insensitive substring search; pattern is already lowercase
+static int VLCClassifierContains(const char *haystack, size_t haystackLength, const char *pattern, size_t patternLength) {
+    if (patternLength == 0 || haystackLength < patternLength) {
+        return 0;
+    }
+    char first = pattern[0];
+    size_t last = haystackLength - patternLength;
+    for (size_t i = 0; i <= last; i++) {
+        if (VLCClassifierLower(haystack[i]) != first) continue;
+        size_t j = 1;
+        while (j < patternLength && VLCClassifierLower(haystack[i + j]) == pattern[j]) j++;
+        if (j == patternLength) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#pragma mark - Built-in Rules
+
+int VLCChannelTitleHasEpisodeMarker(const char *name, size_t length) {
+    if (!name) {
+        return 0;
+    }
+    // Same shape the old regex looked for - [\s\-\.](S\d+|E\d+)[\s\-\.] - plus the
+    // common combined form SxxExx
+    for (size_t i = 0; i + 1 < length; i++) {
+        if (!VLCClassifierIsDelimiter(name[i])) continue;
+
+        size_t cursor = i + 1;
+        char marker = VLCClassifierLower(name[cursor]);
+        if (marker != 's' && marker != 'e') continue;
+        cursor++;
+
+        size_t digitsStart = cursor;
+        while (cursor < length && VLCClassifierIsDigit(name[cursor])) cursor++;
+        if (cursor == digitsStart) continue;
+
+        if (marker == 's' && cursor < length && VLCClassifierLower(name[cursor]) == 'e') {
+            size_t episodeStart = cursor + 1;
+            size_t episodeEnd = episodeStart;
+            while (episodeEnd < length && VLCClassifierIsDigit(name[episodeEnd])) episodeEnd++;
+            if (episodeEnd > episodeStart) {
+                cursor = episodeEnd;
+            }
+        }
+
+        if (cursor < length && VLCClassifierIsDelimiter(name[cursor])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int VLCClassifierHasMovieExtension(const uint32_t *extensionKeys, const char *url, size_t length) {
+    if (!url || length < 2) {
+        return 0;
+    }
+    // Only the last dot-segment matters, and it can be at most VLC_MAX_EXTENSION_LENGTH bytes long
+    size_t scanStart = length > VLC_MAX_EXTENSION_LENGTH + 1 ? length - (VLC_MAX_EXTENSION_LENGTH + 1) : 0;
+    size_t dot = length;
+    for (size_t i = length; i > scanStart; i--) {
+        if (url[i - 1] == '.') {
+            dot = i - 1;
+            break;
+        }
+    }
+    if (dot == length) {
+        return 0;
+    }
+
+    uint32_t key = VLCClassifierExtensionKey(url + dot + 1, length - dot - 1);
+    if (key == 0) {
+        return 0;
+    }
+    return bsearch(&key, extensionKeys, VLC_MOVIE_EXTENSION_COUNT, sizeof(uint32_t), VLCClassifierCompareKeys) != NULL;
+}
+
+static void VLCClassifierBuildExtensionKeys(uint32_t *extensionKeys) {
+    for (size_t i = 0; i < VLC_MOVIE_EXTENSION_COUNT; i++) {
+        extensionKeys[i] = VLCClassifierExtensionKey(VLCMovieExtensions[i], strlen(VLCMovieExtensions[i]));
+    }
+    qsort(extensionKeys, VLC_MOVIE_EXTENSION_COUNT, sizeof(uint32_t), VLCClassifierCompareKeys);
+}
+
+#pragma mark - Classifier
+
+VLCChannelClassifier *VLCChannelClassifierCreate(void) {
+    VLCChannelClassifier *classifier = calloc(1, sizeof(VLCChannelClassifier));
+    if (classifier) {
+        VLCClassifierBuildExtensionKeys(classifier->extensionKeys);
+    }
+    return classifier;
+}
+
+void VLCChannelClassifierFree(VLCChannelClassifier *classifier) {
+    if (!classifier) {
+        return;
+    }
+    for (size_t i = 0; i < classifier->ruleCount; i++) {
+        free(classifier->rules[i].pattern);
+    }
+    free(classifier->rules);
+    free(classifier);
+}
+
+int VLCChannelClassifierAddRule(VLCChannelClassifier *classifier,
+                                VLCClassifierField field,
+                                const char *pattern,
+                                size_t patternLength,
+                                VLCChannelCategory category) {
+    if (!classifier || !pattern || patternLength == 0) {
+        return 0;
+    }
+    if (classifier->ruleCount == classifier->ruleCapacity) {
+        size_t capacity = classifier->ruleCapacity ? classifier->ruleCapacity * 2 : 8;
+        VLCClassifierRule *rules = realloc(classifier->rules, capacity * sizeof(VLCClassifierRule));
+        if (!rules) {
+            return 0;
+        }
+        classifier->rules = rules;
+        classifier->ruleCapacity = capacity;
+    }
+
+    char *lowered = malloc(patternLength);
+    if (!lowered) {
+        return 0;
+    }
+    for (size_t i = 0; i < patternLength; i++) {
+        lowered[i] = VLCClassifierLower(pattern[i]);
+    }
+
+    VLCClassifierRule *rule = &classifier->rules[classifier->ruleCount++];
+    rule->pattern = lowered;
+    rule->length = patternLength;
+    rule->field = field;
+    rule->category = category;
+    return 1;
+}
+
+int VLCChannelClassifierIsMovieURL(const VLCChannelClassifier *classifier, const char *url, size_t length) {
+    return VLCClassifierHasMovieExtension(classifier->extensionKeys, url, length);
+}
+
+VLCChannelCategory VLCChannelClassify(const VLCChannelClassifier *classifier,
+                                      const char *name, size_t nameLength,
+                                      const char *group, size_t groupLength,
+                                      const char *url, size_t urlLength) {
+    for (size_t i = 0; i < classifier->ruleCount; i++) {
+        const VLCClassifierRule *rule = &classifier->rules[i];
+        int matched = rule->field == VLCClassifierFieldURL
+            ? (url && VLCClassifierContains(url, urlLength, rule->pattern, rule->length))
+            : (group && VLCClassifierContains(group, groupLength, rule->pattern, rule->length));
+        if (matched) {
+            return rule->category;
+        }
+    }
+
+    // Series markers in the title win over the file extension (episodes are .mkv/.mp4 too)
+    if (VLCChannelTitleHasEpisodeMarker(name, nameLength)) {
+        return VLCChannelCategorySeries;
+    }
+    if (VLCClassifierHasMovieExtension(classifier->extensionKeys, url, urlLength)) {
+        return VLCChannelCategoryMovies;
+    }
+    return VLCChannelCategoryTV;
+}
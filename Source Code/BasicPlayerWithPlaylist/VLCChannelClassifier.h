@@ -0,0 +1,67 @@
+//
+//  VLCChannelClassifier.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable Channel Classifier - Platform Independent (plain C)
+//  Decides TV / MOVIES / SERIES from raw name, group and URL bytes without allocating
+//
+
+#ifndef VLCChannelClassifier_h
+#define VLCChannelClassifier_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    VLCChannelCategoryTV = 0,
+    VLCChannelCategoryMovies,
+    VLCChannelCategorySeries
+} VLCChannelCategory;
+
+// Which field a user rule is matched against
+typedef enum {
+    VLCClassifierFieldGroup = 0,
+    VLCClassifierFieldURL
+} VLCClassifierField;
+
+typedef struct VLCChannelClassifier VLCChannelClassifier;
+
+// Creates a classifier with the built-in rules (episode markers, movie file extensions).
+// NULL on allocation failure.
+VLCChannelClassifier *VLCChannelClassifierCreate(void);
+void VLCChannelClassifierFree(VLCChannelClassifier *classifier);
+
+/**
+ * Adds a rule: when field contains pattern (ASCII case-insensitive), the channel gets category.
+ * User rules are checked before the built-in rules, in the order they were added.
+ * Not thread safe - add all rules before classifying. Returns 0 on allocation failure.
+ */
+int VLCChannelClassifierAddRule(VLCChannelClassifier *classifier,
+                                VLCClassifierField field,
+                                const char *pattern,
+                                size_t patternLength,
+                                VLCChannelCategory category);
+
+/**
+ * Classifies one channel. Any field may be NULL with length 0.
+ * Safe to call from several threads at once on the same classifier.
+ */
+VLCChannelCategory VLCChannelClassify(const VLCChannelClassifier *classifier,
+                                      const char *name, size_t nameLength,
+                                      const char *group, size_t groupLength,
+                                      const char *url, size_t urlLength);
+
+// Returns 1 when the title has a delimited season/episode marker (" S01 ", ".E05.", "-S02E03 ")
+int VLCChannelTitleHasEpisodeMarker(const char *name, size_t length);
+
+// Returns 1 when the last dot-segment of the URL is a known video file extension (user rules are ignored)
+int VLCChannelClassifierIsMovieURL(const VLCChannelClassifier *classifier, const char *url, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCChannelClassifier_h */
@@ -10,6 +10,7 @@
 
 @class VLCChannel;
 @class VLCCacheManager;
+@class VLCPlaylistSource;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -17,6 +18,26 @@ NS_ASSUME_NONNULL_BEGIN
 typedef void (^VLCChannelLoadCompletion)(NSArray<VLCChannel *> * _Nullable channels, NSError * _Nullable error);
 typedef void (^VLCChannelProgressBlock)(float progress, NSString *status);
 
+// Result of a delta playlist refresh
+@interface VLCChannelChangeSet : NSObject
+@property (nonatomic, readonly) NSArray<VLCChannel *> *channels;          // Playlist after the refresh, in order
+@property (nonatomic, readonly) NSArray<VLCChannel *> *insertedChannels;
+@property (nonatomic, readonly) NSArray<VLCChannel *> *removedChannels;
+@property (nonatomic, readonly) NSArray<VLCChannel *> *updatedChannels;   // Same objects, new playlist fields
+@property (nonatomic, readonly) BOOL fullReload;                          // No previous list to diff against
+@property (nonatomic, readonly) BOOL reordered;                           // Kept channels (or groups) moved
+@property (nonatomic, readonly) BOOL isEmpty;
+
+- (instancetype)initWithChannels:(NSArray<VLCChannel *> *)channels
+                        inserted:(NSArray<VLCChannel *> *)insertedChannels
+                         removed:(NSArray<VLCChannel *> *)removedChannels
+                         updated:(NSArray<VLCChannel *> *)updatedChannels
+                       reordered:(BOOL)reordered
+                      fullReload:(BOOL)fullReload;
+@end
+
+typedef void (^VLCChannelRefreshCompletion)(VLCChannelChangeSet * _Nullable changes, NSError * _Nullable error);
+
 @interface VLCChannelManager : NSObject
 
 // Dependencies (injected for testability)
@@ -39,6 +60,24 @@ typedef void (^VLCChannelProgressBlock)(float progress, NSString *status);
 @property (nonatomic, assign) NSUInteger maxTotalChannels;
 @property (nonatomic, assign) BOOL enableMemoryOptimization;
 
+// Parsing settings (0 = one shard per active CPU core, 1 = serial parse)
+@property (nonatomic, assign) NSUInteger maxParsingThreads;
+
+// Category rules, applied before the built-in title/extension checks.
+// Keys are matched case-insensitively as substrings; values are TV, MOVIES or SERIES.
+// e.g. URL patterns @{@"/movie/": @"MOVIES", @"/series/": @"SERIES"}. Persisted in user defaults.
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *categoryGroupKeywords;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *categoryURLPatterns;
+
+// Xtream Codes playlists (get.php?username=&password=) are loaded from the player_api catalog
+// instead: categories plus live, VOD and series lists fetched in parallel and parsed as they
+// stream in, with catchup and VOD metadata included. Falls back to the M3U export when the
+// API fails. Persisted in user defaults.
+@property (nonatomic, assign) BOOL prefersXtreamCatalog;
+@property (nonatomic, readonly) BOOL loadedFromXtreamCatalog; // Catchup info already came with the channels
+// "server" (scheme, host and port), "username" and "password" of an Xtream get.php URL; nil otherwise
+- (NSDictionary<NSString *, NSString *> * _Nullable)xtreamAccountFromPlaylistURL:(NSString *)m3uURL;
+
 // Main operations
 - (void)loadChannelsFromURL:(NSString *)m3uURL 
                  completion:(VLCChannelLoadCompletion)completion
@@ -55,6 +94,31 @@ typedef void (^VLCChannelProgressBlock)(float progress, NSString *status);
              completion:(VLCChannelLoadCompletion)completion
                progress:(VLCChannelProgressBlock _Nullable)progressBlock;
 
+// Parses raw playlist bytes (e.g. a memory-mapped file) without decoding them to a string first
+- (void)parseM3UData:(NSData *)data
+          completion:(VLCChannelLoadCompletion)completion
+            progress:(VLCChannelProgressBlock _Nullable)progressBlock;
+
+// Delta refresh: re-downloads the playlist and only touches entries whose
+// #EXTINF line or URL changed. Unchanged channels keep their objects (and EPG).
+- (void)refreshChannelsFromURL:(NSString *)m3uURL
+                    completion:(VLCChannelRefreshCompletion)completion
+                      progress:(VLCChannelProgressBlock _Nullable)progressBlock;
+
+// Multiple playlists: sources load concurrently (each from its own cache or download) and are
+// merged in order. A stream an earlier source already has - same URL, or same tvg-id and
+// name - is dropped. Groups of non-primary sources are prefixed with the source name.
+- (void)loadChannelsFromSources:(NSArray<VLCPlaylistSource *> *)sources
+                    bypassCache:(BOOL)bypassCache
+                     completion:(VLCChannelLoadCompletion)completion
+                       progress:(VLCChannelProgressBlock _Nullable)progressBlock;
+
+// Re-downloads sourcesToRefresh only; the other sources keep their loaded channels
+- (void)refreshSources:(NSArray<VLCPlaylistSource *> *)sourcesToRefresh
+             ofSources:(NSArray<VLCPlaylistSource *> *)allSources
+            completion:(VLCChannelLoadCompletion)completion
+              progress:(VLCChannelProgressBlock _Nullable)progressBlock;
+
 // Data organization
 - (void)organizeChannelsIntoCategories;
 - (NSString *)determineCategoryForGroup:(NSString *)groupName;
@@ -11,8 +11,46 @@
 #import "VLCChannel.h"
 #import "VLCTimeshiftManager.h"
 #import "DownloadManager.h"
+#import "VLCM3UTokenizer.h"
+#import "VLCHashIndex.h"
+#import "VLCChannelClassifier.h"
+#import "VLCChannelStore.h"
+#import "VLCPlaylistSource.h"
+#import "VLCJSONRecordReader.h"
 #import <mach/mach.h>
 
+@class VLCChannelManager;
+
+// Per-shard state handed to the tokenizer callback
+typedef struct {
+    VLCChannelManager *manager;
+    NSMutableArray<VLCChannel *> *channels;
+    VLCM3USpan lastGroupSpan;   // Points into the buffer being tokenized
+    NSString *lastGroup;        // Autoreleased; lives only as long as the pool of that buffer
+    VLCChannelStore *store;     // Rows are appended here; one writer per store
+    NSString *groupPrefix;      // Secondary playlist sources: "<source>: " goes before every group
+} VLCM3UBuildContext;
+
+// A context that outlives one buffer must drop the cached group before tokenizing the next
+static inline void VLCM3UBuildContextForgetGroup(VLCM3UBuildContext *buildContext) {
+    buildContext->lastGroupSpan = (VLCM3USpan){ NULL, 0 };
+    buildContext->lastGroup = nil;
+}
+
+// State for diffing a fresh playlist against the loaded channels
+typedef struct {
+    VLCM3UBuildContext build;                          // Materializes new and changed entries only
+    NSArray<VLCChannel *> *previousChannels;
+    VLCHashIndex *previousIndex;                       // entry identity -> previous index + 1
+    VLCHashIndex *occurrences;                         // URL identity -> times seen in this pass
+    uint8_t *seen;                                     // One flag per previous channel
+    uint32_t lastPrevious;                             // Previous index + 1 of the last kept entry
+    BOOL reordered;                                    // A kept entry came before one it used to follow
+    NSMutableArray<VLCChannel *> *orderedChannels;     // New playlist order
+    NSMutableArray<VLCChannel *> *insertedChannels;
+    NSMutableArray<VLCChannel *> *updatedChannels;
+} VLCM3UDeltaContext;
+
 @interface VLCChannelManager ()
 
 // Internal data state
@@ -24,6 +62,7 @@
 
 // Loading state
 @property (nonatomic, assign) BOOL internalIsLoading;
+@property (nonatomic, assign) BOOL internalLoadedFromXtreamCatalog;
 @property (nonatomic, assign) float internalProgress;
 @property (nonatomic, strong) NSString *internalCurrentStatus;
 
@@ -34,6 +73,420 @@
 @property (nonatomic, strong) NSMutableDictionary *stringInternTable;
 @property (nonatomic, assign) NSUInteger processedChannelCount;
 
+// Playlist sources: each source's channels (by cache key), merged in source order
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSArray<VLCChannel *> *> *sourceChannels;
+
+// Category classification (rebuilt when the rules change; replaced ones stay alive
+// until dealloc because background parses may still be using them)
+@property (nonatomic, assign) VLCChannelClassifier *classifier;
+@property (nonatomic, strong) NSMutableArray<NSValue *> *retiredClassifiers;
+
+// M3U tokenizer integration
+- (VLCChannel *)channelFromM3UEntry:(const VLCM3UEntry *)entry buildContext:(VLCM3UBuildContext *)buildContext;
+- (void)applyPlaylistFieldsFromChannel:(VLCChannel *)source toChannel:(VLCChannel *)channel;
+
+@end
+
+static int VLCChannelManagerHandleM3UEntry(const VLCM3UEntry *entry, void *context);
+static int VLCChannelManagerHandleM3UDeltaEntry(const VLCM3UEntry *entry, void *context);
+
+#pragma mark - M3U Parse Session
+
+// Accumulates parsed channels in playlist order. Shared by the sharded merge and the
+// streaming parser so both build exactly what a serial parse would.
+@interface VLCM3UParseSession : NSObject {
+    NSMutableSet<NSString *> *_seenGroups;
+    NSMutableDictionary<NSString *, NSMutableSet<NSString *> *> *_seenGroupsByCategory;
+    VLCHashIndex *_identityOccurrences;
+}
+@property (nonatomic, readonly) NSMutableArray<VLCChannel *> *channels;
+@property (nonatomic, readonly) NSMutableArray<NSString *> *groups;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, NSMutableArray<VLCChannel *> *> *channelsByGroup;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, NSMutableArray<NSString *> *> *groupsByCategory;
+
+// Streaming state
+@property (nonatomic, readonly) NSMutableData *carry; // Bytes received but not yet tokenized
+@property (nonatomic, readonly) VLCChannelStore *store; // Rows of the streamed channels
+@property (nonatomic, assign) CFAbsoluteTime startTime;
+@property (nonatomic, assign) CFAbsoluteTime lastPublishTime;
+@property (nonatomic, assign) CFAbsoluteTime firstChannelsTime;
+@property (nonatomic, assign) int64_t bytesReceived;
+@property (nonatomic, assign) int64_t bytesExpected; // -1 when the server sends no length
+
+// NO when appended channels already carry final entry identities (delta refresh rebuilds)
+@property (nonatomic, assign) BOOL assignsEntryIdentities;
+
+// NO for playlist sources that are only shown once all sources are merged
+@property (nonatomic, assign) BOOL publishesPartialResults;
+@property (nonatomic, copy) NSString *groupPrefix;
+
+- (instancetype)initWithCategories:(NSArray<NSString *> *)categories;
+- (void)appendChannels:(NSArray<VLCChannel *> *)channels;
+@end
+
+@implementation VLCM3UParseSession
+
+- (instancetype)initWithCategories:(NSArray<NSString *> *)categories {
+    self = [super init];
+    if (self) {
+        _channels = [[NSMutableArray alloc] init];
+        _groups = [[NSMutableArray alloc] init];
+        _channelsByGroup = [[NSMutableDictionary alloc] init];
+        _groupsByCategory = [[NSMutableDictionary alloc] init];
+        _seenGroups = [[NSMutableSet alloc] init];
+        _seenGroupsByCategory = [[NSMutableDictionary alloc] init];
+        _carry = [[NSMutableData alloc] init];
+        _store = [[VLCChannelStore alloc] init];
+        _assignsEntryIdentities = YES;
+        _publishesPartialResults = YES;
+        
+        // Initialize categories
+        for (NSString *category in categories) {
+            if (![category isEqualToString:@"SETTINGS"]) {
+                [_groupsByCategory setObject:[NSMutableArray array] forKey:category];
+                [_seenGroupsByCategory setObject:[NSMutableSet set] forKey:category];
+            }
+        }
+    }
+    return self;
+}
+
+- (void)appendChannels:(NSArray<VLCChannel *> *)channels {
+    for (VLCChannel *currentChannel in channels) {
+        // Finalize channel - fallback ids depend on the global position, so assign them here
+        if (!currentChannel.channelId || currentChannel.channelId.length == 0) {
+            currentChannel.channelId = [NSString stringWithFormat:@"ch_%lu", (unsigned long)_channels.count];
+        }
+        
+        // Streams listed more than once get distinct identities by occurrence, in playlist order
+        if (_assignsEntryIdentities && currentChannel.entryIdentity) {
+            if (!_identityOccurrences) {
+                _identityOccurrences = VLCHashIndexCreate(channels.count);
+            }
+            uint32_t *occurrence = VLCHashIndexSlot(_identityOccurrences, currentChannel.entryIdentity);
+            if (occurrence) {
+                currentChannel.entryIdentity = VLCM3UIdentityWithOccurrence(currentChannel.entryIdentity, (*occurrence)++);
+            }
+        }
+        
+        // Add to collections
+        [_channels addObject:currentChannel];
+        
+        if (currentChannel.group && ![_seenGroups containsObject:currentChannel.group]) {
+            [_seenGroups addObject:currentChannel.group];
+            [_groups addObject:currentChannel.group];
+        }
+        
+        // Add to group collection
+        NSMutableArray<VLCChannel *> *groupChannels = [_channelsByGroup objectForKey:currentChannel.group];
+        if (!groupChannels) {
+            groupChannels = [NSMutableArray array];
+            [_channelsByGroup setObject:groupChannels forKey:currentChannel.group];
+        }
+        [groupChannels addObject:currentChannel];
+        
+        // Add to category collection
+        NSMutableArray<NSString *> *categoryGroups = [_groupsByCategory objectForKey:currentChannel.category];
+        NSMutableSet<NSString *> *categorySeen = [_seenGroupsByCategory objectForKey:currentChannel.category];
+        if (categoryGroups && ![categorySeen containsObject:currentChannel.group]) {
+            [categorySeen addObject:currentChannel.group];
+            [categoryGroups addObject:currentChannel.group];
+        }
+    }
+}
+
+- (void)dealloc {
+    [_channels release];
+    [_groups release];
+    [_channelsByGroup release];
+    [_groupsByCategory release];
+    [_seenGroups release];
+    [_seenGroupsByCategory release];
+    [_carry release];
+    [_store release];
+    [_groupPrefix release];
+    VLCHashIndexFree(_identityOccurrences);
+    [super dealloc];
+}
+
+@end
+
+#pragma mark - Xtream Catalog Call
+
+typedef NS_ENUM(NSUInteger, VLCXtreamListKind) {
+    VLCXtreamListLive = 0,
+    VLCXtreamListMovies,
+    VLCXtreamListSeries
+};
+
+static NSString *VLCStringFromJSONField(const VLCJSONField *field) {
+    if (!field || field->value.length == 0 ||
+        (field->type != VLCJSONValueString && field->type != VLCJSONValueNumber)) {
+        return nil;
+    }
+    return [[[NSString alloc] initWithBytes:field->value.bytes length:field->value.length encoding:NSUTF8StringEncoding] autorelease];
+}
+
+static VLCM3USpan VLCM3USpanFromJSONField(const VLCJSONField *field) {
+    VLCM3USpan span = { NULL, 0 };
+    if (field && field->type == VLCJSONValueString) {
+        span.bytes = field->value.bytes;
+        span.length = field->value.length;
+    }
+    return span;
+}
+
+// One player_api list (the categories or the streams of a kind) streamed into its own store.
+// Data arrives on the call's download queue; nothing else touches the call until it finished.
+@interface VLCXtreamCatalogCall : NSObject {
+    VLCJSONRecordReader *_reader;
+    char *_urlPrefix;               // "<server>/live/<user>/<pass>/", NUL terminated
+    char *_defaultExtension;
+    char _lastCategoryBytes[64];    // Streams come grouped by category; reuse its id string
+    size_t _lastCategoryLength;
+    NSString *_lastCategoryId;
+}
+@property (nonatomic, readonly) NSString *action;
+@property (nonatomic, readonly) VLCXtreamListKind kind;
+@property (nonatomic, readonly) BOOL listsCategories;
+@property (nonatomic, readonly) NSMutableArray<VLCChannel *> *channels;     // Group holds the category id until resolved
+@property (nonatomic, readonly) NSMutableArray<NSString *> *categoryIds;    // In catalog order
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, NSString *> *categoryNames;
+@property (nonatomic, readonly) VLCChannelStore *store;
+@property (nonatomic, assign) int64_t bytesReceived;
+@property (nonatomic, assign) CFAbsoluteTime elapsed;
+@property (nonatomic, strong) NSError *error;
+
+- (instancetype)initWithAction:(NSString *)action
+                          kind:(VLCXtreamListKind)kind
+               listsCategories:(BOOL)listsCategories
+                     urlPrefix:(NSString *)urlPrefix
+              defaultExtension:(NSString *)defaultExtension;
+- (void)consumeData:(NSData *)data;
+- (void)finishWithError:(NSError *)error;
+- (void)addRecordWithFields:(const VLCJSONField *)fields count:(size_t)count;
+@end
+
+static int VLCXtreamCatalogCallHandleRecord(const VLCJSONField *fields, size_t count, void *context) {
+    [(VLCXtreamCatalogCall *)context addRecordWithFields:fields count:count];
+    return 1;
+}
+
+@implementation VLCXtreamCatalogCall
+
+- (instancetype)initWithAction:(NSString *)action
+                          kind:(VLCXtreamListKind)kind
+               listsCategories:(BOOL)listsCategories
+                     urlPrefix:(NSString *)urlPrefix
+              defaultExtension:(NSString *)defaultExtension {
+    self = [super init];
+    if (self) {
+        _action = [action copy];
+        _kind = kind;
+        _listsCategories = listsCategories;
+        _reader = VLCJSONRecordReaderCreate(VLCXtreamCatalogCallHandleRecord, self);
+        _urlPrefix = strdup([urlPrefix UTF8String] ?: "");
+        _defaultExtension = strdup([defaultExtension UTF8String] ?: "");
+        _channels = [[NSMutableArray alloc] init];
+        _categoryIds = [[NSMutableArray alloc] init];
+        _categoryNames = [[NSMutableDictionary alloc] init];
+        _store = [[VLCChannelStore alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    VLCJSONRecordReaderFree(_reader);
+    free(_urlPrefix);
+    free(_defaultExtension);
+    [_lastCategoryId release];
+    [_action release];
+    [_channels release];
+    [_categoryIds release];
+    [_categoryNames release];
+    [_store release];
+    [_error release];
+    [super dealloc];
+}
+
+- (void)consumeData:(NSData *)data {
+    self.bytesReceived += data.length;
+    if (!self.error && !VLCJSONRecordReaderFeed(_reader, (const char *)data.bytes, data.length)) {
+        self.error = [NSError errorWithDomain:@"VLCChannelManager" 
+                                         code:1007 
+                                     userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Invalid %@ response", self.action]}];
+    }
+}
+
+- (void)finishWithError:(NSError *)error {
+    if (error) {
+        self.error = error;
+    } else if (!self.error && !VLCJSONRecordReaderFinish(_reader)) {
+        // Wrong credentials answer with {"user_info":{"auth":0}} instead of a list
+        self.error = [NSError errorWithDomain:@"VLCChannelManager" 
+                                         code:1007 
+                                     userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Invalid %@ response", self.action]}];
+    }
+    [self.store finishAppending];
+}
+
+- (NSString *)categoryIdForField:(const VLCJSONField *)field {
+    if (!field || field->value.length == 0 ||
+        (field->type != VLCJSONValueString && field->type != VLCJSONValueNumber)) {
+        return nil;
+    }
+    if (_lastCategoryId && field->value.length == _lastCategoryLength &&
+        memcmp(field->value.bytes, _lastCategoryBytes, _lastCategoryLength) == 0) {
+        return _lastCategoryId;
+    }
+    NSString *categoryId = VLCStringFromJSONField(field);
+    if (field->value.length <= sizeof(_lastCategoryBytes)) {
+        memcpy(_lastCategoryBytes, field->value.bytes, field->value.length);
+        _lastCategoryLength = field->value.length;
+        [_lastCategoryId release];
+        _lastCategoryId = [categoryId retain];
+    }
+    return categoryId;
+}
+
+- (void)addRecordWithFields:(const VLCJSONField *)fields count:(size_t)count {
+    if (self.listsCategories) {
+        NSString *categoryId = VLCStringFromJSONField(VLCJSONFindField(fields, count, "category_id"));
+        if (categoryId && ![self.categoryNames objectForKey:categoryId]) {
+            [self.categoryIds addObject:categoryId];
+            [self.categoryNames setObject:VLCStringFromJSONField(VLCJSONFindField(fields, count, "category_name")) ?: @"" 
+                                   forKey:categoryId];
+        }
+        return;
+    }
+    
+    BOOL series = self.kind == VLCXtreamListSeries;
+    long long streamId = VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, series ? "series_id" : "stream_id"), -1);
+    if (streamId < 0) {
+        return;
+    }
+    
+    // Stream URLs exactly as get.php writes them, so favorites and caches keep matching
+    char url[2048];
+    int urlLength;
+    if (series) {
+        urlLength = snprintf(url, sizeof(url), "%s%lld", _urlPrefix, streamId);
+    } else {
+        const VLCJSONField *extension = self.kind == VLCXtreamListMovies ? VLCJSONFindField(fields, count, "container_extension") : NULL;
+        if (extension && extension->type == VLCJSONValueString && extension->value.length > 0) {
+            urlLength = snprintf(url, sizeof(url), "%s%lld.%.*s", _urlPrefix, streamId,
+                                 (int)extension->value.length, extension->value.bytes);
+        } else {
+            urlLength = snprintf(url, sizeof(url), "%s%lld.%s", _urlPrefix, streamId, _defaultExtension);
+        }
+    }
+    if (urlLength <= 0 || (size_t)urlLength >= sizeof(url)) {
+        return;
+    }
+    
+    VLCChannelStoreRow row;
+    memset(&row, 0, sizeof(row));
+    row.strings[VLCChannelStoreFieldName] = VLCM3USpanFromJSONField(VLCJSONFindField(fields, count, "name"));
+    row.strings[VLCChannelStoreFieldLogo] = VLCM3USpanFromJSONField(VLCJSONFindField(fields, count, series ? "cover" : "stream_icon"));
+    row.strings[VLCChannelStoreFieldURL] = (VLCM3USpan){ url, (size_t)urlLength };
+    row.group = [self categoryIdForField:VLCJSONFindField(fields, count, "category_id")];
+    
+    // The API says what a stream is; no name or URL heuristics needed
+    switch (self.kind) {
+        case VLCXtreamListLive: row.category = @"TV"; break;
+        case VLCXtreamListMovies: row.category = @"MOVIES"; break;
+        case VLCXtreamListSeries: row.category = @"SERIES"; break;
+    }
+    
+    // Catchup - same rules as VLCTimeshiftManager processAPIResponse:, without the extra request
+    if (self.kind == VLCXtreamListLive) {
+        row.strings[VLCChannelStoreFieldChannelId] = VLCM3USpanFromJSONField(VLCJSONFindField(fields, count, "epg_channel_id"));
+        long long archiveDays = VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "tv_archive_duration"), 0);
+        if (VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "tv_archive"), 0) > 0 && archiveDays > 0) {
+            row.supportsCatchup = YES;
+            row.catchupDays = (NSInteger)archiveDays;
+            row.strings[VLCChannelStoreFieldCatchupSource] = (VLCM3USpan){ "default", 7 };
+        }
+    }
+    
+    // Delta refresh keys: the record's fields stand in for the #EXTINF line
+    uint64_t fingerprint = VLC_HASH_SEED;
+    for (size_t i = 0; i < count; i++) {
+        fingerprint = VLCHashBytes(fields[i].key.bytes, fields[i].key.length, fingerprint);
+        fingerprint = VLCHashBytes(fields[i].value.bytes, fields[i].value.length, fingerprint);
+    }
+    row.entryFingerprint = fingerprint;
+    row.entryIdentity = VLCHashBytes(url, (size_t)urlLength, VLC_HASH_SEED);
+    
+    VLCChannel *channel = [self.store appendRow:&row];
+    if (!channel) {
+        // Store full (16M rows) - fall back to a standalone channel
+        channel = [[[VLCChannel alloc] init] autorelease];
+        channel.name = VLCStringFromJSONField(VLCJSONFindField(fields, count, "name")) ?: @"";
+        channel.url = [[[NSString alloc] initWithBytes:url length:(NSUInteger)urlLength encoding:NSUTF8StringEncoding] autorelease];
+        channel.group = row.group ?: @"";
+        channel.category = row.category;
+        channel.supportsCatchup = row.supportsCatchup;
+        channel.catchupDays = row.catchupDays;
+        channel.catchupSource = row.supportsCatchup ? @"default" : nil;
+        channel.entryFingerprint = row.entryFingerprint;
+        channel.entryIdentity = row.entryIdentity;
+    }
+    
+    // VOD metadata that otherwise takes a get_vod_info request per title
+    if (self.kind != VLCXtreamListLive) {
+        channel.movieId = [NSString stringWithFormat:@"%lld", streamId];
+        channel.movieRating = VLCStringFromJSONField(VLCJSONFindField(fields, count, "rating"));
+    }
+    if (series) {
+        channel.movieDescription = VLCStringFromJSONField(VLCJSONFindField(fields, count, "plot"));
+        channel.movieGenre = VLCStringFromJSONField(VLCJSONFindField(fields, count, "genre"));
+        channel.movieCast = VLCStringFromJSONField(VLCJSONFindField(fields, count, "cast"));
+        channel.movieDirector = VLCStringFromJSONField(VLCJSONFindField(fields, count, "director"));
+        NSString *releaseDate = VLCStringFromJSONField(VLCJSONFindField(fields, count, "releaseDate"));
+        channel.movieYear = releaseDate.length >= 4 ? [releaseDate substringToIndex:4] : nil;
+    }
+    
+    [self.channels addObject:channel];
+}
+
+@end
+
+#pragma mark - Channel Change Set
+
+@implementation VLCChannelChangeSet
+
+- (instancetype)initWithChannels:(NSArray<VLCChannel *> *)channels
+                        inserted:(NSArray<VLCChannel *> *)insertedChannels
+                         removed:(NSArray<VLCChannel *> *)removedChannels
+                         updated:(NSArray<VLCChannel *> *)updatedChannels
+                       reordered:(BOOL)reordered
+                      fullReload:(BOOL)fullReload {
+    self = [super init];
+    if (self) {
+        _channels = [channels copy];
+        _insertedChannels = [insertedChannels copy];
+        _removedChannels = [removedChannels copy];
+        _updatedChannels = [updatedChannels copy];
+        _reordered = reordered;
+        _fullReload = fullReload;
+    }
+    return self;
+}
+
+- (BOOL)isEmpty {
+    return !_fullReload && !_reordered &&
+           _insertedChannels.count == 0 && _removedChannels.count == 0 && _updatedChannels.count == 0;
+}
+
+- (void)dealloc {
+    [_channels release];
+    [_insertedChannels release];
+    [_removedChannels release];
+    [_updatedChannels release];
+    [super dealloc];
+}
+
 @end
 
 @implementation VLCChannelManager
@@ -53,6 +506,7 @@
     self.maxChannelsPerGroup = NSUIntegerMax;
     self.maxTotalChannels = NSUIntegerMax;
     self.enableMemoryOptimization = YES;
+    self.maxParsingThreads = 0; // One shard per active core
     
     self.internalIsLoading = NO;
     self.internalProgress = 0.0;
@@ -60,6 +514,27 @@
     
     // Create timeshift manager for integration
     self.timeshiftManager = [[VLCTimeshiftManager alloc] init];
+    
+    // Category rules configured by the user
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    _categoryGroupKeywords = [[defaults dictionaryForKey:@"CategoryGroupKeywords"] copy];
+    _categoryURLPatterns = [[defaults dictionaryForKey:@"CategoryURLPatterns"] copy];
+    _prefersXtreamCatalog = [defaults boolForKey:@"PrefersXtreamCatalog"];
+    self.retiredClassifiers = [[NSMutableArray alloc] init];
+    [self rebuildClassifier];
+    
+    self.sourceChannels = [NSMutableDictionary dictionary];
+}
+
+- (void)dealloc {
+    VLCChannelClassifierFree(_classifier);
+    for (NSValue *retired in _retiredClassifiers) {
+        VLCChannelClassifierFree((VLCChannelClassifier *)[retired pointerValue]);
+    }
+    [_retiredClassifiers release];
+    [_categoryGroupKeywords release];
+    [_categoryURLPatterns release];
+    [super dealloc];
 }
 
 - (void)initializeDataStructures {
@@ -115,6 +590,12 @@
 }
 
 - (BOOL)isLoading { return self.internalIsLoading; }
+- (BOOL)loadedFromXtreamCatalog { return self.internalLoadedFromXtreamCatalog; }
+
+- (void)setPrefersXtreamCatalog:(BOOL)prefersXtreamCatalog {
+    _prefersXtreamCatalog = prefersXtreamCatalog;
+    [[NSUserDefaults standardUserDefaults] setBool:prefersXtreamCatalog forKey:@"PrefersXtreamCatalog"];
+}
 - (float)progress { return self.internalProgress; }
 - (NSString *)currentStatus { return self.internalCurrentStatus ?: @""; }
 
@@ -164,6 +645,13 @@
             return;
         }
         
+        // Expired cache - keep its channels and only apply what changed in the playlist
+        if ([cacheError.domain isEqualToString:@"VLCCacheManager"] && cacheError.code == 3004) {
+            NSLog(@"📊 [CHANNEL] Cache expired - refreshing it with a delta update");
+            [strongSelf refreshExpiredCacheFromURL:m3uURL completion:completion progress:progressBlock];
+            return;
+        }
+        
         // Cache miss or invalid - download from URL
         NSLog(@"📊 [CHANNEL] Cache miss - downloading from URL");
         [strongSelf downloadAndParseM3U:m3uURL completion:completion progress:progressBlock];
@@ -179,86 +667,199 @@
         progressBlock(0.05, self.internalCurrentStatus);
     }
     
-    // Use DownloadManager for async download with progress
-    DownloadManager *downloadManager = [[DownloadManager alloc] init];
-    
-    // Create temporary file path for download
-    NSString *tempFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"temp_playlist.m3u"];
+    // Settings is usable while the playlist is still streaming in
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self publishImmediateSettingsChannel];
+    });
     
-    [downloadManager startDownloadFromURL:m3uURL
-                         progressHandler:^(int64_t totalBytesWritten, int64_t totalBytesExpectedToWrite) {
-        // Update progress during download (0.05 to 0.1 = 5% of total progress)
-        float downloadProgress = 0.05 + (0.05 * ((float)totalBytesWritten / (float)totalBytesExpectedToWrite));
-        NSString *progressStatus = [NSString stringWithFormat:@"🌐 Downloading M3U: %.1f MB / %.1f MB", 
-                                  totalBytesWritten / 1024.0 / 1024.0, 
-                                  totalBytesExpectedToWrite / 1024.0 / 1024.0];
-        
-        // Log progress to console so user can see it
-        NSLog(@"%@", progressStatus);
-        
-        dispatch_async(dispatch_get_main_queue(), ^{
-            if (progressBlock) {
-                progressBlock(downloadProgress, progressStatus);
+    NSDictionary<NSString *, NSString *> *account = self.prefersXtreamCatalog ? [self xtreamAccountFromPlaylistURL:m3uURL] : nil;
+    if (account) {
+        [self loadXtreamCatalogForAccount:account progress:progressBlock completion:^(VLCM3UParseSession *session, NSError *error) {
+            if (session) {
+                self.internalLoadedFromXtreamCatalog = YES;
+                [self finishM3UParsingWithSession:session completion:completion];
+                return;
             }
-        });
+            NSLog(@"⚠️ [CHANNEL] Xtream catalog unavailable (%@) - loading the M3U playlist instead", error.localizedDescription);
+            [self streamAndParseM3U:m3uURL completion:completion progress:progressBlock];
+        }];
+        return;
     }
-                       completionHandler:^(NSString *filePath, NSError *error) {
-        if (error || !filePath) {
-            NSLog(@"❌ [CHANNEL] Download failed: %@", error.localizedDescription);
-            dispatch_async(dispatch_get_main_queue(), ^{
+    
+    [self streamAndParseM3U:m3uURL completion:completion progress:progressBlock];
+}
+
+- (void)streamAndParseM3U:(NSString *)m3uURL
+               completion:(VLCChannelLoadCompletion)completion
+                 progress:(VLCChannelProgressBlock)progressBlock {
+    
+    self.internalLoadedFromXtreamCatalog = NO;
+    
+    // Stream the playlist straight into the tokenizer; parsing overlaps the download
+    // and nothing is written to disk
+    VLCM3UParseSession *session = [[VLCM3UParseSession alloc] initWithCategories:self.internalCategories];
+    
+    [self streamM3UFromURL:m3uURL session:session progress:progressBlock completion:^(NSError *error) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (error) {
                 self.internalIsLoading = NO;
                 if (completion) {
                     completion(nil, error);
                 }
-            });
+            } else {
+                [self finishM3UParsingWithSession:session completion:completion];
+            }
+            [session release];
+        });
+    }];
+}
+
+// Downloads and tokenizes a playlist into session. completion runs on the download queue
+// once the last entry is in the session, or with the download error.
+- (void)streamM3UFromURL:(NSString *)m3uURL
+                 session:(VLCM3UParseSession *)session
+                progress:(VLCChannelProgressBlock)progressBlock
+              completion:(void (^)(NSError *error))completion {
+    
+    session.startTime = CFAbsoluteTimeGetCurrent();
+    session.bytesExpected = -1;
+    
+    DownloadManager *downloadManager = [[DownloadManager alloc] init];
+    
+    [downloadManager startStreamingFromURL:m3uURL
+                           progressHandler:^(int64_t totalBytesReceived, int64_t totalBytesExpected) {
+        // Progress is reported from the data handler together with the channel counts
+        session.bytesExpected = totalBytesExpected;
+    }
+                               dataHandler:^(NSData *data) {
+        [self consumeM3UStreamData:data session:session progress:progressBlock];
+    }
+                         completionHandler:^(NSError *error) {
+        if (error) {
+            NSLog(@"❌ [CHANNEL] Download failed: %@", error.localizedDescription);
+            completion(error);
             [downloadManager release];
             return;
         }
         
-        // Read downloaded data
-        NSData *m3uData = [NSData dataWithContentsOfFile:filePath];
-        if (!m3uData) {
-            NSError *readError = [NSError errorWithDomain:@"VLCChannelManager" 
-                                                     code:1002 
-                                                 userInfo:@{NSLocalizedDescriptionKey: @"Failed to read downloaded M3U file"}];
-            dispatch_async(dispatch_get_main_queue(), ^{
-                self.internalIsLoading = NO;
-                if (completion) {
-                    completion(nil, readError);
-                }
-            });
+        if (session.bytesReceived == 0) {
+            NSLog(@"❌ [CHANNEL] Empty M3U content");
+            completion([NSError errorWithDomain:@"VLCChannelManager" 
+                                           code:1004 
+                                       userInfo:@{NSLocalizedDescriptionKey: @"Empty M3U content"}]);
             [downloadManager release];
             return;
         }
         
-        NSLog(@"✅ [CHANNEL] 🌐 Successfully downloaded M3U playlist: %lu bytes", (unsigned long)m3uData.length);
+        // Flush the tail: the last line may have no trailing newline
+        @autoreleasepool {
+            NSMutableArray<VLCChannel *> *parsed = [[NSMutableArray alloc] init];
+            VLCM3UBuildContext buildContext = { self, parsed, { NULL, 0 }, nil, session.store, session.groupPrefix };
+            VLCM3UTokenizeBuffer((const char *)session.carry.bytes, session.carry.length, 0, 0,
+                                 VLCChannelManagerHandleM3UEntry, &buildContext, NULL);
+            [session appendChannels:parsed];
+            [parsed release];
+            session.carry.length = 0;
+            [session.store finishAppending];
+        }
         
-        // Parse the downloaded content
-        NSString *m3uContent = [[NSString alloc] initWithData:m3uData encoding:NSUTF8StringEncoding];
-        if (!m3uContent) {
-            NSLog(@"❌ [CHANNEL] Failed to decode M3U content");
-            NSError *decodeError = [NSError errorWithDomain:@"VLCChannelManager" 
-                                                       code:1003 
-                                                   userInfo:@{NSLocalizedDescriptionKey: @"Failed to decode M3U content"}];
-            dispatch_async(dispatch_get_main_queue(), ^{
-                self.internalIsLoading = NO;
-                if (completion) {
-                    completion(nil, decodeError);
-                }
-            });
-            [downloadManager release];
+        CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - session.startTime;
+        double megabytes = session.bytesReceived / 1024.0 / 1024.0;
+        NSLog(@"✅ [CHANNEL] 🌐 Successfully streamed M3U playlist: %lld bytes", session.bytesReceived);
+        NSLog(@"🚀 [M3U-PERF] Streamed and parsed %.1f MB in %.2fs (first 100 channels after %.2fs, %.1f MB/s, %.0f channels/s) • RSS %luMB, peak %luMB",
+              megabytes, elapsed, session.firstChannelsTime,
+              elapsed > 0 ? megabytes / elapsed : 0.0,
+              elapsed > 0 ? session.channels.count / elapsed : 0.0,
+              (unsigned long)[VLCChannelManager getCurrentMemoryUsageMB],
+              (unsigned long)[VLCChannelManager getPeakMemoryUsageMB]);
+        NSLog(@"🚀 [M3U-PERF] Channel store: %.1f MB for %lu channels (%.0f bytes/channel + facades)",
+              session.store.bytesAllocated / 1024.0 / 1024.0, (unsigned long)session.channels.count,
+              session.channels.count > 0 ? (double)session.store.bytesAllocated / session.channels.count : 0.0);
+        
+        completion(nil);
+        [downloadManager release];
+    }];
+}
+
+// Runs on the download delegate queue, which is serial, so chunks arrive in order
+- (void)consumeM3UStreamData:(NSData *)data
+                     session:(VLCM3UParseSession *)session
+                    progress:(VLCChannelProgressBlock)progressBlock {
+    
+    const NSUInteger FIRST_PUBLISH_COUNT = 100;    // Show the first screenful as soon as it exists
+    const CFAbsoluteTime PUBLISH_INTERVAL = 1.0;  // Then refresh the partial list once per second
+    
+    @autoreleasepool {
+        session.bytesReceived += data.length;
+        
+        NSMutableArray<VLCChannel *> *parsed = [[NSMutableArray alloc] init];
+        VLCM3UBuildContext buildContext = { self, parsed, { NULL, 0 }, nil, session.store, session.groupPrefix };
+        NSMutableData *carry = session.carry;
+        
+        if (carry.length == 0) {
+            // Common case: tokenize the received bytes in place and keep only the unfinished tail
+            size_t consumed = VLCM3UTokenizePartialBuffer((const char *)data.bytes, data.length,
+                                                          VLCChannelManagerHandleM3UEntry, &buildContext, NULL);
+            [carry appendBytes:(const char *)data.bytes + consumed length:data.length - consumed];
+        } else {
+            [carry appendData:data];
+            size_t consumed = VLCM3UTokenizePartialBuffer((const char *)carry.bytes, carry.length,
+                                                          VLCChannelManagerHandleM3UEntry, &buildContext, NULL);
+            [carry replaceBytesInRange:NSMakeRange(0, consumed) withBytes:NULL length:0];
+        }
+        
+        [session appendChannels:parsed];
+        [parsed release];
+        
+        CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+        BOOL firstScreenful = session.firstChannelsTime == 0 && session.channels.count >= FIRST_PUBLISH_COUNT;
+        if (firstScreenful) {
+            session.firstChannelsTime = now - session.startTime;
+        }
+        if (!session.publishesPartialResults || (!firstScreenful && now - session.lastPublishTime < PUBLISH_INTERVAL)) {
             return;
         }
+        session.lastPublishTime = now;
         
-        // Clean up temp file
-        [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+        // Snapshot the partial lists; the session keeps mutating them on this queue
+        NSMutableArray<VLCChannel *> *channels = [session.channels mutableCopy];
+        NSMutableArray<NSString *> *groups = [session.groups mutableCopy];
+        NSMutableDictionary<NSString *, NSMutableArray<VLCChannel *> *> *channelsByGroup = [[NSMutableDictionary alloc] init];
+        for (NSString *group in session.channelsByGroup) {
+            [channelsByGroup setObject:[[session.channelsByGroup[group] mutableCopy] autorelease] forKey:group];
+        }
+        NSMutableDictionary<NSString *, NSMutableArray<NSString *> *> *groupsByCategory = [[NSMutableDictionary alloc] init];
+        for (NSString *category in session.groupsByCategory) {
+            [groupsByCategory setObject:[[session.groupsByCategory[category] mutableCopy] autorelease] forKey:category];
+        }
+        [self addSettingsChannelToChannels:channels groups:groups channelsByGroup:channelsByGroup groupsByCategory:groupsByCategory];
         
-        // Parse the content (0.1 to 1.0 = remaining 90% for parsing)
-        [self parseM3UContent:m3uContent completion:completion progress:progressBlock];
+        int64_t bytesReceived = session.bytesReceived;
+        int64_t bytesExpected = session.bytesExpected;
+        NSString *status = [NSString stringWithFormat:@"🌐 Streaming M3U: %.1f MB • %lu channels • %lu groups", 
+                           bytesReceived / 1024.0 / 1024.0, (unsigned long)(channels.count - 1), (unsigned long)(groups.count - 1)];
+        NSLog(@"%@", status);
         
-        [downloadManager release];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self updateInternalDataWithChannels:channels 
+                                          groups:groups 
+                                 channelsByGroup:channelsByGroup 
+                                groupsByCategory:groupsByCategory];
+            [channels release];
+            [groups release];
+            [channelsByGroup release];
+            [groupsByCategory release];
+            
+            // Download and parse overlap, so bytes received drive the whole 0.1 - 0.9 range.
+            // Generated playlists often have no length; hold at the midpoint then.
+            float progress = bytesExpected > 0 ? 0.1 + (0.8 * (float)bytesReceived / (float)bytesExpected) : 0.5;
+            self.internalProgress = progress;
+            self.internalCurrentStatus = status;
+            if (progressBlock) {
+                progressBlock(progress, status);
+            }
+        });
     }
-                         destinationPath:tempFilePath];
 }
 
 - (NSData *)downloadDataFromURL:(NSString *)urlString error:(NSError **)error {
@@ -303,290 +904,1202 @@
         return;
     }
     
-    NSLog(@"📊 [CHANNEL] Starting M3U parsing - %lu characters", (unsigned long)content.length);
-    
-    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        [self performM3UParsingWithContent:content completion:completion progress:progressBlock];
-    });
+    // The tokenizer works on raw bytes; string callers pay one UTF-8 encode here
+    [self parseM3UData:[content dataUsingEncoding:NSUTF8StringEncoding allowLossyConversion:YES]
+            completion:completion
+              progress:progressBlock];
+}
+
+- (void)parseM3UData:(NSData *)data
+          completion:(VLCChannelLoadCompletion)completion
+            progress:(VLCChannelProgressBlock)progressBlock {
+    
+    if (!data || data.length == 0) {
+        NSLog(@"❌ [CHANNEL] Empty M3U content");
+        NSError *error = [NSError errorWithDomain:@"VLCChannelManager" 
+                                           code:1004 
+                                       userInfo:@{NSLocalizedDescriptionKey: @"Empty M3U content"}];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self.internalIsLoading = NO;
+            if (completion) {
+                completion(nil, error);
+            }
+        });
+        return;
+    }
+    
+    NSLog(@"📊 [CHANNEL] Starting M3U parsing - %lu bytes", (unsigned long)data.length);
+    
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [self performM3UParsingWithData:data completion:completion progress:progressBlock];
+    });
+}
+
+- (void)performM3UParsingWithData:(NSData *)data
+                       completion:(VLCChannelLoadCompletion)completion
+                         progress:(VLCChannelProgressBlock)progressBlock {
+    
+    NSLog(@"📊 [CHANNEL] 🚀 Starting NON-BLOCKING M3U parsing - %lu bytes", (unsigned long)data.length);
+    
+    // IMMEDIATE Settings delivery for instant UI responsiveness
+            dispatch_async(dispatch_get_main_queue(), ^{
+        self.internalCurrentStatus = @"🚀 Preparing channel processing...";
+                if (progressBlock) {
+                    progressBlock(0.1, self.internalCurrentStatus);
+                }
+        
+        // Create minimal Settings structure immediately for UI
+        [self publishImmediateSettingsChannel];
+        
+        // DO NOT call completion immediately - wait for sharded parsing to complete
+        
+        // Now start parallel parsing for full channel list
+        [self startShardedParsing:data completion:completion progress:progressBlock];
+    });
+}
+            
+- (void)publishImmediateSettingsChannel {
+    // Create minimal Settings structure immediately for UI
+    VLCChannel *settingsChannel = [[VLCChannel alloc] init];
+    settingsChannel.name = @"Settings";
+    settingsChannel.group = @"Settings";
+    settingsChannel.category = @"SETTINGS";
+    settingsChannel.url = @"settings://menu";
+    settingsChannel.channelId = @"settings_menu";
+    
+    NSArray *immediateChannels = @[settingsChannel];
+    NSArray *immediateGroups = @[@"Settings"];
+    NSDictionary *immediateChannelsByGroup = @{@"Settings": immediateChannels};
+    NSDictionary *immediateGroupsByCategory = @{@"SETTINGS": immediateGroups};
+    
+    // Update internal data immediately
+    [self updateInternalDataWithChannels:immediateChannels 
+                                  groups:immediateGroups 
+                         channelsByGroup:immediateChannelsByGroup 
+                        groupsByCategory:immediateGroupsByCategory];
+    
+    NSLog(@"🚀 [CHANNEL] IMMEDIATE: Settings channel available for navigation");
+}
+
+- (NSUInteger)parsingShardCountForLength:(NSUInteger)length {
+    const NSUInteger MIN_SHARD_BYTES = 256 * 1024; // Smaller shards cost more in dispatch than they save
+    NSUInteger threads = self.maxParsingThreads > 0 ? self.maxParsingThreads : [[NSProcessInfo processInfo] activeProcessorCount];
+    NSUInteger bySize = MAX((NSUInteger)1, length / MIN_SHARD_BYTES);
+    return MAX((NSUInteger)1, MIN(threads, bySize));
+}
+
+- (void)startShardedParsing:(NSData *)data
+                 completion:(VLCChannelLoadCompletion)completion
+                   progress:(VLCChannelProgressBlock)progressBlock {
+    
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        const char *bytes = (const char *)data.bytes;
+        size_t length = data.length;
+        
+        // Split at #EXTINF boundaries so every entry lives entirely inside one shard
+        NSUInteger shardCount = [self parsingShardCountForLength:length];
+        size_t *boundaries = malloc((shardCount + 1) * sizeof(size_t));
+        boundaries[0] = 0;
+        for (NSUInteger i = 1; i < shardCount; i++) {
+            size_t target = (size_t)(((unsigned long long)length * i) / shardCount);
+            boundaries[i] = VLCM3UFindEntryStart(bytes, length, MAX(target, boundaries[i - 1]));
+        }
+        boundaries[shardCount] = length;
+        
+        NSLog(@"🚀 [CHANNEL] Starting sharded parsing - %lu bytes across %lu shards", (unsigned long)length, (unsigned long)shardCount);
+        
+        // Parse shards on all cores; each shard owns its output array, so no locking while tokenizing
+        NSMutableArray<VLCChannel *> **shardChannels = calloc(shardCount, sizeof(NSMutableArray *));
+        VLCChannelStore **shardStores = calloc(shardCount, sizeof(VLCChannelStore *));
+        __block NSUInteger completedShards = 0;
+        __block NSUInteger parsedChannels = 0;
+        
+        dispatch_apply(shardCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t shard) {
+            @autoreleasepool {
+                NSMutableArray<VLCChannel *> *channels = [[NSMutableArray alloc] init];
+                VLCChannelStore *store = [[VLCChannelStore alloc] init];
+                VLCM3UBuildContext buildContext = { self, channels, { NULL, 0 }, nil, store, nil };
+                VLCM3UTokenizeBuffer(bytes, boundaries[shard + 1], boundaries[shard], 0,
+                                     VLCChannelManagerHandleM3UEntry, &buildContext, NULL);
+                [store finishAppending];
+                shardChannels[shard] = channels;
+                shardStores[shard] = store;
+                
+                NSUInteger finished;
+                NSUInteger channelTotal;
+                @synchronized (self) {
+                    finished = ++completedShards;
+                    parsedChannels += channels.count;
+                    channelTotal = parsedChannels;
+                }
+                
+                float progress = 0.1 + (0.8 * (float)finished / (float)shardCount);
+                NSString *status = [NSString stringWithFormat:@"📊 Processing M3U: %lu/%lu shards • %lu channels", 
+                                   (unsigned long)finished, (unsigned long)shardCount, (unsigned long)channelTotal];
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    self.internalProgress = progress;
+                    self.internalCurrentStatus = status;
+                    if (progressBlock) {
+                        progressBlock(progress, status);
+                    }
+                });
+            }
+        });
+        CFAbsoluteTime parseTime = CFAbsoluteTimeGetCurrent() - startTime;
+        
+        // Merge in shard order - channel order, group first appearance and groupsByCategory
+        // come out exactly as a serial parse would produce them
+        VLCM3UParseSession *session = [[VLCM3UParseSession alloc] initWithCategories:self.internalCategories];
+        size_t storeBytes = 0;
+        for (NSUInteger shard = 0; shard < shardCount; shard++) {
+            [session appendChannels:shardChannels[shard]];
+            [shardChannels[shard] release];
+            // Channels keep their shard's store alive
+            storeBytes += shardStores[shard].bytesAllocated;
+            [shardStores[shard] release];
+        }
+        free(shardChannels);
+        free(shardStores);
+        free(boundaries);
+        
+        CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - startTime;
+        double megabytes = length / 1024.0 / 1024.0;
+        NSLog(@"🚀 [M3U-PERF] Parsed %.1f MB in %.2fs on %lu shards (tokenize %.2fs, merge %.2fs, %.1f MB/s, %.0f channels/s) • RSS %luMB, peak %luMB",
+              megabytes, elapsed, (unsigned long)shardCount, parseTime, elapsed - parseTime,
+              elapsed > 0 ? megabytes / elapsed : 0.0,
+              elapsed > 0 ? session.channels.count / elapsed : 0.0,
+              (unsigned long)[VLCChannelManager getCurrentMemoryUsageMB],
+              (unsigned long)[VLCChannelManager getPeakMemoryUsageMB]);
+        NSLog(@"🚀 [M3U-PERF] Channel store: %.1f MB for %lu channels (%.0f bytes/channel + facades)",
+              storeBytes / 1024.0 / 1024.0, (unsigned long)session.channels.count,
+              session.channels.count > 0 ? (double)storeBytes / session.channels.count : 0.0);
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self finishM3UParsingWithSession:session completion:completion];
+            [session release];
+        });
+    });
+}
+
+// Adds the Settings entry every channel list starts with
+- (void)addSettingsChannelToChannels:(NSMutableArray<VLCChannel *> *)allChannels
+                              groups:(NSMutableArray<NSString *> *)allGroups
+                     channelsByGroup:(NSMutableDictionary<NSString *, NSMutableArray<VLCChannel *> *> *)allChannelsByGroup
+                    groupsByCategory:(NSMutableDictionary<NSString *, NSMutableArray<NSString *> *> *)allGroupsByCategory {
+    
+    // Create Settings channel for final result
+    VLCChannel *settingsChannel = [[VLCChannel alloc] init];
+    settingsChannel.name = @"Settings";
+    settingsChannel.group = @"Settings";
+    settingsChannel.category = @"SETTINGS";
+    settingsChannel.url = @"settings://menu";
+    settingsChannel.channelId = @"settings_menu";
+    
+    // Add Settings to final collections
+    [allChannels insertObject:settingsChannel atIndex:0]; // Add at beginning
+    if (![allGroups containsObject:@"Settings"]) {
+        [allGroups addObject:@"Settings"];
+    }
+    
+    // Add Settings to group collection
+    NSMutableArray<VLCChannel *> *settingsGroupChannels = [[NSMutableArray alloc] init];
+    [settingsGroupChannels addObject:settingsChannel];
+    [allChannelsByGroup setObject:settingsGroupChannels forKey:@"Settings"];
+    
+    // Add Settings to category collection
+    NSMutableArray<NSString *> *settingsCategoryGroups = [allGroupsByCategory objectForKey:@"SETTINGS"];
+    if (!settingsCategoryGroups) {
+        settingsCategoryGroups = [[NSMutableArray alloc] init];
+        [allGroupsByCategory setObject:settingsCategoryGroups forKey:@"SETTINGS"];
+    }
+    if (![settingsCategoryGroups containsObject:@"Settings"]) {
+        [settingsCategoryGroups addObject:@"Settings"];
+    }
+    
+    [settingsChannel release];
+    [settingsGroupChannels release];
+}
+
+- (void)finishM3UParsingWithSession:(VLCM3UParseSession *)session
+                         completion:(VLCChannelLoadCompletion)completion {
+    
+    NSMutableArray<VLCChannel *> *allChannels = session.channels;
+    NSMutableArray<NSString *> *allGroups = session.groups;
+    NSMutableDictionary<NSString *, NSMutableArray<VLCChannel *> *> *allChannelsByGroup = session.channelsByGroup;
+    NSMutableDictionary<NSString *, NSMutableArray<NSString *> *> *allGroupsByCategory = session.groupsByCategory;
+    
+    // Parsing complete - Add Settings channel to final result
+    NSLog(@"🚀 [CHANNEL] M3U parsing completed: %lu channels", (unsigned long)allChannels.count);
+    
+    [self addSettingsChannelToChannels:allChannels
+                                groups:allGroups
+                       channelsByGroup:allChannelsByGroup
+                      groupsByCategory:allGroupsByCategory];
+    
+    // Debug: Log category distribution
+    NSLog(@"📊 [CATEGORY-DEBUG] Category distribution:");
+    for (NSString *category in allGroupsByCategory) {
+        NSArray *groupsInCategory = [allGroupsByCategory objectForKey:category];
+        NSUInteger channelCount = 0;
+        for (NSString *group in groupsInCategory) {
+            NSArray *channelsInGroup = [allChannelsByGroup objectForKey:group];
+            channelCount += channelsInGroup.count;
+        }
+        NSLog(@"📊 [CATEGORY-DEBUG] %@: %lu groups, %lu channels", category, (unsigned long)groupsInCategory.count, (unsigned long)channelCount);
+    }
+    
+    // Update internal data structures
+    [self updateInternalDataWithChannels:allChannels 
+                                  groups:allGroups 
+                         channelsByGroup:allChannelsByGroup 
+                        groupsByCategory:allGroupsByCategory];
+    
+    // Save to cache
+    if (self.cacheManager) {
+        [self.cacheManager saveChannelsToCache:allChannels 
+                                      sourceURL:@"" 
+                                     completion:nil];
+    }
+    
+    // Complete
+    self.internalIsLoading = NO;
+    self.internalProgress = 1.0;
+    self.internalCurrentStatus = [NSString stringWithFormat:@"✅ Complete: %lu channels", (unsigned long)allChannels.count];
+    
+    if (completion) {
+        completion([allChannels copy], nil);
+    }
+}
+
+#pragma mark - Xtream Catalog
+
+// Xtream get.php playlist URLs carry the player_api server and credentials
+- (NSDictionary<NSString *, NSString *> *)xtreamAccountFromPlaylistURL:(NSString *)m3uURL {
+    NSURLComponents *components = [NSURLComponents componentsWithString:m3uURL];
+    if (components.host.length == 0) {
+        return nil;
+    }
+    
+    NSString *username = nil;
+    NSString *password = nil;
+    NSString *output = nil;
+    for (NSURLQueryItem *item in components.queryItems) {
+        if ([item.name isEqualToString:@"username"]) {
+            username = item.value;
+        } else if ([item.name isEqualToString:@"password"]) {
+            password = item.value;
+        } else if ([item.name isEqualToString:@"output"]) {
+            output = item.value;
+        }
+    }
+    if (username.length == 0 || password.length == 0) {
+        return nil;
+    }
+    
+    NSString *server = components.port 
+        ? [NSString stringWithFormat:@"%@://%@:%@", components.scheme ?: @"http", components.host, components.port]
+        : [NSString stringWithFormat:@"%@://%@", components.scheme ?: @"http", components.host];
+    BOOL hls = [output isEqualToString:@"m3u8"] || [output isEqualToString:@"hls"];
+    
+    return @{
+        @"server": server,
+        @"username": username,
+        @"password": password,
+        @"liveExtension": hls ? @"m3u8" : @"ts"
+    };
+}
+
+// Fetches the categories and the live, VOD and series lists in parallel, each parsed as it
+// streams in. completion runs on the main queue with a finished session, or the first error.
+- (void)loadXtreamCatalogForAccount:(NSDictionary<NSString *, NSString *> *)account
+                           progress:(VLCChannelProgressBlock)progressBlock
+                         completion:(void (^)(VLCM3UParseSession *session, NSError *error))completion {
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSString *server = account[@"server"];
+    NSString *credentials = [NSString stringWithFormat:@"%@/%@/", account[@"username"], account[@"password"]];
+    NSCharacterSet *queryCharacters = [NSCharacterSet URLQueryAllowedCharacterSet];
+    NSString *apiURL = [NSString stringWithFormat:@"%@/player_api.php?username=%@&password=%@&action=", server,
+                        [account[@"username"] stringByAddingPercentEncodingWithAllowedCharacters:queryCharacters],
+                        [account[@"password"] stringByAddingPercentEncodingWithAllowedCharacters:queryCharacters]];
+    
+    VLCXtreamCatalogCall *liveCategories = [[[VLCXtreamCatalogCall alloc] initWithAction:@"get_live_categories" kind:VLCXtreamListLive listsCategories:YES urlPrefix:nil defaultExtension:nil] autorelease];
+    VLCXtreamCatalogCall *movieCategories = [[[VLCXtreamCatalogCall alloc] initWithAction:@"get_vod_categories" kind:VLCXtreamListMovies listsCategories:YES urlPrefix:nil defaultExtension:nil] autorelease];
+    VLCXtreamCatalogCall *seriesCategories = [[[VLCXtreamCatalogCall alloc] initWithAction:@"get_series_categories" kind:VLCXtreamListSeries listsCategories:YES urlPrefix:nil defaultExtension:nil] autorelease];
+    VLCXtreamCatalogCall *liveStreams = [[[VLCXtreamCatalogCall alloc] initWithAction:@"get_live_streams" kind:VLCXtreamListLive listsCategories:NO 
+                                                                            urlPrefix:[NSString stringWithFormat:@"%@/live/%@", server, credentials] 
+                                                                     defaultExtension:account[@"liveExtension"]] autorelease];
+    VLCXtreamCatalogCall *movieStreams = [[[VLCXtreamCatalogCall alloc] initWithAction:@"get_vod_streams" kind:VLCXtreamListMovies listsCategories:NO 
+                                                                             urlPrefix:[NSString stringWithFormat:@"%@/movie/%@", server, credentials] 
+                                                                      defaultExtension:@"mp4"] autorelease];
+    VLCXtreamCatalogCall *seriesStreams = [[[VLCXtreamCatalogCall alloc] initWithAction:@"get_series" kind:VLCXtreamListSeries listsCategories:NO 
+                                                                              urlPrefix:[NSString stringWithFormat:@"%@/series/%@", server, credentials] 
+                                                                       defaultExtension:nil] autorelease];
+    NSArray<VLCXtreamCatalogCall *> *calls = @[liveCategories, movieCategories, seriesCategories, liveStreams, movieStreams, seriesStreams];
+    
+    dispatch_group_t group = dispatch_group_create();
+    __block NSUInteger finishedCalls = 0;
+    
+    for (VLCXtreamCatalogCall *call in calls) {
+        dispatch_group_enter(group);
+        CFAbsoluteTime callStartTime = CFAbsoluteTimeGetCurrent();
+        DownloadManager *downloadManager = [[DownloadManager alloc] init];
+        
+        [downloadManager startStreamingFromURL:[apiURL stringByAppendingString:call.action]
+                               progressHandler:nil
+                                   dataHandler:^(NSData *data) {
+            @autoreleasepool {
+                [call consumeData:data];
+            }
+        }
+                             completionHandler:^(NSError *error) {
+            [call finishWithError:error];
+            call.elapsed = CFAbsoluteTimeGetCurrent() - callStartTime;
+            NSLog(@"🚀 [XTREAM-PERF] %@: %.1f MB, %lu entries in %.2fs%@", call.action, call.bytesReceived / 1024.0 / 1024.0,
+                  (unsigned long)(call.listsCategories ? call.categoryIds.count : call.channels.count), call.elapsed,
+                  call.error ? [NSString stringWithFormat:@" - %@", call.error.localizedDescription] : @"");
+            
+            NSUInteger finished;
+            @synchronized (calls) {
+                finished = ++finishedCalls;
+            }
+            float progress = 0.1 + (0.8 * (float)finished / (float)calls.count);
+            NSString *status = [NSString stringWithFormat:@"🌐 Loading catalog: %lu/%lu lists", (unsigned long)finished, (unsigned long)calls.count];
+            dispatch_async(dispatch_get_main_queue(), ^{
+                self.internalProgress = progress;
+                self.internalCurrentStatus = status;
+                if (progressBlock) {
+                    progressBlock(progress, status);
+                }
+            });
+            
+            dispatch_group_leave(group);
+            [downloadManager release];
+        }];
+    }
+    
+    dispatch_group_notify(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        dispatch_release(group);
+        
+        for (VLCXtreamCatalogCall *call in calls) {
+            if (call.error) {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    completion(nil, call.error);
+                });
+                return;
+            }
+        }
+        
+        // Same order as the get.php export: live, then movies, then series
+        VLCM3UParseSession *session = [[VLCM3UParseSession alloc] initWithCategories:self.internalCategories];
+        @autoreleasepool {
+            [session appendChannels:[self channelsOfCall:liveStreams groupedByCategoriesOf:liveCategories]];
+            [session appendChannels:[self channelsOfCall:movieStreams groupedByCategoriesOf:movieCategories]];
+            [session appendChannels:[self channelsOfCall:seriesStreams groupedByCategoriesOf:seriesCategories]];
+        }
+        
+        int64_t bytesReceived = 0;
+        for (VLCXtreamCatalogCall *call in calls) {
+            bytesReceived += call.bytesReceived;
+        }
+        NSLog(@"🚀 [XTREAM-PERF] Catalog loaded in %.2fs: %.1f MB, %lu channels (%lu live, %lu movies, %lu series) • RSS %luMB, peak %luMB",
+              CFAbsoluteTimeGetCurrent() - startTime, bytesReceived / 1024.0 / 1024.0, (unsigned long)session.channels.count,
+              (unsigned long)liveStreams.channels.count, (unsigned long)movieStreams.channels.count, (unsigned long)seriesStreams.channels.count,
+              (unsigned long)[VLCChannelManager getCurrentMemoryUsageMB],
+              (unsigned long)[VLCChannelManager getPeakMemoryUsageMB]);
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(session, nil);
+            [session release];
+        });
+    });
+}
+
+// Orders streams by their category's position in the category list (as get.php does) and
+// swaps the category ids for names. Streams of unlisted categories follow, in catalog order.
+- (NSArray<VLCChannel *> *)channelsOfCall:(VLCXtreamCatalogCall *)streams groupedByCategoriesOf:(VLCXtreamCatalogCall *)categories {
+    NSMutableDictionary<NSString *, NSMutableArray<VLCChannel *> *> *channelsByCategory = [NSMutableDictionary dictionary];
+    NSMutableArray<NSString *> *categoryIds = [NSMutableArray arrayWithArray:categories.categoryIds];
+    
+    for (VLCChannel *channel in streams.channels) {
+        NSString *categoryId = channel.group;
+        NSMutableArray<VLCChannel *> *bucket = [channelsByCategory objectForKey:categoryId];
+        if (!bucket) {
+            bucket = [NSMutableArray array];
+            [channelsByCategory setObject:bucket forKey:categoryId];
+            if (![categories.categoryNames objectForKey:categoryId]) {
+                [categoryIds addObject:categoryId];
+            }
+        }
+        [bucket addObject:channel];
+    }
+    
+    NSMutableArray<VLCChannel *> *ordered = [NSMutableArray arrayWithCapacity:streams.channels.count];
+    for (NSString *categoryId in categoryIds) {
+        NSArray<VLCChannel *> *bucket = [channelsByCategory objectForKey:categoryId];
+        if (!bucket) {
+            continue;
+        }
+        NSString *groupName = [categories.categoryNames objectForKey:categoryId] ?: @"";
+        for (VLCChannel *channel in bucket) {
+            channel.group = groupName;
+        }
+        [ordered addObjectsFromArray:bucket];
+    }
+    return ordered;
+}
+
+#pragma mark - Playlist Sources
+
+- (void)loadChannelsFromSources:(NSArray<VLCPlaylistSource *> *)sources
+                    bypassCache:(BOOL)bypassCache
+                     completion:(VLCChannelLoadCompletion)completion
+                       progress:(VLCChannelProgressBlock)progressBlock {
+    
+    if (![self beginLoadingSources:sources completion:completion]) {
+        return;
+    }
+    
+    // Settings is usable while the playlists are still loading
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self publishImmediateSettingsChannel];
+    });
+    
+    [self loadSources:sources ofSources:sources bypassCache:bypassCache completion:completion progress:progressBlock];
+}
+
+- (void)refreshSources:(NSArray<VLCPlaylistSource *> *)sourcesToRefresh
+             ofSources:(NSArray<VLCPlaylistSource *> *)allSources
+            completion:(VLCChannelLoadCompletion)completion
+              progress:(VLCChannelProgressBlock)progressBlock {
+    
+    if (![self beginLoadingSources:allSources completion:completion]) {
+        return;
+    }
+    
+    // Sources without loaded channels (added since the last load) come from their cache
+    NSMutableArray<VLCPlaylistSource *> *sourcesToLoad = [NSMutableArray arrayWithArray:sourcesToRefresh];
+    NSMutableArray<VLCPlaylistSource *> *sourcesFromCache = [NSMutableArray array];
+    for (VLCPlaylistSource *source in allSources) {
+        if (![sourcesToLoad containsObject:source] && ![self.sourceChannels objectForKey:source.cacheKey]) {
+            [sourcesFromCache addObject:source];
+        }
+    }
+    
+    if (sourcesFromCache.count == 0) {
+        [self loadSources:sourcesToLoad ofSources:allSources bypassCache:YES completion:completion progress:progressBlock];
+        return;
+    }
+    [self loadSources:sourcesFromCache ofSources:@[] bypassCache:NO completion:^(NSArray<VLCChannel *> *channels, NSError *error) {
+        [self loadSources:sourcesToLoad ofSources:allSources bypassCache:YES completion:completion progress:progressBlock];
+    } progress:nil];
+}
+
+- (BOOL)beginLoadingSources:(NSArray<VLCPlaylistSource *> *)sources completion:(VLCChannelLoadCompletion)completion {
+    NSError *error = nil;
+    if (self.internalIsLoading) {
+        NSLog(@"⚠️ [CHANNEL] Already loading channels, ignoring request");
+        error = [NSError errorWithDomain:@"VLCChannelManager" 
+                                    code:1001 
+                                userInfo:@{NSLocalizedDescriptionKey: @"Channel loading already in progress"}];
+    } else if (sources.count == 0) {
+        error = [NSError errorWithDomain:@"VLCChannelManager" 
+                                    code:1006 
+                                userInfo:@{NSLocalizedDescriptionKey: @"No playlist sources configured"}];
+    }
+    
+    if (error) {
+        if (completion) {
+            completion(nil, error);
+        }
+        return NO;
+    }
+    
+    self.internalIsLoading = YES;
+    self.internalProgress = 0.0;
+    self.internalCurrentStatus = [NSString stringWithFormat:@"🌐 Loading %lu playlists...", (unsigned long)sources.count];
+    return YES;
 }
 
-- (void)performM3UParsingWithContent:(NSString *)content
-                          completion:(VLCChannelLoadCompletion)completion
-                            progress:(VLCChannelProgressBlock)progressBlock {
-    
-    NSLog(@"📊 [CHANNEL] 🚀 Starting NON-BLOCKING M3U parsing - %lu characters", (unsigned long)content.length);
-    
-    // IMMEDIATE Settings delivery for instant UI responsiveness
+// Loads sourcesToLoad concurrently (each from its cache or its own download), then merges
+// allSources in order. An empty allSources only fills sourceChannels.
+- (void)loadSources:(NSArray<VLCPlaylistSource *> *)sourcesToLoad
+          ofSources:(NSArray<VLCPlaylistSource *> *)allSources
+        bypassCache:(BOOL)bypassCache
+         completion:(VLCChannelLoadCompletion)completion
+           progress:(VLCChannelProgressBlock)progressBlock {
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    dispatch_group_t group = dispatch_group_create();
+    NSMutableDictionary<NSString *, NSArray<VLCChannel *> *> *loaded = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary<NSString *, NSDate *> *loadDates = [[NSMutableDictionary alloc] init];
+    __block NSUInteger finishedSources = 0;
+    __block NSError *lastError = nil;
+    
+    for (VLCPlaylistSource *source in sourcesToLoad) {
+        dispatch_group_enter(group);
+        [self loadSource:source bypassCache:bypassCache completion:^(NSArray<VLCChannel *> *channels, NSDate *loadDate, NSError *error) {
+            NSUInteger finished;
+            @synchronized (loaded) {
+                if (channels) {
+                    [loaded setObject:channels forKey:source.cacheKey];
+                    [loadDates setObject:loadDate forKey:source.cacheKey];
+                } else {
+                    NSLog(@"❌ [CHANNEL-SOURCES] %@ failed: %@", source.name, error.localizedDescription);
+                    [lastError release];
+                    lastError = [error retain];
+                }
+                finished = ++finishedSources;
+            }
+            
+            float progress = 0.1 + (0.8 * (float)finished / (float)sourcesToLoad.count);
+            NSString *status = [NSString stringWithFormat:@"🌐 Loaded %lu/%lu playlists • %@: %lu channels", 
+                               (unsigned long)finished, (unsigned long)sourcesToLoad.count, source.name, (unsigned long)channels.count];
             dispatch_async(dispatch_get_main_queue(), ^{
-        self.internalCurrentStatus = @"🚀 Preparing channel processing...";
+                self.internalProgress = progress;
+                self.internalCurrentStatus = status;
                 if (progressBlock) {
-                    progressBlock(0.1, self.internalCurrentStatus);
+                    progressBlock(progress, status);
                 }
+            });
+            dispatch_group_leave(group);
+        }];
+    }
+    
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+        dispatch_release(group);
         
-        // Create minimal Settings structure immediately for UI
-        VLCChannel *settingsChannel = [[VLCChannel alloc] init];
-        settingsChannel.name = @"Settings";
-        settingsChannel.group = @"Settings";
-        settingsChannel.category = @"SETTINGS";
-        settingsChannel.url = @"settings://menu";
-        settingsChannel.channelId = @"settings_menu";
-        
-        NSArray *immediateChannels = @[settingsChannel];
-        NSArray *immediateGroups = @[@"Settings"];
-        NSDictionary *immediateChannelsByGroup = @{@"Settings": immediateChannels};
-        NSDictionary *immediateGroupsByCategory = @{@"SETTINGS": immediateGroups};
+        // sourceChannels is only touched on the main queue
+        [self.sourceChannels addEntriesFromDictionary:loaded];
+        for (VLCPlaylistSource *source in sourcesToLoad) {
+            NSDate *loadDate = [loadDates objectForKey:source.cacheKey];
+            if (loadDate) {
+                source.lastLoadDate = loadDate;
+            }
+        }
+        [loaded release];
+        [loadDates release];
+        [lastError autorelease];
         
-        // Update internal data immediately
-        [self updateInternalDataWithChannels:immediateChannels 
-                                      groups:immediateGroups 
-                             channelsByGroup:immediateChannelsByGroup 
-                            groupsByCategory:immediateGroupsByCategory];
+        if (allSources.count == 0) {
+            if (completion) {
+                completion(nil, lastError);
+            }
+            return;
+        }
         
-        NSLog(@"🚀 [CHANNEL] IMMEDIATE: Settings channel available for navigation");
+        NSMutableArray<NSArray<VLCChannel *> *> *channelLists = [NSMutableArray arrayWithCapacity:allSources.count];
+        NSMutableDictionary<NSString *, NSArray<VLCChannel *> *> *currentChannels = [NSMutableDictionary dictionary];
+        for (VLCPlaylistSource *source in allSources) {
+            NSArray<VLCChannel *> *channels = [self.sourceChannels objectForKey:source.cacheKey] ?: @[];
+            [channelLists addObject:channels];
+            [currentChannels setObject:channels forKey:source.cacheKey];
+        }
+        // Forget sources that were removed
+        self.sourceChannels = currentChannels;
         
-        // DO NOT call completion immediately - wait for chunked parsing to complete
+        NSUInteger availableChannels = 0;
+        for (NSArray<VLCChannel *> *channels in channelLists) {
+            availableChannels += channels.count;
+        }
+        if (availableChannels == 0) {
+            self.internalIsLoading = NO;
+            if (completion) {
+                completion(nil, lastError ?: [NSError errorWithDomain:@"VLCChannelManager" 
+                                                                code:1004 
+                                                            userInfo:@{NSLocalizedDescriptionKey: @"Empty M3U content"}]);
+            }
+            return;
+        }
         
-        // Now start async chunk-based parsing for full channel list
-        [self startChunkedParsing:content completion:completion progress:progressBlock];
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            VLCM3UParseSession *session = [self newSessionByMergingChannelLists:channelLists ofSources:allSources];
+            NSLog(@"🚀 [M3U-PERF] Loaded and merged %lu playlists in %.2fs: %lu channels",
+                  (unsigned long)allSources.count, CFAbsoluteTimeGetCurrent() - startTime, (unsigned long)session.channels.count);
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self finishMergedSourcesWithSession:session completion:completion];
+                [session release];
+            });
+        });
     });
 }
-            
-- (void)startChunkedParsing:(NSString *)content
-                 completion:(VLCChannelLoadCompletion)completion
-                   progress:(VLCChannelProgressBlock)progressBlock {
+
+// completion gets the source's channels and the time they were fetched from the server
+- (void)loadSource:(VLCPlaylistSource *)source
+       bypassCache:(BOOL)bypassCache
+        completion:(void (^)(NSArray<VLCChannel *> *channels, NSDate *loadDate, NSError *error))completion {
+    
+    if (bypassCache || !self.cacheManager) {
+        [self downloadSource:source completion:completion];
+        return;
+    }
+    
+    NSTimeInterval validityHours = source.refreshIntervalHours > 0 ? source.refreshIntervalHours : self.cacheManager.channelCacheValidityHours;
+    [self.cacheManager loadChannelsFromCache:source.cacheKey validityHours:validityHours completion:^(id data, BOOL success, NSError *error) {
+        if (!success || ![data isKindOfClass:[NSArray class]]) {
+            [self downloadSource:source completion:completion];
+            return;
+        }
+        
+        // The refresh schedule runs from when the cache was written, not from app start
+        NSString *cacheFilePath = [self.cacheManager cacheFilePathForType:VLCCacheTypeChannels sourceURL:source.cacheKey];
+        NSDate *cacheDate = [[[NSFileManager defaultManager] attributesOfItemAtPath:cacheFilePath error:nil] fileModificationDate];
+        NSLog(@"💾 [CHANNEL-SOURCES] %@: %lu channels from cache", source.name, (unsigned long)[(NSArray *)data count]);
+        completion((NSArray<VLCChannel *> *)data, cacheDate ?: [NSDate date], nil);
+    }];
+}
+
+- (void)downloadSource:(VLCPlaylistSource *)source
+            completion:(void (^)(NSArray<VLCChannel *> *channels, NSDate *loadDate, NSError *error))completion {
+    
+    NSLog(@"🌐 [CHANNEL-SOURCES] Downloading %@: %@", source.name, source.url);
     
-    NSLog(@"🚀 [CHANNEL] Starting chunked async parsing - %lu characters", (unsigned long)content.length);
+    VLCM3UParseSession *session = [[VLCM3UParseSession alloc] initWithCategories:self.internalCategories];
+    session.publishesPartialResults = NO;
+    session.groupPrefix = source.groupPrefix;
     
-    // Split content into manageable lines array ONCE
-    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
-        NSArray<NSString *> *lines = [content componentsSeparatedByString:@"\n"];
-        NSLog(@"🚀 [CHANNEL] Split into %lu lines for chunked processing", (unsigned long)lines.count);
+    [self streamM3UFromURL:source.url session:session progress:nil completion:^(NSError *error) {
+        if (error) {
+            completion(nil, nil, error);
+            [session release];
+            return;
+        }
         
-        // Initialize parsing state
-        NSMutableArray<VLCChannel *> *allChannels = [[NSMutableArray alloc] init];
-        NSMutableArray<NSString *> *allGroups = [[NSMutableArray alloc] init];
-        NSMutableDictionary<NSString *, NSMutableArray<VLCChannel *> *> *allChannelsByGroup = [[NSMutableDictionary alloc] init];
-        NSMutableDictionary<NSString *, NSMutableArray<NSString *> *> *allGroupsByCategory = [[NSMutableDictionary alloc] init];
+        // The cache keeps this source's own list; merging happens again on every load
+        NSArray<VLCChannel *> *channels = [[session.channels copy] autorelease];
+        if (self.cacheManager) {
+            [self.cacheManager saveChannelsToCache:channels sourceURL:source.cacheKey completion:nil];
+        }
+        completion(channels, [NSDate date], nil);
+        [session release];
+    }];
+}
+
+// Concatenates the sources in order and drops streams an earlier source already has: the same
+// URL, or the same tvg-id and name. Both keys go through hash indexes, so the cost is linear.
+- (VLCM3UParseSession *)newSessionByMergingChannelLists:(NSArray<NSArray<VLCChannel *> *> *)channelLists
+                                              ofSources:(NSArray<VLCPlaylistSource *> *)sources {
+    
+    NSUInteger totalChannels = 0;
+    for (NSArray<VLCChannel *> *channels in channelLists) {
+        totalChannels += channels.count;
+    }
+    
+    VLCHashIndex *urlIndex = VLCHashIndexCreate(totalChannels);
+    VLCHashIndex *identityIndex = VLCHashIndexCreate(totalChannels);
+    NSMutableArray<VLCChannel *> *merged = [[NSMutableArray alloc] initWithCapacity:totalChannels];
+    NSMutableArray<NSNumber *> *keptCounts = [NSMutableArray arrayWithCapacity:sources.count];
+    NSMutableArray<NSNumber *> *duplicateCounts = [NSMutableArray arrayWithCapacity:sources.count];
+    
+    for (NSUInteger i = 0; i < channelLists.count; i++) {
+        NSUInteger kept = 0;
+        NSUInteger duplicates = 0;
         
-        // Initialize categories
-        for (NSString *category in self.internalCategories) {
-            if (![category isEqualToString:@"SETTINGS"]) {
-                [allGroupsByCategory setObject:[[NSMutableArray alloc] init] forKey:category];
+        for (VLCChannel *channel in channelLists[i]) {
+            @autoreleasepool {
+                if ([channel.channelId isEqualToString:@"settings_menu"]) continue;
+                
+                const char *url = [channel.url UTF8String];
+                uint64_t urlHash = (url && url[0]) ? VLCHashBytes(url, strlen(url), VLC_HASH_SEED) : 0;
+                
+                // "ch_N" ids are positional fallbacks, not tvg-ids; the NUL separates id and name
+                uint64_t identityHash = 0;
+                NSString *channelId = channel.channelId;
+                if (channelId.length > 0 && ![channelId hasPrefix:@"ch_"] && channel.name.length > 0) {
+                    const char *tvgId = [channelId UTF8String];
+                    const char *name = [channel.name UTF8String];
+                    identityHash = VLCHashBytes(name, strlen(name), VLCHashBytes(tvgId, strlen(tvgId) + 1, VLC_HASH_SEED));
+                }
+                
+                if ((urlHash && VLCHashIndexGet(urlIndex, urlHash)) ||
+                    (identityHash && VLCHashIndexGet(identityIndex, identityHash))) {
+                    duplicates++;
+                    continue;
+                }
+                if (urlHash) {
+                    VLCHashIndexSet(urlIndex, urlHash, 1);
+                }
+                if (identityHash) {
+                    VLCHashIndexSet(identityIndex, identityHash, 1);
+                }
+                
+                [merged addObject:channel];
+                kept++;
             }
         }
         
-        // Start chunked processing
-        [self processLinesChunk:lines
-                     startIndex:0
-                    allChannels:allChannels
-                      allGroups:allGroups
-           allChannelsByGroup:allChannelsByGroup
-          allGroupsByCategory:allGroupsByCategory
-                   completion:completion
-                     progress:progressBlock];
+        [keptCounts addObject:@(kept)];
+        [duplicateCounts addObject:@(duplicates)];
+        NSLog(@"📊 [CHANNEL-SOURCES] %@: %lu channels, %lu duplicates of earlier sources", 
+              sources[i].name, (unsigned long)kept, (unsigned long)duplicates);
+    }
+    
+    VLCHashIndexFree(urlIndex);
+    VLCHashIndexFree(identityIndex);
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for (NSUInteger i = 0; i < sources.count; i++) {
+            sources[i].channelCount = [keptCounts[i] unsignedIntegerValue];
+            sources[i].duplicateCount = [duplicateCounts[i] unsignedIntegerValue];
+        }
     });
+    
+    // Each source already numbered its repeated streams
+    VLCM3UParseSession *session = [[VLCM3UParseSession alloc] initWithCategories:self.internalCategories];
+    session.assignsEntryIdentities = NO;
+    [session appendChannels:merged];
+    [merged release];
+    return session;
 }
 
-- (void)processLinesChunk:(NSArray<NSString *> *)lines
-               startIndex:(NSUInteger)startIndex
-              allChannels:(NSMutableArray<VLCChannel *> *)allChannels
-                allGroups:(NSMutableArray<NSString *> *)allGroups
-     allChannelsByGroup:(NSMutableDictionary<NSString *, NSMutableArray<VLCChannel *> *> *)allChannelsByGroup
-    allGroupsByCategory:(NSMutableDictionary<NSString *, NSMutableArray<NSString *> *> *)allGroupsByCategory
-               completion:(VLCChannelLoadCompletion)completion
-                 progress:(VLCChannelProgressBlock)progressBlock {
+- (void)finishMergedSourcesWithSession:(VLCM3UParseSession *)session
+                            completion:(VLCChannelLoadCompletion)completion {
     
-    const NSUInteger CHUNK_SIZE = 200; // Process only 200 lines at a time
-    NSUInteger endIndex = MIN(startIndex + CHUNK_SIZE, lines.count);
+    NSMutableArray<VLCChannel *> *allChannels = session.channels;
     
-    // Process this small chunk synchronously
-    VLCChannel *currentChannel = nil;
-    NSUInteger processedChannels = 0;
+    [self addSettingsChannelToChannels:allChannels
+                                groups:session.groups
+                       channelsByGroup:session.channelsByGroup
+                      groupsByCategory:session.groupsByCategory];
     
-    for (NSUInteger i = startIndex; i < endIndex; i++) {
-        NSString *line = [lines[i] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-        
-        if ([line hasPrefix:@"#EXTINF:"]) {
-                            // Parse channel info line
-            currentChannel = [self parseExtinfLineSimple:line];
-                            
-        } else if (currentChannel && [line hasPrefix:@"http"]) {
-                            // Channel URL line
-            currentChannel.url = line;
-            
-            // Finalize channel
-            if (!currentChannel.channelId || currentChannel.channelId.length == 0) {
-                currentChannel.channelId = [NSString stringWithFormat:@"ch_%lu", (unsigned long)allChannels.count];
-            }
-            
-            // Use new URL-based category determination
-            currentChannel.category = [self determineCategoryForChannel:currentChannel];
-            
-            // Add to collections
-            [allChannels addObject:currentChannel];
-            processedChannels++;
-            
-            if (currentChannel.group && ![allGroups containsObject:currentChannel.group]) {
-                [allGroups addObject:currentChannel.group];
-            }
-            
-            // Add to group collection
-            NSMutableArray<VLCChannel *> *groupChannels = [allChannelsByGroup objectForKey:currentChannel.group];
-            if (!groupChannels) {
-                groupChannels = [[NSMutableArray alloc] init];
-                [allChannelsByGroup setObject:groupChannels forKey:currentChannel.group];
-            }
-            [groupChannels addObject:currentChannel];
-            
-            // Add to category collection
-            NSMutableArray<NSString *> *categoryGroups = [allGroupsByCategory objectForKey:currentChannel.category];
-            if (categoryGroups && ![categoryGroups containsObject:currentChannel.group]) {
-                [categoryGroups addObject:currentChannel.group];
-            }
-            
-            currentChannel = nil;
+    // No combined cache: every source keeps its own
+    [self updateInternalDataWithChannels:allChannels 
+                                  groups:session.groups 
+                         channelsByGroup:session.channelsByGroup 
+                        groupsByCategory:session.groupsByCategory];
+    
+    self.internalIsLoading = NO;
+    self.internalProgress = 1.0;
+    self.internalCurrentStatus = [NSString stringWithFormat:@"✅ Complete: %lu channels", (unsigned long)allChannels.count];
+    
+    if (completion) {
+        completion([[allChannels copy] autorelease], nil);
+    }
+}
+
+#pragma mark - Delta Refresh
+
+- (void)refreshChannelsFromURL:(NSString *)m3uURL
+                    completion:(VLCChannelRefreshCompletion)completion
+                      progress:(VLCChannelProgressBlock)progressBlock {
+    
+    if (self.internalIsLoading) {
+        NSLog(@"⚠️ [CHANNEL] Already loading channels, ignoring refresh request");
+        if (completion) {
+            NSError *error = [NSError errorWithDomain:@"VLCChannelManager" 
+                                               code:1001 
+                                           userInfo:@{NSLocalizedDescriptionKey: @"Channel loading already in progress"}];
+            completion(nil, error);
+        }
+        return;
+    }
+    
+    self.internalIsLoading = YES;
+    self.internalProgress = 0.0;
+    [self performDeltaRefreshFromURL:m3uURL
+                     againstChannels:[[self.internalChannels copy] autorelease]
+                          completion:completion
+                            progress:progressBlock];
+}
+
+// loadedChannels is the list the refresh diffs against; it is read on a background queue, so
+// callers pass an array nobody mutates rather than internalChannels itself
+- (void)performDeltaRefreshFromURL:(NSString *)m3uURL
+                   againstChannels:(NSArray<VLCChannel *> *)loadedChannels
+                        completion:(VLCChannelRefreshCompletion)completion
+                          progress:(VLCChannelProgressBlock)progressBlock {
+    
+    // Previous playlist entries (Settings is synthesized, not part of the playlist)
+    NSMutableArray<VLCChannel *> *previousChannels = [[NSMutableArray alloc] initWithCapacity:loadedChannels.count];
+    BOOL hasFingerprints = YES;
+    for (VLCChannel *channel in loadedChannels) {
+        if ([channel.channelId isEqualToString:@"settings_menu"]) continue;
+        if (!channel.entryFingerprint || !channel.entryIdentity) {
+            hasFingerprints = NO;
+            break;
         }
+        [previousChannels addObject:channel];
     }
     
-    // Update progress with detailed processing info
-    float progress = 0.1 + (0.9 * (float)endIndex / (float)lines.count);
-    NSString *status = [NSString stringWithFormat:@"📊 Processing M3U: %lu/%lu lines • %lu channels • %lu groups", 
-                       (unsigned long)endIndex, (unsigned long)lines.count, (unsigned long)allChannels.count, (unsigned long)allGroups.count];
+    if (!hasFingerprints || previousChannels.count == 0) {
+        // Nothing to diff against (first load or a cache written before fingerprints existed)
+        NSLog(@"📊 [CHANNEL-DELTA] No fingerprinted channels loaded - falling back to full reload");
+        [previousChannels release];
+        [self downloadAndParseM3U:m3uURL completion:^(NSArray<VLCChannel *> *channels, NSError *error) {
+            if (!completion) return;
+            if (error) {
+                completion(nil, error);
+                return;
+            }
+            VLCChannelChangeSet *changes = [[[VLCChannelChangeSet alloc] initWithChannels:channels
+                                                                                  inserted:channels
+                                                                                   removed:@[]
+                                                                                   updated:@[]
+                                                                                 reordered:NO
+                                                                                fullReload:YES] autorelease];
+            completion(changes, nil);
+        } progress:progressBlock];
+        return;
+    }
     
-            dispatch_async(dispatch_get_main_queue(), ^{
-        self.internalProgress = progress;
-        self.internalCurrentStatus = status;
-                if (progressBlock) {
-            progressBlock(progress, status);
+    self.internalCurrentStatus = @"🌐 Checking playlist for changes...";
+    if (progressBlock) {
+        progressBlock(0.05, self.internalCurrentStatus);
+    }
+    
+    // identity -> previous index + 1
+    VLCHashIndex *previousIndex = VLCHashIndexCreate(previousChannels.count);
+    for (NSUInteger i = 0; i < previousChannels.count; i++) {
+        VLCHashIndexSet(previousIndex, previousChannels[i].entryIdentity, (uint32_t)(i + 1));
+    }
+    
+    VLCM3UDeltaContext *delta = calloc(1, sizeof(VLCM3UDeltaContext));
+    delta->build.manager = self;
+    delta->build.store = [[VLCChannelStore alloc] init];
+    delta->previousChannels = previousChannels;
+    delta->previousIndex = previousIndex;
+    delta->occurrences = VLCHashIndexCreate(previousChannels.count);
+    delta->seen = calloc(previousChannels.count, sizeof(uint8_t));
+    delta->orderedChannels = [[NSMutableArray alloc] initWithCapacity:previousChannels.count];
+    delta->insertedChannels = [[NSMutableArray alloc] init];
+    delta->updatedChannels = [[NSMutableArray alloc] init];
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSMutableData *carry = [[NSMutableData alloc] init];
+    DownloadManager *downloadManager = [[DownloadManager alloc] init];
+    
+    [downloadManager startStreamingFromURL:m3uURL
+                           progressHandler:^(int64_t totalBytesReceived, int64_t totalBytesExpected) {
+        float progress = totalBytesExpected > 0 ? 0.05 + (0.85 * (float)totalBytesReceived / (float)totalBytesExpected) : 0.5;
+        NSString *status = [NSString stringWithFormat:@"🌐 Checking playlist: %.1f MB • %lu new • %lu changed", 
+                           totalBytesReceived / 1024.0 / 1024.0,
+                           (unsigned long)delta->insertedChannels.count, (unsigned long)delta->updatedChannels.count];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self.internalProgress = progress;
+            self.internalCurrentStatus = status;
+            if (progressBlock) {
+                progressBlock(progress, status);
+            }
+        });
+    }
+                               dataHandler:^(NSData *data) {
+        @autoreleasepool {
+            // The previous chunk's bytes are gone or shifted, and its pool freed the group string
+            VLCM3UBuildContextForgetGroup(&delta->build);
+            if (carry.length == 0) {
+                size_t consumed = VLCM3UTokenizePartialBuffer((const char *)data.bytes, data.length,
+                                                              VLCChannelManagerHandleM3UDeltaEntry, delta, NULL);
+                [carry appendBytes:(const char *)data.bytes + consumed length:data.length - consumed];
+            } else {
+                [carry appendData:data];
+                size_t consumed = VLCM3UTokenizePartialBuffer((const char *)carry.bytes, carry.length,
+                                                              VLCChannelManagerHandleM3UDeltaEntry, delta, NULL);
+                [carry replaceBytesInRange:NSMakeRange(0, consumed) withBytes:NULL length:0];
+            }
         }
+    }
+                         completionHandler:^(NSError *error) {
+        VLCChannelChangeSet *changes = nil;
+        VLCM3UParseSession *session = nil;
         
-        NSLog(@"%@", status);
-        
-        // Continue with next chunk or complete
-        if (endIndex < lines.count) {
-            // Schedule next chunk with delay to prevent blocking
-            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5 * NSEC_PER_MSEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
-                [self processLinesChunk:lines
-                             startIndex:endIndex
-                            allChannels:allChannels
-                              allGroups:allGroups
-                   allChannelsByGroup:allChannelsByGroup
-                  allGroupsByCategory:allGroupsByCategory
-                           completion:completion
-                             progress:progressBlock];
-            });
-        } else {
-            // Parsing complete - Add Settings channel to final result
-            NSLog(@"🚀 [CHANNEL] Chunked parsing completed: %lu channels", (unsigned long)allChannels.count);
-            
-            // Create Settings channel for final result
-            VLCChannel *settingsChannel = [[VLCChannel alloc] init];
-            settingsChannel.name = @"Settings";
-            settingsChannel.group = @"Settings";
-            settingsChannel.category = @"SETTINGS";
-            settingsChannel.url = @"settings://menu";
-            settingsChannel.channelId = @"settings_menu";
+        if (!error) {
+            @autoreleasepool {
+                // Flush the tail: the last line may have no trailing newline
+                VLCM3UBuildContextForgetGroup(&delta->build);
+                VLCM3UTokenizeBuffer((const char *)carry.bytes, carry.length, 0, 0,
+                                     VLCChannelManagerHandleM3UDeltaEntry, delta, NULL);
+            }
             
-            // Add Settings to final collections
-            [allChannels insertObject:settingsChannel atIndex:0]; // Add at beginning
-            if (![allGroups containsObject:@"Settings"]) {
-                [allGroups addObject:@"Settings"];
+            NSMutableArray<VLCChannel *> *removedChannels = [NSMutableArray array];
+            for (NSUInteger i = 0; i < previousChannels.count; i++) {
+                if (!delta->seen[i]) {
+                    [removedChannels addObject:previousChannels[i]];
+                }
             }
             
-            // Add Settings to group collection
-            NSMutableArray<VLCChannel *> *settingsGroupChannels = [[NSMutableArray alloc] init];
-            [settingsGroupChannels addObject:settingsChannel];
-            [allChannelsByGroup setObject:settingsGroupChannels forKey:@"Settings"];
+            changes = [[VLCChannelChangeSet alloc] initWithChannels:delta->orderedChannels
+                                                           inserted:delta->insertedChannels
+                                                            removed:removedChannels
+                                                            updated:delta->updatedChannels
+                                                          reordered:delta->reordered
+                                                         fullReload:NO];
             
-            // Add Settings to category collection
-            NSMutableArray<NSString *> *settingsCategoryGroups = [allGroupsByCategory objectForKey:@"SETTINGS"];
-            if (!settingsCategoryGroups) {
-                settingsCategoryGroups = [[NSMutableArray alloc] init];
-                [allGroupsByCategory setObject:settingsCategoryGroups forKey:@"SETTINGS"];
-            }
-            if (![settingsCategoryGroups containsObject:@"Settings"]) {
-                [settingsCategoryGroups addObject:@"Settings"];
+            // Rebuild the lists only when something changed; existing channel objects are reused,
+            // so their attached programs and favorite links stay intact
+            if (!changes.isEmpty) {
+                session = [[VLCM3UParseSession alloc] initWithCategories:self.internalCategories];
+                session.assignsEntryIdentities = NO;
+                [session appendChannels:delta->orderedChannels];
             }
             
-            // Debug: Log category distribution
-            NSLog(@"📊 [CATEGORY-DEBUG] Category distribution:");
-            for (NSString *category in allGroupsByCategory) {
-                NSArray *groupsInCategory = [allGroupsByCategory objectForKey:category];
-                NSUInteger channelCount = 0;
-                for (NSString *group in groupsInCategory) {
-                    NSArray *channelsInGroup = [allChannelsByGroup objectForKey:group];
-                    channelCount += channelsInGroup.count;
+            CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - startTime;
+            NSLog(@"🚀 [CHANNEL-DELTA] Diffed %lu entries in %.2fs: %lu inserted, %lu removed, %lu updated, %lu unchanged%s",
+                  (unsigned long)delta->orderedChannels.count, elapsed,
+                  (unsigned long)changes.insertedChannels.count, (unsigned long)changes.removedChannels.count,
+                  (unsigned long)changes.updatedChannels.count,
+                  (unsigned long)(delta->orderedChannels.count - changes.insertedChannels.count - changes.updatedChannels.count),
+                  delta->reordered ? ", reordered" : "");
+        } else {
+            NSLog(@"❌ [CHANNEL-DELTA] Refresh download failed: %@", error.localizedDescription);
+        }
+        
+        [delta->build.store finishAppending];
+        [delta->build.store release];
+        VLCHashIndexFree(delta->previousIndex);
+        VLCHashIndexFree(delta->occurrences);
+        free(delta->seen);
+        [delta->orderedChannels release];
+        [delta->insertedChannels release];
+        [delta->updatedChannels release];
+        free(delta);
+        [previousChannels release];
+        [carry release];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (session) {
+                [self applyChannelChanges:changes session:session];
+                [session release];
+            } else if (changes) {
+                // Unchanged playlist: only extend the cache lifetime
+                if (self.cacheManager) {
+                    [self.cacheManager updateChannelCache:self.internalChannels
+                                          changedChannels:@[]
+                                                sourceURL:@""
+                                               completion:nil];
                 }
-                NSLog(@"📊 [CATEGORY-DEBUG] %@: %lu groups, %lu channels", category, (unsigned long)groupsInCategory.count, (unsigned long)channelCount);
             }
             
-            // Update internal data structures
-            [self updateInternalDataWithChannels:allChannels 
-                                          groups:allGroups 
-                                 channelsByGroup:allChannelsByGroup 
-                                groupsByCategory:allGroupsByCategory];
+            self.internalIsLoading = NO;
+            self.internalProgress = 1.0;
+            if (changes) {
+                NSUInteger changedCount = changes.insertedChannels.count + changes.removedChannels.count + changes.updatedChannels.count;
+                if (changes.isEmpty) {
+                    self.internalCurrentStatus = @"✅ Playlist unchanged";
+                } else if (changedCount == 0 && changes.reordered) {
+                    self.internalCurrentStatus = @"✅ Playlist reordered";
+                } else {
+                    self.internalCurrentStatus = [NSString stringWithFormat:@"✅ Playlist updated: %lu new, %lu removed, %lu changed", 
+                                                  (unsigned long)changes.insertedChannels.count, (unsigned long)changes.removedChannels.count,
+                                                  (unsigned long)changes.updatedChannels.count];
+                }
+            }
             
-            // Save to cache
-            if (self.cacheManager) {
-                [self.cacheManager saveChannelsToCache:allChannels 
-                                              sourceURL:@"" 
-                                             completion:nil];
+            if (completion) {
+                completion(changes, error);
             }
+            [changes release];
+        });
+        
+        [downloadManager release];
+    }];
+}
+
+- (void)refreshExpiredCacheFromURL:(NSString *)m3uURL
+                        completion:(VLCChannelLoadCompletion)completion
+                          progress:(VLCChannelProgressBlock)progressBlock {
+    
+    [self.cacheManager loadChannelsFromCache:m3uURL allowExpired:YES completion:^(id data, BOOL success, NSError *error) {
+        if (!success || ![data isKindOfClass:[NSArray class]]) {
+            [self downloadAndParseM3U:m3uURL completion:completion progress:progressBlock];
+            return;
+        }
+        
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+            // Show the expired channels right away; the refresh patches them in place. It diffs
+            // against the cached array itself: internalChannels is republished on main meanwhile.
+            NSArray<VLCChannel *> *cachedChannels = (NSArray<VLCChannel *> *)data;
+            [self updateInternalDataFromCachedChannels:cachedChannels];
             
-            // Complete
-                self.internalIsLoading = NO;
-                self.internalProgress = 1.0;
-            self.internalCurrentStatus = [NSString stringWithFormat:@"✅ Complete: %lu channels", (unsigned long)allChannels.count];
-                
+            [self performDeltaRefreshFromURL:m3uURL
+                             againstChannels:cachedChannels
+                                  completion:^(VLCChannelChangeSet *changes, NSError *refreshError) {
+                if (refreshError) {
+                    // Offline or server error: the expired list is still better than nothing
+                    NSLog(@"⚠️ [CHANNEL] Delta refresh failed, keeping expired cache: %@", refreshError.localizedDescription);
+                }
                 if (completion) {
-                completion([allChannels copy], nil);
+                    completion(self.channels, nil);
                 }
-        }
-    });
+            } progress:progressBlock];
+        });
+    }];
 }
 
-- (VLCChannel *)parseExtinfLineSimple:(NSString *)line {
-    VLCChannel *channel = [[VLCChannel alloc] init];
+- (void)applyChannelChanges:(VLCChannelChangeSet *)changes session:(VLCM3UParseSession *)session {
+    NSMutableArray<VLCChannel *> *allChannels = session.channels;
+    
+    [self addSettingsChannelToChannels:allChannels
+                                groups:session.groups
+                       channelsByGroup:session.channelsByGroup
+                      groupsByCategory:session.groupsByCategory];
+    
+    [self updateInternalDataWithChannels:allChannels 
+                                  groups:session.groups 
+                         channelsByGroup:session.channelsByGroup 
+                        groupsByCategory:session.groupsByCategory];
+    
+    // Only inserted and updated channels need serializing again
+    if (self.cacheManager) {
+        NSMutableArray<VLCChannel *> *changedChannels = [NSMutableArray arrayWithArray:changes.insertedChannels];
+        [changedChannels addObjectsFromArray:changes.updatedChannels];
+        [self.cacheManager updateChannelCache:allChannels
+                              changedChannels:changedChannels
+                                    sourceURL:@""
+                                   completion:nil];
+    }
+}
+
+// Copies the playlist-defined fields of a freshly parsed entry onto the channel already
+// shown in the UI. Programs, movie info and cached artwork stay with the existing object.
+- (void)applyPlaylistFieldsFromChannel:(VLCChannel *)source toChannel:(VLCChannel *)channel {
+    channel.name = source.name;
+    channel.url = source.url;
+    channel.group = source.group;
+    channel.logo = source.logo;
+    if (source.channelId.length > 0) {
+        channel.channelId = source.channelId;
+    }
+    channel.tvgName = source.tvgName;
+    channel.supportsCatchup = source.supportsCatchup;
+    channel.catchupDays = source.catchupDays;
+    channel.catchupSource = source.catchupSource;
+    channel.catchupTemplate = source.catchupTemplate;
+    channel.entryFingerprint = source.entryFingerprint;
+    channel.category = source.category;
+}
+
+static int VLCChannelManagerHandleM3UDeltaEntry(const VLCM3UEntry *entry, void *context) {
+    VLCM3UDeltaContext *delta = (VLCM3UDeltaContext *)context;
     
-    // Extract channel name (after last comma)
-    NSRange lastCommaRange = [line rangeOfString:@"," options:NSBackwardsSearch];
-    if (lastCommaRange.location != NSNotFound) {
-        channel.name = [[line substringFromIndex:lastCommaRange.location + 1] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    uint64_t identity = VLCM3UEntryIdentity(entry);
+    uint32_t *occurrence = VLCHashIndexSlot(delta->occurrences, identity);
+    if (occurrence) {
+        identity = VLCM3UIdentityWithOccurrence(identity, (*occurrence)++);
     }
     
-    // Extract group name (simplified)
-    NSRange groupRange = [line rangeOfString:@"group-title=\""];
-    if (groupRange.location != NSNotFound) {
-        NSUInteger startPos = groupRange.location + groupRange.length;
-        NSRange endQuoteRange = [line rangeOfString:@"\"" options:0 range:NSMakeRange(startPos, line.length - startPos)];
-        if (endQuoteRange.location != NSNotFound) {
-            channel.group = [line substringWithRange:NSMakeRange(startPos, endQuoteRange.location - startPos)];
+    // Unchanged entries cost two hashes and two lookups - no strings, no objects
+    uint32_t previous = VLCHashIndexGet(delta->previousIndex, identity);
+    if (previous > 0 && !delta->seen[previous - 1]) {
+        VLCChannel *existing = delta->previousChannels[previous - 1];
+        delta->seen[previous - 1] = 1;
+        // Kept entries in the old order are never decreasing; inserts and removals don't matter
+        if (previous < delta->lastPrevious) {
+            delta->reordered = YES;
+        }
+        delta->lastPrevious = previous;
+        
+        if (existing.entryFingerprint != VLCM3UEntryFingerprint(entry)) {
+            VLCChannel *fresh = [delta->build.manager channelFromM3UEntry:entry buildContext:&delta->build];
+            [delta->build.manager applyPlaylistFieldsFromChannel:fresh toChannel:existing];
+            [delta->updatedChannels addObject:existing];
         }
+        [delta->orderedChannels addObject:existing];
+        return 1;
     }
     
-    // Extract channel ID (simplified)
-    NSRange idRange = [line rangeOfString:@"tvg-id=\""];
-    if (idRange.location != NSNotFound) {
-        NSUInteger startPos = idRange.location + idRange.length;
-        NSRange endQuoteRange = [line rangeOfString:@"\"" options:0 range:NSMakeRange(startPos, line.length - startPos)];
-        if (endQuoteRange.location != NSNotFound) {
-            channel.channelId = [line substringWithRange:NSMakeRange(startPos, endQuoteRange.location - startPos)];
+    VLCChannel *channel = [delta->build.manager channelFromM3UEntry:entry buildContext:&delta->build];
+    channel.entryIdentity = identity;
+    [delta->insertedChannels addObject:channel];
+    [delta->orderedChannels addObject:channel];
+    return 1;
+}
+
+#pragma mark - M3U Entry Materialization
+
+// Creates an NSString only for fields the app keeps. Playlists are usually UTF-8,
+// but some providers ship Latin-1 names; fall back rather than dropping the field.
+static NSString *VLCStringFromM3USpan(VLCM3USpan span) {
+    if (span.length == 0) {
+        return nil;
+    }
+    NSString *string = [[NSString alloc] initWithBytes:span.bytes length:span.length encoding:NSUTF8StringEncoding];
+    if (!string) {
+        string = [[NSString alloc] initWithBytes:span.bytes length:span.length encoding:NSISOLatin1StringEncoding];
+    }
+    return [string autorelease];
+}
+
+static int VLCChannelManagerHandleM3UEntry(const VLCM3UEntry *entry, void *context) {
+    VLCM3UBuildContext *buildContext = (VLCM3UBuildContext *)context;
+    VLCChannel *channel = [buildContext->manager channelFromM3UEntry:entry buildContext:buildContext];
+    [buildContext->channels addObject:channel];
+    return 1;
+}
+
+- (VLCChannel *)channelFromM3UEntry:(const VLCM3UEntry *)entry buildContext:(VLCM3UBuildContext *)buildContext {
+    // Spans are copied straight into the store's string pool; no NSString per field
+    VLCChannelStoreRow row;
+    memset(&row, 0, sizeof(row));
+    row.strings[VLCChannelStoreFieldName] = entry->name;
+    row.strings[VLCChannelStoreFieldURL] = entry->url;
+    row.strings[VLCChannelStoreFieldLogo] = entry->tvgLogo;
+    row.strings[VLCChannelStoreFieldChannelId] = entry->tvgId;
+    row.strings[VLCChannelStoreFieldTvgName] = entry->tvgName;
+    row.strings[VLCChannelStoreFieldCatchupTemplate] = entry->catchupTemplate;
+    
+    // Playlists list channels group by group, so comparing against the previous
+    // group's bytes avoids allocating the same group string thousands of times
+    if (entry->groupTitle.length > 0) {
+        if (!buildContext->lastGroup ||
+            buildContext->lastGroupSpan.length != entry->groupTitle.length ||
+            memcmp(buildContext->lastGroupSpan.bytes, entry->groupTitle.bytes, entry->groupTitle.length) != 0) {
+            buildContext->lastGroupSpan = entry->groupTitle;
+            buildContext->lastGroup = VLCStringFromM3USpan(entry->groupTitle) ?: @"";
+            if (buildContext->groupPrefix) {
+                buildContext->lastGroup = [NSString stringWithFormat:@"%@: %@", buildContext->groupPrefix, buildContext->lastGroup];
+            }
         }
+        row.group = buildContext->lastGroup;
     }
     
-    // Extract logo URL (simplified) - THIS WAS MISSING!
-    NSRange logoRange = [line rangeOfString:@"tvg-logo=\""];
-    if (logoRange.location != NSNotFound) {
-        NSUInteger startPos = logoRange.location + logoRange.length;
-        NSRange endQuoteRange = [line rangeOfString:@"\"" options:0 range:NSMakeRange(startPos, line.length - startPos)];
-        if (endQuoteRange.location != NSNotFound) {
-            NSString *logoURL = [line substringWithRange:NSMakeRange(startPos, endQuoteRange.location - startPos)];
-            if (logoURL.length > 0) {
-                channel.logo = logoURL;
-            }
+    // Classified straight from the playlist bytes - no lowercased copies, no regex
+    row.category = VLCChannelCategoryName(VLCChannelClassify(self.classifier,
+                                                             entry->name.bytes, entry->name.length,
+                                                             entry->groupTitle.bytes, entry->groupTitle.length,
+                                                             entry->url.bytes, entry->url.length));
+    
+    // Fingerprints for delta refresh; the identity gets its occurrence suffix when merged
+    row.entryFingerprint = VLCM3UEntryFingerprint(entry);
+    row.entryIdentity = VLCM3UEntryIdentity(entry);
+    
+    // Catchup attributes - same rules as VLCTimeshiftManager parseCatchupAttributesInLine:
+    if (entry->catchup.length > 0) {
+        NSString *catchupValue = VLCStringFromM3USpan(entry->catchup);
+        if ([self.timeshiftManager isValidCatchupValue:catchupValue]) {
+            row.supportsCatchup = YES;
+            row.strings[VLCChannelStoreFieldCatchupSource] = entry->catchup;
+        }
+    }
+    if (entry->catchupDays.bytes) {
+        long days = VLCM3USpanToLong(entry->catchupDays);
+        if (days > 0) {
+            row.catchupDays = days;
         }
+    } else if (row.supportsCatchup) {
+        // Default to 7 days if catchup is supported but no days specified
+        row.catchupDays = 7;
     }
     
+    VLCChannel *channel = [buildContext->store appendRow:&row];
+    if (!channel) {
+        // Store full (16M rows) - fall back to a standalone channel
+        channel = [[[VLCChannel alloc] init] autorelease];
+        channel.name = VLCStringFromM3USpan(entry->name) ?: @"";
+        channel.url = VLCStringFromM3USpan(entry->url) ?: @"";
+        channel.group = row.group ?: @"";
+        channel.logo = VLCStringFromM3USpan(entry->tvgLogo) ?: @"";
+        channel.channelId = VLCStringFromM3USpan(entry->tvgId) ?: @"";
+        channel.tvgName = VLCStringFromM3USpan(entry->tvgName);
+        channel.category = row.category;
+        channel.supportsCatchup = row.supportsCatchup;
+        channel.catchupDays = row.catchupDays;
+        channel.catchupSource = row.supportsCatchup ? VLCStringFromM3USpan(entry->catchup) : nil;
+        channel.catchupTemplate = VLCStringFromM3USpan(entry->catchupTemplate);
+        channel.entryFingerprint = row.entryFingerprint;
+        channel.entryIdentity = row.entryIdentity;
+    }
     return channel;
 }
 
@@ -767,63 +2280,95 @@
 - (NSString *)determineCategoryForChannel:(VLCChannel *)channel {
     if (!channel) return @"TV";
     
-    NSString *pattern = @"(?i)[\\s\\-\\.](S\\d+|E\\d+)[\\s\\-\\.]";
+    // Cached channels: most NSStrings expose their UTF-8 bytes directly
+    const char *name = channel.name ? [channel.name UTF8String] : NULL;
+    const char *group = channel.group ? [channel.group UTF8String] : NULL;
+    const char *url = channel.url ? [channel.url UTF8String] : NULL;
     
-    NSString *lowerGroup = channel.group ? [channel.group lowercaseString] : @"";
-    NSString *lowerURL = channel.url ? [channel.url lowercaseString] : @"";
-    NSString *lowerTitle = channel.name ? [channel.name lowercaseString] : @"";
-   
-    NSError *error = nil;
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattern
-                                                                           options:NSRegularExpressionCaseInsensitive
-                                                                             error:&error];
+    VLCChannelCategory category = VLCChannelClassify(self.classifier,
+                                                     name, name ? strlen(name) : 0,
+                                                     group, group ? strlen(group) : 0,
+                                                     url, url ? strlen(url) : 0);
+    return VLCChannelCategoryName(category);
+}
+
+- (BOOL)isMovieURL:(NSString *)urlString {
+    if (!urlString || urlString.length == 0) return NO;
     
-    if (error) {
-        NSLog(@"❌ [SERIES-REGEX] Error creating regex: %@", error.localizedDescription);
-        return @"TV";
-    }
+    const char *url = [urlString UTF8String];
+    return url && VLCChannelClassifierIsMovieURL(self.classifier, url, strlen(url));
+}
 
-    // First check for series patterns in title (priority check)
-    NSRange range = [regex rangeOfFirstMatchInString:lowerTitle options:0 range:NSMakeRange(0, lowerTitle.length)];
-    BOOL isMatch = range.location != NSNotFound;
-    if (isMatch) {
-        //NSLog(@"📺 [CATEGORY] Channel '%@' → SERIES (series pattern found)", channel.name);
-        return @"SERIES";
-    }
+#pragma mark - Category Rules
 
-    // Then check for movie file extensions in URL
-    if ([lowerURL containsString:@"."] && [self isMovieURL:lowerURL]) {
-        //NSLog(@"🎬 [CATEGORY] Channel '%@' → MOVIES (URL has movie extension)", channel.name);
-        return @"MOVIES";
-    }
-    
-    // Default to TV
-    //NSLog(@"📺 [CATEGORY] Channel '%@' → TV (default)", channel.name);
-    return @"TV";
+- (void)setCategoryGroupKeywords:(NSDictionary<NSString *, NSString *> *)categoryGroupKeywords {
+    if (_categoryGroupKeywords == categoryGroupKeywords) return;
+    [_categoryGroupKeywords release];
+    _categoryGroupKeywords = [categoryGroupKeywords copy];
+    [[NSUserDefaults standardUserDefaults] setObject:_categoryGroupKeywords forKey:@"CategoryGroupKeywords"];
+    [self rebuildClassifier];
 }
 
-- (BOOL)isMovieURL:(NSString *)urlString {
-    if (!urlString || urlString.length == 0) return NO;
+- (void)setCategoryURLPatterns:(NSDictionary<NSString *, NSString *> *)categoryURLPatterns {
+    if (_categoryURLPatterns == categoryURLPatterns) return;
+    [_categoryURLPatterns release];
+    _categoryURLPatterns = [categoryURLPatterns copy];
+    [[NSUserDefaults standardUserDefaults] setObject:_categoryURLPatterns forKey:@"CategoryURLPatterns"];
+    [self rebuildClassifier];
+}
+
+// Compiles the user rules into a fresh classifier. Changes apply to channels parsed
+// (or loaded from cache) afterwards; existing categories are not rewritten.
+- (void)rebuildClassifier {
+    VLCChannelClassifier *classifier = VLCChannelClassifierCreate();
+    if (!classifier) {
+        NSLog(@"❌ [CATEGORY] Failed to create channel classifier");
+        return;
+    }
     
-    // Common movie file extensions
-    NSArray *movieExtensions = @[@".mp4", @".mkv", @".avi", @".mov", @".m4v", @".wmv", @".flv", 
-                                @".webm", @".ogv", @".3gp", @".m2ts", @".ts", @".vob", @".divx", 
-                                @".xvid", @".rmvb", @".asf", @".mpg", @".mpeg", @".m2v", @".mts"];
+    [self addCategoryRules:self.categoryURLPatterns field:VLCClassifierFieldURL toClassifier:classifier];
+    [self addCategoryRules:self.categoryGroupKeywords field:VLCClassifierFieldGroup toClassifier:classifier];
     
-    // Check if URL ends with any movie extension (case insensitive)
-    for (NSString *extension in movieExtensions) {
-        if ([urlString hasSuffix:extension]) {
-            //NSLog(@"✅ [MOVIE-CHECK] URL '%@' ends with movie extension '%@'", urlString, extension);
-            return YES;
-        }
+    VLCChannelClassifier *previous = self.classifier;
+    self.classifier = classifier;
+    if (previous) {
+        [self.retiredClassifiers addObject:[NSValue valueWithPointer:previous]];
     }
     
-    // Log when URL is not a movie file
-    if ([urlString containsString:@"http"]) {
-        //NSLog(@"❌ [MOVIE-CHECK] URL '%@' is streaming URL, not a movie file", urlString);
-    }
+    NSLog(@"📊 [CATEGORY] Classifier ready: %lu URL patterns, %lu group keywords", 
+          (unsigned long)self.categoryURLPatterns.count, (unsigned long)self.categoryGroupKeywords.count);
+}
+
+- (void)addCategoryRules:(NSDictionary<NSString *, NSString *> *)rules
+                   field:(VLCClassifierField)field
+            toClassifier:(VLCChannelClassifier *)classifier {
+    // Sorted so longer (more specific) patterns are tried first and the order is stable
+    NSArray<NSString *> *patterns = [rules.allKeys sortedArrayUsingComparator:^NSComparisonResult(NSString *a, NSString *b) {
+        if (a.length != b.length) {
+            return a.length > b.length ? NSOrderedAscending : NSOrderedDescending;
+        }
+        return [a compare:b];
+    }];
     
-    return NO;
+    for (NSString *pattern in patterns) {
+        NSString *categoryName = [[rules objectForKey:pattern] uppercaseString];
+        VLCChannelCategory category;
+        if ([categoryName isEqualToString:@"MOVIES"]) {
+            category = VLCChannelCategoryMovies;
+        } else if ([categoryName isEqualToString:@"SERIES"]) {
+            category = VLCChannelCategorySeries;
+        } else if ([categoryName isEqualToString:@"TV"]) {
+            category = VLCChannelCategoryTV;
+        } else {
+            NSLog(@"⚠️ [CATEGORY] Ignoring rule '%@' with unknown category '%@'", pattern, categoryName);
+            continue;
+        }
+        
+        const char *bytes = [pattern UTF8String];
+        if (bytes && strlen(bytes) > 0) {
+            VLCChannelClassifierAddRule(classifier, field, bytes, strlen(bytes), category);
+        }
+    }
 }
 
 #pragma mark - Cache Integration
@@ -1013,12 +2558,6 @@
     
     NSLog(@"🚀 [CACHE-PERF] Processing %lu channels in batches of %lu", (unsigned long)totalChannels, (unsigned long)batchSize);
     
-    // ULTRA-SAFE: Use simple string matching instead of regex to avoid crashes
-    // This is still very fast and avoids all regex-related memory issues
-    NSArray *movieExtensions = @[@".mp4", @".mkv", @".avi", @".mov", @".m4v", @".wmv", @".flv", @".webm", @".ts", @".m2ts"];
-    
-    NSLog(@"🚀 [CACHE-PERF] Using safe string matching for movie detection (%lu extensions)", (unsigned long)movieExtensions.count);
-    
     for (NSUInteger i = 0; i < totalChannels; i += batchSize) {
         @autoreleasepool {
             NSUInteger endIndex = MIN(i + batchSize, totalChannels);
@@ -1040,20 +2579,10 @@
                     }
                 }
                 
-                // ULTRA-FAST category determination - only for channels that need it
-                BOOL needsCategoryCheck = NO;
-                if (!channel.category || [channel.category length] == 0) {
-                    needsCategoryCheck = YES; // Missing category
-                } else if ([channel.category isEqualToString:@"TV"] && channel.url && [channel.url length] > 0) {
-                    // ULTRA-SAFE: Use simple string matching (fast and crash-free)
-                    NSString *lowercaseURL = [channel.url lowercaseString];
-                    for (NSString *extension in movieExtensions) {
-                        if ([lowercaseURL containsString:extension]) {
-                            needsCategoryCheck = YES;
-                            break;
-                        }
-                    }
-                }
+                // Re-check missing and TV categories: the classifier is cheap and picks up
+                // rules added since the cache was written
+                BOOL needsCategoryCheck = !channel.category || [channel.category length] == 0 ||
+                                          [channel.category isEqualToString:@"TV"];
                 
                 if (needsCategoryCheck) {
                     NSString *originalCategory = channel.category;
@@ -1186,6 +2715,17 @@
     return 0;
 }
 
++ (NSUInteger)getPeakMemoryUsageMB {
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
+    kern_return_t kerr = task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &size);
+    
+    if (kerr == KERN_SUCCESS) {
+        return info.resident_size_max / (1024 * 1024);
+    }
+    return 0;
+}
+
 + (void)logMemoryUsage:(NSString *)context {
     NSUInteger memoryMB = [VLCChannelManager getCurrentMemoryUsageMB];
     NSLog(@"📊 [CHANNEL] Memory usage %@: %luMB", context, (unsigned long)memoryMB);
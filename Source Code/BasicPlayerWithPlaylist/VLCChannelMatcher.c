@@ -0,0 +1,482 @@
+//
+//  VLCChannelMatcher.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable Channel Name Matcher - Platform Independent (plain C)
+//  Normalizes EPG channel ids and display names once, then answers exact lookups through a
+//  hash index and near misses through a trigram index scored by Dice similarity
+//
+
+#include "VLCChannelMatcher.h"
+#include "VLCHashIndex.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Trigrams are three bytes packed into an integer; names are padded with a byte that
+// normalization never produces so the first and last characters get trigrams of their own
+#define VLC_MATCHER_PAD 0x01u
+
+struct VLCChannelMatcher {
+    // Normalized names, back to back
+    char *bytes;
+    size_t bytesLength;
+    size_t bytesCapacity;
+    uint32_t *keyOffset;
+    uint8_t *keyLength;
+    uint32_t *keyTarget;
+    size_t keyCount;
+    size_t keyCapacity;
+    VLCHashIndex *exact;        // Hash of a normalized name -> first key + 1
+
+    // Trigram index, built by VLCChannelMatcherFinish
+    uint32_t *gramStart;        // keyCount + 1 offsets into grams
+    uint32_t *grams;            // Each key's distinct trigrams, ascending
+    VLCHashIndex *gramSlots;    // Trigram -> posting list + 1
+    uint32_t *postingStart;     // slotCount + 1 offsets into postings
+    uint32_t *postings;         // Keys containing each trigram, ascending
+    size_t slotCount;
+    size_t gramCount;
+
+    // Candidate marks for FindSimilar: key i was seen in the current query when stamp[i] == generation
+    uint32_t *stamp;
+    uint32_t generation;
+};
+
+#pragma mark - Normalization
+
+static inline int VLCMatcherIsAlnum(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+static inline int VLCMatcherIsAlpha(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static inline unsigned char VLCMatcherLower(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + 32) : c;
+}
+
+// Tokens that say how a channel is delivered rather than which channel it is
+static int VLCMatcherIsNoiseToken(const unsigned char *token, size_t length) {
+    static const char *const noise[] = {
+        "hd", "fhd", "uhd", "sd", "4k", "8k", "hevc", "h264", "h265", "hdr", "raw", "backup"
+    };
+    for (size_t i = 0; i < sizeof(noise) / sizeof(noise[0]); i++) {
+        size_t noiseLength = strlen(noise[i]);
+        if (noiseLength != length) {
+            continue;
+        }
+        size_t j = 0;
+        while (j < length && VLCMatcherLower(token[j]) == (unsigned char)noise[i][j]) j++;
+        if (j == length) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+size_t VLCChannelMatcherNormalize(const char *bytes, size_t length, char *out, size_t capacity) {
+    const unsigned char *text = (const unsigned char *)bytes;
+    size_t start = 0;
+    size_t end = length;
+
+    // Leading country tag: "UK: ", "|US| ", "[DE] ", "FR | "
+    size_t cursor = 0;
+    while (cursor < end && (text[cursor] == '|' || text[cursor] == '[' || text[cursor] == ' ')) cursor++;
+    size_t tagStart = cursor;
+    while (cursor < end && VLCMatcherIsAlpha(text[cursor])) cursor++;
+    size_t tagLength = cursor - tagStart;
+    while (cursor < end && text[cursor] == ' ') cursor++;
+    if (tagLength >= 2 && tagLength <= 3 && cursor < end &&
+        (text[cursor] == ':' || text[cursor] == '|' || text[cursor] == ']')) {
+        start = cursor + 1;
+    }
+
+    // Trailing country suffix of XMLTV ids: "bbcone.uk"
+    size_t dot = end;
+    while (dot > start && text[dot - 1] != '.') dot--;
+    if (dot > start + 1 && end - dot >= 2 && end - dot <= 3) {
+        int letters = 1;
+        for (size_t i = dot; i < end; i++) {
+            if (!VLCMatcherIsAlpha(text[i])) letters = 0;
+        }
+        if (letters) {
+            end = dot - 1;
+        }
+    }
+
+    // Letters, digits and non-ASCII bytes form tokens; everything else separates them
+    size_t written = 0;
+    size_t i = start;
+    while (i < end && written < capacity) {
+        if (text[i] < 0x80 && !VLCMatcherIsAlnum(text[i])) {
+            i++;
+            continue;
+        }
+        size_t tokenStart = i;
+        while (i < end && (text[i] >= 0x80 || VLCMatcherIsAlnum(text[i]))) i++;
+        if (VLCMatcherIsNoiseToken(text + tokenStart, i - tokenStart)) {
+            continue;
+        }
+        for (size_t j = tokenStart; j < i && written < capacity; j++) {
+            out[written++] = (char)VLCMatcherLower(text[j]);
+        }
+    }
+    return written;
+}
+
+#pragma mark - Trigrams
+
+static int VLCMatcherCompareGrams(const void *a, const void *b) {
+    uint32_t left = *(const uint32_t *)a;
+    uint32_t right = *(const uint32_t *)b;
+    return left < right ? -1 : (left > right);
+}
+
+// Distinct trigrams of a normalized name, ascending. grams needs room for length entries.
+static size_t VLCMatcherGrams(const char *name, size_t length, uint32_t *grams) {
+    if (length == 0) {
+        return 0;
+    }
+    const unsigned char *text = (const unsigned char *)name;
+    for (size_t i = 0; i < length; i++) {
+        uint32_t a = i == 0 ? VLC_MATCHER_PAD : text[i - 1];
+        uint32_t b = text[i];
+        uint32_t c = i + 1 < length ? text[i + 1] : VLC_MATCHER_PAD;
+        grams[i] = (a << 16) | (b << 8) | c;
+    }
+    qsort(grams, length, sizeof(uint32_t), VLCMatcherCompareGrams);
+    size_t distinct = 1;
+    for (size_t i = 1; i < length; i++) {
+        if (grams[i] != grams[distinct - 1]) {
+            grams[distinct++] = grams[i];
+        }
+    }
+    return distinct;
+}
+
+static size_t VLCMatcherCommonGrams(const uint32_t *a, size_t aCount, const uint32_t *b, size_t bCount) {
+    size_t i = 0, j = 0, common = 0;
+    while (i < aCount && j < bCount) {
+        if (a[i] == b[j]) {
+            common++;
+            i++;
+            j++;
+        } else if (a[i] < b[j]) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return common;
+}
+
+#pragma mark - Lifecycle
+
+VLCChannelMatcher *VLCChannelMatcherCreate(size_t expectedNames) {
+    VLCChannelMatcher *matcher = calloc(1, sizeof(VLCChannelMatcher));
+    if (!matcher) {
+        return NULL;
+    }
+    matcher->exact = VLCHashIndexCreate(expectedNames);
+    if (!matcher->exact) {
+        free(matcher);
+        return NULL;
+    }
+    return matcher;
+}
+
+void VLCChannelMatcherFree(VLCChannelMatcher *matcher) {
+    if (!matcher) {
+        return;
+    }
+    free(matcher->bytes);
+    free(matcher->keyOffset);
+    free(matcher->keyLength);
+    free(matcher->keyTarget);
+    VLCHashIndexFree(matcher->exact);
+    free(matcher->gramStart);
+    free(matcher->grams);
+    VLCHashIndexFree(matcher->gramSlots);
+    free(matcher->postingStart);
+    free(matcher->postings);
+    free(matcher->stamp);
+    free(matcher);
+}
+
+size_t VLCChannelMatcherCount(const VLCChannelMatcher *matcher) {
+    return matcher ? matcher->keyCount : 0;
+}
+
+size_t VLCChannelMatcherBytesAllocated(const VLCChannelMatcher *matcher) {
+    if (!matcher) {
+        return 0;
+    }
+    return matcher->bytesCapacity +
+           matcher->keyCapacity * (sizeof(uint32_t) * 2 + sizeof(uint8_t)) +
+           (matcher->gramStart ? (matcher->keyCount + 1) * sizeof(uint32_t) * 2 : 0) +
+           matcher->gramCount * sizeof(uint32_t) * 2 +
+           (matcher->postingStart ? (matcher->slotCount + 1) * sizeof(uint32_t) : 0);
+}
+
+#pragma mark - Adding
+
+static int VLCMatcherGrow(void **array, size_t elementSize, size_t *capacity, size_t needed) {
+    if (needed <= *capacity) {
+        return 1;
+    }
+    size_t newCapacity = *capacity ? *capacity : 256;
+    while (newCapacity < needed) newCapacity *= 2;
+    void *grown = realloc(*array, newCapacity * elementSize);
+    if (!grown) {
+        return 0;
+    }
+    *array = grown;
+    *capacity = newCapacity;
+    return 1;
+}
+
+int VLCChannelMatcherAdd(VLCChannelMatcher *matcher, const char *bytes, size_t length, uint32_t target) {
+    if (!matcher || matcher->gramStart || target == VLC_CHANNEL_MATCHER_NONE) {
+        return matcher != NULL;
+    }
+    char normalized[VLC_CHANNEL_MATCHER_MAX_LENGTH];
+    size_t normalizedLength = VLCChannelMatcherNormalize(bytes, length, normalized, sizeof(normalized));
+    if (normalizedLength == 0) {
+        return 1;
+    }
+    if (matcher->keyCount >= UINT32_MAX - 1 || matcher->bytesLength + normalizedLength > UINT32_MAX) {
+        return 0;
+    }
+
+    size_t keyCapacity = matcher->keyCapacity;
+    if (!VLCMatcherGrow((void **)&matcher->keyOffset, sizeof(uint32_t), &keyCapacity, matcher->keyCount + 1)) {
+        return 0;
+    }
+    keyCapacity = matcher->keyCapacity;
+    if (!VLCMatcherGrow((void **)&matcher->keyLength, sizeof(uint8_t), &keyCapacity, matcher->keyCount + 1)) {
+        return 0;
+    }
+    keyCapacity = matcher->keyCapacity;
+    if (!VLCMatcherGrow((void **)&matcher->keyTarget, sizeof(uint32_t), &keyCapacity, matcher->keyCount + 1)) {
+        return 0;
+    }
+    matcher->keyCapacity = keyCapacity;
+    if (!VLCMatcherGrow((void **)&matcher->bytes, 1, &matcher->bytesCapacity, matcher->bytesLength + normalizedLength)) {
+        return 0;
+    }
+
+    uint32_t key = (uint32_t)matcher->keyCount;
+    uint32_t *slot = VLCHashIndexSlot(matcher->exact, VLCHashBytes(normalized, normalizedLength, VLC_HASH_SEED));
+    if (!slot) {
+        return 0;
+    }
+    if (*slot == 0) {
+        *slot = key + 1;
+    }
+
+    memcpy(matcher->bytes + matcher->bytesLength, normalized, normalizedLength);
+    matcher->keyOffset[key] = (uint32_t)matcher->bytesLength;
+    matcher->keyLength[key] = (uint8_t)normalizedLength;
+    matcher->keyTarget[key] = target;
+    matcher->bytesLength += normalizedLength;
+    matcher->keyCount++;
+    return 1;
+}
+
+int VLCChannelMatcherFinish(VLCChannelMatcher *matcher) {
+    if (!matcher || matcher->gramStart) {
+        return matcher != NULL;
+    }
+    size_t keyCount = matcher->keyCount;
+
+    // Every key's distinct trigrams; a name of n bytes has at most n
+    uint32_t *gramStart = malloc((keyCount + 1) * sizeof(uint32_t));
+    uint32_t *grams = malloc((matcher->bytesLength ? matcher->bytesLength : 1) * sizeof(uint32_t));
+    VLCHashIndex *gramSlots = VLCHashIndexCreate(keyCount * 4);
+    uint32_t *slotCounts = NULL;
+    size_t slotCapacity = 0;
+    size_t slotCount = 0;
+    if (!gramStart || !grams || !gramSlots) {
+        goto fail;
+    }
+    size_t gramCount = 0;
+    for (size_t key = 0; key < keyCount; key++) {
+        gramStart[key] = (uint32_t)gramCount;
+        size_t count = VLCMatcherGrams(matcher->bytes + matcher->keyOffset[key], matcher->keyLength[key], grams + gramCount);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t *slot = VLCHashIndexSlot(gramSlots, grams[gramCount + i]);
+            if (!slot) {
+                goto fail;
+            }
+            if (*slot == 0) {
+                if (!VLCMatcherGrow((void **)&slotCounts, sizeof(uint32_t), &slotCapacity, slotCount + 1)) {
+                    goto fail;
+                }
+                slotCounts[slotCount] = 0;
+                *slot = (uint32_t)++slotCount;
+            }
+            slotCounts[*slot - 1]++;
+        }
+        gramCount += count;
+    }
+    gramStart[keyCount] = (uint32_t)gramCount;
+
+    // Posting lists, filled in key order so each list is ascending
+    uint32_t *postingStart = malloc((slotCount + 1) * sizeof(uint32_t));
+    uint32_t *postings = malloc((gramCount ? gramCount : 1) * sizeof(uint32_t));
+    uint32_t *stamp = calloc(keyCount ? keyCount : 1, sizeof(uint32_t));
+    if (!postingStart || !postings || !stamp) {
+        free(postingStart);
+        free(postings);
+        free(stamp);
+        goto fail;
+    }
+    uint32_t offset = 0;
+    for (size_t slot = 0; slot < slotCount; slot++) {
+        postingStart[slot] = offset;
+        offset += slotCounts[slot];
+        slotCounts[slot] = postingStart[slot];  // Reused as the fill cursor
+    }
+    postingStart[slotCount] = offset;
+    for (size_t key = 0; key < keyCount; key++) {
+        for (uint32_t i = gramStart[key]; i < gramStart[key + 1]; i++) {
+            uint32_t slot = VLCHashIndexGet(gramSlots, grams[i]) - 1;
+            postings[slotCounts[slot]++] = (uint32_t)key;
+        }
+    }
+    free(slotCounts);
+
+    matcher->gramStart = gramStart;
+    matcher->grams = grams;
+    matcher->gramSlots = gramSlots;
+    matcher->postingStart = postingStart;
+    matcher->postings = postings;
+    matcher->slotCount = slotCount;
+    matcher->gramCount = gramCount;
+    matcher->stamp = stamp;
+    return 1;
+
+fail:
+    free(gramStart);
+    free(grams);
+    VLCHashIndexFree(gramSlots);
+    free(slotCounts);
+    return 0;
+}
+
+#pragma mark - Lookup
+
+uint32_t VLCChannelMatcherFindExact(const VLCChannelMatcher *matcher, const char *bytes, size_t length) {
+    if (!matcher) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    char normalized[VLC_CHANNEL_MATCHER_MAX_LENGTH];
+    size_t normalizedLength = VLCChannelMatcherNormalize(bytes, length, normalized, sizeof(normalized));
+    if (normalizedLength == 0) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    uint32_t value = VLCHashIndexGet(matcher->exact, VLCHashBytes(normalized, normalizedLength, VLC_HASH_SEED));
+    if (value == 0) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    // 64-bit hashes of different names can still collide
+    uint32_t key = value - 1;
+    if (matcher->keyLength[key] != normalizedLength ||
+        memcmp(matcher->bytes + matcher->keyOffset[key], normalized, normalizedLength) != 0) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    return matcher->keyTarget[key];
+}
+
+typedef struct {
+    uint32_t gram;
+    uint32_t slot;      // Posting list + 1, 0 when no key has the trigram
+    uint32_t count;     // Posting list length
+} VLCMatcherQueryGram;
+
+static int VLCMatcherCompareByRarity(const void *a, const void *b) {
+    const VLCMatcherQueryGram *left = a;
+    const VLCMatcherQueryGram *right = b;
+    if (left->count != right->count) {
+        return left->count < right->count ? -1 : 1;
+    }
+    return left->gram < right->gram ? -1 : (left->gram > right->gram);
+}
+
+uint32_t VLCChannelMatcherFindSimilar(VLCChannelMatcher *matcher, const char *bytes, size_t length,
+                                      double minScore, double *score) {
+    if (!matcher || !matcher->gramStart || minScore <= 0.0 || minScore > 1.0) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    char normalized[VLC_CHANNEL_MATCHER_MAX_LENGTH];
+    size_t normalizedLength = VLCChannelMatcherNormalize(bytes, length, normalized, sizeof(normalized));
+    uint32_t grams[VLC_CHANNEL_MATCHER_MAX_LENGTH];
+    size_t gramCount = VLCMatcherGrams(normalized, normalizedLength, grams);
+    if (gramCount == 0) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+
+    VLCMatcherQueryGram query[VLC_CHANNEL_MATCHER_MAX_LENGTH];
+    for (size_t i = 0; i < gramCount; i++) {
+        uint32_t slot = VLCHashIndexGet(matcher->gramSlots, grams[i]);
+        query[i].gram = grams[i];
+        query[i].slot = slot;
+        query[i].count = slot ? matcher->postingStart[slot] - matcher->postingStart[slot - 1] : 0;
+    }
+    qsort(query, gramCount, sizeof(VLCMatcherQueryGram), VLCMatcherCompareByRarity);
+
+    // A key scoring minScore shares at least minCommon trigrams with the query, so it has to
+    // contain one of the gramCount - minCommon + 1 rarest ones. Only those lists are walked.
+    size_t minCommon = (size_t)ceil(minScore * (double)gramCount / (2.0 - minScore) - 1e-9);
+    if (minCommon < 1) minCommon = 1;
+    if (minCommon > gramCount) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    size_t prefix = gramCount - minCommon + 1;
+
+    if (++matcher->generation == 0) {
+        memset(matcher->stamp, 0, matcher->keyCount * sizeof(uint32_t));
+        matcher->generation = 1;
+    }
+    uint32_t generation = matcher->generation;
+
+    uint32_t bestKey = VLC_CHANNEL_MATCHER_NONE;
+    double bestScore = 0.0;
+    for (size_t q = 0; q < prefix; q++) {
+        if (query[q].slot == 0) {
+            continue;
+        }
+        uint32_t listStart = matcher->postingStart[query[q].slot - 1];
+        uint32_t listEnd = matcher->postingStart[query[q].slot];
+        for (uint32_t p = listStart; p < listEnd; p++) {
+            uint32_t key = matcher->postings[p];
+            if (matcher->stamp[key] == generation) {
+                continue;
+            }
+            matcher->stamp[key] = generation;
+
+            size_t keyGramCount = matcher->gramStart[key + 1] - matcher->gramStart[key];
+            // Dice can't reach minScore when the sizes are too far apart
+            size_t smaller = keyGramCount < gramCount ? keyGramCount : gramCount;
+            if (2.0 * (double)smaller < minScore * (double)(keyGramCount + gramCount)) {
+                continue;
+            }
+            size_t common = VLCMatcherCommonGrams(grams, gramCount, matcher->grams + matcher->gramStart[key], keyGramCount);
+            double keyScore = 2.0 * (double)common / (double)(keyGramCount + gramCount);
+            if (keyScore >= minScore && (keyScore > bestScore || (keyScore == bestScore && key < bestKey))) {
+                bestScore = keyScore;
+                bestKey = key;
+            }
+        }
+    }
+    if (bestKey == VLC_CHANNEL_MATCHER_NONE) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    if (score) {
+        *score = bestScore;
+    }
+    return matcher->keyTarget[bestKey];
+}
@@ -0,0 +1,72 @@
+//
+//  VLCChannelMatcher.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable Channel Name Matcher - Platform Independent (plain C)
+//  Normalizes EPG channel ids and display names once, then answers exact lookups through a
+//  hash index and near misses through a trigram index scored by Dice similarity
+//
+
+#ifndef VLCChannelMatcher_h
+#define VLCChannelMatcher_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Result of a lookup that found nothing
+#define VLC_CHANNEL_MATCHER_NONE UINT32_MAX
+
+// Normalized names are cut to this many bytes
+#define VLC_CHANNEL_MATCHER_MAX_LENGTH 255
+
+typedef struct VLCChannelMatcher VLCChannelMatcher;
+
+/**
+ * Normalizes a channel name or id into out (up to capacity bytes): drops a leading country
+ * tag ("UK:", "|US|", "[DE]"), a trailing country suffix (".uk"), quality tokens (HD, FHD,
+ * UHD, SD, 4K, HEVC...) and everything that is not a letter or digit, and lowercases ASCII.
+ * Bytes of non-ASCII characters are kept as they are.
+ * @return The normalized length.
+ */
+size_t VLCChannelMatcherNormalize(const char *bytes, size_t length, char *out, size_t capacity);
+
+// NULL on allocation failure
+VLCChannelMatcher *VLCChannelMatcherCreate(size_t expectedNames);
+void VLCChannelMatcherFree(VLCChannelMatcher *matcher);
+
+/**
+ * Adds a name for target (an index of the caller's). Several names may share a target; when
+ * several targets share a normalized name, exact lookups return the first one added.
+ * Names that normalize to nothing are ignored. Call before VLCChannelMatcherFinish.
+ * @return 0 when memory runs out.
+ */
+int VLCChannelMatcherAdd(VLCChannelMatcher *matcher, const char *bytes, size_t length, uint32_t target);
+
+// Builds the trigram index. Returns 0 when memory runs out; exact lookups still work then.
+int VLCChannelMatcherFinish(VLCChannelMatcher *matcher);
+
+// Names added so far
+size_t VLCChannelMatcherCount(const VLCChannelMatcher *matcher);
+size_t VLCChannelMatcherBytesAllocated(const VLCChannelMatcher *matcher);
+
+// Target whose normalized name equals the normalized name given
+uint32_t VLCChannelMatcherFindExact(const VLCChannelMatcher *matcher, const char *bytes, size_t length);
+
+/**
+ * Target whose name is most similar to the name given: Dice coefficient over the distinct
+ * trigrams of both normalized names, at least minScore (0-1]. Ties go to the name added first.
+ * Uses scratch memory in the matcher, so lookups must not run concurrently.
+ * @param score Receives the winning score when not NULL.
+ */
+uint32_t VLCChannelMatcherFindSimilar(VLCChannelMatcher *matcher, const char *bytes, size_t length,
+                                      double minScore, double *score);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCChannelMatcher_h */
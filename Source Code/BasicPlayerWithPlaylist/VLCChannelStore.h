@@ -0,0 +1,102 @@
+//
+//  VLCChannelStore.h
+//  BasicPlayerWithPlaylist
+//
+//  Columnar Channel Store - Platform Independent
+//  Keeps playlist fields as pooled string references and small columns; VLCChannel
+//  objects are thin facades that read their fields from a store row on demand
+//
+
+#import <Foundation/Foundation.h>
+#import "VLCM3UTokenizer.h"
+#import "VLCChannelClassifier.h"
+
+@class VLCChannel;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// String columns of a row. The URL comes last: it is stored as a shared prefix id plus
+// a pooled suffix instead of a plain pooled string.
+typedef NS_ENUM(NSUInteger, VLCChannelStoreField) {
+    VLCChannelStoreFieldName = 0,
+    VLCChannelStoreFieldLogo,
+    VLCChannelStoreFieldChannelId,
+    VLCChannelStoreFieldCatchupSource,
+    VLCChannelStoreFieldCatchupTemplate,
+    VLCChannelStoreFieldTvgName,
+    VLCChannelStoreFieldURL,
+    VLCChannelStoreFieldCount
+};
+
+// Input for one appended row. Spans are copied into the store's string pool.
+typedef struct {
+    VLCM3USpan strings[VLCChannelStoreFieldCount];
+    NSString * _Nullable group;         // Usually one interned string per group
+    NSString * _Nullable category;
+    BOOL supportsCatchup;
+    NSInteger catchupDays;
+    uint64_t entryFingerprint;
+    uint64_t entryIdentity;
+} VLCChannelStoreRow;
+
+// Constant category name for a classifier result
+NSString *VLCChannelCategoryName(VLCChannelCategory category);
+
+@interface VLCChannelStore : NSObject
+
+@property (nonatomic, readonly) NSUInteger count;
+
+// Bytes held by the pool, the columns and the group table (excluding facade objects)
+@property (nonatomic, readonly) size_t bytesAllocated;
+
+// Distinct URL prefixes and the URL bytes they saved (prefix bytes not repeated per row)
+@property (nonatomic, readonly) NSUInteger urlPrefixCount;
+@property (nonatomic, readonly) size_t urlBytesShared;
+
+/**
+ * Appends a row and returns its facade (autoreleased), or nil when the store is full.
+ * Rows are appended by one thread at a time (a parse shard or stream); reading existing
+ * rows from other threads is safe meanwhile.
+ */
+- (VLCChannel * _Nullable)appendRow:(const VLCChannelStoreRow *)row;
+
+// Called once parsing is done; releases append-only bookkeeping
+- (void)finishAppending;
+
+// Row accessors used by VLCChannel. Setters are thread safe.
+// setString: returns NO when the string cannot be pooled (longer than 64 KB); the row keeps its value.
+- (NSString * _Nullable)stringForField:(VLCChannelStoreField)field row:(uint32_t)row;
+- (BOOL)setString:(NSString * _Nullable)string forField:(VLCChannelStoreField)field row:(uint32_t)row;
+- (NSString * _Nullable)groupAtRow:(uint32_t)row;
+- (void)setGroup:(NSString * _Nullable)group atRow:(uint32_t)row;
+- (NSString * _Nullable)categoryAtRow:(uint32_t)row;
+- (void)setCategory:(NSString * _Nullable)category atRow:(uint32_t)row;
+- (BOOL)supportsCatchupAtRow:(uint32_t)row;
+- (void)setSupportsCatchup:(BOOL)supportsCatchup atRow:(uint32_t)row;
+- (NSInteger)catchupDaysAtRow:(uint32_t)row;
+- (void)setCatchupDays:(NSInteger)catchupDays atRow:(uint32_t)row;
+- (uint64_t)entryFingerprintAtRow:(uint32_t)row;
+- (void)setEntryFingerprint:(uint64_t)entryFingerprint atRow:(uint32_t)row;
+- (uint64_t)entryIdentityAtRow:(uint32_t)row;
+- (void)setEntryIdentity:(uint64_t)entryIdentity atRow:(uint32_t)row;
+
+@end
+
+/**
+ * Shares URL prefixes across a serialized channel list (channel cache, favorites). Each
+ * dictionary keeps "urlPrefix" (an index into prefixes) plus the remaining "url" suffix;
+ * dictionaries without "urlPrefix" hold the whole URL, as written by older versions.
+ */
+@interface VLCURLPrefixEncoder : NSObject
+
+@property (nonatomic, readonly) NSArray<NSString *> *prefixes;
+
+// Pass the prefixes stored next to already encoded dictionaries to decode or extend them
+- (instancetype)initWithPrefixes:(nullable NSArray<NSString *> *)prefixes;
+
+- (void)setURL:(nullable NSString *)url inDictionary:(NSMutableDictionary *)dictionary;
+- (nullable NSString *)URLFromDictionary:(NSDictionary *)dictionary;
+
+@end
+
+NS_ASSUME_NONNULL_END
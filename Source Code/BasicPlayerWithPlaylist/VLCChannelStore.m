@@ -0,0 +1,526 @@
+//
+//  VLCChannelStore.m
+//  BasicPlayerWithPlaylist
+//
+//  Columnar Channel Store - Platform Independent
+//  Keeps playlist fields as pooled string references and small columns; VLCChannel
+//  objects are thin facades that read their fields from a store row on demand
+//
+
+#import "VLCChannelStore.h"
+#import "VLCChannel.h"
+#import "VLCStringPool.h"
+#import "VLCURLPrefixTable.h"
+#import <pthread.h>
+
+// Rows live in fixed-size chunks that are never reallocated, so readers can use a row
+// while the parser appends more. 2^10 rows per chunk, up to 2^14 chunks (16M rows).
+#define VLC_CHANNEL_STORE_CHUNK_BITS 10
+#define VLC_CHANNEL_STORE_CHUNK_ROWS ((uint32_t)1 << VLC_CHANNEL_STORE_CHUNK_BITS)
+#define VLC_CHANNEL_STORE_MAX_CHUNKS ((size_t)1 << 14)
+
+// Group names, same scheme: 2^10 per block, up to 2^10 blocks
+#define VLC_CHANNEL_STORE_GROUP_BITS 10
+#define VLC_CHANNEL_STORE_GROUP_BLOCK ((uint32_t)1 << VLC_CHANNEL_STORE_GROUP_BITS)
+#define VLC_CHANNEL_STORE_MAX_GROUP_BLOCKS ((size_t)1 << 10)
+
+#define VLC_CHANNEL_STORE_MAX_CATEGORIES 255
+#define VLC_CHANNEL_STORE_NO_GROUP UINT32_MAX
+#define VLC_CHANNEL_STORE_NO_CATEGORY UINT8_MAX
+
+// Fields kept as plain pooled strings; the URL has its own packed column
+#define VLC_CHANNEL_STORE_POOLED_FIELDS VLCChannelStoreFieldURL
+
+// URL column value: prefix id in the high half, suffix reference in the low half, so a
+// reader never sees the prefix of one URL with the suffix of another
+#define VLC_CHANNEL_STORE_URL(prefixId, suffix) (((uint64_t)(prefixId) << 32) | (uint64_t)(suffix))
+#define VLC_CHANNEL_STORE_URL_PREFIX(url) ((uint32_t)((url) >> 32))
+#define VLC_CHANNEL_STORE_URL_SUFFIX(url) ((VLCStringRef)((url) & 0xFFFFFFFFu))
+
+// URLs are rebuilt on the stack up to this length
+#define VLC_CHANNEL_STORE_URL_BUFFER 1024
+
+// Struct-of-arrays chunk: about 54 bytes per row plus the pooled string bytes
+typedef struct {
+    VLCStringRef strings[VLC_CHANNEL_STORE_POOLED_FIELDS][VLC_CHANNEL_STORE_CHUNK_ROWS];
+    uint64_t url[VLC_CHANNEL_STORE_CHUNK_ROWS];
+    uint32_t group[VLC_CHANNEL_STORE_CHUNK_ROWS];
+    int32_t catchupDays[VLC_CHANNEL_STORE_CHUNK_ROWS];
+    uint8_t category[VLC_CHANNEL_STORE_CHUNK_ROWS];
+    uint8_t supportsCatchup[VLC_CHANNEL_STORE_CHUNK_ROWS];
+    uint64_t entryFingerprint[VLC_CHANNEL_STORE_CHUNK_ROWS];
+    uint64_t entryIdentity[VLC_CHANNEL_STORE_CHUNK_ROWS];
+} VLCChannelStoreChunk;
+
+NSString *VLCChannelCategoryName(VLCChannelCategory category) {
+    switch (category) {
+        case VLCChannelCategoryMovies: return @"MOVIES";
+        case VLCChannelCategorySeries: return @"SERIES";
+        case VLCChannelCategoryTV:
+        default: return @"TV";
+    }
+}
+
+// Strings read from playlists are usually UTF-8, but some providers ship Latin-1
+static NSString *VLCChannelStoreMakeString(const char *bytes, size_t length) {
+    NSString *string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    if (!string) {
+        string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSISOLatin1StringEncoding];
+    }
+    return [string autorelease];
+}
+
+@implementation VLCChannelStore {
+    VLCStringPool *_pool;
+    VLCURLPrefixTable *_urlPrefixes;
+    size_t _urlBytesShared;
+    VLCChannelStoreChunk **_chunks;
+    size_t _chunkCount;
+    NSUInteger _count;
+    
+    NSString ***_groupBlocks;
+    uint32_t _groupCount;
+    NSMutableDictionary<NSString *, NSNumber *> *_groupIds;
+    NSString *_lastGroup;
+    uint32_t _lastGroupId;
+    
+    NSString *_categories[VLC_CHANNEL_STORE_MAX_CATEGORIES];
+    uint8_t _categoryCount;
+    
+    pthread_mutex_t _writeLock;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _pool = VLCStringPoolCreate();
+        _urlPrefixes = VLCURLPrefixTableCreate();
+        _chunks = calloc(VLC_CHANNEL_STORE_MAX_CHUNKS, sizeof(VLCChannelStoreChunk *));
+        _groupBlocks = calloc(VLC_CHANNEL_STORE_MAX_GROUP_BLOCKS, sizeof(NSString **));
+        _groupIds = [[NSMutableDictionary alloc] init];
+        _lastGroupId = VLC_CHANNEL_STORE_NO_GROUP;
+        pthread_mutex_init(&_writeLock, NULL);
+        
+        if (!_pool || !_urlPrefixes || !_chunks || !_groupBlocks) {
+            [self release];
+            return nil;
+        }
+        
+        // Classifier results map straight onto the first category slots
+        _categories[VLCChannelCategoryTV] = [VLCChannelCategoryName(VLCChannelCategoryTV) retain];
+        _categories[VLCChannelCategoryMovies] = [VLCChannelCategoryName(VLCChannelCategoryMovies) retain];
+        _categories[VLCChannelCategorySeries] = [VLCChannelCategoryName(VLCChannelCategorySeries) retain];
+        _categoryCount = 3;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    VLCStringPoolFree(_pool);
+    VLCURLPrefixTableFree(_urlPrefixes);
+    if (_chunks) {
+        for (size_t i = 0; i < _chunkCount; i++) {
+            free(_chunks[i]);
+        }
+        free(_chunks);
+    }
+    if (_groupBlocks) {
+        for (uint32_t i = 0; i < _groupCount; i++) {
+            [_groupBlocks[i >> VLC_CHANNEL_STORE_GROUP_BITS][i & (VLC_CHANNEL_STORE_GROUP_BLOCK - 1)] release];
+        }
+        for (size_t i = 0; i < VLC_CHANNEL_STORE_MAX_GROUP_BLOCKS && _groupBlocks[i]; i++) {
+            free(_groupBlocks[i]);
+        }
+        free(_groupBlocks);
+    }
+    for (uint8_t i = 0; i < _categoryCount; i++) {
+        [_categories[i] release];
+    }
+    [_groupIds release];
+    [_lastGroup release];
+    pthread_mutex_destroy(&_writeLock);
+    [super dealloc];
+}
+
+#pragma mark - Properties
+
+- (NSUInteger)count {
+    return __atomic_load_n(&_count, __ATOMIC_ACQUIRE);
+}
+
+- (size_t)bytesAllocated {
+    pthread_mutex_lock(&_writeLock);
+    size_t bytes = VLCStringPoolBytesAllocated(_pool);
+    bytes += VLCURLPrefixTableBytesAllocated(_urlPrefixes);
+    bytes += _chunkCount * sizeof(VLCChannelStoreChunk);
+    bytes += VLC_CHANNEL_STORE_MAX_CHUNKS * sizeof(VLCChannelStoreChunk *);
+    bytes += VLC_CHANNEL_STORE_MAX_GROUP_BLOCKS * sizeof(NSString **);
+    bytes += ((_groupCount + VLC_CHANNEL_STORE_GROUP_BLOCK - 1) / VLC_CHANNEL_STORE_GROUP_BLOCK) *
+             VLC_CHANNEL_STORE_GROUP_BLOCK * sizeof(NSString *);
+    pthread_mutex_unlock(&_writeLock);
+    return bytes;
+}
+
+- (NSUInteger)urlPrefixCount {
+    pthread_mutex_lock(&_writeLock);
+    NSUInteger count = VLCURLPrefixTableCount(_urlPrefixes);
+    pthread_mutex_unlock(&_writeLock);
+    return count;
+}
+
+- (size_t)urlBytesShared {
+    pthread_mutex_lock(&_writeLock);
+    size_t bytes = _urlBytesShared;
+    pthread_mutex_unlock(&_writeLock);
+    return bytes;
+}
+
+#pragma mark - Row Addressing
+
+static inline VLCChannelStoreChunk *VLCChannelStoreChunkForRow(VLCChannelStoreChunk **chunks, uint32_t row) {
+    return chunks[row >> VLC_CHANNEL_STORE_CHUNK_BITS];
+}
+
+static inline uint32_t VLCChannelStoreSlot(uint32_t row) {
+    return row & (VLC_CHANNEL_STORE_CHUNK_ROWS - 1);
+}
+
+// Callers hold _writeLock
+- (uint32_t)groupIdForGroup:(NSString *)group {
+    if (!group) {
+        return VLC_CHANNEL_STORE_NO_GROUP;
+    }
+    // Parsers pass the same interned string for a run of channels
+    if (group == _lastGroup) {
+        return _lastGroupId;
+    }
+    
+    NSNumber *existing = [_groupIds objectForKey:group];
+    uint32_t groupId;
+    if (existing) {
+        groupId = [existing unsignedIntValue];
+    } else {
+        size_t block = _groupCount >> VLC_CHANNEL_STORE_GROUP_BITS;
+        if (block >= VLC_CHANNEL_STORE_MAX_GROUP_BLOCKS) {
+            return VLC_CHANNEL_STORE_NO_GROUP;
+        }
+        if (!_groupBlocks[block]) {
+            _groupBlocks[block] = calloc(VLC_CHANNEL_STORE_GROUP_BLOCK, sizeof(NSString *));
+            if (!_groupBlocks[block]) {
+                return VLC_CHANNEL_STORE_NO_GROUP;
+            }
+        }
+        groupId = _groupCount;
+        _groupBlocks[block][groupId & (VLC_CHANNEL_STORE_GROUP_BLOCK - 1)] = [group copy];
+        __atomic_store_n(&_groupCount, groupId + 1, __ATOMIC_RELEASE);
+        [_groupIds setObject:@(groupId) forKey:group];
+    }
+    
+    [_lastGroup release];
+    _lastGroup = [group retain];
+    _lastGroupId = groupId;
+    return groupId;
+}
+
+// Callers hold _writeLock
+- (uint8_t)categoryIdForCategory:(NSString *)category {
+    if (!category) {
+        return VLC_CHANNEL_STORE_NO_CATEGORY;
+    }
+    for (uint8_t i = 0; i < _categoryCount; i++) {
+        if (_categories[i] == category || [_categories[i] isEqualToString:category]) {
+            return i;
+        }
+    }
+    if (_categoryCount == VLC_CHANNEL_STORE_MAX_CATEGORIES) {
+        return VLC_CHANNEL_STORE_NO_CATEGORY;
+    }
+    _categories[_categoryCount] = [category copy];
+    return _categoryCount++;
+}
+
+static inline int VLCChannelStoreInterns(VLCChannelStoreField field) {
+    // A handful of distinct values across the whole playlist
+    return field == VLCChannelStoreFieldCatchupSource || field == VLCChannelStoreFieldCatchupTemplate;
+}
+
+// Callers hold _writeLock. Returns NO when the URL cannot be pooled.
+- (BOOL)packURL:(const char *)bytes length:(size_t)length into:(uint64_t *)packed {
+    uint32_t prefixId = VLC_URL_PREFIX_NONE;
+    size_t prefixLength = VLCURLPrefixLength(bytes, length);
+    if (prefixLength > 0) {
+        prefixId = VLCURLPrefixTableIntern(_urlPrefixes, bytes, prefixLength);
+    }
+    if (prefixId == VLC_URL_PREFIX_NONE) {
+        prefixLength = 0;
+    }
+    
+    VLCStringRef suffix = VLCStringPoolAdd(_pool, bytes + prefixLength, length - prefixLength, 0);
+    if (suffix == VLC_STRING_REF_INVALID) {
+        return NO;
+    }
+    _urlBytesShared += prefixLength;
+    *packed = VLC_CHANNEL_STORE_URL(prefixId, suffix);
+    return YES;
+}
+
+#pragma mark - Appending
+
+- (VLCChannel *)appendRow:(const VLCChannelStoreRow *)row {
+    pthread_mutex_lock(&_writeLock);
+    
+    uint32_t index = (uint32_t)_count;
+    size_t chunkIndex = index >> VLC_CHANNEL_STORE_CHUNK_BITS;
+    if (chunkIndex >= VLC_CHANNEL_STORE_MAX_CHUNKS) {
+        pthread_mutex_unlock(&_writeLock);
+        return nil;
+    }
+    if (chunkIndex == _chunkCount) {
+        VLCChannelStoreChunk *chunk = malloc(sizeof(VLCChannelStoreChunk));
+        if (!chunk) {
+            pthread_mutex_unlock(&_writeLock);
+            return nil;
+        }
+        _chunks[_chunkCount++] = chunk;
+    }
+    
+    VLCChannelStoreChunk *chunk = _chunks[chunkIndex];
+    uint32_t slot = VLCChannelStoreSlot(index);
+    for (NSUInteger field = 0; field < VLC_CHANNEL_STORE_POOLED_FIELDS; field++) {
+        VLCM3USpan span = row->strings[field];
+        chunk->strings[field][slot] = VLCStringPoolAdd(_pool, span.bytes, span.length, VLCChannelStoreInterns(field));
+    }
+    VLCM3USpan url = row->strings[VLCChannelStoreFieldURL];
+    if (![self packURL:url.bytes length:url.length into:&chunk->url[slot]]) {
+        chunk->url[slot] = VLC_CHANNEL_STORE_URL(VLC_URL_PREFIX_NONE, VLC_STRING_REF_INVALID);
+    }
+    chunk->group[slot] = [self groupIdForGroup:row->group];
+    chunk->category[slot] = [self categoryIdForCategory:row->category];
+    chunk->supportsCatchup[slot] = row->supportsCatchup ? 1 : 0;
+    chunk->catchupDays[slot] = (int32_t)row->catchupDays;
+    chunk->entryFingerprint[slot] = row->entryFingerprint;
+    chunk->entryIdentity[slot] = row->entryIdentity;
+    
+    __atomic_store_n(&_count, (NSUInteger)index + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&_writeLock);
+    
+    return [[[VLCChannel alloc] initWithStore:self row:index] autorelease];
+}
+
+- (void)finishAppending {
+    pthread_mutex_lock(&_writeLock);
+    VLCStringPoolStopInterning(_pool);
+    [_lastGroup release];
+    _lastGroup = nil;
+    _lastGroupId = VLC_CHANNEL_STORE_NO_GROUP;
+    pthread_mutex_unlock(&_writeLock);
+}
+
+#pragma mark - Row Accessors
+
+- (NSString *)URLAtRow:(uint32_t)row {
+    uint64_t url = __atomic_load_n(&VLCChannelStoreChunkForRow(_chunks, row)->url[VLCChannelStoreSlot(row)], __ATOMIC_ACQUIRE);
+    VLCStringRef suffixRef = VLC_CHANNEL_STORE_URL_SUFFIX(url);
+    if (suffixRef == VLC_STRING_REF_INVALID) {
+        return nil;
+    }
+    size_t suffixLength = 0;
+    const char *suffix = VLCStringPoolGet(_pool, suffixRef, &suffixLength);
+    size_t prefixLength = 0;
+    const char *prefix = VLCURLPrefixTableGet(_urlPrefixes, VLC_CHANNEL_STORE_URL_PREFIX(url), &prefixLength);
+    if (prefixLength == 0) {
+        return suffixLength > 0 ? VLCChannelStoreMakeString(suffix, suffixLength) : nil;
+    }
+    
+    // Join prefix and suffix once, then decode; no intermediate strings
+    char stackBuffer[VLC_CHANNEL_STORE_URL_BUFFER];
+    size_t length = prefixLength + suffixLength;
+    char *buffer = length <= sizeof(stackBuffer) ? stackBuffer : malloc(length);
+    if (!buffer) {
+        return nil;
+    }
+    memcpy(buffer, prefix, prefixLength);
+    memcpy(buffer + prefixLength, suffix, suffixLength);
+    NSString *string = VLCChannelStoreMakeString(buffer, length);
+    if (buffer != stackBuffer) {
+        free(buffer);
+    }
+    return string;
+}
+
+- (NSString *)stringForField:(VLCChannelStoreField)field row:(uint32_t)row {
+    if (field == VLCChannelStoreFieldURL) {
+        return [self URLAtRow:row];
+    }
+    VLCStringRef ref = __atomic_load_n(&VLCChannelStoreChunkForRow(_chunks, row)->strings[field][VLCChannelStoreSlot(row)], __ATOMIC_ACQUIRE);
+    if (ref == 0 || ref == VLC_STRING_REF_INVALID) {
+        return nil;
+    }
+    size_t length = 0;
+    const char *bytes = VLCStringPoolGet(_pool, ref, &length);
+    return VLCChannelStoreMakeString(bytes, length);
+}
+
+- (BOOL)setString:(NSString *)string forField:(VLCChannelStoreField)field row:(uint32_t)row {
+    const char *bytes = string ? [string UTF8String] : NULL;
+    size_t length = bytes ? strlen(bytes) : 0;
+    
+    pthread_mutex_lock(&_writeLock);
+    if (field == VLCChannelStoreFieldURL) {
+        uint64_t url = 0;
+        BOOL packed = [self packURL:bytes length:length into:&url];
+        if (packed) {
+            __atomic_store_n(&VLCChannelStoreChunkForRow(_chunks, row)->url[VLCChannelStoreSlot(row)], url, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(&_writeLock);
+        return packed;
+    }
+    // The old bytes stay in the pool; edits after parsing are rare
+    VLCStringRef ref = VLCStringPoolAdd(_pool, bytes, length, VLCChannelStoreInterns(field));
+    if (ref != VLC_STRING_REF_INVALID) {
+        __atomic_store_n(&VLCChannelStoreChunkForRow(_chunks, row)->strings[field][VLCChannelStoreSlot(row)], ref, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&_writeLock);
+    return ref != VLC_STRING_REF_INVALID;
+}
+
+- (NSString *)groupAtRow:(uint32_t)row {
+    uint32_t groupId = __atomic_load_n(&VLCChannelStoreChunkForRow(_chunks, row)->group[VLCChannelStoreSlot(row)], __ATOMIC_ACQUIRE);
+    if (groupId == VLC_CHANNEL_STORE_NO_GROUP) {
+        return nil;
+    }
+    return _groupBlocks[groupId >> VLC_CHANNEL_STORE_GROUP_BITS][groupId & (VLC_CHANNEL_STORE_GROUP_BLOCK - 1)];
+}
+
+- (void)setGroup:(NSString *)group atRow:(uint32_t)row {
+    pthread_mutex_lock(&_writeLock);
+    uint32_t groupId = [self groupIdForGroup:group];
+    __atomic_store_n(&VLCChannelStoreChunkForRow(_chunks, row)->group[VLCChannelStoreSlot(row)], groupId, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&_writeLock);
+}
+
+- (NSString *)categoryAtRow:(uint32_t)row {
+    uint8_t categoryId = __atomic_load_n(&VLCChannelStoreChunkForRow(_chunks, row)->category[VLCChannelStoreSlot(row)], __ATOMIC_ACQUIRE);
+    return categoryId == VLC_CHANNEL_STORE_NO_CATEGORY ? nil : _categories[categoryId];
+}
+
+- (void)setCategory:(NSString *)category atRow:(uint32_t)row {
+    pthread_mutex_lock(&_writeLock);
+    uint8_t categoryId = [self categoryIdForCategory:category];
+    __atomic_store_n(&VLCChannelStoreChunkForRow(_chunks, row)->category[VLCChannelStoreSlot(row)], categoryId, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&_writeLock);
+}
+
+- (BOOL)supportsCatchupAtRow:(uint32_t)row {
+    return VLCChannelStoreChunkForRow(_chunks, row)->supportsCatchup[VLCChannelStoreSlot(row)] != 0;
+}
+
+- (void)setSupportsCatchup:(BOOL)supportsCatchup atRow:(uint32_t)row {
+    VLCChannelStoreChunkForRow(_chunks, row)->supportsCatchup[VLCChannelStoreSlot(row)] = supportsCatchup ? 1 : 0;
+}
+
+- (NSInteger)catchupDaysAtRow:(uint32_t)row {
+    return VLCChannelStoreChunkForRow(_chunks, row)->catchupDays[VLCChannelStoreSlot(row)];
+}
+
+- (void)setCatchupDays:(NSInteger)catchupDays atRow:(uint32_t)row {
+    VLCChannelStoreChunkForRow(_chunks, row)->catchupDays[VLCChannelStoreSlot(row)] = (int32_t)catchupDays;
+}
+
+- (uint64_t)entryFingerprintAtRow:(uint32_t)row {
+    return VLCChannelStoreChunkForRow(_chunks, row)->entryFingerprint[VLCChannelStoreSlot(row)];
+}
+
+- (void)setEntryFingerprint:(uint64_t)entryFingerprint atRow:(uint32_t)row {
+    VLCChannelStoreChunkForRow(_chunks, row)->entryFingerprint[VLCChannelStoreSlot(row)] = entryFingerprint;
+}
+
+- (uint64_t)entryIdentityAtRow:(uint32_t)row {
+    return VLCChannelStoreChunkForRow(_chunks, row)->entryIdentity[VLCChannelStoreSlot(row)];
+}
+
+- (void)setEntryIdentity:(uint64_t)entryIdentity atRow:(uint32_t)row {
+    VLCChannelStoreChunkForRow(_chunks, row)->entryIdentity[VLCChannelStoreSlot(row)] = entryIdentity;
+}
+
+@end
+
+#pragma mark - URL Prefix Encoder
+
+@implementation VLCURLPrefixEncoder {
+    NSMutableArray<NSString *> *_prefixes;
+    NSMutableDictionary<NSString *, NSNumber *> *_prefixIndexes;
+}
+
+- (instancetype)init {
+    return [self initWithPrefixes:nil];
+}
+
+- (instancetype)initWithPrefixes:(NSArray<NSString *> *)prefixes {
+    self = [super init];
+    if (self) {
+        _prefixes = [[NSMutableArray alloc] init];
+        _prefixIndexes = [[NSMutableDictionary alloc] init];
+        for (id prefix in prefixes) {
+            // Keep indexes stable even if a stored entry is damaged
+            NSString *validPrefix = [prefix isKindOfClass:[NSString class]] ? prefix : @"";
+            [_prefixIndexes setObject:@(_prefixes.count) forKey:validPrefix];
+            [_prefixes addObject:validPrefix];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_prefixes release];
+    [_prefixIndexes release];
+    [super dealloc];
+}
+
+- (NSArray<NSString *> *)prefixes {
+    return [[_prefixes copy] autorelease];
+}
+
+- (void)setURL:(NSString *)url inDictionary:(NSMutableDictionary *)dictionary {
+    if (!url) {
+        return;
+    }
+    
+    // Same split as the channel store, so prefixes line up across store, cache and favorites
+    const char *bytes = [url UTF8String];
+    size_t length = bytes ? strlen(bytes) : 0;
+    size_t prefixLength = VLCURLPrefixLength(bytes, length);
+    if (prefixLength == 0) {
+        [dictionary setObject:url forKey:@"url"];
+        return;
+    }
+    
+    // The split is at an ASCII '/', so both halves are valid UTF-8
+    NSString *prefix = [[NSString alloc] initWithBytes:bytes length:prefixLength encoding:NSUTF8StringEncoding];
+    NSString *suffix = [[NSString alloc] initWithBytes:bytes + prefixLength length:length - prefixLength encoding:NSUTF8StringEncoding];
+    NSNumber *index = [_prefixIndexes objectForKey:prefix];
+    if (!index) {
+        index = @(_prefixes.count);
+        [_prefixIndexes setObject:index forKey:prefix];
+        [_prefixes addObject:prefix];
+    }
+    [dictionary setObject:index forKey:@"urlPrefix"];
+    [dictionary setObject:suffix forKey:@"url"];
+    [prefix release];
+    [suffix release];
+}
+
+- (NSString *)URLFromDictionary:(NSDictionary *)dictionary {
+    NSString *url = [dictionary objectForKey:@"url"];
+    NSNumber *index = [dictionary objectForKey:@"urlPrefix"];
+    if (!index || ![index isKindOfClass:[NSNumber class]]) {
+        return url;
+    }
+    NSUInteger prefixIndex = [index unsignedIntegerValue];
+    if (prefixIndex >= _prefixes.count) {
+        return url;
+    }
+    return [[_prefixes objectAtIndex:prefixIndex] stringByAppendingString:url ?: @""];
+}
+
+@end
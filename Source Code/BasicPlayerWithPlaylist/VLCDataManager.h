@@ -14,6 +14,8 @@
 @class VLCCacheManager;
 @class VLCChannel;
 @class VLCProgram;
+@class VLCPlaylistSource;
+@class VLCEPGSource;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -63,10 +65,30 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong) NSString *epgURL;
 @property (nonatomic, assign) NSTimeInterval epgTimeOffsetHours;
 
+// Extra playlists loaded next to m3uURL; the merged list drops streams an earlier source has.
+// Each source keeps its own cache and refresh interval. Persisted in user defaults.
+@property (nonatomic, readonly) NSArray<VLCPlaylistSource *> *playlistSources; // m3uURL first
+- (void)addPlaylistSourceWithURL:(NSString *)url name:(nullable NSString *)name;
+- (void)removePlaylistSourceWithURL:(NSString *)url;
+
+// Extra XMLTV guides merged with epgURL's; a channel keeps the guide of the first source that
+// has it, later ones only fill its gaps. Persisted in user defaults.
+@property (nonatomic, readonly) NSArray<VLCEPGSource *> *epgSources; // epgURL first
+- (void)addEPGSourceWithURL:(NSString *)url name:(nullable NSString *)name;
+- (void)removeEPGSourceWithURL:(NSString *)url;
+
+// Group currently on screen; background work (EPG matching, movie info) handles its channels first
+@property (nonatomic, copy, nullable) NSString *visibleGroup;
+// Channel last started; its guide is loaded before any other
+@property (nonatomic, strong, nullable) VLCChannel *playingChannel;
+
 // High-level operations
 - (void)loadChannelsFromURL:(NSString *)m3uURL;
 - (void)loadEPGFromURL:(NSString *)epgURL;
 - (void)forceReloadChannels;
+- (void)refreshChannels; // Delta refresh: only new/changed playlist entries are rebuilt and EPG-matched
+- (void)refreshDuePlaylistSources; // Re-downloads the sources whose refresh interval has passed
+- (void)refreshDueEPGSources; // Refreshes in place the guides whose refresh interval has passed
 - (void)forceReloadEPG;
 - (void)detectTimeshiftSupport;
 
@@ -76,6 +98,7 @@ NS_ASSUME_NONNULL_BEGIN
 // Data access helpers
 - (VLCChannel * _Nullable)channelAtIndex:(NSInteger)index;
 - (NSArray<VLCChannel *> * _Nullable)channelsInGroup:(NSString *)groupName;
+- (NSArray<VLCChannel *> * _Nullable)visibleGroupChannels;
 - (NSArray<NSString *> * _Nullable)groupsInCategory:(NSString *)categoryName;
 - (VLCProgram * _Nullable)currentProgramForChannel:(VLCChannel *)channel;
 - (NSArray<VLCProgram *> * _Nullable)programsForChannel:(VLCChannel *)channel;
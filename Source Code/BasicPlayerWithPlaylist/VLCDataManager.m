@@ -13,6 +13,17 @@
 #import "VLCCacheManager.h"
 #import "VLCChannel.h"
 #import "VLCProgram.h"
+#import "VLCPlaylistSource.h"
+#import "VLCEPGSource.h"
+
+// How often to look for playlist sources that are due for a refresh
+static const NSTimeInterval kPlaylistSourceCheckInterval = 10 * 60;
+
+static NSString * const kAdditionalPlaylistSourcesKey = @"AdditionalPlaylistSources";
+static NSString * const kAdditionalEPGSourcesKey = @"AdditionalEPGSources";
+
+// Channels asked for a short guide while the first full guide loads: the group on screen, then favorites
+static const NSUInteger kPriorityChannelLimit = 200;
 
 @interface VLCDataManager () <NSObject>
 
@@ -37,6 +48,16 @@
 @property (nonatomic, assign) float internalChannelLoadingProgress;
 @property (nonatomic, assign) float internalEpgLoadingProgress;
 
+// Playlist sources
+@property (nonatomic, strong) VLCPlaylistSource *primarySource;
+@property (nonatomic, strong) NSMutableArray<VLCPlaylistSource *> *additionalSources;
+@property (nonatomic, strong) NSTimer *sourceRefreshTimer;
+
+// EPG sources
+@property (nonatomic, strong) VLCEPGSource *primaryEPGSource;
+@property (nonatomic, strong) NSMutableArray<VLCEPGSource *> *additionalEPGSources;
+@property (nonatomic, strong) NSTimer *epgSourceRefreshTimer;
+
 // Current operations (for cancellation)
 @property (nonatomic, strong) NSOperation *currentChannelOperation;
 @property (nonatomic, strong) NSOperation *currentEPGOperation;
@@ -83,6 +104,22 @@
     self.internalGroupsByCategory = @{};
     self.internalCategories = @[@"SEARCH", @"FAVORITES", @"TV", @"MOVIES", @"SERIES", @"SETTINGS"];
     self.internalEpgData = @{};
+    
+    self.additionalSources = [NSMutableArray array];
+    for (NSDictionary *dictionary in [[NSUserDefaults standardUserDefaults] arrayForKey:kAdditionalPlaylistSourcesKey]) {
+        VLCPlaylistSource *source = [dictionary isKindOfClass:[NSDictionary class]] ? [VLCPlaylistSource sourceWithDictionary:dictionary] : nil;
+        if (source) {
+            [self.additionalSources addObject:source];
+        }
+    }
+    
+    self.additionalEPGSources = [NSMutableArray array];
+    for (NSDictionary *dictionary in [[NSUserDefaults standardUserDefaults] arrayForKey:kAdditionalEPGSourcesKey]) {
+        VLCEPGSource *source = [dictionary isKindOfClass:[NSDictionary class]] ? [VLCEPGSource sourceWithDictionary:dictionary] : nil;
+        if (source) {
+            [self.additionalEPGSources addObject:source];
+        }
+    }
 }
 
 #pragma mark - Lazy Loading Sub-managers
@@ -155,6 +192,11 @@
     
     NSLog(@"📊 [DATA] Starting channel loading from URL: %@", m3uURL);
     self.m3uURL = m3uURL;
+    
+    if (self.additionalSources.count > 0) {
+        [self loadPlaylistSources:nil bypassCache:NO operation:@"Loading Channels"];
+        return;
+    }
     self.internalIsLoadingChannels = YES;
     self.internalChannelLoadingProgress = 0.0;
     
@@ -239,45 +281,20 @@
     
     // Update EPG manager time offset
     self.epgManager.timeOffsetHours = self.epgTimeOffsetHours;
+    // What is on screen gets its guide first: parsed ahead of the rest, and on Xtream playlists
+    // a short guide until then
+    NSArray<VLCChannel *> *priorityChannels = [self priorityChannels];
+    [self.epgManager setPriorityChannels:priorityChannels];
+    [self.epgManager setShortEPGAccount:self.m3uURL.length > 0 ? [self.channelManager xtreamAccountFromPlaylistURL:self.m3uURL] : nil
+                               channels:priorityChannels];
+    
+    [self scheduleEPGSourceRefresh];
     
     __weak __typeof__(self) weakSelf = self;
-    [self.epgManager loadEPGFromURL:epgURL
-                         completion:^(NSDictionary *epgData, NSError *error) {
-        __strong __typeof__(weakSelf) strongSelf = weakSelf;
-        if (!strongSelf) return;
-        
-        dispatch_async(dispatch_get_main_queue(), ^{
-            strongSelf.internalIsLoadingEPG = NO;
-            strongSelf.internalEpgLoadingProgress = 1.0;
-            
-            if (error) {
-                NSLog(@"❌ [DATA] EPG loading failed: %@", error.localizedDescription);
-                strongSelf.internalIsEPGLoaded = NO;
-                [strongSelf.delegate dataManagerDidEncounterError:error operation:@"Loading EPG"];
-                [strongSelf.delegate dataManagerDidFinishLoading:@"Loading EPG" success:NO];
-            } else {
-                NSLog(@"✅ [DATA] EPG loading completed: %lu programs", (unsigned long)[(NSDictionary *)epgData count]);
-                strongSelf.internalEpgData = epgData;
-                strongSelf.internalIsEPGLoaded = YES;
-                
-                // CRITICAL FIX: Check if channels are available before matching
-                if (strongSelf.channels && strongSelf.channels.count > 0) {
-                    NSLog(@"🔗 [DATA] Matching EPG with %lu available channels", (unsigned long)strongSelf.channels.count);
-                    [strongSelf.epgManager matchEPGWithChannels:strongSelf.channels];
-                } else {
-                    NSLog(@"⚠️ [DATA] No channels available for EPG matching yet - EPG will be matched when channels are loaded");
-                }
-                
-                [strongSelf.delegate dataManagerDidUpdateEPG:epgData];
-                [strongSelf.delegate dataManagerDidFinishLoading:@"Loading EPG" success:YES];
-                
-                // CORRECT SEQUENCE: Step 3 - Now that EPG is loaded, start timeshift detection
-                NSLog(@"📅 [UNIVERSAL] Step 3: EPG complete, now starting timeshift detection...");
-                dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-                    [strongSelf detectTimeshiftSupport];
-                });
-            }
-        });
+    [self.epgManager loadEPGFromSources:[self epgSources]
+                            bypassCache:NO
+                             completion:^(NSDictionary *epgData, NSError *error) {
+        [weakSelf finishEPGLoad:epgData error:error operation:@"Loading EPG"];
     } progress:^(float progress, NSString *status) {
         __strong __typeof__(weakSelf) strongSelf = weakSelf;
         if (!strongSelf) return;
@@ -289,6 +306,69 @@
     }];
 }
 
+// Completion of every EPG load: publishes the guide and matches it with the channels
+- (void)finishEPGLoad:(NSDictionary *)epgData error:(NSError *)error operation:(NSString *)operation {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self.internalIsLoadingEPG = NO;
+        self.internalEpgLoadingProgress = 1.0;
+        
+        if (error) {
+            NSLog(@"❌ [DATA] EPG loading failed: %@", error.localizedDescription);
+            self.internalIsEPGLoaded = NO;
+            [self.delegate dataManagerDidEncounterError:error operation:operation];
+            [self.delegate dataManagerDidFinishLoading:operation success:NO];
+        } else {
+            NSLog(@"✅ [DATA] EPG loading completed: %lu programs", (unsigned long)[(NSDictionary *)epgData count]);
+            self.internalEpgData = epgData;
+            self.internalIsEPGLoaded = YES;
+            
+            // CRITICAL FIX: Check if channels are available before matching
+            if (self.channels && self.channels.count > 0) {
+                NSLog(@"🔗 [DATA] Matching EPG with %lu available channels", (unsigned long)self.channels.count);
+                [self.epgManager matchEPGWithChannels:self.channels priorityChannels:[self visibleGroupChannels]];
+            } else {
+                NSLog(@"⚠️ [DATA] No channels available for EPG matching yet - EPG will be matched when channels are loaded");
+            }
+            
+            [self.delegate dataManagerDidUpdateEPG:epgData];
+            [self.delegate dataManagerDidFinishLoading:operation success:YES];
+            
+            // CORRECT SEQUENCE: Step 3 - Now that EPG is loaded, start timeshift detection
+            NSLog(@"📅 [UNIVERSAL] Step 3: EPG complete, now starting timeshift detection...");
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                [self detectTimeshiftSupport];
+            });
+        }
+    });
+}
+
+// Completion of an in-place refresh. The guide in use stays when the refresh fails, and the UI
+// hears nothing when no programme changed.
+- (void)finishEPGRefresh:(NSDictionary *)epgData error:(NSError *)error {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self.internalIsLoadingEPG = NO;
+        self.internalEpgLoadingProgress = 1.0;
+        
+        if (error) {
+            NSLog(@"❌ [DATA] EPG refresh failed, keeping the guide in use: %@", error.localizedDescription);
+            [self.delegate dataManagerDidFinishLoading:@"Refreshing EPG" success:NO];
+            return;
+        }
+        if (epgData != self.internalEpgData) {
+            NSLog(@"✅ [DATA] EPG refreshed: %lu guide channels", (unsigned long)epgData.count);
+            self.internalEpgData = epgData;
+            // Nothing matched yet to move over
+            if (!self.epgManager.nowNextTable && self.channels.count > 0) {
+                [self.epgManager matchEPGWithChannels:self.channels priorityChannels:[self visibleGroupChannels]];
+            }
+            [self.delegate dataManagerDidUpdateEPG:epgData];
+        } else {
+            NSLog(@"✅ [DATA] EPG refresh found no changed programmes");
+        }
+        [self.delegate dataManagerDidFinishLoading:@"Refreshing EPG" success:YES];
+    });
+}
+
 - (void)forceReloadChannels {
     if (self.m3uURL) {
         NSLog(@"🔄 [DATA] Force reloading channels (bypassing cache)");
@@ -306,6 +386,11 @@
     
     NSLog(@"🚀 [DATA] Force reloading channels from URL (BYPASSING CACHE): %@", m3uURL);
     self.m3uURL = m3uURL;
+    
+    if (self.additionalSources.count > 0) {
+        [self loadPlaylistSources:nil bypassCache:YES operation:@"Loading Channels"];
+        return;
+    }
     self.internalIsLoadingChannels = YES;
     self.internalChannelLoadingProgress = 0.0;
     
@@ -361,7 +446,8 @@
         // CRITICAL: Declare weak reference OUTSIDE the blocks
         __weak __typeof__(self) weakSelf = self;
         
-        [self.epgManager forceReloadEPGFromURL:self.epgURL completion:^(NSDictionary *epgData, NSError *error) {
+        [self.epgManager clearEPGData];
+        [self.epgManager loadEPGFromSources:[self epgSources] bypassCache:YES completion:^(NSDictionary *epgData, NSError *error) {
             __strong __typeof__(weakSelf) strongSelf = weakSelf;
             if (!strongSelf) return;
             
@@ -382,7 +468,7 @@
                     // CRITICAL FIX: Check if channels are available before matching
                     if (strongSelf.channels && strongSelf.channels.count > 0) {
                         NSLog(@"🔗 [DATA] Force reload - Matching EPG with %lu available channels", (unsigned long)strongSelf.channels.count);
-                        [strongSelf.epgManager matchEPGWithChannels:strongSelf.channels];
+                        [strongSelf.epgManager matchEPGWithChannels:strongSelf.channels priorityChannels:[strongSelf visibleGroupChannels]];
                     } else {
                         NSLog(@"⚠️ [DATA] Force reload - No channels available for EPG matching yet");
                     }
@@ -431,9 +517,12 @@
     
     NSLog(@"🔄 [DATA] Starting timeshift detection for %lu channels with M3U URL: %@", (unsigned long)self.channels.count, self.m3uURL ?: @"None");
     
+    // Catalog channels already carry tv_archive; without a URL no second get_live_streams is made
+    NSString *apiURL = self.channelManager.loadedFromXtreamCatalog ? nil : self.m3uURL;
+    
     __weak __typeof__(self) weakSelf = self;
     [self.timeshiftManager detectTimeshiftSupport:self.channels
-                                        m3uURL:self.m3uURL
+                                        m3uURL:apiURL
                                        completion:^(NSInteger detectedChannels, NSError *error) {
         __strong __typeof__(weakSelf) strongSelf = weakSelf;
         if (!strongSelf) return;
@@ -462,6 +551,26 @@
     return self.channelsByGroup[groupName];
 }
 
+- (NSArray<VLCChannel *> *)visibleGroupChannels {
+    return self.visibleGroup ? [self channelsInGroup:self.visibleGroup] : nil;
+}
+
+// Playing channel, visible group, favorites
+- (NSArray<VLCChannel *> *)priorityChannels {
+    NSMutableArray<VLCChannel *> *channels = [NSMutableArray array];
+    if (self.playingChannel) {
+        [channels addObject:self.playingChannel];
+    }
+    [channels addObjectsFromArray:[self visibleGroupChannels] ?: @[]];
+    for (NSString *group in [self groupsInCategory:@"FAVORITES"]) {
+        [channels addObjectsFromArray:[self channelsInGroup:group] ?: @[]];
+    }
+    if (channels.count > kPriorityChannelLimit) {
+        [channels removeObjectsInRange:NSMakeRange(kPriorityChannelLimit, channels.count - kPriorityChannelLimit)];
+    }
+    return channels;
+}
+
 - (NSArray<NSString *> *)groupsInCategory:(NSString *)categoryName {
     return self.groupsByCategory[categoryName];
 }
@@ -480,6 +589,345 @@
     [self updateChannelData:channels];
 }
 
+- (void)refreshChannels {
+    if (!self.m3uURL) {
+        NSLog(@"⚠️ [DATA] Cannot refresh channels - no URL set");
+        return;
+    }
+    if (self.internalIsLoadingChannels) {
+        NSLog(@"⚠️ [DATA] Channel refresh blocked - loading already in progress");
+        return;
+    }
+    
+    if (self.additionalSources.count > 0) {
+        [self loadPlaylistSources:[self playlistSources] bypassCache:YES operation:@"Refreshing Channels"];
+        return;
+    }
+    
+    NSLog(@"🔄 [DATA] Delta refreshing channels from URL: %@", self.m3uURL);
+    self.internalIsLoadingChannels = YES;
+    self.internalChannelLoadingProgress = 0.0;
+    
+    [self.delegate dataManagerDidStartLoading:@"Refreshing Channels"];
+    
+    __weak __typeof__(self) weakSelf = self;
+    [self.channelManager refreshChannelsFromURL:self.m3uURL
+                                     completion:^(VLCChannelChangeSet *changes, NSError *error) {
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) return;
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            strongSelf.internalIsLoadingChannels = NO;
+            strongSelf.internalChannelLoadingProgress = 1.0;
+            
+            if (error) {
+                NSLog(@"❌ [DATA] Channel refresh failed: %@", error.localizedDescription);
+                [strongSelf.delegate dataManagerDidEncounterError:error operation:@"Refreshing Channels"];
+                [strongSelf.delegate dataManagerDidFinishLoading:@"Refreshing Channels" success:NO];
+                return;
+            }
+            
+            if (changes.fullReload) {
+                [strongSelf updateChannelData:strongSelf.channelManager.channels];
+            } else if (!changes.isEmpty) {
+                [strongSelf applyChannelChanges:changes];
+            } else {
+                NSLog(@"✅ [DATA] Channel refresh completed - playlist unchanged");
+            }
+            [strongSelf.delegate dataManagerDidFinishLoading:@"Refreshing Channels" success:YES];
+        });
+    } progress:^(float progress, NSString *status) {
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) return;
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            strongSelf.internalChannelLoadingProgress = progress;
+            [strongSelf.delegate dataManagerDidUpdateProgress:progress operation:status];
+        });
+    }];
+}
+
+#pragma mark - Playlist Sources
+
+- (NSArray<VLCPlaylistSource *> *)playlistSources {
+    NSMutableArray<VLCPlaylistSource *> *sources = [NSMutableArray array];
+    if (self.m3uURL.length > 0) {
+        // Same object while the URL is unchanged, so its load date survives
+        if (![self.primarySource.url isEqualToString:self.m3uURL]) {
+            VLCPlaylistSource *primary = [[VLCPlaylistSource alloc] initWithURL:self.m3uURL name:nil];
+            primary.primary = YES;
+            self.primarySource = primary;
+            [primary release];
+        }
+        [sources addObject:self.primarySource];
+    }
+    for (VLCPlaylistSource *source in self.additionalSources) {
+        if (![source.url isEqualToString:self.m3uURL]) {
+            [sources addObject:source];
+        }
+    }
+    return sources;
+}
+
+- (void)addPlaylistSourceWithURL:(NSString *)url name:(NSString *)name {
+    if (url.length == 0 || [url isEqualToString:self.m3uURL]) {
+        return;
+    }
+    for (VLCPlaylistSource *source in self.additionalSources) {
+        if ([source.url isEqualToString:url]) {
+            if (name.length > 0) {
+                source.name = name;
+                [self saveAdditionalSources];
+            }
+            return;
+        }
+    }
+    
+    VLCPlaylistSource *source = [[VLCPlaylistSource alloc] initWithURL:url name:name];
+    [self.additionalSources addObject:source];
+    [source release];
+    [self saveAdditionalSources];
+    NSLog(@"📊 [DATA] Added playlist source %@ (%lu additional)", url, (unsigned long)self.additionalSources.count);
+}
+
+- (void)removePlaylistSourceWithURL:(NSString *)url {
+    for (VLCPlaylistSource *source in [[self.additionalSources copy] autorelease]) {
+        if ([source.url isEqualToString:url]) {
+            [self.additionalSources removeObject:source];
+        }
+    }
+    [self saveAdditionalSources];
+    NSLog(@"📊 [DATA] Removed playlist source %@ (%lu additional)", url, (unsigned long)self.additionalSources.count);
+}
+
+- (void)saveAdditionalSources {
+    NSMutableArray<NSDictionary *> *dictionaries = [NSMutableArray arrayWithCapacity:self.additionalSources.count];
+    for (VLCPlaylistSource *source in self.additionalSources) {
+        [dictionaries addObject:[source dictionaryRepresentation]];
+    }
+    [[NSUserDefaults standardUserDefaults] setObject:dictionaries forKey:kAdditionalPlaylistSourcesKey];
+}
+
+- (void)refreshDuePlaylistSources {
+    if (self.additionalSources.count == 0 || self.internalIsLoadingChannels) {
+        return;
+    }
+    
+    NSMutableArray<VLCPlaylistSource *> *dueSources = [NSMutableArray array];
+    for (VLCPlaylistSource *source in [self playlistSources]) {
+        if ([source isDueForRefreshWithDefaultInterval:self.cacheManager.channelCacheValidityHours]) {
+            [dueSources addObject:source];
+        }
+    }
+    if (dueSources.count == 0) {
+        return;
+    }
+    
+    NSLog(@"🔄 [DATA] %lu playlist sources due for refresh", (unsigned long)dueSources.count);
+    [self loadPlaylistSources:dueSources bypassCache:YES operation:@"Refreshing Channels"];
+}
+
+#pragma mark - EPG Sources
+
+- (NSArray<VLCEPGSource *> *)epgSources {
+    NSMutableArray<VLCEPGSource *> *sources = [NSMutableArray array];
+    if (self.epgURL.length > 0) {
+        // Same object while the URL is unchanged, so its load date survives
+        if (![self.primaryEPGSource.url isEqualToString:self.epgURL]) {
+            VLCEPGSource *primary = [[VLCEPGSource alloc] initWithURL:self.epgURL name:nil];
+            self.primaryEPGSource = primary;
+            [primary release];
+        }
+        [sources addObject:self.primaryEPGSource];
+    }
+    for (VLCEPGSource *source in self.additionalEPGSources) {
+        if (![source.url isEqualToString:self.epgURL]) {
+            [sources addObject:source];
+        }
+    }
+    return sources;
+}
+
+- (void)addEPGSourceWithURL:(NSString *)url name:(NSString *)name {
+    if (url.length == 0 || [url isEqualToString:self.epgURL]) {
+        return;
+    }
+    for (VLCEPGSource *source in self.additionalEPGSources) {
+        if ([source.url isEqualToString:url]) {
+            if (name.length > 0) {
+                source.name = name;
+                [self saveAdditionalEPGSources];
+            }
+            return;
+        }
+    }
+    
+    VLCEPGSource *source = [[VLCEPGSource alloc] initWithURL:url name:name];
+    [self.additionalEPGSources addObject:source];
+    [source release];
+    [self saveAdditionalEPGSources];
+    NSLog(@"📊 [DATA] Added EPG source %@ (%lu additional)", url, (unsigned long)self.additionalEPGSources.count);
+}
+
+- (void)removeEPGSourceWithURL:(NSString *)url {
+    for (VLCEPGSource *source in [[self.additionalEPGSources copy] autorelease]) {
+        if ([source.url isEqualToString:url]) {
+            [self.additionalEPGSources removeObject:source];
+        }
+    }
+    [self saveAdditionalEPGSources];
+    NSLog(@"📊 [DATA] Removed EPG source %@ (%lu additional)", url, (unsigned long)self.additionalEPGSources.count);
+}
+
+- (void)saveAdditionalEPGSources {
+    NSMutableArray<NSDictionary *> *dictionaries = [NSMutableArray arrayWithCapacity:self.additionalEPGSources.count];
+    for (VLCEPGSource *source in self.additionalEPGSources) {
+        [dictionaries addObject:[source dictionaryRepresentation]];
+    }
+    [[NSUserDefaults standardUserDefaults] setObject:dictionaries forKey:kAdditionalEPGSourcesKey];
+}
+
+// Guides past their refresh interval are refreshed in place rather than reloaded
+- (void)scheduleEPGSourceRefresh {
+    if (!self.epgSourceRefreshTimer) {
+        self.epgSourceRefreshTimer = [NSTimer scheduledTimerWithTimeInterval:kPlaylistSourceCheckInterval
+                                                                      target:self
+                                                                    selector:@selector(refreshDueEPGSources)
+                                                                    userInfo:nil
+                                                                     repeats:YES];
+    }
+}
+
+- (void)refreshDueEPGSources {
+    if (self.internalIsLoadingEPG || !self.internalIsEPGLoaded) {
+        return;
+    }
+    
+    NSArray<VLCEPGSource *> *sources = [self epgSources];
+    NSMutableArray<VLCEPGSource *> *dueSources = [NSMutableArray array];
+    for (VLCEPGSource *source in sources) {
+        if ([source isDueForRefreshWithDefaultInterval:self.cacheManager.epgCacheValidityHours]) {
+            [dueSources addObject:source];
+        }
+    }
+    if (dueSources.count == 0) {
+        return;
+    }
+    
+    // Only the due guides are downloaded and parsed again; the others are merged from memory.
+    // Matched channels are moved to the new programmes by the EPG manager, not matched again.
+    NSLog(@"🔄 [DATA] %lu of %lu EPG sources due for refresh", (unsigned long)dueSources.count, (unsigned long)sources.count);
+    self.internalIsLoadingEPG = YES;
+    self.internalEpgLoadingProgress = 0.0;
+    [self.delegate dataManagerDidStartLoading:@"Refreshing EPG"];
+    
+    __weak __typeof__(self) weakSelf = self;
+    [self.epgManager refreshEPGSources:dueSources
+                             ofSources:sources
+                            completion:^(NSDictionary *epgData, NSError *error) {
+        [weakSelf finishEPGRefresh:epgData error:error];
+    } progress:^(float progress, NSString *status) {
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) return;
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            strongSelf.internalEpgLoadingProgress = progress;
+            [strongSelf.delegate dataManagerDidUpdateProgress:progress operation:status];
+        });
+    }];
+}
+
+// sourcesToRefresh nil loads every source; otherwise only those are downloaded again
+- (void)loadPlaylistSources:(NSArray<VLCPlaylistSource *> *)sourcesToRefresh
+                bypassCache:(BOOL)bypassCache
+                  operation:(NSString *)operation {
+    NSArray<VLCPlaylistSource *> *sources = [self playlistSources];
+    NSLog(@"📊 [DATA] Loading %lu playlist sources", (unsigned long)sources.count);
+    
+    self.internalIsLoadingChannels = YES;
+    self.internalChannelLoadingProgress = 0.0;
+    [self.delegate dataManagerDidStartLoading:operation];
+    
+    if (!self.sourceRefreshTimer) {
+        self.sourceRefreshTimer = [NSTimer scheduledTimerWithTimeInterval:kPlaylistSourceCheckInterval
+                                                                   target:self
+                                                                 selector:@selector(refreshDuePlaylistSources)
+                                                                 userInfo:nil
+                                                                  repeats:YES];
+    }
+    
+    __weak __typeof__(self) weakSelf = self;
+    VLCChannelLoadCompletion completion = ^(NSArray<VLCChannel *> *channels, NSError *error) {
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) return;
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            strongSelf.internalIsLoadingChannels = NO;
+            strongSelf.internalChannelLoadingProgress = 1.0;
+            
+            if (error) {
+                NSLog(@"❌ [DATA] Playlist sources failed: %@", error.localizedDescription);
+                [strongSelf.delegate dataManagerDidEncounterError:error operation:operation];
+                [strongSelf.delegate dataManagerDidFinishLoading:operation success:NO];
+            } else {
+                NSLog(@"✅ [DATA] Playlist sources loaded: %lu channels", (unsigned long)channels.count);
+                [strongSelf updateChannelData:channels];
+                [strongSelf.delegate dataManagerDidFinishLoading:operation success:YES];
+            }
+        });
+    };
+    VLCChannelProgressBlock progress = ^(float progress, NSString *status) {
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf) return;
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            strongSelf.internalChannelLoadingProgress = progress;
+            [strongSelf.delegate dataManagerDidUpdateProgress:progress operation:status];
+        });
+    };
+    
+    if (sourcesToRefresh) {
+        [self.channelManager refreshSources:sourcesToRefresh ofSources:sources completion:completion progress:progress];
+    } else {
+        [self.channelManager loadChannelsFromSources:sources bypassCache:bypassCache completion:completion progress:progress];
+    }
+}
+
+// Applies a delta refresh: unchanged channels keep their objects and matched programs,
+// so only inserted and updated channels go through EPG matching again
+- (void)applyChannelChanges:(VLCChannelChangeSet *)changes {
+    self.internalChannels = self.channelManager.channels;
+    self.internalGroups = self.channelManager.groups;
+    self.internalChannelsByGroup = self.channelManager.channelsByGroup;
+    self.internalGroupsByCategory = self.channelManager.groupsByCategory;
+    self.internalCategories = self.channelManager.categories;
+    
+    NSLog(@"📊 [DATA] ✅ Applied channel changes: %lu inserted, %lu removed, %lu updated (%lu channels)", 
+          (unsigned long)changes.insertedChannels.count, (unsigned long)changes.removedChannels.count,
+          (unsigned long)changes.updatedChannels.count, (unsigned long)self.internalChannels.count);
+    
+    // Inserted, removed or updated channels can change how far back catch-up reaches
+    [self.epgManager setCatchupChannels:self.internalChannels];
+    
+    [self.delegate dataManagerDidUpdateChannels:self.internalChannels];
+    
+    NSMutableArray<VLCChannel *> *changedChannels = [NSMutableArray arrayWithArray:changes.insertedChannels];
+    [changedChannels addObjectsFromArray:changes.updatedChannels];
+    
+    if (changedChannels.count > 0 && self.internalEpgData && self.internalEpgData.count > 0) {
+        __weak __typeof__(self) weakSelf = self;
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [weakSelf.epgManager matchEPGWithChannels:changedChannels priorityChannels:[weakSelf visibleGroupChannels]];
+            dispatch_async(dispatch_get_main_queue(), ^{
+                __strong __typeof__(weakSelf) strongSelf = weakSelf;
+                if (!strongSelf) return;
+                [strongSelf.delegate dataManagerDidUpdateEPG:strongSelf.internalEpgData];
+                NSLog(@"🔗 [DATA] EPG matched for %lu changed channels", (unsigned long)changedChannels.count);
+            });
+        });
+    }
+}
+
 - (void)updateChannelData:(NSArray<VLCChannel *> *)channels {
     // Update internal data structures through channel manager
     self.internalChannels = channels;
@@ -523,6 +971,9 @@
         NSLog(@"📊 [DATA] ✅ Updated channel data: %lu channels, %lu groups", 
               (unsigned long)channels.count, (unsigned long)strongSelf.internalGroups.count);
         
+        // EPG retention keeps past programmes as long as each channel's catch-up reaches back
+        [strongSelf.epgManager setCatchupChannels:channels];
+        
         // CRITICAL: Notify delegate that channels are ready AFTER background processing completes
         [strongSelf.delegate dataManagerDidUpdateChannels:channels];
             
@@ -533,7 +984,7 @@
                   (unsigned long)strongSelf.internalEpgData.count, (unsigned long)channels.count);
             
             dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-                [strongSelf.epgManager matchEPGWithChannels:channels];
+                [strongSelf.epgManager matchEPGWithChannels:channels priorityChannels:[strongSelf visibleGroupChannels]];
                 dispatch_async(dispatch_get_main_queue(), ^{
                     strongSelf.internalIsEPGLoaded = YES;
                     [strongSelf.delegate dataManagerDidUpdateEPG:strongSelf.internalEpgData];
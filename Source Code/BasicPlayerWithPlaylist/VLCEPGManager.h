@@ -11,6 +11,8 @@
 @class VLCChannel;
 @class VLCProgram;
 @class VLCCacheManager;
+@class VLCNowNextTable;
+@class VLCEPGSource;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -30,11 +32,24 @@ typedef void (^VLCEPGProgressBlock)(float progress, NSString *status);
 @property (nonatomic, readonly) float progress;
 @property (nonatomic, readonly) NSString *currentStatus;
 
+// What is on now and next on the channels of the last match, advanced at programme boundaries
+// (see VLCNowNextTableDidChangeNotification); nil before the first match. Main thread only.
+@property (nonatomic, readonly, nullable) VLCNowNextTable *nowNextTable;
+
 // Configuration
+// Changing the offset rebuilds nowNextTable
 @property (nonatomic, assign) NSTimeInterval timeOffsetHours;
 @property (nonatomic, assign) NSTimeInterval cacheValidityHours; // Default: 6 hours
+// Parse guides on all cores in pieces merged in document order. Default: YES
+@property (nonatomic, assign) BOOL parallelParsing;
+// Programmes outside the retention window are dropped while parsing, and hourly as it slides
+// forward. It reaches back pastRetentionHours, or as many days as a channel's catch-up when
+// longer (see -setCatchupChannels:), and ahead futureHorizonHours. 0 removes a limit.
+@property (nonatomic, assign) NSTimeInterval pastRetentionHours;  // Default: 24 hours
+@property (nonatomic, assign) NSTimeInterval futureHorizonHours;  // Default: 72 hours
 
 // Main operations
+// epgURL may point at a plain, gzip (.xml.gz) or xz (.xml.xz) XMLTV guide
 - (void)loadEPGFromURL:(NSString *)epgURL
             completion:(VLCEPGLoadCompletion)completion
               progress:(VLCEPGProgressBlock _Nullable)progressBlock;
@@ -46,15 +61,59 @@ typedef void (^VLCEPGProgressBlock)(float progress, NSString *status);
                    completion:(VLCEPGLoadCompletion)completion
                      progress:(VLCEPGProgressBlock _Nullable)progressBlock;
 
+// Multiple guides: sources load concurrently (each from its own cache or download) into a
+// programme store of their own, merged in order. A channel takes its programmes from the first
+// source that has it; later sources only fill the gaps (see VLCProgramStore).
+- (void)loadEPGFromSources:(NSArray<VLCEPGSource *> *)sources
+               bypassCache:(BOOL)bypassCache
+                completion:(VLCEPGLoadCompletion)completion
+                  progress:(VLCEPGProgressBlock _Nullable)progressBlock;
+
+/**
+ * Re-downloads sourcesToRefresh only; the other sources keep their parsed guides. Each newer
+ * guide updates the one in memory rather than replacing it: programmes that aired stay, the
+ * rest come from the newer guide. Readers keep the current generation until the update is
+ * published, and nothing is published when no programme changed (completion then gets the
+ * epgData of the load before). Matched channels are moved to the new programmes without
+ * matching them again; VLCNowNextTableDidChangeNotification lists those whose programmes changed.
+ */
+- (void)refreshEPGSources:(NSArray<VLCEPGSource *> *)sourcesToRefresh
+                ofSources:(NSArray<VLCEPGSource *> *)allSources
+               completion:(VLCEPGLoadCompletion)completion
+                 progress:(VLCEPGProgressBlock _Nullable)progressBlock;
+
+// Xtream fast path for cold starts: while a guide downloads with nothing loaded yet, the short
+// guide of these channels (see VLCShortEPGFetcher) is fetched in small batches and attached to
+// them. Matching the full guide replaces it; channels the guide lacks keep theirs. account as
+// -[VLCChannelManager xtreamAccountFromPlaylistURL:] returns it, nil to turn this off.
+- (void)setShortEPGAccount:(nullable NSDictionary<NSString *, NSString *> *)account
+                  channels:(nullable NSArray<VLCChannel *> *)channels;
+
+// Channels the user is looking at (playing, visible group, favorites). On a cold load their
+// guide channels are published and matched as soon as their programmes are parsed, ahead of
+// the rest of the guide.
+- (void)setPriorityChannels:(nullable NSArray<VLCChannel *> *)channels;
+
 // EPG processing
+// xmlData may also be gzip or xz compressed
 - (void)parseEPGXMLData:(NSData *)xmlData
              completion:(VLCEPGLoadCompletion)completion
                progress:(VLCEPGProgressBlock _Nullable)progressBlock;
 
 - (void)matchEPGWithChannels:(NSArray<VLCChannel *> *)channels;
+// Runs as a scheduler task; priorityChannels (e.g. the group on screen) are matched first
+- (void)matchEPGWithChannels:(NSArray<VLCChannel *> *)channels priorityChannels:(nullable NSArray<VLCChannel *> *)priorityChannels;
 
 // Program access
 - (VLCProgram * _Nullable)currentProgramForChannel:(VLCChannel *)channel;
+// What -[VLCChannel currentProgramWithTimeOffset:] returns; from nowNextTable (O(1)) when it
+// was built for this offset. Main thread only.
+- (VLCProgram * _Nullable)currentProgramForChannel:(VLCChannel *)channel timeOffsetHours:(NSInteger)offsetHours;
+// The same for channels in range, into programs[0..range.length) (see +[VLCChannel getCurrentPrograms:...])
+- (NSUInteger)getCurrentPrograms:(VLCProgram * _Nullable * _Nonnull)programs
+                     forChannels:(NSArray *)channels
+                           range:(NSRange)range
+                 timeOffsetHours:(NSInteger)offsetHours;
 - (NSArray<VLCProgram *> * _Nullable)programsForChannel:(VLCChannel *)channel;
 - (NSArray<VLCProgram *> * _Nullable)programsForChannelID:(NSString *)channelID;
 
@@ -71,10 +130,13 @@ typedef void (^VLCEPGProgressBlock)(float progress, NSString *status);
 
 // Data management
 - (void)clearEPGData;
+// Catch-up days of the playlist, found by tvg-id, tvg-name or name; used by the retention window
+- (void)setCatchupChannels:(NSArray<VLCChannel *> *)channels;
 - (void)updateEPGData:(NSDictionary *)epgData;
 
 // Memory management
 - (NSUInteger)estimatedMemoryUsage;
+// Drops the programmes outside the retention window
 - (void)performMemoryOptimization;
 
 // Cache management
@@ -10,34 +10,915 @@
 #import "VLCCacheManager.h"
 #import "VLCChannel.h"
 #import "VLCProgram.h"
+#import "VLCProgramStore.h"
+#import "VLCNowNextTable.h"
 #import "DownloadManager.h"
+#import "VLCTaskScheduler.h"
+#import "VLCXMLTVParser.h"
+#import "VLCXMLTVShard.h"
+#import "VLCStreamDecompressor.h"
+#import "VLCChannelMatcher.h"
+#import "VLCSnapshot.h"
+#import "VLCShortEPGFetcher.h"
+#import "VLCEPGSource.h"
 #import <mach/mach.h>
 
-@interface VLCEPGManager () <NSXMLParserDelegate>
+@class VLCEPGChannelIndex;
+@class VLCEPGRetentionWindow;
+@class VLCEPGSnapshot;
+
+@interface VLCEPGManager () {
+    dispatch_source_t _retentionTimer;
+    VLCEPGSnapshot *_snapshot;          // Published with VLCSnapshotPublish, read with VLCSnapshotLoad
+    uint64_t _generation;
+    VLCSnapshotStats _statsAtLastPublish;
+    // Sealed guide of each source (by URL) and the order they merge in; changed under @synchronized(self)
+    NSMutableDictionary<NSString *, VLCProgramStore *> *_sourceStores;
+    NSMutableDictionary<NSString *, NSDictionary *> *_sourceDisplayNames;
+    NSArray<NSString *> *_sourceOrder;
+}
 
 // Internal state
-@property (nonatomic, strong) NSMutableDictionary *internalEpgData;
 @property (nonatomic, assign) BOOL internalIsLoaded;
 @property (nonatomic, assign) BOOL internalIsLoading;
 @property (nonatomic, assign) float internalProgress;
 @property (nonatomic, strong) NSString *internalCurrentStatus;
-@property (nonatomic, strong) NSString *currentEPGURL; // Track current EPG URL for cache saving
+@property (nonatomic, strong, readwrite) VLCNowNextTable *nowNextTable;
+@property (atomic, strong) NSDictionary *catchupDaysByName;         // Normalized tvg-id/tvg-name/name -> catch-up days
+@property (atomic, strong) NSDictionary *shortEPGAccount;
+@property (atomic, strong) NSArray<VLCChannel *> *shortEPGChannels;
+@property (atomic, strong) VLCShortEPGFetcher *shortEPGFetcher;     // While a cold-start fetch runs
+@property (atomic, strong) NSArray<VLCChannel *> *priorityChannels;
+@property (atomic, assign) BOOL showingPriorityChannels;             // Published ahead of the full guide
+@property (atomic, strong) VLCEPGSnapshot *priorityFallback;        // Put back when the full guide fails
+
++ (NSUInteger)getCurrentMemoryUsage;
++ (NSUInteger)getPeakMemoryUsage;
+- (void)slideRetentionWindow;
+
+@end
 
-// XML parsing state
-@property (nonatomic, strong) NSMutableString *currentElementContent;
-@property (nonatomic, strong) VLCProgram *currentProgram;
-@property (nonatomic, strong) NSString *currentChannelId;
-@property (nonatomic, strong) NSMutableArray *currentChannelPrograms;
-@property (nonatomic, assign) NSUInteger totalProgramsParsed;
-@property (nonatomic, assign) NSUInteger totalChannelsParsed;
+#pragma mark - Retention Window
 
-// Temporary parsing properties to avoid premature NSDate parsing
-@property (nonatomic, strong) NSString *currentStartTimeStr;
-@property (nonatomic, strong) NSString *currentStopTimeStr;
+// How often the retention window slides forward and drops what fell out of it
+static const NSTimeInterval VLCEPGRetentionInterval = 3600.0;
+
+static NSString *VLCEPGRetentionKey(NSString *name) {
+    const char *bytes = name.length > 0 ? [name UTF8String] : NULL;
+    if (!bytes) {
+        return nil;
+    }
+    char normalized[VLC_CHANNEL_MATCHER_MAX_LENGTH];
+    size_t length = VLCChannelMatcherNormalize(bytes, strlen(bytes), normalized, sizeof(normalized));
+    if (length == 0) {
+        return nil;
+    }
+    // Latin-1 maps every byte, so cut UTF-8 sequences still make a key
+    return [[[NSString alloc] initWithBytes:normalized length:length encoding:NSISOLatin1StringEncoding] autorelease];
+}
 
-// Progress tracking
-@property (nonatomic, strong) NSTimer *progressTimer;
-@property (nonatomic, assign) NSUInteger lastReportedProgress;
+// The programmes worth keeping at one guide time: those that ended less than the past retention
+// ago (or, on a channel with catch-up, within its catch-up days) and start before the horizon
+@interface VLCEPGRetentionWindow : NSObject {
+    int64_t _guideTime;
+    int64_t _defaultPastCutoff;
+    NSDictionary *_catchupDays;
+}
+@property (nonatomic, readonly) int64_t futureCutoff;   // INT64_MAX without a horizon
+
+- (instancetype)initWithGuideTime:(int64_t)guideTime
+                        pastHours:(NSTimeInterval)pastHours
+                      futureHours:(NSTimeInterval)futureHours
+                      catchupDays:(NSDictionary *)catchupDays;
+- (int64_t)pastCutoffForChannelId:(NSString *)channelId;
+@end
+
+@implementation VLCEPGRetentionWindow
+
+- (instancetype)initWithGuideTime:(int64_t)guideTime
+                        pastHours:(NSTimeInterval)pastHours
+                      futureHours:(NSTimeInterval)futureHours
+                      catchupDays:(NSDictionary *)catchupDays {
+    self = [super init];
+    if (self) {
+        _guideTime = guideTime;
+        _defaultPastCutoff = pastHours > 0 ? guideTime - (int64_t)llround(pastHours * 3600.0) : INT64_MIN;
+        _futureCutoff = futureHours > 0 ? guideTime + (int64_t)llround(futureHours * 3600.0) : INT64_MAX;
+        _catchupDays = [catchupDays copy];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_catchupDays release];
+    [super dealloc];
+}
+
+- (int64_t)pastCutoffForChannelId:(NSString *)channelId {
+    if (_defaultPastCutoff == INT64_MIN || _catchupDays.count == 0) {
+        return _defaultPastCutoff;
+    }
+    NSString *key = VLCEPGRetentionKey(channelId);
+    NSInteger days = key ? [[_catchupDays objectForKey:key] integerValue] : 0;
+    return MIN(_defaultPastCutoff, _guideTime - (int64_t)days * 86400);
+}
+
+@end
+
+#pragma mark - XMLTV Parse Session
+
+// Pieces handed to other cores in parallel mode: cut at a <programme> boundary once this big
+#define VLC_XMLTV_PIECE_BYTES (4u * 1024u * 1024u)
+
+// Priority channels whose programmes are complete are published at most this often
+static const CFAbsoluteTime VLCXMLTVPriorityPublishInterval = 0.5;
+
+// A piece of the decoded document, parsed on any thread and merged in document order
+typedef struct {
+    char *bytes;
+    size_t length;
+    BOOL last;
+    VLCXMLTVShard *shard;
+    dispatch_semaphore_t parsed;
+} VLCXMLTVPiece;
+
+// One XMLTV document being parsed as it downloads. Programmes go straight into a fresh
+// programme store whose lists replace the EPG data once the document is complete.
+// .xml.gz and .xml.xz guides are inflated on the way, one chunk at a time.
+// In parallel mode the decoded document is cut into pieces parsed on all cores into buffers of
+// their own; a serial queue appends them to the store in document order, so the store ends up
+// exactly as a serial parse would leave it.
+// Guides list each channel's programmes in one run, so a channel is complete once the next run
+// starts. Priority channels (by normalized id or display name) are handed out then, copied into
+// a store of their own, long before the document ends.
+@interface VLCXMLTVParseSession : NSObject {
+    VLCStreamDecompressor *_decompressor;
+    VLCXMLTVParser *_parser;
+    char _lastChannelBytes[256];    // Programmes come grouped by channel; reuse its table
+    size_t _lastChannelLength;
+    uint32_t _lastChannel;
+    
+    // Parallel mode
+    BOOL _parallel;
+    char *_segment;                 // Decoded bytes not handed to a piece yet
+    size_t _segmentLength;
+    size_t _segmentCapacity;
+    dispatch_queue_t _mergeQueue;
+    dispatch_semaphore_t _piecesInFlight;
+    VLCXMLTVParserStats _pieceStats;
+    
+    // Set on the merge queue and read on the download thread, so only through __atomic builtins
+    BOOL _failed;
+    BOOL _decompressionFailed;
+    BOOL _storeFailed;
+    BOOL _cutShort;
+    
+    // Retention
+    VLCEPGRetentionWindow *_retentionWindow;
+    int64_t *_pastCutoffs;          // Per store channel
+    size_t _pastCutoffCount;
+    size_t _pastCutoffCapacity;
+    int64_t _futureCutoff;
+    
+    // Priority channels
+    NSSet *_priorityKeys;
+    NSMutableIndexSet *_priorityChannels;       // Store channels
+    NSMutableIndexSet *_completePriorityChannels;
+    NSUInteger _publishedPriorityCount;
+    CFAbsoluteTime _lastPriorityPublish;
+    uint32_t _runChannel;
+}
+@property (nonatomic, readonly) VLCProgramStore *store;
+@property (nonatomic, readonly) NSMutableDictionary *displayNames;  // channelId -> display names, for matching by name
+@property (nonatomic, assign) int64_t bytesReceived;
+@property (nonatomic, assign) int64_t bytesExpected;
+@property (nonatomic, readonly) CFAbsoluteTime startTime;
+@property (nonatomic, assign) CFAbsoluteTime lastProgressTime;
+@property (nonatomic, readonly) NSUInteger programCount;
+@property (nonatomic, readonly) NSUInteger channelCount;    // Channels with at least one programme
+@property (nonatomic, readonly) BOOL failed;
+@property (nonatomic, readonly) BOOL decompressionFailed;  // Corrupt gzip/xz rather than bad XML
+@property (nonatomic, readonly) BOOL storeFailed;          // Ran out of memory for programmes
+@property (nonatomic, readonly) NSUInteger pieceCount;      // Pieces parsed in parallel, 0 in serial mode
+@property (nonatomic, readonly) NSUInteger prunedCount;     // Programmes outside the retention window
+// Gets a sealed store of the complete priority channels so far, and their display names; runs
+// on the parsing thread
+@property (nonatomic, copy) void (^priorityHandler)(VLCProgramStore *store, NSDictionary *displayNames);
+
+// A nil window keeps every programme. priorityKeys are VLCEPGRetentionKey()s.
+- (instancetype)initWithRetentionWindow:(VLCEPGRetentionWindow *)window
+                           priorityKeys:(NSSet *)priorityKeys
+                        parallelParsing:(BOOL)parallel;
+- (void)consumeBytes:(const char *)bytes length:(NSUInteger)length;
+- (BOOL)finish;                     // NO when the document or compressed stream was cut short
+- (VLCXMLTVParserStats)stats;
+- (VLCCompressionFormat)compressionFormat;
+- (int64_t)bytesDecoded;
+- (BOOL)parseDecodedBytes:(const char *)bytes length:(size_t)length;
+- (BOOL)addChannel:(const VLCXMLTVChannel *)channel;
+- (BOOL)addProgramme:(const VLCXMLTVProgramme *)programme;
+@end
+
+static int VLCXMLTVParseSessionHandleChannel(const VLCXMLTVChannel *channel, void *context) {
+    return [(VLCXMLTVParseSession *)context addChannel:channel];
+}
+
+static int VLCXMLTVParseSessionHandleProgramme(const VLCXMLTVProgramme *programme, void *context) {
+    return [(VLCXMLTVParseSession *)context addProgramme:programme];
+}
+
+static int VLCXMLTVParseSessionHandleDecoded(const char *bytes, size_t length, void *context) {
+    return [(VLCXMLTVParseSession *)context parseDecodedBytes:bytes length:length];
+}
+
+static NSString *VLCXMLTVNewString(VLCXMLTVSpan span) {
+    NSString *string = [[NSString alloc] initWithBytes:span.bytes length:span.length encoding:NSUTF8StringEncoding];
+    if (!string) {
+        // Some providers still ship Latin-1 guides while declaring UTF-8
+        string = [[NSString alloc] initWithBytes:span.bytes length:span.length encoding:NSISOLatin1StringEncoding];
+    }
+    return string;
+}
+
+static inline BOOL VLCXMLTVParseSessionFlag(BOOL *flag) {
+    return __atomic_load_n(flag, __ATOMIC_ACQUIRE);
+}
+
+static inline void VLCXMLTVParseSessionRaise(BOOL *flag) {
+    __atomic_store_n(flag, YES, __ATOMIC_RELEASE);
+}
+
+static int64_t VLCEPGTimestampFromDate(NSDate *date) {
+    return (int64_t)floor([date timeIntervalSince1970]);
+}
+
+@implementation VLCXMLTVParseSession
+
+- (instancetype)init {
+    return [self initWithRetentionWindow:nil priorityKeys:nil parallelParsing:NO];
+}
+
+- (instancetype)initWithRetentionWindow:(VLCEPGRetentionWindow *)window
+                           priorityKeys:(NSSet *)priorityKeys
+                        parallelParsing:(BOOL)parallel {
+    self = [super init];
+    if (self) {
+        _retentionWindow = [window retain];
+        if (priorityKeys.count > 0) {
+            _priorityKeys = [priorityKeys copy];
+            _priorityChannels = [[NSMutableIndexSet alloc] init];
+            _completePriorityChannels = [[NSMutableIndexSet alloc] init];
+        }
+        _runChannel = VLC_PROGRAM_STORE_NO_CHANNEL;
+        _futureCutoff = window ? window.futureCutoff : INT64_MAX;
+        VLCXMLTVHandlers handlers = { VLCXMLTVParseSessionHandleChannel, VLCXMLTVParseSessionHandleProgramme };
+        _parser = VLCXMLTVParserCreate(handlers, self);
+        if (parallel) {
+            _parallel = YES;
+            _mergeQueue = dispatch_queue_create("com.basicplayer.epg.merge", DISPATCH_QUEUE_SERIAL);
+            // Bounded so a fast download cannot queue up the whole document in memory
+            _piecesInFlight = dispatch_semaphore_create((long)[[NSProcessInfo processInfo] activeProcessorCount] * 2);
+        }
+        _decompressor = VLCStreamDecompressorCreate(VLCXMLTVParseSessionHandleDecoded, self);
+        _store = [[VLCProgramStore alloc] init];
+        _displayNames = [[NSMutableDictionary alloc] init];
+        _lastChannel = VLC_PROGRAM_STORE_NO_CHANNEL;
+        _bytesExpected = -1;
+        _startTime = CFAbsoluteTimeGetCurrent();
+    }
+    return self;
+}
+
+- (void)dealloc {
+    VLCStreamDecompressorFree(_decompressor);
+    VLCXMLTVParserFree(_parser);
+    free(_segment);
+    free(_pastCutoffs);
+    [_retentionWindow release];
+    [_priorityKeys release];
+    [_priorityChannels release];
+    [_completePriorityChannels release];
+    [_priorityHandler release];
+    if (_mergeQueue) {
+        dispatch_release(_mergeQueue);
+        dispatch_release(_piecesInFlight);
+    }
+    [_store release];
+    [_displayNames release];
+    [super dealloc];
+}
+
+- (BOOL)failed {
+    return VLCXMLTVParseSessionFlag(&_failed);
+}
+
+- (BOOL)decompressionFailed {
+    return VLCXMLTVParseSessionFlag(&_decompressionFailed);
+}
+
+- (BOOL)storeFailed {
+    return VLCXMLTVParseSessionFlag(&_storeFailed);
+}
+
+- (void)consumeBytes:(const char *)bytes length:(NSUInteger)length {
+    self.bytesReceived += length;
+    if (!self.failed && !VLCStreamDecompressorFeed(_decompressor, bytes, length)) {
+        // A parser or merge failure stops the decompressor too; only its own failures count here
+        if (!self.failed) {
+            VLCXMLTVParseSessionRaise(&_decompressionFailed);
+        }
+        VLCXMLTVParseSessionRaise(&_failed);
+    }
+}
+
+- (BOOL)parseDecodedBytes:(const char *)bytes length:(size_t)length {
+    if (_parallel) {
+        // A whole document handed over at once still has to be cut into pieces
+        while (length > 0) {
+            size_t step = MIN(length, (size_t)VLC_XMLTV_PIECE_BYTES / 4);
+            if (![self appendToSegment:bytes length:step]) {
+                return NO;
+            }
+            bytes += step;
+            length -= step;
+        }
+        return YES;
+    }
+    if (!VLCXMLTVParserFeed(_parser, bytes, length)) {
+        VLCXMLTVParseSessionRaise(&_failed);
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)finish {
+    // Flushes what the decompressor still holds into the parser first
+    BOOL streamComplete = !self.failed && VLCStreamDecompressorFinish(_decompressor);
+    if (!_parallel) {
+        return streamComplete && VLCXMLTVParserFinish(_parser);
+    }
+    if (_segmentLength > 0 && !self.failed && !self.storeFailed) {
+        [self dispatchPieceOfLength:_segmentLength last:YES];
+    }
+    // Waits for every piece to be merged; only then are the merge queue's flags final
+    dispatch_sync(_mergeQueue, ^{});
+    return streamComplete && !VLCXMLTVParseSessionFlag(&_cutShort) && !self.failed && !self.storeFailed;
+}
+
+#pragma mark - Parallel Mode
+
+// Collects decoded bytes until a piece is big enough, then hands it to another core
+- (BOOL)appendToSegment:(const char *)bytes length:(size_t)length {
+    if (self.failed || self.storeFailed) {
+        VLCXMLTVParseSessionRaise(&_failed);
+        return NO;
+    }
+    if (_segmentLength + length > _segmentCapacity) {
+        size_t capacity = MAX(_segmentCapacity * 2, (size_t)VLC_XMLTV_PIECE_BYTES + 65536);
+        while (capacity < _segmentLength + length) {
+            capacity *= 2;
+        }
+        char *segment = realloc(_segment, capacity);
+        if (!segment) {
+            VLCXMLTVParseSessionRaise(&_storeFailed);
+            VLCXMLTVParseSessionRaise(&_failed);
+            return NO;
+        }
+        _segment = segment;
+        _segmentCapacity = capacity;
+    }
+    memcpy(_segment + _segmentLength, bytes, length);
+    _segmentLength += length;
+    
+    if (_segmentLength >= VLC_XMLTV_PIECE_BYTES) {
+        // No boundary yet (a long run of <channel>s): keep collecting
+        size_t boundary = VLCXMLTVShardBoundary(_segment, _segmentLength);
+        if (boundary > 0) {
+            return [self dispatchPieceOfLength:boundary last:NO];
+        }
+    }
+    return YES;
+}
+
+// The segment's first length bytes become a piece; the rest starts the next segment
+- (BOOL)dispatchPieceOfLength:(size_t)length last:(BOOL)last {
+    size_t remaining = _segmentLength - length;
+    size_t capacity = MAX(remaining, (size_t)VLC_XMLTV_PIECE_BYTES + 65536);
+    char *next = last ? NULL : malloc(capacity);
+    VLCXMLTVPiece *piece = calloc(1, sizeof(VLCXMLTVPiece));
+    if ((!last && !next) || !piece) {
+        free(next);
+        free(piece);
+        VLCXMLTVParseSessionRaise(&_storeFailed);
+        VLCXMLTVParseSessionRaise(&_failed);
+        return NO;
+    }
+    if (next) {
+        memcpy(next, _segment + length, remaining);
+    }
+    piece->bytes = _segment;
+    piece->length = length;
+    piece->last = last;
+    piece->parsed = dispatch_semaphore_create(0);
+    _segment = next;
+    _segmentLength = remaining;
+    _segmentCapacity = next ? capacity : 0;
+    _pieceCount++;
+    
+    dispatch_semaphore_wait(_piecesInFlight, DISPATCH_TIME_FOREVER);
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        piece->shard = VLCXMLTVShardParse(piece->bytes, piece->length);
+        dispatch_semaphore_signal(piece->parsed);
+    });
+    // Enqueued in document order, so pieces are merged in document order
+    dispatch_async(_mergeQueue, ^{
+        dispatch_semaphore_wait(piece->parsed, DISPATCH_TIME_FOREVER);
+        @autoreleasepool {
+            [self mergePiece:piece];
+        }
+        VLCXMLTVShardFree(piece->shard);
+        dispatch_release(piece->parsed);
+        free(piece->bytes);
+        free(piece);
+        dispatch_semaphore_signal(_piecesInFlight);
+    });
+    return YES;
+}
+
+// Runs on the merge queue
+- (void)mergePiece:(const VLCXMLTVPiece *)piece {
+    VLCXMLTVShard *shard = piece->shard;
+    if (self.failed || self.storeFailed) {
+        return;
+    }
+    if (!shard) {
+        VLCXMLTVParseSessionRaise(&_storeFailed);
+        return;
+    }
+    switch (VLCXMLTVShardGetResult(shard)) {
+        case VLCXMLTVShardParsed:
+            break;
+        case VLCXMLTVShardCutShort:
+            // Only the end of the document may be cut off; anywhere else the cut was misplaced
+            if (piece->last) {
+                VLCXMLTVParseSessionRaise(&_cutShort);
+            } else {
+                VLCXMLTVParseSessionRaise(&_failed);
+            }
+            break;
+        case VLCXMLTVShardFailed:
+            VLCXMLTVParseSessionRaise(&_failed);
+            break;
+    }
+    VLCXMLTVParserStats stats = VLCXMLTVShardGetStats(shard);
+    _pieceStats.channels += stats.channels;
+    _pieceStats.programmes += stats.programmes;
+    _pieceStats.skippedElements += stats.skippedElements;
+    _pieceStats.skippedBytes += stats.skippedBytes;
+    _pieceStats.carriedBytes += stats.carriedBytes;
+    if (self.failed) {
+        return;
+    }
+    
+    // Ids in the order the piece first mentions them, so store channels are created in the
+    // same order as by a serial parse
+    size_t idCount = VLCXMLTVShardChannelIdCount(shard);
+    uint32_t *channels = malloc((idCount ? idCount : 1) * sizeof(uint32_t));
+    if (!channels) {
+        VLCXMLTVParseSessionRaise(&_storeFailed);
+        return;
+    }
+    for (size_t i = 0; i < idCount; i++) {
+        channels[i] = [self channelForSpan:VLCXMLTVShardChannelId(shard, i)];
+        if (channels[i] == VLC_PROGRAM_STORE_NO_CHANNEL) {
+            VLCXMLTVParseSessionRaise(&_storeFailed);
+            free(channels);
+            return;
+        }
+    }
+    
+    size_t count;
+    const VLCXMLTVShardChannel *declarations = VLCXMLTVShardChannels(shard, &count);
+    for (size_t i = 0; i < count; i++) {
+        [self addDisplayNames:declarations[i].displayNames
+                        count:declarations[i].displayNameCount
+                 forChannelId:VLCXMLTVShardChannelId(shard, declarations[i].channel)];
+        [self markPriorityChannel:channels[declarations[i].channel]
+                     displayNames:declarations[i].displayNames
+                            count:declarations[i].displayNameCount];
+    }
+    
+    const VLCXMLTVShardProgramme *programmes = VLCXMLTVShardProgrammes(shard, &count);
+    for (size_t i = 0; i < count; i++) {
+        const VLCXMLTVShardProgramme *programme = &programmes[i];
+        VLCProgramStoreRow row = {
+            .startTimestamp = programme->start == VLC_XMLTV_SHARD_NO_TIME ? VLC_PROGRAM_NO_TIMESTAMP : programme->start,
+            .endTimestamp = programme->stop == VLC_XMLTV_SHARD_NO_TIME ? VLC_PROGRAM_NO_TIMESTAMP : programme->stop,
+            .title = programme->title.bytes,
+            .titleLength = programme->title.length,
+            .programDescription = programme->desc.bytes,
+            .programDescriptionLength = programme->desc.length
+        };
+        if (![self appendRow:&row toChannel:channels[programme->channel]]) {
+            break;
+        }
+    }
+    free(channels);
+}
+
+- (VLCCompressionFormat)compressionFormat {
+    return VLCStreamDecompressorFormat(_decompressor);
+}
+
+- (int64_t)bytesDecoded {
+    return (int64_t)VLCStreamDecompressorBytesOut(_decompressor);
+}
+
+- (VLCXMLTVParserStats)stats {
+    return _parallel ? _pieceStats : VLCXMLTVParserGetStats(_parser);
+}
+
+- (uint32_t)channelForSpan:(VLCXMLTVSpan)span {
+    if (_lastChannel != VLC_PROGRAM_STORE_NO_CHANNEL && span.length == _lastChannelLength &&
+        memcmp(span.bytes, _lastChannelBytes, span.length) == 0) {
+        return _lastChannel;
+    }
+    NSString *channelId = VLCXMLTVNewString(span);
+    _lastChannel = [self.store channelIndexForId:channelId];
+    if (_retentionWindow && _lastChannel != VLC_PROGRAM_STORE_NO_CHANNEL && _lastChannel >= _pastCutoffCount &&
+        ![self addPastCutoffForChannel:_lastChannel channelId:channelId]) {
+        _lastChannel = VLC_PROGRAM_STORE_NO_CHANNEL;
+    }
+    if (_priorityKeys && _lastChannel != VLC_PROGRAM_STORE_NO_CHANNEL && channelId &&
+        [_priorityKeys containsObject:VLCEPGRetentionKey(channelId)]) {
+        [_priorityChannels addIndex:_lastChannel];
+    }
+    [channelId release];
+    
+    if (span.length <= sizeof(_lastChannelBytes)) {
+        memcpy(_lastChannelBytes, span.bytes, span.length);
+        _lastChannelLength = span.length;
+    } else {
+        _lastChannelLength = SIZE_MAX;  // Too long to remember; never matches
+    }
+    return _lastChannel;
+}
+
+// Store channels are numbered in order of creation, so a new channel is always the next entry
+- (BOOL)addPastCutoffForChannel:(uint32_t)channel channelId:(NSString *)channelId {
+    if (channel >= _pastCutoffCapacity) {
+        size_t capacity = MAX(_pastCutoffCapacity * 2, (size_t)1024);
+        int64_t *cutoffs = realloc(_pastCutoffs, capacity * sizeof(int64_t));
+        if (!cutoffs) {
+            return NO;
+        }
+        _pastCutoffs = cutoffs;
+        _pastCutoffCapacity = capacity;
+    }
+    _pastCutoffs[channel] = [_retentionWindow pastCutoffForChannelId:channelId];
+    _pastCutoffCount = channel + 1;
+    return YES;
+}
+
+- (BOOL)addChannel:(const VLCXMLTVChannel *)channel {
+    if (channel->id.length == 0) {
+        return YES;
+    }
+    // Declared channels get an (empty) entry even before any programme
+    uint32_t index = [self channelForSpan:channel->id];
+    if (index == VLC_PROGRAM_STORE_NO_CHANNEL) {
+        VLCXMLTVParseSessionRaise(&_storeFailed);
+        return NO;
+    }
+    [self addDisplayNames:channel->displayNames count:channel->displayNameCount forChannelId:channel->id];
+    [self markPriorityChannel:index displayNames:channel->displayNames count:channel->displayNameCount];
+    return YES;
+}
+
+// Playlists often name a channel the way the guide's display name does, not by its id
+- (void)markPriorityChannel:(uint32_t)channel displayNames:(const VLCXMLTVSpan *)displayNames count:(size_t)count {
+    if (!_priorityKeys || [_priorityChannels containsIndex:channel]) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        NSString *name = VLCXMLTVNewString(displayNames[i]);
+        BOOL priority = name && [_priorityKeys containsObject:VLCEPGRetentionKey(name)];
+        [name release];
+        if (priority) {
+            [_priorityChannels addIndex:channel];
+            return;
+        }
+    }
+}
+
+// The run of programmes of channel ended; hands out the complete priority channels when due
+- (void)finishRunOfChannel:(uint32_t)channel {
+    if (![_priorityChannels containsIndex:channel] || [self.store programCountForChannel:channel] == 0) {
+        return;
+    }
+    [_completePriorityChannels addIndex:channel];
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    if (!self.priorityHandler || _completePriorityChannels.count == _publishedPriorityCount ||
+        (_publishedPriorityCount > 0 && now - _lastPriorityPublish < VLCXMLTVPriorityPublishInterval)) {
+        return;
+    }
+    VLCProgramStore *store = [self.store storeWithRowsOfChannels:_completePriorityChannels];
+    if (!store) {
+        return;
+    }
+    NSMutableDictionary *displayNames = [NSMutableDictionary dictionaryWithCapacity:_completePriorityChannels.count];
+    [_completePriorityChannels enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        NSString *channelId = [self.store channelIdForChannel:(uint32_t)index];
+        NSArray *names = [self->_displayNames objectForKey:channelId];
+        if (names) {
+            [displayNames setObject:[[names copy] autorelease] forKey:channelId];
+        }
+    }];
+    _publishedPriorityCount = _completePriorityChannels.count;
+    _lastPriorityPublish = now;
+    self.priorityHandler(store, displayNames);
+}
+
+// Kept so playlists without tvg-ids can still be matched by name
+- (void)addDisplayNames:(const VLCXMLTVSpan *)displayNames count:(size_t)count forChannelId:(VLCXMLTVSpan)span {
+    if (count == 0) {
+        return;
+    }
+    NSString *channelId = VLCXMLTVNewString(span);
+    if (!channelId) {
+        return;
+    }
+    NSMutableArray *names = [_displayNames objectForKey:channelId];
+    if (!names) {
+        names = [NSMutableArray arrayWithCapacity:count];
+        [_displayNames setObject:names forKey:channelId];
+    }
+    for (size_t i = 0; i < count; i++) {
+        NSString *name = VLCXMLTVNewString(displayNames[i]);
+        if (name) {
+            [names addObject:name];
+            [name release];
+        }
+    }
+    [channelId release];
+}
+
+// Returns NO (stopping the parser) when the store runs out of memory
+- (BOOL)addProgramme:(const VLCXMLTVProgramme *)programme {
+    if (programme->channel.length == 0 || programme->title.length == 0) {
+        return YES;
+    }
+    uint32_t channel = [self channelForSpan:programme->channel];
+    if (channel == VLC_PROGRAM_STORE_NO_CHANNEL) {
+        VLCXMLTVParseSessionRaise(&_storeFailed);
+        return NO;
+    }
+    // Decoded straight from the attribute bytes; strings are pooled, not turned into objects
+    VLCProgramStoreRow row = {
+        .startTimestamp = VLC_PROGRAM_NO_TIMESTAMP,
+        .endTimestamp = VLC_PROGRAM_NO_TIMESTAMP,
+        .title = programme->title.bytes,
+        .titleLength = programme->title.length,
+        .programDescription = programme->desc.bytes,
+        .programDescriptionLength = programme->desc.length
+    };
+    int64_t timestamp;
+    if (programme->start.length > 0 && VLCXMLTVParseTime(programme->start.bytes, programme->start.length, &timestamp)) {
+        row.startTimestamp = timestamp;
+    }
+    if (programme->stop.length > 0 && VLCXMLTVParseTime(programme->stop.bytes, programme->stop.length, &timestamp)) {
+        row.endTimestamp = timestamp;
+    }
+    return [self appendRow:&row toChannel:channel];
+}
+
+// Returns NO when the store runs out of memory
+- (BOOL)appendRow:(const VLCProgramStoreRow *)row toChannel:(uint32_t)channel {
+    if (channel != _runChannel) {
+        if (_priorityKeys && _runChannel != VLC_PROGRAM_STORE_NO_CHANNEL) {
+            [self finishRunOfChannel:_runChannel];
+        }
+        _runChannel = channel;
+    }
+    // Never stored, so never allocated
+    if (_retentionWindow && !VLCProgramInRetentionWindow(row->startTimestamp, row->endTimestamp,
+                                                         _pastCutoffs[channel], _futureCutoff)) {
+        _prunedCount++;
+        return YES;
+    }
+    BOOL firstProgram = [self.store programCountForChannel:channel] == 0;
+    if (![self.store appendRow:row toChannel:channel]) {
+        VLCXMLTVParseSessionRaise(&_storeFailed);
+        return NO;
+    }
+    if (firstProgram) {
+        _channelCount++;
+    }
+    _programCount++;
+    return YES;
+}
+
+@end
+
+#pragma mark - EPG Channel Index
+
+// How a playlist channel found its guide entry, in the order the ways are tried
+typedef NS_ENUM(NSUInteger, VLCEPGMatchKind) {
+    VLCEPGMatchNone = 0,
+    VLCEPGMatchChannelId,       // tvg-id is an XMLTV channel id
+    VLCEPGMatchNormalizedId,    // tvg-id equals an id or display name once normalized ("UK: BBC One HD" / "bbcone.uk")
+    VLCEPGMatchTvgName,         // tvg-name, likewise
+    VLCEPGMatchName,            // Channel name, likewise
+    VLCEPGMatchFuzzy            // tvg-name or name similar enough to an id or display name
+};
+
+// Lowest trigram similarity accepted for a fuzzy match
+static const double VLCEPGFuzzyMatchThreshold = 0.7;
+
+// VOD entries listed among the channels never have a guide
+static BOOL VLCEPGIsUnlikelyLiveChannel(NSString *name) {
+    return name && ([name rangeOfString:@"2023"].location != NSNotFound ||
+                    [name rangeOfString:@"2024"].location != NSNotFound ||
+                    [name rangeOfString:@"Movie"].location != NSNotFound ||
+                    [name rangeOfString:@"●"].location != NSNotFound);
+}
+
+// Every EPG channel id and display name, normalized and indexed once per EPG data set.
+// Lookups are thread safe.
+@interface VLCEPGChannelIndex : NSObject {
+    NSDictionary *_programLists;    // channelId -> programs the index was built from
+    NSArray *_channelIds;           // Matcher targets: ids with programmes, sorted
+    VLCChannelMatcher *_matcher;
+}
+@property (nonatomic, readonly) NSUInteger nameCount;
+- (instancetype)initWithProgramLists:(NSDictionary *)programLists displayNames:(NSDictionary *)displayNames;
+- (NSArray *)programsForChannel:(VLCChannel *)channel matchKind:(VLCEPGMatchKind *)matchKind;
+@end
+
+static BOOL VLCEPGChannelIndexAdd(VLCChannelMatcher *matcher, NSString *name, uint32_t target) {
+    const char *bytes = [name UTF8String];
+    return !bytes || VLCChannelMatcherAdd(matcher, bytes, strlen(bytes), target);
+}
+
+static uint32_t VLCEPGChannelIndexFind(VLCChannelMatcher *matcher, NSString *name, BOOL fuzzy) {
+    const char *bytes = name.length > 0 ? [name UTF8String] : NULL;
+    if (!bytes) {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    if (fuzzy) {
+        return VLCChannelMatcherFindSimilar(matcher, bytes, strlen(bytes), VLCEPGFuzzyMatchThreshold, NULL);
+    }
+    return VLCChannelMatcherFindExact(matcher, bytes, strlen(bytes));
+}
+
+@implementation VLCEPGChannelIndex
+
+- (instancetype)initWithProgramLists:(NSDictionary *)programLists displayNames:(NSDictionary *)displayNames {
+    self = [super init];
+    if (!self) {
+        return nil;
+    }
+    _programLists = [programLists copy];
+    
+    // Sorted so equal names resolve the same way every time
+    NSMutableArray *channelIds = [NSMutableArray arrayWithCapacity:_programLists.count];
+    for (NSString *channelId in _programLists) {
+        if ([[_programLists objectForKey:channelId] count] > 0) {
+            [channelIds addObject:channelId];
+        }
+    }
+    [channelIds sortUsingSelector:@selector(compare:)];
+    _channelIds = [channelIds copy];
+    
+    NSUInteger count = _channelIds.count;
+    _matcher = VLCChannelMatcherCreate(count * 2);
+    BOOL added = _matcher != NULL;
+    // Ids first, so an id wins over another channel's display name that normalizes the same
+    for (NSUInteger i = 0; added && i < count; i++) {
+        @autoreleasepool {
+            added = VLCEPGChannelIndexAdd(_matcher, [_channelIds objectAtIndex:i], (uint32_t)i);
+        }
+    }
+    for (NSUInteger i = 0; added && i < count; i++) {
+        @autoreleasepool {
+            for (NSString *name in [displayNames objectForKey:[_channelIds objectAtIndex:i]]) {
+                if (!(added = VLCEPGChannelIndexAdd(_matcher, name, (uint32_t)i))) break;
+            }
+        }
+    }
+    if (!added || !VLCChannelMatcherFinish(_matcher)) {
+        NSLog(@"⚠️ [EPG-MATCH] Not enough memory to index EPG channel names - matching by tvg-id only");
+        VLCChannelMatcherFree(_matcher);
+        _matcher = NULL;
+    }
+    _nameCount = VLCChannelMatcherCount(_matcher);
+    return self;
+}
+
+- (void)dealloc {
+    VLCChannelMatcherFree(_matcher);
+    [_programLists release];
+    [_channelIds release];
+    [super dealloc];
+}
+
+- (NSArray *)programsForChannel:(VLCChannel *)channel matchKind:(VLCEPGMatchKind *)matchKind {
+    NSString *channelId = channel.channelId;
+    NSArray *programs = channelId.length > 0 ? [_programLists objectForKey:channelId] : nil;
+    VLCEPGMatchKind kind = VLCEPGMatchChannelId;
+    
+    if (programs.count == 0 && _matcher) {
+        NSString *tvgName = channel.tvgName;
+        NSString *name = channel.name;
+        uint32_t target = VLC_CHANNEL_MATCHER_NONE;
+        // Fuzzy lookups share the matcher's scratch memory
+        @synchronized(self) {
+            if ((target = VLCEPGChannelIndexFind(_matcher, channelId, NO)) != VLC_CHANNEL_MATCHER_NONE) {
+                kind = VLCEPGMatchNormalizedId;
+            } else if ((target = VLCEPGChannelIndexFind(_matcher, tvgName, NO)) != VLC_CHANNEL_MATCHER_NONE) {
+                kind = VLCEPGMatchTvgName;
+            } else if ((target = VLCEPGChannelIndexFind(_matcher, name, NO)) != VLC_CHANNEL_MATCHER_NONE) {
+                kind = VLCEPGMatchName;
+            } else if ((target = VLCEPGChannelIndexFind(_matcher, tvgName, YES)) != VLC_CHANNEL_MATCHER_NONE ||
+                       (target = VLCEPGChannelIndexFind(_matcher, name, YES)) != VLC_CHANNEL_MATCHER_NONE) {
+                kind = VLCEPGMatchFuzzy;
+            }
+        }
+        programs = target != VLC_CHANNEL_MATCHER_NONE ? [_programLists objectForKey:[_channelIds objectAtIndex:target]] : nil;
+    }
+    
+    if (programs.count == 0) {
+        kind = VLCEPGMatchNone;
+        programs = nil;
+    }
+    if (matchKind) {
+        *matchKind = kind;
+    }
+    return programs;
+}
+
+@end
+
+#pragma mark - EPG Snapshot
+
+// One generation of EPG data, never changed once published. Loaders build the next generation
+// off to the side and publish it in a single pointer swap; a reader pins the generation it
+// loaded and keeps reading it however many newer ones are published meanwhile.
+@interface VLCEPGSnapshot : NSObject {
+    VLCEPGChannelIndex *_channelIndex;
+}
+@property (nonatomic, readonly) uint64_t generation;
+@property (nonatomic, readonly) NSDictionary *programLists;     // channelId -> programs
+@property (nonatomic, readonly) VLCProgramStore *store;         // Backs the lists, nil for plain arrays
+@property (nonatomic, readonly) NSDictionary *displayNames;     // channelId -> XMLTV display names
+
+- (instancetype)initWithGeneration:(uint64_t)generation
+                      programLists:(NSDictionary *)programLists
+                             store:(VLCProgramStore *)store
+                      displayNames:(NSDictionary *)displayNames;
+// Built on first use
+- (VLCEPGChannelIndex *)channelIndex;
+@end
+
+@implementation VLCEPGSnapshot
+
+- (instancetype)initWithGeneration:(uint64_t)generation
+                      programLists:(NSDictionary *)programLists
+                             store:(VLCProgramStore *)store
+                      displayNames:(NSDictionary *)displayNames {
+    self = [super init];
+    if (self) {
+        _generation = generation;
+        _programLists = programLists ? [programLists copy] : [[NSDictionary alloc] init];
+        _store = [store retain];
+        _displayNames = [displayNames copy];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_channelIndex release];
+    [_programLists release];
+    [_store release];
+    [_displayNames release];
+    [super dealloc];
+}
+
+- (VLCEPGChannelIndex *)channelIndex {
+    VLCEPGChannelIndex *index = VLCSnapshotLoad((id *)&_channelIndex);
+    if (index) {
+        return index;
+    }
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    index = [[[VLCEPGChannelIndex alloc] initWithProgramLists:_programLists displayNames:_displayNames] autorelease];
+    if (!VLCSnapshotPublishIfUnchanged((id *)&_channelIndex, nil, index)) {
+        // Built by another thread at the same time
+        return VLCSnapshotLoad((id *)&_channelIndex);
+    }
+    NSLog(@"🚀 [EPG-PERF] Indexed %lu EPG channel ids and display names of generation %llu in %.0f ms",
+          (unsigned long)index.nameCount, (unsigned long long)_generation, (CFAbsoluteTimeGetCurrent() - start) * 1000.0);
+    return index;
+}
 
 @end
 
@@ -50,13 +931,28 @@
     if (self) {
         [self setupDefaultConfiguration];
         [self initializeDataStructures];
+        [self startRetentionTimer];
     }
     return self;
 }
 
+- (void)dealloc {
+    if (_retentionTimer) {
+        dispatch_source_cancel(_retentionTimer);
+        dispatch_release(_retentionTimer);
+    }
+    [_sourceStores release];
+    [_sourceDisplayNames release];
+    [_sourceOrder release];
+    [super dealloc];
+}
+
 - (void)setupDefaultConfiguration {
     self.timeOffsetHours = 0.0;
     self.cacheValidityHours = 6.0; // 6 hours
+    self.parallelParsing = YES;
+    self.pastRetentionHours = 24.0;
+    self.futureHorizonHours = 72.0;
     
     self.internalIsLoaded = NO;
     self.internalIsLoading = NO;
@@ -66,20 +962,56 @@
     NSLog(@"📅 [EPG] Initialized with defaults");
 }
 
+// One core gains nothing from pieces but pays for the copies
+- (BOOL)shouldParseInParallel {
+    return self.parallelParsing && [[NSProcessInfo processInfo] activeProcessorCount] > 1;
+}
+
 - (void)initializeDataStructures {
-    self.internalEpgData = [[NSMutableDictionary alloc] init];
-    self.currentElementContent = [[NSMutableString alloc] init];
+    _sourceStores = [[NSMutableDictionary alloc] init];
+    _sourceDisplayNames = [[NSMutableDictionary alloc] init];
+    [self publishProgramLists:nil store:nil displayNames:nil];
     
     NSLog(@"📅 [EPG] Initialized data structures");
 }
 
-#pragma mark - Public Property Accessors
+#pragma mark - Snapshots
+
+// The current generation, pinned until the caller's autorelease pool drains. Never waits.
+- (VLCEPGSnapshot *)currentSnapshot {
+    return VLCSnapshotLoad((id *)&_snapshot);
+}
 
-- (NSDictionary *)epgData { 
-    @synchronized(self.internalEpgData) {
-        return [self.internalEpgData copy]; 
+// Writers take turns on self so read-modify-write updates are not lost; readers never take it
+- (void)publishProgramLists:(NSDictionary *)programLists
+                      store:(VLCProgramStore *)store
+               displayNames:(NSDictionary *)displayNames {
+    @synchronized(self) {
+        VLCEPGSnapshot *snapshot = [[VLCEPGSnapshot alloc] initWithGeneration:++_generation
+                                                                 programLists:programLists
+                                                                        store:store
+                                                                 displayNames:displayNames];
+        VLCSnapshotPublish((id *)&_snapshot, snapshot);
+        
+        // Main-thread reads since the last generation: what the UI did while this one was built
+        VLCSnapshotStats stats = VLCSnapshotGetStats();
+        uint64_t reads = stats.mainThreadLoads - _statsAtLastPublish.mainThreadLoads;
+        uint64_t nanos = stats.mainThreadLoadNanos - _statsAtLastPublish.mainThreadLoadNanos;
+        NSLog(@"🚀 [EPG-PERF] Published EPG generation %llu (%lu channels) • main thread: %llu lock-free reads since the last one, avg %.0f ns, slowest ever %.1f µs • %llu snapshots retired, %llu freed",
+              (unsigned long long)snapshot.generation, (unsigned long)snapshot.programLists.count,
+              (unsigned long long)reads, reads > 0 ? (double)nanos / reads : 0.0,
+              stats.maxMainThreadLoadNanos / 1000.0,
+              (unsigned long long)stats.retired, (unsigned long long)stats.released);
+        _statsAtLastPublish = stats;
+        [snapshot release];
     }
 }
+
+#pragma mark - Public Property Accessors
+
+- (NSDictionary *)epgData {
+    return [self currentSnapshot].programLists;
+}
 - (BOOL)isLoaded { return self.internalIsLoaded; }
 - (BOOL)isLoading { return self.internalIsLoading; }
 - (float)progress { return self.internalProgress; }
@@ -90,173 +1022,23 @@
 - (void)loadEPGFromURL:(NSString *)epgURL
             completion:(VLCEPGLoadCompletion)completion
               progress:(VLCEPGProgressBlock)progressBlock {
-    
-    if (self.internalIsLoading) {
-        NSLog(@"⚠️ [EPG] Already loading EPG, ignoring request");
-        if (completion) {
-            NSError *error = [NSError errorWithDomain:@"VLCEPGManager" 
-                                               code:4001 
-                                           userInfo:@{NSLocalizedDescriptionKey: @"EPG loading already in progress"}];
-            completion(nil, error);
-        }
-        return;
-    }
-    
-    NSLog(@"📅 [EPG] Starting EPG loading from URL: %@", epgURL);
-    
-    self.internalIsLoading = YES;
-    self.internalProgress = 0.0;
-    self.internalCurrentStatus = @"Checking EPG cache...";
-    
-    if (progressBlock) {
-        progressBlock(0.0, self.internalCurrentStatus);
-    }
-    
-    // Try loading from cache first
-    __weak __typeof__(self) weakSelf = self;
-    [self loadEPGFromCache:epgURL completion:^(NSDictionary *cachedEpgData, NSError *cacheError) {
-        __strong __typeof__(weakSelf) strongSelf = weakSelf;
-        if (!strongSelf) return;
-        
-        if (cachedEpgData && !cacheError) {
-            // Count total programs for logging
-            NSUInteger totalPrograms = 0;
-            for (NSString *channelId in cachedEpgData) {
-                NSArray *programs = [cachedEpgData objectForKey:channelId];
-                if ([programs isKindOfClass:[NSArray class]]) {
-                    totalPrograms += programs.count;
-                }
-            }
-            NSLog(@"✅ [CACHE] Found cached EPG: %lu channels with %lu programs total", (unsigned long)cachedEpgData.count, (unsigned long)totalPrograms);
-            
-            dispatch_async(dispatch_get_main_queue(), ^{
-                // CRITICAL FIX: Properly store the cached EPG data internally
-                @synchronized(strongSelf.internalEpgData) {
-                    strongSelf.internalEpgData = [cachedEpgData mutableCopy];
-                }
-                strongSelf.internalIsLoaded = YES;
-                strongSelf.internalIsLoading = NO;
-                strongSelf.internalProgress = 1.0;
-                strongSelf.internalCurrentStatus = [NSString stringWithFormat:@"EPG loaded from cache (%lu channels, %lu programs)", (unsigned long)cachedEpgData.count, (unsigned long)totalPrograms];
-                
-                if (progressBlock) {
-                    progressBlock(1.0, strongSelf.internalCurrentStatus);
-                }
-                
-                if (completion) {
-                    completion(cachedEpgData, nil);
-                }
-                
-                // CRITICAL: Explicitly log the cache load success for debugging
-                NSLog(@"📅 [EPG-CACHE] EPG data loaded from cache and stored internally - isLoaded: %@, dataCount: %lu", 
-                      strongSelf.internalIsLoaded ? @"YES" : @"NO", (unsigned long)strongSelf.internalEpgData.count);
-            });
-            return;
-        }
-        
-        // Cache miss or invalid - download from URL
-        NSLog(@"📅 [EPG] 🌐 Cache miss - downloading fresh EPG from server");
-        [strongSelf downloadAndParseEPG:epgURL completion:completion progress:progressBlock];
-    }];
+    VLCEPGSource *source = [[[VLCEPGSource alloc] initWithURL:epgURL name:nil] autorelease];
+    [self loadEPGFromSources:@[source] bypassCache:NO completion:completion progress:progressBlock];
 }
 
-- (void)downloadAndParseEPG:(NSString *)epgURL
-                 completion:(VLCEPGLoadCompletion)completion
-                   progress:(VLCEPGProgressBlock)progressBlock {
-    
-    // Store current EPG URL for cache saving
-    self.currentEPGURL = epgURL;
-    
-    self.internalCurrentStatus = @"🌐 Downloading fresh EPG from server...";
-    if (progressBlock) {
-        dispatch_async(dispatch_get_main_queue(), ^{
-            progressBlock(0.05, self.internalCurrentStatus);
-        });
-    }
+- (void)forceReloadEPGFromURL:(NSString *)epgURL
+                   completion:(VLCEPGLoadCompletion)completion
+                     progress:(VLCEPGProgressBlock)progressBlock {
     
-    // Use DownloadManager for async download with progress
-    DownloadManager *downloadManager = [[DownloadManager alloc] init];
+    NSLog(@"🔄 🚀 [EPG] FORCE reloading EPG from URL (bypassing cache): %@", epgURL);
+    NSLog(@"🌐 [EPG] Fresh download initiated - will show real download progress");
     
-    // Create temporary file path for download
-    NSString *tempFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"temp_epg.xml"];
+    // Clear existing data
+    [self clearEPGData];
     
-    [downloadManager startDownloadFromURL:epgURL
-                         progressHandler:^(int64_t totalBytesWritten, int64_t totalBytesExpectedToWrite) {
-        // CRITICAL FIX: Handle division by zero when server doesn't provide Content-Length
-        float downloadProgress;
-        if (totalBytesExpectedToWrite > 0) {
-            // Normal progress calculation when we know the total size
-            downloadProgress = 0.05 + (0.25 * ((float)totalBytesWritten / (float)totalBytesExpectedToWrite));
-        } else {
-            // Fallback: estimate progress based on downloaded bytes (assume reasonable EPG size)
-            float estimatedTotalMB = MAX(50.0, totalBytesWritten / 1024.0 / 1024.0 * 2.0); // Estimate total as 2x current download
-            float currentMB = totalBytesWritten / 1024.0 / 1024.0;
-            float estimatedProgress = MIN(0.25, currentMB / estimatedTotalMB * 0.25);
-            downloadProgress = 0.05 + estimatedProgress;
-        }
-        
-        // Ensure progress stays within reasonable bounds
-        downloadProgress = MAX(0.05, MIN(0.3, downloadProgress));
-        
-        NSString *progressStatus;
-        if (totalBytesExpectedToWrite > 0) {
-            progressStatus = [NSString stringWithFormat:@"🌐 Downloading EPG: %.1f MB / %.1f MB", 
-                            totalBytesWritten / 1024.0 / 1024.0, 
-                            totalBytesExpectedToWrite / 1024.0 / 1024.0];
-        } else {
-            progressStatus = [NSString stringWithFormat:@"🌐 Downloading EPG: %.1f MB", 
-                            totalBytesWritten / 1024.0 / 1024.0];
-        }
-        
-        // Log progress to console so user can see it
-        NSLog(@"%@", progressStatus);
-        
-        dispatch_async(dispatch_get_main_queue(), ^{
-            if (progressBlock) {
-                progressBlock(downloadProgress, progressStatus);
-            }
-        });
-    }
-                       completionHandler:^(NSString *filePath, NSError *error) {
-        if (error || !filePath) {
-            NSLog(@"❌ [EPG] Download failed: %@", error.localizedDescription);
-            dispatch_async(dispatch_get_main_queue(), ^{
-                self.internalIsLoading = NO;
-                if (completion) {
-                    completion(nil, error);
-                }
-            });
-            [downloadManager release];
-            return;
-        }
-        
-        // Read downloaded data
-        NSData *epgData = [NSData dataWithContentsOfFile:filePath];
-        if (!epgData) {
-            NSError *readError = [NSError errorWithDomain:@"VLCEPGManager" 
-                                                     code:4005 
-                                                 userInfo:@{NSLocalizedDescriptionKey: @"Failed to read downloaded EPG file"}];
-            dispatch_async(dispatch_get_main_queue(), ^{
-                self.internalIsLoading = NO;
-                if (completion) {
-                    completion(nil, readError);
-                }
-            });
-            [downloadManager release];
-            return;
-        }
-        
-        NSLog(@"✅ [EPG] 🌐 Successfully downloaded fresh EPG: %lu bytes", (unsigned long)epgData.length);
-        
-        // Clean up temp file
-        [[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
-        
-        // Parse the downloaded content (0.3 to 1.0 = remaining 70% for parsing)
-        [self parseEPGXMLData:epgData completion:completion progress:progressBlock];
-        
-        [downloadManager release];
-    }
-                         destinationPath:tempFilePath];
+    // Download and parse directly (bypass cache)
+    VLCEPGSource *source = [[[VLCEPGSource alloc] initWithURL:epgURL name:nil] autorelease];
+    [self loadEPGFromSources:@[source] bypassCache:YES completion:completion progress:progressBlock];
 }
 
 - (NSData *)downloadDataFromURL:(NSString *)urlString error:(NSError **)error {
@@ -321,72 +1103,37 @@
         return;
     }
     
-    [self.cacheManager loadEPGFromCache:sourceURL completion:^(id data, BOOL success, NSError *error) {
+    [self.cacheManager loadEPGAndDisplayNamesFromCache:sourceURL
+                                         validityHours:self.cacheManager.epgCacheValidityHours
+                                            completion:^(NSDictionary *data, NSDictionary *cachedNames, BOOL success, NSError *error) {
         if (success && [data isKindOfClass:[NSDictionary class]]) {
-            // CRITICAL FIX: Convert cached dictionary data to VLCProgram objects
-            NSDictionary *cachedEpgDict = (NSDictionary *)data;
-            NSMutableDictionary *convertedEpgData = [[NSMutableDictionary alloc] init];
-            
-            for (NSString *channelId in cachedEpgDict) {
-                NSArray *programDicts = [cachedEpgDict objectForKey:channelId];
-                NSMutableArray *programs = [[NSMutableArray alloc] init];
-                
-                for (NSDictionary *programDict in programDicts) {
-                    if ([programDict isKindOfClass:[NSDictionary class]]) {
-                        // Convert dictionary to VLCProgram object
-                        VLCProgram *program = [[VLCProgram alloc] init];
-                        program.title = [programDict objectForKey:@"title"];
-                        program.programDescription = [programDict objectForKey:@"description"];
-                        program.startTime = [programDict objectForKey:@"startTime"];
-                        program.endTime = [programDict objectForKey:@"endTime"];
-                        program.channelId = [programDict objectForKey:@"channelId"];
-                        
-                        // TIMESHIFT: Restore timeshift properties from cache
-                        program.hasArchive = [[programDict objectForKey:@"hasArchive"] boolValue];
-                        program.archiveDays = [[programDict objectForKey:@"archiveDays"] integerValue];
-                        
-                        [programs addObject:program];
-                        [program release];
-                    } else if ([programDict isKindOfClass:[VLCProgram class]]) {
-                        // Already a VLCProgram object
-                        [programs addObject:programDict];
-                    }
+            // CRITICAL FIX: Convert cached dictionary data into a programme store
+            VLCProgramStore *store = [self storeFromCachedEPG:(NSDictionary *)data];
+            if (!store) {
+                if (completion) {
+                    completion(nil, [NSError errorWithDomain:@"VLCEPGManager" 
+                                                       code:4008 
+                                                   userInfo:@{NSLocalizedDescriptionKey: @"Not enough memory for EPG data"}]);
                 }
-                
-                [convertedEpgData setObject:programs forKey:channelId];
-                [programs release];
-            }
-            
-            // CRITICAL FIX: Store the converted EPG data internally and mark as loaded
-            NSUInteger totalPrograms = 0;
-            for (NSString *channelId in convertedEpgData) {
-                NSArray *programs = [convertedEpgData objectForKey:channelId];
-                totalPrograms += programs.count;
+                return;
             }
             
-            NSLog(@"📅 [EPG-CACHE] Storing %lu channels with %lu programs internally", (unsigned long)convertedEpgData.count, (unsigned long)totalPrograms);
-            
-            // CRITICAL DEBUG: Log the first few channel IDs to see what's being loaded
-            NSArray *channelIds = [convertedEpgData allKeys];
-            NSLog(@"📅 [EPG-CACHE] First 10 EPG channel IDs loaded from cache:");
-            for (NSInteger i = 0; i < MIN(10, channelIds.count); i++) {
-                NSString *channelId = channelIds[i];
-                NSArray *programs = [convertedEpgData objectForKey:channelId];
-                NSLog(@"📅 [EPG-CACHE]   %ld: '%@' (%lu programs)", (long)i, channelId, (unsigned long)programs.count);
-            }
-            
-            @synchronized(self.internalEpgData) {
-                [self.internalEpgData removeAllObjects];
-                [self.internalEpgData addEntriesFromDictionary:convertedEpgData];
+            // The cache becomes the only source. Caches written before display names were kept
+            // fall back to the ones of the last parse.
+            NSDictionary *convertedEpgData = nil;
+            @synchronized(self) {
+                NSDictionary *displayNames = cachedNames ?: [_sourceDisplayNames objectForKey:sourceURL] ?: [self currentSnapshot].displayNames;
+                [self replaceSourcesWithStore:store displayNames:displayNames forURL:sourceURL];
+                convertedEpgData = [self publishMergedSourcesDroppingOverlaps:NULL];
             }
             self.internalIsLoaded = YES;
             
-            NSLog(@"📅 [EPG-CACHE] Internal EPG data now contains %lu channels", (unsigned long)self.internalEpgData.count);
+            NSLog(@"📅 [EPG-CACHE] Internal EPG data now contains %lu channels with %lu programs",
+                  (unsigned long)convertedEpgData.count, (unsigned long)store.programCount);
             
             if (completion) {
                 completion(convertedEpgData, nil);
             }
-            [convertedEpgData release];
         } else {
             if (completion) {
                 completion(nil, error);
@@ -395,22 +1142,561 @@
     }];
 }
 
-- (void)forceReloadEPGFromURL:(NSString *)epgURL
-                   completion:(VLCEPGLoadCompletion)completion
-                     progress:(VLCEPGProgressBlock)progressBlock {
+// Programme store of a guide as the cache keeps it; nil when memory runs out
+- (VLCProgramStore *)storeFromCachedEPG:(NSDictionary *)cachedEpgDict {
+    VLCProgramStore *store = [[[VLCProgramStore alloc] init] autorelease];
+    if (!store) {
+        return nil;
+    }
+    // The cache may be hours old; what fell out of the window since is not loaded
+    VLCEPGRetentionWindow *window = [self currentRetentionWindow];
     
-    NSLog(@"🔄 🚀 [EPG] FORCE reloading EPG from URL (bypassing cache): %@", epgURL);
-    NSLog(@"🌐 [EPG] Fresh download initiated - will show real download progress");
+    for (NSString *channelId in cachedEpgDict) {
+        @autoreleasepool {
+            NSArray *programDicts = [cachedEpgDict objectForKey:channelId];
+            uint32_t channel = [store channelIndexForId:channelId];
+            if (channel == VLC_PROGRAM_STORE_NO_CHANNEL) {
+                return nil;
+            }
+            int64_t pastCutoff = [window pastCutoffForChannelId:channelId];
+            
+            for (id programObject in programDicts) {
+                VLCProgramStoreRow row = {
+                    .startTimestamp = VLC_PROGRAM_NO_TIMESTAMP,
+                    .endTimestamp = VLC_PROGRAM_NO_TIMESTAMP
+                };
+                NSString *title = nil;
+                NSString *programDescription = nil;
+                if ([programObject isKindOfClass:[NSDictionary class]]) {
+                    NSDictionary *programDict = (NSDictionary *)programObject;
+                    title = [programDict objectForKey:@"title"];
+                    programDescription = [programDict objectForKey:@"description"];
+                    NSDate *startTime = [programDict objectForKey:@"startTime"];
+                    NSDate *endTime = [programDict objectForKey:@"endTime"];
+                    if ([startTime isKindOfClass:[NSDate class]]) {
+                        row.startTimestamp = VLCEPGTimestampFromDate(startTime);
+                    }
+                    if ([endTime isKindOfClass:[NSDate class]]) {
+                        row.endTimestamp = VLCEPGTimestampFromDate(endTime);
+                    }
+                    
+                    // TIMESHIFT: Restore timeshift properties from cache
+                    row.hasArchive = [[programDict objectForKey:@"hasArchive"] boolValue];
+                    row.archiveDays = [[programDict objectForKey:@"archiveDays"] integerValue];
+                } else if ([programObject isKindOfClass:[VLCProgram class]]) {
+                    // Already a VLCProgram object
+                    VLCProgram *program = (VLCProgram *)programObject;
+                    title = program.title;
+                    programDescription = program.programDescription;
+                    row.startTimestamp = program.startTimestamp;
+                    row.endTimestamp = program.endTimestamp;
+                    row.hasArchive = program.hasArchive;
+                    row.archiveDays = program.archiveDays;
+                } else {
+                    continue;
+                }
+                if (!VLCProgramInRetentionWindow(row.startTimestamp, row.endTimestamp, pastCutoff, window.futureCutoff)) {
+                    continue;
+                }
+                
+                if ([title isKindOfClass:[NSString class]]) {
+                    row.title = title.UTF8String;
+                    row.titleLength = strlen(row.title);
+                }
+                if ([programDescription isKindOfClass:[NSString class]]) {
+                    row.programDescription = programDescription.UTF8String;
+                    row.programDescriptionLength = strlen(row.programDescription);
+                }
+                if (![store appendRow:&row toChannel:channel]) {
+                    return nil;
+                }
+            }
+        }
+    }
+    [store finishAppending];
+    return store;
+}
+
+#pragma mark - EPG Sources
+
+- (void)loadEPGFromSources:(NSArray<VLCEPGSource *> *)sources
+               bypassCache:(BOOL)bypassCache
+                completion:(VLCEPGLoadCompletion)completion
+                  progress:(VLCEPGProgressBlock)progressBlock {
     
-    // Store current EPG URL for cache saving
-    self.currentEPGURL = epgURL;
+    if (![self beginLoadingSources:sources completion:completion]) {
+        return;
+    }
+    if (progressBlock) {
+        progressBlock(0.0, self.internalCurrentStatus);
+    }
+    [self loadSources:sources ofSources:sources bypassCache:bypassCache incremental:NO completion:completion progress:progressBlock];
+}
+
+- (void)refreshEPGSources:(NSArray<VLCEPGSource *> *)sourcesToRefresh
+                ofSources:(NSArray<VLCEPGSource *> *)allSources
+               completion:(VLCEPGLoadCompletion)completion
+                 progress:(VLCEPGProgressBlock)progressBlock {
     
-    // Clear existing data
-    [self clearEPGData];
+    if (![self beginLoadingSources:allSources completion:completion]) {
+        return;
+    }
+    [self loadSources:sourcesToRefresh ofSources:allSources bypassCache:YES incremental:YES completion:completion progress:progressBlock];
+}
+
+- (BOOL)beginLoadingSources:(NSArray<VLCEPGSource *> *)sources completion:(VLCEPGLoadCompletion)completion {
+    NSError *error = nil;
+    if (self.internalIsLoading) {
+        NSLog(@"⚠️ [EPG] Already loading EPG, ignoring request");
+        error = [NSError errorWithDomain:@"VLCEPGManager" 
+                                    code:4001 
+                                userInfo:@{NSLocalizedDescriptionKey: @"EPG loading already in progress"}];
+    } else if (sources.count == 0) {
+        error = [NSError errorWithDomain:@"VLCEPGManager" 
+                                    code:4009 
+                                userInfo:@{NSLocalizedDescriptionKey: @"No EPG sources configured"}];
+    }
     
-    // Download and parse directly (bypass cache)
+    if (error) {
+        if (completion) {
+            completion(nil, error);
+        }
+        return NO;
+    }
+    
+    NSLog(@"📅 [EPG] Starting EPG loading from %lu sources: %@",
+          (unsigned long)sources.count, [[sources valueForKey:@"url"] componentsJoinedByString:@", "]);
     self.internalIsLoading = YES;
-    [self downloadAndParseEPG:epgURL completion:completion progress:progressBlock];
+    self.internalProgress = 0.0;
+    self.internalCurrentStatus = sources.count == 1 ? @"Checking EPG cache..." 
+                                                    : [NSString stringWithFormat:@"📅 Loading %lu EPG sources...", (unsigned long)sources.count];
+    return YES;
+}
+
+// Loads sourcesToLoad concurrently (each from its cache or its own download), and the sources
+// of allSources without a guide in memory from their cache; then merges allSources in order.
+// Incremental loads update the guides in memory instead of replacing them (see
+// -applyLoadedStores:incremental:).
+- (void)loadSources:(NSArray<VLCEPGSource *> *)sourcesToLoad
+          ofSources:(NSArray<VLCEPGSource *> *)allSources
+        bypassCache:(BOOL)bypassCache
+        incremental:(BOOL)incremental
+         completion:(VLCEPGLoadCompletion)completion
+           progress:(VLCEPGProgressBlock)progressBlock {
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSMutableArray<VLCEPGSource *> *sourcesFromCache = [NSMutableArray array];
+    @synchronized(self) {
+        for (VLCEPGSource *source in allSources) {
+            if (![sourcesToLoad containsObject:source] && ![_sourceStores objectForKey:source.url]) {
+                [sourcesFromCache addObject:source];
+            }
+        }
+    }
+    NSArray<VLCEPGSource *> *loading = [sourcesToLoad arrayByAddingObjectsFromArray:sourcesFromCache];
+    // Cold loads show the on-screen channels of the first guide before the rest is parsed
+    VLCEPGSource *prioritySource = [self currentSnapshot].programLists.count == 0 ? loading.firstObject : nil;
+    
+    dispatch_group_t group = dispatch_group_create();
+    NSMutableDictionary<NSString *, VLCProgramStore *> *loaded = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary<NSString *, NSDictionary *> *loadedNames = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary<NSString *, NSDate *> *loadDates = [[NSMutableDictionary alloc] init];
+    NSMutableArray<NSNumber *> *fractions = [NSMutableArray arrayWithCapacity:loading.count];
+    __block NSError *lastError = nil;
+    
+    for (NSUInteger i = 0; i < loading.count; i++) {
+        VLCEPGSource *source = loading[i];
+        [fractions addObject:@0.0f];
+        // Guides stream side by side; progress is their average. Runs on the main queue.
+        VLCEPGProgressBlock sourceProgress = ^(float progress, NSString *status) {
+            [fractions replaceObjectAtIndex:i withObject:@(progress)];
+            float total = 0.0f;
+            for (NSNumber *fraction in fractions) {
+                total += fraction.floatValue;
+            }
+            total /= fractions.count;
+            self.internalProgress = total;
+            if (progressBlock) {
+                progressBlock(total, status);
+            }
+        };
+        
+        dispatch_group_enter(group);
+        [self loadGuideOfSource:source
+                    bypassCache:bypassCache && i < sourcesToLoad.count
+                  priorityGuide:source == prioritySource
+                       progress:sourceProgress
+                     completion:^(VLCProgramStore *store, NSDictionary *displayNames, NSDate *loadDate, NSError *error) {
+            @synchronized (loaded) {
+                if (store) {
+                    [loaded setObject:store forKey:source.url];
+                    [loadDates setObject:loadDate forKey:source.url];
+                    if (displayNames) {
+                        [loadedNames setObject:displayNames forKey:source.url];
+                    }
+                } else {
+                    NSLog(@"❌ [EPG-SOURCES] %@ failed: %@", source.name, error.localizedDescription);
+                    [lastError release];
+                    lastError = [error retain];
+                }
+            }
+            dispatch_group_leave(group);
+        }];
+    }
+    
+    dispatch_group_notify(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        dispatch_release(group);
+        [lastError autorelease];
+        
+        NSDictionary *programLists = nil;
+        VLCProgramStore *store = nil;
+        NSUInteger droppedCount = 0;
+        NSMutableDictionary<NSString *, VLCProgramStore *> *sourceStores = [NSMutableDictionary dictionary];
+        VLCEPGSnapshot *previous = nil;
+        NSSet<NSString *> *changedIds = nil;
+        BOOL guideChannelsAdded = NO;
+        CFAbsoluteTime mergeStart = CFAbsoluteTimeGetCurrent();
+        @synchronized(self) {
+            previous = [self currentSnapshot];
+            BOOL sourcesChanged = [self applyLoadedStores:loaded incremental:incremental];
+            [_sourceDisplayNames addEntriesFromDictionary:loadedNames];
+            
+            // Forget sources that were removed
+            NSMutableArray<NSString *> *order = [NSMutableArray arrayWithCapacity:allSources.count];
+            NSMutableDictionary<NSString *, NSDictionary *> *displayNames = [NSMutableDictionary dictionary];
+            for (VLCEPGSource *source in allSources) {
+                VLCProgramStore *sourceStore = [_sourceStores objectForKey:source.url];
+                if (sourceStore) {
+                    [order addObject:source.url];
+                    [sourceStores setObject:sourceStore forKey:source.url];
+                    NSDictionary *names = [_sourceDisplayNames objectForKey:source.url];
+                    if (names) {
+                        [displayNames setObject:names forKey:source.url];
+                    }
+                }
+            }
+            [_sourceStores setDictionary:sourceStores];
+            [_sourceDisplayNames setDictionary:displayNames];
+            sourcesChanged = sourcesChanged || ![order isEqualToArray:_sourceOrder];
+            [_sourceOrder release];
+            _sourceOrder = [order copy];
+            
+            if (incremental && !sourcesChanged && previous.store) {
+                // Same programmes as the guide in use: nothing to publish, match or redraw
+                programLists = previous.programLists;
+                changedIds = [NSSet set];
+            } else {
+                programLists = [self publishMergedSourcesDroppingOverlaps:&droppedCount];
+                if (programLists && incremental && previous.store) {
+                    changedIds = [[self currentSnapshot].store channelIdsChangedFromStore:previous.store];
+                    for (NSString *channelId in programLists) {
+                        if (![previous.programLists objectForKey:channelId]) {
+                            guideChannelsAdded = YES;
+                            break;
+                        }
+                    }
+                }
+            }
+            if (programLists) {
+                store = [self currentSnapshot].store;
+                programLists = [self currentSnapshot].programLists;
+            }
+        }
+        
+        if (!programLists) {
+            [self failLoadWithError:lastError ?: [NSError errorWithDomain:@"VLCEPGManager" 
+                                                                     code:4008 
+                                                                 userInfo:@{NSLocalizedDescriptionKey: @"Not enough memory for EPG data"}]
+                         completion:completion];
+            [loaded release];
+            [loadedNames release];
+            [loadDates release];
+            return;
+        }
+        NSLog(@"🚀 [EPG-PERF] Loaded %lu of %lu EPG sources and merged %lu in %.2fs (merge %.0f ms): %lu programs from %lu channels, %lu overlapping programs of later sources dropped",
+              (unsigned long)loaded.count, (unsigned long)loading.count, (unsigned long)sourceStores.count,
+              CFAbsoluteTimeGetCurrent() - startTime, (CFAbsoluteTimeGetCurrent() - mergeStart) * 1000.0,
+              (unsigned long)store.programCount, (unsigned long)store.channelCount, (unsigned long)droppedCount);
+        if (changedIds) {
+            NSLog(@"🚀 [EPG-PERF] Incremental refresh: programmes changed on %lu of %lu guide channels%@",
+                  (unsigned long)changedIds.count, (unsigned long)store.channelCount,
+                  guideChannelsAdded ? @", new guide channels need matching" : @"");
+        }
+        self.priorityFallback = nil;
+        if (self.showingPriorityChannels) {
+            self.showingPriorityChannels = NO;
+            NSLog(@"🚀 [EPG-PERF] Full guide published %.2fs after the download started", CFAbsoluteTimeGetCurrent() - startTime);
+        }
+        [self.shortEPGFetcher cancel];
+        
+        // The published generation's own lists: a refresh that changed nothing hands back the
+        // same dictionary as the load before
+        NSDictionary *epgData = programLists;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            for (VLCEPGSource *source in allSources) {
+                VLCProgramStore *sourceStore = [sourceStores objectForKey:source.url];
+                NSDate *loadDate = [loadDates objectForKey:source.url];
+                if (loadDate) {
+                    source.lastLoadDate = loadDate;
+                }
+                source.channelCount = sourceStore.channelCount;
+                source.programCount = sourceStore.programCount;
+            }
+            [loaded release];
+            [loadedNames release];
+            [loadDates release];
+            if (changedIds.count > 0) {
+                NSArray<VLCChannel *> *channels = self.nowNextTable.channels;
+                if (guideChannelsAdded) {
+                    [self matchEPGWithChannels:channels];
+                } else {
+                    [self reattachChannelsFromSnapshot:previous changedChannelIds:changedIds];
+                }
+            }
+            [self completeLoadWithEpgData:epgData programCount:store.programCount channelCount:store.channelCount completion:completion];
+        });
+    });
+}
+
+// completion gets the source's sealed store, its display names (nil from the cache, which has
+// none) and when the guide was fetched from its server. It runs on any thread.
+- (void)loadGuideOfSource:(VLCEPGSource *)source
+              bypassCache:(BOOL)bypassCache
+            priorityGuide:(BOOL)priorityGuide
+                 progress:(VLCEPGProgressBlock)progressBlock
+               completion:(void (^)(VLCProgramStore *store, NSDictionary *displayNames, NSDate *loadDate, NSError *error))completion {
+    
+    if (bypassCache || !self.cacheManager) {
+        [self downloadAndParseEPG:source.url priorityGuide:priorityGuide progress:progressBlock
+                       completion:^(VLCProgramStore *store, NSDictionary *displayNames, NSError *error) {
+            completion(store, displayNames, store ? [NSDate date] : nil, error);
+        }];
+        return;
+    }
+    
+    NSTimeInterval validityHours = source.refreshIntervalHours > 0 ? source.refreshIntervalHours : self.cacheManager.epgCacheValidityHours;
+    [self.cacheManager loadEPGAndDisplayNamesFromCache:source.url validityHours:validityHours
+                                            completion:^(NSDictionary *data, NSDictionary *displayNames, BOOL success, NSError *error) {
+        if (!success || ![data isKindOfClass:[NSDictionary class]]) {
+            NSLog(@"📅 [EPG] 🌐 Cache miss for %@ - downloading fresh EPG from server", source.name);
+            [self loadGuideOfSource:source bypassCache:YES priorityGuide:priorityGuide progress:progressBlock completion:completion];
+            return;
+        }
+        
+        // The refresh schedule runs from when the cache was written, not from app start
+        NSString *cacheFilePath = [self.cacheManager cacheFilePathForType:VLCCacheTypeEPG sourceURL:source.url];
+        NSDate *cacheDate = [[[NSFileManager defaultManager] attributesOfItemAtPath:cacheFilePath error:nil] fileModificationDate];
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            @autoreleasepool {
+                VLCProgramStore *store = [self storeFromCachedEPG:(NSDictionary *)data];
+                NSLog(@"✅ [CACHE] %@: %lu programs of %lu channels from cache",
+                      source.name, (unsigned long)store.programCount, (unsigned long)store.channelCount);
+                completion(store, displayNames, cacheDate ?: [NSDate date], store ? nil : [NSError errorWithDomain:@"VLCEPGManager" 
+                                                                                                     code:4008 
+                                                                                                 userInfo:@{NSLocalizedDescriptionKey: @"Not enough memory for EPG data"}]);
+            }
+        });
+    }];
+}
+
+// Puts the loaded guides in place; returns whether any guide in use changed. An incremental load
+// updates a guide in memory with its newer version, keeping what has aired, and keeps the one in
+// use when no programme differs. Call under @synchronized(self).
+- (BOOL)applyLoadedStores:(NSDictionary<NSString *, VLCProgramStore *> *)loaded incremental:(BOOL)incremental {
+    VLCEPGRetentionWindow *window = incremental ? [self currentRetentionWindow] : nil;
+    BOOL changed = NO;
+    for (NSString *url in loaded) {
+        VLCProgramStore *store = [loaded objectForKey:url];
+        VLCProgramStore *current = [_sourceStores objectForKey:url];
+        if (incremental && current) {
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            VLCProgramStore *updated = [current storeUpdatedWithStore:store keepingProgramsAfter:^int64_t(NSString *channelId) {
+                return [window pastCutoffForChannelId:channelId];
+            } before:window.futureCutoff];
+            if (!updated) {
+                // Out of memory: the newer guide on its own still beats none
+                NSLog(@"⚠️ [EPG] Not enough memory to update %@ in place - replacing it", url);
+                updated = store;
+            }
+            NSUInteger changedCount = [updated channelIdsChangedFromStore:current].count;
+            NSLog(@"🚀 [EPG-PERF] Updated %@ in %.0f ms: programmes changed on %lu of %lu channels",
+                  url, (CFAbsoluteTimeGetCurrent() - start) * 1000.0,
+                  (unsigned long)changedCount, (unsigned long)updated.channelCount);
+            if (changedCount == 0) {
+                continue;
+            }
+            store = updated;
+        }
+        [_sourceStores setObject:store forKey:url];
+        changed = YES;
+    }
+    return changed;
+}
+
+// After an incremental refresh or a retention trim: moves the channels matched to the previous
+// generation onto the lists of the same guide channels in the current one without matching them
+// again (the old store is freed once nothing shows it), and announces only the channels whose
+// programmes changed. Channels whose guide channel is gone lose their programmes. Main thread.
+- (void)reattachChannelsFromSnapshot:(VLCEPGSnapshot *)previous changedChannelIds:(NSSet<NSString *> *)changedIds {
+    VLCEPGSnapshot *current = [self currentSnapshot];
+    NSMapTable *guideChannelIds = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                                        valueOptions:NSPointerFunctionsObjectPersonality];
+    for (NSString *channelId in previous.programLists) {
+        [guideChannelIds setObject:channelId forKey:[previous.programLists objectForKey:channelId]];
+    }
+    
+    // The matched channels, and favorites kept as separate objects among the priority channels
+    NSArray<VLCChannel *> *tableChannels = self.nowNextTable.channels;
+    NSMutableArray<VLCChannel *> *channels = [NSMutableArray arrayWithArray:tableChannels];
+    [channels addObjectsFromArray:self.priorityChannels];
+    NSHashTable *seen = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    NSMutableArray<VLCChannel *> *changed = [NSMutableArray array];
+    NSUInteger moved = 0;
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for (VLCChannel *channel in channels) {
+        if ([seen containsObject:channel]) {
+            continue;
+        }
+        [seen addObject:channel];
+        NSString *channelId = channel.programs ? [guideChannelIds objectForKey:channel.programs] : nil;
+        if (!channelId) {
+            continue;
+        }
+        channel.programs = [current.programLists objectForKey:channelId];
+        moved++;
+        if ([changedIds containsObject:channelId]) {
+            [changed addObject:channel];
+        }
+    }
+    NSLog(@"🚀 [EPG-PERF] Moved %lu channels to the new guide generation in %.1f ms, %lu with changed programmes",
+          (unsigned long)moved, (CFAbsoluteTimeGetCurrent() - start) * 1000.0, (unsigned long)changed.count);
+    
+    [self rebuildNowNextTableWithChannels:tableChannels];
+    if (changed.count > 0) {
+        [[NSNotificationCenter defaultCenter] postNotificationName:VLCNowNextTableDidChangeNotification
+                                                            object:self
+                                                          userInfo:@{@"channels": changed}];
+    }
+}
+
+// Drops every source but this one. Call under @synchronized(self).
+- (void)replaceSourcesWithStore:(VLCProgramStore *)store displayNames:(NSDictionary *)displayNames forURL:(NSString *)url {
+    [_sourceStores removeAllObjects];
+    [_sourceDisplayNames removeAllObjects];
+    [_sourceStores setObject:store forKey:url];
+    if (displayNames) {
+        [_sourceDisplayNames setObject:displayNames forKey:url];
+    }
+    [_sourceOrder release];
+    _sourceOrder = [@[url] retain];
+}
+
+// Publishes the guides of the sources merged in order; returns the programme lists published,
+// nil when there is no guide or no memory. Call under @synchronized(self).
+- (NSDictionary *)publishMergedSourcesDroppingOverlaps:(NSUInteger *)droppedCount {
+    NSMutableArray<VLCProgramStore *> *stores = [NSMutableArray arrayWithCapacity:_sourceOrder.count];
+    NSMutableDictionary *displayNames = [NSMutableDictionary dictionary];
+    for (NSString *url in [_sourceOrder reverseObjectEnumerator]) {
+        // Names of earlier sources win too
+        [stores insertObject:[_sourceStores objectForKey:url] atIndex:0];
+        [displayNames addEntriesFromDictionary:[_sourceDisplayNames objectForKey:url]];
+    }
+    VLCProgramStore *store = stores.count > 0 ? [VLCProgramStore storeMergingStores:stores droppedCount:droppedCount] : nil;
+    if (!store) {
+        return nil;
+    }
+    NSMutableDictionary *programLists = [store programListsByChannel];
+    [self publishProgramLists:programLists store:store displayNames:displayNames];
+    return programLists;
+}
+
+- (void)completeLoadWithEpgData:(NSDictionary *)epgData
+                   programCount:(NSUInteger)programCount
+                   channelCount:(NSUInteger)channelCount
+                     completion:(VLCEPGLoadCompletion)completion {
+    self.internalIsLoaded = YES;
+    self.internalIsLoading = NO;
+    self.internalProgress = 1.0;
+    self.internalCurrentStatus = [NSString stringWithFormat:@"EPG: Complete (%lu programs from %lu channels)", 
+                                  (unsigned long)programCount, (unsigned long)channelCount];
+    
+    if (completion) {
+        completion(epgData, nil);
+    }
+}
+
+- (void)failLoadWithError:(NSError *)error completion:(VLCEPGLoadCompletion)completion {
+    NSLog(@"❌ [EPG] EPG loading failed: %@", error.localizedDescription);
+    // The priority channels' partial guide would otherwise stay up and pass for a loaded one
+    VLCEPGSnapshot *interim = nil;
+    @synchronized(self) {
+        if (self.showingPriorityChannels) {
+            self.showingPriorityChannels = NO;
+            interim = [self currentSnapshot];
+            VLCEPGSnapshot *fallback = self.priorityFallback;
+            [self publishProgramLists:fallback.programLists store:fallback.store displayNames:fallback.displayNames];
+            NSLog(@"📅 [EPG] Withdrew the partial guide of %lu priority channels", (unsigned long)interim.programLists.count);
+        }
+        self.priorityFallback = nil;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (interim) {
+            [self reattachChannelsFromSnapshot:interim changedChannelIds:[NSSet setWithArray:interim.programLists.allKeys]];
+        }
+        self.internalIsLoading = NO;
+        self.internalProgress = 0.0;
+        if (completion) {
+            completion(nil, error);
+        }
+    });
+}
+
+- (void)downloadAndParseEPG:(NSString *)epgURL
+              priorityGuide:(BOOL)priorityGuide
+                   progress:(VLCEPGProgressBlock)progressBlock
+                 completion:(void (^)(VLCProgramStore *store, NSDictionary *displayNames, NSError *error))completion {
+    
+    self.internalCurrentStatus = @"🌐 Downloading fresh EPG from server...";
+    if (progressBlock) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            progressBlock(0.05, self.internalCurrentStatus);
+        });
+    }
+    
+    // Nothing to show until the guide is in: fill the screen from the short guide meanwhile
+    if (priorityGuide) {
+        [self startShortEPGFetch];
+    }
+    
+    // Parse chunks as they arrive instead of downloading the whole guide first: memory stays at
+    // one chunk plus the programmes, and parsing overlaps the download
+    VLCXMLTVParseSession *session = [[VLCXMLTVParseSession alloc] initWithRetentionWindow:[self currentRetentionWindow]
+                                                                            priorityKeys:priorityGuide ? [self priorityChannelKeys] : nil
+                                                                         parallelParsing:[self shouldParseInParallel]];
+    if (priorityGuide) {
+        [self publishPriorityChannelsOfSession:session];
+    }
+    DownloadManager *downloadManager = [[DownloadManager alloc] init];
+    
+    [downloadManager startStreamingFromURL:epgURL
+                           progressHandler:^(int64_t totalBytesReceived, int64_t totalBytesExpected) {
+        // Progress is reported from the data handler together with the programme count
+        session.bytesExpected = totalBytesExpected;
+    }
+                               dataHandler:^(NSData *data) {
+        [self consumeXMLTVData:data session:session progress:progressBlock];
+    }
+                         completionHandler:^(NSError *error) {
+        if (error) {
+            NSLog(@"❌ [EPG] Download failed: %@", error.localizedDescription);
+            completion(nil, nil, error);
+        } else {
+            NSLog(@"✅ [EPG] 🌐 Successfully streamed fresh EPG: %lld bytes", session.bytesReceived);
+            [self finishXMLTVSession:session sourceURL:epgURL completion:completion];
+        }
+        [session release];
+        [downloadManager release];
+    }];
 }
 
 #pragma mark - EPG Processing
@@ -436,498 +1722,460 @@
     NSLog(@"📅 [EPG] Starting XML parsing - %lu bytes", (unsigned long)xmlData.length);
     
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        [self performEPGXMLParsing:xmlData completion:completion progress:progressBlock];
-    });
-}
-
-- (void)performEPGXMLParsing:(NSData *)xmlData
-                  completion:(VLCEPGLoadCompletion)completion
-                    progress:(VLCEPGProgressBlock)progressBlock {
-    
-    // ✅ EPG parsing re-enabled with memory optimizations
-    
-    @autoreleasepool {
-        // Initialize parsing state
-        self.internalCurrentStatus = @"Parsing EPG XML...";
-        self.totalProgramsParsed = 0;
-        self.totalChannelsParsed = 0;
-        self.lastReportedProgress = 0;
-        
-        // Clear existing EPG data
-        [self.internalEpgData removeAllObjects];
-        
-        // Start progress timer
-        dispatch_async(dispatch_get_main_queue(), ^{
-            NSMutableDictionary *userInfo = [[NSMutableDictionary alloc] init];
-            if (progressBlock) {
-                [userInfo setObject:progressBlock forKey:@"progressBlock"];
+        // Same path as a download, with the document as a single chunk
+        VLCXMLTVParseSession *session = [[VLCXMLTVParseSession alloc] initWithRetentionWindow:[self currentRetentionWindow]
+                                                                                priorityKeys:nil
+                                                                             parallelParsing:[self shouldParseInParallel]];
+        session.bytesExpected = xmlData.length;
+        [self consumeXMLTVData:xmlData session:session progress:progressBlock];
+        [self finishXMLTVSession:session sourceURL:nil completion:^(VLCProgramStore *store, NSDictionary *displayNames, NSError *error) {
+            if (!store) {
+                [self failLoadWithError:error completion:completion];
+                return;
             }
-            
-            self.progressTimer = [NSTimer scheduledTimerWithTimeInterval:0.5 
-                                                                 target:self 
-                                                               selector:@selector(reportParsingProgress:) 
-                                                               userInfo:userInfo
-                                                                repeats:YES];
-        });
-        
-        // Create XML parser
-        NSXMLParser *parser = [[NSXMLParser alloc] initWithData:xmlData];
-        parser.delegate = self;
-        
-        // Parse XML
-        BOOL success = [parser parse];
-        
-        // Stop progress timer
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [self.progressTimer invalidate];
-            self.progressTimer = nil;
-        });
-        
-        if (success) {
-            NSLog(@"✅ [EPG] XML parsing completed successfully - %lu programs from %lu channels", 
-                  (unsigned long)self.totalProgramsParsed, (unsigned long)self.totalChannelsParsed);
-            
-            // Save to cache with proper URL
-            if (self.cacheManager && self.currentEPGURL) {
-                @synchronized(self.internalEpgData) {
-                    NSLog(@"💾 [EPG] Saving parsed EPG to cache with URL: %@", self.currentEPGURL);
-                    [self.cacheManager saveEPGToCache:[self.internalEpgData copy] 
-                                            sourceURL:self.currentEPGURL
-                                           completion:^(BOOL success, NSError *error) {
-                        if (success) {
-                            NSLog(@"✅ [EPG] EPG successfully cached");
-                        } else {
-                            NSLog(@"❌ [EPG] Failed to cache EPG: %@", error.localizedDescription);
-                        }
-                    }];
-                }
+            // The document replaces every source
+            NSDictionary *epgData = nil;
+            @synchronized(self) {
+                [self replaceSourcesWithStore:store displayNames:displayNames forURL:@""];
+                epgData = [[[self publishMergedSourcesDroppingOverlaps:NULL] copy] autorelease];
             }
-            
-            dispatch_async(dispatch_get_main_queue(), ^{
-                self.internalIsLoaded = YES;
-                self.internalIsLoading = NO;
-                self.internalProgress = 1.0;
-                self.internalCurrentStatus = [NSString stringWithFormat:@"EPG: Complete (%lu programs from %lu channels)", 
-                                              (unsigned long)self.totalProgramsParsed, (unsigned long)self.totalChannelsParsed];
-                
-                if (completion) {
-                    @synchronized(self.internalEpgData) {
-                        completion([self.internalEpgData copy], nil);
-                    }
-                }
-            });
-            
-        } else {
-            NSError *parseError = parser.parserError;
-            NSLog(@"❌ [EPG] XML parsing failed: %@", parseError.localizedDescription);
-            
             dispatch_async(dispatch_get_main_queue(), ^{
-                self.internalIsLoading = NO;
-                self.internalProgress = 0.0;
-                
-                if (completion) {
-                    completion(nil, parseError);
-                }
+                [self completeLoadWithEpgData:epgData programCount:store.programCount channelCount:store.channelCount completion:completion];
             });
-        }
-    }
+        }];
+        [session release];
+    });
 }
-
-- (void)reportParsingProgress:(NSTimer *)timer {
-    NSDictionary *userInfo = timer.userInfo;
-    id progressBlockObj = [userInfo objectForKey:@"progressBlock"];
-    
-    if ([progressBlockObj isKindOfClass:[NSNull class]]) return;
-    
-    VLCEPGProgressBlock progressBlock = (VLCEPGProgressBlock)progressBlockObj;
+
+// Runs on the download delegate queue, which is serial, so chunks arrive in order
+- (void)consumeXMLTVData:(NSData *)data
+                 session:(VLCXMLTVParseSession *)session
+                progress:(VLCEPGProgressBlock)progressBlock {
     
-    // More accurate progress estimation: download (0.05-0.3) + parsing (0.3-1.0)
-    float parsingProgress = MIN(1.0, (float)self.totalProgramsParsed / 80000.0);
-    float estimatedProgress = 0.3 + (0.7 * parsingProgress);
-    self.internalProgress = estimatedProgress;
+    const CFAbsoluteTime PROGRESS_INTERVAL = 0.5;
     
-    // Estimate total programs based on current progress
-    NSUInteger estimatedTotalPrograms = 0;
-    if (parsingProgress > 0.01) { // Avoid division by very small numbers
-        estimatedTotalPrograms = (NSUInteger)(self.totalProgramsParsed / parsingProgress);
+    @autoreleasepool {
+        [session consumeBytes:(const char *)data.bytes length:data.length];
     }
     
-    if (estimatedTotalPrograms > 0 && estimatedTotalPrograms < 1000000) { // Sanity check
-        self.internalCurrentStatus = [NSString stringWithFormat:@"EPG: Parsing (%lu of %lu)", 
-                                      (unsigned long)self.totalProgramsParsed, (unsigned long)estimatedTotalPrograms];
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    if (now - session.lastProgressTime < PROGRESS_INTERVAL) {
+        return;
+    }
+    session.lastProgressTime = now;
+    
+    float fraction;
+    NSString *status;
+    double receivedMB = session.bytesReceived / 1024.0 / 1024.0;
+    if (session.bytesExpected > 0) {
+        fraction = MIN(1.0f, (float)session.bytesReceived / (float)session.bytesExpected);
+        status = [NSString stringWithFormat:@"📅 Streaming EPG: %.1f MB / %.1f MB • %lu programs",
+                  receivedMB, session.bytesExpected / 1024.0 / 1024.0, (unsigned long)session.programCount];
     } else {
-        self.internalCurrentStatus = [NSString stringWithFormat:@"EPG: Parsing (%lu programs)", 
-                                      (unsigned long)self.totalProgramsParsed];
+        // No Content-Length: assume the guide is at least 50 MB and twice what has arrived so far
+        double estimatedTotalMB = MAX(50.0, receivedMB * 2.0);
+        fraction = (float)(receivedMB / estimatedTotalMB);
+        status = [NSString stringWithFormat:@"📅 Streaming EPG: %.1f MB • %lu programs",
+                  receivedMB, (unsigned long)session.programCount];
     }
-    
-    // Log memory usage along with progress (less frequently to avoid spam)
-    if (self.totalProgramsParsed % 5000 == 0) {
-        [VLCEPGManager logMemoryUsage:self.internalCurrentStatus];
+    float progress = 0.05f + (0.9f * fraction);
+    NSLog(@"%@", status);
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self.internalProgress = progress;
+        self.internalCurrentStatus = status;
+        if (progressBlock) {
+            progressBlock(progress, status);
+        }
+    });
+}
+
+// Seals the session's store and caches it under sourceURL (when given); completion gets the
+// store and the guide's display names, or the error
+- (void)finishXMLTVSession:(VLCXMLTVParseSession *)session
+                 sourceURL:(NSString *)sourceURL
+                completion:(void (^)(VLCProgramStore *store, NSDictionary *displayNames, NSError *error))completion {
+    
+    BOOL complete = [session finish];
+    NSError *parseError = nil;
+    if (session.bytesReceived == 0) {
+        parseError = [NSError errorWithDomain:@"VLCEPGManager" 
+                                    code:4004 
+                                userInfo:@{NSLocalizedDescriptionKey: @"Empty EPG XML data"}];
+    } else if (session.decompressionFailed) {
+        parseError = [NSError errorWithDomain:@"VLCEPGManager" 
+                                    code:4007 
+                                userInfo:@{NSLocalizedDescriptionKey: @"Corrupt compressed EPG data"}];
+    } else if (session.storeFailed) {
+        parseError = [NSError errorWithDomain:@"VLCEPGManager" 
+                                    code:4008 
+                                userInfo:@{NSLocalizedDescriptionKey: @"Not enough memory for EPG data"}];
+    } else if (session.failed) {
+        parseError = [NSError errorWithDomain:@"VLCEPGManager" 
+                                    code:4006 
+                                userInfo:@{NSLocalizedDescriptionKey: @"Malformed EPG XML data"}];
+    }
+    if (parseError) {
+        NSLog(@"❌ [EPG] XML parsing failed: %@", parseError.localizedDescription);
+        completion(nil, nil, parseError);
+        return;
+    }
+    if (!complete) {
+        // Keep everything up to the cut; a guide missing its last programme is still useful
+        NSLog(@"⚠️ [EPG] XMLTV document was cut short - keeping %lu parsed programs", (unsigned long)session.programCount);
     }
     
-    if (progressBlock) {
-        progressBlock(estimatedProgress, self.internalCurrentStatus);
+    VLCXMLTVParserStats stats = [session stats];
+    CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - session.startTime;
+    double megabytes = session.bytesReceived / 1024.0 / 1024.0;
+    double decodedMegabytes = session.bytesDecoded / 1024.0 / 1024.0;
+    NSLog(@"✅ [EPG] XML parsing completed successfully - %lu programs from %lu channels (%lu outside the retention window dropped)", 
+          (unsigned long)session.programCount, (unsigned long)session.channelCount, (unsigned long)session.prunedCount);
+    NSLog(@"🚀 [EPG-PERF] Streamed and parsed %.1f MB (%s, %.1f MB of XML) in %.2fs (%.1f MB/s, %.0f programs/s, %llu elements skipped, %.1f MB carried, %lu pieces in parallel) • RSS %luMB, peak %luMB",
+          megabytes, VLCCompressionFormatName(session.compressionFormat), decodedMegabytes, elapsed,
+          elapsed > 0 ? decodedMegabytes / elapsed : 0.0,
+          elapsed > 0 ? session.programCount / elapsed : 0.0,
+          (unsigned long long)stats.skippedElements, stats.carriedBytes / 1024.0 / 1024.0,
+          (unsigned long)session.pieceCount,
+          (unsigned long)([VLCEPGManager getCurrentMemoryUsage] / (1024 * 1024)),
+          (unsigned long)([VLCEPGManager getPeakMemoryUsage] / (1024 * 1024)));
+    
+    VLCProgramStore *store = session.store;
+    [store finishAppending];
+    NSLog(@"💾 [EPG] Programme store: %.1f MB for %lu programs (%.1f bytes per program)",
+          store.bytesAllocated / 1024.0 / 1024.0, (unsigned long)store.programCount,
+          store.programCount > 0 ? (double)store.bytesAllocated / store.programCount : 0.0);
+    
+    // The cache keeps this source's own guide; merging happens again on every load
+    if (self.cacheManager && sourceURL.length > 0) {
+        NSLog(@"💾 [EPG] Saving parsed EPG to cache with URL: %@", sourceURL);
+        [self.cacheManager saveEPGToCache:[store programListsByChannel] 
+                             displayNames:[[session.displayNames copy] autorelease]
+                                sourceURL:sourceURL
+                               completion:^(BOOL success, NSError *error) {
+            if (success) {
+                NSLog(@"✅ [EPG] EPG successfully cached");
+            } else {
+                NSLog(@"❌ [EPG] Failed to cache EPG: %@", error.localizedDescription);
+            }
+        }];
     }
+    
+    completion(store, session.displayNames, nil);
 }
 
-#pragma mark - NSXMLParserDelegate
+#pragma mark - Priority Channels
 
-- (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)elementName 
-  namespaceURI:(NSString *)namespaceURI 
- qualifiedName:(NSString *)qName 
-    attributes:(NSDictionary<NSString *, NSString *> *)attributeDict {
-    
-    [self.currentElementContent setString:@""];
-    
-    if ([elementName isEqualToString:@"programme"]) {
-        // Start new program - use minimal VLCProgram with delayed property assignment
-        self.currentProgram = [[VLCProgram alloc] init];
-        
-        // Extract and store only the channel ID immediately
-        self.currentChannelId = [attributeDict objectForKey:@"channel"];
-        if (self.currentChannelId) {
-            self.currentProgram.channelId = self.currentChannelId;
-        }
-        
-        // Store raw time strings in temporary properties to avoid NSDate parsing overhead
-        self.currentStartTimeStr = [attributeDict objectForKey:@"start"];
-        self.currentStopTimeStr = [attributeDict objectForKey:@"stop"];
-        
-    } else if ([elementName isEqualToString:@"channel"]) {
-        // Start new channel
-        self.currentChannelId = [attributeDict objectForKey:@"id"];
-        
-        // Initialize program array for this channel if needed
-        if (self.currentChannelId) {
-            @synchronized(self.internalEpgData) {
-                if (![self.internalEpgData objectForKey:self.currentChannelId]) {
-                    [self.internalEpgData setObject:[[NSMutableArray alloc] init] forKey:self.currentChannelId];
-                }
+- (void)setPriorityChannels:(NSArray<VLCChannel *> *)channels {
+    self.priorityChannels = channels;
+}
+
+// Normalized tvg-ids, tvg-names and names, as the guide may know the channel by any of them
+- (NSSet *)priorityChannelKeys {
+    NSArray<VLCChannel *> *channels = self.priorityChannels;
+    if (channels.count == 0) {
+        return nil;
+    }
+    NSMutableSet *keys = [NSMutableSet setWithCapacity:channels.count * 3];
+    for (VLCChannel *channel in channels) {
+        for (NSString *name in @[channel.channelId ?: @"", channel.tvgName ?: @"", channel.name ?: @""]) {
+            NSString *key = VLCEPGRetentionKey(name);
+            if (key) {
+                [keys addObject:key];
             }
         }
     }
+    return keys;
 }
 
-- (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string {
-    [self.currentElementContent appendString:string];
-}
-
-- (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName 
-  namespaceURI:(NSString *)namespaceURI 
- qualifiedName:(NSString *)qName {
-    
-    NSString *content = [self.currentElementContent stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-    
-    if ([elementName isEqualToString:@"title"] && self.currentProgram) {
-        // Store directly in VLCProgram object
-        if (content && content.length > 0) {
-            self.currentProgram.title = content;
-        }
-        
-    } else if ([elementName isEqualToString:@"desc"] && self.currentProgram) {
-        // Store directly in VLCProgram object
-        if (content && content.length > 0) {
-            self.currentProgram.programDescription = content;
+// Cold loads only: a partial generation would hide a full one until the download ends
+- (void)publishPriorityChannelsOfSession:(VLCXMLTVParseSession *)session {
+    NSArray<VLCChannel *> *channels = self.priorityChannels;
+    if (channels.count == 0) {
+        return;
+    }
+    CFAbsoluteTime start = session.startTime;
+    __block BOOL shownAny = NO;
+    session.priorityHandler = ^(VLCProgramStore *store, NSDictionary *displayNames) {
+        if (!shownAny) {
+            shownAny = YES;
+            NSLog(@"🚀 [EPG-PERF] Priority channels: first %lu guide channels complete %.2fs after the download started",
+                  (unsigned long)store.channelCount, CFAbsoluteTimeGetCurrent() - start);
         }
-        
-    } else if ([elementName isEqualToString:@"programme"] && self.currentProgram) {
-        // Finalize current program - parse dates only when completing the program
-        if (self.currentChannelId && self.currentProgram.title && self.currentProgram.title.length > 0) {
-            @autoreleasepool {
-                // Parse dates only when finalizing
-                if (self.currentStartTimeStr) {
-                    self.currentProgram.startTime = [self parseXMLTVTime:self.currentStartTimeStr];
-                }
-                
-                if (self.currentStopTimeStr) {
-                    self.currentProgram.endTime = [self parseXMLTVTime:self.currentStopTimeStr];
-                }
-                
-                // Ensure description is not nil
-                if (!self.currentProgram.programDescription) {
-                    self.currentProgram.programDescription = @"";
-                }
-                
-                @synchronized(self.internalEpgData) {
-                    NSMutableArray *channelPrograms = [self.internalEpgData objectForKey:self.currentChannelId];
-                    if (!channelPrograms) {
-                        channelPrograms = [[NSMutableArray alloc] init];
-                        [self.internalEpgData setObject:channelPrograms forKey:self.currentChannelId];
-                        // Only count channel once when first program is added
-                        self.totalChannelsParsed++;
-                    }
-                    
-                    [channelPrograms addObject:self.currentProgram];
-                    self.totalProgramsParsed++;
-                }
+        @synchronized(self) {
+            if (!self.showingPriorityChannels) {
+                self.priorityFallback = [self currentSnapshot];
+                self.showingPriorityChannels = YES;
             }
+            [self publishProgramLists:[store programListsByChannel] store:store displayNames:displayNames];
         }
-        
-        // Clean up temporary properties and release current program
-        [self.currentProgram release];
-        self.currentProgram = nil;
-        self.currentStartTimeStr = nil;
-        self.currentStopTimeStr = nil;
-        
-    } else if ([elementName isEqualToString:@"channel"]) {
-        // End of channel - don't log individual channels
-        self.currentChannelId = nil;
-    }
+        [self matchEPGWithChannels:channels priorityChannels:nil];
+    };
+}
+
+#pragma mark - Short EPG
+
+- (void)setShortEPGAccount:(NSDictionary<NSString *, NSString *> *)account channels:(NSArray<VLCChannel *> *)channels {
+    self.shortEPGAccount = account;
+    self.shortEPGChannels = channels;
 }
 
-- (void)parser:(NSXMLParser *)parser parseErrorOccurred:(NSError *)parseError {
-    NSLog(@"❌ [EPG] XML parse error: %@", parseError.localizedDescription);
+- (void)startShortEPGFetch {
+    NSDictionary *account = self.shortEPGAccount;
+    NSArray<VLCChannel *> *channels = self.shortEPGChannels;
+    if (!account || channels.count == 0 || [self currentSnapshot].programLists.count > 0) {
+        return;
+    }
+    VLCShortEPGFetcher *fetcher = [[[VLCShortEPGFetcher alloc] initWithAccount:account] autorelease];
+    if (!fetcher) {
+        return;
+    }
+    [self.shortEPGFetcher cancel];
+    self.shortEPGFetcher = fetcher;
+    
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    __block BOOL shownAny = NO;
+    __block NSUInteger attached = 0;
+    [fetcher fetchChannels:channels batchHandler:^BOOL(NSArray<VLCChannel *> *batchChannels, NSArray<NSArray<VLCProgram *> *> *programLists) {
+        // The full guide was published meanwhile; matching takes it from here
+        if ([self currentSnapshot].programLists.count > 0 && !self.showingPriorityChannels) {
+            return NO;
+        }
+        NSMutableArray<VLCChannel *> *changed = [NSMutableArray arrayWithCapacity:batchChannels.count];
+        for (NSUInteger i = 0; i < batchChannels.count; i++) {
+            VLCChannel *channel = batchChannels[i];
+            NSArray<VLCProgram *> *programs = programLists[i];
+            if (programs.count > 0 && channel.programs.count == 0) {
+                channel.programs = programs;
+                [changed addObject:channel];
+            }
+        }
+        if (changed.count == 0) {
+            return YES;
+        }
+        attached += changed.count;
+        if (!shownAny) {
+            shownAny = YES;
+            NSLog(@"🚀 [EPG-PERF] Short EPG: first now/next on %lu channels %.2fs after the guide download started",
+                  (unsigned long)changed.count, CFAbsoluteTimeGetCurrent() - start);
+        }
+        [[NSNotificationCenter defaultCenter] postNotificationName:VLCNowNextTableDidChangeNotification
+                                                            object:self
+                                                          userInfo:@{@"channels": changed}];
+        return YES;
+    } completion:^(NSUInteger channelsWithPrograms) {
+        NSLog(@"📅 [SHORT-EPG] Done in %.2fs: %lu channels had a short guide, %lu shown before the full guide",
+              CFAbsoluteTimeGetCurrent() - start, (unsigned long)channelsWithPrograms, (unsigned long)attached);
+        if (self.shortEPGFetcher == fetcher) {
+            self.shortEPGFetcher = nil;
+        }
+    }];
 }
 
 #pragma mark - Program Matching
 
 - (void)matchEPGWithChannels:(NSArray<VLCChannel *> *)channels {
+    [self matchEPGWithChannels:channels priorityChannels:nil];
+}
+
+- (void)matchEPGWithChannels:(NSArray<VLCChannel *> *)channels priorityChannels:(NSArray<VLCChannel *> *)priorityChannels {
     if (!channels || channels.count == 0) {
         NSLog(@"⚠️ [EPG] No channels to match EPG with");
         return;
     }
     
-    NSLog(@"📅 [EPG] Matching EPG with %lu channels", (unsigned long)channels.count);
-    
-    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        [self performEPGMatching:channels];
-        
-        // CRITICAL FIX: Notify that EPG matching is complete so UI can update
-        dispatch_async(dispatch_get_main_queue(), ^{
-            NSLog(@"📅 [EPG-MATCH] EPG matching completed - notifying observers");
-            
-            // Post notification that EPG matching is complete
-            [[NSNotificationCenter defaultCenter] postNotificationName:@"VLCEPGMatchingCompleted" 
-                                                                object:self 
-                                                              userInfo:@{@"channels": channels}];
-        });
-    });
-}
-
-- (void)performEPGMatching:(NSArray<VLCChannel *> *)channels {
-    NSUInteger matchedChannels = 0;
-    NSUInteger totalPrograms = 0;
-    NSUInteger channelsWithoutId = 0;
-    NSUInteger channelsWithoutMatch = 0;
-    
-    NSLog(@"📅 [EPG-MATCH] Starting ULTRA-FAST EPG matching for %lu channels", (unsigned long)channels.count);
+    NSLog(@"📅 [EPG] Matching EPG with %lu channels (%lu prioritized)",
+          (unsigned long)channels.count, (unsigned long)priorityChannels.count);
     
-    // ULTRA-PERFORMANCE: Create a snapshot of EPG data once, outside the loop
-    NSDictionary *epgDataSnapshot = nil;
-    @synchronized(self.internalEpgData) {
-        epgDataSnapshot = [self.internalEpgData copy];
-        NSLog(@"📅 [EPG-MATCH] Created EPG snapshot with %lu entries", (unsigned long)epgDataSnapshot.count);
+    // Channels on screen get their programs first; the rest follow in playlist order
+    NSArray<VLCChannel *> *orderedChannels = channels;
+    if (priorityChannels.count > 0) {
+        NSMutableArray<VLCChannel *> *reordered = [NSMutableArray arrayWithCapacity:channels.count];
+        NSHashTable *prioritized = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+        for (VLCChannel *channel in priorityChannels) {
+            [prioritized addObject:channel];
+        }
+        for (VLCChannel *channel in channels) {
+            if ([prioritized containsObject:channel]) {
+                [reordered addObject:channel];
+            }
+        }
+        for (VLCChannel *channel in channels) {
+            if (![prioritized containsObject:channel]) {
+                [reordered addObject:channel];
+            }
+        }
+        orderedChannels = reordered;
     }
     
-    NSUInteger totalChannels = channels.count;
-    NSUInteger batchSize = (totalChannels > 100000) ? 20000 : 5000; // Even larger batches for speed
-    
-    NSLog(@"📅 [EPG-MATCH] Using ULTRA-FAST batch size: %lu for %lu total channels", (unsigned long)batchSize, (unsigned long)totalChannels);
-    
-    for (NSUInteger batchStart = 0; batchStart < totalChannels; batchStart += batchSize) {
-        @autoreleasepool {
-            NSUInteger batchEnd = MIN(batchStart + batchSize, totalChannels);
-            NSLog(@"📅 [EPG-MATCH] ULTRA-FAST batch %lu-%lu of %lu", 
-                  (unsigned long)batchStart, (unsigned long)batchEnd-1, (unsigned long)totalChannels);
+    __block VLCEPGChannelIndex *channelIndex = nil;
+    __block CFAbsoluteTime matchStart = 0;
+    __block NSUInteger matchedChannels = 0;
+    __block NSUInteger totalPrograms = 0;
+    __block NSUInteger channelsWithoutId = 0;
+    __block NSUInteger channelsWithoutMatch = 0;
+    __block NSUInteger matchedById = 0;
+    __block NSUInteger matchedByNormalizedId = 0;
+    __block NSUInteger matchedByTvgName = 0;
+    __block NSUInteger matchedByName = 0;
+    __block NSUInteger matchedFuzzy = 0;
+    // Distinct lists attached; every further channel matching one of them costs a pointer
+    NSHashTable *attachedLists = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    
+    VLCScheduledTask *task = [[VLCScheduledTask alloc] initWithName:@"EPG matching"
+                                                           priority:VLCTaskPriorityNormal
+                                                         totalUnits:orderedChannels.count
+                                                               step:^(NSRange range) {
+        // Taken on the first slice so a queued task sees the newest EPG data
+        if (!channelIndex) {
+            matchStart = CFAbsoluteTimeGetCurrent();
+            channelIndex = [[self currentChannelIndex] retain];
+        }
+        
+        for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+            VLCChannel *channel = orderedChannels[i];
             
-            // ULTRA-PERFORMANCE: Process entire batch with direct dictionary lookups
-            for (NSUInteger i = batchStart; i < batchEnd; i++) {
-                VLCChannel *channel = channels[i];
-                
-                // Quick skip for obvious non-EPG content
-                if (channel.name && ([channel.name rangeOfString:@"2023"].location != NSNotFound || 
-                                   [channel.name rangeOfString:@"2024"].location != NSNotFound ||
-                                   [channel.name rangeOfString:@"Movie"].location != NSNotFound ||
-                                   [channel.name rangeOfString:@"●"].location != NSNotFound)) {
-                    channelsWithoutMatch++;
-                    continue;
-                }
-                
-                // Quick channel ID check
-                if (!channel.channelId || [channel.channelId length] == 0) {
-                    channelsWithoutId++;
-                    continue; // Skip expensive ID generation for large datasets
-                }
-                
-                // DIRECT EPG LOOKUP - no method calls, no synchronized access
-                NSArray *programs = [epgDataSnapshot objectForKey:channel.channelId];
-                if (programs && programs.count > 0) {
-                    channel.programs = [programs mutableCopy];
-                    matchedChannels++;
-                    totalPrograms += programs.count;
-                } else {
-                    channelsWithoutMatch++;
-                }
+            // Quick skip for obvious non-EPG content
+            if (VLCEPGIsUnlikelyLiveChannel(channel.name)) {
+                channelsWithoutMatch++;
+                continue;
             }
-            
-            // Much less frequent progress updates for speed
-            if (batchEnd >= totalChannels || (batchEnd % 100000 == 0)) {
-                dispatch_async(dispatch_get_main_queue(), ^{
-                    NSLog(@"📅 [EPG-MATCH] ULTRA-FAST progress: %lu/%lu channels (%lu matched)", 
-                          (unsigned long)batchEnd, (unsigned long)totalChannels, (unsigned long)matchedChannels);
-                    [[NSNotificationCenter defaultCenter] postNotificationName:@"VLCEPGMatchingProgress" 
-                                                                        object:self 
-                                                                      userInfo:@{
-                        @"processed": @(batchEnd),
-                        @"total": @(totalChannels),
-                        @"matched": @(matchedChannels)
-                    }];
-                });
+            if (channel.channelId.length == 0) {
+                channelsWithoutId++;    // Still matched by name below
             }
             
-            // No yielding for maximum speed
-        }
-    }
-    
-    // Only log summary, not individual channels
-    NSLog(@"📊 [EPG-MATCH] Results: %lu/%lu channels matched (%lu programs total)", 
-          (unsigned long)matchedChannels, (unsigned long)channels.count, (unsigned long)totalPrograms);
-    if (channelsWithoutId > 0 || channelsWithoutMatch > 0) {
-        //NSLog(@"📊 [EPG-MATCH] Issues: %lu channels without ID, %lu channels without EPG match", 
-        //      (unsigned long)channelsWithoutId, (unsigned long)channelsWithoutMatch);
-    }
-    
-    // CRITICAL: Log EPG data availability for troubleshooting
-    NSUInteger totalEPGPrograms = 0;
-    for (NSString *channelId in self.internalEpgData) {
-        NSArray *programs = [self.internalEpgData objectForKey:channelId];
-        if ([programs isKindOfClass:[NSArray class]]) {
-            totalEPGPrograms += programs.count;
+            // tvg-id, then tvg-name, then the name; exact before fuzzy
+            VLCEPGMatchKind matchKind = VLCEPGMatchNone;
+            NSArray *programs = [channelIndex programsForChannel:channel matchKind:&matchKind];
+            if (!programs) {
+                channelsWithoutMatch++;
+                continue;
+            }
+            // Attached, not copied: guide lists are immutable slices of the store, shared by
+            // every channel matching the same guide channel (copy only copies mutable arrays)
+            programs = [[programs copy] autorelease];
+            channel.programs = programs;
+            [attachedLists addObject:programs];
+            matchedChannels++;
+            totalPrograms += programs.count;
+            switch (matchKind) {
+                case VLCEPGMatchChannelId: matchedById++; break;
+                case VLCEPGMatchNormalizedId: matchedByNormalizedId++; break;
+                case VLCEPGMatchTvgName: matchedByTvgName++; break;
+                case VLCEPGMatchName: matchedByName++; break;
+                case VLCEPGMatchFuzzy: matchedFuzzy++; break;
+                case VLCEPGMatchNone: break;
+            }
         }
-    }
-    //NSLog(@"📊 [EPG-MATCH] EPG data available: %lu channel entries, %lu total programs", 
-    //      (unsigned long)self.internalEpgData.count, (unsigned long)totalEPGPrograms);
+    }];
     
-    // ENHANCED DEBUG: Always show detailed matching info when fewer than expected channels match
-    if (matchedChannels < channels.count * 0.3 && channels.count > 50) { // Less than 30% match rate
-        //NSLog(@"🔍 [EPG-MATCH] DEBUGGING: Poor match rate (%.1f%%) - investigating...", 
-        //      (float)matchedChannels / channels.count * 100.0);
+    // Progress is rate-limited by the scheduler, not tied to a batch size
+    task.progressBlock = ^(NSUInteger completedUnits, NSUInteger totalUnits) {
+        [[NSNotificationCenter defaultCenter] postNotificationName:@"VLCEPGMatchingProgress" 
+                                                            object:self 
+                                                          userInfo:@{
+            @"processed": @(completedUnits),
+            @"total": @(totalUnits),
+            @"matched": @(matchedChannels)
+        }];
+    };
+    
+    task.completionBlock = ^(VLCScheduledTask *finishedTask) {
+        [channelIndex release];
+        channelIndex = nil;
         
-        // Sample first 10 channels to see what's happening
-        for (NSInteger i = 0; i < MIN(10, channels.count); i++) {
-            VLCChannel *channel = channels[i];
-            NSArray *foundPrograms = [self findProgramsForChannel:channel];
-            //NSLog(@"🔍 [EPG-MATCH] Channel %ld: name='%@' id='%@' -> %lu programs", 
-            //      (long)i, channel.name ?: @"nil", channel.channelId ?: @"nil", (unsigned long)foundPrograms.count);
+        NSLog(@"📊 [EPG-MATCH] Results: %lu/%lu channels matched in %.2fs (%lu programs total, %lu without ID, %lu without match)", 
+              (unsigned long)matchedChannels, (unsigned long)finishedTask.totalUnits,
+              matchStart > 0 ? CFAbsoluteTimeGetCurrent() - matchStart : 0.0, (unsigned long)totalPrograms,
+              (unsigned long)channelsWithoutId, (unsigned long)channelsWithoutMatch);
+        NSLog(@"📊 [EPG-MATCH] Matched by tvg-id %lu, normalized tvg-id %lu, tvg-name %lu, name %lu, fuzzy %lu",
+              (unsigned long)matchedById, (unsigned long)matchedByNormalizedId, (unsigned long)matchedByTvgName,
+              (unsigned long)matchedByName, (unsigned long)matchedFuzzy);
+        NSLog(@"📊 [EPG-MATCH] %lu matched channels share %lu guide lists",
+              (unsigned long)matchedChannels, (unsigned long)attachedLists.count);
+        [attachedLists removeAllObjects];
+        if (finishedTask.isCancelled) {
+            return;
         }
         
-        // Also log first few EPG entries
-        NSArray *epgKeys = [self.internalEpgData allKeys];
-        //NSLog(@"🔍 [EPG-MATCH] EPG entries available: %lu", (unsigned long)epgKeys.count);
-        for (NSInteger i = 0; i < MIN(10, epgKeys.count); i++) {
-            NSString *epgKey = epgKeys[i];
-            NSArray *programs = [self.internalEpgData objectForKey:epgKey];
-            //NSLog(@"🔍 [EPG-MATCH] EPG key %ld: '%@' (%lu programs)", 
-            //      (long)i, epgKey, (unsigned long)programs.count);
-        }
-    }
+        [self rebuildNowNextTableWithChannels:channels];
+        
+        // CRITICAL FIX: Notify that EPG matching is complete so UI can update
+        NSLog(@"📅 [EPG-MATCH] EPG matching completed - notifying observers");
+        [[NSNotificationCenter defaultCenter] postNotificationName:@"VLCEPGMatchingCompleted" 
+                                                            object:self 
+                                                          userInfo:@{@"channels": channels}];
+    };
+    
+    [[VLCTaskScheduler sharedScheduler] addTask:task];
+    [task release];
 }
 
-- (NSArray<VLCProgram *> *)findProgramsForChannel:(VLCChannel *)channel {
-    if (!channel.channelId || [channel.channelId length] == 0) return nil;
-    
-    // PERFORMANCE: Use direct access for large datasets to avoid copying overhead
-    NSArray *programs = nil;
-    @synchronized(self.internalEpgData) {
-        // Try exact match first (most common case)
-        programs = [self.internalEpgData objectForKey:channel.channelId];
-        if (programs && programs.count > 0) {
-            return programs;
-        }
-    }
-    
-    // PERFORMANCE: Skip fuzzy matching for large datasets to improve speed
-    // For datasets over 100k channels, exact matching only
-    @synchronized(self.internalEpgData) {
-        if (self.internalEpgData.count > 100000) {
-            return nil; // Skip fuzzy matching for very large datasets
-        }
-    }
-    
-    // Skip fuzzy matching for channels that clearly won't match (movies, shows, etc.)
-    if (channel.name && ([channel.name containsString:@"(2023)"] || 
-                        [channel.name containsString:@"(2024)"] ||
-                        [channel.name containsString:@"(2022)"] ||
-                        [channel.name containsString:@"Movie"] ||
-                        [channel.name containsString:@"Film"] ||
-                        [channel.name containsString:@"●"] ||
-                        [channel.name hasPrefix:@"◦"] ||
-                        [channel.name hasPrefix:@"▶"])) {
-        return nil; // Don't waste time on fuzzy matching for movies/shows
-    }
-    
-    // Optimized fuzzy matching with channel name (for smaller datasets only)
-    if (channel.name && [channel.name length] > 3) { // Only try for reasonable names
-        NSString *normalizedChannelName = [self normalizeChannelName:channel.name];
-        
-        // Use synchronized access for thread safety during enumeration
-        @synchronized(self.internalEpgData) {
-            // Limit fuzzy search to first 1000 EPG entries for performance
-            NSArray *epgKeys = [self.internalEpgData allKeys];
-            NSUInteger maxFuzzySearch = MIN(1000, epgKeys.count);
-            
-            for (NSUInteger j = 0; j < maxFuzzySearch; j++) {
-                NSString *epgChannelId = epgKeys[j];
-                
-                // Skip empty or invalid EPG IDs
-                if (!epgChannelId || [epgChannelId length] == 0 || [epgChannelId isEqualToString:@"0"]) {
-                    continue;
-                }
-                
-                NSArray *epgPrograms = [self.internalEpgData objectForKey:epgChannelId];
-                if (!epgPrograms || epgPrograms.count == 0) {
-                    continue; // Skip EPG entries with no programs
-                }
-                
-                NSString *normalizedEpgId = [self normalizeChannelName:epgChannelId];
-                
-                // More selective fuzzy matching
-                if ([normalizedChannelName isEqualToString:normalizedEpgId] ||
-                    ([normalizedChannelName length] > 5 && [normalizedEpgId containsString:normalizedChannelName]) ||
-                    ([normalizedEpgId length] > 5 && [normalizedChannelName containsString:normalizedEpgId])) {
-                    
-                    return epgPrograms;
-                }
-            }
-        }
-    }
-    
-    return nil;
+// The channel index of the current generation, built on first use
+- (VLCEPGChannelIndex *)currentChannelIndex {
+    return [[self currentSnapshot] channelIndex];
 }
 
-- (NSString *)normalizeChannelName:(NSString *)name {
-    if (!name) return @"";
-    
-    // Convert to lowercase and remove common prefixes/suffixes
-    NSString *normalized = [name lowercaseString];
-    normalized = [normalized stringByReplacingOccurrencesOfString:@" hd" withString:@""];
-    normalized = [normalized stringByReplacingOccurrencesOfString:@" fhd" withString:@""];
-    normalized = [normalized stringByReplacingOccurrencesOfString:@" 4k" withString:@""];
-    normalized = [normalized stringByReplacingOccurrencesOfString:@"." withString:@""];
-    normalized = [normalized stringByReplacingOccurrencesOfString:@" " withString:@""];
-    
-    return normalized;
+// Same resolution as EPG matching: tvg-id, then tvg-name, then the name, exact before fuzzy
+- (NSArray<VLCProgram *> *)findProgramsForChannel:(VLCChannel *)channel {
+    if (!channel || VLCEPGIsUnlikelyLiveChannel(channel.name)) return nil;
+    return [[self currentChannelIndex] programsForChannel:channel matchKind:NULL];
 }
 
 #pragma mark - Program Access
 
+// adjustTimeForServer: for a timestamp
+- (int64_t)serverTimestampForTimestamp:(int64_t)timestamp {
+    return timestamp - (int64_t)llround(self.timeOffsetHours * 3600.0);
+}
+
 - (VLCProgram *)currentProgramForChannel:(VLCChannel *)channel {
-    if (!channel || !channel.programs || channel.programs.count == 0) {
+    if (!channel) {
         return nil;
     }
     
-    NSDate *now = [self adjustedCurrentTime];
+    VLCProgram *onAir = nil;
+    VLCNowNextTable *table = [NSThread isMainThread] ? self.nowNextTable : nil;
+    if (table && table.timeOffsetHours == self.timeOffsetHours &&
+        [table getNowProgram:&onAir nextProgram:NULL currentProgram:NULL forChannel:channel]) {
+        return onAir;
+    }
     
-    for (VLCProgram *program in channel.programs) {
-        if (program.startTime && program.endTime) {
-            if ([now timeIntervalSinceDate:program.startTime] >= 0 && 
-                [now timeIntervalSinceDate:program.endTime] < 0) {
-                return program;
-            }
-        }
+    int64_t now = (int64_t)floor(CFAbsoluteTimeGetCurrent() + kCFAbsoluteTimeIntervalSince1970);
+    return [channel programAtTimestamp:[self serverTimestampForTimestamp:now]];
+}
+
+- (VLCProgram *)currentProgramForChannel:(VLCChannel *)channel timeOffsetHours:(NSInteger)offsetHours {
+    if (!channel) {
+        return nil;
     }
     
-    return nil;
+    VLCProgram *current = nil;
+    VLCNowNextTable *table = self.nowNextTable;
+    if (table && table.timeOffsetHours == offsetHours &&
+        [table getNowProgram:NULL nextProgram:NULL currentProgram:&current forChannel:channel]) {
+        return current;
+    }
+    return [channel currentProgramWithTimeOffset:offsetHours];
+}
+
+- (NSUInteger)getCurrentPrograms:(VLCProgram **)programs
+                     forChannels:(NSArray *)channels
+                           range:(NSRange)range
+                 timeOffsetHours:(NSInteger)offsetHours {
+    NSUInteger channelCount = channels.count;
+    NSUInteger found = 0;
+    for (NSUInteger i = 0; i < range.length; i++) {
+        NSUInteger channelIndex = range.location + i;
+        id channel = channelIndex < channelCount ? [channels objectAtIndex:channelIndex] : nil;
+        programs[i] = [channel isKindOfClass:[VLCChannel class]]
+            ? [self currentProgramForChannel:channel timeOffsetHours:offsetHours]
+            : nil;
+        if (programs[i]) {
+            found++;
+        }
+    }
+    return found;
 }
 
 - (NSArray<VLCProgram *> *)programsForChannel:(VLCChannel *)channel {
@@ -935,53 +2183,24 @@
 }
 
 - (NSArray<VLCProgram *> *)programsForChannelID:(NSString *)channelID {
-    @synchronized(self.internalEpgData) {
-        return [self.internalEpgData objectForKey:channelID];
-    }
+    return [[self currentSnapshot].programLists objectForKey:channelID];
 }
 
 - (VLCProgram *)programAtTime:(NSDate *)time forChannel:(VLCChannel *)channel {
-    if (!time || !channel || !channel.programs) return nil;
-    
-    NSDate *adjustedTime = [self adjustTimeForServer:time];
+    if (!time || !channel) return nil;
     
-    for (VLCProgram *program in channel.programs) {
-        if (program.startTime && program.endTime) {
-            if ([adjustedTime timeIntervalSinceDate:program.startTime] >= 0 && 
-                [adjustedTime timeIntervalSinceDate:program.endTime] < 0) {
-                return program;
-            }
-        }
-    }
-    
-    return nil;
+    return [channel programAtTimestamp:[self serverTimestampForTimestamp:VLCEPGTimestampFromDate(time)]];
 }
 
 - (NSArray<VLCProgram *> *)programsInTimeRange:(NSDate *)startTime 
                                        endTime:(NSDate *)endTime 
                                     forChannel:(VLCChannel *)channel {
     
-    if (!startTime || !endTime || !channel || !channel.programs) return @[];
-    
-    NSMutableArray *programs = [[NSMutableArray alloc] init];
-    
-    for (VLCProgram *program in channel.programs) {
-        if (program.startTime && program.endTime) {
-            // Check if program overlaps with time range
-            BOOL programStartsInRange = ([program.startTime timeIntervalSinceDate:startTime] >= 0 && 
-                                        [program.startTime timeIntervalSinceDate:endTime] < 0);
-            BOOL programEndsInRange = ([program.endTime timeIntervalSinceDate:startTime] >= 0 && 
-                                      [program.endTime timeIntervalSinceDate:endTime] < 0);
-            BOOL programContainsRange = ([program.startTime timeIntervalSinceDate:startTime] < 0 && 
-                                        [program.endTime timeIntervalSinceDate:endTime] > 0);
-            
-            if (programStartsInRange || programEndsInRange || programContainsRange) {
-                [programs addObject:program];
-            }
-        }
-    }
+    if (!startTime || !endTime || !channel) return @[];
     
-    return [programs copy];
+    // Programmes overlapping [startTime, endTime)
+    return [channel programsFromTimestamp:VLCEPGTimestampFromDate(startTime)
+                              toTimestamp:VLCEPGTimestampFromDate(endTime)];
 }
 
 #pragma mark - Time Utilities
@@ -1006,75 +2225,256 @@
     return [time dateByAddingTimeInterval:offsetSeconds];
 }
 
-- (NSDate *)parseXMLTVTime:(NSString *)xmltvTime {
-    if (!xmltvTime || xmltvTime.length < 14) return nil;
+#pragma mark - Now/Next
+
+- (void)setTimeOffsetHours:(NSTimeInterval)timeOffsetHours {
+    if (_timeOffsetHours == timeOffsetHours) {
+        return;
+    }
+    _timeOffsetHours = timeOffsetHours;
+    NSArray *channels = self.nowNextTable.channels;
+    if (channels) {
+        [self rebuildNowNextTableWithChannels:channels];
+    }
+}
+
+// channels nil drops the table. The table lives on the main thread, so this hops there.
+- (void)rebuildNowNextTableWithChannels:(NSArray<VLCChannel *> *)channels {
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self rebuildNowNextTableWithChannels:channels];
+        });
+        return;
+    }
     
-    // XMLTV format: YYYYMMDDHHmmss +ZZZZ
-    NSString *dateString = [xmltvTime substringToIndex:14];
+    [self.nowNextTable invalidate];
+    self.nowNextTable = nil;
+    if (channels.count == 0) {
+        return;
+    }
     
-    // Use static cached formatter to avoid creating thousands of formatters
-    static NSDateFormatter *cachedFormatter = nil;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        cachedFormatter = [[NSDateFormatter alloc] init];
-        [cachedFormatter setDateFormat:@"yyyyMMddHHmmss"];
-        [cachedFormatter setTimeZone:[NSTimeZone timeZoneWithAbbreviation:@"UTC"]];
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    VLCNowNextTable *table = [[VLCNowNextTable alloc] initWithChannels:channels
+                                                       timeOffsetHours:(NSInteger)self.timeOffsetHours];
+    self.nowNextTable = table;
+    [table release];
+    NSLog(@"🚀 [EPG-PERF] Now/next table for %lu channels built in %.1f ms",
+          (unsigned long)channels.count, (CFAbsoluteTimeGetCurrent() - start) * 1000.0);
+}
+
+#pragma mark - Retention
+
+- (void)setCatchupChannels:(NSArray<VLCChannel *> *)channels {
+    NSMutableDictionary *catchupDays = [NSMutableDictionary dictionary];
+    for (VLCChannel *channel in channels) {
+        if (channel.catchupDays <= 0) {
+            continue;
+        }
+        @autoreleasepool {
+            for (NSString *name in @[channel.channelId ?: @"", channel.tvgName ?: @"", channel.name ?: @""]) {
+                NSString *key = VLCEPGRetentionKey(name);
+                // Channels sharing a name keep the longest catch-up
+                if (key && [[catchupDays objectForKey:key] integerValue] < channel.catchupDays) {
+                    [catchupDays setObject:@(channel.catchupDays) forKey:key];
+                }
+            }
+        }
+    }
+    self.catchupDaysByName = catchupDays;
+}
+
+// The window as of now, in guide time
+- (VLCEPGRetentionWindow *)currentRetentionWindow {
+    int64_t guideTime = [self serverTimestampForTimestamp:VLCEPGTimestampFromDate([NSDate date])];
+    return [[[VLCEPGRetentionWindow alloc] initWithGuideTime:guideTime
+                                                   pastHours:self.pastRetentionHours
+                                                 futureHours:self.futureHorizonHours
+                                                 catchupDays:self.catchupDaysByName] autorelease];
+}
+
+static void VLCEPGManagerSlideRetentionWindow(void *context) {
+    @autoreleasepool {
+        [(VLCEPGManager *)context slideRetentionWindow];
+    }
+}
+
+- (void)startRetentionTimer {
+    _retentionTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0,
+                                             dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0));
+    if (!_retentionTimer) {
+        return;
+    }
+    dispatch_set_context(_retentionTimer, self);
+    dispatch_source_set_event_handler_f(_retentionTimer, VLCEPGManagerSlideRetentionWindow);
+    dispatch_source_set_timer(_retentionTimer,
+                              dispatch_walltime(NULL, (int64_t)(VLCEPGRetentionInterval * NSEC_PER_SEC)),
+                              (uint64_t)(VLCEPGRetentionInterval * NSEC_PER_SEC), 60 * NSEC_PER_SEC);
+    dispatch_resume(_retentionTimer);
+}
+
+// Drops programmes that fell out of the window since the last pass, then moves the matched
+// channels onto the trimmed lists so they let go of the old programmes too. The guide channels
+// are the same, so nothing is matched again.
+- (void)slideRetentionWindow {
+    if (self.internalIsLoading || !self.internalIsLoaded) {
+        return;
+    }
+    VLCEPGSnapshot *previous = nil;
+    VLCEPGSnapshot *current = nil;
+    @synchronized(self) {
+        previous = [self currentSnapshot];
+        if ([self trimToRetentionWindow] == 0) {
+            return;
+        }
+        current = [self currentSnapshot];
+    }
+    NSSet<NSString *> *changedIds = previous.store && current.store
+        ? [current.store channelIdsChangedFromStore:previous.store]
+        : [NSSet setWithArray:current.programLists.allKeys];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self reattachChannelsFromSnapshot:previous changedChannelIds:changedIds];
     });
-    
-    NSDate *date = [cachedFormatter dateFromString:dateString];
-    
-    // Handle timezone offset if present
-    if (xmltvTime.length > 15) {
-        NSString *timezoneString = [xmltvTime substringFromIndex:15];
-        if (timezoneString.length >= 5) {
-            NSString *sign = [timezoneString substringToIndex:1];
-            NSString *hours = [timezoneString substringWithRange:NSMakeRange(1, 2)];
-            NSString *minutes = [timezoneString substringWithRange:NSMakeRange(3, 2)];
-            
-            NSTimeInterval offsetSeconds = ([hours intValue] * 3600) + ([minutes intValue] * 60);
-            if ([sign isEqualToString:@"-"]) {
-                offsetSeconds = -offsetSeconds;
+}
+
+// Returns how many programmes were dropped
+- (NSUInteger)trimToRetentionWindow {
+    VLCEPGRetentionWindow *window = [self currentRetentionWindow];
+    int64_t futureCutoff = window.futureCutoff;
+    NSUInteger removedPrograms = 0;
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    
+    // The trimmed generation is built beside the current one, which readers keep using meanwhile
+    @synchronized(self) {
+        if (_sourceOrder.count > 1) {
+            // Each source is trimmed on its own, then merged again
+            for (NSString *url in _sourceOrder) {
+                VLCProgramStore *sourceStore = [_sourceStores objectForKey:url];
+                VLCProgramStore *trimmed = [sourceStore storeKeepingProgramsAfter:^int64_t(NSString *channelId) {
+                    return [window pastCutoffForChannelId:channelId];
+                } before:futureCutoff];
+                if (trimmed && trimmed.programCount < sourceStore.programCount) {
+                    removedPrograms += sourceStore.programCount - trimmed.programCount;
+                    [_sourceStores setObject:trimmed forKey:url];
+                }
+            }
+            if (removedPrograms > 0) {
+                [self publishMergedSourcesDroppingOverlaps:NULL];
+            }
+            NSLog(@"🧹 [EPG] Retention window trimmed %lu programs of %lu sources in %.1f ms • RSS %luMB",
+                  (unsigned long)removedPrograms, (unsigned long)_sourceOrder.count,
+                  (CFAbsoluteTimeGetCurrent() - start) * 1000.0,
+                  (unsigned long)([VLCEPGManager getCurrentMemoryUsage] / (1024 * 1024)));
+            return removedPrograms;
+        }
+        
+        VLCEPGSnapshot *snapshot = [self currentSnapshot];
+        VLCProgramStore *store = snapshot.store;
+        NSMutableDictionary *programLists = nil;
+        
+        // Store-backed data is rebuilt without the old rows, which frees their memory
+        if (store) {
+            VLCProgramStore *trimmed = [store storeKeepingProgramsAfter:^int64_t(NSString *channelId) {
+                return [window pastCutoffForChannelId:channelId];
+            } before:futureCutoff];
+            if (trimmed) {
+                removedPrograms = store.programCount - trimmed.programCount;
+                store = trimmed;
+                programLists = [trimmed programListsByChannel];
+            }
+        } else {
+            programLists = [NSMutableDictionary dictionaryWithCapacity:snapshot.programLists.count];
+            for (NSString *channelId in snapshot.programLists) {
+                NSArray *programs = [snapshot.programLists objectForKey:channelId];
+                if (![programs isKindOfClass:[NSArray class]]) {
+                    [programLists setObject:programs forKey:channelId];
+                    continue;
+                }
+                int64_t pastCutoff = [window pastCutoffForChannelId:channelId];
+                NSMutableArray *filteredPrograms = [[NSMutableArray alloc] initWithCapacity:programs.count];
+                
+                for (VLCProgram *program in programs) {
+                    if (![program isKindOfClass:[VLCProgram class]] ||
+                        VLCProgramInRetentionWindow(program.startTimestamp, program.endTimestamp, pastCutoff, futureCutoff)) {
+                        [filteredPrograms addObject:program];
+                    } else {
+                        removedPrograms++;
+                    }
+                }
+                
+                [programLists setObject:filteredPrograms forKey:channelId];
+                [filteredPrograms release];
+            }
+        }
+        
+        if (removedPrograms > 0) {
+            [self publishProgramLists:programLists store:store displayNames:snapshot.displayNames];
+            // A single source's store is the published one
+            if (_sourceOrder.count == 1 && store) {
+                [_sourceStores setObject:store forKey:_sourceOrder.firstObject];
             }
-            
-            date = [date dateByAddingTimeInterval:-offsetSeconds]; // Convert to UTC
         }
     }
     
-    return date;
+    NSLog(@"🧹 [EPG] Retention window trimmed %lu programs in %.1f ms • RSS %luMB",
+          (unsigned long)removedPrograms, (CFAbsoluteTimeGetCurrent() - start) * 1000.0,
+          (unsigned long)([VLCEPGManager getCurrentMemoryUsage] / (1024 * 1024)));
+    return removedPrograms;
 }
 
 #pragma mark - Data Management
 
 - (void)clearEPGData {
     NSLog(@"🧹 [EPG] Clearing EPG data");
-    @synchronized(self.internalEpgData) {
-        [self.internalEpgData removeAllObjects];
+    @synchronized(self) {
+        [self forgetSources];
+        [self publishProgramLists:nil store:nil displayNames:nil];
     }
     self.internalIsLoaded = NO;
+    [self rebuildNowNextTableWithChannels:nil];
 }
 
 - (void)updateEPGData:(NSDictionary *)epgData {
     if (epgData) {
-        @synchronized(self.internalEpgData) {
-            self.internalEpgData = [epgData mutableCopy];
+        @synchronized(self) {
+            [self forgetSources];
+            [self publishProgramLists:epgData store:nil displayNames:nil];
         }
         self.internalIsLoaded = YES;
         NSLog(@"📅 [EPG] Updated EPG data with %lu channels", (unsigned long)epgData.count);
     }
 }
 
+// Call under @synchronized(self)
+- (void)forgetSources {
+    [_sourceStores removeAllObjects];
+    [_sourceDisplayNames removeAllObjects];
+    [_sourceOrder release];
+    _sourceOrder = nil;
+}
+
 #pragma mark - Memory Management
 
 - (NSUInteger)estimatedMemoryUsage {
     NSUInteger total = 0;
     
     // Estimate EPG data memory usage
-    @synchronized(self.internalEpgData) {
-        for (NSString *channelId in self.internalEpgData) {
-            NSArray *programs = [self.internalEpgData objectForKey:channelId];
+    VLCEPGSnapshot *snapshot = [self currentSnapshot];
+    total += snapshot.store.bytesAllocated;
+    // With several sources, each keeps its own guide beside the merged one
+    @synchronized(self) {
+        for (NSString *url in _sourceStores) {
+            VLCProgramStore *store = [_sourceStores objectForKey:url];
+            if (store != snapshot.store) {
+                total += store.bytesAllocated;
+            }
+        }
+    }
+    for (NSString *channelId in snapshot.programLists) {
+        NSArray *programs = [snapshot.programLists objectForKey:channelId];
+        if (![programs isKindOfClass:[VLCProgramList class]]) {
             total += programs.count * sizeof(VLCProgram *);
-            total += channelId.length * sizeof(unichar);
         }
+        total += channelId.length * sizeof(unichar);
     }
     
     return total;
@@ -1083,31 +2483,8 @@
 - (void)performMemoryOptimization {
     NSLog(@"🧹 [EPG] Performing memory optimization");
     
-    // Remove old programs (older than 24 hours)
-    NSDate *cutoffDate = [[NSDate date] dateByAddingTimeInterval:-24 * 3600];
-    NSUInteger removedPrograms = 0;
-    
-    @synchronized(self.internalEpgData) {
-        // Create a copy of the keys to avoid mutation during enumeration
-        NSArray *channelIds = [self.internalEpgData allKeys];
-        
-        for (NSString *channelId in channelIds) {
-            NSMutableArray *programs = [self.internalEpgData objectForKey:channelId];
-            if ([programs isKindOfClass:[NSMutableArray class]]) {
-                NSMutableArray *filteredPrograms = [[NSMutableArray alloc] init];
-                
-                for (VLCProgram *program in programs) {
-                    if (program.endTime && [program.endTime timeIntervalSinceDate:cutoffDate] > 0) {
-                        [filteredPrograms addObject:program];
-                    } else {
-                        removedPrograms++;
-                    }
-                }
-                
-                [self.internalEpgData setObject:filteredPrograms forKey:channelId];
-            }
-        }
-    }
+    // Remove programs outside the retention window
+    NSUInteger removedPrograms = [self trimToRetentionWindow];
     
     NSLog(@"🧹 [EPG] Memory optimization completed - removed %lu old programs", (unsigned long)removedPrograms);
 }
@@ -1155,11 +2532,11 @@
 }
 
 - (NSTimeInterval)programDuration:(VLCProgram *)program {
-    if (!program || !program.startTime || !program.endTime) {
+    if (!program || program.startTimestamp == VLC_PROGRAM_NO_TIMESTAMP || program.endTimestamp == VLC_PROGRAM_NO_TIMESTAMP) {
         return 0.0;
     }
     
-    return [program.endTime timeIntervalSinceDate:program.startTime];
+    return (NSTimeInterval)(program.endTimestamp - program.startTimestamp);
 }
 
 #pragma mark - Memory Monitoring
@@ -1177,6 +2554,19 @@
     return 0;
 }
 
++ (NSUInteger)getPeakMemoryUsage {
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
+    kern_return_t kerr = task_info(mach_task_self(),
+                                   MACH_TASK_BASIC_INFO,
+                                   (task_info_t)&info,
+                                   &size);
+    if (kerr == KERN_SUCCESS) {
+        return info.resident_size_max;
+    }
+    return 0;
+}
+
 + (void)logMemoryUsage:(NSString *)context {
     NSUInteger memoryUsage = [self getCurrentMemoryUsage];
     NSUInteger memoryMB = memoryUsage / (1024 * 1024);
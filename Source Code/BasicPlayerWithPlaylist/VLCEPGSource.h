@@ -0,0 +1,34 @@
+//
+//  VLCEPGSource.h
+//  BasicPlayerWithPlaylist
+//
+//  EPG Source - Platform Independent
+//  One XMLTV guide among several merged into one; earlier sources win where guides overlap
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface VLCEPGSource : NSObject
+
+@property (nonatomic, readonly) NSString *url;          // Also the key of its EPG cache
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) NSTimeInterval refreshIntervalHours; // 0 = EPG cache validity
+
+// Runtime state, not persisted
+@property (nonatomic, strong, nullable) NSDate *lastLoadDate;
+@property (nonatomic, assign) NSUInteger channelCount;
+@property (nonatomic, assign) NSUInteger programCount;
+
+- (instancetype)initWithURL:(NSString *)url name:(nullable NSString *)name;
+
+- (BOOL)isDueForRefreshWithDefaultInterval:(NSTimeInterval)defaultIntervalHours;
+
+// User defaults persistence
+- (NSDictionary *)dictionaryRepresentation;
++ (nullable instancetype)sourceWithDictionary:(NSDictionary *)dictionary;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,63 @@
+//
+//  VLCEPGSource.m
+//  BasicPlayerWithPlaylist
+//
+//  EPG Source - Platform Independent
+//  One XMLTV guide among several merged into one; earlier sources win where guides overlap
+//
+
+#import "VLCEPGSource.h"
+
+@implementation VLCEPGSource
+
+- (instancetype)initWithURL:(NSString *)url name:(NSString *)name {
+    self = [super init];
+    if (self) {
+        _url = [url copy];
+        if (name.length > 0) {
+            _name = [name copy];
+        } else {
+            // Guide host is what users recognize, e.g. "epg.example.com"
+            NSString *host = [NSURL URLWithString:url].host;
+            _name = [(host.length > 0 ? host : url) copy];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_url release];
+    [_name release];
+    [_lastLoadDate release];
+    [super dealloc];
+}
+
+- (BOOL)isDueForRefreshWithDefaultInterval:(NSTimeInterval)defaultIntervalHours {
+    if (!self.lastLoadDate) {
+        return YES;
+    }
+    NSTimeInterval intervalHours = self.refreshIntervalHours > 0 ? self.refreshIntervalHours : defaultIntervalHours;
+    return [[NSDate date] timeIntervalSinceDate:self.lastLoadDate] >= intervalHours * 3600.0;
+}
+
+#pragma mark - Persistence
+
+- (NSDictionary *)dictionaryRepresentation {
+    return @{
+        @"url": self.url,
+        @"name": self.name ?: @"",
+        @"refreshIntervalHours": @(self.refreshIntervalHours)
+    };
+}
+
++ (instancetype)sourceWithDictionary:(NSDictionary *)dictionary {
+    NSString *url = [dictionary objectForKey:@"url"];
+    if (![url isKindOfClass:[NSString class]] || url.length == 0) {
+        return nil;
+    }
+    VLCEPGSource *source = [[[VLCEPGSource alloc] initWithURL:url name:[dictionary objectForKey:@"name"]] autorelease];
+    source.refreshIntervalHours = [[dictionary objectForKey:@"refreshIntervalHours"] doubleValue];
+    return source;
+}
+
+@end
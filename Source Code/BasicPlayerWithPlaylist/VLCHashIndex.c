@@ -0,0 +1,164 @@
+//
+//  VLCHashIndex.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable Hash Index - Platform Independent (plain C)
+//  Open-addressing map from 64-bit hashes to 32-bit slots, used for fingerprint lookups
+//
+
+#include "VLCHashIndex.h"
+
+#include <stdlib.h>
+
+struct VLCHashIndex {
+    uint64_t *keys;     // 0 marks an empty bucket
+    uint32_t *values;
+    size_t capacity;    // Power of two
+    size_t count;
+};
+
+#pragma mark - Hashing
+
+uint64_t VLCHashBytes(const void *bytes, size_t length, uint64_t hash) {
+    const unsigned char *cursor = (const unsigned char *)bytes;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= cursor[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Key 0 is the empty marker, so it is folded onto another value
+static inline uint64_t VLCHashIndexNormalizeKey(uint64_t key) {
+    return key ? key : 0x9e3779b97f4a7c15ULL;
+}
+
+// FNV output is weak in the low bits; finalize before masking into a bucket
+static inline size_t VLCHashIndexBucket(uint64_t key, size_t mask) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (size_t)key & mask;
+}
+
+#pragma mark - Lifecycle
+
+static int VLCHashIndexAllocate(VLCHashIndex *index, size_t capacity) {
+    index->keys = calloc(capacity, sizeof(uint64_t));
+    index->values = calloc(capacity, sizeof(uint32_t));
+    if (!index->keys || !index->values) {
+        free(index->keys);
+        free(index->values);
+        index->keys = NULL;
+        index->values = NULL;
+        return 0;
+    }
+    index->capacity = capacity;
+    return 1;
+}
+
+VLCHashIndex *VLCHashIndexCreate(size_t expectedCount) {
+    VLCHashIndex *index = calloc(1, sizeof(VLCHashIndex));
+    if (!index) {
+        return NULL;
+    }
+
+    // Keep the load factor under 0.5
+    size_t capacity = 16;
+    while (capacity < expectedCount * 2) capacity <<= 1;
+
+    if (!VLCHashIndexAllocate(index, capacity)) {
+        free(index);
+        return NULL;
+    }
+    return index;
+}
+
+void VLCHashIndexFree(VLCHashIndex *index) {
+    if (!index) {
+        return;
+    }
+    free(index->keys);
+    free(index->values);
+    free(index);
+}
+
+static int VLCHashIndexGrow(VLCHashIndex *index) {
+    uint64_t *oldKeys = index->keys;
+    uint32_t *oldValues = index->values;
+    size_t oldCapacity = index->capacity;
+
+    if (!VLCHashIndexAllocate(index, oldCapacity * 2)) {
+        index->keys = oldKeys;
+        index->values = oldValues;
+        return 0;
+    }
+
+    size_t mask = index->capacity - 1;
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldKeys[i] == 0) continue;
+        size_t bucket = VLCHashIndexBucket(oldKeys[i], mask);
+        while (index->keys[bucket] != 0) bucket = (bucket + 1) & mask;
+        index->keys[bucket] = oldKeys[i];
+        index->values[bucket] = oldValues[i];
+    }
+
+    free(oldKeys);
+    free(oldValues);
+    return 1;
+}
+
+#pragma mark - Access
+
+uint32_t VLCHashIndexGet(const VLCHashIndex *index, uint64_t key) {
+    if (!index) {
+        return 0;
+    }
+    key = VLCHashIndexNormalizeKey(key);
+    size_t mask = index->capacity - 1;
+    size_t bucket = VLCHashIndexBucket(key, mask);
+    while (index->keys[bucket] != 0) {
+        if (index->keys[bucket] == key) {
+            return index->values[bucket];
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    return 0;
+}
+
+uint32_t *VLCHashIndexSlot(VLCHashIndex *index, uint64_t key) {
+    if (!index) {
+        return NULL;
+    }
+    if ((index->count + 1) * 2 > index->capacity && !VLCHashIndexGrow(index)) {
+        return NULL;
+    }
+
+    key = VLCHashIndexNormalizeKey(key);
+    size_t mask = index->capacity - 1;
+    size_t bucket = VLCHashIndexBucket(key, mask);
+    while (index->keys[bucket] != 0) {
+        if (index->keys[bucket] == key) {
+            return &index->values[bucket];
+        }
+        bucket = (bucket + 1) & mask;
+    }
+
+    index->keys[bucket] = key;
+    index->values[bucket] = 0;
+    index->count++;
+    return &index->values[bucket];
+}
+
+int VLCHashIndexSet(VLCHashIndex *index, uint64_t key, uint32_t value) {
+    uint32_t *slot = VLCHashIndexSlot(index, key);
+    if (!slot) {
+        return 0;
+    }
+    *slot = value;
+    return 1;
+}
+
+size_t VLCHashIndexCount(const VLCHashIndex *index) {
+    return index ? index->count : 0;
+}
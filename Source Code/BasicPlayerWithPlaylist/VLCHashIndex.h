@@ -0,0 +1,47 @@
+//
+//  VLCHashIndex.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable Hash Index - Platform Independent (plain C)
+//  Open-addressing map from 64-bit hashes to 32-bit slots, used for fingerprint lookups
+//
+
+#ifndef VLCHashIndex_h
+#define VLCHashIndex_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// FNV-1a 64 offset basis; pass as the initial hash to VLCHashBytes
+#define VLC_HASH_SEED 0xcbf29ce484222325ULL
+
+typedef struct VLCHashIndex VLCHashIndex;
+
+// FNV-1a over bytes, continuing from hash (chain calls to hash several fields)
+uint64_t VLCHashBytes(const void *bytes, size_t length, uint64_t hash);
+
+// Creates an index sized for expectedCount keys; grows automatically. NULL on allocation failure.
+VLCHashIndex *VLCHashIndexCreate(size_t expectedCount);
+void VLCHashIndexFree(VLCHashIndex *index);
+
+// Value stored for key, or 0 when absent (store index + 1 when 0 is a valid value)
+uint32_t VLCHashIndexGet(const VLCHashIndex *index, uint64_t key);
+
+// Pointer to the value for key, inserting 0 when absent. NULL on allocation failure.
+// The pointer is invalidated by the next insertion.
+uint32_t *VLCHashIndexSlot(VLCHashIndex *index, uint64_t key);
+
+// Inserts or overwrites; returns 0 on allocation failure
+int VLCHashIndexSet(VLCHashIndex *index, uint64_t key, uint32_t value);
+
+size_t VLCHashIndexCount(const VLCHashIndex *index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCHashIndex_h */
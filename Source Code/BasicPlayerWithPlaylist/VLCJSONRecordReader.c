@@ -0,0 +1,524 @@
+//
+//  VLCJSONRecordReader.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable JSON Record Reader - Platform Independent (plain C)
+//  Incrementally reads a top-level JSON array of objects (the shape of every Xtream
+//  player_api catalog) and reports each object's fields as it completes
+//
+
+#include "VLCJSONRecordReader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define VLC_JSON_MAX_DEPTH 64
+#define VLC_JSON_MAX_FIELDS 64     // Fields kept per record; later ones are skipped
+
+// Records are the objects directly inside the top-level array
+#define VLC_JSON_RECORD_DEPTH 2
+
+typedef enum {
+    VLCJSONStateValue,          // Expecting a value (or ']' of an array)
+    VLCJSONStateKey,            // Expecting a key (or '}' of an object)
+    VLCJSONStateColon,
+    VLCJSONStateString,
+    VLCJSONStateEscape,
+    VLCJSONStateUnicode,
+    VLCJSONStateLiteral,
+    VLCJSONStateAfterValue,
+    VLCJSONStateDone,
+    VLCJSONStateError
+} VLCJSONState;
+
+// Offsets rather than pointers: the buffer may move while the record grows
+typedef struct {
+    size_t keyOffset;
+    size_t keyLength;
+    size_t valueOffset;
+    size_t valueLength;
+    VLCJSONValueType type;
+} VLCJSONFieldSlot;
+
+struct VLCJSONRecordReader {
+    VLCJSONRecordHandler handler;
+    void *context;
+    VLCJSONState state;
+    unsigned depth;
+    uint64_t objectBits;        // Bit d-1 is set when the container at depth d is an object
+    int topLevelArray;
+    int stringIsKey;
+    int capturing;              // The current key or value is copied into buffer
+    long currentField;          // Slot of the record field being read, -1 when skipped
+    uint32_t unicode;
+    int unicodeDigits;
+    uint32_t highSurrogate;     // Pending first half of a \u surrogate pair
+    char *buffer;               // Unescaped keys and values of the current record
+    size_t bufferLength;
+    size_t bufferCapacity;
+    VLCJSONFieldSlot slots[VLC_JSON_MAX_FIELDS];
+    size_t slotCount;
+    VLCJSONField fields[VLC_JSON_MAX_FIELDS];
+    size_t recordCount;
+};
+
+#pragma mark - Lifecycle
+
+VLCJSONRecordReader *VLCJSONRecordReaderCreate(VLCJSONRecordHandler handler, void *context) {
+    VLCJSONRecordReader *reader = calloc(1, sizeof(VLCJSONRecordReader));
+    if (!reader) {
+        return NULL;
+    }
+    reader->handler = handler;
+    reader->context = context;
+    reader->state = VLCJSONStateValue;
+    reader->currentField = -1;
+    return reader;
+}
+
+void VLCJSONRecordReaderFree(VLCJSONRecordReader *reader) {
+    if (!reader) {
+        return;
+    }
+    free(reader->buffer);
+    free(reader);
+}
+
+#pragma mark - Record Buffer
+
+static int VLCJSONAppend(VLCJSONRecordReader *reader, const char *bytes, size_t length) {
+    if (reader->bufferLength + length > reader->bufferCapacity) {
+        size_t capacity = reader->bufferCapacity ? reader->bufferCapacity : 1024;
+        while (capacity < reader->bufferLength + length) {
+            capacity *= 2;
+        }
+        char *buffer = realloc(reader->buffer, capacity);
+        if (!buffer) {
+            reader->state = VLCJSONStateError;
+            return 0;
+        }
+        reader->buffer = buffer;
+        reader->bufferCapacity = capacity;
+    }
+    memcpy(reader->buffer + reader->bufferLength, bytes, length);
+    reader->bufferLength += length;
+    return 1;
+}
+
+static void VLCJSONAppendCodepoint(VLCJSONRecordReader *reader, uint32_t codepoint) {
+    char utf8[4];
+    size_t length;
+    if (codepoint < 0x80) {
+        utf8[0] = (char)codepoint;
+        length = 1;
+    } else if (codepoint < 0x800) {
+        utf8[0] = (char)(0xC0 | (codepoint >> 6));
+        utf8[1] = (char)(0x80 | (codepoint & 0x3F));
+        length = 2;
+    } else if (codepoint < 0x10000) {
+        utf8[0] = (char)(0xE0 | (codepoint >> 12));
+        utf8[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (codepoint & 0x3F));
+        length = 3;
+    } else {
+        utf8[0] = (char)(0xF0 | (codepoint >> 18));
+        utf8[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+        utf8[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        utf8[3] = (char)(0x80 | (codepoint & 0x3F));
+        length = 4;
+    }
+    VLCJSONAppend(reader, utf8, length);
+}
+
+// A high surrogate not followed by its low half becomes U+FFFD
+static void VLCJSONFlushSurrogate(VLCJSONRecordReader *reader) {
+    if (reader->highSurrogate) {
+        reader->highSurrogate = 0;
+        if (reader->capturing) {
+            VLCJSONAppendCodepoint(reader, 0xFFFD);
+        }
+    }
+}
+
+static void VLCJSONFinishUnicodeEscape(VLCJSONRecordReader *reader) {
+    uint32_t codepoint = reader->unicode;
+    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+        VLCJSONFlushSurrogate(reader);
+        reader->highSurrogate = codepoint;
+        return;
+    }
+    if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+        if (reader->highSurrogate) {
+            codepoint = 0x10000 + ((reader->highSurrogate - 0xD800) << 10) + (codepoint - 0xDC00);
+            reader->highSurrogate = 0;
+        } else {
+            codepoint = 0xFFFD;
+        }
+    } else {
+        VLCJSONFlushSurrogate(reader);
+    }
+    if (reader->capturing) {
+        VLCJSONAppendCodepoint(reader, codepoint);
+    }
+}
+
+#pragma mark - Structure
+
+static int VLCJSONInRecord(const VLCJSONRecordReader *reader) {
+    return reader->topLevelArray && reader->depth == VLC_JSON_RECORD_DEPTH &&
+           (reader->objectBits >> (VLC_JSON_RECORD_DEPTH - 1) & 1);
+}
+
+static int VLCJSONCurrentIsObject(const VLCJSONRecordReader *reader) {
+    return reader->depth > 0 && (reader->objectBits >> (reader->depth - 1) & 1);
+}
+
+static void VLCJSONOpenContainer(VLCJSONRecordReader *reader, int isObject) {
+    if (reader->depth == 0) {
+        reader->topLevelArray = !isObject;
+    }
+    if (VLCJSONInRecord(reader) && reader->currentField >= 0) {
+        // Nested values (e.g. "backdrop_path": [...]) are skipped
+        reader->slots[reader->currentField].type = VLCJSONValueNested;
+        reader->slots[reader->currentField].valueOffset = reader->bufferLength;
+        reader->slots[reader->currentField].valueLength = 0;
+        reader->currentField = -1;
+    }
+    if (reader->depth >= VLC_JSON_MAX_DEPTH) {
+        reader->state = VLCJSONStateError;
+        return;
+    }
+
+    reader->depth++;
+    if (isObject) {
+        reader->objectBits |= (uint64_t)1 << (reader->depth - 1);
+    } else {
+        reader->objectBits &= ~((uint64_t)1 << (reader->depth - 1));
+    }
+
+    if (VLCJSONInRecord(reader)) {
+        reader->slotCount = 0;
+        reader->bufferLength = 0;
+        reader->currentField = -1;
+    }
+    reader->state = isObject ? VLCJSONStateKey : VLCJSONStateValue;
+}
+
+static void VLCJSONEmitRecord(VLCJSONRecordReader *reader) {
+    for (size_t i = 0; i < reader->slotCount; i++) {
+        const VLCJSONFieldSlot *slot = &reader->slots[i];
+        reader->fields[i].key.bytes = reader->buffer + slot->keyOffset;
+        reader->fields[i].key.length = slot->keyLength;
+        reader->fields[i].value.bytes = reader->buffer + slot->valueOffset;
+        reader->fields[i].value.length = slot->valueLength;
+        reader->fields[i].type = slot->type;
+    }
+    reader->recordCount++;
+    if (reader->handler && !reader->handler(reader->fields, reader->slotCount, reader->context)) {
+        reader->state = VLCJSONStateError;
+    }
+}
+
+static void VLCJSONCloseContainer(VLCJSONRecordReader *reader, int isObject) {
+    if (reader->depth == 0 || VLCJSONCurrentIsObject(reader) != isObject) {
+        reader->state = VLCJSONStateError;
+        return;
+    }
+    int closesRecord = isObject && VLCJSONInRecord(reader);
+    reader->depth--;
+    reader->state = reader->depth == 0 ? VLCJSONStateDone : VLCJSONStateAfterValue;
+    if (closesRecord) {
+        VLCJSONEmitRecord(reader);
+    }
+}
+
+static void VLCJSONBeginValue(VLCJSONRecordReader *reader, VLCJSONValueType type) {
+    reader->capturing = VLCJSONInRecord(reader) && reader->currentField >= 0;
+    if (reader->capturing) {
+        reader->slots[reader->currentField].type = type;
+        reader->slots[reader->currentField].valueOffset = reader->bufferLength;
+    }
+}
+
+static void VLCJSONFinishValue(VLCJSONRecordReader *reader) {
+    if (reader->capturing) {
+        VLCJSONFieldSlot *slot = &reader->slots[reader->currentField];
+        slot->valueLength = reader->bufferLength - slot->valueOffset;
+        reader->capturing = 0;
+    }
+    reader->currentField = -1;
+    reader->state = reader->depth == 0 ? VLCJSONStateDone : VLCJSONStateAfterValue;
+}
+
+static void VLCJSONBeginKey(VLCJSONRecordReader *reader) {
+    reader->stringIsKey = 1;
+    reader->capturing = 0;
+    reader->currentField = -1;
+    if (VLCJSONInRecord(reader) && reader->slotCount < VLC_JSON_MAX_FIELDS) {
+        VLCJSONFieldSlot *slot = &reader->slots[reader->slotCount];
+        memset(slot, 0, sizeof(*slot));
+        slot->type = VLCJSONValueNull;
+        slot->keyOffset = reader->bufferLength;
+        reader->currentField = (long)reader->slotCount++;
+        reader->capturing = 1;
+    }
+    reader->state = VLCJSONStateString;
+}
+
+static void VLCJSONFinishString(VLCJSONRecordReader *reader) {
+    VLCJSONFlushSurrogate(reader);
+    if (reader->stringIsKey) {
+        if (reader->capturing) {
+            VLCJSONFieldSlot *slot = &reader->slots[reader->currentField];
+            slot->keyLength = reader->bufferLength - slot->keyOffset;
+            reader->capturing = 0;
+        }
+        reader->state = VLCJSONStateColon;
+    } else {
+        VLCJSONFinishValue(reader);
+    }
+}
+
+static int VLCJSONIsWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static int VLCJSONIsLiteralByte(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           c == '-' || c == '+' || c == '.';
+}
+
+static int VLCJSONHexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+#pragma mark - Feeding
+
+int VLCJSONRecordReaderFeed(VLCJSONRecordReader *reader, const char *bytes, size_t length) {
+    if (!reader || reader->state == VLCJSONStateError) {
+        return 0;
+    }
+
+    size_t i = 0;
+    while (i < length && reader->state != VLCJSONStateError) {
+        char c = bytes[i];
+
+        switch (reader->state) {
+            case VLCJSONStateValue:
+                if (VLCJSONIsWhitespace(c)) {
+                    i++;
+                } else if (c == '{' || c == '[') {
+                    VLCJSONOpenContainer(reader, c == '{');
+                    i++;
+                } else if (c == ']') {
+                    VLCJSONCloseContainer(reader, 0);
+                    i++;
+                } else if (c == '"') {
+                    reader->stringIsKey = 0;
+                    VLCJSONBeginValue(reader, VLCJSONValueString);
+                    reader->state = VLCJSONStateString;
+                    i++;
+                } else if (c == '-' || (c >= '0' && c <= '9')) {
+                    VLCJSONBeginValue(reader, VLCJSONValueNumber);
+                    reader->state = VLCJSONStateLiteral;
+                } else if (c == 't' || c == 'f') {
+                    VLCJSONBeginValue(reader, VLCJSONValueBool);
+                    reader->state = VLCJSONStateLiteral;
+                } else if (c == 'n') {
+                    VLCJSONBeginValue(reader, VLCJSONValueNull);
+                    reader->state = VLCJSONStateLiteral;
+                } else {
+                    reader->state = VLCJSONStateError;
+                }
+                break;
+
+            case VLCJSONStateKey:
+                if (VLCJSONIsWhitespace(c)) {
+                    i++;
+                } else if (c == '"') {
+                    VLCJSONBeginKey(reader);
+                    i++;
+                } else if (c == '}') {
+                    VLCJSONCloseContainer(reader, 1);
+                    i++;
+                } else {
+                    reader->state = VLCJSONStateError;
+                }
+                break;
+
+            case VLCJSONStateColon:
+                if (VLCJSONIsWhitespace(c)) {
+                    i++;
+                } else if (c == ':') {
+                    reader->state = VLCJSONStateValue;
+                    i++;
+                } else {
+                    reader->state = VLCJSONStateError;
+                }
+                break;
+
+            case VLCJSONStateString: {
+                // Copy plain runs in one go; only quotes and escapes need a look
+                size_t runEnd = i;
+                while (runEnd < length && bytes[runEnd] != '"' && bytes[runEnd] != '\\') {
+                    runEnd++;
+                }
+                if (runEnd > i) {
+                    VLCJSONFlushSurrogate(reader);
+                    if (reader->capturing) {
+                        VLCJSONAppend(reader, bytes + i, runEnd - i);
+                    }
+                    i = runEnd;
+                    break;
+                }
+                if (c == '"') {
+                    VLCJSONFinishString(reader);
+                } else {
+                    reader->state = VLCJSONStateEscape;
+                }
+                i++;
+                break;
+            }
+
+            case VLCJSONStateEscape: {
+                char unescaped;
+                switch (c) {
+                    case '"': unescaped = '"'; break;
+                    case '\\': unescaped = '\\'; break;
+                    case '/': unescaped = '/'; break;
+                    case 'b': unescaped = '\b'; break;
+                    case 'f': unescaped = '\f'; break;
+                    case 'n': unescaped = '\n'; break;
+                    case 'r': unescaped = '\r'; break;
+                    case 't': unescaped = '\t'; break;
+                    case 'u':
+                        reader->unicode = 0;
+                        reader->unicodeDigits = 0;
+                        reader->state = VLCJSONStateUnicode;
+                        i++;
+                        continue;
+                    default:
+                        reader->state = VLCJSONStateError;
+                        continue;
+                }
+                VLCJSONFlushSurrogate(reader);
+                if (reader->capturing) {
+                    VLCJSONAppend(reader, &unescaped, 1);
+                }
+                reader->state = VLCJSONStateString;
+                i++;
+                break;
+            }
+
+            case VLCJSONStateUnicode: {
+                int value = VLCJSONHexValue(c);
+                if (value < 0) {
+                    reader->state = VLCJSONStateError;
+                    break;
+                }
+                reader->unicode = (reader->unicode << 4) | (uint32_t)value;
+                if (++reader->unicodeDigits == 4) {
+                    VLCJSONFinishUnicodeEscape(reader);
+                    reader->state = VLCJSONStateString;
+                }
+                i++;
+                break;
+            }
+
+            case VLCJSONStateLiteral:
+                if (VLCJSONIsLiteralByte(c)) {
+                    if (reader->capturing) {
+                        VLCJSONAppend(reader, &c, 1);
+                    }
+                    i++;
+                } else {
+                    // The terminating byte belongs to the next state
+                    VLCJSONFinishValue(reader);
+                }
+                break;
+
+            case VLCJSONStateAfterValue:
+                if (VLCJSONIsWhitespace(c)) {
+                    i++;
+                } else if (c == ',') {
+                    reader->state = VLCJSONCurrentIsObject(reader) ? VLCJSONStateKey : VLCJSONStateValue;
+                    i++;
+                } else if (c == '}' || c == ']') {
+                    VLCJSONCloseContainer(reader, c == '}');
+                    i++;
+                } else {
+                    reader->state = VLCJSONStateError;
+                }
+                break;
+
+            case VLCJSONStateDone:
+                if (VLCJSONIsWhitespace(c)) {
+                    i++;
+                } else {
+                    reader->state = VLCJSONStateError;
+                }
+                break;
+
+            case VLCJSONStateError:
+                break;
+        }
+    }
+
+    return reader->state != VLCJSONStateError;
+}
+
+int VLCJSONRecordReaderFinish(const VLCJSONRecordReader *reader) {
+    return reader && reader->state == VLCJSONStateDone && reader->topLevelArray;
+}
+
+size_t VLCJSONRecordReaderRecordCount(const VLCJSONRecordReader *reader) {
+    return reader ? reader->recordCount : 0;
+}
+
+#pragma mark - Field Access
+
+const VLCJSONField *VLCJSONFindField(const VLCJSONField *fields, size_t count, const char *key) {
+    size_t keyLength = strlen(key);
+    for (size_t i = 0; i < count; i++) {
+        if (fields[i].key.length == keyLength && memcmp(fields[i].key.bytes, key, keyLength) == 0) {
+            return &fields[i];
+        }
+    }
+    return NULL;
+}
+
+long long VLCJSONFieldToLongLong(const VLCJSONField *field, long long fallback) {
+    if (!field) {
+        return fallback;
+    }
+    const char *bytes = field->value.bytes;
+    size_t length = field->value.length;
+
+    if (field->type == VLCJSONValueBool) {
+        return length == 4 && memcmp(bytes, "true", 4) == 0;
+    }
+    if (field->type != VLCJSONValueNumber && field->type != VLCJSONValueString) {
+        return fallback;
+    }
+
+    size_t i = 0;
+    while (i < length && bytes[i] == ' ') {
+        i++;
+    }
+    int negative = i < length && bytes[i] == '-';
+    if (negative) {
+        i++;
+    }
+    long long value = 0;
+    size_t digits = 0;
+    for (; i < length && bytes[i] >= '0' && bytes[i] <= '9'; i++, digits++) {
+        value = value * 10 + (bytes[i] - '0');
+    }
+    if (digits == 0) {
+        return fallback;
+    }
+    return negative ? -value : value;
+}
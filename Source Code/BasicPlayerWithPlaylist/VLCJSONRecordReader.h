@@ -0,0 +1,70 @@
+//
+//  VLCJSONRecordReader.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable JSON Record Reader - Platform Independent (plain C)
+//  Incrementally reads a top-level JSON array of objects (the shape of every Xtream
+//  player_api catalog) and reports each object's fields as it completes
+//
+
+#ifndef VLCJSONRecordReader_h
+#define VLCJSONRecordReader_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    VLCJSONValueString = 0,
+    VLCJSONValueNumber,
+    VLCJSONValueBool,
+    VLCJSONValueNull,
+    VLCJSONValueNested      // Object or array value; skipped, its span is empty
+} VLCJSONValueType;
+
+// A slice of the reader's record buffer, valid until the handler returns. Not NUL terminated.
+typedef struct {
+    const char *bytes;
+    size_t length;
+} VLCJSONSpan;
+
+typedef struct {
+    VLCJSONSpan key;            // Unescaped UTF-8
+    VLCJSONSpan value;          // Unescaped UTF-8 for strings, literal text for other scalars
+    VLCJSONValueType type;
+} VLCJSONField;
+
+// Called once per object in the top-level array. Return 0 to stop reading.
+typedef int (*VLCJSONRecordHandler)(const VLCJSONField *fields, size_t count, void *context);
+
+typedef struct VLCJSONRecordReader VLCJSONRecordReader;
+
+VLCJSONRecordReader *VLCJSONRecordReaderCreate(VLCJSONRecordHandler handler, void *context);
+void VLCJSONRecordReaderFree(VLCJSONRecordReader *reader);
+
+/**
+ * Feeds the next chunk of the document. Chunks may split tokens anywhere, including
+ * inside escapes and multi-byte characters; nothing needs to be carried by the caller.
+ * @return 0 after a syntax error or when the handler stopped the reader, 1 otherwise.
+ */
+int VLCJSONRecordReaderFeed(VLCJSONRecordReader *reader, const char *bytes, size_t length);
+
+// Returns 1 when a complete top-level array was read (records may still be 0)
+int VLCJSONRecordReaderFinish(const VLCJSONRecordReader *reader);
+
+size_t VLCJSONRecordReaderRecordCount(const VLCJSONRecordReader *reader);
+
+// Returns the field named key, or NULL
+const VLCJSONField *VLCJSONFindField(const VLCJSONField *fields, size_t count, const char *key);
+
+// Integer value of a number or numeric string field ("tv_archive": "1"); fallback otherwise
+long long VLCJSONFieldToLongLong(const VLCJSONField *field, long long fallback);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCJSONRecordReader_h */
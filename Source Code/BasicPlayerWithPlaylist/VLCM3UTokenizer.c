@@ -0,0 +1,291 @@
+//
+//  VLCM3UTokenizer.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable M3U Tokenizer - Platform Independent (plain C)
+//  Walks raw UTF-8 playlist bytes once and reports every #EXTINF entry as byte spans
+//
+
+#include "VLCM3UTokenizer.h"
+#include "VLCHashIndex.h"
+
+#include <string.h>
+
+#pragma mark - Helpers
+
+static inline int VLCM3UIsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+static inline void VLCM3UTrim(const char **start, const char **end) {
+    while (*start < *end && VLCM3UIsSpace(**start)) (*start)++;
+    while (*end > *start && VLCM3UIsSpace(*(*end - 1))) (*end)--;
+}
+
+static inline VLCM3USpan VLCM3UMakeSpan(const char *start, const char *end) {
+    VLCM3USpan span;
+    span.bytes = start;
+    span.length = (size_t)(end - start);
+    return span;
+}
+
+int VLCM3USpanEquals(VLCM3USpan span, const char *literal) {
+    size_t literalLength = strlen(literal);
+    return span.length == literalLength && memcmp(span.bytes, literal, literalLength) == 0;
+}
+
+long VLCM3USpanToLong(VLCM3USpan span) {
+    long value = 0;
+    int sawDigit = 0;
+    for (size_t i = 0; i < span.length; i++) {
+        char c = span.bytes[i];
+        if (c >= '0' && c <= '9') {
+            value = value * 10 + (c - '0');
+            sawDigit = 1;
+        } else if (sawDigit) {
+            break;
+        } else if (!VLCM3UIsSpace(c) && c != '+') {
+            return -1;
+        }
+    }
+    return sawDigit ? value : -1;
+}
+
+uint64_t VLCM3UEntryFingerprint(const VLCM3UEntry *entry) {
+    uint64_t hash = VLCHashBytes(entry->extinf.bytes, entry->extinf.length, VLC_HASH_SEED);
+    hash = VLCHashBytes("\n", 1, hash);
+    return VLCHashBytes(entry->url.bytes, entry->url.length, hash);
+}
+
+uint64_t VLCM3UEntryIdentity(const VLCM3UEntry *entry) {
+    return VLCHashBytes(entry->url.bytes, entry->url.length, VLC_HASH_SEED);
+}
+
+uint64_t VLCM3UIdentityWithOccurrence(uint64_t identity, uint32_t occurrence) {
+    if (occurrence == 0) {
+        return identity;
+    }
+    return VLCHashBytes(&occurrence, sizeof(occurrence), identity);
+}
+
+// Routes a key to its slot in the entry. Keys are compared by length first so
+// most attributes are rejected without touching memcmp.
+static VLCM3USpan *VLCM3USlotForKey(VLCM3UEntry *entry, const char *key, size_t keyLength) {
+    switch (keyLength) {
+        case 6:
+            if (memcmp(key, "tvg-id", 6) == 0) return &entry->tvgId;
+            break;
+        case 7:
+            if (memcmp(key, "catchup", 7) == 0) return &entry->catchup;
+            break;
+        case 8:
+            if (memcmp(key, "tvg-name", 8) == 0) return &entry->tvgName;
+            if (memcmp(key, "tvg-logo", 8) == 0) return &entry->tvgLogo;
+            break;
+        case 9:
+            if (memcmp(key, "tvg-shift", 9) == 0) return &entry->tvgShift;
+            break;
+        case 11:
+            if (memcmp(key, "group-title", 11) == 0) return &entry->groupTitle;
+            break;
+        case 12:
+            if (memcmp(key, "catchup-days", 12) == 0) return &entry->catchupDays;
+            break;
+        case 16:
+            if (memcmp(key, "catchup-template", 16) == 0) return &entry->catchupTemplate;
+            break;
+        default:
+            break;
+    }
+    return NULL;
+}
+
+#pragma mark - EXTINF Attribute Scanner
+
+void VLCM3UParseExtinf(const char *line, size_t length, VLCM3UEntry *entry) {
+    const char *cursor = line;
+    const char *end = line + length;
+
+    entry->extinf = VLCM3UMakeSpan(line, end);
+
+    // Skip "#EXTINF:" and the duration token
+    if (length >= 8 && memcmp(line, "#EXTINF:", 8) == 0) {
+        cursor += 8;
+    }
+    while (cursor < end && !VLCM3UIsSpace(*cursor) && *cursor != ',') cursor++;
+
+    // Attribute list: key="value" pairs separated by whitespace, terminated by the first
+    // comma outside quotes. Quoted values may legitimately contain commas.
+    while (cursor < end) {
+        while (cursor < end && VLCM3UIsSpace(*cursor)) cursor++;
+        if (cursor >= end) break;
+
+        if (*cursor == ',') {
+            const char *nameStart = cursor + 1;
+            const char *nameEnd = end;
+            VLCM3UTrim(&nameStart, &nameEnd);
+            entry->name = VLCM3UMakeSpan(nameStart, nameEnd);
+            return;
+        }
+
+        const char *keyStart = cursor;
+        while (cursor < end && *cursor != '=' && *cursor != ',' && !VLCM3UIsSpace(*cursor)) cursor++;
+        const char *keyEnd = cursor;
+
+        if (cursor >= end || *cursor != '=') {
+            // Bare token without a value; ignore it
+            continue;
+        }
+        cursor++; // '='
+
+        const char *valueStart;
+        const char *valueEnd;
+        if (cursor < end && *cursor == '"') {
+            valueStart = ++cursor;
+            const char *closingQuote = memchr(cursor, '"', (size_t)(end - cursor));
+            valueEnd = closingQuote ? closingQuote : end;
+            cursor = closingQuote ? closingQuote + 1 : end;
+        } else {
+            valueStart = cursor;
+            while (cursor < end && *cursor != ',' && !VLCM3UIsSpace(*cursor)) cursor++;
+            valueEnd = cursor;
+        }
+
+        VLCM3USpan *slot = VLCM3USlotForKey(entry, keyStart, (size_t)(keyEnd - keyStart));
+        if (slot) {
+            *slot = VLCM3UMakeSpan(valueStart, valueEnd);
+        }
+    }
+}
+
+#pragma mark - Buffer Tokenizer
+
+// keepPendingEntry: when the buffer runs out after an #EXTINF whose URL has not been seen
+// yet, resume at that #EXTINF instead of dropping it (more bytes are still to come)
+static size_t VLCM3UTokenize(const char *bytes,
+                             size_t length,
+                             size_t offset,
+                             size_t maxEntries,
+                             VLCM3UEntryHandler handler,
+                             void *context,
+                             size_t *entriesEmitted,
+                             int keepPendingEntry) {
+
+    size_t emitted = 0;
+    size_t resumeOffset = offset;
+    int hasPending = 0;
+    size_t pendingLineOffset = 0;
+    VLCM3UEntry pending;
+
+    // Skip a UTF-8 byte order mark at the very start of the playlist
+    if (offset == 0 && length >= 3 &&
+        (unsigned char)bytes[0] == 0xEF && (unsigned char)bytes[1] == 0xBB && (unsigned char)bytes[2] == 0xBF) {
+        offset = 3;
+        resumeOffset = 3;
+    }
+
+    const char *cursor = bytes + offset;
+    const char *bufferEnd = bytes + length;
+
+    while (cursor < bufferEnd) {
+        const char *newline = memchr(cursor, '\n', (size_t)(bufferEnd - cursor));
+        const char *lineEnd = newline ? newline : bufferEnd;
+        const char *nextLine = newline ? newline + 1 : bufferEnd;
+
+        const char *lineStart = cursor;
+        const char *trimmedEnd = lineEnd;
+        VLCM3UTrim(&lineStart, &trimmedEnd);
+        size_t lineLength = (size_t)(trimmedEnd - lineStart);
+
+        if (lineLength >= 8 && memcmp(lineStart, "#EXTINF:", 8) == 0) {
+            memset(&pending, 0, sizeof(pending));
+            VLCM3UParseExtinf(lineStart, lineLength, &pending);
+            hasPending = 1;
+            pendingLineOffset = (size_t)(cursor - bytes);
+        } else if (hasPending && lineLength >= 4 && memcmp(lineStart, "http", 4) == 0) {
+            pending.url = VLCM3UMakeSpan(lineStart, trimmedEnd);
+            hasPending = 0;
+            emitted++;
+            resumeOffset = (size_t)(nextLine - bytes);
+
+            if (handler && !handler(&pending, context)) {
+                break;
+            }
+            if (maxEntries > 0 && emitted >= maxEntries) {
+                break;
+            }
+        }
+
+        cursor = nextLine;
+    }
+
+    if (cursor >= bufferEnd && !(maxEntries > 0 && emitted >= maxEntries)) {
+        // A trailing EXTINF without URL is dropped, exactly like the line based parser did
+        resumeOffset = (keepPendingEntry && hasPending) ? pendingLineOffset : length;
+    }
+
+    if (entriesEmitted) {
+        *entriesEmitted = emitted;
+    }
+    return resumeOffset;
+}
+
+size_t VLCM3UTokenizeBuffer(const char *bytes,
+                            size_t length,
+                            size_t offset,
+                            size_t maxEntries,
+                            VLCM3UEntryHandler handler,
+                            void *context,
+                            size_t *entriesEmitted) {
+    return VLCM3UTokenize(bytes, length, offset, maxEntries, handler, context, entriesEmitted, 0);
+}
+
+size_t VLCM3UTokenizePartialBuffer(const char *bytes,
+                                   size_t length,
+                                   VLCM3UEntryHandler handler,
+                                   void *context,
+                                   size_t *entriesEmitted) {
+    // Only complete lines are tokenized; the text after the last newline may still grow
+    size_t completeLength = length;
+    while (completeLength > 0 && bytes[completeLength - 1] != '\n') completeLength--;
+    if (completeLength == 0) {
+        if (entriesEmitted) {
+            *entriesEmitted = 0;
+        }
+        return 0;
+    }
+    return VLCM3UTokenize(bytes, completeLength, 0, 0, handler, context, entriesEmitted, 1);
+}
+
+size_t VLCM3UFindEntryStart(const char *bytes, size_t length, size_t offset) {
+    if (offset >= length) {
+        return length;
+    }
+
+    const char *cursor = bytes + offset;
+    const char *bufferEnd = bytes + length;
+
+    // Align to the start of a line
+    if (offset > 0 && bytes[offset - 1] != '\n') {
+        const char *newline = memchr(cursor, '\n', (size_t)(bufferEnd - cursor));
+        if (!newline) {
+            return length;
+        }
+        cursor = newline + 1;
+    }
+
+    while (cursor < bufferEnd) {
+        const char *content = cursor;
+        while (content < bufferEnd && (*content == ' ' || *content == '\t' || *content == '\r')) content++;
+        if ((size_t)(bufferEnd - content) >= 8 && memcmp(content, "#EXTINF:", 8) == 0) {
+            return (size_t)(cursor - bytes);
+        }
+
+        const char *newline = memchr(cursor, '\n', (size_t)(bufferEnd - cursor));
+        if (!newline) {
+            break;
+        }
+        cursor = newline + 1;
+    }
+    return length;
+}
@@ -0,0 +1,101 @@
+//
+//  VLCM3UTokenizer.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable M3U Tokenizer - Platform Independent (plain C)
+//  Walks raw UTF-8 playlist bytes once and reports every #EXTINF entry as byte spans
+//
+
+#ifndef VLCM3UTokenizer_h
+#define VLCM3UTokenizer_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A slice of the caller's buffer. Spans are never copied or NUL terminated.
+typedef struct {
+    const char *bytes;
+    size_t length;
+} VLCM3USpan;
+
+// One playlist entry (#EXTINF line + its stream URL line).
+// Attributes that are absent have length 0.
+typedef struct {
+    VLCM3USpan extinf;          // Whole #EXTINF line, trimmed
+    VLCM3USpan name;            // Display name after the attribute list
+    VLCM3USpan tvgId;
+    VLCM3USpan tvgName;
+    VLCM3USpan tvgLogo;
+    VLCM3USpan groupTitle;
+    VLCM3USpan catchup;
+    VLCM3USpan catchupDays;
+    VLCM3USpan catchupTemplate;
+    VLCM3USpan tvgShift;
+    VLCM3USpan url;             // Stream URL line, trimmed
+} VLCM3UEntry;
+
+// Called once per complete entry. Return 0 to stop tokenizing early.
+typedef int (*VLCM3UEntryHandler)(const VLCM3UEntry *entry, void *context);
+
+/**
+ * Tokenizes bytes[offset..length) and calls handler for each entry.
+ * Stops after maxEntries entries (0 = no limit) or when the handler returns 0.
+ * @return The byte offset to resume from; equals length when the buffer is exhausted.
+ *         Resume offsets always fall on a line boundary after a URL line.
+ */
+size_t VLCM3UTokenizeBuffer(const char *bytes,
+                            size_t length,
+                            size_t offset,
+                            size_t maxEntries,
+                            VLCM3UEntryHandler handler,
+                            void *context,
+                            size_t *entriesEmitted);
+
+/**
+ * Incremental variant for data that is still arriving (e.g. a network stream).
+ * Tokenizes only complete lines and keeps an #EXTINF whose URL line is missing.
+ * @return Number of bytes consumed; the caller keeps bytes[consumed..length) and
+ *         prepends them to the next chunk. Flush the final remainder with VLCM3UTokenizeBuffer.
+ */
+size_t VLCM3UTokenizePartialBuffer(const char *bytes,
+                                   size_t length,
+                                   VLCM3UEntryHandler handler,
+                                   void *context,
+                                   size_t *entriesEmitted);
+
+/**
+ * Returns the start of the first line at or after offset that begins an entry (#EXTINF:),
+ * or length when there is none. When offset is mid-line the search starts at the next line.
+ * Splitting a buffer at these offsets yields shards that tokenize exactly like the whole buffer.
+ */
+size_t VLCM3UFindEntryStart(const char *bytes, size_t length, size_t offset);
+
+/**
+ * Parses the attribute list of a single #EXTINF line into entry (url is left untouched).
+ * Exposed so callers holding a lone EXTINF line can reuse the same scanner.
+ */
+void VLCM3UParseExtinf(const char *line, size_t length, VLCM3UEntry *entry);
+
+// Fingerprint of the entry's playlist text (#EXTINF line + URL); changes whenever the entry changes
+uint64_t VLCM3UEntryFingerprint(const VLCM3UEntry *entry);
+
+// Stable identity of the entry across playlist revisions (its stream URL). Streams listed more
+// than once are told apart with VLCM3UIdentityWithOccurrence.
+uint64_t VLCM3UEntryIdentity(const VLCM3UEntry *entry);
+uint64_t VLCM3UIdentityWithOccurrence(uint64_t identity, uint32_t occurrence);
+
+// Returns 1 when span equals the NUL terminated literal (case sensitive).
+int VLCM3USpanEquals(VLCM3USpan span, const char *literal);
+
+// Parses a non-negative decimal integer span; returns -1 when it contains no digits.
+long VLCM3USpanToLong(VLCM3USpan span);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCM3UTokenizer_h */
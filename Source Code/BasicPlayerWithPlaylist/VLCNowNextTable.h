@@ -0,0 +1,52 @@
+//
+//  VLCNowNextTable.h
+//  BasicPlayerWithPlaylist
+//
+//  Now/Next Table - Platform Independent
+//  What is on now and next on every channel, worked out once and then advanced by a timer
+//  wheel that only wakes when some channel's programme starts or ends
+//
+
+#import <Foundation/Foundation.h>
+
+@class VLCChannel;
+@class VLCProgram;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Posted on the main thread when programmes change; userInfo[@"channels"] lists the channels
+extern NSString * const VLCNowNextTableDidChangeNotification;
+
+/**
+ * Built and used on the main thread. Entries follow the guide time (now minus the offset) the
+ * table was created with. A channel whose programs array was replaced is worked out again on
+ * its next lookup.
+ */
+@interface VLCNowNextTable : NSObject
+
+// nil when memory runs out
+- (nullable instancetype)initWithChannels:(NSArray<VLCChannel *> *)channels timeOffsetHours:(NSInteger)offsetHours;
+
+@property (nonatomic, readonly) NSArray<VLCChannel *> *channels;
+@property (nonatomic, readonly) NSInteger timeOffsetHours;
+
+/**
+ * O(1). now is the program on air (or nil), next the first one to start after it, current what
+ * -[VLCChannel currentProgramWithTimeOffset:] returns (on air, else next, else last).
+ * @return NO when the channel is not in the table; the out parameters are left alone then.
+ */
+- (BOOL)getNowProgram:(VLCProgram * _Nullable * _Nullable)now
+          nextProgram:(VLCProgram * _Nullable * _Nullable)next
+       currentProgram:(VLCProgram * _Nullable * _Nullable)current
+           forChannel:(VLCChannel *)channel;
+
+// Brings the table up to the current time. The table does this itself when a programme boundary
+// passes; call it after the app was suspended.
+- (void)advance;
+
+// Stops the wake-ups; the table keeps answering with its last state
+- (void)invalidate;
+
+@end
+
+NS_ASSUME_NONNULL_END
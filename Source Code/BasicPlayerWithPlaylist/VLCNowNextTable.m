@@ -0,0 +1,250 @@
+//
+//  VLCNowNextTable.m
+//  BasicPlayerWithPlaylist
+//
+//  Now/Next Table - Platform Independent
+//  What is on now and next on every channel, worked out once and then advanced by a timer
+//  wheel that only wakes when some channel's programme starts or ends
+//
+
+#import "VLCNowNextTable.h"
+#import "VLCChannel.h"
+#import "VLCProgram.h"
+#import "VLCHashIndex.h"
+#import "VLCTimerWheel.h"
+
+NSString * const VLCNowNextTableDidChangeNotification = @"VLCNowNextTableDidChange";
+
+typedef struct {
+    VLCChannel *channel;    // Retained by _channels
+    NSArray *programs;      // The programs array now/next were worked out from
+    VLCProgram *now;
+    VLCProgram *next;
+    VLCProgram *current;
+} VLCNowNextEntry;
+
+static inline void VLCNowNextAssign(id *slot, id value) {
+    if (*slot == value) return;
+    id old = *slot;
+    *slot = [value retain];
+    [old release];
+}
+
+// Views of the same row are different objects but compare equal
+static inline BOOL VLCNowNextSame(VLCProgram *a, VLCProgram *b) {
+    return a == b || [a isEqual:b];
+}
+
+@interface VLCNowNextTable ()
+- (void)entryExpired:(uint32_t)entryIndex;
+@end
+
+static void VLCNowNextTableTimerExpired(uint32_t timer, int64_t expiry, void *context) {
+    [(VLCNowNextTable *)context entryExpired:timer];
+}
+
+static void VLCNowNextTableWakeUp(void *context) {
+    [(VLCNowNextTable *)context advance];
+}
+
+@implementation VLCNowNextTable {
+    NSArray *_channels;
+    NSInteger _timeOffsetHours;
+    VLCNowNextEntry *_entries;
+    NSUInteger _entryCount;
+    VLCHashIndex *_entryByChannel;      // Channel pointer -> entry index + 1
+    VLCTimerWheel *_wheel;              // Guide time; timer i fires when entry i changes
+    dispatch_source_t _timer;
+    int64_t _advanceTimestamp;
+    NSMutableArray *_changedChannels;   // Collected while advancing
+}
+
+@synthesize channels = _channels;
+@synthesize timeOffsetHours = _timeOffsetHours;
+
+- (instancetype)initWithChannels:(NSArray<VLCChannel *> *)channels timeOffsetHours:(NSInteger)offsetHours {
+    self = [super init];
+    if (!self) {
+        return nil;
+    }
+    _channels = [channels copy];
+    _timeOffsetHours = offsetHours;
+
+    NSUInteger count = _channels.count;
+    int64_t now = (int64_t)floor([self guideTime]);
+    _entries = calloc(count ? count : 1, sizeof(VLCNowNextEntry));
+    _entryByChannel = VLCHashIndexCreate(count);
+    _wheel = VLCTimerWheelCreate(count, now);
+    if (!_entries || !_entryByChannel || !_wheel) {
+        NSLog(@"❌ [EPG] Not enough memory for the now/next table (%lu channels)", (unsigned long)count);
+        [self release];
+        return nil;
+    }
+
+    for (NSUInteger i = 0; i < count; i++) {
+        VLCChannel *channel = [_channels objectAtIndex:i];
+        uint32_t *slot = VLCHashIndexSlot(_entryByChannel, (uint64_t)(uintptr_t)channel);
+        if (!slot) {
+            [self release];
+            return nil;
+        }
+        if (*slot != 0) {
+            continue; // Same channel listed twice
+        }
+        uint32_t entryIndex = (uint32_t)_entryCount++;
+        *slot = entryIndex + 1;
+        _entries[entryIndex].channel = channel;
+        @autoreleasepool {
+            [self updateEntry:entryIndex atTimestamp:now];
+        }
+    }
+
+    _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+    if (_timer) {
+        dispatch_set_context(_timer, self);
+        dispatch_source_set_event_handler_f(_timer, VLCNowNextTableWakeUp);
+        [self scheduleWakeUp];
+        dispatch_resume(_timer);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self invalidate];
+    if (_entries) {
+        for (NSUInteger i = 0; i < _entryCount; i++) {
+            [_entries[i].programs release];
+            [_entries[i].now release];
+            [_entries[i].next release];
+            [_entries[i].current release];
+        }
+        free(_entries);
+    }
+    VLCHashIndexFree(_entryByChannel);
+    VLCTimerWheelFree(_wheel);
+    [_channels release];
+    [super dealloc];
+}
+
+- (void)invalidate {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+        dispatch_release(_timer);
+        _timer = NULL;
+    }
+}
+
+#pragma mark - Entries
+
+// Seconds since 1970 on the guide's clock
+- (double)guideTime {
+    return CFAbsoluteTimeGetCurrent() + kCFAbsoluteTimeIntervalSince1970 - (double)_timeOffsetHours * 3600.0;
+}
+
+// Works out the entry at timestamp and sets its timer for the next programme boundary.
+// Returns YES when what the entry shows changed.
+- (BOOL)updateEntry:(uint32_t)entryIndex atTimestamp:(int64_t)timestamp {
+    VLCNowNextEntry *entry = &_entries[entryIndex];
+    VLCChannel *channel = entry->channel;
+    NSArray *programs = channel.programs;
+
+    VLCProgram *now = nil;
+    VLCProgram *next = nil;
+    VLCProgram *current = nil;
+    if (programs.count > 0) {
+        now = [channel programAtTimestamp:timestamp];
+        next = [channel nextProgramAfterTimestamp:timestamp];
+        current = now ?: (next ?: [channel currentProgramAtTimestamp:timestamp]);
+    }
+
+    BOOL changed = !VLCNowNextSame(entry->now, now) || !VLCNowNextSame(entry->next, next) ||
+                   !VLCNowNextSame(entry->current, current);
+    VLCNowNextAssign(&entry->programs, programs);
+    VLCNowNextAssign(&entry->now, now);
+    VLCNowNextAssign(&entry->next, next);
+    VLCNowNextAssign(&entry->current, current);
+
+    // Nothing changes until the programme on air ends or the next one starts
+    int64_t changesAt = VLC_TIMER_WHEEL_NEVER;
+    if (now && now.endTimestamp != VLC_PROGRAM_NO_TIMESTAMP) {
+        changesAt = now.endTimestamp;
+    }
+    if (next && next.startTimestamp < changesAt) {
+        changesAt = next.startTimestamp;
+    }
+    if (changesAt == VLC_TIMER_WHEEL_NEVER) {
+        VLCTimerWheelCancel(_wheel, entryIndex);
+    } else {
+        VLCTimerWheelSchedule(_wheel, entryIndex, changesAt);
+    }
+    return changed;
+}
+
+- (void)entryExpired:(uint32_t)entryIndex {
+    if ([self updateEntry:entryIndex atTimestamp:_advanceTimestamp]) {
+        [_changedChannels addObject:_entries[entryIndex].channel];
+    }
+}
+
+#pragma mark - Lookup
+
+- (BOOL)getNowProgram:(VLCProgram **)now
+          nextProgram:(VLCProgram **)next
+       currentProgram:(VLCProgram **)current
+           forChannel:(VLCChannel *)channel {
+    uint32_t value = channel ? VLCHashIndexGet(_entryByChannel, (uint64_t)(uintptr_t)channel) : 0;
+    if (value == 0) {
+        return NO;
+    }
+    uint32_t entryIndex = value - 1;
+    VLCNowNextEntry *entry = &_entries[entryIndex];
+    if (entry->programs != channel.programs) {
+        // Guide data was attached again since; work it out now and keep it current from here on
+        [self updateEntry:entryIndex atTimestamp:(int64_t)floor([self guideTime])];
+        [self scheduleWakeUp];
+    }
+    if (now) *now = entry->now;
+    if (next) *next = entry->next;
+    if (current) *current = entry->current;
+    return YES;
+}
+
+#pragma mark - Advancing
+
+- (void)advance {
+    if (!_wheel) {
+        return;
+    }
+    NSMutableArray *changedChannels = [NSMutableArray array];
+    _changedChannels = changedChannels;
+    _advanceTimestamp = (int64_t)floor([self guideTime]);
+    @autoreleasepool {
+        VLCTimerWheelAdvance(_wheel, _advanceTimestamp, VLCNowNextTableTimerExpired, self);
+    }
+    _changedChannels = nil;
+    [self scheduleWakeUp];
+
+    if (changedChannels.count > 0) {
+        [[NSNotificationCenter defaultCenter] postNotificationName:VLCNowNextTableDidChangeNotification
+                                                            object:self
+                                                          userInfo:@{@"channels": changedChannels}];
+    }
+}
+
+// One wake-up for the whole table, at the next programme boundary on any channel
+- (void)scheduleWakeUp {
+    if (!_timer) {
+        return;
+    }
+    int64_t expiry = VLCTimerWheelNextExpiry(_wheel);
+    if (expiry == VLC_TIMER_WHEEL_NEVER) {
+        dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        return;
+    }
+    double delay = MAX((double)expiry - [self guideTime], 0.0);
+    // Wall clock, so the wake-up still happens on time after the device slept
+    dispatch_source_set_timer(_timer, dispatch_walltime(NULL, (int64_t)(delay * NSEC_PER_SEC)),
+                              DISPATCH_TIME_FOREVER, NSEC_PER_SEC / 4);
+}
+
+@end
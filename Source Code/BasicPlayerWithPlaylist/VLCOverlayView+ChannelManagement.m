@@ -6,6 +6,7 @@
 #import "DownloadManager.h"
 #import "VLCSubtitleSettings.h"
 #import "VLCDataManager.h"
+#import "VLCTaskScheduler.h"
 #import <objc/runtime.h>
 #import <CommonCrypto/CommonDigest.h>
 
@@ -1309,6 +1310,7 @@ static char tempEarlyPlaybackChannelKey;
         //NSLog(@"Error: Invalid URL format: %@", channel.url);
         return;
     }
+    self.dataManager.playingChannel = channel;
     
     // Stop current playback and clear time state to prevent stale time info
     if (self.player) {
@@ -2012,6 +2014,46 @@ static char tempEarlyPlaybackChannelKey;
 
 #pragma mark - Proactive Movie Info and Cover Loading
 
+// Movie info requests go to the provider's API; this keeps the average of the old 5-per-2s batches
+static const double kMovieInfoFetchesPerSecond = 2.5;
+
+// Movies of the group on screen first, the rest in their original order
+- (NSArray *)movieChannelsVisibleFirst:(NSArray *)movieChannels {
+    NSArray *visibleChannels = [self.channelsByGroup objectForKey:self.dataManager.visibleGroup];
+    if (visibleChannels.count == 0) {
+        return movieChannels;
+    }
+    
+    NSHashTable *visible = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for (VLCChannel *channel in visibleChannels) {
+        [visible addObject:channel];
+    }
+    NSMutableArray *ordered = [NSMutableArray arrayWithCapacity:movieChannels.count];
+    for (VLCChannel *channel in movieChannels) {
+        if ([visible containsObject:channel]) {
+            [ordered addObject:channel];
+        }
+    }
+    for (VLCChannel *channel in movieChannels) {
+        if (![visible containsObject:channel]) {
+            [ordered addObject:channel];
+        }
+    }
+    return ordered;
+}
+
+// Fetches movie info from the network, then the cover image on the main thread
+- (void)fetchMovieInfoAndCoverForChannel:(VLCChannel *)channel {
+    channel.hasStartedFetchingMovieInfo = YES;
+    [self fetchMovieInfoForChannel:channel];
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (channel.logo && !channel.cachedPosterImage) {
+            [self loadImageAsynchronously:channel.logo forChannel:channel];
+        }
+    });
+}
+
 // Add a new method for preloading all movie info and covers
 - (void)preloadAllMovieInfoAndCovers {
     // Get all movie channels
@@ -2031,166 +2073,51 @@ static char tempEarlyPlaybackChannelKey;
         }
     }
     
-    //NSLog(@"Found %lu movie channels to preload", (unsigned long)movieChannels.count);
-    
-    // Process in batches to avoid overwhelming the system
-    const NSInteger BATCH_SIZE = 5;
-    const CGFloat DELAY_BETWEEN_BATCHES = 2.0; // seconds
-    
-    // Start batch processing
-    [self processBatchOfMovieChannels:movieChannels batchSize:BATCH_SIZE delayBetweenBatches:DELAY_BETWEEN_BATCHES currentIndex:0];
-}
-
-// Process channels in batches
-- (void)processBatchOfMovieChannels:(NSArray *)movieChannels 
-                          batchSize:(NSInteger)batchSize 
-                 delayBetweenBatches:(CGFloat)delay 
-                        currentIndex:(NSInteger)currentIndex {
-    
-    // Check if we've finished processing all channels
-    if (currentIndex >= movieChannels.count) {
-        //NSLog(@"Completed preloading all movie info and covers");
+    if (movieChannels.count == 0) {
         return;
     }
-    
-    // Calculate the end index for this batch
-    NSInteger endIndex = MIN(currentIndex + batchSize, movieChannels.count);
-    
-    // Process this batch
-    //NSLog(@"Processing movie info batch %ld to %ld of %lu", 
-    //     (long)currentIndex, (long)endIndex - 1, (unsigned long)movieChannels.count);
-         
-    dispatch_group_t group = dispatch_group_create();
-    
-    for (NSInteger i = currentIndex; i < endIndex; i++) {
-        VLCChannel *channel = [movieChannels objectAtIndex:i];
-        dispatch_group_enter(group);
-        
-        // Check if movie info is already cached before fetching
-        BOOL loadedFromCache = [self loadMovieInfoFromCacheForChannel:channel];
-        
-        if (!loadedFromCache && !channel.hasStartedFetchingMovieInfo) {
-            channel.hasStartedFetchingMovieInfo = YES;
-            
-            // Load movie info
-            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-                //NSLog(@"Preloading movie info for channel %@ (%ld of %lu)", 
-                //     channel.name, (long)i, (unsigned long)movieChannels.count);
-                     
-                [self fetchMovieInfoForChannel:channel];
-                
-                // After fetching movie info, also load the image if needed
-                dispatch_async(dispatch_get_main_queue(), ^{
-                    if (channel.logo && !channel.cachedPosterImage) {
-                        //NSLog(@"Preloading cover image for channel %@", channel.name);
-                        [self loadImageAsynchronously:channel.logo forChannel:channel];
-                    }
-                    dispatch_group_leave(group);
-                });
-            });
-        } else {
-            // Already loaded from cache or started fetching
-            if (loadedFromCache) {
-                //NSLog(@"Movie info for %@ already loaded from cache", channel.name);
-                
-                // Still load the image if needed
+    NSArray *orderedChannels = [self movieChannelsVisibleFirst:movieChannels];
+    
+    // Phase 1: cache loads are local work, sliced by the scheduler as fast as the budget allows
+    NSMutableArray *channelsToFetch = [[NSMutableArray alloc] init];
+    VLCScheduledTask *cacheTask = [[VLCScheduledTask alloc] initWithName:@"Movie info cache"
+                                                                priority:VLCTaskPriorityBackground
+                                                              totalUnits:orderedChannels.count
+                                                                    step:^(NSRange range) {
+        for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+            VLCChannel *channel = [orderedChannels objectAtIndex:i];
+            if ([self loadMovieInfoFromCacheForChannel:channel]) {
                 if (channel.logo && !channel.cachedPosterImage) {
-                    //NSLog(@"Preloading cover image for channel %@", channel.name);
-                    [self loadImageAsynchronously:channel.logo forChannel:channel];
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        [self loadImageAsynchronously:channel.logo forChannel:channel];
+                    });
                 }
+            } else if (!channel.hasStartedFetchingMovieInfo) {
+                [channelsToFetch addObject:channel];
             }
-            dispatch_group_leave(group);
         }
-    }
-    
-    // Schedule the next batch after current batch completes
-    dispatch_group_notify(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        // Clean up
-        [group release];
-        
-        // Schedule next batch after delay
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), 
-                     dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-            [self processBatchOfMovieChannels:movieChannels 
-                                    batchSize:batchSize 
-                           delayBetweenBatches:delay 
-                                  currentIndex:endIndex];
-        });
-    });
-}
-
-// Process channels in batches with progress tracking
-- (void)processBatchOfMovieChannelsWithProgress:(NSArray *)movieChannels 
-                                      batchSize:(NSInteger)batchSize 
-                             delayBetweenBatches:(CGFloat)delay 
-                                    currentIndex:(NSInteger)currentIndex {
-    
-    // Check if we've finished processing all channels
-    if (currentIndex >= movieChannels.count) {
-       // NSLog(@"Completed refreshing all movie info and covers");
-        
-        // Reset refresh state on main thread
-        dispatch_async(dispatch_get_main_queue(), ^{
-            self.isRefreshingMovieInfo = NO;
-            self.movieRefreshCompleted = self.movieRefreshTotal;
-            [self setNeedsDisplay:YES];
-        });
-        return;
-    }
-    
-    // Calculate the end index for this batch
-    NSInteger endIndex = MIN(currentIndex + batchSize, movieChannels.count);
-    
-    // Process this batch
-    //NSLog(@"Processing movie info batch %ld to %ld of %lu", 
-    //       (long)currentIndex, (long)endIndex - 1, (unsigned long)movieChannels.count);
-         
-    dispatch_group_t group = dispatch_group_create();
+    }];
     
-    for (NSInteger i = currentIndex; i < endIndex; i++) {
-        VLCChannel *channel = [movieChannels objectAtIndex:i];
-        dispatch_group_enter(group);
-        
-        // Always fetch fresh data (no cache check since this is a forced refresh)
-        channel.hasStartedFetchingMovieInfo = YES;
-        
-        // Load movie info
-        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-            //NSLog(@"Refreshing movie info for channel %@ (%ld of %lu)", 
-            //     channel.name, (long)i + 1, (unsigned long)movieChannels.count);
-                 
-            [self fetchMovieInfoForChannel:channel];
-            
-            // After fetching movie info, also load the image if needed
-            dispatch_async(dispatch_get_main_queue(), ^{
-                if (channel.logo && !channel.cachedPosterImage) {
-                    //NSLog(@"Refreshing cover image for channel %@", channel.name);
-                    [self loadImageAsynchronously:channel.logo forChannel:channel];
+    // Phase 2: network fetches for cache misses, capped to a rate the provider tolerates
+    cacheTask.completionBlock = ^(VLCScheduledTask *task) {
+        if (!task.isCancelled && channelsToFetch.count > 0) {
+            VLCScheduledTask *fetchTask = [[VLCScheduledTask alloc] initWithName:@"Movie info fetch"
+                                                                        priority:VLCTaskPriorityBackground
+                                                                      totalUnits:channelsToFetch.count
+                                                                            step:^(NSRange range) {
+                for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+                    [self fetchMovieInfoAndCoverForChannel:[channelsToFetch objectAtIndex:i]];
                 }
-                
-                // Update progress
-                self.movieRefreshCompleted++;
-                [self setNeedsDisplay:YES];
-                
-                dispatch_group_leave(group);
-            });
-        });
-    }
+            }];
+            fetchTask.maxUnitsPerSecond = kMovieInfoFetchesPerSecond;
+            [[VLCTaskScheduler sharedScheduler] addTask:fetchTask];
+            [fetchTask release];
+        }
+        [channelsToFetch release];
+    };
     
-    // Schedule the next batch after current batch completes
-    dispatch_group_notify(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        // Clean up
-        [group release];
-        
-        // Schedule next batch after delay
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), 
-                     dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-            [self processBatchOfMovieChannelsWithProgress:movieChannels 
-                                                batchSize:batchSize 
-                                       delayBetweenBatches:delay 
-                                              currentIndex:endIndex];
-        });
-    });
+    [[VLCTaskScheduler sharedScheduler] addTask:cacheTask];
+    [cacheTask release];
 }
 
 // Add method to start movie info refresh with progress tracking
@@ -2253,15 +2180,33 @@ static char tempEarlyPlaybackChannelKey;
     // Delete cached movie info files
     [self clearMovieInfoCache];
     
-    // Process in batches to avoid overwhelming the system
-    const NSInteger BATCH_SIZE = 5;
-    const CGFloat DELAY_BETWEEN_BATCHES = 2.0; // seconds
+    // Always fetch fresh data (no cache check since this is a forced refresh)
+    NSArray *orderedChannels = [self movieChannelsVisibleFirst:movieChannels];
+    VLCScheduledTask *task = [[VLCScheduledTask alloc] initWithName:@"Movie info refresh"
+                                                           priority:VLCTaskPriorityNormal
+                                                         totalUnits:orderedChannels.count
+                                                               step:^(NSRange range) {
+        for (NSUInteger i = range.location; i < NSMaxRange(range); i++) {
+            [self fetchMovieInfoAndCoverForChannel:[orderedChannels objectAtIndex:i]];
+        }
+    }];
+    task.maxUnitsPerSecond = kMovieInfoFetchesPerSecond;
     
-    // Start batch processing with a short delay
-    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), 
-                  dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
-        [self processBatchOfMovieChannelsWithProgress:movieChannels batchSize:BATCH_SIZE delayBetweenBatches:DELAY_BETWEEN_BATCHES currentIndex:0];
-    });
+    // Progress redraws are rate-limited by the scheduler
+    task.progressBlock = ^(NSUInteger completedUnits, NSUInteger totalUnits) {
+        self.movieRefreshCompleted = completedUnits;
+        [self setNeedsDisplay:YES];
+    };
+    
+    // Reset refresh state once every channel has been requested
+    task.completionBlock = ^(VLCScheduledTask *finishedTask) {
+        self.isRefreshingMovieInfo = NO;
+        self.movieRefreshCompleted = self.movieRefreshTotal;
+        [self setNeedsDisplay:YES];
+    };
+    
+    [[VLCTaskScheduler sharedScheduler] addTask:task];
+    [task release];
 }
 
 // Add method to force refresh all movie info and covers (legacy method)
@@ -14,6 +14,7 @@
 - (void)playCatchUpFromMenu:(NSMenuItem *)sender;
 - (void)playChannelFromEpgMenu:(NSMenuItem *)sender;
 - (NSInteger)findChannelIndexForChannel:(VLCChannel *)targetChannel;
+- (NSString *)getCurrentGroupName;
 
 // Timeshift methods
 - (void)showTimeshiftOptionsForChannel:(NSMenuItem *)sender;
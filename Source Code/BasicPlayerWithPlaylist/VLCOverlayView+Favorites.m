@@ -116,9 +116,9 @@ typedef enum {
         favoriteChannel.hasStartedFetchingMovieInfo = channel.hasStartedFetchingMovieInfo;
         favoriteChannel.cachedPosterImage = channel.cachedPosterImage;
                 
-                // CRITICAL FIX: Copy EPG programs from original channel
+                // Share the original channel's EPG programs; guide lists are immutable
                 if (channel.programs && channel.programs.count > 0) {
-                    favoriteChannel.programs = [channel.programs mutableCopy];
+                    favoriteChannel.programs = channel.programs;
                     //NSLog(@"📅 [FAVORITES] Copied %lu EPG programs to favorite channel: %@", 
                           //(unsigned long)channel.programs.count, channel.name);
                 } else {
@@ -296,9 +296,9 @@ typedef enum {
                 favoriteChannel.hasStartedFetchingMovieInfo = originalChannel.hasStartedFetchingMovieInfo;
                 favoriteChannel.cachedPosterImage = originalChannel.cachedPosterImage;
                         
-                        // CRITICAL FIX: Copy EPG programs from original channel
+                        // Share the original channel's EPG programs; guide lists are immutable
                         if (originalChannel.programs && originalChannel.programs.count > 0) {
-                            favoriteChannel.programs = [originalChannel.programs mutableCopy];
+                            favoriteChannel.programs = originalChannel.programs;
                             //NSLog(@"📅 [FAVORITES] Copied %lu EPG programs to favorite channel: %@", 
                                  // (unsigned long)originalChannel.programs.count, originalChannel.name);
                         } else {
@@ -533,7 +533,7 @@ typedef enum {
             VLCChannel *mainChannel = [self findMainChannelWithId:favChannel.channelId url:favChannel.url];
             if (mainChannel && mainChannel.programs && mainChannel.programs.count > 0) {
                 // Update favorite channel with EPG data
-                favChannel.programs = [mainChannel.programs mutableCopy];
+                favChannel.programs = mainChannel.programs;
                 updatedChannels++;
                 totalPrograms += mainChannel.programs.count;
                 //NSLog(@"📅 [FAVORITES] Updated %@ with %lu EPG programs", 
@@ -2,6 +2,7 @@
 
 #if TARGET_OS_OSX
 #import "VLCOverlayView_Private.h"
+#import "VLCEPGManager.h"
 #import "VLCSubtitleSettings.h"
 #import <objc/runtime.h>
 
@@ -1988,9 +1989,10 @@ static NSTimeInterval lastMouseMoveTime = 0;
             //NSLog(@"EPG Info: Using real-time calculation (cached: %@, timeshift: %@, startup: %@)", 
             //      cachedProgramInfo ? @"YES" : @"NO", isActuallyTimeshift ? @"YES" : @"NO", isInStartupMode ? @"YES" : @"NO");
             // Fallback to real-time calculation
-            // The currentProgramWithTimeOffset method automatically calculates the current program
-            // based on the current time, so calling it refreshes the information
-            currentProgram = [currentChannel currentProgramWithTimeOffset:self.epgTimeOffsetHours];
+            // The now/next table already holds the current program (it advances when a
+            // programme ends), so this is a lookup rather than a search every second
+            currentProgram = [self.dataManager.epgManager currentProgramForChannel:currentChannel
+                                                                   timeOffsetHours:self.epgTimeOffsetHours];
         }
         
         // Log program changes for debugging
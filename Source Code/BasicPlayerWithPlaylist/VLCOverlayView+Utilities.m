@@ -2,6 +2,7 @@
 
 #if TARGET_OS_OSX
 #import "VLCOverlayView_Private.h"
+#import "VLCChannelStore.h"
 
 @implementation VLCOverlayView (Utilities)
 
@@ -1061,13 +1062,14 @@
         [favoritesData setObject:favoriteGroups forKey:@"groups"];
         
         NSMutableArray *favoriteChannels = [NSMutableArray array];
+        VLCURLPrefixEncoder *urlEncoder = [[[VLCURLPrefixEncoder alloc] init] autorelease];
         for (NSString *group in favoriteGroups) {
             NSArray *groupChannels = [self.channelsByGroup objectForKey:group];
             if (groupChannels) {
                 for (VLCChannel *channel in groupChannels) {
                     NSMutableDictionary *channelDict = [NSMutableDictionary dictionary];
                     [channelDict setObject:(channel.name ? channel.name : @"") forKey:@"name"];
-                    [channelDict setObject:(channel.url ? channel.url : @"") forKey:@"url"];
+                    [urlEncoder setURL:(channel.url ? channel.url : @"") inDictionary:channelDict];
                     [channelDict setObject:(channel.group ? channel.group : @"") forKey:@"group"];
                     if (channel.logo) [channelDict setObject:channel.logo forKey:@"logo"];
                     if (channel.channelId) [channelDict setObject:channel.channelId forKey:@"channelId"];
@@ -1103,6 +1105,7 @@
         }
         if (favoriteChannels.count > 0) {
             [favoritesData setObject:favoriteChannels forKey:@"channels"];
+            [favoritesData setObject:urlEncoder.prefixes forKey:@"urlPrefixes"];
         }
         
         // Store the favorites data
@@ -1190,13 +1193,14 @@
         // Restore favorite channels
         NSArray *favoriteChannels = [favoritesData objectForKey:@"channels"];
         if (favoriteChannels && [favoriteChannels isKindOfClass:[NSArray class]]) {
+            VLCURLPrefixEncoder *urlEncoder = [[[VLCURLPrefixEncoder alloc] initWithPrefixes:[favoritesData objectForKey:@"urlPrefixes"]] autorelease];
             for (NSDictionary *channelDict in favoriteChannels) {
                 if (![channelDict isKindOfClass:[NSDictionary class]]) continue;
                 
                 // Create a new channel object
                 VLCChannel *channel = [[VLCChannel alloc] init];
                 channel.name = [channelDict objectForKey:@"name"];
-                channel.url = [channelDict objectForKey:@"url"];
+                channel.url = [urlEncoder URLFromDictionary:channelDict];
                 channel.group = [channelDict objectForKey:@"group"];
                 channel.logo = [channelDict objectForKey:@"logo"];
                 channel.channelId = [channelDict objectForKey:@"channelId"];
@@ -16,12 +16,14 @@
 #import "VLCOverlayView+Utilities.h"
 #import "VLCOverlayView+UI.h"
 #import "VLCOverlayView+ChannelManagement.h"
+#import "VLCOverlayView+ContextMenu.h"
 // #import "VLCOverlayView+EPG.h" - REMOVED: Old EPG system eliminated
 #import "VLCOverlayView+Favorites.h"
 #import "VLCOverlayView+PlayerControls.h"
 #import "VLCOverlayView+Theming.h"
 #import "VLCOverlayView+Glassmorphism.h"
 #import "VLCDataManager.h"
+#import "VLCNowNextTable.h"
 
 
 // Implementation of global progress message
@@ -34,6 +36,7 @@ NSInteger hoveredCatchupProgramIndex = -1;
 @implementation VLCOverlayView
 
 @synthesize hoveredChannelIndex = _hoveredChannelIndex;
+@synthesize selectedGroupIndex = _selectedGroupIndex;
 
 // Data manager property accessor
 - (VLCDataManager *)dataManager {
@@ -68,6 +71,12 @@ NSInteger hoveredCatchupProgramIndex = -1;
     //NSLog(@"🔧 SETTER: Successfully set hover index to %ld", (long)_hoveredChannelIndex);
 }
 
+// Custom setter for selectedGroupIndex so background work starts with the group on screen
+- (void)setSelectedGroupIndex:(NSInteger)newIndex {
+    _selectedGroupIndex = newIndex;
+    _dataManager.visibleGroup = newIndex >= 0 ? [self getCurrentGroupName] : nil;
+}
+
 #pragma mark - Initialization
 
 - (instancetype)initWithFrame:(NSRect)frame {
@@ -188,6 +197,12 @@ NSInteger hoveredCatchupProgramIndex = -1;
                                                      name:@"VLCEPGMatchingProgress" 
                                                    object:nil];
         
+        // Programmes changed on some channels (a show ended somewhere)
+        [[NSNotificationCenter defaultCenter] addObserver:self 
+                                                 selector:@selector(nowNextTableDidChange:) 
+                                                     name:VLCNowNextTableDidChangeNotification 
+                                                   object:nil];
+        
         // Show menu initially with basic structure (especially Settings for configuration)
         self.isChannelListVisible = YES;
         
@@ -985,6 +1000,11 @@ NSInteger hoveredCatchupProgramIndex = -1;
     });
 }
 
+- (void)nowNextTableDidChange:(NSNotification *)notification {
+    // Posted on the main thread, only when a programme actually ended somewhere
+    [self setNeedsDisplay:YES];
+}
+
 - (void)epgMatchingCompleted:(NSNotification *)notification {
     NSLog(@"📅 [MAC-UI] EPG matching completed notification received - refreshing UI");
     
@@ -0,0 +1,41 @@
+//
+//  VLCPlaylistSource.h
+//  BasicPlayerWithPlaylist
+//
+//  Playlist Source - Platform Independent
+//  One M3U provider (or backup line) among several loaded side by side
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface VLCPlaylistSource : NSObject
+
+@property (nonatomic, readonly) NSString *url;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) BOOL primary;              // Groups keep their playlist names
+@property (nonatomic, assign) NSTimeInterval refreshIntervalHours; // 0 = channel cache validity
+
+// Runtime state, not persisted
+@property (nonatomic, strong, nullable) NSDate *lastLoadDate;
+@property (nonatomic, assign) NSUInteger channelCount;
+@property (nonatomic, assign) NSUInteger duplicateCount; // Entries dropped because an earlier source has them
+
+- (instancetype)initWithURL:(NSString *)url name:(nullable NSString *)name;
+
+// Each source has its own channel cache file
+- (NSString *)cacheKey;
+
+// Put before this source's group names ("<prefix>: <group>"); nil for the primary source
+- (nullable NSString *)groupPrefix;
+
+- (BOOL)isDueForRefreshWithDefaultInterval:(NSTimeInterval)defaultIntervalHours;
+
+// User defaults persistence
+- (NSDictionary *)dictionaryRepresentation;
++ (nullable instancetype)sourceWithDictionary:(NSDictionary *)dictionary;
+
+@end
+
+NS_ASSUME_NONNULL_END
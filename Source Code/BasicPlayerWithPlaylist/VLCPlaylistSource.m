@@ -0,0 +1,72 @@
+//
+//  VLCPlaylistSource.m
+//  BasicPlayerWithPlaylist
+//
+//  Playlist Source - Platform Independent
+//  One M3U provider (or backup line) among several loaded side by side
+//
+
+#import "VLCPlaylistSource.h"
+#import "VLCCacheManager.h"
+
+@implementation VLCPlaylistSource
+
+- (instancetype)initWithURL:(NSString *)url name:(NSString *)name {
+    self = [super init];
+    if (self) {
+        _url = [url copy];
+        if (name.length > 0) {
+            _name = [name copy];
+        } else {
+            // Provider host is what users recognize, e.g. "line2.example.com"
+            NSString *host = [NSURL URLWithString:url].host;
+            _name = [(host.length > 0 ? host : url) copy];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_url release];
+    [_name release];
+    [_lastLoadDate release];
+    [super dealloc];
+}
+
+- (NSString *)cacheKey {
+    return [VLCCacheSourceKeyPrefix stringByAppendingString:self.url];
+}
+
+- (NSString *)groupPrefix {
+    return self.primary ? nil : self.name;
+}
+
+- (BOOL)isDueForRefreshWithDefaultInterval:(NSTimeInterval)defaultIntervalHours {
+    if (!self.lastLoadDate) {
+        return YES;
+    }
+    NSTimeInterval intervalHours = self.refreshIntervalHours > 0 ? self.refreshIntervalHours : defaultIntervalHours;
+    return [[NSDate date] timeIntervalSinceDate:self.lastLoadDate] >= intervalHours * 3600.0;
+}
+
+#pragma mark - Persistence
+
+- (NSDictionary *)dictionaryRepresentation {
+    return @{
+        @"url": self.url,
+        @"name": self.name ?: @"",
+        @"refreshIntervalHours": @(self.refreshIntervalHours)
+    };
+}
+
++ (instancetype)sourceWithDictionary:(NSDictionary *)dictionary {
+    NSString *url = [dictionary objectForKey:@"url"];
+    if (![url isKindOfClass:[NSString class]] || url.length == 0) {
+        return nil;
+    }
+    VLCPlaylistSource *source = [[[VLCPlaylistSource alloc] initWithURL:url name:[dictionary objectForKey:@"name"]] autorelease];
+    source.refreshIntervalHours = [[dictionary objectForKey:@"refreshIntervalHours"] doubleValue];
+    return source;
+}
+
+@end
@@ -1,9 +1,23 @@
 #import <Foundation/Foundation.h>
 
+@class VLCProgramStore;
+
+// startTimestamp/endTimestamp value of a time that is not known
+#define VLC_PROGRAM_NO_TIMESTAMP INT64_MIN
+
+// Guide programmes are views over a VLCProgramStore row, created when a list element is read:
+// fields come from the store and archive changes go back to the row. Programmes created with
+// -init keep their own fields, as does a view for any other field that is assigned.
 @interface VLCProgram : NSObject
 
+- (instancetype)initWithStore:(VLCProgramStore *)store channel:(uint32_t)channel row:(uint32_t)row;
+
 @property (nonatomic, retain) NSString *title;
 @property (nonatomic, retain) NSString *programDescription;
+// UTC seconds since 1970; this is what is stored and compared
+@property (nonatomic, assign) int64_t startTimestamp;
+@property (nonatomic, assign) int64_t endTimestamp;
+// NSDate views of the timestamps for display code, created on each access; nil when unknown
 @property (nonatomic, retain) NSDate *startTime;
 @property (nonatomic, retain) NSDate *endTime;
 @property (nonatomic, retain) NSString *channelId;
@@ -1,37 +1,280 @@
 #import "VLCProgram.h"
+#import "VLCProgramStore.h"
 
-@implementation VLCProgram
+// Fields held by the programme itself instead of a store row: every field of a programme
+// created with -init, and values assigned to a view that its row cannot take
+typedef struct {
+    uint32_t localFields;                           // VLCProgramLocalField bits
+    NSString *title;
+    NSString *programDescription;
+    NSString *channelId;
+    NSString *archiveUrl;
+    int64_t startTimestamp;
+    int64_t endTimestamp;
+    BOOL hasArchive;
+    NSInteger archiveDays;
+} VLCProgramLocalFields;
+
+enum {
+    VLCProgramLocalTitle = 1u << 0,
+    VLCProgramLocalDescription = 1u << 1,
+    VLCProgramLocalChannelId = 1u << 2,
+    VLCProgramLocalStart = 1u << 3,
+    VLCProgramLocalEnd = 1u << 4,
+    VLCProgramLocalHasArchive = 1u << 5,
+    VLCProgramLocalArchiveDays = 1u << 6,
+    VLCProgramLocalAll = (1u << 7) - 1
+};
+
+static inline void VLCProgramAssign(NSString **slot, NSString *value) {
+    if (*slot == value) return;
+    NSString *old = *slot;
+    *slot = [value retain];
+    [old release];
+}
+
+@implementation VLCProgram {
+    VLCProgramStore *_store;
+    uint32_t _channel;
+    uint32_t _row;
+    VLCProgramLocalFields *_local;
+}
 
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _title = @"";
-        _programDescription = @"";
-        _startTime = [NSDate date];
-        _endTime = [NSDate dateWithTimeIntervalSinceNow:3600]; // Default 1 hour
-        _channelId = @"";
+        // Standalone programme: every field is local
+        _local = calloc(1, sizeof(VLCProgramLocalFields));
+        if (!_local) {
+            [self release];
+            return nil;
+        }
+        _local->localFields = VLCProgramLocalAll;
+        _local->title = @"";
+        _local->programDescription = @"";
+        _local->channelId = @"";
+        _local->startTimestamp = (int64_t)floor([[NSDate date] timeIntervalSince1970]);
+        _local->endTimestamp = _local->startTimestamp + 3600; // Default 1 hour
+    }
+    return self;
+}
+
+- (instancetype)initWithStore:(VLCProgramStore *)store channel:(uint32_t)channel row:(uint32_t)row {
+    self = [super init];
+    if (self) {
+        _store = [store retain];
+        _channel = channel;
+        _row = row;
     }
     return self;
 }
 
+- (void)dealloc {
+    if (_local) {
+        [_local->title release];
+        [_local->programDescription release];
+        [_local->channelId release];
+        [_local->archiveUrl release];
+        free(_local);
+    }
+    [_store release];
+    [super dealloc];
+}
+
+#pragma mark - Field Storage
+
+// Allocates the local fields once, even when two threads get here at the same time
+- (VLCProgramLocalFields *)localFields {
+    VLCProgramLocalFields *existing = __atomic_load_n(&_local, __ATOMIC_ACQUIRE);
+    if (existing) {
+        return existing;
+    }
+    VLCProgramLocalFields *fresh = calloc(1, sizeof(VLCProgramLocalFields));
+    if (__atomic_compare_exchange_n(&_local, &existing, fresh, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return fresh;
+    }
+    free(fresh);
+    return existing;
+}
+
+- (BOOL)hasLocalField:(uint32_t)field {
+    VLCProgramLocalFields *local = __atomic_load_n(&_local, __ATOMIC_ACQUIRE);
+    return local && (__atomic_load_n(&local->localFields, __ATOMIC_ACQUIRE) & field);
+}
+
+- (void)markLocalField:(uint32_t)field local:(BOOL)isLocal {
+    if (isLocal) {
+        __atomic_fetch_or(&[self localFields]->localFields, field, __ATOMIC_RELEASE);
+    } else if (_local) {
+        __atomic_fetch_and(&_local->localFields, ~field, __ATOMIC_RELEASE);
+    }
+}
+
+#pragma mark - Fields
+
+- (NSString *)title {
+    if ([self hasLocalField:VLCProgramLocalTitle]) return _local->title;
+    return [_store titleForChannel:_channel row:_row];
+}
+
+- (void)setTitle:(NSString *)title {
+    VLCProgramAssign(&[self localFields]->title, title);
+    [self markLocalField:VLCProgramLocalTitle local:YES];
+}
+
+- (NSString *)programDescription {
+    if ([self hasLocalField:VLCProgramLocalDescription]) return _local->programDescription;
+    return [_store programDescriptionForChannel:_channel row:_row];
+}
+
+- (void)setProgramDescription:(NSString *)programDescription {
+    VLCProgramAssign(&[self localFields]->programDescription, programDescription);
+    [self markLocalField:VLCProgramLocalDescription local:YES];
+}
+
+- (NSString *)channelId {
+    if ([self hasLocalField:VLCProgramLocalChannelId]) return _local->channelId;
+    return [_store channelIdForChannel:_channel];
+}
+
+- (void)setChannelId:(NSString *)channelId {
+    VLCProgramAssign(&[self localFields]->channelId, channelId);
+    [self markLocalField:VLCProgramLocalChannelId local:YES];
+}
+
+- (NSString *)archiveUrl {
+    VLCProgramLocalFields *local = __atomic_load_n(&_local, __ATOMIC_ACQUIRE);
+    return local ? local->archiveUrl : nil;
+}
+
+- (void)setArchiveUrl:(NSString *)archiveUrl {
+    VLCProgramAssign(&[self localFields]->archiveUrl, archiveUrl);
+}
+
+- (BOOL)hasArchive {
+    if ([self hasLocalField:VLCProgramLocalHasArchive]) return _local->hasArchive;
+    return [_store hasArchiveForChannel:_channel row:_row];
+}
+
+- (void)setHasArchive:(BOOL)hasArchive {
+    if (_store) {
+        [_store setHasArchive:hasArchive forChannel:_channel row:_row];
+        [self markLocalField:VLCProgramLocalHasArchive local:NO];
+        return;
+    }
+    [self localFields]->hasArchive = hasArchive;
+}
+
+- (NSInteger)archiveDays {
+    if ([self hasLocalField:VLCProgramLocalArchiveDays]) return _local->archiveDays;
+    return [_store archiveDaysForChannel:_channel row:_row];
+}
+
+- (void)setArchiveDays:(NSInteger)archiveDays {
+    if (_store && [_store setArchiveDays:archiveDays forChannel:_channel row:_row]) {
+        [self markLocalField:VLCProgramLocalArchiveDays local:NO];
+        return;
+    }
+    [self localFields]->archiveDays = archiveDays;
+    [self markLocalField:VLCProgramLocalArchiveDays local:YES];
+}
+
+#pragma mark - Time Accessors
+
+- (int64_t)startTimestamp {
+    if ([self hasLocalField:VLCProgramLocalStart]) return _local->startTimestamp;
+    return _store ? [_store startTimestampForChannel:_channel row:_row] : VLC_PROGRAM_NO_TIMESTAMP;
+}
+
+// Times stay local on views: the row's place in its start-ordered table must not change
+- (void)setStartTimestamp:(int64_t)startTimestamp {
+    [self localFields]->startTimestamp = startTimestamp;
+    [self markLocalField:VLCProgramLocalStart local:YES];
+}
+
+- (int64_t)endTimestamp {
+    if ([self hasLocalField:VLCProgramLocalEnd]) return _local->endTimestamp;
+    return _store ? [_store endTimestampForChannel:_channel row:_row] : VLC_PROGRAM_NO_TIMESTAMP;
+}
+
+- (void)setEndTimestamp:(int64_t)endTimestamp {
+    [self localFields]->endTimestamp = endTimestamp;
+    [self markLocalField:VLCProgramLocalEnd local:YES];
+}
+
+static NSDate *VLCProgramDateFromTimestamp(int64_t timestamp) {
+    if (timestamp == VLC_PROGRAM_NO_TIMESTAMP) {
+        return nil;
+    }
+    return [NSDate dateWithTimeIntervalSince1970:(NSTimeInterval)timestamp];
+}
+
+static int64_t VLCProgramTimestampFromDate(NSDate *date) {
+    if (!date) {
+        return VLC_PROGRAM_NO_TIMESTAMP;
+    }
+    return (int64_t)floor([date timeIntervalSince1970]);
+}
+
+- (NSDate *)startTime {
+    return VLCProgramDateFromTimestamp(self.startTimestamp);
+}
+
+- (void)setStartTime:(NSDate *)startTime {
+    self.startTimestamp = VLCProgramTimestampFromDate(startTime);
+}
+
+- (NSDate *)endTime {
+    return VLCProgramDateFromTimestamp(self.endTimestamp);
+}
+
+- (void)setEndTime:(NSDate *)endTime {
+    self.endTimestamp = VLCProgramTimestampFromDate(endTime);
+}
+
+#pragma mark - Identity
+
+// Views of the same row are the same programme, whichever list access created them
+- (BOOL)isEqual:(id)object {
+    if (object == self) {
+        return YES;
+    }
+    if (!_store || ![object isKindOfClass:[VLCProgram class]]) {
+        return NO;
+    }
+    VLCProgram *other = (VLCProgram *)object;
+    return other->_store == _store && other->_channel == _channel && other->_row == _row;
+}
+
+- (NSUInteger)hash {
+    if (!_store) {
+        return [super hash];
+    }
+    return (NSUInteger)_store ^ (((NSUInteger)_channel << 20) + _row);
+}
+
+#pragma mark - Formatting
+
 - (NSString *)formattedTimeRange {
+    NSDate *startTime = self.startTime;
+    NSDate *endTime = self.endTime;
     NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
     [formatter setDateFormat:@"HH:mm"];
     
     NSString *timeRange;
     
-    if (_endTime) {
+    if (endTime) {
         // Normal case with both start and end times
         timeRange = [NSString stringWithFormat:@"%@ - %@", 
-                     [formatter stringFromDate:_startTime],
-                     [formatter stringFromDate:_endTime]];
+                     [formatter stringFromDate:startTime],
+                     [formatter stringFromDate:endTime]];
     } else {
         // Handle missing end time - estimate 1 hour duration
         //NSLog(@"Warning: Missing end time for program '%@' starting at %@", _title, _startTime);
         
-        NSDate *estimatedEndTime = [_startTime dateByAddingTimeInterval:3600]; // 1 hour
+        NSDate *estimatedEndTime = [startTime dateByAddingTimeInterval:3600]; // 1 hour
         timeRange = [NSString stringWithFormat:@"%@ - %@", 
-                     [formatter stringFromDate:_startTime],
+                     [formatter stringFromDate:startTime],
                      [formatter stringFromDate:estimatedEndTime]];
     }
     
@@ -46,13 +289,14 @@
     // Apply offset in seconds (hours * 3600)
     NSTimeInterval offsetSeconds = offsetHours * 3600;
     
-    NSDate *adjustedStartTime = [_startTime dateByAddingTimeInterval:offsetSeconds];
+    NSDate *adjustedStartTime = [self.startTime dateByAddingTimeInterval:offsetSeconds];
+    NSDate *endTime = self.endTime;
     
     NSString *timeRange;
     
-    if (_endTime) {
+    if (endTime) {
         // Normal case with both start and end times
-        NSDate *adjustedEndTime = [_endTime dateByAddingTimeInterval:offsetSeconds];
+        NSDate *adjustedEndTime = [endTime dateByAddingTimeInterval:offsetSeconds];
         timeRange = [NSString stringWithFormat:@"%@ - %@", 
                      [formatter stringFromDate:adjustedStartTime],
                      [formatter stringFromDate:adjustedEndTime]];
@@ -73,7 +317,7 @@
 
 - (NSString *)description {
     return [NSString stringWithFormat:@"%@: %@ (%@)", 
-           [self formattedTimeRange], _title, _programDescription];
+           [self formattedTimeRange], self.title, self.programDescription];
 }
 
 + (BOOL)hasArchiveForProgramObject:(id)programObject {
@@ -88,13 +332,4 @@
     return NO;
 }
 
-- (void)dealloc {
-    [_title release];
-    [_programDescription release];
-    [_startTime release];
-    [_endTime release];
-    [_channelId release];
-    [super dealloc];
-}
-
 @end 
\ No newline at end of file
@@ -0,0 +1,188 @@
+//
+//  VLCProgramIndex.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable Programme Interval Index - Platform Independent (plain C)
+//  One channel's programmes sorted by start time with a running maximum of end times, so
+//  "what is on at T" and "what overlaps [A, B)" are binary searches that allocate nothing
+//
+
+#include "VLCProgramIndex.h"
+
+#include <stdlib.h>
+
+// Struct of arrays, sorted by (start, position). maxEnd[i] is the latest end among entries
+// 0...i; it never decreases, so the first entry that can still be on air at T is a binary
+// search away even when programmes overlap.
+struct VLCProgramIndex {
+    size_t count;
+    int64_t *start;
+    int64_t *end;
+    int64_t *maxEnd;
+    uint32_t *position;
+};
+
+typedef struct {
+    int64_t start;
+    int64_t end;
+    uint32_t position;
+} VLCProgramIndexEntry;
+
+static int VLCProgramIndexEntryCompare(const void *a, const void *b) {
+    const VLCProgramIndexEntry *left = a;
+    const VLCProgramIndexEntry *right = b;
+    if (left->start != right->start) {
+        return left->start < right->start ? -1 : 1;
+    }
+    return left->position < right->position ? -1 : (left->position > right->position);
+}
+
+#pragma mark - Lifecycle
+
+VLCProgramIndex *VLCProgramIndexCreate(const VLCProgramInterval *intervals, size_t count) {
+    if (count > UINT32_MAX) {
+        return NULL;
+    }
+    VLCProgramIndex *index = calloc(1, sizeof(VLCProgramIndex));
+    VLCProgramIndexEntry *entries = malloc((count ? count : 1) * sizeof(VLCProgramIndexEntry));
+    if (!index || !entries) {
+        free(index);
+        free(entries);
+        return NULL;
+    }
+
+    size_t kept = 0;
+    int sorted = 1;
+    for (size_t i = 0; i < count; i++) {
+        if (intervals[i].start == VLC_PROGRAM_INDEX_NO_TIME || intervals[i].end == VLC_PROGRAM_INDEX_NO_TIME) {
+            continue;
+        }
+        if (kept > 0 && intervals[i].start < entries[kept - 1].start) {
+            sorted = 0;
+        }
+        entries[kept].start = intervals[i].start;
+        entries[kept].end = intervals[i].end;
+        entries[kept].position = (uint32_t)i;
+        kept++;
+    }
+    // Guides are nearly always in order already
+    if (!sorted) {
+        qsort(entries, kept, sizeof(VLCProgramIndexEntry), VLCProgramIndexEntryCompare);
+    }
+
+    size_t columns = kept ? kept : 1;
+    index->start = malloc(columns * sizeof(int64_t));
+    index->end = malloc(columns * sizeof(int64_t));
+    index->maxEnd = malloc(columns * sizeof(int64_t));
+    index->position = malloc(columns * sizeof(uint32_t));
+    if (!index->start || !index->end || !index->maxEnd || !index->position) {
+        free(entries);
+        VLCProgramIndexFree(index);
+        return NULL;
+    }
+
+    int64_t maxEnd = INT64_MIN;
+    for (size_t i = 0; i < kept; i++) {
+        index->start[i] = entries[i].start;
+        index->end[i] = entries[i].end;
+        if (entries[i].end > maxEnd) {
+            maxEnd = entries[i].end;
+        }
+        index->maxEnd[i] = maxEnd;
+        index->position[i] = entries[i].position;
+    }
+    index->count = kept;
+    free(entries);
+    return index;
+}
+
+void VLCProgramIndexFree(VLCProgramIndex *index) {
+    if (!index) {
+        return;
+    }
+    free(index->start);
+    free(index->end);
+    free(index->maxEnd);
+    free(index->position);
+    free(index);
+}
+
+size_t VLCProgramIndexCount(const VLCProgramIndex *index) {
+    return index ? index->count : 0;
+}
+
+#pragma mark - Searching
+
+// Entries whose start is <= time (inclusive) or < time (exclusive)
+static size_t VLCProgramIndexStartsBefore(const VLCProgramIndex *index, int64_t time, int inclusive) {
+    size_t low = 0;
+    size_t high = index->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int64_t start = index->start[middle];
+        if (start < time || (inclusive && start == time)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// First entry in [0, limit) with maxEnd > time; limit when there is none
+static size_t VLCProgramIndexFirstEndingAfter(const VLCProgramIndex *index, int64_t time, size_t limit) {
+    size_t low = 0;
+    size_t high = limit;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (index->maxEnd[middle] > time) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+size_t VLCProgramIndexFind(const VLCProgramIndex *index, int64_t time) {
+    if (!index || index->count == 0) {
+        return VLC_PROGRAM_INDEX_NONE;
+    }
+    size_t limit = VLCProgramIndexStartsBefore(index, time, 1);
+    size_t first = VLCProgramIndexFirstEndingAfter(index, time, limit);
+    // maxEnd only rose above time at this entry, so its own end is what did it
+    return first < limit ? index->position[first] : VLC_PROGRAM_INDEX_NONE;
+}
+
+size_t VLCProgramIndexFindNext(const VLCProgramIndex *index, int64_t time) {
+    if (!index) {
+        return VLC_PROGRAM_INDEX_NONE;
+    }
+    size_t next = VLCProgramIndexStartsBefore(index, time, 1);
+    return next < index->count ? index->position[next] : VLC_PROGRAM_INDEX_NONE;
+}
+
+size_t VLCProgramIndexFindLast(const VLCProgramIndex *index) {
+    if (!index || index->count == 0) {
+        return VLC_PROGRAM_INDEX_NONE;
+    }
+    return index->position[index->count - 1];
+}
+
+size_t VLCProgramIndexFindRange(const VLCProgramIndex *index, int64_t start, int64_t end,
+                                size_t *positions, size_t capacity) {
+    if (!index || end <= start) {
+        return 0;
+    }
+    size_t limit = VLCProgramIndexStartsBefore(index, end, 0);
+    size_t found = 0;
+    for (size_t i = VLCProgramIndexFirstEndingAfter(index, start, limit); i < limit; i++) {
+        if (index->end[i] > start) {
+            if (found < capacity) {
+                positions[found] = index->position[i];
+            }
+            found++;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,65 @@
+//
+//  VLCProgramIndex.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable Programme Interval Index - Platform Independent (plain C)
+//  One channel's programmes sorted by start time with a running maximum of end times, so
+//  "what is on at T" and "what overlaps [A, B)" are binary searches that allocate nothing
+//
+
+#ifndef VLCProgramIndex_h
+#define VLCProgramIndex_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Start or end of a programme whose time is not known (same value as VLC_PROGRAM_NO_TIMESTAMP)
+#define VLC_PROGRAM_INDEX_NO_TIME INT64_MIN
+
+// Result of a lookup that found nothing
+#define VLC_PROGRAM_INDEX_NONE SIZE_MAX
+
+// UTC seconds; a programme covers start <= t < end
+typedef struct {
+    int64_t start;
+    int64_t end;
+} VLCProgramInterval;
+
+typedef struct VLCProgramIndex VLCProgramIndex;
+
+/**
+ * Indexes intervals[0..count). Results are positions in that array. Intervals with an unknown
+ * start or end are left out, as no time query can match them.
+ * @return NULL on allocation failure or more than UINT32_MAX intervals.
+ */
+VLCProgramIndex *VLCProgramIndexCreate(const VLCProgramInterval *intervals, size_t count);
+void VLCProgramIndexFree(VLCProgramIndex *index);
+
+// Intervals that made it into the index
+size_t VLCProgramIndexCount(const VLCProgramIndex *index);
+
+// Position of the programme on air at time; the earliest starting one when several overlap
+size_t VLCProgramIndexFind(const VLCProgramIndex *index, int64_t time);
+
+// Position of the first programme starting after time
+size_t VLCProgramIndexFindNext(const VLCProgramIndex *index, int64_t time);
+
+// Position of the programme that starts last
+size_t VLCProgramIndexFindLast(const VLCProgramIndex *index);
+
+/**
+ * Writes the positions of programmes overlapping [start, end), in start order, up to capacity.
+ * @return The number of overlapping programmes, which may exceed capacity.
+ */
+size_t VLCProgramIndexFindRange(const VLCProgramIndex *index, int64_t start, int64_t end,
+                                size_t *positions, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCProgramIndex_h */
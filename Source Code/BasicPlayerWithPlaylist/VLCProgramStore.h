@@ -0,0 +1,127 @@
+//
+//  VLCProgramStore.h
+//  BasicPlayerWithPlaylist
+//
+//  Columnar Programme Store - Platform Independent
+//  Keeps each channel's guide as one contiguous table sorted by start time; VLCProgram
+//  objects are views that read a row on demand
+//
+
+#import <Foundation/Foundation.h>
+#import "VLCProgram.h"
+#import "VLCProgramIndex.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define VLC_PROGRAM_STORE_NO_CHANNEL UINT32_MAX
+
+// Input for one appended programme. Strings are copied into the store's string pool.
+typedef struct {
+    int64_t startTimestamp;             // VLC_PROGRAM_NO_TIMESTAMP when unknown
+    int64_t endTimestamp;
+    const char * _Nullable title;
+    size_t titleLength;
+    const char * _Nullable programDescription;
+    size_t programDescriptionLength;
+    BOOL hasArchive;
+    NSInteger archiveDays;
+} VLCProgramStoreRow;
+
+// Whether a programme lies in a retention window: it ends after pastCutoff (or, with no end
+// known, starts after it) and does not start at or after futureCutoff. Programmes with no
+// time at all lie outside every window.
+static inline BOOL VLCProgramInRetentionWindow(int64_t start, int64_t end, int64_t pastCutoff, int64_t futureCutoff) {
+    int64_t last = end != VLC_PROGRAM_NO_TIMESTAMP ? end : start;
+    if (last == VLC_PROGRAM_NO_TIMESTAMP || last <= pastCutoff) {
+        return NO;
+    }
+    return start == VLC_PROGRAM_NO_TIMESTAMP || start < futureCutoff;
+}
+
+/**
+ * Filled by one thread, then sealed with -finishAppending. After that the store is read only
+ * (apart from the archive columns, whose setters are thread safe) and can be shared freely.
+ */
+@interface VLCProgramStore : NSObject
+
+@property (nonatomic, readonly) NSUInteger channelCount;
+@property (nonatomic, readonly) NSUInteger programCount;
+
+// Bytes held by the tables and the string pool (excluding views and lists)
+@property (nonatomic, readonly) size_t bytesAllocated;
+
+// Index of the channel's table, created empty on first use; VLC_PROGRAM_STORE_NO_CHANNEL when out of memory
+- (uint32_t)channelIndexForId:(NSString *)channelId;
+
+// Returns NO when memory runs out. Titles and descriptions over 64 KB are cut at a character boundary.
+- (BOOL)appendRow:(const VLCProgramStoreRow *)row toChannel:(uint32_t)channel;
+
+// Sorts every table by start time, trims growth slack and frees the string intern index
+- (void)finishAppending;
+
+// Channel id -> VLCProgramList for every channel, including channels without programmes.
+// Lists keep the store alive. Call after -finishAppending.
+- (NSMutableDictionary<NSString *, NSArray<VLCProgram *> *> *)programListsByChannel;
+
+// A new sealed store with only the programmes inside each channel's retention window (see
+// VLCProgramInRetentionWindow); nil when memory runs out
+- (VLCProgramStore * _Nullable)storeKeepingProgramsAfter:(int64_t (^)(NSString *channelId))pastCutoffForChannel
+                                                  before:(int64_t)futureCutoff;
+
+// A new sealed store with copies of the rows these channels hold so far. Unlike the rest of the
+// API it may be used before -finishAppending, by the thread appending. nil when memory runs out.
+- (VLCProgramStore * _Nullable)storeWithRowsOfChannels:(NSIndexSet *)channels;
+
+/**
+ * Merges sealed stores, highest priority first, into a new sealed store (a single store is
+ * returned as is). Each channel keeps every programme of the first store that has it; later
+ * stores only fill the gaps, with programmes that overlap none taken so far. Programmes without
+ * a start cannot fill a gap. nil when memory runs out.
+ * @param droppedCount Optional; gets how many programmes of later stores overlapped.
+ */
++ (VLCProgramStore * _Nullable)storeMergingStores:(NSArray<VLCProgramStore *> *)stores
+                                     droppedCount:(NSUInteger * _Nullable)droppedCount;
+
+/**
+ * Refreshes this sealed store with a newer guide into a new sealed store. A channel keeps its
+ * programmes that ended before the newer guide's first start (guides drop what has aired;
+ * catch-up still wants it) and takes the newer guide's from there. Channels the newer guide
+ * lacks keep theirs. Programmes the two have in common keep their archive columns. Only
+ * programmes inside each channel's retention window are kept. nil when memory runs out.
+ */
+- (VLCProgramStore * _Nullable)storeUpdatedWithStore:(VLCProgramStore *)newer
+                                keepingProgramsAfter:(int64_t (^)(NSString *channelId))pastCutoffForChannel
+                                              before:(int64_t)futureCutoff;
+
+// Ids of the channels whose programmes differ from older's (times, titles or descriptions),
+// including channels only one of the two has. Both stores must be sealed.
+- (NSMutableSet<NSString *> *)channelIdsChangedFromStore:(VLCProgramStore *)older;
+
+// Row accessors used by VLCProgram and VLCProgramList
+- (uint32_t)programCountForChannel:(uint32_t)channel;
+- (NSString *)channelIdForChannel:(uint32_t)channel;
+- (int64_t)startTimestampForChannel:(uint32_t)channel row:(uint32_t)row;
+- (int64_t)endTimestampForChannel:(uint32_t)channel row:(uint32_t)row;
+- (NSString *)titleForChannel:(uint32_t)channel row:(uint32_t)row;
+- (NSString *)programDescriptionForChannel:(uint32_t)channel row:(uint32_t)row;
+- (BOOL)hasArchiveForChannel:(uint32_t)channel row:(uint32_t)row;
+- (void)setHasArchive:(BOOL)hasArchive forChannel:(uint32_t)channel row:(uint32_t)row;
+- (NSInteger)archiveDaysForChannel:(uint32_t)channel row:(uint32_t)row;
+// Returns NO when the value does not fit the column (0-255 days); the row keeps its value
+- (BOOL)setArchiveDays:(NSInteger)archiveDays forChannel:(uint32_t)channel row:(uint32_t)row;
+
+@end
+
+// Immutable array over one channel's table. Elements are views created on access. One list
+// per guide channel is attached as is to every playlist channel it matches, favorites included.
+@interface VLCProgramList : NSArray<VLCProgram *>
+
+- (instancetype)initWithStore:(VLCProgramStore *)store channel:(uint32_t)channel;
+
+// Interval index over the list, built from the time columns on first use and kept for the
+// list's lifetime, so channels sharing the list share it too. NULL when memory runs out.
+- (const VLCProgramIndex * _Nullable)programIndex;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,800 @@
+//
+//  VLCProgramStore.m
+//  BasicPlayerWithPlaylist
+//
+//  Columnar Programme Store - Platform Independent
+//  Keeps each channel's guide as one contiguous table sorted by start time; VLCProgram
+//  objects are views that read a row on demand
+//
+
+#import "VLCProgramStore.h"
+#import "VLCProgram.h"
+#import "VLCStringPool.h"
+
+enum {
+    VLCProgramStoreFlagHasArchive = 1u << 0
+};
+
+// One channel's programmes, struct of arrays: 26 bytes per programme plus pooled strings
+typedef struct {
+    NSString *channelId;
+    int64_t *start;
+    int64_t *end;
+    VLCStringRef *title;
+    VLCStringRef *programDescription;
+    uint8_t *flags;                 // VLCProgramStoreFlag bits
+    uint8_t *archiveDays;
+    uint32_t count;
+    uint32_t capacity;
+    BOOL sorted;                    // Rows arrived in start order so far
+} VLCProgramTable;
+
+// Guides are mostly UTF-8, but some providers ship Latin-1 while declaring UTF-8
+static NSString *VLCProgramStoreMakeString(const char *bytes, size_t length) {
+    NSString *string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    if (!string) {
+        string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSISOLatin1StringEncoding];
+    }
+    return [string autorelease];
+}
+
+// Interned, so reruns and repeated descriptions share one copy
+static VLCStringRef VLCProgramStoreAddString(VLCStringPool *pool, const char *bytes, size_t length) {
+    if (!bytes || length == 0) {
+        return 0;
+    }
+    if (length > VLC_STRING_POOL_MAX_LENGTH) {
+        length = VLC_STRING_POOL_MAX_LENGTH;
+        while (length > 0 && ((unsigned char)bytes[length] & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+    return VLCStringPoolAdd(pool, bytes, length, 1);
+}
+
+static BOOL VLCProgramTableReserve(VLCProgramTable *table, uint32_t capacity) {
+    if (capacity <= table->capacity) {
+        return YES;
+    }
+    int64_t *start = realloc(table->start, capacity * sizeof(int64_t));
+    if (start) table->start = start;
+    int64_t *end = realloc(table->end, capacity * sizeof(int64_t));
+    if (end) table->end = end;
+    VLCStringRef *title = realloc(table->title, capacity * sizeof(VLCStringRef));
+    if (title) table->title = title;
+    VLCStringRef *programDescription = realloc(table->programDescription, capacity * sizeof(VLCStringRef));
+    if (programDescription) table->programDescription = programDescription;
+    uint8_t *flags = realloc(table->flags, capacity * sizeof(uint8_t));
+    if (flags) table->flags = flags;
+    uint8_t *archiveDays = realloc(table->archiveDays, capacity * sizeof(uint8_t));
+    if (archiveDays) table->archiveDays = archiveDays;
+
+    if (!start || !end || !title || !programDescription || !flags || !archiveDays) {
+        return NO;
+    }
+    table->capacity = capacity;
+    return YES;
+}
+
+static void VLCProgramTableFree(VLCProgramTable *table) {
+    [table->channelId release];
+    free(table->start);
+    free(table->end);
+    free(table->title);
+    free(table->programDescription);
+    free(table->flags);
+    free(table->archiveDays);
+}
+
+typedef struct {
+    int64_t start;
+    uint32_t row;
+} VLCProgramSortKey;
+
+// Ties keep their document order
+static int VLCProgramSortKeyCompare(const void *a, const void *b) {
+    const VLCProgramSortKey *left = a;
+    const VLCProgramSortKey *right = b;
+    if (left->start != right->start) {
+        return left->start < right->start ? -1 : 1;
+    }
+    return left->row < right->row ? -1 : (left->row > right->row);
+}
+
+#define VLC_PROGRAM_TABLE_PERMUTE(column, type, keys, count, scratch) do { \
+    type *source = (type *)(column);                                        \
+    type *target = (type *)(scratch);                                       \
+    for (uint32_t i = 0; i < (count); i++) {                                \
+        target[i] = source[(keys)[i].row];                                  \
+    }                                                                       \
+    memcpy(source, target, (count) * sizeof(type));                         \
+} while (0)
+
+// Returns NO when there is no memory for the sort; the table stays in document order
+static BOOL VLCProgramTableSort(VLCProgramTable *table) {
+    uint32_t count = table->count;
+    if (table->sorted || count < 2) {
+        table->sorted = YES;
+        return YES;
+    }
+    VLCProgramSortKey *keys = malloc(count * sizeof(VLCProgramSortKey));
+    void *scratch = malloc(count * sizeof(int64_t));
+    if (!keys || !scratch) {
+        free(keys);
+        free(scratch);
+        return NO;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        keys[i].start = table->start[i];
+        keys[i].row = i;
+    }
+    qsort(keys, count, sizeof(VLCProgramSortKey), VLCProgramSortKeyCompare);
+
+    VLC_PROGRAM_TABLE_PERMUTE(table->start, int64_t, keys, count, scratch);
+    VLC_PROGRAM_TABLE_PERMUTE(table->end, int64_t, keys, count, scratch);
+    VLC_PROGRAM_TABLE_PERMUTE(table->title, VLCStringRef, keys, count, scratch);
+    VLC_PROGRAM_TABLE_PERMUTE(table->programDescription, VLCStringRef, keys, count, scratch);
+    VLC_PROGRAM_TABLE_PERMUTE(table->flags, uint8_t, keys, count, scratch);
+    VLC_PROGRAM_TABLE_PERMUTE(table->archiveDays, uint8_t, keys, count, scratch);
+
+    free(keys);
+    free(scratch);
+    table->sorted = YES;
+    return YES;
+}
+
+@implementation VLCProgramStore {
+    VLCStringPool *_pool;
+    VLCProgramTable *_tables;
+    uint32_t _tableCount;
+    uint32_t _tableCapacity;
+    NSUInteger _programCount;
+    NSMutableDictionary<NSString *, NSNumber *> *_channelIndexes;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _pool = VLCStringPoolCreate();
+        _channelIndexes = [[NSMutableDictionary alloc] init];
+        if (!_pool) {
+            [self release];
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    VLCStringPoolFree(_pool);
+    for (uint32_t i = 0; i < _tableCount; i++) {
+        VLCProgramTableFree(&_tables[i]);
+    }
+    free(_tables);
+    [_channelIndexes release];
+    [super dealloc];
+}
+
+#pragma mark - Properties
+
+- (NSUInteger)channelCount {
+    return _tableCount;
+}
+
+- (NSUInteger)programCount {
+    return _programCount;
+}
+
+- (size_t)bytesAllocated {
+    size_t bytes = VLCStringPoolBytesAllocated(_pool);
+    bytes += _tableCapacity * sizeof(VLCProgramTable);
+    for (uint32_t i = 0; i < _tableCount; i++) {
+        bytes += _tables[i].capacity * (2 * sizeof(int64_t) + 2 * sizeof(VLCStringRef) + 2 * sizeof(uint8_t));
+    }
+    return bytes;
+}
+
+#pragma mark - Appending
+
+- (uint32_t)channelIndexForId:(NSString *)channelId {
+    NSNumber *existing = [_channelIndexes objectForKey:channelId];
+    if (existing) {
+        return [existing unsignedIntValue];
+    }
+    if (_tableCount == _tableCapacity) {
+        uint32_t capacity = _tableCapacity ? _tableCapacity * 2 : 64;
+        VLCProgramTable *tables = realloc(_tables, capacity * sizeof(VLCProgramTable));
+        if (!tables) {
+            return VLC_PROGRAM_STORE_NO_CHANNEL;
+        }
+        _tables = tables;
+        _tableCapacity = capacity;
+    }
+
+    uint32_t index = _tableCount++;
+    memset(&_tables[index], 0, sizeof(VLCProgramTable));
+    _tables[index].channelId = [channelId copy];
+    _tables[index].sorted = YES;
+    [_channelIndexes setObject:@(index) forKey:_tables[index].channelId];
+    return index;
+}
+
+- (BOOL)appendRow:(const VLCProgramStoreRow *)row toChannel:(uint32_t)channel {
+    VLCProgramTable *table = &_tables[channel];
+    if (table->count == table->capacity &&
+        !VLCProgramTableReserve(table, table->capacity ? table->capacity * 2 : 16)) {
+        return NO;
+    }
+    VLCStringRef title = VLCProgramStoreAddString(_pool, row->title, row->titleLength);
+    VLCStringRef programDescription = VLCProgramStoreAddString(_pool, row->programDescription, row->programDescriptionLength);
+    if (title == VLC_STRING_REF_INVALID || programDescription == VLC_STRING_REF_INVALID) {
+        return NO;
+    }
+
+    uint32_t index = table->count;
+    if (index > 0 && row->startTimestamp < table->start[index - 1]) {
+        table->sorted = NO;
+    }
+    table->start[index] = row->startTimestamp;
+    table->end[index] = row->endTimestamp;
+    table->title[index] = title;
+    table->programDescription[index] = programDescription;
+    table->flags[index] = row->hasArchive ? VLCProgramStoreFlagHasArchive : 0;
+    table->archiveDays[index] = (uint8_t)MAX(0, MIN(UINT8_MAX, row->archiveDays));
+    table->count = index + 1;
+    _programCount++;
+    return YES;
+}
+
+- (void)finishAppending {
+    VLCStringPoolStopInterning(_pool);
+    for (uint32_t i = 0; i < _tableCount; i++) {
+        VLCProgramTable *table = &_tables[i];
+        if (!VLCProgramTableSort(table)) {
+            NSLog(@"⚠️ [EPG] Out of memory sorting programmes of %@", table->channelId);
+        }
+        // Drop the growth slack; a column realloc cannot fail to shrink in a way that loses rows
+        if (table->count > 0 && table->count < table->capacity) {
+            table->capacity = 0;
+            VLCProgramTableReserve(table, table->count);
+            table->capacity = table->count;
+        }
+    }
+}
+
+- (NSMutableDictionary<NSString *, NSArray<VLCProgram *> *> *)programListsByChannel {
+    NSMutableDictionary *lists = [NSMutableDictionary dictionaryWithCapacity:_tableCount];
+    for (uint32_t i = 0; i < _tableCount; i++) {
+        VLCProgramList *list = [[VLCProgramList alloc] initWithStore:self channel:i];
+        [lists setObject:list forKey:_tables[i].channelId];
+        [list release];
+    }
+    return lists;
+}
+
+- (VLCProgramStore *)storeKeepingProgramsAfter:(int64_t (^)(NSString *channelId))pastCutoffForChannel
+                                        before:(int64_t)futureCutoff {
+    VLCProgramStore *store = [[[VLCProgramStore alloc] init] autorelease];
+    for (uint32_t i = 0; i < _tableCount; i++) {
+        if (![self copyTable:i toStore:store pastCutoff:pastCutoffForChannel(_tables[i].channelId) futureCutoff:futureCutoff]) {
+            return nil;
+        }
+    }
+    [store finishAppending];
+    return store;
+}
+
+- (VLCProgramStore *)storeWithRowsOfChannels:(NSIndexSet *)channels {
+    VLCProgramStore *store = [[[VLCProgramStore alloc] init] autorelease];
+    __block BOOL copied = store != nil;
+    [channels enumerateIndexesUsingBlock:^(NSUInteger channel, BOOL *stop) {
+        if (channel < self->_tableCount &&
+            ![self copyTable:(uint32_t)channel toStore:store pastCutoff:INT64_MIN futureCutoff:INT64_MAX]) {
+            copied = NO;
+            *stop = YES;
+        }
+    }];
+    if (!copied) {
+        return nil;
+    }
+    [store finishAppending];
+    return store;
+}
+
+// Appends the table's rows inside the window to a table of the same id in store; INT64_MIN and
+// INT64_MAX copy every row. Returns NO when memory runs out.
+- (BOOL)copyTable:(uint32_t)index toStore:(VLCProgramStore *)store pastCutoff:(int64_t)pastCutoff futureCutoff:(int64_t)futureCutoff {
+    VLCProgramTable *table = &_tables[index];
+    uint32_t channel = [store channelIndexForId:table->channelId];
+    if (channel == VLC_PROGRAM_STORE_NO_CHANNEL) {
+        return NO;
+    }
+    BOOL everyRow = pastCutoff == INT64_MIN && futureCutoff == INT64_MAX;
+    for (uint32_t row = 0; row < table->count; row++) {
+        if (!everyRow && !VLCProgramInRetentionWindow(table->start[row], table->end[row], pastCutoff, futureCutoff)) {
+            continue;
+        }
+        if (![self copyRow:row ofTable:index toStore:store channel:channel]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (BOOL)copyRow:(uint32_t)row ofTable:(uint32_t)index toStore:(VLCProgramStore *)store channel:(uint32_t)channel {
+    VLCProgramStoreRow copied;
+    [self getRow:&copied row:row ofTable:index];
+    return [store appendRow:&copied toChannel:channel];
+}
+
+// Strings point into the pool, which never moves them
+- (void)getRow:(VLCProgramStoreRow *)copied row:(uint32_t)row ofTable:(uint32_t)index {
+    VLCProgramTable *table = &_tables[index];
+    *copied = (VLCProgramStoreRow){
+        .startTimestamp = table->start[row],
+        .endTimestamp = table->end[row],
+        .hasArchive = (__atomic_load_n(&table->flags[row], __ATOMIC_ACQUIRE) & VLCProgramStoreFlagHasArchive) != 0,
+        .archiveDays = __atomic_load_n(&table->archiveDays[row], __ATOMIC_ACQUIRE)
+    };
+    copied->title = VLCStringPoolGet(_pool, table->title[row], &copied->titleLength);
+    copied->programDescription = VLCStringPoolGet(_pool, table->programDescription[row], &copied->programDescriptionLength);
+}
+
+// Time a programme covers when gap filling: a missing or bad end runs to the next start
+static int64_t VLCProgramTableCoveredEnd(const VLCProgramTable *table, uint32_t row) {
+    int64_t start = table->start[row];
+    int64_t end = table->end[row];
+    if (end != VLC_PROGRAM_NO_TIMESTAMP && end > start) {
+        return end;
+    }
+    if (row + 1 < table->count && table->start[row + 1] > start) {
+        return table->start[row + 1];
+    }
+    return start + 1;
+}
+
+typedef struct {
+    int64_t start;
+    int64_t end;
+} VLCProgramInterval;
+
+typedef struct {
+    VLCProgramInterval *intervals;  // Sorted, disjoint
+    size_t count;
+    size_t capacity;
+} VLCProgramCoverage;
+
+static BOOL VLCProgramCoverageReserve(VLCProgramCoverage *coverage, size_t capacity) {
+    if (capacity <= coverage->capacity) {
+        return YES;
+    }
+    VLCProgramInterval *intervals = realloc(coverage->intervals, capacity * sizeof(VLCProgramInterval));
+    if (!intervals) {
+        return NO;
+    }
+    coverage->intervals = intervals;
+    coverage->capacity = capacity;
+    return YES;
+}
+
+// Appends in start order, joining an interval that overlaps or touches the last one
+static void VLCProgramCoverageAppend(VLCProgramCoverage *coverage, int64_t start, int64_t end) {
+    if (coverage->count > 0 && start <= coverage->intervals[coverage->count - 1].end) {
+        VLCProgramInterval *last = &coverage->intervals[coverage->count - 1];
+        last->end = MAX(last->end, end);
+        return;
+    }
+    coverage->intervals[coverage->count++] = (VLCProgramInterval){ start, end };
+}
+
+// The coverage plus the kept rows of table, both in start order, merged into scratch; then swapped
+static BOOL VLCProgramCoverageAddRows(VLCProgramCoverage *coverage, VLCProgramCoverage *scratch,
+                                      const VLCProgramTable *table, const uint32_t *rows, size_t rowCount) {
+    if (!VLCProgramCoverageReserve(scratch, coverage->count + rowCount)) {
+        return NO;
+    }
+    scratch->count = 0;
+    size_t i = 0, j = 0;
+    while (i < coverage->count || j < rowCount) {
+        if (j == rowCount || (i < coverage->count && coverage->intervals[i].start <= table->start[rows[j]])) {
+            VLCProgramCoverageAppend(scratch, coverage->intervals[i].start, coverage->intervals[i].end);
+            i++;
+        } else {
+            VLCProgramCoverageAppend(scratch, table->start[rows[j]], VLCProgramTableCoveredEnd(table, rows[j]));
+            j++;
+        }
+    }
+    VLCProgramCoverage swapped = *coverage;
+    *coverage = *scratch;
+    *scratch = swapped;
+    return YES;
+}
+
++ (VLCProgramStore *)storeMergingStores:(NSArray<VLCProgramStore *> *)stores droppedCount:(NSUInteger *)droppedCount {
+    if (droppedCount) {
+        *droppedCount = 0;
+    }
+    if (stores.count == 1) {
+        return stores[0];
+    }
+    VLCProgramStore *merged = [[[VLCProgramStore alloc] init] autorelease];
+    if (!merged) {
+        return nil;
+    }
+    
+    // Channel ids in the order the stores first have them
+    NSMutableArray<NSString *> *channelIds = [NSMutableArray array];
+    NSMutableSet<NSString *> *seen = [NSMutableSet set];
+    for (VLCProgramStore *store in stores) {
+        for (uint32_t i = 0; i < store->_tableCount; i++) {
+            if (![seen containsObject:store->_tables[i].channelId]) {
+                [seen addObject:store->_tables[i].channelId];
+                [channelIds addObject:store->_tables[i].channelId];
+            }
+        }
+    }
+    
+    VLCProgramCoverage coverage = { NULL, 0, 0 };
+    VLCProgramCoverage scratch = { NULL, 0, 0 };
+    uint32_t *keptRows = NULL;
+    uint32_t keptCapacity = 0;
+    NSUInteger dropped = 0;
+    BOOL failed = NO;
+    
+    for (NSString *channelId in channelIds) {
+        uint32_t channel = [merged channelIndexForId:channelId];
+        if (channel == VLC_PROGRAM_STORE_NO_CHANNEL) {
+            failed = YES;
+            break;
+        }
+        coverage.count = 0;
+        BOOL firstTable = YES;
+        for (VLCProgramStore *store in stores) {
+            NSNumber *index = [store->_channelIndexes objectForKey:channelId];
+            if (!index) {
+                continue;
+            }
+            const VLCProgramTable *table = &store->_tables[[index unsignedIntValue]];
+            if (table->count > keptCapacity) {
+                uint32_t *rows = realloc(keptRows, table->count * sizeof(uint32_t));
+                if (!rows) {
+                    failed = YES;
+                    break;
+                }
+                keptRows = rows;
+                keptCapacity = table->count;
+            }
+            
+            // Both are in start order, so one pass finds the rows that fit between taken ones
+            size_t keptCount = 0;
+            size_t next = 0;
+            for (uint32_t row = 0; row < table->count; row++) {
+                int64_t start = table->start[row];
+                if (start == VLC_PROGRAM_NO_TIMESTAMP) {
+                    // Kept from the first source that has the channel; a gap filler must say where it goes
+                    if (firstTable) {
+                        keptRows[keptCount++] = row;
+                    } else {
+                        dropped++;
+                    }
+                    continue;
+                }
+                while (next < coverage.count && coverage.intervals[next].end <= start) {
+                    next++;
+                }
+                if (next < coverage.count && coverage.intervals[next].start < VLCProgramTableCoveredEnd(table, row)) {
+                    dropped++;
+                    continue;
+                }
+                keptRows[keptCount++] = row;
+            }
+            
+            for (size_t i = 0; i < keptCount; i++) {
+                if (![store copyRow:keptRows[i] ofTable:[index unsignedIntValue] toStore:merged channel:channel]) {
+                    failed = YES;
+                    break;
+                }
+            }
+            // Rows without a start sort first and cover nothing
+            size_t placed = 0;
+            while (placed < keptCount && table->start[keptRows[placed]] == VLC_PROGRAM_NO_TIMESTAMP) {
+                placed++;
+            }
+            if (failed || !VLCProgramCoverageAddRows(&coverage, &scratch, table, keptRows + placed, keptCount - placed)) {
+                failed = YES;
+                break;
+            }
+            firstTable = NO;
+        }
+        if (failed) {
+            break;
+        }
+    }
+    free(coverage.intervals);
+    free(scratch.intervals);
+    free(keptRows);
+    if (failed) {
+        return nil;
+    }
+    
+    [merged finishAppending];
+    if (droppedCount) {
+        *droppedCount = dropped;
+    }
+    return merged;
+}
+
+#pragma mark - Refreshing
+
+static BOOL VLCProgramStoreSameString(const VLCStringPool *pool, VLCStringRef ref,
+                                      const VLCStringPool *otherPool, VLCStringRef otherRef) {
+    size_t length = 0;
+    size_t otherLength = 0;
+    const char *bytes = VLCStringPoolGet(pool, ref, &length);
+    const char *otherBytes = VLCStringPoolGet(otherPool, otherRef, &otherLength);
+    return length == otherLength && (length == 0 || memcmp(bytes, otherBytes, length) == 0);
+}
+
+// Same programme: same times, title and description. The archive columns are what the app
+// learned since and do not count.
+- (BOOL)row:(uint32_t)row ofTable:(uint32_t)index isSameAsRow:(uint32_t)otherRow ofTable:(uint32_t)otherIndex inStore:(VLCProgramStore *)other {
+    const VLCProgramTable *table = &_tables[index];
+    const VLCProgramTable *otherTable = &other->_tables[otherIndex];
+    return table->start[row] == otherTable->start[otherRow] &&
+           table->end[row] == otherTable->end[otherRow] &&
+           VLCProgramStoreSameString(_pool, table->title[row], other->_pool, otherTable->title[otherRow]) &&
+           VLCProgramStoreSameString(_pool, table->programDescription[row], other->_pool, otherTable->programDescription[otherRow]);
+}
+
+- (VLCProgramStore *)storeUpdatedWithStore:(VLCProgramStore *)newer
+                      keepingProgramsAfter:(int64_t (^)(NSString *channelId))pastCutoffForChannel
+                                    before:(int64_t)futureCutoff {
+    VLCProgramStore *store = [[[VLCProgramStore alloc] init] autorelease];
+    if (!store) {
+        return nil;
+    }
+    for (uint32_t i = 0; i < newer->_tableCount; i++) {
+        NSString *channelId = newer->_tables[i].channelId;
+        NSNumber *own = [_channelIndexes objectForKey:channelId];
+        int64_t pastCutoff = pastCutoffForChannel(channelId);
+        BOOL copied = NO;
+        if (!own) {
+            copied = [newer copyTable:i toStore:store pastCutoff:pastCutoff futureCutoff:futureCutoff];
+        } else if (newer->_tables[i].count == 0) {
+            copied = [self copyTable:[own unsignedIntValue] toStore:store pastCutoff:pastCutoff futureCutoff:futureCutoff];
+        } else {
+            copied = [self updateTable:[own unsignedIntValue] withTable:i ofStore:newer toStore:store
+                            pastCutoff:pastCutoff futureCutoff:futureCutoff];
+        }
+        if (!copied) {
+            return nil;
+        }
+    }
+    // Channels the newer guide left out keep theirs until they leave the window
+    for (uint32_t i = 0; i < _tableCount; i++) {
+        if (![newer->_channelIndexes objectForKey:_tables[i].channelId] &&
+            ![self copyTable:i toStore:store pastCutoff:pastCutoffForChannel(_tables[i].channelId) futureCutoff:futureCutoff]) {
+            return nil;
+        }
+    }
+    [store finishAppending];
+    return store;
+}
+
+// This table's programmes that aired before the newer table's first start, then the newer
+// table's, each keeping the archive columns of the same programme here. Both are in start order.
+- (BOOL)updateTable:(uint32_t)index
+          withTable:(uint32_t)newerIndex
+            ofStore:(VLCProgramStore *)newer
+            toStore:(VLCProgramStore *)store
+         pastCutoff:(int64_t)pastCutoff
+       futureCutoff:(int64_t)futureCutoff {
+    const VLCProgramTable *table = &_tables[index];
+    const VLCProgramTable *newerTable = &newer->_tables[newerIndex];
+    uint32_t channel = [store channelIndexForId:newerTable->channelId];
+    if (channel == VLC_PROGRAM_STORE_NO_CHANNEL) {
+        return NO;
+    }
+    
+    uint32_t first = 0;
+    while (first < newerTable->count && newerTable->start[first] == VLC_PROGRAM_NO_TIMESTAMP) {
+        first++;
+    }
+    int64_t cut = first < newerTable->count ? newerTable->start[first] : INT64_MAX;
+    for (uint32_t row = 0; row < table->count && table->start[row] < cut; row++) {
+        // Rows without a start come from the newer guide; one running into its first is superseded
+        if (table->start[row] == VLC_PROGRAM_NO_TIMESTAMP ||
+            (table->end[row] != VLC_PROGRAM_NO_TIMESTAMP && table->end[row] > cut) ||
+            !VLCProgramInRetentionWindow(table->start[row], table->end[row], pastCutoff, futureCutoff)) {
+            continue;
+        }
+        if (![self copyRow:row ofTable:index toStore:store channel:channel]) {
+            return NO;
+        }
+    }
+    
+    uint32_t match = 0;
+    for (uint32_t row = 0; row < newerTable->count; row++) {
+        int64_t start = newerTable->start[row];
+        if (!VLCProgramInRetentionWindow(start, newerTable->end[row], pastCutoff, futureCutoff)) {
+            continue;
+        }
+        VLCProgramStoreRow copied;
+        [newer getRow:&copied row:row ofTable:newerIndex];
+        while (match < table->count && table->start[match] < start) {
+            match++;
+        }
+        for (uint32_t same = match; same < table->count && table->start[same] == start; same++) {
+            if ([self row:same ofTable:index isSameAsRow:row ofTable:newerIndex inStore:newer]) {
+                VLCProgramStoreRow known;
+                [self getRow:&known row:same ofTable:index];
+                copied.hasArchive = copied.hasArchive || known.hasArchive;
+                if (copied.archiveDays == 0) {
+                    copied.archiveDays = known.archiveDays;
+                }
+                break;
+            }
+        }
+        if (![store appendRow:&copied toChannel:channel]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (NSMutableSet<NSString *> *)channelIdsChangedFromStore:(VLCProgramStore *)older {
+    NSMutableSet<NSString *> *changed = [NSMutableSet set];
+    for (uint32_t i = 0; i < _tableCount; i++) {
+        const VLCProgramTable *table = &_tables[i];
+        NSNumber *olderIndex = [older->_channelIndexes objectForKey:table->channelId];
+        if (!olderIndex) {
+            [changed addObject:table->channelId];
+            continue;
+        }
+        uint32_t otherIndex = [olderIndex unsignedIntValue];
+        BOOL same = table->count == older->_tables[otherIndex].count;
+        for (uint32_t row = 0; same && row < table->count; row++) {
+            same = [self row:row ofTable:i isSameAsRow:row ofTable:otherIndex inStore:older];
+        }
+        if (!same) {
+            [changed addObject:table->channelId];
+        }
+    }
+    for (uint32_t i = 0; i < older->_tableCount; i++) {
+        if (![_channelIndexes objectForKey:older->_tables[i].channelId]) {
+            [changed addObject:older->_tables[i].channelId];
+        }
+    }
+    return changed;
+}
+
+#pragma mark - Row Accessors
+
+- (uint32_t)programCountForChannel:(uint32_t)channel {
+    return _tables[channel].count;
+}
+
+- (NSString *)channelIdForChannel:(uint32_t)channel {
+    return _tables[channel].channelId;
+}
+
+- (int64_t)startTimestampForChannel:(uint32_t)channel row:(uint32_t)row {
+    return _tables[channel].start[row];
+}
+
+- (int64_t)endTimestampForChannel:(uint32_t)channel row:(uint32_t)row {
+    return _tables[channel].end[row];
+}
+
+- (NSString *)stringForRef:(VLCStringRef)ref {
+    if (ref == 0) {
+        return @"";
+    }
+    size_t length = 0;
+    const char *bytes = VLCStringPoolGet(_pool, ref, &length);
+    return VLCProgramStoreMakeString(bytes, length);
+}
+
+- (NSString *)titleForChannel:(uint32_t)channel row:(uint32_t)row {
+    return [self stringForRef:_tables[channel].title[row]];
+}
+
+- (NSString *)programDescriptionForChannel:(uint32_t)channel row:(uint32_t)row {
+    return [self stringForRef:_tables[channel].programDescription[row]];
+}
+
+- (BOOL)hasArchiveForChannel:(uint32_t)channel row:(uint32_t)row {
+    return (__atomic_load_n(&_tables[channel].flags[row], __ATOMIC_ACQUIRE) & VLCProgramStoreFlagHasArchive) != 0;
+}
+
+- (void)setHasArchive:(BOOL)hasArchive forChannel:(uint32_t)channel row:(uint32_t)row {
+    if (hasArchive) {
+        __atomic_fetch_or(&_tables[channel].flags[row], VLCProgramStoreFlagHasArchive, __ATOMIC_RELEASE);
+    } else {
+        __atomic_fetch_and(&_tables[channel].flags[row], (uint8_t)~VLCProgramStoreFlagHasArchive, __ATOMIC_RELEASE);
+    }
+}
+
+- (NSInteger)archiveDaysForChannel:(uint32_t)channel row:(uint32_t)row {
+    return __atomic_load_n(&_tables[channel].archiveDays[row], __ATOMIC_ACQUIRE);
+}
+
+- (BOOL)setArchiveDays:(NSInteger)archiveDays forChannel:(uint32_t)channel row:(uint32_t)row {
+    if (archiveDays < 0 || archiveDays > UINT8_MAX) {
+        return NO;
+    }
+    __atomic_store_n(&_tables[channel].archiveDays[row], (uint8_t)archiveDays, __ATOMIC_RELEASE);
+    return YES;
+}
+
+@end
+
+#pragma mark - Program List
+
+@implementation VLCProgramList {
+    VLCProgramStore *_store;
+    uint32_t _channel;
+    uint32_t _count;
+    VLCProgramIndex *_index;        // Published once with a compare-and-swap
+}
+
+- (instancetype)initWithStore:(VLCProgramStore *)store channel:(uint32_t)channel {
+    self = [super init];
+    if (self) {
+        _store = [store retain];
+        _channel = channel;
+        _count = [store programCountForChannel:channel];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    VLCProgramIndexFree(_index);
+    [_store release];
+    [super dealloc];
+}
+
+- (NSUInteger)count {
+    return _count;
+}
+
+- (const VLCProgramIndex *)programIndex {
+    VLCProgramIndex *index = __atomic_load_n(&_index, __ATOMIC_ACQUIRE);
+    if (index) {
+        return index;
+    }
+    VLCProgramInterval *intervals = malloc((_count ? _count : 1) * sizeof(VLCProgramInterval));
+    if (!intervals) {
+        return NULL;
+    }
+    for (uint32_t row = 0; row < _count; row++) {
+        intervals[row].start = [_store startTimestampForChannel:_channel row:row];
+        intervals[row].end = [_store endTimestampForChannel:_channel row:row];
+    }
+    VLCProgramIndex *built = VLCProgramIndexCreate(intervals, _count);
+    free(intervals);
+    if (!built) {
+        return NULL;
+    }
+    // Two threads may build at once; the loser frees its copy and uses the winner's
+    if (!__atomic_compare_exchange_n(&_index, &index, built, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        VLCProgramIndexFree(built);
+        return index;
+    }
+    return built;
+}
+
+- (id)objectAtIndex:(NSUInteger)index {
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu beyond bounds [0 .. %lu]",
+         (unsigned long)index, (unsigned long)_count];
+    }
+    return [[[VLCProgram alloc] initWithStore:_store channel:_channel row:(uint32_t)index] autorelease];
+}
+
+// Immutable and backed by an immutable table: copies can share it
+- (id)copyWithZone:(NSZone *)zone {
+    return [self retain];
+}
+
+@end
@@ -0,0 +1,44 @@
+//
+//  VLCShortEPGFetcher.h
+//  BasicPlayerWithPlaylist
+//
+//  Xtream Short EPG Fetcher - Platform Independent
+//  Asks an Xtream server for the next few programmes of single channels (player_api
+//  get_short_epg), a cheap stand-in while the full XMLTV guide downloads
+//
+
+#import <Foundation/Foundation.h>
+
+@class VLCChannel;
+@class VLCProgram;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Gets a batch's channels and their programmes (lists of one programme store per batch, in
+// the same order; empty when the server had none). Return NO to stop before the next batch.
+typedef BOOL (^VLCShortEPGBatchHandler)(NSArray<VLCChannel *> *channels, NSArray<NSArray<VLCProgram *> *> *programLists);
+
+@interface VLCShortEPGFetcher : NSObject
+
+// account as -[VLCChannelManager xtreamAccountFromPlaylistURL:] returns it; nil without credentials
+- (nullable instancetype)initWithAccount:(NSDictionary<NSString *, NSString *> *)account;
+
+@property (nonatomic, assign) NSUInteger batchSize;             // Requests in flight at once. Default: 8
+@property (nonatomic, assign) NSUInteger programsPerChannel;    // Default: 4
+@property (nonatomic, assign) NSTimeInterval requestTimeout;    // Default: 10 s
+
+/**
+ * Fetches channels in order, batchSize requests at a time. Channels whose URL is not a live
+ * stream of this account are skipped. batchHandler and completion run on the main queue;
+ * completion gets the number of channels that got programmes.
+ */
+- (void)fetchChannels:(NSArray<VLCChannel *> *)channels
+         batchHandler:(VLCShortEPGBatchHandler)batchHandler
+           completion:(void (^ _Nullable)(NSUInteger channelsWithPrograms))completion;
+
+// Stops after the batch in flight; its results are dropped
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,288 @@
+//
+//  VLCShortEPGFetcher.m
+//  BasicPlayerWithPlaylist
+//
+//  Xtream Short EPG Fetcher - Platform Independent
+//  Asks an Xtream server for the next few programmes of single channels (player_api
+//  get_short_epg), a cheap stand-in while the full XMLTV guide downloads
+//
+
+#import "VLCShortEPGFetcher.h"
+#import "VLCChannel.h"
+#import "VLCProgram.h"
+#import "VLCProgramStore.h"
+
+// Titles and descriptions come base64 encoded; a few servers send them as they are
+static NSData *VLCShortEPGTextData(id value) {
+    if (![value isKindOfClass:[NSString class]] || [(NSString *)value length] == 0) {
+        return nil;
+    }
+    NSData *decoded = [[[NSData alloc] initWithBase64EncodedString:value
+                                                           options:NSDataBase64DecodingIgnoreUnknownCharacters] autorelease];
+    if (decoded.length > 0) {
+        NSString *text = [[NSString alloc] initWithData:decoded encoding:NSUTF8StringEncoding];
+        BOOL isText = text != nil;
+        [text release];
+        if (isText) {
+            return decoded;
+        }
+    }
+    return [(NSString *)value dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+// "1735732800" or 1735732800
+static int64_t VLCShortEPGTimestamp(id value) {
+    if ([value isKindOfClass:[NSString class]] || [value isKindOfClass:[NSNumber class]]) {
+        long long timestamp = [value longLongValue];
+        if (timestamp > 0) {
+            return (int64_t)timestamp;
+        }
+    }
+    return VLC_PROGRAM_NO_TIMESTAMP;
+}
+
+@implementation VLCShortEPGFetcher {
+    NSURLSession *_session;
+    NSString *_server;
+    NSString *_credentialsPath;     // "/<user>/<pass>/", as stream URLs spell it
+    NSString *_apiURL;              // Everything up to the stream id
+    dispatch_queue_t _queue;        // Builds each batch's store
+    BOOL _cancelled;                // Read and written with __atomic builtins
+}
+
+- (instancetype)initWithAccount:(NSDictionary<NSString *, NSString *> *)account {
+    NSString *server = account[@"server"];
+    NSString *username = account[@"username"];
+    NSString *password = account[@"password"];
+    if (server.length == 0 || username.length == 0 || password.length == 0) {
+        [self release];
+        return nil;
+    }
+
+    self = [super init];
+    if (self) {
+        _batchSize = 8;
+        _programsPerChannel = 4;
+        _requestTimeout = 10.0;
+        _server = [server copy];
+        _credentialsPath = [[NSString alloc] initWithFormat:@"/%@/%@/", username, password];
+        NSCharacterSet *queryCharacters = [NSCharacterSet URLQueryAllowedCharacterSet];
+        _apiURL = [[NSString alloc] initWithFormat:@"%@/player_api.php?username=%@&password=%@&action=get_short_epg&stream_id=",
+                   server,
+                   [username stringByAddingPercentEncodingWithAllowedCharacters:queryCharacters],
+                   [password stringByAddingPercentEncodingWithAllowedCharacters:queryCharacters]];
+        _queue = dispatch_queue_create("com.basicplayer.shortepg", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_session invalidateAndCancel];
+    [_session release];
+    [_server release];
+    [_credentialsPath release];
+    [_apiURL release];
+    dispatch_release(_queue);
+    [super dealloc];
+}
+
+- (void)cancel {
+    __atomic_store_n(&_cancelled, YES, __ATOMIC_RELEASE);
+}
+
+- (BOOL)isCancelled {
+    return __atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE);
+}
+
+// Live stream URLs are <server>/live/<user>/<pass>/<id>.<ext> or <server>/<user>/<pass>/<id>;
+// -1 for anything else (other servers, movies, series)
+- (long long)streamIdForChannel:(VLCChannel *)channel {
+    NSString *url = channel.url;
+    if (![url hasPrefix:_server]) {
+        return -1;
+    }
+    NSString *path = [url substringFromIndex:_server.length];
+    if ([path hasPrefix:@"/live/"]) {
+        path = [path substringFromIndex:5];
+    }
+    if (![path hasPrefix:_credentialsPath]) {
+        return -1;
+    }
+    NSString *name = [path substringFromIndex:_credentialsPath.length];
+    NSRange extension = [name rangeOfString:@"."];
+    if (extension.location != NSNotFound) {
+        name = [name substringToIndex:extension.location];
+    }
+    if (name.length == 0 || name.length > 18) {
+        return -1;
+    }
+    for (NSUInteger i = 0; i < name.length; i++) {
+        unichar c = [name characterAtIndex:i];
+        if (c < '0' || c > '9') {
+            return -1;
+        }
+    }
+    return [name longLongValue];
+}
+
+- (void)fetchChannels:(NSArray<VLCChannel *> *)channels
+         batchHandler:(VLCShortEPGBatchHandler)batchHandler
+           completion:(void (^)(NSUInteger))completion {
+    if (!_session) {
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+        configuration.HTTPMaximumConnectionsPerHost = (NSInteger)MAX(self.batchSize, 1);
+        configuration.timeoutIntervalForRequest = self.requestTimeout;
+        _session = [[NSURLSession sessionWithConfiguration:configuration] retain];
+    }
+
+    NSMutableArray<VLCChannel *> *fetchable = [NSMutableArray arrayWithCapacity:channels.count];
+    NSMutableArray<NSNumber *> *streamIds = [NSMutableArray arrayWithCapacity:channels.count];
+    NSMutableSet<NSNumber *> *seen = [NSMutableSet set];
+    for (VLCChannel *channel in channels) {
+        long long streamId = [self streamIdForChannel:channel];
+        if (streamId >= 0) {
+            [seen addObject:@(streamId)];
+            [fetchable addObject:channel];
+            [streamIds addObject:@(streamId)];
+        }
+    }
+    NSLog(@"📅 [SHORT-EPG] Fetching %lu streams for %lu of %lu channels, %lu at a time",
+          (unsigned long)seen.count, (unsigned long)fetchable.count, (unsigned long)channels.count,
+          (unsigned long)self.batchSize);
+
+    [self fetchBatchFrom:0 channels:fetchable streamIds:streamIds found:0
+            batchHandler:[[batchHandler copy] autorelease]
+              completion:[[completion copy] autorelease]];
+}
+
+- (void)fetchBatchFrom:(NSUInteger)start
+              channels:(NSArray<VLCChannel *> *)channels
+             streamIds:(NSArray<NSNumber *> *)streamIds
+                 found:(NSUInteger)found
+          batchHandler:(VLCShortEPGBatchHandler)batchHandler
+            completion:(void (^)(NSUInteger))completion {
+    if (start >= channels.count || [self isCancelled]) {
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(found);
+            });
+        }
+        return;
+    }
+
+    // A stream listed twice in a batch (a favorite next to its group) is fetched once
+    NSUInteger end = start;
+    NSMutableOrderedSet<NSNumber *> *batchStreams = [NSMutableOrderedSet orderedSet];
+    while (end < channels.count && (batchStreams.count < MAX(self.batchSize, 1) || [batchStreams containsObject:streamIds[end]])) {
+        [batchStreams addObject:streamIds[end]];
+        end++;
+    }
+
+    NSMutableDictionary<NSNumber *, NSArray *> *listings = [NSMutableDictionary dictionaryWithCapacity:batchStreams.count];
+    dispatch_group_t group = dispatch_group_create();
+    for (NSNumber *streamId in batchStreams) {
+        NSString *url = [NSString stringWithFormat:@"%@%lld&limit=%lu", _apiURL, streamId.longLongValue,
+                         (unsigned long)self.programsPerChannel];
+        NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:url]
+                                                 cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+                                             timeoutInterval:self.requestTimeout];
+        dispatch_group_enter(group);
+        NSURLSessionDataTask *task = [_session dataTaskWithRequest:request
+                                                 completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+            // {"epg_listings":[{"title":"<base64>","start_timestamp":"...","stop_timestamp":"...",...}]}
+            NSArray *entries = nil;
+            if (!error && data.length > 0) {
+                id json = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+                id list = [json isKindOfClass:[NSDictionary class]] ? [(NSDictionary *)json objectForKey:@"epg_listings"] : nil;
+                entries = [list isKindOfClass:[NSArray class]] ? list : nil;
+            }
+            if (entries.count > 0) {
+                @synchronized (listings) {
+                    [listings setObject:entries forKey:streamId];
+                }
+            }
+            dispatch_group_leave(group);
+        }];
+        [task resume];
+    }
+
+    dispatch_group_notify(group, _queue, ^{
+        dispatch_release(group);
+        if ([self isCancelled]) {
+            [self fetchBatchFrom:channels.count channels:channels streamIds:streamIds found:found
+                    batchHandler:batchHandler completion:completion];
+            return;
+        }
+
+        NSMutableDictionary<NSNumber *, NSArray<VLCProgram *> *> *lists = [NSMutableDictionary dictionaryWithCapacity:listings.count];
+        [self storeListings:listings lists:lists];
+
+        NSRange range = NSMakeRange(start, end - start);
+        NSArray<VLCChannel *> *batchChannels = [channels subarrayWithRange:range];
+        NSMutableArray<NSArray<VLCProgram *> *> *programLists = [NSMutableArray arrayWithCapacity:range.length];
+        NSUInteger batchFound = 0;
+        for (NSUInteger i = start; i < end; i++) {
+            NSArray<VLCProgram *> *list = [lists objectForKey:streamIds[i]];
+            [programLists addObject:list ?: @[]];
+            batchFound += list.count > 0;
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if ([self isCancelled] || !batchHandler(batchChannels, programLists)) {
+                [self cancel];
+            }
+            [self fetchBatchFrom:end channels:channels streamIds:streamIds found:found + batchFound
+                    batchHandler:batchHandler completion:completion];
+        });
+    });
+}
+
+// One sealed programme store per batch, its tables keyed by stream id
+- (void)storeListings:(NSDictionary<NSNumber *, NSArray *> *)listings lists:(NSMutableDictionary *)lists {
+    VLCProgramStore *store = [[VLCProgramStore alloc] init];
+    if (!store) {
+        return;
+    }
+    NSMutableDictionary<NSNumber *, NSNumber *> *tables = [NSMutableDictionary dictionaryWithCapacity:listings.count];
+    for (NSNumber *streamId in listings) {
+        uint32_t channel = [store channelIndexForId:streamId.stringValue];
+        if (channel == VLC_PROGRAM_STORE_NO_CHANNEL) {
+            continue;
+        }
+        for (id entry in [listings objectForKey:streamId]) {
+            if (![entry isKindOfClass:[NSDictionary class]]) {
+                continue;
+            }
+            NSData *title = VLCShortEPGTextData([entry objectForKey:@"title"]);
+            if (title.length == 0) {
+                continue;
+            }
+            NSData *programDescription = VLCShortEPGTextData([entry objectForKey:@"description"]);
+            VLCProgramStoreRow row;
+            memset(&row, 0, sizeof(row));
+            row.startTimestamp = VLCShortEPGTimestamp([entry objectForKey:@"start_timestamp"]);
+            row.endTimestamp = VLCShortEPGTimestamp([entry objectForKey:@"stop_timestamp"]);
+            row.title = (const char *)title.bytes;
+            row.titleLength = title.length;
+            row.programDescription = (const char *)programDescription.bytes;
+            row.programDescriptionLength = programDescription.length;
+            id hasArchive = [entry objectForKey:@"has_archive"];
+            row.hasArchive = [hasArchive respondsToSelector:@selector(integerValue)] && [hasArchive integerValue] > 0;
+            if (![store appendRow:&row toChannel:channel]) {
+                break;
+            }
+        }
+        [tables setObject:@(channel) forKey:streamId];
+    }
+    [store finishAppending];
+    for (NSNumber *streamId in tables) {
+        VLCProgramList *list = [[VLCProgramList alloc] initWithStore:store channel:[[tables objectForKey:streamId] unsignedIntValue]];
+        if (list.count > 0) {
+            [lists setObject:list forKey:streamId];
+        }
+        [list release];
+    }
+    [store release];
+}
+
+@end
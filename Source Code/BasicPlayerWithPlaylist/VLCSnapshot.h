@@ -0,0 +1,51 @@
+//
+//  VLCSnapshot.h
+//  BasicPlayerWithPlaylist
+//
+//  Snapshot Publishing - Platform Independent
+//  Hands immutable objects from the threads that build them to the threads that read them
+//  without locks: writers swap one pointer, readers pin what they loaded
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Loads the object published in *slot and keeps it alive until the current autorelease pool
+ * drains, however often the slot is republished meanwhile. Any thread. Never waits: the reader
+ * only announces itself for the span of the load and retain.
+ */
+id _Nullable VLCSnapshotLoad(id _Nullable const * _Nonnull slot);
+
+/**
+ * Publishes value (retained) in *slot. The object it replaces is retired, not released: readers
+ * that loaded it just before the swap may not have pinned it yet.
+ */
+void VLCSnapshotPublish(id _Nullable * _Nonnull slot, id _Nullable value);
+
+/**
+ * Publishes value only when *slot still holds expected.
+ * @return NO (and value is not retained) when another object was published first.
+ */
+BOOL VLCSnapshotPublishIfUnchanged(id _Nullable * _Nonnull slot, id _Nullable expected, id _Nullable value);
+
+// Takes over one reference and releases it on a background queue once every load that started
+// before the call has retained what it loaded. object must already be out of every slot. Safe
+// from any thread.
+void VLCSnapshotRetire(id _Nullable object);
+
+// Counters since launch. Main-thread load times show that readers on the main thread never wait
+// on the threads publishing.
+typedef struct {
+    uint64_t mainThreadLoads;
+    uint64_t mainThreadLoadNanos;       // Total
+    uint64_t maxMainThreadLoadNanos;
+    uint64_t publishes;
+    uint64_t retired;
+    uint64_t released;
+} VLCSnapshotStats;
+
+VLCSnapshotStats VLCSnapshotGetStats(void);
+
+NS_ASSUME_NONNULL_END
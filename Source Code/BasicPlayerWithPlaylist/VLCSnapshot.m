@@ -0,0 +1,174 @@
+//
+//  VLCSnapshot.m
+//  BasicPlayerWithPlaylist
+//
+//  Snapshot Publishing - Platform Independent
+//  Hands immutable objects from the threads that build them to the threads that read them
+//  without locks: writers swap one pointer, readers pin what they loaded
+//
+
+#import "VLCSnapshot.h"
+#import <pthread.h>
+#import <time.h>
+#import <unistd.h>
+
+typedef struct VLCSnapshotRetired {
+    struct VLCSnapshotRetired *next;
+    id object;
+} VLCSnapshotRetired;
+
+static VLCSnapshotRetired *VLCSnapshotRetiredList;      // Pushed by any thread
+static int VLCSnapshotDrainScheduled;
+static VLCSnapshotStats VLCSnapshotCounters;
+
+// Readers announce themselves in the counter of the epoch's parity for the span between loading
+// a slot and retaining what they loaded. Only the reclaimer advances the epoch.
+static uint64_t VLCSnapshotEpoch;
+static uint64_t VLCSnapshotReaders[2];
+
+static void VLCSnapshotScheduleDrain(void);
+
+#pragma mark - Loading
+
+// Sequentially consistent throughout: the announcement must be visible before the slot is read,
+// and the reclaimer's epoch flip before it reads the counters
+static id VLCSnapshotLoadAnnounced(id const *slot) {
+    uint64_t parity = __atomic_load_n(&VLCSnapshotEpoch, __ATOMIC_SEQ_CST) & 1;
+    __atomic_fetch_add(&VLCSnapshotReaders[parity], 1, __ATOMIC_SEQ_CST);
+    id object = [__atomic_load_n((id *)slot, __ATOMIC_SEQ_CST) retain];
+    __atomic_fetch_sub(&VLCSnapshotReaders[parity], 1, __ATOMIC_RELEASE);
+    return [object autorelease];
+}
+
+id VLCSnapshotLoad(id const *slot) {
+    if (!pthread_main_np()) {
+        return VLCSnapshotLoadAnnounced(slot);
+    }
+    uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+    id object = VLCSnapshotLoadAnnounced(slot);
+    uint64_t elapsed = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+    
+    // Only the main thread writes these; atomics keep readers on other threads exact
+    __atomic_fetch_add(&VLCSnapshotCounters.mainThreadLoads, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&VLCSnapshotCounters.mainThreadLoadNanos, elapsed, __ATOMIC_RELAXED);
+    if (elapsed > __atomic_load_n(&VLCSnapshotCounters.maxMainThreadLoadNanos, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&VLCSnapshotCounters.maxMainThreadLoadNanos, elapsed, __ATOMIC_RELAXED);
+    }
+    return object;
+}
+
+#pragma mark - Publishing
+
+void VLCSnapshotPublish(id *slot, id value) {
+    // Sequentially consistent like the loads: a reclaimer that finds no reader announced must
+    // also find the object out of its slot
+    id old = __atomic_exchange_n(slot, [value retain], __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&VLCSnapshotCounters.publishes, 1, __ATOMIC_RELAXED);
+    if (old == value) {
+        // Still held by the slot
+        [old release];
+    } else {
+        VLCSnapshotRetire(old);
+    }
+}
+
+BOOL VLCSnapshotPublishIfUnchanged(id *slot, id expected, id value) {
+    id current = expected;
+    [value retain];
+    if (!__atomic_compare_exchange_n(slot, &current, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+        [value release];
+        return NO;
+    }
+    __atomic_fetch_add(&VLCSnapshotCounters.publishes, 1, __ATOMIC_RELAXED);
+    VLCSnapshotRetire(expected);
+    return YES;
+}
+
+#pragma mark - Retiring
+
+void VLCSnapshotRetire(id object) {
+    if (!object) {
+        return;
+    }
+    VLCSnapshotRetired *node = malloc(sizeof(VLCSnapshotRetired));
+    if (!node) {
+        // Leaking one object beats releasing it under a reader
+        return;
+    }
+    node->object = object;
+    node->next = __atomic_load_n(&VLCSnapshotRetiredList, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&VLCSnapshotRetiredList, &node->next, node, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+    __atomic_fetch_add(&VLCSnapshotCounters.retired, 1, __ATOMIC_RELAXED);
+    VLCSnapshotScheduleDrain();
+}
+
+static void VLCSnapshotRelease(VLCSnapshotRetired *list) {
+    uint64_t count = 0;
+    while (list) {
+        VLCSnapshotRetired *next = list->next;
+        [list->object release];
+        free(list);
+        list = next;
+        count++;
+    }
+    __atomic_fetch_add(&VLCSnapshotCounters.released, count, __ATOMIC_RELAXED);
+}
+
+// Returns once every reader that could have loaded an object retired before the call has
+// retained it. A reader counts in the parity of the epoch it read, which is at most the current
+// one; after two flips, each followed by that parity draining, both parities are clear of such
+// readers. Readers arriving meanwhile land in the other parity, so neither wait starves.
+static void VLCSnapshotWaitForReaders(void) {
+    for (int flip = 0; flip < 2; flip++) {
+        uint64_t epoch = __atomic_fetch_add(&VLCSnapshotEpoch, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&VLCSnapshotReaders[epoch & 1], __ATOMIC_SEQ_CST) != 0) {
+            // A reader holds it for a load and a retain, longer only when preempted
+            usleep(50);
+        }
+    }
+}
+
+// Reclaim queue. Everything on the list was swapped out of its slot before it was retired, so
+// once the readers that started earlier are done, nothing can reach it.
+static void VLCSnapshotDrain(void) {
+    __atomic_store_n(&VLCSnapshotDrainScheduled, 0, __ATOMIC_RELEASE);
+    VLCSnapshotRetired *retired = __atomic_exchange_n(&VLCSnapshotRetiredList, NULL, __ATOMIC_ACQUIRE);
+    if (!retired) {
+        return;
+    }
+    VLCSnapshotWaitForReaders();
+    @autoreleasepool {
+        VLCSnapshotRelease(retired);
+    }
+}
+
+static void VLCSnapshotScheduleDrain(void) {
+    if (__atomic_exchange_n(&VLCSnapshotDrainScheduled, 1, __ATOMIC_ACQ_REL)) {
+        return;
+    }
+    // Tearing down a guide takes a while, and waiting for readers must not block one: never the main queue
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.basicplayer.snapshot.reclaim",
+                                      dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_BACKGROUND, 0));
+    });
+    dispatch_async(queue, ^{
+        VLCSnapshotDrain();
+    });
+}
+
+#pragma mark - Statistics
+
+VLCSnapshotStats VLCSnapshotGetStats(void) {
+    VLCSnapshotStats stats;
+    stats.mainThreadLoads = __atomic_load_n(&VLCSnapshotCounters.mainThreadLoads, __ATOMIC_RELAXED);
+    stats.mainThreadLoadNanos = __atomic_load_n(&VLCSnapshotCounters.mainThreadLoadNanos, __ATOMIC_RELAXED);
+    stats.maxMainThreadLoadNanos = __atomic_load_n(&VLCSnapshotCounters.maxMainThreadLoadNanos, __ATOMIC_RELAXED);
+    stats.publishes = __atomic_load_n(&VLCSnapshotCounters.publishes, __ATOMIC_RELAXED);
+    stats.retired = __atomic_load_n(&VLCSnapshotCounters.retired, __ATOMIC_RELAXED);
+    stats.released = __atomic_load_n(&VLCSnapshotCounters.released, __ATOMIC_RELAXED);
+    return stats;
+}
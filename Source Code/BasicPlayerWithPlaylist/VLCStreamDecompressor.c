@@ -0,0 +1,299 @@
+//
+//  VLCStreamDecompressor.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable Stream Decompressor - Platform Independent (plain C)
+//  Recognizes gzip and xz downloads by their magic bytes and inflates them chunk by chunk;
+//  anything else is passed through untouched
+//
+
+#include "VLCStreamDecompressor.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+// Apple SDKs ship no liblzma headers; libcompression's LZMA decoder reads the xz container
+#if defined(__APPLE__)
+#include <compression.h>
+#else
+#include <lzma.h>
+#endif
+
+#define VLC_DECOMPRESSOR_OUTPUT_SIZE 65536
+#define VLC_DECOMPRESSOR_SNIFF_SIZE 6
+
+static const unsigned char VLCXzMagic[VLC_DECOMPRESSOR_SNIFF_SIZE] = { 0xFD, '7', 'z', 'X', 'Z', 0x00 };
+
+struct VLCStreamDecompressor {
+    VLCDecompressorOutput output;
+    void *context;
+    VLCCompressionFormat format;
+    unsigned char sniff[VLC_DECOMPRESSOR_SNIFF_SIZE];   // First bytes, held until the format is known
+    size_t sniffLength;
+    z_stream gzip;
+#if defined(__APPLE__)
+    compression_stream xz;
+#else
+    lzma_stream xz;
+#endif
+    int decoderActive;
+    int ended;                  // The compressed stream (or current gzip member) is complete
+    int failed;
+    uint64_t bytesOut;
+    unsigned char buffer[VLC_DECOMPRESSOR_OUTPUT_SIZE];
+};
+
+#pragma mark - Lifecycle
+
+VLCStreamDecompressor *VLCStreamDecompressorCreate(VLCDecompressorOutput output, void *context) {
+    VLCStreamDecompressor *decompressor = calloc(1, sizeof(VLCStreamDecompressor));
+    if (!decompressor) {
+        return NULL;
+    }
+    decompressor->output = output;
+    decompressor->context = context;
+    return decompressor;
+}
+
+void VLCStreamDecompressorFree(VLCStreamDecompressor *decompressor) {
+    if (!decompressor) {
+        return;
+    }
+    if (decompressor->decoderActive) {
+        if (decompressor->format == VLCCompressionGzip) {
+            inflateEnd(&decompressor->gzip);
+        } else {
+#if defined(__APPLE__)
+            compression_stream_destroy(&decompressor->xz);
+#else
+            lzma_end(&decompressor->xz);
+#endif
+        }
+    }
+    free(decompressor);
+}
+
+VLCCompressionFormat VLCStreamDecompressorFormat(const VLCStreamDecompressor *decompressor) {
+    return decompressor->format;
+}
+
+uint64_t VLCStreamDecompressorBytesOut(const VLCStreamDecompressor *decompressor) {
+    return decompressor->bytesOut;
+}
+
+const char *VLCCompressionFormatName(VLCCompressionFormat format) {
+    switch (format) {
+        case VLCCompressionGzip: return "gzip";
+        case VLCCompressionXz: return "xz";
+        default: return "none";
+    }
+}
+
+#pragma mark - Detection
+
+static VLCCompressionFormat VLCDetectCompression(const unsigned char *bytes, size_t length) {
+    if (length == 0) {
+        return VLCCompressionUnknown;
+    }
+    if (bytes[0] == 0x1F) {
+        if (length < 2) {
+            return VLCCompressionUnknown;
+        }
+        return bytes[1] == 0x8B ? VLCCompressionGzip : VLCCompressionNone;
+    }
+    if (bytes[0] == VLCXzMagic[0]) {
+        size_t compared = length < VLC_DECOMPRESSOR_SNIFF_SIZE ? length : VLC_DECOMPRESSOR_SNIFF_SIZE;
+        if (memcmp(bytes, VLCXzMagic, compared) != 0) {
+            return VLCCompressionNone;
+        }
+        return compared < VLC_DECOMPRESSOR_SNIFF_SIZE ? VLCCompressionUnknown : VLCCompressionXz;
+    }
+    return VLCCompressionNone;
+}
+
+static int VLCDecompressorStart(VLCStreamDecompressor *decompressor) {
+    if (decompressor->format == VLCCompressionGzip) {
+        // 16 + MAX_WBITS: expect a gzip header and trailer rather than a zlib one
+        if (inflateInit2(&decompressor->gzip, 16 + MAX_WBITS) != Z_OK) {
+            return 0;
+        }
+        decompressor->decoderActive = 1;
+    } else if (decompressor->format == VLCCompressionXz) {
+#if defined(__APPLE__)
+        if (compression_stream_init(&decompressor->xz, COMPRESSION_STREAM_DECODE, COMPRESSION_LZMA) != COMPRESSION_STATUS_OK) {
+            return 0;
+        }
+#else
+        lzma_stream initial = LZMA_STREAM_INIT;
+        decompressor->xz = initial;
+        if (lzma_stream_decoder(&decompressor->xz, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+            return 0;
+        }
+#endif
+        decompressor->decoderActive = 1;
+    }
+    return 1;
+}
+
+#pragma mark - Decoding
+
+static int VLCDecompressorEmit(VLCStreamDecompressor *decompressor, const void *bytes, size_t length) {
+    if (length == 0) {
+        return 1;
+    }
+    decompressor->bytesOut += length;
+    return decompressor->output((const char *)bytes, length, decompressor->context);
+}
+
+static int VLCDecompressGzip(VLCStreamDecompressor *decompressor, const unsigned char *bytes, size_t length) {
+    z_stream *stream = &decompressor->gzip;
+    stream->next_in = (Bytef *)bytes;
+    stream->avail_in = (uInt)length;
+    for (;;) {
+        if (decompressor->ended) {
+            if (stream->avail_in == 0) {
+                return 1;
+            }
+            if (*stream->next_in != 0x1F) {
+                // Zero padding after the last member, as some servers send
+                stream->avail_in = 0;
+                return 1;
+            }
+            if (inflateReset(stream) != Z_OK) {
+                return 0;
+            }
+            decompressor->ended = 0;
+        }
+        stream->next_out = decompressor->buffer;
+        stream->avail_out = VLC_DECOMPRESSOR_OUTPUT_SIZE;
+        int status = inflate(stream, Z_NO_FLUSH);
+        if (!VLCDecompressorEmit(decompressor, decompressor->buffer, VLC_DECOMPRESSOR_OUTPUT_SIZE - stream->avail_out)) {
+            return 0;
+        }
+        if (status == Z_STREAM_END) {
+            decompressor->ended = 1;
+            continue;
+        }
+        if (status != Z_OK && status != Z_BUF_ERROR) {
+            return 0;
+        }
+        if (status == Z_BUF_ERROR || (stream->avail_in == 0 && stream->avail_out != 0)) {
+            return 1;
+        }
+    }
+}
+
+static int VLCDecompressXz(VLCStreamDecompressor *decompressor, const unsigned char *bytes, size_t length, int finish) {
+#if defined(__APPLE__)
+    compression_stream *stream = &decompressor->xz;
+    stream->src_ptr = bytes;
+    stream->src_size = length;
+    for (;;) {
+        stream->dst_ptr = decompressor->buffer;
+        stream->dst_size = VLC_DECOMPRESSOR_OUTPUT_SIZE;
+        compression_status status = compression_stream_process(stream, finish ? COMPRESSION_STREAM_FINALIZE : 0);
+        if (!VLCDecompressorEmit(decompressor, decompressor->buffer, VLC_DECOMPRESSOR_OUTPUT_SIZE - stream->dst_size)) {
+            return 0;
+        }
+        if (status == COMPRESSION_STATUS_END) {
+            decompressor->ended = 1;
+            return 1;
+        }
+        if (status == COMPRESSION_STATUS_ERROR) {
+            return 0;
+        }
+        if (stream->src_size == 0 && stream->dst_size != 0) {
+            return 1;
+        }
+    }
+#else
+    lzma_stream *stream = &decompressor->xz;
+    stream->next_in = bytes;
+    stream->avail_in = length;
+    for (;;) {
+        stream->next_out = decompressor->buffer;
+        stream->avail_out = VLC_DECOMPRESSOR_OUTPUT_SIZE;
+        lzma_ret status = lzma_code(stream, finish ? LZMA_FINISH : LZMA_RUN);
+        if (!VLCDecompressorEmit(decompressor, decompressor->buffer, VLC_DECOMPRESSOR_OUTPUT_SIZE - stream->avail_out)) {
+            return 0;
+        }
+        if (status == LZMA_STREAM_END) {
+            decompressor->ended = 1;
+            return 1;
+        }
+        if (status != LZMA_OK && status != LZMA_BUF_ERROR) {
+            return 0;
+        }
+        if (status == LZMA_BUF_ERROR || (stream->avail_in == 0 && stream->avail_out != 0)) {
+            return 1;
+        }
+    }
+#endif
+}
+
+static int VLCDecompressorProcess(VLCStreamDecompressor *decompressor, const unsigned char *bytes, size_t length) {
+    switch (decompressor->format) {
+        case VLCCompressionGzip:
+            return VLCDecompressGzip(decompressor, bytes, length);
+        case VLCCompressionXz:
+            return length == 0 || VLCDecompressXz(decompressor, bytes, length, 0);
+        default:
+            return VLCDecompressorEmit(decompressor, bytes, length);
+    }
+}
+
+#pragma mark - Feeding
+
+int VLCStreamDecompressorFeed(VLCStreamDecompressor *decompressor, const char *bytes, size_t length) {
+    if (decompressor->failed) {
+        return 0;
+    }
+    const unsigned char *input = (const unsigned char *)bytes;
+
+    if (decompressor->format == VLCCompressionUnknown) {
+        size_t take = VLC_DECOMPRESSOR_SNIFF_SIZE - decompressor->sniffLength;
+        if (take > length) {
+            take = length;
+        }
+        memcpy(decompressor->sniff + decompressor->sniffLength, input, take);
+        decompressor->sniffLength += take;
+        input += take;
+        length -= take;
+
+        decompressor->format = VLCDetectCompression(decompressor->sniff, decompressor->sniffLength);
+        if (decompressor->format == VLCCompressionUnknown) {
+            return 1;
+        }
+        if (!VLCDecompressorStart(decompressor) ||
+            !VLCDecompressorProcess(decompressor, decompressor->sniff, decompressor->sniffLength)) {
+            decompressor->failed = 1;
+            return 0;
+        }
+    }
+
+    if (length > 0 && !VLCDecompressorProcess(decompressor, input, length)) {
+        decompressor->failed = 1;
+        return 0;
+    }
+    return 1;
+}
+
+int VLCStreamDecompressorFinish(VLCStreamDecompressor *decompressor) {
+    if (decompressor->failed) {
+        return 0;
+    }
+    if (decompressor->format == VLCCompressionUnknown) {
+        // Fewer bytes than a magic number: whatever arrived is the document
+        decompressor->format = VLCCompressionNone;
+        if (!VLCDecompressorEmit(decompressor, decompressor->sniff, decompressor->sniffLength)) {
+            return 0;
+        }
+    }
+    if (decompressor->format == VLCCompressionXz && !decompressor->ended &&
+        !VLCDecompressXz(decompressor, NULL, 0, 1)) {
+        decompressor->failed = 1;
+        return 0;
+    }
+    return decompressor->format == VLCCompressionNone || decompressor->ended;
+}
@@ -0,0 +1,55 @@
+//
+//  VLCStreamDecompressor.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable Stream Decompressor - Platform Independent (plain C)
+//  Recognizes gzip and xz downloads by their magic bytes and inflates them chunk by chunk;
+//  anything else is passed through untouched
+//
+
+#ifndef VLCStreamDecompressor_h
+#define VLCStreamDecompressor_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    VLCCompressionUnknown = 0,      // Not enough bytes seen yet
+    VLCCompressionNone,
+    VLCCompressionGzip,             // 1F 8B; concatenated members are read back to back
+    VLCCompressionXz                // FD 37 7A 58 5A 00
+} VLCCompressionFormat;
+
+// Receives decompressed (or passed-through) bytes in order. Return 0 to stop.
+typedef int (*VLCDecompressorOutput)(const char *bytes, size_t length, void *context);
+
+typedef struct VLCStreamDecompressor VLCStreamDecompressor;
+
+VLCStreamDecompressor *VLCStreamDecompressorCreate(VLCDecompressorOutput output, void *context);
+void VLCStreamDecompressorFree(VLCStreamDecompressor *decompressor);
+
+/**
+ * Feeds the next chunk of the download. The format is decided from the first bytes; output
+ * is produced in pieces of at most 64 KB, so the whole document never exists at once.
+ * @return 0 on corrupt compressed data or when output stopped, 1 otherwise.
+ */
+int VLCStreamDecompressorFeed(VLCStreamDecompressor *decompressor, const char *bytes, size_t length);
+
+// Call after the last chunk. Returns 1 when a compressed stream reached its proper end.
+int VLCStreamDecompressorFinish(VLCStreamDecompressor *decompressor);
+
+VLCCompressionFormat VLCStreamDecompressorFormat(const VLCStreamDecompressor *decompressor);
+uint64_t VLCStreamDecompressorBytesOut(const VLCStreamDecompressor *decompressor);
+
+// "gzip", "xz" or "none"
+const char *VLCCompressionFormatName(VLCCompressionFormat format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCStreamDecompressor_h */
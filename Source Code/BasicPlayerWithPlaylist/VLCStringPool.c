@@ -0,0 +1,146 @@
+//
+//  VLCStringPool.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable String Pool - Platform Independent (plain C)
+//  Append-only byte arena addressed by 32-bit references, with optional interning
+//
+
+#include "VLCStringPool.h"
+#include "VLCHashIndex.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// A reference is (block index << VLC_STRING_POOL_BLOCK_BITS) | offset. Blocks are allocated
+// on demand and never reallocated, so readers can follow references while a writer appends.
+#define VLC_STRING_POOL_BLOCK_BITS 18
+#define VLC_STRING_POOL_BLOCK_SIZE ((size_t)1 << VLC_STRING_POOL_BLOCK_BITS)
+#define VLC_STRING_POOL_MAX_BLOCKS ((size_t)1 << (32 - VLC_STRING_POOL_BLOCK_BITS))
+
+// Each string is stored as a 2-byte length followed by its bytes
+#define VLC_STRING_POOL_HEADER_SIZE 2
+
+struct VLCStringPool {
+    char *blocks[VLC_STRING_POOL_MAX_BLOCKS];
+    size_t blockCount;
+    size_t used;                // Bytes used in the last block
+    VLCHashIndex *internIndex;  // String hash -> reference (created on first interned add)
+    int interningStopped;
+};
+
+#pragma mark - Lifecycle
+
+VLCStringPool *VLCStringPoolCreate(void) {
+    return calloc(1, sizeof(VLCStringPool));
+}
+
+void VLCStringPoolFree(VLCStringPool *pool) {
+    if (!pool) {
+        return;
+    }
+    for (size_t i = 0; i < pool->blockCount; i++) {
+        free(pool->blocks[i]);
+    }
+    VLCHashIndexFree(pool->internIndex);
+    free(pool);
+}
+
+void VLCStringPoolStopInterning(VLCStringPool *pool) {
+    if (!pool) {
+        return;
+    }
+    VLCHashIndexFree(pool->internIndex);
+    pool->internIndex = NULL;
+    pool->interningStopped = 1;
+}
+
+size_t VLCStringPoolBytesAllocated(const VLCStringPool *pool) {
+    if (!pool) {
+        return 0;
+    }
+    size_t bytes = sizeof(VLCStringPool) + pool->blockCount * VLC_STRING_POOL_BLOCK_SIZE;
+    if (pool->internIndex) {
+        bytes += VLCHashIndexCount(pool->internIndex) * 2 * (sizeof(uint64_t) + sizeof(uint32_t));
+    }
+    return bytes;
+}
+
+#pragma mark - Access
+
+const char *VLCStringPoolGet(const VLCStringPool *pool, VLCStringRef ref, size_t *length) {
+    if (!pool || ref == 0 || ref == VLC_STRING_REF_INVALID) {
+        if (length) *length = 0;
+        return "";
+    }
+    const unsigned char *entry = (const unsigned char *)pool->blocks[ref >> VLC_STRING_POOL_BLOCK_BITS] +
+                                 (ref & (VLC_STRING_POOL_BLOCK_SIZE - 1));
+    if (length) {
+        *length = (size_t)entry[0] | ((size_t)entry[1] << 8);
+    }
+    return (const char *)entry + VLC_STRING_POOL_HEADER_SIZE;
+}
+
+static VLCStringRef VLCStringPoolAppend(VLCStringPool *pool, const char *bytes, size_t length) {
+    size_t needed = VLC_STRING_POOL_HEADER_SIZE + length;
+
+    if (pool->blockCount == 0 || pool->used + needed > VLC_STRING_POOL_BLOCK_SIZE) {
+        if (pool->blockCount == VLC_STRING_POOL_MAX_BLOCKS) {
+            return VLC_STRING_REF_INVALID;
+        }
+        char *block = malloc(VLC_STRING_POOL_BLOCK_SIZE);
+        if (!block) {
+            return VLC_STRING_REF_INVALID;
+        }
+        pool->blocks[pool->blockCount++] = block;
+        // Offset 0 of the first block would encode reference 0 (the empty string)
+        pool->used = pool->blockCount == 1 ? 1 : 0;
+    }
+
+    size_t blockIndex = pool->blockCount - 1;
+    unsigned char *entry = (unsigned char *)pool->blocks[blockIndex] + pool->used;
+    entry[0] = (unsigned char)(length & 0xFF);
+    entry[1] = (unsigned char)(length >> 8);
+    memcpy(entry + VLC_STRING_POOL_HEADER_SIZE, bytes, length);
+
+    VLCStringRef ref = (VLCStringRef)((blockIndex << VLC_STRING_POOL_BLOCK_BITS) | pool->used);
+    pool->used += needed;
+    return ref;
+}
+
+VLCStringRef VLCStringPoolAdd(VLCStringPool *pool, const char *bytes, size_t length, int intern) {
+    if (!pool) {
+        return VLC_STRING_REF_INVALID;
+    }
+    if (length == 0) {
+        return 0;
+    }
+    if (length > VLC_STRING_POOL_MAX_LENGTH) {
+        return VLC_STRING_REF_INVALID;
+    }
+
+    if (!intern || pool->interningStopped) {
+        return VLCStringPoolAppend(pool, bytes, length);
+    }
+
+    if (!pool->internIndex) {
+        pool->internIndex = VLCHashIndexCreate(64);
+    }
+    uint64_t hash = VLCHashBytes(bytes, length, VLC_HASH_SEED);
+    VLCStringRef existing = VLCHashIndexGet(pool->internIndex, hash);
+    if (existing) {
+        size_t existingLength = 0;
+        const char *existingBytes = VLCStringPoolGet(pool, existing, &existingLength);
+        if (existingLength == length && memcmp(existingBytes, bytes, length) == 0) {
+            return existing;
+        }
+        // Hash collision: keep the first string interned, store this one as a plain copy
+        return VLCStringPoolAppend(pool, bytes, length);
+    }
+
+    VLCStringRef ref = VLCStringPoolAppend(pool, bytes, length);
+    if (ref != VLC_STRING_REF_INVALID) {
+        VLCHashIndexSet(pool->internIndex, hash, ref);
+    }
+    return ref;
+}
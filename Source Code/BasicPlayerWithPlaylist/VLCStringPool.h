@@ -0,0 +1,53 @@
+//
+//  VLCStringPool.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable String Pool - Platform Independent (plain C)
+//  Append-only byte arena addressed by 32-bit references, with optional interning
+//
+
+#ifndef VLCStringPool_h
+#define VLCStringPool_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Reference to a pooled string. 0 is the empty string; VLC_STRING_REF_INVALID means "not pooled".
+typedef uint32_t VLCStringRef;
+
+#define VLC_STRING_REF_INVALID UINT32_MAX
+#define VLC_STRING_POOL_MAX_LENGTH 65535
+
+typedef struct VLCStringPool VLCStringPool;
+
+// NULL on allocation failure
+VLCStringPool *VLCStringPoolCreate(void);
+void VLCStringPoolFree(VLCStringPool *pool);
+
+/**
+ * Copies bytes into the pool. With intern set, identical strings added with intern share one copy.
+ * Returns 0 for an empty string, VLC_STRING_REF_INVALID when the string is longer than
+ * VLC_STRING_POOL_MAX_LENGTH or memory runs out.
+ * Not thread safe against other adds; reads of earlier references may run concurrently
+ * because pooled bytes never move.
+ */
+VLCStringRef VLCStringPoolAdd(VLCStringPool *pool, const char *bytes, size_t length, int intern);
+
+// Bytes of ref (not NUL terminated); length 0 for the empty string
+const char *VLCStringPoolGet(const VLCStringPool *pool, VLCStringRef ref, size_t *length);
+
+// Frees the intern index once no more interned strings will be added
+void VLCStringPoolStopInterning(VLCStringPool *pool);
+
+// Bytes allocated for blocks and the intern index
+size_t VLCStringPoolBytesAllocated(const VLCStringPool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCStringPool_h */
@@ -0,0 +1,74 @@
+//
+//  VLCTaskScheduler.h
+//  BasicPlayerWithPlaylist
+//
+//  Cooperative Task Scheduler - Platform Independent
+//  Runs long ingestion jobs (EPG matching, movie info preloading) in time-boxed slices.
+//  Slice sizes follow measured throughput instead of fixed batch sizes and delays.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, VLCTaskPriority) {
+    VLCTaskPriorityBackground = 0,  // Prefetching nobody is waiting for
+    VLCTaskPriorityNormal,          // Whole-playlist work
+    VLCTaskPriorityVisible          // Work for what is on screen right now
+};
+
+@class VLCScheduledTask;
+
+// Processes units [range.location, NSMaxRange(range)) of the task's work, on the scheduler queue
+typedef void (^VLCTaskStepBlock)(NSRange range);
+// Main queue; at most once per progressInterval, plus once when the task finishes
+typedef void (^VLCTaskProgressBlock)(NSUInteger completedUnits, NSUInteger totalUnits);
+// Main queue; after the last slice or after cancellation
+typedef void (^VLCTaskCompletionBlock)(VLCScheduledTask *task);
+
+@interface VLCScheduledTask : NSObject
+
+@property (nonatomic, readonly) NSString *name;
+@property (nonatomic, readonly) VLCTaskPriority priority;
+@property (nonatomic, readonly) NSUInteger totalUnits;
+@property (nonatomic, readonly) NSUInteger completedUnits;
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+@property (nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+// Set before the task is added
+@property (nonatomic, copy, nullable) VLCTaskProgressBlock progressBlock;
+@property (nonatomic, copy, nullable) VLCTaskCompletionBlock completionBlock;
+@property (nonatomic, assign) double maxUnitsPerSecond; // Caps work that hits a remote server (0 = no cap)
+
+// Instrumentation
+@property (nonatomic, readonly) NSTimeInterval cpuTime;     // Thread CPU time spent in slices
+@property (nonatomic, readonly) NSTimeInterval wallTime;    // Wall time spent in slices
+@property (nonatomic, readonly) NSUInteger sliceCount;
+@property (nonatomic, readonly) NSUInteger yieldCount;      // Slices that ended with work left
+
+- (instancetype)initWithName:(NSString *)name
+                    priority:(VLCTaskPriority)priority
+                  totalUnits:(NSUInteger)totalUnits
+                        step:(VLCTaskStepBlock)step;
+
+// Stops the task before its next slice; the completion block still runs
+- (void)cancel;
+
+@end
+
+@interface VLCTaskScheduler : NSObject
+
++ (instancetype)sharedScheduler;
+
+// Time one slice may take before the scheduler yields to other tasks (default 8 ms)
+@property (nonatomic, assign) NSTimeInterval sliceBudget;
+
+// Minimum interval between progress callbacks of a task (default 0.25 s)
+@property (nonatomic, assign) NSTimeInterval progressInterval;
+
+// Queues the task; the highest priority runnable task gets the next slice
+- (void)addTask:(VLCScheduledTask *)task;
+
+@end
+
+NS_ASSUME_NONNULL_END
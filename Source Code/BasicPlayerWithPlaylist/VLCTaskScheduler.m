@@ -0,0 +1,301 @@
+//
+//  VLCTaskScheduler.m
+//  BasicPlayerWithPlaylist
+//
+//  Cooperative Task Scheduler - Platform Independent
+//  Runs long ingestion jobs (EPG matching, movie info preloading) in time-boxed slices.
+//  Slice sizes follow measured throughput instead of fixed batch sizes and delays.
+//
+
+#import "VLCTaskScheduler.h"
+#import <time.h>
+
+// Units handed to a task's first slice, before its throughput is known
+static const NSUInteger VLCTaskInitialSliceUnits = 32;
+
+// Weight of the newest measurement in the per-unit cost average
+static const double VLCTaskCostSmoothing = 0.3;
+
+static NSTimeInterval VLCTaskThreadCPUTime(void) {
+    struct timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) {
+        return 0;
+    }
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+@interface VLCScheduledTask ()
+@property (nonatomic, readwrite) NSUInteger completedUnits;
+@property (nonatomic, readwrite, getter=isFinished) BOOL finished;
+@property (nonatomic, readwrite) NSTimeInterval cpuTime;
+@property (nonatomic, readwrite) NSTimeInterval wallTime;
+@property (nonatomic, readwrite) NSUInteger sliceCount;
+@property (nonatomic, readwrite) NSUInteger yieldCount;
+@property (nonatomic, readonly) VLCTaskStepBlock step;
+@property (nonatomic, assign) NSUInteger sequence;              // FIFO order within a priority
+@property (nonatomic, assign) double secondsPerUnit;            // Smoothed cost of one unit
+@property (nonatomic, assign) double rateAllowance;             // Units the rate cap allows right now
+@property (nonatomic, assign) CFAbsoluteTime rateUpdatedTime;
+@property (nonatomic, assign) CFAbsoluteTime lastProgressTime;
+@end
+
+@implementation VLCScheduledTask {
+    volatile int32_t _cancelled;
+}
+
+- (instancetype)initWithName:(NSString *)name
+                    priority:(VLCTaskPriority)priority
+                  totalUnits:(NSUInteger)totalUnits
+                        step:(VLCTaskStepBlock)step {
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _priority = priority;
+        _totalUnits = totalUnits;
+        _step = [step copy];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_name release];
+    [_step release];
+    [_progressBlock release];
+    [_completionBlock release];
+    [super dealloc];
+}
+
+- (BOOL)isCancelled {
+    return __atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE) != 0;
+}
+
+- (void)cancel {
+    __atomic_store_n(&_cancelled, 1, __ATOMIC_RELEASE);
+}
+
+// Units for the next slice so it lasts about one budget
+- (NSUInteger)unitsForBudget:(NSTimeInterval)budget {
+    NSUInteger remaining = self.totalUnits - self.completedUnits;
+    NSUInteger units = VLCTaskInitialSliceUnits;
+    if (self.secondsPerUnit > 0) {
+        double fitting = budget / self.secondsPerUnit;
+        units = fitting < 1.0 ? 1 : (fitting > (double)NSUIntegerMax / 2 ? NSUIntegerMax / 2 : (NSUInteger)fitting);
+    }
+    return MIN(units, remaining);
+}
+
+// Applies the rate cap; returns the units allowed now (0 = wait until *wakeTime)
+- (NSUInteger)rateLimitedUnits:(NSUInteger)units now:(CFAbsoluteTime)now wakeTime:(CFAbsoluteTime *)wakeTime {
+    if (self.maxUnitsPerSecond <= 0) {
+        return units;
+    }
+    if (self.rateUpdatedTime == 0) {
+        self.rateAllowance = 1.0;
+    } else {
+        // Refill, allowing at most one second of burst
+        double refilled = self.rateAllowance + (now - self.rateUpdatedTime) * self.maxUnitsPerSecond;
+        self.rateAllowance = MIN(refilled, MAX(self.maxUnitsPerSecond, 1.0));
+    }
+    self.rateUpdatedTime = now;
+
+    if (self.rateAllowance < 1.0) {
+        *wakeTime = now + (1.0 - self.rateAllowance) / self.maxUnitsPerSecond;
+        return 0;
+    }
+    return MIN(units, (NSUInteger)self.rateAllowance);
+}
+
+@end
+
+@implementation VLCTaskScheduler {
+    dispatch_queue_t _queue;
+    NSMutableArray<VLCScheduledTask *> *_tasks; // Only touched on _queue
+    NSUInteger _nextSequence;
+    BOOL _drainPending;
+    CFAbsoluteTime _wakeTime;                   // Pending timed wake-up for rate-capped tasks, 0 = none
+}
+
++ (instancetype)sharedScheduler {
+    static VLCTaskScheduler *sharedScheduler = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedScheduler = [[VLCTaskScheduler alloc] init];
+    });
+    return sharedScheduler;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        // Utility QoS keeps ingestion from competing with the main thread for a core
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        _queue = dispatch_queue_create("com.vlc.taskscheduler", attributes);
+        _tasks = [[NSMutableArray alloc] init];
+        _sliceBudget = 0.008;
+        _progressInterval = 0.25;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    dispatch_release(_queue);
+    [_tasks release];
+    [super dealloc];
+}
+
+#pragma mark - Scheduling
+
+- (void)addTask:(VLCScheduledTask *)task {
+    if (!task) {
+        return;
+    }
+    [task retain];
+    dispatch_async(_queue, ^{
+        task.sequence = _nextSequence++;
+        [_tasks addObject:task];
+        [task release];
+        [self scheduleDrain];
+    });
+}
+
+// On _queue. Each slice is its own queue item, so adding a task or a higher priority
+// task becoming runnable takes effect at the next slice boundary.
+- (void)scheduleDrain {
+    if (_drainPending) {
+        return;
+    }
+    _drainPending = YES;
+    dispatch_async(_queue, ^{
+        _drainPending = NO;
+        [self runSlice];
+    });
+}
+
+- (void)scheduleWakeAt:(CFAbsoluteTime)wakeTime {
+    if (_wakeTime != 0 && _wakeTime <= wakeTime) {
+        return;
+    }
+    _wakeTime = wakeTime;
+    NSTimeInterval delay = MAX(wakeTime - CFAbsoluteTimeGetCurrent(), 0);
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _queue, ^{
+        if (_wakeTime == wakeTime) {
+            _wakeTime = 0;
+            [self scheduleDrain];
+        }
+    });
+}
+
+- (void)runSlice {
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+
+    // Drop cancelled tasks first so they never get another slice
+    for (VLCScheduledTask *task in [[_tasks copy] autorelease]) {
+        if (task.isCancelled) {
+            [self finishTask:task];
+        }
+    }
+
+    // Highest priority first, then oldest; rate-capped tasks without allowance wait
+    VLCScheduledTask *selected = nil;
+    NSUInteger selectedUnits = 0;
+    CFAbsoluteTime earliestWake = 0;
+    for (VLCScheduledTask *task in _tasks) {
+        if (selected && (task.priority < selected.priority ||
+                         (task.priority == selected.priority && task.sequence > selected.sequence))) {
+            continue;
+        }
+        CFAbsoluteTime wakeTime = 0;
+        NSUInteger units = [task rateLimitedUnits:[task unitsForBudget:self.sliceBudget] now:now wakeTime:&wakeTime];
+        if (units == 0 && task.completedUnits < task.totalUnits) {
+            if (earliestWake == 0 || wakeTime < earliestWake) {
+                earliestWake = wakeTime;
+            }
+            continue;
+        }
+        selected = task;
+        selectedUnits = units;
+    }
+
+    if (!selected) {
+        if (earliestWake > 0) {
+            [self scheduleWakeAt:earliestWake];
+        }
+        return;
+    }
+
+    if (selectedUnits > 0) {
+        NSRange range = NSMakeRange(selected.completedUnits, selectedUnits);
+        CFAbsoluteTime sliceStart = CFAbsoluteTimeGetCurrent();
+        NSTimeInterval cpuStart = VLCTaskThreadCPUTime();
+
+        @autoreleasepool {
+            selected.step(range);
+        }
+
+        NSTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - sliceStart;
+        selected.cpuTime += VLCTaskThreadCPUTime() - cpuStart;
+        selected.wallTime += elapsed;
+        selected.sliceCount++;
+        selected.completedUnits += selectedUnits;
+        if (selected.maxUnitsPerSecond > 0) {
+            selected.rateAllowance -= selectedUnits;
+        }
+
+        // Track the cost of one unit so the next slice fits the budget on this machine
+        double secondsPerUnit = elapsed / selectedUnits;
+        selected.secondsPerUnit = selected.secondsPerUnit > 0
+            ? selected.secondsPerUnit + VLCTaskCostSmoothing * (secondsPerUnit - selected.secondsPerUnit)
+            : secondsPerUnit;
+    }
+
+    if (selected.completedUnits >= selected.totalUnits) {
+        [self finishTask:selected];
+    } else {
+        selected.yieldCount++;
+        [self publishProgressForTask:selected force:NO];
+    }
+
+    if (_tasks.count > 0) {
+        [self scheduleDrain];
+    }
+}
+
+- (void)publishProgressForTask:(VLCScheduledTask *)task force:(BOOL)force {
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    if (!task.progressBlock || (!force && now - task.lastProgressTime < self.progressInterval)) {
+        return;
+    }
+    task.lastProgressTime = now;
+
+    VLCTaskProgressBlock progressBlock = task.progressBlock;
+    NSUInteger completedUnits = task.completedUnits;
+    NSUInteger totalUnits = task.totalUnits;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        progressBlock(completedUnits, totalUnits);
+    });
+}
+
+- (void)finishTask:(VLCScheduledTask *)task {
+    [task retain];
+    [_tasks removeObjectIdenticalTo:task];
+    task.finished = YES;
+
+    if (!task.isCancelled) {
+        [self publishProgressForTask:task force:YES];
+    }
+
+    NSLog(@"⏱️ [SCHEDULER] %@ %@: %lu/%lu units, %lu slices, %lu yields, %.3fs CPU, %.3fs wall",
+          task.name, task.isCancelled ? @"cancelled" : @"finished",
+          (unsigned long)task.completedUnits, (unsigned long)task.totalUnits,
+          (unsigned long)task.sliceCount, (unsigned long)task.yieldCount,
+          task.cpuTime, task.wallTime);
+
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (task.completionBlock) {
+            task.completionBlock(task);
+        }
+        [task release];
+    });
+}
+
+@end
@@ -0,0 +1,266 @@
+//
+//  VLCTimerWheel.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable Timer Wheel - Platform Independent (plain C)
+//  Hierarchical timing wheel with one-second ticks for a fixed set of timers (one per
+//  channel); scheduling, cancelling and firing never allocate
+//
+
+#include "VLCTimerWheel.h"
+
+#include <stdlib.h>
+
+// Four levels of 64 slots: level 0 holds the next 64 seconds one second per slot, level 1 the
+// next ~68 minutes a minute per slot, level 2 ~3 days, level 3 ~194 days. A timer sits in the
+// coarsest slot that still separates it from now and moves down a level when that slot comes
+// up. Anything further out waits in the last level 3 slot and is re-filed from there.
+#define VLC_WHEEL_BITS 6
+#define VLC_WHEEL_SLOTS (1 << VLC_WHEEL_BITS)
+#define VLC_WHEEL_LEVELS 4
+#define VLC_WHEEL_RANGE ((int64_t)1 << (VLC_WHEEL_BITS * VLC_WHEEL_LEVELS))
+
+// Lists: one per slot, one for timers already due and one for timers being fired
+#define VLC_WHEEL_DUE_LIST (VLC_WHEEL_LEVELS * VLC_WHEEL_SLOTS)
+#define VLC_WHEEL_FIRING_LIST (VLC_WHEEL_DUE_LIST + 1)
+#define VLC_WHEEL_LIST_COUNT (VLC_WHEEL_FIRING_LIST + 1)
+#define VLC_WHEEL_NO_LIST UINT16_MAX
+#define VLC_WHEEL_NIL UINT32_MAX
+
+// Advancing one tick at a time is cheap up to about three days' worth of ticks
+#define VLC_WHEEL_MAX_STEPS ((int64_t)1 << (VLC_WHEEL_BITS * 3))
+
+struct VLCTimerWheel {
+    int64_t now;
+    size_t capacity;
+    size_t scheduled;
+    int64_t *expiry;
+    uint32_t *next;         // Doubly linked lists threaded through the timer arrays
+    uint32_t *prev;
+    uint16_t *list;         // List holding each timer, VLC_WHEEL_NO_LIST when idle
+    uint32_t heads[VLC_WHEEL_LIST_COUNT];
+};
+
+#pragma mark - Lifecycle
+
+VLCTimerWheel *VLCTimerWheelCreate(size_t capacity, int64_t now) {
+    if (capacity >= VLC_WHEEL_NIL) {
+        return NULL;
+    }
+    VLCTimerWheel *wheel = calloc(1, sizeof(VLCTimerWheel));
+    if (!wheel) {
+        return NULL;
+    }
+    size_t slots = capacity ? capacity : 1;
+    wheel->expiry = malloc(slots * sizeof(int64_t));
+    wheel->next = malloc(slots * sizeof(uint32_t));
+    wheel->prev = malloc(slots * sizeof(uint32_t));
+    wheel->list = malloc(slots * sizeof(uint16_t));
+    if (!wheel->expiry || !wheel->next || !wheel->prev || !wheel->list) {
+        VLCTimerWheelFree(wheel);
+        return NULL;
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        wheel->list[i] = VLC_WHEEL_NO_LIST;
+    }
+    for (size_t i = 0; i < VLC_WHEEL_LIST_COUNT; i++) {
+        wheel->heads[i] = VLC_WHEEL_NIL;
+    }
+    wheel->capacity = capacity;
+    wheel->now = now;
+    return wheel;
+}
+
+void VLCTimerWheelFree(VLCTimerWheel *wheel) {
+    if (!wheel) {
+        return;
+    }
+    free(wheel->expiry);
+    free(wheel->next);
+    free(wheel->prev);
+    free(wheel->list);
+    free(wheel);
+}
+
+size_t VLCTimerWheelScheduledCount(const VLCTimerWheel *wheel) {
+    return wheel ? wheel->scheduled : 0;
+}
+
+#pragma mark - Lists
+
+static void VLCTimerWheelLink(VLCTimerWheel *wheel, uint32_t timer, uint16_t list) {
+    uint32_t head = wheel->heads[list];
+    wheel->next[timer] = head;
+    wheel->prev[timer] = VLC_WHEEL_NIL;
+    if (head != VLC_WHEEL_NIL) {
+        wheel->prev[head] = timer;
+    }
+    wheel->heads[list] = timer;
+    wheel->list[timer] = list;
+}
+
+static void VLCTimerWheelUnlink(VLCTimerWheel *wheel, uint32_t timer) {
+    uint16_t list = wheel->list[timer];
+    uint32_t next = wheel->next[timer];
+    uint32_t prev = wheel->prev[timer];
+    if (prev != VLC_WHEEL_NIL) {
+        wheel->next[prev] = next;
+    } else {
+        wheel->heads[list] = next;
+    }
+    if (next != VLC_WHEEL_NIL) {
+        wheel->prev[next] = prev;
+    }
+    wheel->list[timer] = VLC_WHEEL_NO_LIST;
+}
+
+// Takes a whole list out of the wheel; the caller walks it through next[]
+static uint32_t VLCTimerWheelDetach(VLCTimerWheel *wheel, uint16_t list) {
+    uint32_t head = wheel->heads[list];
+    wheel->heads[list] = VLC_WHEEL_NIL;
+    for (uint32_t timer = head; timer != VLC_WHEEL_NIL; timer = wheel->next[timer]) {
+        wheel->list[timer] = VLC_WHEEL_NO_LIST;
+    }
+    return head;
+}
+
+// Files a timer by its expiry relative to the clock
+static void VLCTimerWheelFile(VLCTimerWheel *wheel, uint32_t timer) {
+    int64_t expiry = wheel->expiry[timer];
+    if (expiry <= wheel->now) {
+        VLCTimerWheelLink(wheel, timer, VLC_WHEEL_DUE_LIST);
+        return;
+    }
+    int64_t target = expiry;
+    if (expiry - wheel->now >= VLC_WHEEL_RANGE) {
+        target = wheel->now + VLC_WHEEL_RANGE - 1;
+    }
+    int64_t delta = target - wheel->now;
+    int level = 0;
+    while (level < VLC_WHEEL_LEVELS - 1 && delta >= ((int64_t)1 << (VLC_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    int slot = (int)((target >> (VLC_WHEEL_BITS * level)) & (VLC_WHEEL_SLOTS - 1));
+    VLCTimerWheelLink(wheel, timer, (uint16_t)(level * VLC_WHEEL_SLOTS + slot));
+}
+
+#pragma mark - Scheduling
+
+void VLCTimerWheelSchedule(VLCTimerWheel *wheel, uint32_t timer, int64_t expiry) {
+    if (!wheel || timer >= wheel->capacity) {
+        return;
+    }
+    if (wheel->list[timer] != VLC_WHEEL_NO_LIST) {
+        VLCTimerWheelUnlink(wheel, timer);
+    } else {
+        wheel->scheduled++;
+    }
+    wheel->expiry[timer] = expiry;
+    VLCTimerWheelFile(wheel, timer);
+}
+
+void VLCTimerWheelCancel(VLCTimerWheel *wheel, uint32_t timer) {
+    if (!wheel || timer >= wheel->capacity || wheel->list[timer] == VLC_WHEEL_NO_LIST) {
+        return;
+    }
+    VLCTimerWheelUnlink(wheel, timer);
+    wheel->scheduled--;
+}
+
+#pragma mark - Advancing
+
+// Fires every timer in a list. The timers are moved to the firing list first and taken off
+// it one by one, so a callback can schedule or cancel any of them (including ones not fired
+// yet); a timer it schedules for now is not fired again in the same pass.
+static size_t VLCTimerWheelFire(VLCTimerWheel *wheel, uint16_t list, VLCTimerWheelCallback callback, void *context) {
+    uint32_t head = VLCTimerWheelDetach(wheel, list);
+    if (head == VLC_WHEEL_NIL) {
+        return 0;
+    }
+    wheel->heads[VLC_WHEEL_FIRING_LIST] = head;
+    for (uint32_t timer = head; timer != VLC_WHEEL_NIL; timer = wheel->next[timer]) {
+        wheel->list[timer] = VLC_WHEEL_FIRING_LIST;
+    }
+
+    size_t fired = 0;
+    uint32_t timer;
+    while ((timer = wheel->heads[VLC_WHEEL_FIRING_LIST]) != VLC_WHEEL_NIL) {
+        VLCTimerWheelUnlink(wheel, timer);
+        wheel->scheduled--;
+        fired++;
+        if (callback) {
+            callback(timer, wheel->expiry[timer], context);
+        }
+    }
+    return fired;
+}
+
+// Moves a detached list back into the wheel, each timer by its own expiry
+static void VLCTimerWheelRefile(VLCTimerWheel *wheel, uint32_t head) {
+    uint32_t timer = head;
+    while (timer != VLC_WHEEL_NIL) {
+        uint32_t next = wheel->next[timer];
+        VLCTimerWheelFile(wheel, timer);
+        timer = next;
+    }
+}
+
+size_t VLCTimerWheelAdvance(VLCTimerWheel *wheel, int64_t now, VLCTimerWheelCallback callback, void *context) {
+    if (!wheel) {
+        return 0;
+    }
+
+    if (now < wheel->now || now - wheel->now > VLC_WHEEL_MAX_STEPS) {
+        // Clock change or a long sleep: pull every timer out and file it against the new clock
+        wheel->now = now;
+        for (uint16_t list = 0; list < VLC_WHEEL_DUE_LIST; list++) {
+            uint32_t head = VLCTimerWheelDetach(wheel, list);
+            VLCTimerWheelRefile(wheel, head);
+        }
+    }
+
+    size_t fired = VLCTimerWheelFire(wheel, VLC_WHEEL_DUE_LIST, callback, context);
+    while (wheel->now < now) {
+        int64_t tick = ++wheel->now;
+        // Split the coarse slots that start at this tick, top level first
+        for (int level = VLC_WHEEL_LEVELS - 1; level > 0; level--) {
+            int64_t unit = (int64_t)1 << (VLC_WHEEL_BITS * level);
+            if (tick % unit == 0) {
+                int slot = (int)((tick >> (VLC_WHEEL_BITS * level)) & (VLC_WHEEL_SLOTS - 1));
+                VLCTimerWheelRefile(wheel, VLCTimerWheelDetach(wheel, (uint16_t)(level * VLC_WHEEL_SLOTS + slot)));
+            }
+        }
+        int slot = (int)(tick & (VLC_WHEEL_SLOTS - 1));
+        fired += VLCTimerWheelFire(wheel, (uint16_t)slot, callback, context);
+        // Refiling puts timers that expire exactly now on the due list
+        fired += VLCTimerWheelFire(wheel, VLC_WHEEL_DUE_LIST, callback, context);
+    }
+    return fired;
+}
+
+int64_t VLCTimerWheelNextExpiry(const VLCTimerWheel *wheel) {
+    if (!wheel || wheel->scheduled == 0) {
+        return VLC_TIMER_WHEEL_NEVER;
+    }
+    if (wheel->heads[VLC_WHEEL_DUE_LIST] != VLC_WHEEL_NIL) {
+        return wheel->now;
+    }
+    // Level 0 slots hold one second each; a coarser slot is due when it starts, which can be
+    // sooner than a timer late in level 0
+    int64_t earliest = VLC_TIMER_WHEEL_NEVER;
+    for (int level = 0; level < VLC_WHEEL_LEVELS; level++) {
+        int shift = VLC_WHEEL_BITS * level;
+        int64_t bucket = wheel->now >> shift;
+        for (int64_t step = 1; step <= VLC_WHEEL_SLOTS; step++) {
+            int slot = (int)((bucket + step) & (VLC_WHEEL_SLOTS - 1));
+            if (wheel->heads[level * VLC_WHEEL_SLOTS + slot] != VLC_WHEEL_NIL) {
+                int64_t start = (bucket + step) << shift;
+                if (start < earliest) {
+                    earliest = start;
+                }
+                break;
+            }
+        }
+    }
+    return earliest;
+}
@@ -0,0 +1,58 @@
+//
+//  VLCTimerWheel.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable Timer Wheel - Platform Independent (plain C)
+//  Hierarchical timing wheel with one-second ticks for a fixed set of timers (one per
+//  channel); scheduling, cancelling and firing never allocate
+//
+
+#ifndef VLCTimerWheel_h
+#define VLCTimerWheel_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returned by VLCTimerWheelNextExpiry when nothing is scheduled
+#define VLC_TIMER_WHEEL_NEVER INT64_MAX
+
+typedef struct VLCTimerWheel VLCTimerWheel;
+
+// Called for each timer that expired; it may schedule or cancel any timer, including this one
+typedef void (*VLCTimerWheelCallback)(uint32_t timer, int64_t expiry, void *context);
+
+/**
+ * Creates a wheel for timers 0..capacity-1, with the clock at now (seconds, >= 0).
+ * @return NULL on allocation failure or a capacity over UINT32_MAX - 1.
+ */
+VLCTimerWheel *VLCTimerWheelCreate(size_t capacity, int64_t now);
+void VLCTimerWheelFree(VLCTimerWheel *wheel);
+
+// Sets the timer to fire at expiry, replacing any earlier schedule. A time that is not after
+// the wheel's clock fires on the next advance.
+void VLCTimerWheelSchedule(VLCTimerWheel *wheel, uint32_t timer, int64_t expiry);
+void VLCTimerWheelCancel(VLCTimerWheel *wheel, uint32_t timer);
+
+/**
+ * Moves the clock to now and fires every timer due by then, in expiry order. After the clock
+ * went backwards or jumped more than about three days ahead, every timer is re-filed against
+ * the new time and the overdue ones fire together, in no particular order.
+ * @return The number of timers fired.
+ */
+size_t VLCTimerWheelAdvance(VLCTimerWheel *wheel, int64_t now, VLCTimerWheelCallback callback, void *context);
+
+// A time by which the wheel should next be advanced: the earliest expiry, or earlier when a
+// coarse slot has to be split first. VLC_TIMER_WHEEL_NEVER when no timer is scheduled.
+int64_t VLCTimerWheelNextExpiry(const VLCTimerWheel *wheel);
+
+size_t VLCTimerWheelScheduledCount(const VLCTimerWheel *wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCTimerWheel_h */
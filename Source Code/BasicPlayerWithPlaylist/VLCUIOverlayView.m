@@ -14,12 +14,15 @@
 #import <objc/runtime.h>
 
 #import "VLCChannel.h"
+#import "VLCChannelStore.h"
 #import "VLCProgram.h"
 #import "DownloadManager.h"
 #import <CommonCrypto/CommonDigest.h>
 // #import "VLCOverlayView+EPG.h" - REMOVED: Old EPG system eliminated
 #import "VLCOverlayView+ChannelManagement.h"
 #import "VLCDataManager.h"
+#import "VLCEPGManager.h"
+#import "VLCNowNextTable.h"
 #import "VLCCacheManager.h"
 
 // EPG functionality is now shared between macOS and iOS via the EPG category
@@ -2827,6 +2830,12 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
                                                      name:@"VLCEPGMatchingProgress" 
                                                    object:nil];
         
+        // Programmes changed on some channels (a show ended somewhere)
+        [[NSNotificationCenter defaultCenter] addObserver:self 
+                                                 selector:@selector(nowNextTableDidChange:) 
+                                                     name:VLCNowNextTableDidChangeNotification 
+                                                   object:nil];
+        
         NSLog(@"🎬 Testing setupGestures...");
         [self setupGestures];
         NSLog(@"🎬 setupGestures completed");
@@ -4703,6 +4712,17 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
     // Get channels for current selection
     NSArray *channels = [self getChannelsForCurrentGroup];
     
+    // Rows on screen, plus one above for smooth scrolling; their current programs are looked
+    // up together once per frame
+    CGFloat rowHeight = [self rowHeight];
+    NSInteger firstVisibleRow = rowHeight > 0 ? MAX(0, (NSInteger)floor(_channelScrollPosition / rowHeight) - 1) : 0;
+    NSInteger visibleRowCount = rowHeight > 0 ? MIN((NSInteger)ceil(rect.size.height / rowHeight) + 2, 256) : 0;
+    VLCProgram *visiblePrograms[256];
+    [_dataManager.epgManager getCurrentPrograms:visiblePrograms
+                                    forChannels:channels
+                                          range:NSMakeRange(firstVisibleRow, visibleRowCount)
+                                timeOffsetHours:(NSInteger)self.epgTimeOffsetHours];
+    
     // Draw channel items
     for (NSInteger i = 0; i < channels.count; i++) {
         CGRect itemRect = CGRectMake(channelListX, i * [self rowHeight] - _channelScrollPosition, 
@@ -4713,6 +4733,10 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
         if (itemRect.origin.y + itemRect.size.height < -[self rowHeight]) {
             continue;
         }
+        // Nothing further down is visible
+        if (itemRect.origin.y >= rect.size.height) {
+            break;
+        }
         
         // Highlight hovered or selected channel using custom selection colors (like macOS)
         if (i == _hoveredChannelIndex || i == _selectedChannelIndex) {
@@ -4865,7 +4889,10 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
         
         // Draw EPG data below channel name (like macOS version)
         if (channel) {
-            VLCProgram *currentProgram = [channel currentProgramWithTimeOffset:self.epgTimeOffsetHours];
+            NSInteger visibleSlot = i - firstVisibleRow;
+            VLCProgram *currentProgram = (visibleSlot >= 0 && visibleSlot < visibleRowCount)
+                ? visiblePrograms[visibleSlot]
+                : [channel currentProgramWithTimeOffset:self.epgTimeOffsetHours];
             
             // Check if we have EPG data
             BOOL hasEpgData = (self.isEpgLoaded && currentProgram != nil);
@@ -7459,13 +7486,14 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
         [favoritesData setObject:favoriteGroups forKey:@"groups"];
         
         NSMutableArray *favoriteChannels = [NSMutableArray array];
+        VLCURLPrefixEncoder *urlEncoder = [[[VLCURLPrefixEncoder alloc] init] autorelease];
         for (NSString *group in favoriteGroups) {
             NSArray *groupChannels = [_channelsByGroup objectForKey:group];
             if (groupChannels) {
                 for (VLCChannel *channel in groupChannels) {
                     NSMutableDictionary *channelDict = [NSMutableDictionary dictionary];
                     [channelDict setObject:(channel.name ? channel.name : @"") forKey:@"name"];
-                    [channelDict setObject:(channel.url ? channel.url : @"") forKey:@"url"];
+                    [urlEncoder setURL:(channel.url ? channel.url : @"") inDictionary:channelDict];
                     [channelDict setObject:(channel.group ? channel.group : @"") forKey:@"group"];
                     if (channel.logo) [channelDict setObject:channel.logo forKey:@"logo"];
                     if (channel.channelId) [channelDict setObject:channel.channelId forKey:@"channelId"];
@@ -7484,6 +7512,7 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
         }
         if (favoriteChannels.count > 0) {
             [favoritesData setObject:favoriteChannels forKey:@"channels"];
+            [favoritesData setObject:urlEncoder.prefixes forKey:@"urlPrefixes"];
         }
         
         // Store the favorites data
@@ -9120,6 +9149,7 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
     }
     
     NSLog(@"📺 [PLAYBACK] Playing channel: %@ (URL: %@)", channel.name, channel.url);
+    _dataManager.playingChannel = channel;
     
     // Save last played content info BEFORE starting playback
     [self saveLastPlayedChannelUrl:channel.url];
@@ -9402,13 +9432,14 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
     // Restore favorite channels
     NSArray *favoriteChannels = [favoritesData objectForKey:@"channels"];
     if (favoriteChannels && [favoriteChannels isKindOfClass:[NSArray class]]) {
+        VLCURLPrefixEncoder *urlEncoder = [[[VLCURLPrefixEncoder alloc] initWithPrefixes:[favoritesData objectForKey:@"urlPrefixes"]] autorelease];
         for (NSDictionary *channelDict in favoriteChannels) {
             if (![channelDict isKindOfClass:[NSDictionary class]]) continue;
             
             // Create a new channel object
             VLCChannel *channel = [[VLCChannel alloc] init];
             channel.name = [channelDict objectForKey:@"name"];
-            channel.url = [channelDict objectForKey:@"url"];
+            channel.url = [urlEncoder URLFromDictionary:channelDict];
             channel.group = [channelDict objectForKey:@"group"];
             channel.logo = [channelDict objectForKey:@"logo"];
             channel.channelId = [channelDict objectForKey:@"channelId"];
@@ -13610,6 +13641,11 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
     });
 }
 
+- (void)nowNextTableDidChange:(NSNotification *)notification {
+    // Posted on the main thread, only when a programme actually ended somewhere
+    [self setNeedsDisplay];
+}
+
 - (void)dataManagerDidUpdateChannels:(NSArray<VLCChannel *> *)channels {
     NSLog(@"📺 VLCDataManager updated channels: %lu channels", (unsigned long)channels.count);
     
@@ -14022,8 +14058,7 @@ NSInteger _tvosSelectedSettingsControl; // Index of currently selected settings
             VLCChannel *mainChannel = [self findMainChannelWithId:favChannel.channelId url:favChannel.url];
             if (mainChannel && mainChannel.programs && mainChannel.programs.count > 0) {
                 // Update favorite channel with EPG data
-                [favChannel.programs release];
-                favChannel.programs = [mainChannel.programs mutableCopy];
+                favChannel.programs = mainChannel.programs;
                 updatedChannels++;
                 totalPrograms += mainChannel.programs.count;
                 NSLog(@"📅 [FAVORITES-iOS] Updated %@ with %lu EPG programs", 
@@ -0,0 +1,176 @@
+//
+//  VLCURLPrefixTable.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable URL Prefix Table - Platform Independent (plain C)
+//  Stores the shared part of stream URLs once (e.g. http://host:port/user/pass/) so each
+//  channel only keeps a prefix id plus its own suffix (stream id and extension)
+//
+
+#include "VLCURLPrefixTable.h"
+#include "VLCHashIndex.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Entries live in blocks that are never reallocated, so readers can look up an id
+// while another prefix is being added
+#define VLC_URL_PREFIX_BLOCK_BITS 8
+#define VLC_URL_PREFIX_BLOCK_SIZE ((uint32_t)1 << VLC_URL_PREFIX_BLOCK_BITS)
+#define VLC_URL_PREFIX_MAX_BLOCKS (VLC_URL_PREFIX_TABLE_CAPACITY / VLC_URL_PREFIX_BLOCK_SIZE)
+
+typedef struct {
+    char *bytes;
+    size_t length;
+} VLCURLPrefixEntry;
+
+struct VLCURLPrefixTable {
+    VLCURLPrefixEntry *blocks[VLC_URL_PREFIX_MAX_BLOCKS];
+    uint32_t count;
+    size_t prefixBytes;
+    VLCHashIndex *index;    // Prefix hash -> id
+};
+
+#pragma mark - Splitting
+
+size_t VLCURLPrefixLength(const char *url, size_t length) {
+    if (!url) {
+        return 0;
+    }
+
+    // Only the path is shared; "?token=..." and "#..." belong to the suffix
+    size_t pathEnd = length;
+    for (size_t i = 0; i < length; i++) {
+        if (url[i] == '?' || url[i] == '#') {
+            pathEnd = i;
+            break;
+        }
+    }
+
+    // Skip "scheme://" so the prefix always ends inside the path
+    size_t pathStart = 0;
+    for (size_t i = 0; i + 2 < pathEnd; i++) {
+        if (url[i] == ':' && url[i + 1] == '/' && url[i + 2] == '/') {
+            pathStart = i + 3;
+            break;
+        }
+        if (url[i] == '/') {
+            break;
+        }
+    }
+
+    for (size_t i = pathEnd; i > pathStart; i--) {
+        if (url[i - 1] == '/') {
+            return i;
+        }
+    }
+    return 0;
+}
+
+#pragma mark - Lifecycle
+
+VLCURLPrefixTable *VLCURLPrefixTableCreate(void) {
+    return calloc(1, sizeof(VLCURLPrefixTable));
+}
+
+void VLCURLPrefixTableFree(VLCURLPrefixTable *table) {
+    if (!table) {
+        return;
+    }
+    for (uint32_t i = 0; i < table->count; i++) {
+        free(table->blocks[i >> VLC_URL_PREFIX_BLOCK_BITS][i & (VLC_URL_PREFIX_BLOCK_SIZE - 1)].bytes);
+    }
+    for (size_t i = 0; i < VLC_URL_PREFIX_MAX_BLOCKS; i++) {
+        free(table->blocks[i]);
+    }
+    VLCHashIndexFree(table->index);
+    free(table);
+}
+
+#pragma mark - Interning
+
+uint32_t VLCURLPrefixTableIntern(VLCURLPrefixTable *table, const char *bytes, size_t length) {
+    if (!table || length == 0) {
+        return VLC_URL_PREFIX_NONE;
+    }
+    if (!table->index) {
+        table->index = VLCHashIndexCreate(16);
+        if (!table->index) {
+            return VLC_URL_PREFIX_NONE;
+        }
+    }
+
+    uint64_t hash = VLCHashBytes(bytes, length, VLC_HASH_SEED);
+    uint32_t existing = VLCHashIndexGet(table->index, hash);
+    if (existing) {
+        size_t existingLength = 0;
+        const char *existingBytes = VLCURLPrefixTableGet(table, existing, &existingLength);
+        if (existingLength == length && memcmp(existingBytes, bytes, length) == 0) {
+            return existing;
+        }
+        // Hash collision: the second prefix is simply not shared
+        return VLC_URL_PREFIX_NONE;
+    }
+
+    if (table->count >= VLC_URL_PREFIX_TABLE_CAPACITY) {
+        return VLC_URL_PREFIX_NONE;
+    }
+
+    uint32_t slot = table->count;
+    size_t block = slot >> VLC_URL_PREFIX_BLOCK_BITS;
+    if (!table->blocks[block]) {
+        table->blocks[block] = calloc(VLC_URL_PREFIX_BLOCK_SIZE, sizeof(VLCURLPrefixEntry));
+        if (!table->blocks[block]) {
+            return VLC_URL_PREFIX_NONE;
+        }
+    }
+
+    char *copy = malloc(length);
+    if (!copy) {
+        return VLC_URL_PREFIX_NONE;
+    }
+    memcpy(copy, bytes, length);
+
+    VLCURLPrefixEntry *entry = &table->blocks[block][slot & (VLC_URL_PREFIX_BLOCK_SIZE - 1)];
+    entry->bytes = copy;
+    entry->length = length;
+
+    uint32_t prefixId = slot + 1;
+    if (!VLCHashIndexSet(table->index, hash, prefixId)) {
+        free(copy);
+        entry->bytes = NULL;
+        entry->length = 0;
+        return VLC_URL_PREFIX_NONE;
+    }
+    table->count = prefixId;
+    table->prefixBytes += length;
+    return prefixId;
+}
+
+#pragma mark - Access
+
+const char *VLCURLPrefixTableGet(const VLCURLPrefixTable *table, uint32_t prefixId, size_t *length) {
+    if (!table || prefixId == VLC_URL_PREFIX_NONE || prefixId > VLC_URL_PREFIX_TABLE_CAPACITY) {
+        if (length) *length = 0;
+        return "";
+    }
+    uint32_t slot = prefixId - 1;
+    const VLCURLPrefixEntry *entry = &table->blocks[slot >> VLC_URL_PREFIX_BLOCK_BITS][slot & (VLC_URL_PREFIX_BLOCK_SIZE - 1)];
+    if (length) *length = entry->length;
+    return entry->bytes;
+}
+
+uint32_t VLCURLPrefixTableCount(const VLCURLPrefixTable *table) {
+    return table ? table->count : 0;
+}
+
+size_t VLCURLPrefixTableBytesAllocated(const VLCURLPrefixTable *table) {
+    if (!table) {
+        return 0;
+    }
+    size_t bytes = sizeof(VLCURLPrefixTable) + table->prefixBytes;
+    bytes += ((table->count + VLC_URL_PREFIX_BLOCK_SIZE - 1) / VLC_URL_PREFIX_BLOCK_SIZE) *
+             VLC_URL_PREFIX_BLOCK_SIZE * sizeof(VLCURLPrefixEntry);
+    bytes += table->count * 2 * (sizeof(uint64_t) + sizeof(uint32_t));
+    return bytes;
+}
@@ -0,0 +1,59 @@
+//
+//  VLCURLPrefixTable.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable URL Prefix Table - Platform Independent (plain C)
+//  Stores the shared part of stream URLs once (e.g. http://host:port/user/pass/) so each
+//  channel only keeps a prefix id plus its own suffix (stream id and extension)
+//
+
+#ifndef VLCURLPrefixTable_h
+#define VLCURLPrefixTable_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Prefix id meaning "no shared prefix, the suffix is the whole URL"
+#define VLC_URL_PREFIX_NONE 0
+
+// Xtream playlists have a handful of prefixes (one per host, account and stream kind).
+// Playlists whose URLs share nothing stop being split once this many prefixes exist.
+#define VLC_URL_PREFIX_TABLE_CAPACITY 4096
+
+typedef struct VLCURLPrefixTable VLCURLPrefixTable;
+
+/**
+ * Length of the shareable part of a URL: everything up to and including the last '/'
+ * of its path. Query strings and fragments never count as prefix. Returns 0 when the URL
+ * has no path separator after the host.
+ */
+size_t VLCURLPrefixLength(const char *url, size_t length);
+
+// NULL on allocation failure
+VLCURLPrefixTable *VLCURLPrefixTableCreate(void);
+void VLCURLPrefixTableFree(VLCURLPrefixTable *table);
+
+/**
+ * Returns the id of prefix bytes, adding them on first use. Returns VLC_URL_PREFIX_NONE when
+ * the table is full, memory runs out or the prefix collides with a different one.
+ * Not thread safe against other interns; lookups of returned ids may run concurrently.
+ */
+uint32_t VLCURLPrefixTableIntern(VLCURLPrefixTable *table, const char *bytes, size_t length);
+
+// Bytes of prefixId (not NUL terminated); "" with length 0 for VLC_URL_PREFIX_NONE
+const char *VLCURLPrefixTableGet(const VLCURLPrefixTable *table, uint32_t prefixId, size_t *length);
+
+uint32_t VLCURLPrefixTableCount(const VLCURLPrefixTable *table);
+
+// Bytes allocated for the prefixes and their index
+size_t VLCURLPrefixTableBytesAllocated(const VLCURLPrefixTable *table);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCURLPrefixTable_h */
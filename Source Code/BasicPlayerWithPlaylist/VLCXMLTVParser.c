@@ -0,0 +1,728 @@
+//
+//  VLCXMLTVParser.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable XMLTV Parser - Platform Independent (plain C)
+//  Incremental parser for XMLTV guides: fed download chunks as they arrive, reports each
+//  <channel> and <programme> with byte spans and skips every element the EPG does not use
+//
+
+#include "VLCXMLTVParser.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// A single <channel> or <programme> larger than this is treated as a broken document
+#define VLC_XMLTV_MAX_ELEMENT (16u * 1024u * 1024u)
+
+struct VLCXMLTVParser {
+    VLCXMLTVHandlers handlers;
+    void *context;
+    char *carry;                // Unfinished construct cut off by the end of a chunk
+    size_t carryLength;
+    size_t carryCapacity;
+    const char *pendingEnd;     // Text that completes the carried construct, NULL if unknown
+    size_t pendingEndLength;
+    char *scratch;              // Decoded text of the current element
+    size_t scratchLength;
+    size_t scratchCapacity;
+    VLCXMLTVParserStats stats;
+    int stopped;
+};
+
+// One child element inside a <channel> or <programme>
+typedef struct {
+    const char *name;
+    size_t nameLength;
+    const char *attributes;     // Between the name and the end of the open tag
+    const char *attributesEnd;
+    const char *content;        // Between the open and the close tag, empty if self-closing
+    const char *contentEnd;
+    size_t length;              // Whole element including its tags
+} VLCXMLTVChild;
+
+#pragma mark - Lifecycle
+
+VLCXMLTVParser *VLCXMLTVParserCreate(VLCXMLTVHandlers handlers, void *context) {
+    VLCXMLTVParser *parser = calloc(1, sizeof(VLCXMLTVParser));
+    if (!parser) {
+        return NULL;
+    }
+    parser->handlers = handlers;
+    parser->context = context;
+    return parser;
+}
+
+void VLCXMLTVParserFree(VLCXMLTVParser *parser) {
+    if (!parser) {
+        return;
+    }
+    free(parser->carry);
+    free(parser->scratch);
+    free(parser);
+}
+
+VLCXMLTVParserStats VLCXMLTVParserGetStats(const VLCXMLTVParser *parser) {
+    return parser->stats;
+}
+
+#pragma mark - Scanning
+
+static int VLCXMLTVIsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static int VLCXMLTVIsNameByte(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '-' || c == '_' || c == ':' || c == '.' || (unsigned char)c >= 0x80;
+}
+
+static const char *VLCXMLTVFind(const char *from, const char *end, const char *needle, size_t needleLength) {
+    while (from + needleLength <= end) {
+        const char *candidate = memchr(from, needle[0], (size_t)(end - from) - needleLength + 1);
+        if (!candidate) {
+            return NULL;
+        }
+        if (memcmp(candidate, needle, needleLength) == 0) {
+            return candidate;
+        }
+        from = candidate + 1;
+    }
+    return NULL;
+}
+
+// The '>' closing a tag, skipping any inside quoted attribute values
+static const char *VLCXMLTVFindTagEnd(const char *from, const char *end) {
+    char quote = 0;
+    for (const char *p = from; p < end; p++) {
+        char c = *p;
+        if (quote) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+// Start of "</name>" (whitespace allowed before '>'); *closeEnd is set past its '>'
+static const char *VLCXMLTVFindClose(const char *from, const char *end, const char *name, size_t nameLength, const char **closeEnd) {
+    while (from < end) {
+        const char *close = VLCXMLTVFind(from, end, "</", 2);
+        if (!close) {
+            return NULL;
+        }
+        const char *afterName = close + 2 + nameLength;
+        if (afterName < end && memcmp(close + 2, name, nameLength) == 0 &&
+            (*afterName == '>' || VLCXMLTVIsSpace(*afterName))) {
+            const char *tagEnd = memchr(afterName, '>', (size_t)(end - afterName));
+            if (!tagEnd) {
+                return NULL;
+            }
+            *closeEnd = tagEnd + 1;
+            return close;
+        }
+        from = close + 2;
+    }
+    return NULL;
+}
+
+static int VLCXMLTVNameIs(const char *name, size_t nameLength, const char *expected) {
+    size_t expectedLength = strlen(expected);
+    return nameLength == expectedLength && memcmp(name, expected, nameLength) == 0;
+}
+
+#pragma mark - Text
+
+static size_t VLCXMLTVEncodeUTF8(uint32_t codepoint, char *out) {
+    if (codepoint < 0x80) {
+        out[0] = (char)codepoint;
+        return 1;
+    }
+    if (codepoint < 0x800) {
+        out[0] = (char)(0xC0 | (codepoint >> 6));
+        out[1] = (char)(0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+    if (codepoint < 0x10000) {
+        out[0] = (char)(0xE0 | (codepoint >> 12));
+        out[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (codepoint >> 18));
+    out[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+// Decodes the entity at *cursor ('&') into out. Unknown entities are kept as a literal '&'.
+// Never writes more bytes than it consumes, so decoded text always fits the element size.
+static size_t VLCXMLTVDecodeEntity(const char **cursor, const char *end, char *out) {
+    const char *p = *cursor + 1;
+    const char *semicolon = memchr(p, ';', (size_t)(end - p) < 12 ? (size_t)(end - p) : 12);
+    if (semicolon) {
+        size_t length = (size_t)(semicolon - p);
+        char replacement = 0;
+        if (length == 3 && memcmp(p, "amp", 3) == 0) replacement = '&';
+        else if (length == 2 && memcmp(p, "lt", 2) == 0) replacement = '<';
+        else if (length == 2 && memcmp(p, "gt", 2) == 0) replacement = '>';
+        else if (length == 4 && memcmp(p, "quot", 4) == 0) replacement = '"';
+        else if (length == 4 && memcmp(p, "apos", 4) == 0) replacement = '\'';
+        if (replacement) {
+            *out = replacement;
+            *cursor = semicolon + 1;
+            return 1;
+        }
+        if (length >= 2 && p[0] == '#') {
+            int hex = (p[1] == 'x' || p[1] == 'X');
+            uint32_t codepoint = 0;
+            int digits = 0;
+            int valid = 1;
+            for (const char *d = p + 1 + hex; d < semicolon; d++, digits++) {
+                int value;
+                if (*d >= '0' && *d <= '9') value = *d - '0';
+                else if (hex && *d >= 'a' && *d <= 'f') value = *d - 'a' + 10;
+                else if (hex && *d >= 'A' && *d <= 'F') value = *d - 'A' + 10;
+                else { valid = 0; break; }
+                codepoint = codepoint * (hex ? 16 : 10) + (uint32_t)value;
+                if (codepoint > 0x10FFFF) { valid = 0; break; }
+            }
+            if (valid && digits > 0 && codepoint > 0 && (codepoint < 0xD800 || codepoint > 0xDFFF)) {
+                *cursor = semicolon + 1;
+                return VLCXMLTVEncodeUTF8(codepoint, out);
+            }
+        }
+    }
+    *out = '&';
+    *cursor = *cursor + 1;
+    return 1;
+}
+
+// Trimmed text of [from, end). Plain text is returned in place; text with entities or
+// CDATA sections is decoded into the scratch buffer sized for the current element.
+static VLCXMLTVSpan VLCXMLTVText(VLCXMLTVParser *parser, const char *from, const char *end) {
+    VLCXMLTVSpan span = { NULL, 0 };
+    while (from < end && VLCXMLTVIsSpace(*from)) {
+        from++;
+    }
+    while (end > from && VLCXMLTVIsSpace(end[-1])) {
+        end--;
+    }
+    if (from == end) {
+        return span;
+    }
+    if (!memchr(from, '&', (size_t)(end - from)) && !memchr(from, '<', (size_t)(end - from))) {
+        span.bytes = from;
+        span.length = (size_t)(end - from);
+        return span;
+    }
+
+    char *out = parser->scratch + parser->scratchLength;
+    char *start = out;
+    const char *p = from;
+    while (p < end) {
+        if (*p == '&') {
+            out += VLCXMLTVDecodeEntity(&p, end, out);
+        } else if (*p == '<' && (size_t)(end - p) >= 9 && memcmp(p, "<![CDATA[", 9) == 0) {
+            const char *cdataEnd = VLCXMLTVFind(p + 9, end, "]]>", 3);
+            const char *cdataStop = cdataEnd ? cdataEnd : end;
+            memcpy(out, p + 9, (size_t)(cdataStop - (p + 9)));
+            out += cdataStop - (p + 9);
+            p = cdataEnd ? cdataEnd + 3 : end;
+        } else {
+            *out++ = *p++;
+        }
+    }
+    parser->scratchLength += (size_t)(out - start);
+    span.bytes = start;
+    span.length = (size_t)(out - start);
+    return span;
+}
+
+// Values of the wanted attributes; attributes not listed are passed over
+static void VLCXMLTVReadAttributes(VLCXMLTVParser *parser, const char *p, const char *end,
+                                   const char *const *names, VLCXMLTVSpan *values, size_t count) {
+    while (p < end) {
+        while (p < end && (VLCXMLTVIsSpace(*p) || *p == '/')) {
+            p++;
+        }
+        const char *name = p;
+        while (p < end && VLCXMLTVIsNameByte(*p)) {
+            p++;
+        }
+        size_t nameLength = (size_t)(p - name);
+        while (p < end && VLCXMLTVIsSpace(*p)) {
+            p++;
+        }
+        if (nameLength == 0 || p >= end || *p != '=') {
+            if (nameLength == 0) {
+                p++;
+            }
+            continue;
+        }
+        p++;
+        while (p < end && VLCXMLTVIsSpace(*p)) {
+            p++;
+        }
+        if (p >= end || (*p != '"' && *p != '\'')) {
+            continue;
+        }
+        char quote = *p++;
+        const char *value = p;
+        const char *valueEnd = memchr(p, quote, (size_t)(end - p));
+        if (!valueEnd) {
+            valueEnd = end;
+        }
+        p = valueEnd + 1;
+        for (size_t i = 0; i < count; i++) {
+            if (values[i].length == 0 && VLCXMLTVNameIs(name, nameLength, names[i])) {
+                values[i] = VLCXMLTVText(parser, value, valueEnd);
+                break;
+            }
+        }
+    }
+}
+
+#pragma mark - Elements
+
+// Next child element in [*cursor, end); comments, text and stray close tags are passed over
+static int VLCXMLTVNextChild(const char **cursor, const char *end, VLCXMLTVChild *child) {
+    const char *p = *cursor;
+    while (p < end) {
+        const char *open = memchr(p, '<', (size_t)(end - p));
+        if (!open || open + 1 >= end) {
+            break;
+        }
+        if (open[1] == '!' || open[1] == '?' || open[1] == '/') {
+            const char *skipEnd = NULL;
+            if ((size_t)(end - open) >= 4 && memcmp(open, "<!--", 4) == 0) {
+                skipEnd = VLCXMLTVFind(open + 4, end, "-->", 3);
+                skipEnd = skipEnd ? skipEnd + 3 : NULL;
+            } else if ((size_t)(end - open) >= 9 && memcmp(open, "<![CDATA[", 9) == 0) {
+                skipEnd = VLCXMLTVFind(open + 9, end, "]]>", 3);
+                skipEnd = skipEnd ? skipEnd + 3 : NULL;
+            } else {
+                skipEnd = memchr(open, '>', (size_t)(end - open));
+                skipEnd = skipEnd ? skipEnd + 1 : NULL;
+            }
+            p = skipEnd ? skipEnd : end;
+            continue;
+        }
+
+        const char *name = open + 1;
+        const char *nameEnd = name;
+        while (nameEnd < end && VLCXMLTVIsNameByte(*nameEnd)) {
+            nameEnd++;
+        }
+        const char *tagEnd = VLCXMLTVFindTagEnd(nameEnd, end);
+        if (nameEnd == name || !tagEnd) {
+            break;
+        }
+        child->name = name;
+        child->nameLength = (size_t)(nameEnd - name);
+        child->attributes = nameEnd;
+        child->attributesEnd = tagEnd;
+        if (tagEnd[-1] == '/') {
+            child->attributesEnd = tagEnd - 1;
+            child->content = child->contentEnd = tagEnd + 1;
+            p = tagEnd + 1;
+        } else {
+            const char *closeEnd = NULL;
+            const char *close = VLCXMLTVFindClose(tagEnd + 1, end, name, child->nameLength, &closeEnd);
+            child->content = tagEnd + 1;
+            child->contentEnd = close ? close : end;
+            p = close ? closeEnd : end;
+        }
+        child->length = (size_t)(p - open);
+        *cursor = p;
+        return 1;
+    }
+    *cursor = end;
+    return 0;
+}
+
+static int VLCXMLTVPrepareScratch(VLCXMLTVParser *parser, size_t elementLength) {
+    parser->scratchLength = 0;
+    if (parser->scratchCapacity >= elementLength) {
+        return 1;
+    }
+    size_t capacity = parser->scratchCapacity ? parser->scratchCapacity : 4096;
+    while (capacity < elementLength) {
+        capacity *= 2;
+    }
+    char *scratch = realloc(parser->scratch, capacity);
+    if (!scratch) {
+        return 0;
+    }
+    parser->scratch = scratch;
+    parser->scratchCapacity = capacity;
+    return 1;
+}
+
+static void VLCXMLTVParseProgramme(VLCXMLTVParser *parser, const char *attributes, const char *attributesEnd,
+                                   const char *content, const char *contentEnd) {
+    static const char *const names[] = { "channel", "start", "stop" };
+    VLCXMLTVProgramme programme;
+    memset(&programme, 0, sizeof(programme));
+    VLCXMLTVSpan values[3] = { { NULL, 0 }, { NULL, 0 }, { NULL, 0 } };
+    VLCXMLTVReadAttributes(parser, attributes, attributesEnd, names, values, 3);
+    programme.channel = values[0];
+    programme.start = values[1];
+    programme.stop = values[2];
+
+    VLCXMLTVChild child;
+    const char *cursor = content;
+    while (VLCXMLTVNextChild(&cursor, contentEnd, &child)) {
+        if (programme.title.length == 0 && VLCXMLTVNameIs(child.name, child.nameLength, "title")) {
+            programme.title = VLCXMLTVText(parser, child.content, child.contentEnd);
+        } else if (programme.desc.length == 0 && VLCXMLTVNameIs(child.name, child.nameLength, "desc")) {
+            programme.desc = VLCXMLTVText(parser, child.content, child.contentEnd);
+        } else {
+            parser->stats.skippedElements++;
+            parser->stats.skippedBytes += child.length;
+        }
+    }
+
+    parser->stats.programmes++;
+    if (parser->handlers.programme && !parser->handlers.programme(&programme, parser->context)) {
+        parser->stopped = 1;
+    }
+}
+
+static void VLCXMLTVParseChannel(VLCXMLTVParser *parser, const char *attributes, const char *attributesEnd,
+                                 const char *content, const char *contentEnd) {
+    static const char *const idName[] = { "id" };
+    static const char *const srcName[] = { "src" };
+    VLCXMLTVChannel channel;
+    memset(&channel, 0, sizeof(channel));
+    VLCXMLTVReadAttributes(parser, attributes, attributesEnd, idName, &channel.id, 1);
+
+    VLCXMLTVChild child;
+    const char *cursor = content;
+    while (VLCXMLTVNextChild(&cursor, contentEnd, &child)) {
+        if (VLCXMLTVNameIs(child.name, child.nameLength, "display-name")) {
+            VLCXMLTVSpan name = VLCXMLTVText(parser, child.content, child.contentEnd);
+            if (name.length > 0 && channel.displayNameCount < VLC_XMLTV_MAX_DISPLAY_NAMES) {
+                channel.displayNames[channel.displayNameCount++] = name;
+            }
+        } else if (channel.icon.length == 0 && VLCXMLTVNameIs(child.name, child.nameLength, "icon")) {
+            VLCXMLTVReadAttributes(parser, child.attributes, child.attributesEnd, srcName, &channel.icon, 1);
+        } else {
+            parser->stats.skippedElements++;
+            parser->stats.skippedBytes += child.length;
+        }
+    }
+
+    parser->stats.channels++;
+    if (parser->handlers.channel && !parser->handlers.channel(&channel, parser->context)) {
+        parser->stopped = 1;
+    }
+}
+
+static size_t VLCXMLTVIncomplete(VLCXMLTVParser *parser, const char *bytes, const char *open,
+                                 const char *pendingEnd, size_t pendingEndLength) {
+    parser->pendingEnd = pendingEnd;
+    parser->pendingEndLength = pendingEndLength;
+    return (size_t)(open - bytes);
+}
+
+// Parses every complete top-level construct and returns how many bytes were consumed
+static size_t VLCXMLTVParseBuffer(VLCXMLTVParser *parser, const char *bytes, size_t length) {
+    const char *cursor = bytes;
+    const char *end = bytes + length;
+    parser->pendingEnd = NULL;
+    parser->pendingEndLength = 0;
+
+    while (cursor < end && !parser->stopped) {
+        const char *open = memchr(cursor, '<', (size_t)(end - cursor));
+        if (!open) {
+            return length;
+        }
+        size_t available = (size_t)(end - open);
+        if (available < 4) {
+            return VLCXMLTVIncomplete(parser, bytes, open, NULL, 0);
+        }
+
+        if (open[1] == '!' && memcmp(open, "<!--", 4) == 0) {
+            const char *commentEnd = VLCXMLTVFind(open + 4, end, "-->", 3);
+            if (!commentEnd) {
+                return VLCXMLTVIncomplete(parser, bytes, open, "-->", 3);
+            }
+            cursor = commentEnd + 3;
+            continue;
+        }
+        if (open[1] == '?') {
+            const char *declarationEnd = VLCXMLTVFind(open + 2, end, "?>", 2);
+            if (!declarationEnd) {
+                return VLCXMLTVIncomplete(parser, bytes, open, "?>", 2);
+            }
+            cursor = declarationEnd + 2;
+            continue;
+        }
+        if (open[1] == '!' || open[1] == '/') {
+            // <!DOCTYPE tv SYSTEM "xmltv.dtd">, </tv>
+            const char *tagEnd = VLCXMLTVFindTagEnd(open + 2, end);
+            if (!tagEnd) {
+                return VLCXMLTVIncomplete(parser, bytes, open, ">", 1);
+            }
+            cursor = tagEnd + 1;
+            continue;
+        }
+
+        const char *name = open + 1;
+        const char *nameEnd = name;
+        while (nameEnd < end && VLCXMLTVIsNameByte(*nameEnd)) {
+            nameEnd++;
+        }
+        if (nameEnd == end) {
+            return VLCXMLTVIncomplete(parser, bytes, open, NULL, 0);
+        }
+        const char *tagEnd = VLCXMLTVFindTagEnd(nameEnd, end);
+        if (!tagEnd) {
+            return VLCXMLTVIncomplete(parser, bytes, open, ">", 1);
+        }
+
+        size_t nameLength = (size_t)(nameEnd - name);
+        int isProgramme = VLCXMLTVNameIs(name, nameLength, "programme");
+        int isChannel = !isProgramme && VLCXMLTVNameIs(name, nameLength, "channel");
+        if (!isProgramme && !isChannel) {
+            // <tv ...> and anything unknown: only the open tag is consumed, children are
+            // reached by the same loop
+            cursor = tagEnd + 1;
+            continue;
+        }
+
+        const char *attributesEnd = tagEnd;
+        const char *content = tagEnd + 1;
+        const char *contentEnd = content;
+        const char *elementEnd = content;
+        if (tagEnd[-1] == '/') {
+            attributesEnd = tagEnd - 1;
+        } else {
+            contentEnd = VLCXMLTVFindClose(content, end, name, nameLength, &elementEnd);
+            if (!contentEnd) {
+                return isProgramme ? VLCXMLTVIncomplete(parser, bytes, open, "</programme", 11)
+                                   : VLCXMLTVIncomplete(parser, bytes, open, "</channel", 9);
+            }
+        }
+
+        if (!VLCXMLTVPrepareScratch(parser, (size_t)(elementEnd - open))) {
+            parser->stopped = 1;
+            return (size_t)(open - bytes);
+        }
+        if (isProgramme) {
+            VLCXMLTVParseProgramme(parser, nameEnd, attributesEnd, content, contentEnd);
+        } else {
+            VLCXMLTVParseChannel(parser, nameEnd, attributesEnd, content, contentEnd);
+        }
+        cursor = elementEnd;
+    }
+    return (size_t)(cursor - bytes);
+}
+
+#pragma mark - Feeding
+
+static int VLCXMLTVAppendCarry(VLCXMLTVParser *parser, const char *bytes, size_t length) {
+    if (length == 0) {
+        return 1;
+    }
+    if (parser->carryLength + length > VLC_XMLTV_MAX_ELEMENT) {
+        return 0;
+    }
+    if (parser->carryLength + length > parser->carryCapacity) {
+        size_t capacity = parser->carryCapacity ? parser->carryCapacity : 16384;
+        while (capacity < parser->carryLength + length) {
+            capacity *= 2;
+        }
+        char *carry = realloc(parser->carry, capacity);
+        if (!carry) {
+            return 0;
+        }
+        parser->carry = carry;
+        parser->carryCapacity = capacity;
+    }
+    memcpy(parser->carry + parser->carryLength, bytes, length);
+    parser->carryLength += length;
+    parser->stats.carriedBytes += length;
+    return 1;
+}
+
+// Bytes of the new chunk needed to complete the carried construct: through the '>' after
+// its pending terminator, which may itself straddle the chunk boundary. All of it if unknown.
+static size_t VLCXMLTVCompletingLength(const VLCXMLTVParser *parser, const char *bytes, size_t length) {
+    const char *needle = parser->pendingEnd;
+    size_t needleLength = parser->pendingEndLength;
+    if (!needle) {
+        return length;
+    }
+
+    const char *needleEnd = NULL;
+    size_t tailLength = parser->carryLength < needleLength - 1 ? parser->carryLength : needleLength - 1;
+    size_t headLength = length < needleLength - 1 ? length : needleLength - 1;
+    if (tailLength > 0 && headLength > 0) {
+        char joint[32];
+        memcpy(joint, parser->carry + parser->carryLength - tailLength, tailLength);
+        memcpy(joint + tailLength, bytes, headLength);
+        const char *match = VLCXMLTVFind(joint, joint + tailLength + headLength, needle, needleLength);
+        if (match && (size_t)(match - joint) + needleLength > tailLength) {
+            needleEnd = bytes + ((size_t)(match - joint) + needleLength - tailLength);
+        }
+    }
+    if (!needleEnd) {
+        const char *match = VLCXMLTVFind(bytes, bytes + length, needle, needleLength);
+        if (!match) {
+            return length;
+        }
+        needleEnd = match + needleLength;
+    }
+    if (needle[needleLength - 1] == '>') {
+        return (size_t)(needleEnd - bytes);
+    }
+    const char *tagEnd = memchr(needleEnd, '>', (size_t)(bytes + length - needleEnd));
+    return tagEnd ? (size_t)(tagEnd + 1 - bytes) : length;
+}
+
+int VLCXMLTVParserFeed(VLCXMLTVParser *parser, const char *bytes, size_t length) {
+    if (parser->stopped) {
+        return 0;
+    }
+    const char *cursor = bytes;
+    const char *end = bytes + length;
+
+    // Finish the carried element with just enough of the new chunk, then go back to
+    // parsing in place
+    while (parser->carryLength > 0 && cursor < end) {
+        size_t take = VLCXMLTVCompletingLength(parser, cursor, (size_t)(end - cursor));
+        if (!VLCXMLTVAppendCarry(parser, cursor, take)) {
+            parser->stopped = 1;
+            return 0;
+        }
+        cursor += take;
+        size_t consumed = VLCXMLTVParseBuffer(parser, parser->carry, parser->carryLength);
+        memmove(parser->carry, parser->carry + consumed, parser->carryLength - consumed);
+        parser->carryLength -= consumed;
+        if (parser->stopped) {
+            return 0;
+        }
+    }
+
+    if (cursor < end) {
+        size_t consumed = VLCXMLTVParseBuffer(parser, cursor, (size_t)(end - cursor));
+        if (parser->stopped) {
+            return 0;
+        }
+        if (!VLCXMLTVAppendCarry(parser, cursor + consumed, (size_t)(end - cursor) - consumed)) {
+            parser->stopped = 1;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int VLCXMLTVParserFinish(VLCXMLTVParser *parser) {
+    return parser->carryLength == 0;
+}
+
+#pragma mark - Timestamps
+
+// Eight ASCII digits at once in a 64-bit word (little-endian load, first digit lowest)
+static int VLCXMLTVIsEightDigits(uint64_t word) {
+    return (((word & 0xF0F0F0F0F0F0F0F0ull) |
+             (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+}
+
+static uint32_t VLCXMLTVEightDigitsValue(uint64_t word) {
+    word = ((word & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    word = ((word & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    return (uint32_t)(((word & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32);
+}
+
+static int VLCXMLTVDigits(const char *bytes, size_t count, unsigned *value) {
+    unsigned result = 0;
+    for (size_t i = 0; i < count; i++) {
+        unsigned digit = (unsigned)(unsigned char)bytes[i] - '0';
+        if (digit > 9) {
+            return 0;
+        }
+        result = result * 10 + digit;
+    }
+    *value = result;
+    return 1;
+}
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar
+static int64_t VLCXMLTVDaysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = (unsigned)(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + (int64_t)dayOfEra - 719468;
+}
+
+int VLCXMLTVParseTime(const char *bytes, size_t length, int64_t *epochSeconds) {
+    static const unsigned char daysInMonth[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (!bytes || length < 12) {
+        return 0;
+    }
+
+    unsigned date;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if (!VLCXMLTVDigits(bytes, 8, &date)) {
+        return 0;
+    }
+#else
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    if (!VLCXMLTVIsEightDigits(word)) {
+        return 0;
+    }
+    date = VLCXMLTVEightDigitsValue(word);
+#endif
+    unsigned year = date / 10000;
+    unsigned month = (date / 100) % 100;
+    unsigned day = date % 100;
+
+    unsigned hour, minute, second = 0;
+    size_t cursor;
+    if (!VLCXMLTVDigits(bytes + 8, 2, &hour) || !VLCXMLTVDigits(bytes + 10, 2, &minute)) {
+        return 0;
+    }
+    if (length >= 14 && VLCXMLTVDigits(bytes + 12, 2, &second)) {
+        cursor = 14;
+    } else if (length == 12 || bytes[12] == ' ' || bytes[12] == '+' || bytes[12] == '-') {
+        cursor = 12;
+    } else {
+        return 0;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth[month - 1] || hour > 23 || minute > 59 || second > 59) {
+        return 0;
+    }
+    int leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (month == 2 && day == 29 && !leap) {
+        return 0;
+    }
+
+    // The offset follows one separator byte, normally a space, or directly the digits
+    int64_t offset = 0;
+    size_t zone = (cursor < length && (bytes[cursor] == '+' || bytes[cursor] == '-')) ? cursor : cursor + 1;
+    unsigned offsetHours, offsetMinutes;
+    if (zone + 5 <= length && (bytes[zone] == '+' || bytes[zone] == '-') &&
+        VLCXMLTVDigits(bytes + zone + 1, 2, &offsetHours) && VLCXMLTVDigits(bytes + zone + 3, 2, &offsetMinutes)) {
+        offset = (int64_t)offsetHours * 3600 + (int64_t)offsetMinutes * 60;
+        if (bytes[zone] == '-') {
+            offset = -offset;
+        }
+    }
+    // Anything else there ("UTC", "GMT", junk) leaves the time as UTC, as before
+
+    *epochSeconds = VLCXMLTVDaysFromCivil(year, month, day) * 86400 +
+                    (int64_t)hour * 3600 + (int64_t)minute * 60 + second - offset;
+    return 1;
+}
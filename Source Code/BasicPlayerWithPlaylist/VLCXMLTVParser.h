@@ -0,0 +1,86 @@
+//
+//  VLCXMLTVParser.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable XMLTV Parser - Platform Independent (plain C)
+//  Incremental parser for XMLTV guides: fed download chunks as they arrive, reports each
+//  <channel> and <programme> with byte spans and skips every element the EPG does not use
+//
+
+#ifndef VLCXMLTVParser_h
+#define VLCXMLTVParser_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VLC_XMLTV_MAX_DISPLAY_NAMES 8
+
+// Text with entities and CDATA decoded and surrounding whitespace trimmed. Points into the
+// fed chunk or the parser's scratch memory; valid until the handler returns. Absent = length 0.
+typedef struct {
+    const char *bytes;
+    size_t length;
+} VLCXMLTVSpan;
+
+typedef struct {
+    VLCXMLTVSpan id;
+    VLCXMLTVSpan displayNames[VLC_XMLTV_MAX_DISPLAY_NAMES];
+    size_t displayNameCount;
+    VLCXMLTVSpan icon;              // <icon src="...">
+} VLCXMLTVChannel;
+
+typedef struct {
+    VLCXMLTVSpan channel;
+    VLCXMLTVSpan start;             // Raw XMLTV time, e.g. "20250101120000 +0100"
+    VLCXMLTVSpan stop;
+    VLCXMLTVSpan title;             // First <title>
+    VLCXMLTVSpan desc;              // First <desc>
+} VLCXMLTVProgramme;
+
+// Return 0 to stop parsing. Either handler may be NULL.
+typedef struct {
+    int (*channel)(const VLCXMLTVChannel *channel, void *context);
+    int (*programme)(const VLCXMLTVProgramme *programme, void *context);
+} VLCXMLTVHandlers;
+
+typedef struct {
+    uint64_t channels;
+    uint64_t programmes;
+    uint64_t skippedElements;       // Children nobody reads (<credits>, <category>, ...)
+    uint64_t skippedBytes;
+    uint64_t carriedBytes;          // Bytes copied to complete elements split across chunks
+} VLCXMLTVParserStats;
+
+typedef struct VLCXMLTVParser VLCXMLTVParser;
+
+VLCXMLTVParser *VLCXMLTVParserCreate(VLCXMLTVHandlers handlers, void *context);
+void VLCXMLTVParserFree(VLCXMLTVParser *parser);
+
+/**
+ * Parses the next chunk of the document. Complete elements are parsed in place; only an
+ * element cut off by the end of the chunk is kept until the next call.
+ * @return 0 when a handler stopped the parser or an element grew past 16 MB, 1 otherwise.
+ */
+int VLCXMLTVParserFeed(VLCXMLTVParser *parser, const char *bytes, size_t length);
+
+// Call after the last chunk. Returns 1 when no unfinished element was left over.
+int VLCXMLTVParserFinish(VLCXMLTVParser *parser);
+
+VLCXMLTVParserStats VLCXMLTVParserGetStats(const VLCXMLTVParser *parser);
+
+/**
+ * Decodes an XMLTV time, "YYYYMMDDHHMMSS +HHMM" (seconds, the space and the offset are
+ * optional), to UTC seconds since 1970. No allocation, no locale, safe on any thread.
+ * @return 1 on success, 0 when the text is not a valid calendar time.
+ */
+int VLCXMLTVParseTime(const char *bytes, size_t length, int64_t *epochSeconds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCXMLTVParser_h */
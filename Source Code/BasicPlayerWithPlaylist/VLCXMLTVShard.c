@@ -0,0 +1,305 @@
+//
+//  VLCXMLTVShard.c
+//  BasicPlayerWithPlaylist
+//
+//  Portable XMLTV Shard Parser - Platform Independent (plain C)
+//  Parses one piece of an XMLTV document, cut at a <programme> boundary, into buffers of its
+//  own so pieces can be parsed on separate threads and merged in document order afterwards
+//
+
+#include "VLCXMLTVShard.h"
+#include "VLCHashIndex.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Decoded text (entities, CDATA) is copied out of the parser's scratch into chunks this big
+#define VLC_XMLTV_SHARD_CHUNK (256u * 1024u)
+
+typedef struct VLCXMLTVShardChunk {
+    struct VLCXMLTVShardChunk *next;
+    size_t used;
+    size_t capacity;
+    char bytes[];
+} VLCXMLTVShardChunk;
+
+struct VLCXMLTVShard {
+    const char *bytes;              // The piece, owned by the caller
+    size_t length;
+    VLCXMLTVParserStats stats;
+    VLCXMLTVShardResult result;
+
+    VLCXMLTVSpan *channelIds;
+    size_t channelIdCount;
+    size_t channelIdCapacity;
+    VLCHashIndex *channelIndex;     // Hash of an id -> channel id index + 1
+    uint32_t lastChannel;           // Programmes come grouped by channel
+
+    VLCXMLTVShardChannel *channels;
+    size_t channelCount;
+    size_t channelCapacity;
+    VLCXMLTVShardProgramme *programmes;
+    size_t programmeCount;
+    size_t programmeCapacity;
+
+    VLCXMLTVShardChunk *chunks;     // Newest first
+    int outOfMemory;
+};
+
+#pragma mark - Boundaries
+
+size_t VLCXMLTVShardBoundary(const char *bytes, size_t length) {
+    static const char tag[] = "<programme";
+    const size_t tagLength = sizeof(tag) - 1;
+    size_t position = length;
+    while (position > 0) {
+        position--;
+        if (bytes[position] != '<' || length - position <= tagLength ||
+            memcmp(bytes + position, tag, tagLength) != 0) {
+            continue;
+        }
+        char after = bytes[position + tagLength];
+        if (after != ' ' && after != '\t' && after != '\r' && after != '\n' && after != '>') {
+            continue;
+        }
+        // Only whitespace back to the '>' of the previous tag: not inside text, a comment or CDATA
+        size_t before = position;
+        while (before > 0 && (bytes[before - 1] == ' ' || bytes[before - 1] == '\t' ||
+                              bytes[before - 1] == '\r' || bytes[before - 1] == '\n')) {
+            before--;
+        }
+        if (before > 0 && bytes[before - 1] == '>') {
+            return position;
+        }
+    }
+    return 0;
+}
+
+#pragma mark - Buffers
+
+static int VLCXMLTVShardGrow(void **array, size_t elementSize, size_t *capacity, size_t needed) {
+    if (needed <= *capacity) {
+        return 1;
+    }
+    size_t newCapacity = *capacity ? *capacity * 2 : 1024;
+    while (newCapacity < needed) newCapacity *= 2;
+    void *grown = realloc(*array, newCapacity * elementSize);
+    if (!grown) {
+        return 0;
+    }
+    *array = grown;
+    *capacity = newCapacity;
+    return 1;
+}
+
+// Spans into the piece stay where they are; decoded text is copied out of the parser's scratch,
+// which the next element overwrites
+static int VLCXMLTVShardKeep(VLCXMLTVShard *shard, VLCXMLTVSpan *span) {
+    if (span->length == 0 ||
+        (span->bytes >= shard->bytes && span->bytes + span->length <= shard->bytes + shard->length)) {
+        return 1;
+    }
+    VLCXMLTVShardChunk *chunk = shard->chunks;
+    if (!chunk || chunk->capacity - chunk->used < span->length) {
+        size_t capacity = span->length > VLC_XMLTV_SHARD_CHUNK ? span->length : VLC_XMLTV_SHARD_CHUNK;
+        chunk = malloc(sizeof(VLCXMLTVShardChunk) + capacity);
+        if (!chunk) {
+            return 0;
+        }
+        chunk->next = shard->chunks;
+        chunk->used = 0;
+        chunk->capacity = capacity;
+        shard->chunks = chunk;
+    }
+    char *copy = chunk->bytes + chunk->used;
+    memcpy(copy, span->bytes, span->length);
+    chunk->used += span->length;
+    span->bytes = copy;
+    return 1;
+}
+
+// Index of the channel id, added on first mention; UINT32_MAX when out of memory
+static uint32_t VLCXMLTVShardChannelFor(VLCXMLTVShard *shard, VLCXMLTVSpan id) {
+    if (shard->lastChannel != UINT32_MAX) {
+        VLCXMLTVSpan last = shard->channelIds[shard->lastChannel];
+        if (last.length == id.length && memcmp(last.bytes, id.bytes, id.length) == 0) {
+            return shard->lastChannel;
+        }
+    }
+    uint32_t *slot = VLCHashIndexSlot(shard->channelIndex, VLCHashBytes(id.bytes, id.length, VLC_HASH_SEED));
+    if (!slot) {
+        return UINT32_MAX;
+    }
+    if (*slot != 0) {
+        VLCXMLTVSpan known = shard->channelIds[*slot - 1];
+        if (known.length == id.length && memcmp(known.bytes, id.bytes, id.length) == 0) {
+            shard->lastChannel = *slot - 1;
+            return shard->lastChannel;
+        }
+        // Two ids with the same 64-bit hash; look the rare loser up the slow way
+        for (size_t i = 0; i < shard->channelIdCount; i++) {
+            known = shard->channelIds[i];
+            if (known.length == id.length && memcmp(known.bytes, id.bytes, id.length) == 0) {
+                shard->lastChannel = (uint32_t)i;
+                return shard->lastChannel;
+            }
+        }
+        slot = NULL;
+    }
+    if (shard->channelIdCount >= UINT32_MAX - 1 ||
+        !VLCXMLTVShardGrow((void **)&shard->channelIds, sizeof(VLCXMLTVSpan), &shard->channelIdCapacity,
+                           shard->channelIdCount + 1) ||
+        !VLCXMLTVShardKeep(shard, &id)) {
+        return UINT32_MAX;
+    }
+    uint32_t channel = (uint32_t)shard->channelIdCount++;
+    shard->channelIds[channel] = id;
+    if (slot) {
+        *slot = channel + 1;
+    }
+    shard->lastChannel = channel;
+    return channel;
+}
+
+#pragma mark - Parser Handlers
+
+static int VLCXMLTVShardHandleChannel(const VLCXMLTVChannel *channel, void *context) {
+    VLCXMLTVShard *shard = context;
+    if (channel->id.length == 0) {
+        return 1;
+    }
+    VLCXMLTVShardChannel declaration;
+    memset(&declaration, 0, sizeof(declaration));
+    declaration.channel = VLCXMLTVShardChannelFor(shard, channel->id);
+    if (declaration.channel == UINT32_MAX ||
+        !VLCXMLTVShardGrow((void **)&shard->channels, sizeof(VLCXMLTVShardChannel), &shard->channelCapacity,
+                           shard->channelCount + 1)) {
+        shard->outOfMemory = 1;
+        return 0;
+    }
+    for (size_t i = 0; i < channel->displayNameCount; i++) {
+        declaration.displayNames[i] = channel->displayNames[i];
+        if (!VLCXMLTVShardKeep(shard, &declaration.displayNames[i])) {
+            shard->outOfMemory = 1;
+            return 0;
+        }
+    }
+    declaration.displayNameCount = channel->displayNameCount;
+    shard->channels[shard->channelCount++] = declaration;
+    return 1;
+}
+
+static int VLCXMLTVShardHandleProgramme(const VLCXMLTVProgramme *programme, void *context) {
+    VLCXMLTVShard *shard = context;
+    if (programme->channel.length == 0 || programme->title.length == 0) {
+        return 1;
+    }
+    VLCXMLTVShardProgramme row = {
+        .channel = VLCXMLTVShardChannelFor(shard, programme->channel),
+        .start = VLC_XMLTV_SHARD_NO_TIME,
+        .stop = VLC_XMLTV_SHARD_NO_TIME,
+        .title = programme->title,
+        .desc = programme->desc
+    };
+    int64_t timestamp;
+    if (programme->start.length > 0 && VLCXMLTVParseTime(programme->start.bytes, programme->start.length, &timestamp)) {
+        row.start = timestamp;
+    }
+    if (programme->stop.length > 0 && VLCXMLTVParseTime(programme->stop.bytes, programme->stop.length, &timestamp)) {
+        row.stop = timestamp;
+    }
+    if (row.channel == UINT32_MAX ||
+        !VLCXMLTVShardKeep(shard, &row.title) || !VLCXMLTVShardKeep(shard, &row.desc) ||
+        !VLCXMLTVShardGrow((void **)&shard->programmes, sizeof(VLCXMLTVShardProgramme), &shard->programmeCapacity,
+                           shard->programmeCount + 1)) {
+        shard->outOfMemory = 1;
+        return 0;
+    }
+    shard->programmes[shard->programmeCount++] = row;
+    return 1;
+}
+
+#pragma mark - Parsing
+
+VLCXMLTVShard *VLCXMLTVShardParse(const char *bytes, size_t length) {
+    VLCXMLTVShard *shard = calloc(1, sizeof(VLCXMLTVShard));
+    if (!shard) {
+        return NULL;
+    }
+    shard->bytes = bytes;
+    shard->length = length;
+    shard->lastChannel = UINT32_MAX;
+    shard->channelIndex = VLCHashIndexCreate(256);
+
+    VLCXMLTVHandlers handlers = { VLCXMLTVShardHandleChannel, VLCXMLTVShardHandleProgramme };
+    VLCXMLTVParser *parser = shard->channelIndex ? VLCXMLTVParserCreate(handlers, shard) : NULL;
+    if (!parser) {
+        VLCXMLTVShardFree(shard);
+        return NULL;
+    }
+    int fed = VLCXMLTVParserFeed(parser, bytes, length);
+    if (shard->outOfMemory) {
+        VLCXMLTVParserFree(parser);
+        VLCXMLTVShardFree(shard);
+        return NULL;
+    }
+    if (!fed) {
+        shard->result = VLCXMLTVShardFailed;
+    } else if (!VLCXMLTVParserFinish(parser)) {
+        shard->result = VLCXMLTVShardCutShort;
+    } else {
+        shard->result = VLCXMLTVShardParsed;
+    }
+    shard->stats = VLCXMLTVParserGetStats(parser);
+    VLCXMLTVParserFree(parser);
+
+    // Lookups are over; only the results stay
+    VLCHashIndexFree(shard->channelIndex);
+    shard->channelIndex = NULL;
+    return shard;
+}
+
+void VLCXMLTVShardFree(VLCXMLTVShard *shard) {
+    if (!shard) {
+        return;
+    }
+    VLCXMLTVShardChunk *chunk = shard->chunks;
+    while (chunk) {
+        VLCXMLTVShardChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    VLCHashIndexFree(shard->channelIndex);
+    free(shard->channelIds);
+    free(shard->channels);
+    free(shard->programmes);
+    free(shard);
+}
+
+#pragma mark - Results
+
+VLCXMLTVShardResult VLCXMLTVShardGetResult(const VLCXMLTVShard *shard) {
+    return shard->result;
+}
+
+VLCXMLTVParserStats VLCXMLTVShardGetStats(const VLCXMLTVShard *shard) {
+    return shard->stats;
+}
+
+size_t VLCXMLTVShardChannelIdCount(const VLCXMLTVShard *shard) {
+    return shard->channelIdCount;
+}
+
+VLCXMLTVSpan VLCXMLTVShardChannelId(const VLCXMLTVShard *shard, size_t index) {
+    return shard->channelIds[index];
+}
+
+const VLCXMLTVShardChannel *VLCXMLTVShardChannels(const VLCXMLTVShard *shard, size_t *count) {
+    *count = shard->channelCount;
+    return shard->channels;
+}
+
+const VLCXMLTVShardProgramme *VLCXMLTVShardProgrammes(const VLCXMLTVShard *shard, size_t *count) {
+    *count = shard->programmeCount;
+    return shard->programmes;
+}
@@ -0,0 +1,78 @@
+//
+//  VLCXMLTVShard.h
+//  BasicPlayerWithPlaylist
+//
+//  Portable XMLTV Shard Parser - Platform Independent (plain C)
+//  Parses one piece of an XMLTV document, cut at a <programme> boundary, into buffers of its
+//  own so pieces can be parsed on separate threads and merged in document order afterwards
+//
+
+#ifndef VLCXMLTVShard_h
+#define VLCXMLTVShard_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "VLCXMLTVParser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Start or stop that is missing or not a valid XMLTV time
+#define VLC_XMLTV_SHARD_NO_TIME INT64_MIN
+
+typedef enum {
+    VLCXMLTVShardParsed = 0,
+    VLCXMLTVShardCutShort,          // The piece ended inside an element
+    VLCXMLTVShardFailed             // An element over the parser's size limit
+} VLCXMLTVShardResult;
+
+// A <programme> with a channel and a title, its times already decoded
+typedef struct {
+    uint32_t channel;               // Index into the shard's channel ids
+    int64_t start;                  // UTC seconds, VLC_XMLTV_SHARD_NO_TIME when unknown
+    int64_t stop;
+    VLCXMLTVSpan title;
+    VLCXMLTVSpan desc;
+} VLCXMLTVShardProgramme;
+
+// A <channel> declaration with an id
+typedef struct {
+    uint32_t channel;               // Index into the shard's channel ids
+    VLCXMLTVSpan displayNames[VLC_XMLTV_MAX_DISPLAY_NAMES];
+    size_t displayNameCount;
+} VLCXMLTVShardChannel;
+
+typedef struct VLCXMLTVShard VLCXMLTVShard;
+
+/**
+ * Where to cut a piece of an XMLTV document: the offset of its last <programme> open tag that
+ * directly follows a closing tag, so everything before it is made of whole elements.
+ * @return 0 when there is no such tag.
+ */
+size_t VLCXMLTVShardBoundary(const char *bytes, size_t length);
+
+/**
+ * Parses [bytes, bytes + length). Spans in the results point into bytes or into memory owned
+ * by the shard; keep both until the shard is freed. Safe to call on several threads at once.
+ * @return NULL on allocation failure.
+ */
+VLCXMLTVShard *VLCXMLTVShardParse(const char *bytes, size_t length);
+void VLCXMLTVShardFree(VLCXMLTVShard *shard);
+
+VLCXMLTVShardResult VLCXMLTVShardGetResult(const VLCXMLTVShard *shard);
+VLCXMLTVParserStats VLCXMLTVShardGetStats(const VLCXMLTVShard *shard);
+
+// Channel ids in the order the piece first mentions them
+size_t VLCXMLTVShardChannelIdCount(const VLCXMLTVShard *shard);
+VLCXMLTVSpan VLCXMLTVShardChannelId(const VLCXMLTVShard *shard, size_t index);
+
+// In document order
+const VLCXMLTVShardChannel *VLCXMLTVShardChannels(const VLCXMLTVShard *shard, size_t *count);
+const VLCXMLTVShardProgramme *VLCXMLTVShardProgrammes(const VLCXMLTVShard *shard, size_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VLCXMLTVShard_h */
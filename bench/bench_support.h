@@ -0,0 +1,80 @@
+//
+//  bench_support.h
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Timing, peak memory and file helpers shared by the Linux harnesses for the plain C parsers
+//
+
+#ifndef bench_support_h
+#define bench_support_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+static inline double BenchNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// Peak resident set of the whole process so far; run one mode per process to compare modes
+static inline double BenchPeakRSSMegabytes(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    return (double)usage.ru_maxrss / 1024.0;    // Kilobytes on Linux
+}
+
+// Whole file in a malloc'd buffer (NUL terminated past length); NULL when it cannot be read
+static inline char *BenchReadFile(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    char *bytes = NULL;
+    size_t used = 0;
+    size_t capacity = 0;
+    for (;;) {
+        if (used + 65536 + 1 > capacity) {
+            capacity = capacity ? capacity * 2 : 1 << 20;
+            char *grown = realloc(bytes, capacity);
+            if (!grown) {
+                free(bytes);
+                fclose(file);
+                return NULL;
+            }
+            bytes = grown;
+        }
+        size_t got = fread(bytes + used, 1, 65536, file);
+        used += got;
+        if (got < 65536) {
+            break;
+        }
+    }
+    fclose(file);
+    bytes[used] = '\0';
+    *length = used;
+    return bytes;
+}
+
+// Deterministic, so every run and every mode sees the same synthetic data
+static inline uint32_t BenchRandom(uint64_t *state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (uint32_t)(*state >> 33);
+}
+
+#define BenchCheck(condition, ...) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fputc('\n', stderr); \
+        exit(1); \
+    } \
+} while (0)
+
+#endif /* bench_support_h */
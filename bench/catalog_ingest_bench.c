@@ -0,0 +1,247 @@
+//
+//  catalog_ingest_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  The same live catalog read both ways the app can ingest it: the recorded get_live_streams
+//  response repeated up to N records and read with VLCJSONRecordReader, and the m3u_plus
+//  playlist get.php would send for those records tokenized with VLCM3UTokenizer. Both arrive
+//  in 64 KB chunks and keep what their channel handler keeps: name, logo, group, EPG id,
+//  catch-up days, the stream URL and the delta refresh fingerprint.
+//
+//  catalog_ingest_bench fixtures/get_live_streams.json [--records N]      (default 500000)
+//
+
+#include "bench_support.h"
+#include "VLCHashIndex.h"
+#include "VLCJSONRecordReader.h"
+#include "VLCM3UTokenizer.h"
+
+#define BENCH_CHUNK 65536
+#define BENCH_URL_PREFIX "http://provider.example.com:8080/live/user/pass/"
+
+typedef struct {
+    size_t channels;
+    size_t catchupChannels;
+    size_t keptBytes;               // Bytes of the fields a store row would take
+    uint64_t fingerprints;          // Sum, so the work cannot be skipped
+} BenchTotals;
+
+typedef struct {
+    char *bytes;
+    size_t length;
+    size_t capacity;
+} BenchBuffer;
+
+static void BenchAppend(BenchBuffer *buffer, const char *bytes, size_t length) {
+    if (buffer->length + length + 1 > buffer->capacity) {
+        buffer->capacity = (buffer->length + length + 1) * 2;
+        buffer->bytes = realloc(buffer->bytes, buffer->capacity);
+    }
+    memcpy(buffer->bytes + buffer->length, bytes, length);
+    buffer->length += length;
+    buffer->bytes[buffer->length] = '\0';
+}
+
+static size_t BenchFieldLength(const VLCJSONField *field) {
+    return field && field->type == VLCJSONValueString ? field->value.length : 0;
+}
+
+#pragma mark - JSON
+
+// VLCXtreamCatalogCall's record handler without the store
+static int BenchHandleRecord(const VLCJSONField *fields, size_t count, void *context) {
+    BenchTotals *totals = context;
+    long long streamId = VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "stream_id"), -1);
+    if (streamId < 0) {
+        return 1;
+    }
+    char url[2048];
+    int urlLength = snprintf(url, sizeof(url), BENCH_URL_PREFIX "%lld.ts", streamId);
+    totals->channels++;
+    totals->keptBytes += (size_t)urlLength + BenchFieldLength(VLCJSONFindField(fields, count, "name")) +
+                         BenchFieldLength(VLCJSONFindField(fields, count, "stream_icon")) +
+                         BenchFieldLength(VLCJSONFindField(fields, count, "category_id")) +
+                         BenchFieldLength(VLCJSONFindField(fields, count, "epg_channel_id"));
+    long long archiveDays = VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "tv_archive_duration"), 0);
+    if (VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "tv_archive"), 0) > 0 && archiveDays > 0) {
+        totals->catchupChannels++;
+    }
+    uint64_t fingerprint = VLC_HASH_SEED;
+    for (size_t i = 0; i < count; i++) {
+        fingerprint = VLCHashBytes(fields[i].key.bytes, fields[i].key.length, fingerprint);
+        fingerprint = VLCHashBytes(fields[i].value.bytes, fields[i].value.length, fingerprint);
+    }
+    totals->fingerprints += fingerprint + VLCHashBytes(url, (size_t)urlLength, VLC_HASH_SEED);
+    return 1;
+}
+
+static void BenchReadCatalog(const char *bytes, size_t length, BenchTotals *totals) {
+    VLCJSONRecordReader *reader = VLCJSONRecordReaderCreate(BenchHandleRecord, totals);
+    BenchCheck(reader, "out of memory");
+    for (size_t offset = 0; offset < length; offset += BENCH_CHUNK) {
+        size_t step = length - offset < BENCH_CHUNK ? length - offset : BENCH_CHUNK;
+        BenchCheck(VLCJSONRecordReaderFeed(reader, bytes + offset, step), "syntax error at byte %zu", offset);
+    }
+    BenchCheck(VLCJSONRecordReaderFinish(reader), "the catalog did not read as complete");
+    VLCJSONRecordReaderFree(reader);
+}
+
+#pragma mark - M3U
+
+// VLCChannelManagerHandleM3UEntry without the store
+static int BenchHandleEntry(const VLCM3UEntry *entry, void *context) {
+    BenchTotals *totals = context;
+    totals->channels++;
+    totals->keptBytes += entry->url.length + entry->name.length + entry->tvgLogo.length + entry->groupTitle.length +
+                         entry->tvgId.length;
+    if (entry->catchup.length > 0 && VLCM3USpanToLong(entry->catchupDays) > 0) {
+        totals->catchupChannels++;
+    }
+    totals->fingerprints += VLCM3UEntryFingerprint(entry) + VLCM3UEntryIdentity(entry);
+    return 1;
+}
+
+static void BenchTokenizePlaylist(const char *bytes, size_t length, BenchTotals *totals) {
+    char *carry = malloc(BENCH_CHUNK * 4);
+    size_t carryCapacity = BENCH_CHUNK * 4;
+    size_t carryLength = 0;
+    for (size_t offset = 0; offset < length; offset += BENCH_CHUNK) {
+        size_t step = length - offset < BENCH_CHUNK ? length - offset : BENCH_CHUNK;
+        if (carryLength + step > carryCapacity) {
+            carryCapacity = (carryLength + step) * 2;
+            carry = realloc(carry, carryCapacity);
+        }
+        memcpy(carry + carryLength, bytes + offset, step);
+        carryLength += step;
+        size_t consumed = VLCM3UTokenizePartialBuffer(carry, carryLength, BenchHandleEntry, totals, NULL);
+        memmove(carry, carry + consumed, carryLength - consumed);
+        carryLength -= consumed;
+    }
+    VLCM3UTokenizeBuffer(carry, carryLength, 0, 0, BenchHandleEntry, totals, NULL);
+    free(carry);
+}
+
+#pragma mark - Equivalent Playlist
+
+// An attribute value or name as get.php writes it: on one line, without double quotes
+static void BenchAppendText(BenchBuffer *buffer, const VLCJSONField *field) {
+    if (!field || field->type != VLCJSONValueString) {
+        return;
+    }
+    for (size_t i = 0; i < field->value.length; i++) {
+        char c = field->value.bytes[i];
+        if (c == '"') {
+            c = '\'';
+        } else if (c == '\n' || c == '\r' || c == '\t') {
+            c = ' ';
+        }
+        BenchAppend(buffer, &c, 1);
+    }
+}
+
+static int BenchWriteEntry(const VLCJSONField *fields, size_t count, void *context) {
+    BenchBuffer *playlist = context;
+    long long streamId = VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "stream_id"), -1);
+    if (streamId < 0) {
+        return 1;
+    }
+    BenchAppend(playlist, "#EXTINF:-1 tvg-id=\"", 19);
+    BenchAppendText(playlist, VLCJSONFindField(fields, count, "epg_channel_id"));
+    BenchAppend(playlist, "\" tvg-name=\"", 12);
+    BenchAppendText(playlist, VLCJSONFindField(fields, count, "name"));
+    BenchAppend(playlist, "\" tvg-logo=\"", 12);
+    BenchAppendText(playlist, VLCJSONFindField(fields, count, "stream_icon"));
+    BenchAppend(playlist, "\" group-title=\"", 15);
+    BenchAppendText(playlist, VLCJSONFindField(fields, count, "category_id"));
+    BenchAppend(playlist, "\"", 1);
+    char text[256];
+    long long archiveDays = VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "tv_archive_duration"), 0);
+    if (VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "tv_archive"), 0) > 0 && archiveDays > 0) {
+        BenchAppend(playlist, text, (size_t)snprintf(text, sizeof(text), " catchup=\"default\" catchup-days=\"%lld\"", archiveDays));
+    }
+    BenchAppend(playlist, ",", 1);
+    BenchAppendText(playlist, VLCJSONFindField(fields, count, "name"));
+    BenchAppend(playlist, text, (size_t)snprintf(text, sizeof(text), "\n" BENCH_URL_PREFIX "%lld.ts\n", streamId));
+    return 1;
+}
+
+// The fixture's records repeated until there are at least records of them
+static void BenchScaleCatalog(const char *fixture, size_t fixtureLength, size_t records, BenchBuffer *catalog, size_t *copies) {
+    const char *open = memchr(fixture, '[', fixtureLength);
+    const char *close = fixture + fixtureLength;
+    while (close > fixture && close[-1] != ']') close--;
+    BenchCheck(open && close > open + 1, "the fixture is not an array");
+    BenchTotals counted = { 0 };
+    VLCJSONRecordReader *reader = VLCJSONRecordReaderCreate(BenchHandleRecord, &counted);
+    BenchCheck(reader && VLCJSONRecordReaderFeed(reader, fixture, fixtureLength) && VLCJSONRecordReaderFinish(reader),
+               "the fixture does not read");
+    size_t fixtureRecords = VLCJSONRecordReaderRecordCount(reader);
+    VLCJSONRecordReaderFree(reader);
+
+    *copies = (records + fixtureRecords - 1) / fixtureRecords;
+    const char *body = open + 1;
+    size_t bodyLength = (size_t)(close - 1 - body);
+    BenchAppend(catalog, "[", 1);
+    for (size_t i = 0; i < *copies; i++) {
+        if (i > 0) {
+            BenchAppend(catalog, ",", 1);
+        }
+        BenchAppend(catalog, body, bodyLength);
+    }
+    BenchAppend(catalog, "]", 1);
+}
+
+#pragma mark - Main
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    size_t records = 500000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--records") == 0 && i + 1 < argc) {
+            records = strtoul(argv[++i], NULL, 10);
+        } else {
+            path = argv[i];
+        }
+    }
+    BenchCheck(path && records > 0, "usage: catalog_ingest_bench get_live_streams.json [--records N]");
+    size_t fixtureLength = 0;
+    char *fixture = BenchReadFile(path, &fixtureLength);
+    BenchCheck(fixture && fixtureLength > 0, "cannot read %s", path);
+
+    BenchBuffer catalog = { 0 };
+    size_t copies = 0;
+    BenchScaleCatalog(fixture, fixtureLength, records, &catalog, &copies);
+    BenchBuffer playlist = { 0 };
+    BenchAppend(&playlist, "#EXTM3U\n", 8);
+    VLCJSONRecordReader *writer = VLCJSONRecordReaderCreate(BenchWriteEntry, &playlist);
+    BenchCheck(writer && VLCJSONRecordReaderFeed(writer, catalog.bytes, catalog.length) && VLCJSONRecordReaderFinish(writer),
+               "the scaled catalog does not read");
+    VLCJSONRecordReaderFree(writer);
+
+    BenchTotals json = { 0 };
+    double start = BenchNow();
+    BenchReadCatalog(catalog.bytes, catalog.length, &json);
+    double jsonSeconds = BenchNow() - start;
+
+    BenchTotals m3u = { 0 };
+    start = BenchNow();
+    BenchTokenizePlaylist(playlist.bytes, playlist.length, &m3u);
+    double m3uSeconds = BenchNow() - start;
+
+    double jsonMegabytes = (double)catalog.length / (1024.0 * 1024.0);
+    double m3uMegabytes = (double)playlist.length / (1024.0 * 1024.0);
+    printf("json      %zu channels (%zu copies of the fixture), %.1f MB in %.3f s: %.1f MB/s, %.0f channels/s\n",
+           json.channels, copies, jsonMegabytes, jsonSeconds, jsonSeconds > 0 ? jsonMegabytes / jsonSeconds : 0.0,
+           jsonSeconds > 0 ? (double)json.channels / jsonSeconds : 0.0);
+    printf("m3u       %zu channels, %.1f MB in %.3f s: %.1f MB/s, %.0f channels/s (%.2fx the json time)\n",
+           m3u.channels, m3uMegabytes, m3uSeconds, m3uSeconds > 0 ? m3uMegabytes / m3uSeconds : 0.0,
+           m3uSeconds > 0 ? (double)m3u.channels / m3uSeconds : 0.0, jsonSeconds > 0 ? m3uSeconds / jsonSeconds : 0.0);
+
+    BenchCheck(json.channels == m3u.channels, "%zu channels from the catalog, %zu from the playlist", json.channels, m3u.channels);
+    BenchCheck(json.catchupChannels == m3u.catchupChannels, "%zu catch-up channels from the catalog, %zu from the playlist",
+               json.catchupChannels, m3u.catchupChannels);
+    free(catalog.bytes);
+    free(playlist.bytes);
+    free(fixture);
+    return 0;
+}
@@ -0,0 +1,194 @@
+//
+//  channel_classifier_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Nanoseconds per channel for VLCChannelClassifier against the categorization it replaced,
+//  over a generated list of live channels, VOD files and episodes.
+//
+//  classifier  one VLCChannelClassifier built up front, each channel classified from its bytes
+//  baseline    the old determineCategoryForChannel: redone in C: per channel the episode regex
+//              compiled again, lowercase copies of name, group and URL made, the title matched
+//              and the URL compared against every movie extension with a suffix test
+//
+//  Both must agree on every channel except "S02E03"-style episodes, which the old regex did
+//  not recognize and the classifier does.
+//
+//  channel_classifier_bench [--entries N]      (default 1000000)
+//
+
+#include "bench_support.h"
+#include "VLCChannelClassifier.h"
+
+#include <ctype.h>
+#include <regex.h>
+#include <stdarg.h>
+
+typedef struct {
+    char *name;
+    char *group;
+    char *url;
+    int combinedMarker;         // Named "... S02E03 ...", which only the classifier sees as an episode
+} BenchEntry;
+
+// The strings VLCChannelCategoryName gives the app
+static const char *const BenchCategoryNames[] = { "TV", "MOVIES", "SERIES" };
+
+#pragma mark - Synthetic List
+
+static char *BenchFormat(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+static char *BenchFormat(const char *format, ...) {
+    char buffer[256];
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(buffer, sizeof(buffer), format, arguments);
+    va_end(arguments);
+    return strdup(buffer);
+}
+
+static BenchEntry *BenchMakeEntries(size_t count) {
+    static const char *extensions[] = { "mp4", "MKV", "avi", "ts", "m2ts", "mpeg" };
+    BenchEntry *entries = calloc(count, sizeof(BenchEntry));
+    uint64_t seed = 42;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t random = BenchRandom(&seed);
+        BenchEntry *entry = &entries[i];
+        switch (random % 8) {
+            case 0:
+                entry->name = BenchFormat("Show %zu S%02u E%02u", i, random % 12, random % 24);
+                entry->group = BenchFormat("Series | Drama");
+                entry->url = BenchFormat("http://provider.example.com:8080/series/user/pass/%zu.mkv", i);
+                break;
+            case 1:
+                entry->name = BenchFormat("Show.%zu.E%02u.1080p", i, random % 24);
+                entry->group = BenchFormat("Series | Comedy");
+                entry->url = BenchFormat("http://provider.example.com:8080/series/user/pass/%zu.mp4", i);
+                break;
+            case 2:
+                entry->name = BenchFormat("Show %zu -S%02uE%02u HD", i, random % 12, random % 24);
+                entry->group = BenchFormat("Series | Crime");
+                entry->url = BenchFormat("http://provider.example.com:8080/series/user/pass/%zu.mkv", i);
+                entry->combinedMarker = 1;
+                break;
+            case 3:
+            case 4:
+                entry->name = BenchFormat("Movie %zu (20%02u)", i, random % 25);
+                entry->group = BenchFormat("VOD | Action");
+                entry->url = BenchFormat("http://provider.example.com:8080/movie/user/pass/%zu.%s", i, extensions[random % 6]);
+                break;
+            default:
+                // Live channels, some of them Xtream .ts streams, which both rule sets file under MOVIES
+                entry->name = BenchFormat("UK: Channel %zu HD", i);
+                entry->group = BenchFormat("UK | Entertainment");
+                entry->url = BenchFormat(random % 3 == 0 ? "http://provider.example.com:8080/live/user/pass/%zu.ts"
+                                                         : "http://provider.example.com:8080/user/pass/%zu", i);
+                break;
+        }
+    }
+    return entries;
+}
+
+#pragma mark - Baseline
+
+static char *BenchLowercase(const char *string) {
+    char *lowered = strdup(string);
+    for (char *c = lowered; *c; c++) {
+        *c = (char)tolower((unsigned char)*c);
+    }
+    return lowered;
+}
+
+static int BenchHasSuffix(const char *string, size_t length, const char *suffix) {
+    size_t suffixLength = strlen(suffix);
+    return length >= suffixLength && memcmp(string + length - suffixLength, suffix, suffixLength) == 0;
+}
+
+static VLCChannelCategory BenchBaselineCategory(const BenchEntry *entry) {
+    static const char *movieExtensions[] = {
+        ".mp4", ".mkv", ".avi", ".mov", ".m4v", ".wmv", ".flv", ".webm", ".ogv", ".3gp", ".m2ts",
+        ".ts", ".vob", ".divx", ".xvid", ".rmvb", ".asf", ".mpg", ".mpeg", ".m2v", ".mts"
+    };
+    char *lowerGroup = BenchLowercase(entry->group);
+    char *lowerURL = BenchLowercase(entry->url);
+    char *lowerTitle = BenchLowercase(entry->name);
+
+    // [NSRegularExpression regularExpressionWithPattern:...] for every channel
+    regex_t regex;
+    BenchCheck(regcomp(&regex, "[[:space:].-](s[0-9]+|e[0-9]+)[[:space:].-]", REG_EXTENDED | REG_ICASE | REG_NOSUB) == 0,
+               "cannot compile the episode pattern");
+    VLCChannelCategory category = VLCChannelCategoryTV;
+    if (regexec(&regex, lowerTitle, 0, NULL, 0) == 0) {
+        category = VLCChannelCategorySeries;
+    } else if (strchr(lowerURL, '.')) {
+        size_t length = strlen(lowerURL);
+        for (size_t i = 0; i < sizeof(movieExtensions) / sizeof(movieExtensions[0]); i++) {
+            if (BenchHasSuffix(lowerURL, length, movieExtensions[i])) {
+                category = VLCChannelCategoryMovies;
+                break;
+            }
+        }
+    }
+    regfree(&regex);
+    free(lowerGroup);
+    free(lowerURL);
+    free(lowerTitle);
+    return category;
+}
+
+#pragma mark - Main
+
+int main(int argc, char **argv) {
+    size_t count = 1000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--entries") == 0) {
+            count = strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    BenchCheck(count > 0, "--entries must be positive");
+    BenchEntry *entries = BenchMakeEntries(count);
+    VLCChannelCategory *classified = malloc(count * sizeof(VLCChannelCategory));
+
+    double start = BenchNow();
+    VLCChannelClassifier *classifier = VLCChannelClassifierCreate();
+    BenchCheck(classifier, "out of memory");
+    for (size_t i = 0; i < count; i++) {
+        const BenchEntry *entry = &entries[i];
+        classified[i] = VLCChannelClassify(classifier, entry->name, strlen(entry->name), entry->group, strlen(entry->group),
+                                           entry->url, strlen(entry->url));
+    }
+    VLCChannelClassifierFree(classifier);
+    double classifierSeconds = BenchNow() - start;
+
+    size_t totals[3] = { 0 };
+    size_t combined = 0;
+    start = BenchNow();
+    for (size_t i = 0; i < count; i++) {
+        VLCChannelCategory category = BenchBaselineCategory(&entries[i]);
+        if (entries[i].combinedMarker) {
+            BenchCheck(classified[i] == VLCChannelCategorySeries && category != VLCChannelCategorySeries,
+                       "channel %zu (%s): the combined episode marker was not the only difference", i, entries[i].name);
+            combined++;
+        } else {
+            BenchCheck(classified[i] == category, "channel %zu (%s, %s): %s from the classifier, %s from the old rules",
+                       i, entries[i].name, entries[i].url, BenchCategoryNames[classified[i]], BenchCategoryNames[category]);
+        }
+        totals[classified[i]]++;
+    }
+    double baselineSeconds = BenchNow() - start;
+
+    printf("classifier %zu channels in %.3f s: %.1f ns each (%zu TV, %zu MOVIES, %zu SERIES)\n", count, classifierSeconds,
+           classifierSeconds * 1e9 / (double)count, totals[VLCChannelCategoryTV], totals[VLCChannelCategoryMovies],
+           totals[VLCChannelCategorySeries]);
+    printf("baseline   %zu channels in %.3f s: %.1f ns each (%.1fx the classifier), %zu SxxExx episodes it missed\n", count,
+           baselineSeconds, baselineSeconds * 1e9 / (double)count,
+           classifierSeconds > 0 ? baselineSeconds / classifierSeconds : 0.0, combined);
+
+    for (size_t i = 0; i < count; i++) {
+        free(entries[i].name);
+        free(entries[i].group);
+        free(entries[i].url);
+    }
+    free(entries);
+    free(classified);
+    return 0;
+}
@@ -0,0 +1,288 @@
+//
+//  channel_matcher_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Match rate and time of VLCChannelMatcher on a synthetic playlist against a synthetic guide,
+//  resolving each channel the way VLCEPGChannelIndex does: tvg-id as given (a VLCHashIndex
+//  here, the programme dictionary in the app), then the normalized tvg-id, tvg-name and name,
+//  then the fuzzy index for tvg-name and name. Then VLCHashIndex on its own with as many
+//  fingerprints as a large playlist refresh looks up.
+//
+//  channel_matcher_bench [--channels N] [--guide N] [--fingerprints N]
+//
+//  Defaults: 100000 playlist channels against 20000 guide channels, 1000000 fingerprints.
+//  About a fifth of the playlist has no guide channel at all (movies and series); the rest
+//  names its guide channel in one of several ways, some misspelled.
+//
+
+#include "bench_support.h"
+#include "VLCChannelMatcher.h"
+#include "VLCHashIndex.h"
+
+#include <ctype.h>
+
+// Matches VLCEPGFuzzyMatchThreshold in VLCEPGManager.m
+#define BENCH_FUZZY_THRESHOLD 0.7
+
+typedef enum {
+    BenchMatchNone = 0,
+    BenchMatchId,
+    BenchMatchNormalizedId,
+    BenchMatchTvgName,
+    BenchMatchName,
+    BenchMatchFuzzy,
+    BenchMatchKindCount
+} BenchMatchKind;
+
+static const char *BenchMatchKindNames[BenchMatchKindCount] = {
+    "none", "tvg-id", "normalized tvg-id", "tvg-name", "name", "fuzzy"
+};
+
+typedef struct {
+    char id[64];
+    char name[64];
+} BenchGuideChannel;
+
+typedef struct {
+    char tvgId[64];
+    char tvgName[80];
+    char name[80];
+    uint32_t guide;             // Ground truth, VLC_CHANNEL_MATCHER_NONE when there is none
+} BenchPlaylistChannel;
+
+static const char *BenchBrands[] = {
+    "Sky", "BBC", "Fox", "Euro", "Kanal", "Rai", "Canal", "Star", "Nova", "Sport", "Discovery",
+    "National", "History", "Cartoon", "Disney", "Comedy", "Music", "Cinema", "Premier", "Global"
+};
+static const char *BenchGenres[] = {
+    "News", "Sports", "Movies", "Kids", "Documentary", "Action", "Drama", "Family", "Life",
+    "Travel", "Science", "Nature", "Crime", "Comedy", "Gold", "Max", "Plus", "Extra", "Select"
+};
+static const char *BenchCountries[] = { "uk", "us", "de", "fr", "tr", "nl", "it", "es" };
+static const char *BenchQualities[] = { "HD", "FHD", "UHD", "SD", "4K", "HEVC" };
+
+#define BenchCount(array) (sizeof(array) / sizeof((array)[0]))
+
+static void BenchMakeGuide(BenchGuideChannel *guide, size_t count) {
+    uint64_t seed = 7;
+    for (size_t i = 0; i < count; i++) {
+        const char *brand = BenchBrands[BenchRandom(&seed) % BenchCount(BenchBrands)];
+        const char *genre = BenchGenres[BenchRandom(&seed) % BenchCount(BenchGenres)];
+        const char *country = BenchCountries[i % BenchCount(BenchCountries)];
+        // The index keeps the names distinct, as the ids of one guide are
+        snprintf(guide[i].name, sizeof(guide[i].name), "%s %s %zu", brand, genre, i);
+        snprintf(guide[i].id, sizeof(guide[i].id), "%s%s%zu.%s", brand, genre, i, country);
+    }
+}
+
+// Only among the letters: a changed number names another channel, not a misspelled one
+static void BenchMisspell(char *name, uint64_t *seed) {
+    size_t length = strlen(name);
+    size_t letters = strcspn(name, "0123456789");
+    size_t at = 1 + BenchRandom(seed) % (letters - 3);
+    if (BenchRandom(seed) % 2) {
+        memmove(name + at, name + at + 1, length - at);         // A letter dropped
+    } else {
+        char swap = name[at];                                   // Two letters swapped
+        name[at] = name[at + 1];
+        name[at + 1] = swap;
+    }
+}
+
+static void BenchMakePlaylist(BenchPlaylistChannel *channels, size_t count, const BenchGuideChannel *guide, size_t guideCount) {
+    uint64_t seed = 11;
+    for (size_t i = 0; i < count; i++) {
+        BenchPlaylistChannel *channel = &channels[i];
+        memset(channel, 0, sizeof(*channel));
+        uint32_t variant = BenchRandom(&seed) % 100;
+        if (variant < 20) {
+            snprintf(channel->name, sizeof(channel->name), "Movie Title %zu (%u)", i, 1990 + BenchRandom(&seed) % 35);
+            channel->guide = VLC_CHANNEL_MATCHER_NONE;
+            continue;
+        }
+        uint32_t target = BenchRandom(&seed) % (uint32_t)guideCount;
+        const BenchGuideChannel *entry = &guide[target];
+        const char *country = BenchCountries[target % BenchCount(BenchCountries)];
+        const char *quality = BenchQualities[BenchRandom(&seed) % BenchCount(BenchQualities)];
+        channel->guide = target;
+        snprintf(channel->name, sizeof(channel->name), "%s: %s %s", country, entry->name, quality);
+        if (variant < 45) {
+            snprintf(channel->tvgId, sizeof(channel->tvgId), "%s", entry->id);
+        } else if (variant < 60) {
+            // Another capitalization and no country suffix
+            snprintf(channel->tvgId, sizeof(channel->tvgId), "%s", entry->id);
+            *strrchr(channel->tvgId, '.') = '\0';
+            for (char *c = channel->tvgId; *c; c++) {
+                *c = (char)toupper((unsigned char)*c);
+            }
+        } else if (variant < 75) {
+            snprintf(channel->tvgName, sizeof(channel->tvgName), "|%s| %s %s", country, entry->name, quality);
+        } else if (variant < 85) {
+            snprintf(channel->name, sizeof(channel->name), "[%s] %s", country, entry->name);
+        } else {
+            BenchMisspell(channel->name + 4, &seed);
+        }
+    }
+}
+
+#pragma mark - Matching
+
+static uint32_t BenchFind(VLCChannelMatcher *matcher, const char *name, int fuzzy) {
+    if (name[0] == '\0') {
+        return VLC_CHANNEL_MATCHER_NONE;
+    }
+    if (fuzzy) {
+        return VLCChannelMatcherFindSimilar(matcher, name, strlen(name), BENCH_FUZZY_THRESHOLD, NULL);
+    }
+    return VLCChannelMatcherFindExact(matcher, name, strlen(name));
+}
+
+static void BenchMatch(size_t channelCount, size_t guideCount) {
+    BenchGuideChannel *guide = malloc(guideCount * sizeof(BenchGuideChannel));
+    BenchPlaylistChannel *channels = malloc(channelCount * sizeof(BenchPlaylistChannel));
+    BenchMakeGuide(guide, guideCount);
+    BenchMakePlaylist(channels, channelCount, guide, guideCount);
+
+    double start = BenchNow();
+    VLCHashIndex *ids = VLCHashIndexCreate(guideCount);
+    VLCChannelMatcher *matcher = VLCChannelMatcherCreate(guideCount * 2);
+    BenchCheck(ids && matcher, "out of memory");
+    // Ids first, so an id wins over another channel's display name that normalizes the same
+    for (size_t i = 0; i < guideCount; i++) {
+        BenchCheck(VLCHashIndexSet(ids, VLCHashBytes(guide[i].id, strlen(guide[i].id), VLC_HASH_SEED), (uint32_t)i + 1) &&
+                   VLCChannelMatcherAdd(matcher, guide[i].id, strlen(guide[i].id), (uint32_t)i), "out of memory");
+    }
+    for (size_t i = 0; i < guideCount; i++) {
+        BenchCheck(VLCChannelMatcherAdd(matcher, guide[i].name, strlen(guide[i].name), (uint32_t)i), "out of memory");
+    }
+    BenchCheck(VLCChannelMatcherFinish(matcher), "out of memory");
+    double indexSeconds = BenchNow() - start;
+
+    size_t kinds[BenchMatchKindCount] = { 0 };
+    size_t correct = 0;
+    size_t wrong = 0;
+    start = BenchNow();
+    for (size_t i = 0; i < channelCount; i++) {
+        const BenchPlaylistChannel *channel = &channels[i];
+        BenchMatchKind kind = BenchMatchNone;
+        uint32_t target = VLC_CHANNEL_MATCHER_NONE;
+        if (channel->tvgId[0]) {
+            uint32_t slot = VLCHashIndexGet(ids, VLCHashBytes(channel->tvgId, strlen(channel->tvgId), VLC_HASH_SEED));
+            if (slot > 0 && strcmp(guide[slot - 1].id, channel->tvgId) == 0) {
+                target = slot - 1;
+                kind = BenchMatchId;
+            }
+        }
+        if (kind == BenchMatchNone) {
+            if ((target = BenchFind(matcher, channel->tvgId, 0)) != VLC_CHANNEL_MATCHER_NONE) {
+                kind = BenchMatchNormalizedId;
+            } else if ((target = BenchFind(matcher, channel->tvgName, 0)) != VLC_CHANNEL_MATCHER_NONE) {
+                kind = BenchMatchTvgName;
+            } else if ((target = BenchFind(matcher, channel->name, 0)) != VLC_CHANNEL_MATCHER_NONE) {
+                kind = BenchMatchName;
+            } else if ((target = BenchFind(matcher, channel->tvgName, 1)) != VLC_CHANNEL_MATCHER_NONE ||
+                       (target = BenchFind(matcher, channel->name, 1)) != VLC_CHANNEL_MATCHER_NONE) {
+                kind = BenchMatchFuzzy;
+            }
+        }
+        kinds[kind]++;
+        if (kind != BenchMatchNone) {
+            if (target == channel->guide) {
+                correct++;
+            } else {
+                wrong++;
+            }
+        }
+    }
+    double matchSeconds = BenchNow() - start;
+
+    size_t withGuide = 0;
+    for (size_t i = 0; i < channelCount; i++) {
+        withGuide += channels[i].guide != VLC_CHANNEL_MATCHER_NONE;
+    }
+    size_t matched = correct + wrong;
+    printf("matcher   %zu names of %zu guide channels indexed in %.0f ms, %.1f MB\n",
+           VLCChannelMatcherCount(matcher), guideCount, indexSeconds * 1000.0,
+           (double)VLCChannelMatcherBytesAllocated(matcher) / (1024.0 * 1024.0));
+    printf("matcher   %zu channels resolved in %.0f ms (%.2f µs each): %zu matched (%.1f%% of the %zu with a guide channel), %zu to the wrong one\n",
+           channelCount, matchSeconds * 1000.0, matchSeconds * 1e6 / (double)channelCount,
+           matched, withGuide ? 100.0 * (double)correct / (double)withGuide : 0.0, withGuide, wrong);
+    for (int kind = BenchMatchId; kind < BenchMatchKindCount; kind++) {
+        printf("          by %-18s %zu\n", BenchMatchKindNames[kind], kinds[kind]);
+    }
+    printf("          unmatched          %zu\n", kinds[BenchMatchNone]);
+
+    // Channels without a guide channel never match; most of the others must
+    BenchCheck(matched <= withGuide, "%zu channels matched, only %zu have a guide channel", matched, withGuide);
+    BenchCheck(correct * 10 >= withGuide * 9, "only %zu of %zu channels matched correctly", correct, withGuide);
+    BenchCheck(wrong * 100 <= matched, "%zu of %zu matches went to the wrong channel", wrong, matched);
+
+    VLCChannelMatcherFree(matcher);
+    VLCHashIndexFree(ids);
+    free(channels);
+    free(guide);
+}
+
+#pragma mark - Hash Index
+
+static void BenchHashIndex(size_t count) {
+    uint64_t *keys = malloc(count * sizeof(uint64_t));
+    char entry[128];
+    for (size_t i = 0; i < count; i++) {
+        int length = snprintf(entry, sizeof(entry), "#EXTINF:-1 tvg-id=\"c%zu\",Channel %zu\nhttp://example.com/%zu.ts", i, i, i);
+        keys[i] = VLCHashBytes(entry, (size_t)length, VLC_HASH_SEED);
+    }
+
+    // Sized for a tenth so growing is part of the measurement
+    double start = BenchNow();
+    VLCHashIndex *index = VLCHashIndexCreate(count / 10);
+    BenchCheck(index, "out of memory");
+    for (size_t i = 0; i < count; i++) {
+        BenchCheck(VLCHashIndexSet(index, keys[i], (uint32_t)i + 1), "out of memory");
+    }
+    double insertSeconds = BenchNow() - start;
+
+    start = BenchNow();
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        found += VLCHashIndexGet(index, keys[i]) == (uint32_t)i + 1;
+    }
+    double hitSeconds = BenchNow() - start;
+
+    start = BenchNow();
+    size_t missed = 0;
+    for (size_t i = 0; i < count; i++) {
+        missed += VLCHashIndexGet(index, keys[i] ^ 0x9e3779b97f4a7c15ULL) == 0;
+    }
+    double missSeconds = BenchNow() - start;
+
+    printf("hashindex %zu fingerprints: insert %.1f ns, hit %.1f ns, miss %.1f ns each\n",
+           count, insertSeconds * 1e9 / (double)count, hitSeconds * 1e9 / (double)count, missSeconds * 1e9 / (double)count);
+    BenchCheck(VLCHashIndexCount(index) == count, "%zu keys stored of %zu", VLCHashIndexCount(index), count);
+    BenchCheck(found == count, "%zu of %zu keys found", found, count);
+    BenchCheck(missed == count, "%zu of %zu absent keys reported absent", missed, count);
+
+    VLCHashIndexFree(index);
+    free(keys);
+}
+
+int main(int argc, char **argv) {
+    size_t channels = 100000;
+    size_t guide = 20000;
+    size_t fingerprints = 1000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--channels") == 0) {
+            channels = strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--guide") == 0) {
+            guide = strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--fingerprints") == 0) {
+            fingerprints = strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    BenchCheck(channels > 0 && guide > 0 && fingerprints > 0, "counts must be positive");
+
+    BenchMatch(channels, guide);
+    BenchHashIndex(fingerprints);
+    printf("peak RSS %.1f MB\n", BenchPeakRSSMegabytes());
+    return 0;
+}
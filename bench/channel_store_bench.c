@@ -0,0 +1,311 @@
+//
+//  channel_store_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Heap bytes per channel and peak RSS of a parsed playlist kept the way VLCChannelStore keeps
+//  it, against one object per channel with a string per field as before.
+//
+//  store       the playlist fields in a VLCStringPool, URLs split through a VLCURLPrefixTable
+//              and the other columns in chunks laid out like VLCChannelStoreChunk, plus one
+//              small VLCChannel facade per row (isa, store, row, local and extras pointers)
+//  strings     the old VLCChannel with an ivar per property and an NSString per playlist
+//              field, each string modelled as a 16-byte object header with its bytes inline
+//
+//  Both keep the same fields, intern group names the same way and hold the channels in one
+//  array. Each mode runs in a child process of its own so peak RSS is measured per mode; the
+//  store has to come out under half the heap bytes of the strings.
+//
+//  channel_store_bench [--entries N]      (default 1000000)
+//
+
+#include "bench_support.h"
+#include "VLCHashIndex.h"
+#include "VLCM3UTokenizer.h"
+#include "VLCStringPool.h"
+#include "VLCURLPrefixTable.h"
+#include "m3u_synthetic_playlist.h"
+
+#include <malloc.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// The pooled string columns of VLCChannelStoreField, up to the URL
+enum {
+    BenchFieldName = 0,
+    BenchFieldLogo,
+    BenchFieldChannelId,
+    BenchFieldCatchupSource,
+    BenchFieldCatchupTemplate,
+    BenchFieldTvgName,
+    BenchPooledFields
+};
+
+#define BENCH_CHUNK_ROWS 1024
+#define BENCH_MAX_CHUNKS 16384
+
+// VLCChannelStoreChunk
+typedef struct {
+    VLCStringRef strings[BenchPooledFields][BENCH_CHUNK_ROWS];
+    uint64_t url[BENCH_CHUNK_ROWS];
+    uint32_t group[BENCH_CHUNK_ROWS];
+    int32_t catchupDays[BENCH_CHUNK_ROWS];
+    uint8_t category[BENCH_CHUNK_ROWS];
+    uint8_t supportsCatchup[BENCH_CHUNK_ROWS];
+    uint64_t entryFingerprint[BENCH_CHUNK_ROWS];
+    uint64_t entryIdentity[BENCH_CHUNK_ROWS];
+} BenchStoreChunk;
+
+// The ivars of a VLCChannel facade
+typedef struct {
+    void *isa;
+    void *store;
+    uint32_t row;
+    void *local;
+    void *extras;
+} BenchFacade;
+
+// An immutable NSString holding its bytes inline
+typedef struct {
+    void *isa;
+    uint64_t info;
+    char bytes[];
+} BenchString;
+
+// The ivars of VLCChannel before the store: every property its own, tvg-name included so both
+// modes keep the same fields
+typedef struct {
+    void *isa;
+    BenchString *strings[BenchPooledFields];
+    BenchString *url;
+    BenchString *group;
+    const char *category;               // One of three constant strings
+    void *programs;
+    void *logoUrl;
+    void *movieFields[8];               // movieId through movieCast
+    void *cachedPosterImage;
+    long catchupDays;
+    uint64_t entryFingerprint;
+    uint64_t entryIdentity;
+    char supportsCatchup;
+    char hasLoadedMovieInfo;
+    char hasStartedFetchingMovieInfo;
+} BenchOldChannel;
+
+typedef struct {
+    int store;                          // Which mode builds the list
+    VLCHashIndex *groupIds;             // Hash of the group name -> group index + 1
+    BenchString **groups;
+    size_t groupCount;
+    size_t groupCapacity;
+    void **channels;                    // The NSMutableArray of channels
+    size_t count;
+    size_t capacity;
+    VLCStringPool *pool;
+    VLCURLPrefixTable *prefixes;
+    BenchStoreChunk *chunks[BENCH_MAX_CHUNKS];
+    size_t chunkCount;
+} BenchList;
+
+static BenchString *BenchMakeString(VLCM3USpan span) {
+    if (span.length == 0) {
+        return NULL;
+    }
+    BenchString *string = malloc(sizeof(BenchString) + span.length + 1);
+    memcpy(string->bytes, span.bytes, span.length);
+    string->bytes[span.length] = '\0';
+    return string;
+}
+
+// Same in both modes, as the parsers intern group names either way
+static uint32_t BenchGroupId(BenchList *list, VLCM3USpan group) {
+    if (group.length == 0) {
+        return UINT32_MAX;
+    }
+    uint32_t *slot = VLCHashIndexSlot(list->groupIds, VLCHashBytes(group.bytes, group.length, VLC_HASH_SEED));
+    BenchCheck(slot, "out of memory");
+    if (*slot == 0) {
+        if (list->groupCount == list->groupCapacity) {
+            list->groupCapacity = list->groupCapacity ? list->groupCapacity * 2 : 256;
+            list->groups = realloc(list->groups, list->groupCapacity * sizeof(BenchString *));
+        }
+        list->groups[list->groupCount++] = BenchMakeString(group);
+        *slot = (uint32_t)list->groupCount;
+    }
+    return *slot - 1;
+}
+
+static void BenchAddToArray(BenchList *list, void *channel) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 4096;
+        list->channels = realloc(list->channels, list->capacity * sizeof(void *));
+    }
+    list->channels[list->count++] = channel;
+}
+
+static void BenchEntryFields(const VLCM3UEntry *entry, VLCM3USpan *fields) {
+    fields[BenchFieldName] = entry->name;
+    fields[BenchFieldLogo] = entry->tvgLogo;
+    fields[BenchFieldChannelId] = entry->tvgId;
+    fields[BenchFieldCatchupSource] = entry->catchup;
+    fields[BenchFieldCatchupTemplate] = entry->catchupTemplate;
+    fields[BenchFieldTvgName] = entry->tvgName;
+}
+
+#pragma mark - Store
+
+// appendRow: without the locking
+static void BenchAppendRow(BenchList *list, const VLCM3UEntry *entry) {
+    size_t row = list->count;
+    size_t chunkIndex = row / BENCH_CHUNK_ROWS;
+    BenchCheck(chunkIndex < BENCH_MAX_CHUNKS, "the store is full");
+    if (chunkIndex == list->chunkCount) {
+        list->chunks[list->chunkCount++] = malloc(sizeof(BenchStoreChunk));
+    }
+    BenchStoreChunk *chunk = list->chunks[chunkIndex];
+    size_t slot = row % BENCH_CHUNK_ROWS;
+
+    VLCM3USpan fields[BenchPooledFields];
+    BenchEntryFields(entry, fields);
+    for (size_t field = 0; field < BenchPooledFields; field++) {
+        int intern = field == BenchFieldCatchupSource || field == BenchFieldCatchupTemplate;
+        chunk->strings[field][slot] = VLCStringPoolAdd(list->pool, fields[field].bytes, fields[field].length, intern);
+    }
+    size_t prefixLength = VLCURLPrefixLength(entry->url.bytes, entry->url.length);
+    uint32_t prefixId = prefixLength > 0 ? VLCURLPrefixTableIntern(list->prefixes, entry->url.bytes, prefixLength)
+                                         : VLC_URL_PREFIX_NONE;
+    if (prefixId == VLC_URL_PREFIX_NONE) {
+        prefixLength = 0;
+    }
+    VLCStringRef suffix = VLCStringPoolAdd(list->pool, entry->url.bytes + prefixLength, entry->url.length - prefixLength, 0);
+    chunk->url[slot] = ((uint64_t)prefixId << 32) | suffix;
+    chunk->group[slot] = BenchGroupId(list, entry->groupTitle);
+    chunk->category[slot] = 0;
+    chunk->supportsCatchup[slot] = entry->catchup.length > 0;
+    chunk->catchupDays[slot] = (int32_t)VLCM3USpanToLong(entry->catchupDays);
+    chunk->entryFingerprint[slot] = VLCM3UEntryFingerprint(entry);
+    chunk->entryIdentity[slot] = VLCM3UEntryIdentity(entry);
+
+    BenchFacade *facade = calloc(1, sizeof(BenchFacade));
+    facade->row = (uint32_t)row;
+    BenchAddToArray(list, facade);
+}
+
+#pragma mark - Strings
+
+static void BenchAppendObject(BenchList *list, const VLCM3UEntry *entry) {
+    BenchOldChannel *channel = calloc(1, sizeof(BenchOldChannel));
+    VLCM3USpan fields[BenchPooledFields];
+    BenchEntryFields(entry, fields);
+    for (size_t field = 0; field < BenchPooledFields; field++) {
+        channel->strings[field] = BenchMakeString(fields[field]);
+    }
+    channel->url = BenchMakeString(entry->url);
+    uint32_t group = BenchGroupId(list, entry->groupTitle);
+    channel->group = group == UINT32_MAX ? NULL : list->groups[group];
+    channel->category = "TV";
+    channel->supportsCatchup = entry->catchup.length > 0;
+    channel->catchupDays = VLCM3USpanToLong(entry->catchupDays);
+    channel->entryFingerprint = VLCM3UEntryFingerprint(entry);
+    channel->entryIdentity = VLCM3UEntryIdentity(entry);
+    BenchAddToArray(list, channel);
+}
+
+static int BenchKeepEntry(const VLCM3UEntry *entry, void *context) {
+    BenchList *list = context;
+    if (list->store) {
+        BenchAppendRow(list, entry);
+    } else {
+        BenchAppendObject(list, entry);
+    }
+    return 1;
+}
+
+#pragma mark - Measuring
+
+typedef struct {
+    size_t channels;
+    double bytesPerChannel;
+    double peakMegabytes;           // Over the resident set the child started with
+} BenchResult;
+
+static size_t BenchHeapBytes(void) {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static double BenchResidentMegabytes(void) {
+    long pages = 0;
+    long resident = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm) {
+        if (fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        fclose(statm);
+    }
+    return (double)resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+// Builds the list in a child process and reads back what it cost
+static BenchResult BenchMeasure(const char *playlist, size_t length, int store) {
+    int results[2];
+    BenchCheck(pipe(results) == 0, "cannot create a pipe");
+    pid_t child = fork();
+    BenchCheck(child >= 0, "cannot fork");
+    if (child == 0) {
+        close(results[0]);
+        double startMegabytes = BenchResidentMegabytes();
+        size_t startBytes = BenchHeapBytes();
+        BenchList *list = calloc(1, sizeof(BenchList));
+        list->store = store;
+        list->groupIds = VLCHashIndexCreate(1024);
+        list->pool = VLCStringPoolCreate();
+        list->prefixes = VLCURLPrefixTableCreate();
+        BenchCheck(list->groupIds && list->pool && list->prefixes, "out of memory");
+        VLCM3UTokenizeBuffer(playlist, length, 0, 0, BenchKeepEntry, list, NULL);
+        if (store) {
+            // finishAppending:
+            VLCStringPoolStopInterning(list->pool);
+        }
+        BenchResult result = { list->count, 0.0, BenchPeakRSSMegabytes() - startMegabytes };
+        result.bytesPerChannel = list->count ? (double)(BenchHeapBytes() - startBytes) / (double)list->count : 0.0;
+        BenchCheck(write(results[1], &result, sizeof(result)) == (ssize_t)sizeof(result), "cannot report the result");
+        _exit(0);
+    }
+    close(results[1]);
+    BenchResult result = { 0 };
+    BenchCheck(read(results[0], &result, sizeof(result)) == (ssize_t)sizeof(result), "the %s child failed",
+               store ? "store" : "strings");
+    close(results[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    BenchCheck(WIFEXITED(status) && WEXITSTATUS(status) == 0, "the %s child failed", store ? "store" : "strings");
+    return result;
+}
+
+int main(int argc, char **argv) {
+    size_t entries = 1000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--entries") == 0) {
+            entries = strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    BenchCheck(entries > 0, "--entries must be positive");
+    size_t length = 0;
+    char *playlist = BenchMakePlaylist(entries, &length);
+
+    BenchResult store = BenchMeasure(playlist, length, 1);
+    BenchResult strings = BenchMeasure(playlist, length, 0);
+    printf("store     %zu channels: %.1f bytes per channel, peak RSS %.1f MB over the playlist\n",
+           store.channels, store.bytesPerChannel, store.peakMegabytes);
+    printf("strings   %zu channels: %.1f bytes per channel, peak RSS %.1f MB over the playlist\n",
+           strings.channels, strings.bytesPerChannel, strings.peakMegabytes);
+    printf("store/strings: %.2f of the heap bytes, %.2f of the peak RSS\n",
+           store.bytesPerChannel / strings.bytesPerChannel,
+           strings.peakMegabytes > 0 ? store.peakMegabytes / strings.peakMegabytes : 0.0);
+    BenchCheck(store.channels == entries && strings.channels == entries, "%zu and %zu channels parsed, %zu generated",
+               store.channels, strings.channels, entries);
+    BenchCheck(store.bytesPerChannel * 2 < strings.bytesPerChannel, "the store is not under half the heap bytes");
+    free(playlist);
+    return 0;
+}
@@ -0,0 +1,199 @@
+//
+//  decompressor_check.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Feeds a recorded guide and its gzip and xz downloads to VLCStreamDecompressor in every chunk
+//  size and checks the output is always the guide itself. Every truncation of the compressed
+//  files must finish as incomplete, every corrupted byte must either fail or still produce the
+//  guide, and concatenated gzip members are read back to back.
+//
+//  decompressor_check fixtures/guide.xml fixtures/guide.xml.gz fixtures/guide.xml.xz
+//
+
+#include "bench_support.h"
+#include "VLCStreamDecompressor.h"
+
+#include <zlib.h>
+
+typedef struct {
+    char *bytes;
+    size_t length;
+    size_t capacity;
+    size_t largestPiece;
+    size_t stopAfter;           // Refuse output once this much arrived, 0 for never
+} BenchOutput;
+
+static int BenchCollect(const char *bytes, size_t length, void *context) {
+    BenchOutput *output = context;
+    if (output->length + length > output->capacity) {
+        output->capacity = (output->length + length) * 2;
+        output->bytes = realloc(output->bytes, output->capacity);
+    }
+    memcpy(output->bytes + output->length, bytes, length);
+    output->length += length;
+    if (length > output->largestPiece) {
+        output->largestPiece = length;
+    }
+    return output->stopAfter == 0 || output->length < output->stopAfter;
+}
+
+// Output of the download fed in chunks of chunk bytes; *finished is VLCStreamDecompressorFinish,
+// or 0 when a feed already failed
+static VLCCompressionFormat BenchDecompress(const char *bytes, size_t length, size_t chunk, BenchOutput *output, int *finished) {
+    VLCStreamDecompressor *decompressor = VLCStreamDecompressorCreate(BenchCollect, output);
+    BenchCheck(decompressor, "out of memory");
+    int fed = 1;
+    for (size_t offset = 0; offset < length && fed; offset += chunk) {
+        fed = VLCStreamDecompressorFeed(decompressor, bytes + offset, length - offset < chunk ? length - offset : chunk);
+    }
+    *finished = fed && VLCStreamDecompressorFinish(decompressor);
+    BenchCheck(VLCStreamDecompressorBytesOut(decompressor) == output->length, "bytes out differ from the bytes reported");
+    VLCCompressionFormat format = VLCStreamDecompressorFormat(decompressor);
+    VLCStreamDecompressorFree(decompressor);
+    return format;
+}
+
+static int BenchIsPrefix(const BenchOutput *output, const char *plain, size_t plainLength) {
+    return output->length <= plainLength && (output->length == 0 || memcmp(output->bytes, plain, output->length) == 0);
+}
+
+static int BenchEquals(const BenchOutput *output, const char *plain, size_t plainLength) {
+    return output->length == plainLength && BenchIsPrefix(output, plain, plainLength);
+}
+
+// member is the length of one compressed stream in bytes; a cut between two is a whole download
+static void BenchCheckDownload(const char *name, const char *bytes, size_t length, size_t member, VLCCompressionFormat format,
+                               size_t magicLength, const char *plain, size_t plainLength) {
+    for (size_t chunk = 1; chunk <= length; chunk++) {
+        BenchOutput output = { 0 };
+        int finished = 0;
+        BenchCheck(BenchDecompress(bytes, length, chunk, &output, &finished) == format,
+                   "%s in chunks of %zu bytes: detected as another format", name, chunk);
+        BenchCheck(finished, "%s in chunks of %zu bytes did not finish", name, chunk);
+        BenchCheck(BenchEquals(&output, plain, plainLength), "%s in chunks of %zu bytes: output differs", name, chunk);
+        free(output.bytes);
+    }
+    if (format == VLCCompressionNone) {
+        return;
+    }
+    for (size_t cut = 1; cut < length; cut++) {
+        BenchOutput output = { 0 };
+        int finished = 0;
+        VLCCompressionFormat detected = BenchDecompress(bytes, cut, cut, &output, &finished);
+        if (cut < magicLength) {
+            // Shorter than the magic number: passed through as it is
+            BenchCheck(detected == VLCCompressionNone && finished && output.length == cut,
+                       "%s truncated to %zu bytes was not passed through", name, cut);
+        } else if (cut % member == 0) {
+            BenchCheck(finished, "%s cut between streams at byte %zu did not finish", name, cut);
+            BenchCheck(BenchIsPrefix(&output, plain, plainLength), "%s cut at byte %zu: output is not a prefix", name, cut);
+        } else {
+            BenchCheck(!finished, "%s truncated at byte %zu finished as complete", name, cut);
+            BenchCheck(BenchIsPrefix(&output, plain, plainLength), "%s truncated at byte %zu: output is not a prefix", name, cut);
+        }
+        free(output.bytes);
+    }
+    char *corrupt = malloc(length);
+    for (size_t position = magicLength; position < length; position++) {
+        memcpy(corrupt, bytes, length);
+        corrupt[position] ^= 0x55;
+        BenchOutput output = { 0 };
+        int finished = 0;
+        BenchDecompress(corrupt, length, 512, &output, &finished);
+        // A second member that does not start with the magic byte is trailing garbage, which
+        // gzip(1) ignores as well; the members before it are still the output
+        BenchCheck(!finished || BenchEquals(&output, plain, plainLength) ||
+                   (position % member == 0 && BenchEquals(&output, plain, plainLength * position / length)),
+                   "%s with byte %zu corrupted finished with the wrong output", name, position);
+        free(output.bytes);
+    }
+    free(corrupt);
+}
+
+// One gzip member of bytes, as a server compressing on the fly would send it
+static char *BenchGzip(const char *bytes, size_t length, size_t *compressedLength) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    BenchCheck(deflateInit2(&stream, 6, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK, "deflateInit2");
+    size_t capacity = deflateBound(&stream, length) + 64;
+    char *compressed = malloc(capacity);
+    stream.next_in = (Bytef *)bytes;
+    stream.avail_in = (uInt)length;
+    stream.next_out = (Bytef *)compressed;
+    stream.avail_out = (uInt)capacity;
+    BenchCheck(deflate(&stream, Z_FINISH) == Z_STREAM_END, "deflate");
+    *compressedLength = stream.total_out;
+    deflateEnd(&stream);
+    return compressed;
+}
+
+static char *BenchRepeat(const char *bytes, size_t length, size_t times, size_t extra) {
+    char *repeated = calloc(1, length * times + extra);
+    for (size_t i = 0; i < times; i++) {
+        memcpy(repeated + i * length, bytes, length);
+    }
+    return repeated;
+}
+
+int main(int argc, char **argv) {
+    BenchCheck(argc == 4, "usage: decompressor_check guide.xml guide.xml.gz guide.xml.xz");
+    size_t plainLength = 0;
+    size_t gzipLength = 0;
+    size_t xzLength = 0;
+    char *plain = BenchReadFile(argv[1], &plainLength);
+    char *gzip = BenchReadFile(argv[2], &gzipLength);
+    char *xz = BenchReadFile(argv[3], &xzLength);
+    BenchCheck(plain && gzip && xz && plainLength > 0, "cannot read the fixtures");
+
+    BenchCheckDownload("guide.xml", plain, plainLength, plainLength, VLCCompressionNone, 0, plain, plainLength);
+    BenchCheckDownload("guide.xml.gz", gzip, gzipLength, gzipLength, VLCCompressionGzip, 2, plain, plainLength);
+    BenchCheckDownload("guide.xml.xz", xz, xzLength, xzLength, VLCCompressionXz, 6, plain, plainLength);
+
+    // Concatenated members, and the zero padding some servers send after the last one
+    char *twice = BenchRepeat(plain, plainLength, 2, 0);
+    char *gzipTwice = BenchRepeat(gzip, gzipLength, 2, 0);
+    char *xzTwice = BenchRepeat(xz, xzLength, 2, 0);
+    char *padded = BenchRepeat(gzip, gzipLength, 1, 512);
+    BenchCheckDownload("two gzip members", gzipTwice, gzipLength * 2, gzipLength, VLCCompressionGzip, 2, twice, plainLength * 2);
+    BenchCheckDownload("two xz streams", xzTwice, xzLength * 2, xzLength, VLCCompressionXz, 6, twice, plainLength * 2);
+    for (size_t chunk = 1; chunk <= gzipLength + 512; chunk += 7) {
+        BenchOutput output = { 0 };
+        int finished = 0;
+        BenchDecompress(padded, gzipLength + 512, chunk, &output, &finished);
+        BenchCheck(finished && BenchEquals(&output, plain, plainLength), "zero padding in chunks of %zu bytes", chunk);
+        free(output.bytes);
+    }
+
+    // A guide far larger than the output buffer comes out in pieces of at most 64 KB
+    size_t largeLength = plainLength * 200;
+    char *large = BenchRepeat(plain, plainLength, 200, 0);
+    size_t largeGzipLength = 0;
+    char *largeGzip = BenchGzip(large, largeLength, &largeGzipLength);
+    BenchOutput output = { 0 };
+    int finished = 0;
+    BenchDecompress(largeGzip, largeGzipLength, 65536, &output, &finished);
+    BenchCheck(finished && BenchEquals(&output, large, largeLength), "large guide differs");
+    BenchCheck(output.largestPiece <= 65536, "output piece of %zu bytes", output.largestPiece);
+    free(output.bytes);
+
+    // Output that stops makes the feed fail, and nothing is reported after it
+    memset(&output, 0, sizeof(output));
+    output.stopAfter = 100000;
+    BenchDecompress(largeGzip, largeGzipLength, largeGzipLength, &output, &finished);
+    BenchCheck(!finished && output.length < largeLength && output.length <= output.stopAfter + 65536,
+               "output went on after it stopped");
+    free(output.bytes);
+
+    printf("decompressor_check: plain, gzip and xz identical in every chunk size, %zu + %zu truncations unfinished, corruption never accepted\n",
+           gzipLength - 2, xzLength - 6);
+    free(large);
+    free(largeGzip);
+    free(twice);
+    free(gzipTwice);
+    free(xzTwice);
+    free(padded);
+    free(plain);
+    free(gzip);
+    free(xz);
+    return 0;
+}
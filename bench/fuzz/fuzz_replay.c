@@ -0,0 +1,83 @@
+//
+//  fuzz_replay.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  main for the fuzz targets when they are built without libFuzzer (gcc, or clang without
+//  -DBENCH_LIBFUZZER=ON). Runs the target on every corpus file given, or every file in the
+//  corpus directories given, then on each of its truncations and on each single flipped byte,
+//  so ctest exercises the same invariants without a fuzzing engine.
+//
+//  json_record_fuzz fuzz/json_corpus [more files or directories...]
+//
+
+#include "bench_support.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+// Every input in a buffer of exactly its size, so the sanitizers see reads past the end
+static void BenchRunTarget(const char *bytes, size_t size) {
+    uint8_t *copy = malloc(size ? size : 1);
+    if (size > 0) {
+        memcpy(copy, bytes, size);
+    }
+    LLVMFuzzerTestOneInput(copy, size);
+    free(copy);
+}
+
+static size_t BenchReplayFile(const char *path) {
+    size_t length = 0;
+    char *bytes = BenchReadFile(path, &length);
+    BenchCheck(bytes, "cannot read %s", path);
+    size_t runs = 0;
+    BenchRunTarget(bytes, length);
+    runs++;
+    for (size_t cut = 0; cut < length; cut++) {
+        BenchRunTarget(bytes, cut);
+        runs++;
+    }
+    for (size_t position = 0; position < length; position++) {
+        static const char flips[] = { 0x01, 0x20, (char)0x80 };
+        for (size_t i = 0; i < sizeof(flips); i++) {
+            bytes[position] ^= flips[i];
+            BenchRunTarget(bytes, length);
+            bytes[position] ^= flips[i];
+            runs++;
+        }
+    }
+    free(bytes);
+    return runs;
+}
+
+int main(int argc, char **argv) {
+    BenchCheck(argc >= 2, "usage: %s corpus-file-or-directory...", argv[0]);
+    size_t files = 0;
+    size_t runs = 0;
+    for (int i = 1; i < argc; i++) {
+        struct stat info;
+        BenchCheck(stat(argv[i], &info) == 0, "cannot read %s", argv[i]);
+        if (!S_ISDIR(info.st_mode)) {
+            runs += BenchReplayFile(argv[i]);
+            files++;
+            continue;
+        }
+        DIR *directory = opendir(argv[i]);
+        BenchCheck(directory, "cannot read %s", argv[i]);
+        struct dirent *entry;
+        while ((entry = readdir(directory)) != NULL) {
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+            char path[4096];
+            snprintf(path, sizeof(path), "%s/%s", argv[i], entry->d_name);
+            runs += BenchReplayFile(path);
+            files++;
+        }
+        closedir(directory);
+    }
+    BenchCheck(files > 0, "empty corpus");
+    printf("%s: %zu corpus files, %zu inputs with their truncations and flipped bytes\n", argv[0], files, runs);
+    return 0;
+}
@@ -0,0 +1,84 @@
+//
+//  json_record_fuzz.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  libFuzzer target for VLCJSONRecordReader. Each input is read whole, split in two at a
+//  point taken from its first byte, and one byte at a time; all three must report the same
+//  records with the same fields and agree on whether the document was complete. Without
+//  libFuzzer, fuzz_replay.c drives it over the corpus in json_corpus/.
+//
+
+#include "VLCJSONRecordReader.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    uint64_t hash;              // FNV-1a over every key, type and value in order
+    size_t records;
+} BenchDigest;
+
+static void BenchHash(BenchDigest *digest, const char *bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        digest->hash = (digest->hash ^ (unsigned char)bytes[i]) * 0x100000001B3ULL;
+    }
+    digest->hash = (digest->hash ^ 0xFF) * 0x100000001B3ULL;
+}
+
+static int BenchDigestRecord(const VLCJSONField *fields, size_t count, void *context) {
+    BenchDigest *digest = context;
+    for (size_t i = 0; i < count; i++) {
+        char type = (char)('0' + fields[i].type);
+        BenchHash(digest, fields[i].key.bytes, fields[i].key.length);
+        BenchHash(digest, &type, 1);
+        BenchHash(digest, fields[i].value.bytes, fields[i].value.length);
+        if (fields[i].type == VLCJSONValueNested && fields[i].value.length != 0) {
+            fprintf(stderr, "nested value with a non-empty span\n");
+            abort();
+        }
+    }
+    digest->records++;
+    return 1;
+}
+
+// 1 when the input read as a complete array, 0 after a syntax error or when unfinished
+static int BenchRead(const uint8_t *data, size_t size, size_t split, size_t chunk, BenchDigest *digest) {
+    digest->hash = 0xCBF29CE484222325ULL;
+    digest->records = 0;
+    VLCJSONRecordReader *reader = VLCJSONRecordReaderCreate(BenchDigestRecord, digest);
+    if (!reader) {
+        abort();
+    }
+    const char *bytes = (const char *)data;
+    int fed = split == 0 || VLCJSONRecordReaderFeed(reader, bytes, split);
+    for (size_t offset = split; offset < size && fed; offset += chunk) {
+        fed = VLCJSONRecordReaderFeed(reader, bytes + offset, size - offset < chunk ? size - offset : chunk);
+    }
+    int finished = fed && VLCJSONRecordReaderFinish(reader);
+    if (VLCJSONRecordReaderRecordCount(reader) != digest->records) {
+        fprintf(stderr, "record count differs from the records reported\n");
+        abort();
+    }
+    VLCJSONRecordReaderFree(reader);
+    return finished;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    BenchDigest whole, split, bytewise;
+    int wholeFinished = BenchRead(data, size, size, 1, &whole);
+    size_t cut = size > 0 ? data[0] % (size + 1) : 0;
+    int splitFinished = BenchRead(data, size, cut, size, &split);
+    int bytewiseFinished = BenchRead(data, size, 0, 1, &bytewise);
+    if (splitFinished != wholeFinished || split.records != whole.records || split.hash != whole.hash) {
+        fprintf(stderr, "split at byte %zu: %zu records (finished %d) instead of %zu (finished %d)\n",
+                cut, split.records, splitFinished, whole.records, wholeFinished);
+        abort();
+    }
+    if (bytewiseFinished != wholeFinished || bytewise.records != whole.records || bytewise.hash != whole.hash) {
+        fprintf(stderr, "one byte at a time: %zu records (finished %d) instead of %zu (finished %d)\n",
+                bytewise.records, bytewiseFinished, whole.records, wholeFinished);
+        abort();
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+//
+//  xmltv_time_fuzz.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  libFuzzer target comparing VLCXMLTVParseTime with the formatter path it replaced
+//  (xmltv_time_reference.h). The raw input is decoded as it is, and its first bytes are also
+//  turned into a well-formed "YYYYMMDDHHMMSS +HHMM" with fields just past their ranges, so most
+//  runs reach the calendar checks. Without libFuzzer, fuzz_replay.c drives it over time_corpus/.
+//
+
+#include "VLCXMLTVParser.h"
+#include "xmltv_time_reference.h"
+
+static int BenchIsDigits(const uint8_t *bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (!isdigit(bytes[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Inputs both paths read the same way. The decoder also takes shapes the formatter refused
+// (no seconds, the offset right after the time) and leaves junk offsets as UTC where the
+// formatter read them with intValue.
+static int BenchIsComparable(const uint8_t *data, size_t size) {
+    if (size < 14 || !BenchIsDigits(data, 14)) {
+        return 0;
+    }
+    if (size > 14 && (data[14] == '+' || data[14] == '-')) {
+        return 0;
+    }
+    return size < 20 || ((data[15] == '+' || data[15] == '-') && BenchIsDigits(data + 16, 4));
+}
+
+static void BenchCompare(const uint8_t *data, size_t size) {
+    int64_t decoded = 0;
+    int64_t expected = 0;
+    int decodedOK = VLCXMLTVParseTime((const char *)data, size, &decoded);
+    if (!BenchIsComparable(data, size)) {
+        return;
+    }
+    int expectedOK = BenchFormatterTime((const char *)data, size, &expected);
+    if (decodedOK != expectedOK || (decodedOK && decoded != expected)) {
+        fprintf(stderr, "\"%.*s\": decoded %d/%lld, formatter %d/%lld\n", (int)size, (const char *)data,
+                decodedOK, (long long)decoded, expectedOK, (long long)expected);
+        abort();
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    BenchCompare(data, size);
+    if (size < 10) {
+        return 0;
+    }
+    char text[32];
+    int length = snprintf(text, sizeof(text), "%04u%02u%02u%02u%02u%02u %c%02u%02u",
+                          (unsigned)(data[0] | data[1] << 8) % 10000, data[2] % 14u, data[3] % 33u,
+                          data[4] % 25u, data[5] % 61u, data[6] % 61u, (data[7] & 1) ? '-' : '+',
+                          data[8] % 24u, data[9] % 60u);
+    // Exactly as long as the text, so the sanitizers see reads past it
+    uint8_t *formed = malloc((size_t)length);
+    memcpy(formed, text, (size_t)length);
+    BenchCompare(formed, (size_t)length);
+    free(formed);
+    return 0;
+}
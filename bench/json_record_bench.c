@@ -0,0 +1,80 @@
+//
+//  json_record_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  MB/s and records/s of VLCJSONRecordReader over a generated get_live_streams catalog fed in
+//  64 KB chunks, as the Xtream catalog download delivers it. Records carry escaped URLs,
+//  \u escapes, numeric strings, null and a nested category_ids array like the real ones.
+//
+//  json_record_bench [--records N]
+//
+
+#include "bench_support.h"
+#include "VLCJSONRecordReader.h"
+
+typedef struct {
+    size_t records;
+    long long streamIdSum;
+    size_t nameBytes;
+} BenchTotals;
+
+static int BenchHandleRecord(const VLCJSONField *fields, size_t count, void *context) {
+    BenchTotals *totals = context;
+    totals->records++;
+    totals->streamIdSum += VLCJSONFieldToLongLong(VLCJSONFindField(fields, count, "stream_id"), 0);
+    const VLCJSONField *name = VLCJSONFindField(fields, count, "name");
+    totals->nameBytes += name ? name->value.length : 0;
+    return 1;
+}
+
+static char *BenchCatalog(size_t records, size_t *length) {
+    size_t capacity = records * 512 + 16;
+    char *catalog = malloc(capacity);
+    size_t used = 0;
+    catalog[used++] = '[';
+    for (size_t i = 0; i < records; i++) {
+        used += (size_t)snprintf(catalog + used, capacity - used,
+                                 "%s{\"num\":%zu,\"name\":\"TR: Haber Kanal\\u0131 %zu \\\"HD\\\"\",\"stream_type\":\"live\","
+                                 "\"stream_id\":%zu,\"stream_icon\":\"http:\\/\\/logos.example.com\\/%zu.png\","
+                                 "\"epg_channel_id\":\"channel%zu.tr\",\"added\":\"1700000000\",\"is_adult\":0,"
+                                 "\"category_id\":\"%zu\",\"category_ids\":[%zu],\"custom_sid\":null,"
+                                 "\"tv_archive\":%d,\"direct_source\":\"\",\"tv_archive_duration\":\"7\"}",
+                                 i ? "," : "", i + 1, i, i, i, i, i % 40, i % 40, (int)(i % 3 == 0));
+    }
+    catalog[used++] = ']';
+    *length = used;
+    return catalog;
+}
+
+int main(int argc, char **argv) {
+    size_t records = 500000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--records") == 0) {
+            records = strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    BenchCheck(records > 0, "--records must be positive");
+    size_t length = 0;
+    char *catalog = BenchCatalog(records, &length);
+
+    BenchTotals totals = { 0 };
+    double start = BenchNow();
+    VLCJSONRecordReader *reader = VLCJSONRecordReaderCreate(BenchHandleRecord, &totals);
+    BenchCheck(reader, "out of memory");
+    for (size_t offset = 0; offset < length; offset += 65536) {
+        size_t step = length - offset < 65536 ? length - offset : 65536;
+        BenchCheck(VLCJSONRecordReaderFeed(reader, catalog + offset, step), "syntax error at byte %zu", offset);
+    }
+    BenchCheck(VLCJSONRecordReaderFinish(reader), "the catalog did not read as complete");
+    VLCJSONRecordReaderFree(reader);
+    double seconds = BenchNow() - start;
+
+    printf("reader    %zu records, %.1f MB in %.3f s: %.1f MB/s, %.0f records/s\n",
+           totals.records, (double)length / (1024.0 * 1024.0), seconds,
+           seconds > 0 ? (double)length / (1024.0 * 1024.0) / seconds : 0.0,
+           seconds > 0 ? (double)totals.records / seconds : 0.0);
+    BenchCheck(totals.records == records, "%zu records read, %zu generated", totals.records, records);
+    BenchCheck(totals.streamIdSum == (long long)(records * (records - 1) / 2), "stream_id values differ");
+    free(catalog);
+    return 0;
+}
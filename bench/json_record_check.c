@@ -0,0 +1,176 @@
+//
+//  json_record_check.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Reads a recorded player_api catalog with VLCJSONRecordReader in every chunk size and at every
+//  single cut, and checks that the records always come out the same as from the whole document;
+//  every truncation of it must read as unfinished rather than complete.
+//
+//  json_record_check fixtures/get_live_streams.json
+//
+
+#include "bench_support.h"
+#include "VLCJSONRecordReader.h"
+
+typedef struct {
+    char **records;             // "key=type:value" fields, 0x1F separated, one string per record
+    size_t count;
+    size_t capacity;
+} BenchRecordList;
+
+static int BenchCollectRecord(const VLCJSONField *fields, size_t count, void *context) {
+    BenchRecordList *list = context;
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++) {
+        length += fields[i].key.length + fields[i].value.length + 4;
+    }
+    char *text = malloc(length + 1);
+    char *cursor = text;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(cursor, fields[i].key.bytes, fields[i].key.length);
+        cursor += fields[i].key.length;
+        *cursor++ = '=';
+        *cursor++ = (char)('0' + fields[i].type);
+        *cursor++ = ':';
+        if (fields[i].value.length > 0) {
+            memcpy(cursor, fields[i].value.bytes, fields[i].value.length);
+            cursor += fields[i].value.length;
+        }
+        *cursor++ = '\x1f';
+    }
+    *cursor = '\0';
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 16;
+        list->records = realloc(list->records, list->capacity * sizeof(char *));
+    }
+    list->records[list->count++] = text;
+    return 1;
+}
+
+static void BenchFreeRecords(BenchRecordList *list) {
+    for (size_t i = 0; i < list->count; i++) {
+        free(list->records[i]);
+    }
+    free(list->records);
+    memset(list, 0, sizeof(*list));
+}
+
+// Records read from document in chunks of chunk bytes; returns VLCJSONRecordReaderFinish
+static int BenchRead(const char *bytes, size_t length, size_t chunk, BenchRecordList *list) {
+    VLCJSONRecordReader *reader = VLCJSONRecordReaderCreate(BenchCollectRecord, list);
+    BenchCheck(reader, "out of memory");
+    for (size_t offset = 0; offset < length; offset += chunk) {
+        size_t step = length - offset < chunk ? length - offset : chunk;
+        BenchCheck(VLCJSONRecordReaderFeed(reader, bytes + offset, step), "syntax error at byte %zu", offset);
+    }
+    int finished = VLCJSONRecordReaderFinish(reader);
+    BenchCheck(VLCJSONRecordReaderRecordCount(reader) == list->count, "record count differs from the records reported");
+    VLCJSONRecordReaderFree(reader);
+    return finished;
+}
+
+static void BenchCompare(const BenchRecordList *expected, const BenchRecordList *actual, size_t count, const char *how) {
+    BenchCheck(actual->count == count, "%s: %zu records instead of %zu", how, actual->count, count);
+    for (size_t i = 0; i < count; i++) {
+        BenchCheck(strcmp(actual->records[i], expected->records[i]) == 0,
+                   "%s: record %zu is\n  %s\ninstead of\n  %s", how, i, actual->records[i], expected->records[i]);
+    }
+}
+
+// Value of key in the record, as the reader reported it
+static int BenchHasField(const BenchRecordList *list, size_t record, const char *key, VLCJSONValueType type, const char *value) {
+    char field[512];
+    snprintf(field, sizeof(field), "%s=%c:%s\x1f", key, '0' + type, value);
+    const char *found = strstr(list->records[record], field);
+    return found && (found == list->records[record] || found[-1] == '\x1f');
+}
+
+int main(int argc, char **argv) {
+    BenchCheck(argc == 2, "usage: json_record_check catalog.json");
+    size_t length = 0;
+    char *bytes = BenchReadFile(argv[1], &length);
+    BenchCheck(bytes && length > 0, "cannot read %s", argv[1]);
+
+    BenchRecordList expected = { 0 };
+    BenchCheck(BenchRead(bytes, length, length, &expected), "the whole fixture did not read as complete");
+
+    // What the fixture is made of: escapes of every kind, a surrogate pair, nested values that
+    // are skipped (one holding a "}" string), numbers, booleans, null and an empty record
+    BenchCheck(expected.count == 6, "%zu records in the fixture, expected 6", expected.count);
+    BenchCheck(BenchHasField(&expected, 0, "stream_icon", VLCJSONValueString, "http://logos.example.com/bbc1.png"), "escaped slashes");
+    BenchCheck(BenchHasField(&expected, 0, "custom_sid", VLCJSONValueNull, "null"), "null");
+    BenchCheck(BenchHasField(&expected, 1, "name", VLCJSONValueString, "TR: Türkçe \"Haber\" Kanalı"), "escaped quotes");
+    BenchCheck(BenchHasField(&expected, 1, "category_ids", VLCJSONValueNested, ""), "nested array");
+    BenchCheck(BenchHasField(&expected, 2, "name", VLCJSONValueString, "Back\\slash / Tab\tNew\nLine"), "control escapes");
+    BenchCheck(BenchHasField(&expected, 2, "extra", VLCJSONValueNested, ""), "nested object");
+    BenchCheck(BenchHasField(&expected, 2, "category_id", VLCJSONValueString, "30"), "field after a nested object");
+    BenchCheck(BenchHasField(&expected, 3, "name", VLCJSONValueString, "Emoji \xF0\x9F\x93\xBA TV \xC3\x87orba"), "\\u escapes");
+    BenchCheck(BenchHasField(&expected, 3, "rating_5based", VLCJSONValueNumber, "-2.75e1"), "exponent");
+    BenchCheck(BenchHasField(&expected, 3, "is_adult", VLCJSONValueBool, "false"), "boolean");
+    BenchCheck(expected.records[4][0] == '\0', "empty record");
+    BenchCheck(BenchHasField(&expected, 5, "tv_archive", VLCJSONValueBool, "true"), "spaced out record");
+
+    // tv_archive as a numeric string ("1"), and null falling back
+    VLCJSONField field = { { "tv_archive", 10 }, { "1", 1 }, VLCJSONValueString };
+    BenchCheck(VLCJSONFieldToLongLong(&field, -1) == 1, "numeric string");
+    field.type = VLCJSONValueNull;
+    BenchCheck(VLCJSONFieldToLongLong(&field, -1) == -1, "null falls back");
+
+    char how[64];
+    for (size_t chunk = 1; chunk < length; chunk++) {
+        BenchRecordList actual = { 0 };
+        BenchCheck(BenchRead(bytes, length, chunk, &actual), "chunks of %zu bytes did not read as complete", chunk);
+        snprintf(how, sizeof(how), "chunks of %zu bytes", chunk);
+        BenchCompare(&expected, &actual, expected.count, how);
+        BenchFreeRecords(&actual);
+    }
+    for (size_t cut = 1; cut < length; cut++) {
+        // Two feeds, then the truncated document alone: a download that stopped there
+        BenchRecordList actual = { 0 };
+        VLCJSONRecordReader *reader = VLCJSONRecordReaderCreate(BenchCollectRecord, &actual);
+        BenchCheck(VLCJSONRecordReaderFeed(reader, bytes, cut) && VLCJSONRecordReaderFeed(reader, bytes + cut, length - cut),
+                   "syntax error with a cut at byte %zu", cut);
+        BenchCheck(VLCJSONRecordReaderFinish(reader), "cut at byte %zu did not read as complete", cut);
+        VLCJSONRecordReaderFree(reader);
+        snprintf(how, sizeof(how), "cut at byte %zu", cut);
+        BenchCompare(&expected, &actual, expected.count, how);
+        BenchFreeRecords(&actual);
+
+        size_t truncated = cut;
+        while (truncated > 0 && (bytes[truncated - 1] == ' ' || bytes[truncated - 1] == '\n')) {
+            truncated--;
+        }
+        if (bytes[truncated - 1] == ']') {
+            continue;       // Only trailing whitespace is missing
+        }
+        int finished = BenchRead(bytes, cut, cut, &actual);
+        snprintf(how, sizeof(how), "truncated at byte %zu", cut);
+        BenchCheck(!finished, "%s read as complete", how);
+        BenchCompare(&expected, &actual, actual.count, how);
+        BenchFreeRecords(&actual);
+    }
+
+    // Malformed documents stop the reader instead of producing records
+    static const char *malformed[] = {
+        "{\"a\":1}",
+        "[{\"a\" 1}]",
+        "[{\"a\":1}}",
+        "[{\"a\":\"\\x\"}]",
+        "[{\"a\":\"\\u12G4\"}]",
+        "[1 2]",
+    };
+    for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+        BenchRecordList actual = { 0 };
+        VLCJSONRecordReader *reader = VLCJSONRecordReaderCreate(BenchCollectRecord, &actual);
+        int fed = VLCJSONRecordReaderFeed(reader, malformed[i], strlen(malformed[i]));
+        BenchCheck(!fed || !VLCJSONRecordReaderFinish(reader), "%s was accepted", malformed[i]);
+        VLCJSONRecordReaderFree(reader);
+        BenchFreeRecords(&actual);
+    }
+
+    printf("json_record_check: %zu records identical for all %zu chunk sizes and cuts, every truncation unfinished\n",
+           expected.count, length);
+    BenchFreeRecords(&expected);
+    free(bytes);
+    return 0;
+}
@@ -0,0 +1,243 @@
+//
+//  m3u_download_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Time to the first 100 channels and total wall time of a playlist download from a local HTTP
+//  stand-in that throttles its bandwidth, parsed two ways:
+//
+//  stream      every received range handed to VLCM3UTokenizePartialBuffer as it arrives, the
+//              unconsumed tail carried into the next one, as DownloadManager streams it now
+//  tempfile    the old path: the body written to a temporary file, the file read back whole
+//              once the download completes and tokenized in one pass
+//
+//  The server thread answers one GET per mode on a loopback socket and paces its 64 KB writes
+//  to the given rate. Both modes must see every generated channel.
+//
+//  m3u_download_bench [--entries N] [--rate MB/s]      (defaults 100000 and 10)
+//
+
+#include "bench_support.h"
+#include "VLCM3UTokenizer.h"
+#include "m3u_synthetic_playlist.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define BENCH_CHUNK 65536
+#define BENCH_FIRST_CHANNELS 100
+
+#pragma mark - Server
+
+typedef struct {
+    int listener;
+    const char *body;
+    size_t length;
+    double bytesPerSecond;
+    int requests;                   // Answered one after another, then the thread ends
+} BenchServer;
+
+static void BenchSleepUntil(double when) {
+    double now = BenchNow();
+    if (when <= now) {
+        return;
+    }
+    double wait = when - now;
+    struct timespec delay = { (time_t)wait, (long)((wait - (double)(time_t)wait) * 1e9) };
+    nanosleep(&delay, NULL);
+}
+
+static int BenchSendAll(int socket, const char *bytes, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(socket, bytes, length, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return 0;
+        }
+        bytes += sent;
+        length -= (size_t)sent;
+    }
+    return 1;
+}
+
+static void *BenchServe(void *context) {
+    BenchServer *server = context;
+    for (int i = 0; i < server->requests; i++) {
+        int client = accept(server->listener, NULL, NULL);
+        if (client < 0) {
+            return NULL;
+        }
+        // The request itself does not matter; read it so the client is not reset
+        char request[1024];
+        ssize_t received = recv(client, request, sizeof(request), 0);
+        if (received > 0) {
+            char header[128];
+            int headerLength = snprintf(header, sizeof(header),
+                                        "HTTP/1.1 200 OK\r\nContent-Type: audio/x-mpegurl\r\nContent-Length: %zu\r\n\r\n",
+                                        server->length);
+            double start = BenchNow();
+            int open = BenchSendAll(client, header, (size_t)headerLength);
+            for (size_t offset = 0; open && offset < server->length; offset += BENCH_CHUNK) {
+                BenchSleepUntil(start + (double)offset / server->bytesPerSecond);
+                size_t step = server->length - offset < BENCH_CHUNK ? server->length - offset : BENCH_CHUNK;
+                open = BenchSendAll(client, server->body + offset, step);
+            }
+        }
+        close(client);
+    }
+    return NULL;
+}
+
+#pragma mark - Client
+
+typedef struct {
+    double start;
+    double firstChannels;           // Seconds until BENCH_FIRST_CHANNELS channels were out
+    size_t channels;
+    size_t urlBytes;
+} BenchProgress;
+
+static int BenchCountEntry(const VLCM3UEntry *entry, void *context) {
+    BenchProgress *progress = context;
+    progress->urlBytes += entry->url.length;
+    if (++progress->channels == BENCH_FIRST_CHANNELS) {
+        progress->firstChannels = BenchNow() - progress->start;
+    }
+    return 1;
+}
+
+// Connects, sends the GET and returns the socket positioned after the response header.
+// Header bytes read past the blank line go to body.
+static int BenchRequest(int port, char *body, size_t *bodyLength) {
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    BenchCheck(client >= 0 && connect(client, (struct sockaddr *)&address, sizeof(address)) == 0, "cannot connect");
+    static const char request[] = "GET /get.php?type=m3u_plus HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+    BenchCheck(BenchSendAll(client, request, sizeof(request) - 1), "cannot send the request");
+
+    char header[4096];
+    size_t used = 0;
+    for (;;) {
+        ssize_t received = recv(client, header + used, sizeof(header) - used, 0);
+        BenchCheck(received > 0, "the response header did not arrive");
+        used += (size_t)received;
+        char *end = memmem(header, used, "\r\n\r\n", 4);
+        if (end) {
+            size_t headerLength = (size_t)(end - header) + 4;
+            *bodyLength = used - headerLength;
+            memcpy(body, header + headerLength, *bodyLength);
+            return client;
+        }
+        BenchCheck(used < sizeof(header), "response header too long");
+    }
+}
+
+static void BenchStream(int port, BenchProgress *progress) {
+    size_t capacity = BENCH_CHUNK * 4;
+    char *carry = malloc(capacity);
+    size_t carryLength = 0;
+    int client = BenchRequest(port, carry, &carryLength);
+    for (;;) {
+        if (carryLength > 0) {
+            size_t consumed = VLCM3UTokenizePartialBuffer(carry, carryLength, BenchCountEntry, progress, NULL);
+            memmove(carry, carry + consumed, carryLength - consumed);
+            carryLength -= consumed;
+        }
+        if (capacity - carryLength < BENCH_CHUNK) {
+            capacity *= 2;
+            carry = realloc(carry, capacity);
+        }
+        ssize_t received = recv(client, carry + carryLength, BENCH_CHUNK, 0);
+        if (received <= 0) {
+            break;
+        }
+        carryLength += (size_t)received;
+    }
+    VLCM3UTokenizeBuffer(carry, carryLength, 0, 0, BenchCountEntry, progress, NULL);
+    close(client);
+    free(carry);
+}
+
+static void BenchTempFile(int port, BenchProgress *progress) {
+    char path[] = "/tmp/temp_playlist_XXXXXX";
+    int fd = mkstemp(path);
+    BenchCheck(fd >= 0, "cannot create a temporary file");
+    FILE *file = fdopen(fd, "wb");
+    char *chunk = malloc(BENCH_CHUNK);
+    size_t chunkLength = 0;
+    int client = BenchRequest(port, chunk, &chunkLength);
+    for (;;) {
+        BenchCheck(fwrite(chunk, 1, chunkLength, file) == chunkLength, "cannot write %s", path);
+        ssize_t received = recv(client, chunk, BENCH_CHUNK, 0);
+        if (received <= 0) {
+            break;
+        }
+        chunkLength = (size_t)received;
+    }
+    close(client);
+    fclose(file);
+    free(chunk);
+
+    // The completion handler: the whole file back into memory, then one pass
+    size_t length = 0;
+    char *bytes = BenchReadFile(path, &length);
+    BenchCheck(bytes, "cannot read %s back", path);
+    VLCM3UTokenizeBuffer(bytes, length, 0, 0, BenchCountEntry, progress, NULL);
+    free(bytes);
+    unlink(path);
+}
+
+#pragma mark - Main
+
+int main(int argc, char **argv) {
+    size_t entries = 100000;
+    double rate = 10.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--entries") == 0) {
+            entries = strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--rate") == 0) {
+            rate = strtod(argv[i + 1], NULL);
+        }
+    }
+    BenchCheck(entries >= BENCH_FIRST_CHANNELS && rate > 0, "needs --entries >= %d and a positive --rate", BENCH_FIRST_CHANNELS);
+    size_t length = 0;
+    char *playlist = BenchMakePlaylist(entries, &length);
+
+    BenchServer server = { socket(AF_INET, SOCK_STREAM, 0), playlist, length, rate * 1024.0 * 1024.0, 2 };
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addressLength = sizeof(address);
+    BenchCheck(server.listener >= 0 && bind(server.listener, (struct sockaddr *)&address, sizeof(address)) == 0 &&
+               listen(server.listener, 1) == 0 &&
+               getsockname(server.listener, (struct sockaddr *)&address, &addressLength) == 0,
+               "cannot listen on the loopback interface");
+    int port = ntohs(address.sin_port);
+    pthread_t thread;
+    BenchCheck(pthread_create(&thread, NULL, BenchServe, &server) == 0, "cannot start the server");
+
+    printf("playlist  %zu channels, %.1f MB served at %.1f MB/s\n", entries, (double)length / (1024.0 * 1024.0), rate);
+    BenchProgress stream = { BenchNow(), 0, 0, 0 };
+    BenchStream(port, &stream);
+    double streamSeconds = BenchNow() - stream.start;
+    printf("stream    first %d channels after %.3f s, all %zu after %.3f s\n",
+           BENCH_FIRST_CHANNELS, stream.firstChannels, stream.channels, streamSeconds);
+
+    BenchProgress tempFile = { BenchNow(), 0, 0, 0 };
+    BenchTempFile(port, &tempFile);
+    double tempFileSeconds = BenchNow() - tempFile.start;
+    printf("tempfile  first %d channels after %.3f s, all %zu after %.3f s\n",
+           BENCH_FIRST_CHANNELS, tempFile.firstChannels, tempFile.channels, tempFileSeconds);
+
+    pthread_join(thread, NULL);
+    close(server.listener);
+    BenchCheck(stream.channels == entries && tempFile.channels == entries, "%zu and %zu channels parsed, %zu generated",
+               stream.channels, tempFile.channels, entries);
+    BenchCheck(stream.urlBytes == tempFile.urlBytes, "the two paths saw different URLs");
+    free(playlist);
+    return 0;
+}
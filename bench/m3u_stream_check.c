@@ -0,0 +1,166 @@
+//
+//  m3u_stream_check.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Feeds a fixture playlist to VLCM3UTokenizePartialBuffer the way VLCChannelManager does while
+//  a playlist downloads (the unconsumed tail is carried into the next chunk, the last one is
+//  flushed with VLCM3UTokenizeBuffer) and checks that every chunk size and every single cut
+//  yields exactly the entries of the whole file.
+//
+//  m3u_stream_check fixtures/playlist.m3u
+//
+
+#include "bench_support.h"
+#include "VLCM3UTokenizer.h"
+
+typedef struct {
+    char **entries;             // Every field of an entry, 0x1F separated, one string per entry
+    size_t count;
+    size_t capacity;
+} BenchEntryList;
+
+static void BenchAppendSpan(char **text, size_t *length, VLCM3USpan span) {
+    *text = realloc(*text, *length + span.length + 2);
+    if (span.length > 0) {
+        memcpy(*text + *length, span.bytes, span.length);
+        *length += span.length;
+    }
+    (*text)[(*length)++] = '\x1f';
+    (*text)[*length] = '\0';
+}
+
+static int BenchCollectEntry(const VLCM3UEntry *entry, void *context) {
+    BenchEntryList *list = context;
+    char *text = NULL;
+    size_t length = 0;
+    const VLCM3USpan spans[] = {
+        entry->extinf, entry->name, entry->tvgId, entry->tvgName, entry->tvgLogo, entry->groupTitle,
+        entry->catchup, entry->catchupDays, entry->catchupTemplate, entry->tvgShift, entry->url
+    };
+    for (size_t i = 0; i < sizeof(spans) / sizeof(spans[0]); i++) {
+        BenchAppendSpan(&text, &length, spans[i]);
+    }
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 16;
+        list->entries = realloc(list->entries, list->capacity * sizeof(char *));
+    }
+    list->entries[list->count++] = text;
+    return 1;
+}
+
+static void BenchFreeEntries(BenchEntryList *list) {
+    for (size_t i = 0; i < list->count; i++) {
+        free(list->entries[i]);
+    }
+    free(list->entries);
+    memset(list, 0, sizeof(*list));
+}
+
+typedef struct {
+    char *bytes;
+    size_t length;
+    size_t capacity;
+} BenchCarry;
+
+static void BenchCarryAppend(BenchCarry *carry, const char *bytes, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    if (carry->length + length > carry->capacity) {
+        carry->capacity = (carry->length + length) * 2;
+        carry->bytes = realloc(carry->bytes, carry->capacity);
+    }
+    memcpy(carry->bytes + carry->length, bytes, length);
+    carry->length += length;
+}
+
+// One dataHandler call of the streaming download
+static void BenchFeedChunk(BenchCarry *carry, const char *bytes, size_t length, BenchEntryList *list) {
+    if (carry->length == 0) {
+        size_t consumed = VLCM3UTokenizePartialBuffer(bytes, length, BenchCollectEntry, list, NULL);
+        BenchCarryAppend(carry, bytes + consumed, length - consumed);
+    } else {
+        BenchCarryAppend(carry, bytes, length);
+        size_t consumed = VLCM3UTokenizePartialBuffer(carry->bytes, carry->length, BenchCollectEntry, list, NULL);
+        memmove(carry->bytes, carry->bytes + consumed, carry->length - consumed);
+        carry->length -= consumed;
+    }
+}
+
+static void BenchFinish(BenchCarry *carry, BenchEntryList *list) {
+    VLCM3UTokenizeBuffer(carry->bytes, carry->length, 0, 0, BenchCollectEntry, list, NULL);
+    free(carry->bytes);
+    memset(carry, 0, sizeof(*carry));
+}
+
+static void BenchCompare(const BenchEntryList *expected, const BenchEntryList *actual, const char *how) {
+    BenchCheck(actual->count == expected->count, "%s: %zu entries instead of %zu", how, actual->count, expected->count);
+    for (size_t i = 0; i < expected->count; i++) {
+        BenchCheck(strcmp(actual->entries[i], expected->entries[i]) == 0,
+                   "%s: entry %zu is\n  %s\ninstead of\n  %s", how, i, actual->entries[i], expected->entries[i]);
+    }
+}
+
+static const char *BenchField(const BenchEntryList *list, size_t entry, size_t field) {
+    static char value[1024];
+    const char *cursor = list->entries[entry];
+    for (size_t i = 0; i < field; i++) {
+        cursor = strchr(cursor, '\x1f') + 1;
+    }
+    size_t length = (size_t)(strchr(cursor, '\x1f') - cursor);
+    memcpy(value, cursor, length);
+    value[length] = '\0';
+    return value;
+}
+
+int main(int argc, char **argv) {
+    BenchCheck(argc == 2, "usage: m3u_stream_check playlist.m3u");
+    size_t length = 0;
+    char *bytes = BenchReadFile(argv[1], &length);
+    BenchCheck(bytes && length > 0, "cannot read %s", argv[1]);
+
+    BenchEntryList expected = { 0 };
+    VLCM3UTokenizeBuffer(bytes, length, 0, 0, BenchCollectEntry, &expected, NULL);
+
+    // What the fixture is made of: a URL-less entry is dropped, comments and #EXTVLCOPT lines
+    // between an #EXTINF and its URL are skipped, and the last URL has no newline
+    BenchCheck(expected.count == 9, "%zu entries in the fixture, expected 9", expected.count);
+    BenchCheck(strcmp(BenchField(&expected, 0, 2), "bbc1.uk") == 0, "tvg-id of the first entry");
+    BenchCheck(strcmp(BenchField(&expected, 2, 5), "US, News & Weather") == 0, "group with a comma");
+    BenchCheck(strcmp(BenchField(&expected, 2, 7), "7") == 0, "catchup-days");
+    BenchCheck(strcmp(BenchField(&expected, 2, 10), "http://provider.example.com:8080/live/user/pass/3.ts") == 0,
+               "URL after #EXTVLCOPT");
+    BenchCheck(strcmp(BenchField(&expected, 3, 10), "http://provider.example.com:8080/live/user/pass/4.ts") == 0,
+               "URL with spaces around it");
+    BenchCheck(strcmp(BenchField(&expected, 7, 1), "Series One S01 E01") == 0, "entry after the URL-less one");
+    BenchCheck(strcmp(BenchField(&expected, 8, 10), "http://provider.example.com:8080/live/user/pass/6.ts") == 0,
+               "last URL without a newline");
+
+    char how[64];
+    for (size_t chunk = 1; chunk <= length; chunk++) {
+        BenchEntryList actual = { 0 };
+        BenchCarry carry = { 0 };
+        for (size_t offset = 0; offset < length; offset += chunk) {
+            BenchFeedChunk(&carry, bytes + offset, length - offset < chunk ? length - offset : chunk, &actual);
+        }
+        BenchFinish(&carry, &actual);
+        snprintf(how, sizeof(how), "chunks of %zu bytes", chunk);
+        BenchCompare(&expected, &actual, how);
+        BenchFreeEntries(&actual);
+    }
+    for (size_t cut = 0; cut <= length; cut++) {
+        BenchEntryList actual = { 0 };
+        BenchCarry carry = { 0 };
+        BenchFeedChunk(&carry, bytes, cut, &actual);
+        BenchFeedChunk(&carry, bytes + cut, length - cut, &actual);
+        BenchFinish(&carry, &actual);
+        snprintf(how, sizeof(how), "cut at byte %zu", cut);
+        BenchCompare(&expected, &actual, how);
+        BenchFreeEntries(&actual);
+    }
+
+    printf("m3u_stream_check: %zu entries identical for all %zu chunk sizes and cuts\n", expected.count, length);
+    BenchFreeEntries(&expected);
+    free(bytes);
+    return 0;
+}
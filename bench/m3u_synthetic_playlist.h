@@ -0,0 +1,44 @@
+//
+//  m3u_synthetic_playlist.h
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  The generated playlist the M3U benchmarks parse: Xtream-style live and VOD entries with
+//  tvg attributes, groups, catch-up on some and bare #EXTINF lines on others
+//
+
+#ifndef m3u_synthetic_playlist_h
+#define m3u_synthetic_playlist_h
+
+#include "bench_support.h"
+
+static inline char *BenchMakePlaylist(size_t entries, size_t *length) {
+    size_t capacity = 64 + entries * 400;
+    char *bytes = malloc(capacity);
+    size_t used = (size_t)snprintf(bytes, capacity, "#EXTM3U url-tvg=\"http://epg.example.com/guide.xml.gz\"\n");
+    uint64_t seed = 42;
+    static const char *countries[] = { "UK", "US", "DE", "FR", "TR", "NL" };
+    for (size_t i = 0; i < entries; i++) {
+        uint32_t random = BenchRandom(&seed);
+        const char *country = countries[random % 6];
+        unsigned group = random % 900;
+        if (random % 10 == 0) {
+            // Bare entries as some providers send them: a name and nothing else
+            used += (size_t)snprintf(bytes + used, capacity - used,
+                                     "#EXTINF:-1,%s: Channel %zu\r\nhttp://provider.example.com:8080/live/user/pass/%zu.ts\n",
+                                     country, i, i);
+            continue;
+        }
+        used += (size_t)snprintf(bytes + used, capacity - used,
+                                 "#EXTINF:-1 tvg-id=\"channel%zu.%s\" tvg-name=\"%s: Channel %zu HD\" "
+                                 "tvg-logo=\"http://logos.example.com/%zu.png\" group-title=\"%s | Group %u\"%s,%s: Channel %zu HD\r\n"
+                                 "http://provider.example.com:8080/%s/user/pass/%zu%s\n",
+                                 i, country, country, i, i, country, group,
+                                 random % 4 == 0 ? " catchup=\"default\" catchup-days=\"7\"" : "",
+                                 country, i,
+                                 random % 5 == 0 ? "movie" : "live", i, random % 5 == 0 ? ".mkv" : ".ts");
+    }
+    *length = used;
+    return bytes;
+}
+
+#endif /* m3u_synthetic_playlist_h */
@@ -0,0 +1,360 @@
+//
+//  m3u_tokenizer_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  MB/s and peak RSS of VLCM3UTokenizer against the line-splitting path it replaced.
+//
+//  m3u_tokenizer_bench [--mode tokenizer|stream|shard|baseline] [--entries N] [playlist.m3u]
+//
+//  tokenizer   one pass over the mapped file (VLCM3UTokenizeBuffer)
+//  stream      64 KB chunks as they come off the network (VLCM3UTokenizePartialBuffer)
+//  shard       split at VLCM3UFindEntryStart as startShardedParsing: does, one thread per
+//              shard, merged in shard order; timed at 1, 2, 4 and 8 threads and checked
+//              against a serial parse
+//  baseline    the old path redone in C: the file read whole, copied again as the decoded
+//              string, split into line copies, each trimmed into another copy and searched
+//              once per attribute
+//
+//  Every mode keeps the same fields per channel (name, group, tvg-id, logo, URL) as heap
+//  strings, standing in for the NSStrings the app keeps. Without a file, N synthetic entries
+//  (default 400000) are generated. Peak RSS is per process, so run one mode per process.
+//
+
+#include "bench_support.h"
+#include "VLCM3UTokenizer.h"
+#include "m3u_synthetic_playlist.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+    char *name;
+    char *group;
+    char *channelId;
+    char *logo;
+    char *url;
+} BenchChannel;
+
+typedef struct {
+    BenchChannel *channels;
+    size_t count;
+    size_t capacity;
+} BenchChannelList;
+
+static char *BenchCopy(const char *bytes, size_t length) {
+    char *copy = malloc(length + 1);
+    memcpy(copy, bytes, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+static BenchChannel *BenchAddChannel(BenchChannelList *list) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 4096;
+        list->channels = realloc(list->channels, list->capacity * sizeof(BenchChannel));
+    }
+    BenchChannel *channel = &list->channels[list->count++];
+    memset(channel, 0, sizeof(*channel));
+    return channel;
+}
+
+static void BenchFreeChannels(BenchChannelList *list) {
+    for (size_t i = 0; i < list->count; i++) {
+        free(list->channels[i].name);
+        free(list->channels[i].group);
+        free(list->channels[i].channelId);
+        free(list->channels[i].logo);
+        free(list->channels[i].url);
+    }
+    free(list->channels);
+}
+
+#pragma mark - Tokenizer
+
+static char *BenchSpanCopy(VLCM3USpan span) {
+    return span.length > 0 ? BenchCopy(span.bytes, span.length) : NULL;
+}
+
+static int BenchKeepEntry(const VLCM3UEntry *entry, void *context) {
+    // Strings only for the fields that are kept, as VLCChannelManager does
+    BenchChannel *channel = BenchAddChannel(context);
+    channel->name = BenchSpanCopy(entry->name);
+    channel->group = BenchSpanCopy(entry->groupTitle);
+    channel->channelId = BenchSpanCopy(entry->tvgId);
+    channel->logo = BenchSpanCopy(entry->tvgLogo);
+    channel->url = BenchSpanCopy(entry->url);
+    return 1;
+}
+
+static void BenchTokenize(const char *bytes, size_t length, BenchChannelList *list) {
+    size_t emitted = 0;
+    VLCM3UTokenizeBuffer(bytes, length, 0, 0, BenchKeepEntry, list, &emitted);
+}
+
+// Chunks as DownloadManager delivers them; the unconsumed tail is carried into the next one
+static void BenchTokenizeStream(const char *bytes, size_t length, BenchChannelList *list) {
+    const size_t chunk = 65536;
+    char *carry = malloc(chunk * 4);
+    size_t carryCapacity = chunk * 4;
+    size_t carryLength = 0;
+    size_t emitted = 0;
+    for (size_t offset = 0; offset < length; offset += chunk) {
+        size_t step = length - offset < chunk ? length - offset : chunk;
+        if (carryLength + step > carryCapacity) {
+            carryCapacity = (carryLength + step) * 2;
+            carry = realloc(carry, carryCapacity);
+        }
+        memcpy(carry + carryLength, bytes + offset, step);
+        carryLength += step;
+        size_t consumed = VLCM3UTokenizePartialBuffer(carry, carryLength, BenchKeepEntry, list, &emitted);
+        memmove(carry, carry + consumed, carryLength - consumed);
+        carryLength -= consumed;
+    }
+    VLCM3UTokenizeBuffer(carry, carryLength, 0, 0, BenchKeepEntry, list, &emitted);
+    free(carry);
+}
+
+#pragma mark - Shards
+
+typedef struct {
+    const char *bytes;
+    size_t start;
+    size_t end;
+    BenchChannelList list;
+} BenchShard;
+
+static void *BenchTokenizeShard(void *context) {
+    BenchShard *shard = context;
+    size_t emitted = 0;
+    VLCM3UTokenizeBuffer(shard->bytes, shard->end, shard->start, 0, BenchKeepEntry, &shard->list, &emitted);
+    return NULL;
+}
+
+// Boundaries at the same targets as startShardedParsing:, shards tokenized in parallel and
+// their channels appended in shard order
+static void BenchTokenizeShards(const char *bytes, size_t length, size_t shardCount, BenchChannelList *list) {
+    BenchShard *shards = calloc(shardCount, sizeof(BenchShard));
+    pthread_t *threads = calloc(shardCount, sizeof(pthread_t));
+    size_t previous = 0;
+    for (size_t i = 0; i < shardCount; i++) {
+        size_t target = (size_t)(((unsigned long long)length * i) / shardCount);
+        shards[i].bytes = bytes;
+        shards[i].start = i == 0 ? 0 : VLCM3UFindEntryStart(bytes, length, target > previous ? target : previous);
+        previous = shards[i].start;
+        if (i > 0) {
+            shards[i - 1].end = shards[i].start;
+        }
+    }
+    shards[shardCount - 1].end = length;
+    for (size_t i = 0; i < shardCount; i++) {
+        BenchCheck(pthread_create(&threads[i], NULL, BenchTokenizeShard, &shards[i]) == 0, "cannot start shard %zu", i);
+    }
+    for (size_t i = 0; i < shardCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    for (size_t i = 0; i < shardCount; i++) {
+        for (size_t j = 0; j < shards[i].list.count; j++) {
+            *BenchAddChannel(list) = shards[i].list.channels[j];
+        }
+        free(shards[i].list.channels);
+    }
+    free(threads);
+    free(shards);
+}
+
+static int BenchSameString(const char *a, const char *b) {
+    return a == b || (a && b && strcmp(a, b) == 0);
+}
+
+static void BenchCompareChannels(const BenchChannelList *expected, const BenchChannelList *actual, size_t shardCount) {
+    BenchCheck(actual->count == expected->count, "%zu shards: %zu channels instead of %zu",
+               shardCount, actual->count, expected->count);
+    for (size_t i = 0; i < expected->count; i++) {
+        const BenchChannel *a = &actual->channels[i];
+        const BenchChannel *e = &expected->channels[i];
+        BenchCheck(BenchSameString(a->name, e->name) && BenchSameString(a->group, e->group) &&
+                   BenchSameString(a->channelId, e->channelId) && BenchSameString(a->logo, e->logo) &&
+                   BenchSameString(a->url, e->url),
+                   "%zu shards: channel %zu differs from the serial parse", shardCount, i);
+    }
+}
+
+static void BenchShardScaling(const char *bytes, size_t length) {
+    BenchChannelList serial = { 0 };
+    double start = BenchNow();
+    BenchTokenize(bytes, length, &serial);
+    double serialSeconds = BenchNow() - start;
+    double megabytes = (double)length / (1024.0 * 1024.0);
+    // More threads than processors only shows what the split and the merge cost
+    printf("serial    %zu channels, %.1f MB in %.3f s: %.1f MB/s, %ld processors online\n", serial.count, megabytes,
+           serialSeconds, serialSeconds > 0 ? megabytes / serialSeconds : 0.0, sysconf(_SC_NPROCESSORS_ONLN));
+
+    static const size_t shardCounts[] = { 1, 2, 4, 8 };
+    for (size_t i = 0; i < sizeof(shardCounts) / sizeof(shardCounts[0]); i++) {
+        BenchChannelList merged = { 0 };
+        start = BenchNow();
+        BenchTokenizeShards(bytes, length, shardCounts[i], &merged);
+        double seconds = BenchNow() - start;
+        printf("shard     %zu threads: %zu channels in %.3f s: %.1f MB/s (%.2fx serial)\n",
+               shardCounts[i], merged.count, seconds, seconds > 0 ? megabytes / seconds : 0.0,
+               seconds > 0 ? serialSeconds / seconds : 0.0);
+        BenchCompareChannels(&serial, &merged, shardCounts[i]);
+        BenchFreeChannels(&merged);
+    }
+    BenchFreeChannels(&serial);
+}
+
+#pragma mark - Baseline
+
+static int BenchIsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+// [line substringWithRange:] between key and the next quote
+static char *BenchAttribute(const char *line, const char *key) {
+    const char *start = strstr(line, key);
+    if (!start) {
+        return NULL;
+    }
+    start += strlen(key);
+    const char *end = strchr(start, '"');
+    return end ? BenchCopy(start, (size_t)(end - start)) : NULL;
+}
+
+static void BenchBaseline(const char *bytes, size_t length, BenchChannelList *list) {
+    // NSString from the file's NSData
+    char *content = BenchCopy(bytes, length);
+
+    // componentsSeparatedByString:@"\n"
+    size_t lineCount = 1;
+    for (size_t i = 0; i < length; i++) {
+        lineCount += content[i] == '\n';
+    }
+    char **lines = malloc(lineCount * sizeof(char *));
+    size_t lineIndex = 0;
+    const char *lineStart = content;
+    for (;;) {
+        const char *newline = strchr(lineStart, '\n');
+        size_t lineLength = newline ? (size_t)(newline - lineStart) : strlen(lineStart);
+        lines[lineIndex++] = BenchCopy(lineStart, lineLength);
+        if (!newline) {
+            break;
+        }
+        lineStart = newline + 1;
+    }
+
+    BenchChannel *current = NULL;
+    for (size_t i = 0; i < lineIndex; i++) {
+        // stringByTrimmingCharactersInSet:
+        const char *start = lines[i];
+        const char *end = start + strlen(start);
+        while (start < end && BenchIsSpace(*start)) start++;
+        while (end > start && BenchIsSpace(end[-1])) end--;
+        char *line = BenchCopy(start, (size_t)(end - start));
+
+        if (strncmp(line, "#EXTINF:", 8) == 0) {
+            current = BenchAddChannel(list);
+            const char *comma = strrchr(line, ',');
+            if (comma) {
+                const char *nameStart = comma + 1;
+                const char *nameEnd = line + strlen(line);
+                while (nameStart < nameEnd && BenchIsSpace(*nameStart)) nameStart++;
+                current->name = BenchCopy(nameStart, (size_t)(nameEnd - nameStart));
+            }
+            current->group = BenchAttribute(line, "group-title=\"");
+            current->channelId = BenchAttribute(line, "tvg-id=\"");
+            current->logo = BenchAttribute(line, "tvg-logo=\"");
+        } else if (current && strncmp(line, "http", 4) == 0) {
+            current->url = BenchCopy(line, strlen(line));
+            current = NULL;
+        }
+        free(line);
+    }
+
+    for (size_t i = 0; i < lineIndex; i++) {
+        free(lines[i]);
+    }
+    free(lines);
+    free(content);
+}
+
+#pragma mark - Main
+
+int main(int argc, char **argv) {
+    const char *mode = "tokenizer";
+    const char *path = NULL;
+    size_t entries = 400000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            mode = argv[++i];
+        } else if (strcmp(argv[i], "--entries") == 0 && i + 1 < argc) {
+            entries = strtoul(argv[++i], NULL, 10);
+        } else {
+            path = argv[i];
+        }
+    }
+
+    const char *bytes = NULL;
+    size_t length = 0;
+    char *synthetic = NULL;
+    void *mapped = NULL;
+    if (path) {
+        // Local playlists are mapped, never read into a buffer of their own
+        int fd = open(path, O_RDONLY);
+        struct stat info;
+        BenchCheck(fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0, "cannot open %s", path);
+        length = (size_t)info.st_size;
+        mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        BenchCheck(mapped != MAP_FAILED, "cannot map %s", path);
+        bytes = mapped;
+    } else {
+        synthetic = BenchMakePlaylist(entries, &length);
+        bytes = synthetic;
+    }
+    if (strcmp(mode, "shard") == 0) {
+        BenchShardScaling(bytes, length);
+        free(synthetic);
+        if (mapped) {
+            munmap(mapped, length);
+        }
+        return 0;
+    }
+    double baseRSS = BenchPeakRSSMegabytes();
+
+    BenchChannelList list = { 0 };
+    double start = BenchNow();
+    if (strcmp(mode, "tokenizer") == 0) {
+        BenchTokenize(bytes, length, &list);
+    } else if (strcmp(mode, "stream") == 0) {
+        BenchTokenizeStream(bytes, length, &list);
+    } else if (strcmp(mode, "baseline") == 0) {
+        BenchBaseline(bytes, length, &list);
+    } else {
+        fprintf(stderr, "unknown mode %s\n", mode);
+        return 2;
+    }
+    double seconds = BenchNow() - start;
+
+    double megabytes = (double)length / (1024.0 * 1024.0);
+    printf("%-9s %zu channels, %.1f MB in %.3f s: %.1f MB/s, peak RSS %.1f MB (%.1f MB over the input)\n",
+           mode, list.count, megabytes, seconds, seconds > 0 ? megabytes / seconds : 0.0,
+           BenchPeakRSSMegabytes(), BenchPeakRSSMegabytes() - baseRSS);
+
+    // Every mode has to see the same channels, or the comparison means nothing
+    if (!path) {
+        BenchCheck(list.count == entries, "%zu channels parsed, %zu generated", list.count, entries);
+        BenchCheck(list.channels[entries - 1].url && strstr(list.channels[entries - 1].url, "provider.example.com"),
+                   "last channel lost its URL");
+    }
+
+    BenchFreeChannels(&list);
+    free(synthetic);
+    if (mapped) {
+        munmap(mapped, length);
+    }
+    return 0;
+}
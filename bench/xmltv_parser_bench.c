@@ -0,0 +1,337 @@
+//
+//  xmltv_parser_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Programmes/s and peak RSS of VLCXMLTVParser against the NSXMLParser path it replaced.
+//
+//  xmltv_parser_bench [--mode parser|baseline] [--channels N] [--programmes N]
+//
+//  parser      64 KB chunks fed as they are produced, as DownloadManager delivers them;
+//              times decoded to integers, titles and descriptions appended to one pool
+//  baseline    the old path redone in C: the whole document collected first (the downloaded
+//              NSData), then every element reported with a copied name and attribute
+//              dictionary, all text accumulated and trimmed into new strings, element names
+//              compared as strings and one object per programme with times parsed through
+//              strptime and timegm, like the shared NSDateFormatter
+//
+//  The guide is generated: N channels (default 400) with N programmes each (default 500),
+//  every programme carrying the <credits>, <category>, <icon> and <episode-num> children real
+//  guides have. Peak RSS is per process, so run one mode per process.
+//
+
+#include "bench_support.h"
+#include "VLCXMLTVParser.h"
+#include "xmltv_synthetic_guide.h"
+
+#include <ctype.h>
+
+#pragma mark - Parser
+
+typedef struct {
+    size_t programmes;
+    size_t channels;
+    int64_t *starts;            // The programme store's columns
+    int64_t *stops;
+    char *pool;                 // Its string pool
+    size_t poolLength;
+    size_t poolCapacity;
+} BenchStore;
+
+static void BenchPool(BenchStore *store, const char *bytes, size_t length) {
+    if (store->poolLength + length > store->poolCapacity) {
+        store->poolCapacity = (store->poolLength + length) * 2;
+        store->pool = realloc(store->pool, store->poolCapacity);
+    }
+    memcpy(store->pool + store->poolLength, bytes, length);
+    store->poolLength += length;
+}
+
+static int BenchHandleChannel(const VLCXMLTVChannel *channel, void *context) {
+    BenchStore *store = context;
+    store->channels++;
+    for (size_t i = 0; i < channel->displayNameCount; i++) {
+        BenchPool(store, channel->displayNames[i].bytes, channel->displayNames[i].length);
+    }
+    return 1;
+}
+
+static int BenchHandleProgramme(const VLCXMLTVProgramme *programme, void *context) {
+    BenchStore *store = context;
+    size_t index = store->programmes++;
+    if ((index & (index - 1)) == 0) {
+        size_t capacity = index ? index * 2 : 1;
+        store->starts = realloc(store->starts, capacity * sizeof(int64_t));
+        store->stops = realloc(store->stops, capacity * sizeof(int64_t));
+    }
+    VLCXMLTVParseTime(programme->start.bytes, programme->start.length, &store->starts[index]);
+    VLCXMLTVParseTime(programme->stop.bytes, programme->stop.length, &store->stops[index]);
+    BenchPool(store, programme->title.bytes, programme->title.length);
+    BenchPool(store, programme->desc.bytes, programme->desc.length);
+    return 1;
+}
+
+static size_t BenchParse(BenchGuide *guide, size_t *bytes) {
+    BenchStore store = { 0 };
+    VLCXMLTVHandlers handlers = { BenchHandleChannel, BenchHandleProgramme };
+    VLCXMLTVParser *parser = VLCXMLTVParserCreate(handlers, &store);
+    BenchCheck(parser, "out of memory");
+    char *chunk = malloc(65536);
+    size_t length;
+    while ((length = BenchReadGuide(guide, chunk, 65536)) > 0) {
+        *bytes += length;
+        BenchCheck(VLCXMLTVParserFeed(parser, chunk, length), "parser stopped");
+    }
+    BenchCheck(VLCXMLTVParserFinish(parser), "the guide did not end properly");
+    BenchCheck(store.starts[0] == 1735686000 && store.stops[0] == 1735687740, "first programme decoded to %lld-%lld",
+               (long long)store.starts[0], (long long)store.stops[0]);
+    VLCXMLTVParserStats stats = VLCXMLTVParserGetStats(parser);
+    printf("parser    %llu elements (%.1f MB) skipped, %.1f KB carried across chunks, %.1f MB of strings kept\n",
+           (unsigned long long)stats.skippedElements, (double)stats.skippedBytes / (1024.0 * 1024.0),
+           (double)stats.carriedBytes / 1024.0, (double)store.poolLength / (1024.0 * 1024.0));
+    VLCXMLTVParserFree(parser);
+    free(chunk);
+    free(store.starts);
+    free(store.stops);
+    free(store.pool);
+    return store.programmes;
+}
+
+#pragma mark - Baseline
+
+typedef struct {
+    char *channel;
+    char *title;
+    char *desc;
+    time_t start;
+    time_t stop;
+} BenchProgram;
+
+typedef struct {
+    char *name;
+    char **attributes;          // Name, value, name, value...
+    size_t attributeCount;
+} BenchElement;
+
+static char *BenchCopy(const char *bytes, size_t length) {
+    char *copy = malloc(length + 1);
+    memcpy(copy, bytes, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+// NSXMLParser hands text over with entities already decoded
+static char *BenchDecode(const char *bytes, size_t length) {
+    char *text = malloc(length + 1);
+    size_t used = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (bytes[i] == '&' && i + 4 < length && memcmp(bytes + i, "&amp;", 5) == 0) {
+            text[used++] = '&';
+            i += 4;
+        } else {
+            text[used++] = bytes[i];
+        }
+    }
+    text[used] = '\0';
+    return text;
+}
+
+// "20250101060000 +0100" through a formatter: strptime, then the offset taken off
+static time_t BenchFormatterDate(const char *value) {
+    char *copy = BenchCopy(value, strlen(value));
+    struct tm fields;
+    memset(&fields, 0, sizeof(fields));
+    char *rest = strptime(copy, "%Y%m%d%H%M%S", &fields);
+    time_t seconds = timegm(&fields);
+    if (rest && *rest == ' ') {
+        char *offset = BenchCopy(rest + 1, strlen(rest + 1));
+        int hours = 0;
+        int minutes = 0;
+        sscanf(offset + 1, "%2d%2d", &hours, &minutes);
+        seconds -= (offset[0] == '-' ? -1 : 1) * (hours * 3600 + minutes * 60);
+        free(offset);
+    }
+    free(copy);
+    return seconds;
+}
+
+static const char *BenchAttribute(const BenchElement *element, const char *name) {
+    for (size_t i = 0; i < element->attributeCount; i++) {
+        if (strcmp(element->attributes[i * 2], name) == 0) {
+            return element->attributes[i * 2 + 1];
+        }
+    }
+    return NULL;
+}
+
+static void BenchFreeElement(BenchElement *element) {
+    free(element->name);
+    for (size_t i = 0; i < element->attributeCount * 2; i++) {
+        free(element->attributes[i]);
+    }
+    free(element->attributes);
+    memset(element, 0, sizeof(*element));
+}
+
+// didStartElement:attributes: gets a copied name and a dictionary of copied attributes
+static const char *BenchReadElement(const char *p, const char *end, BenchElement *element) {
+    const char *nameEnd = p;
+    while (nameEnd < end && !isspace((unsigned char)*nameEnd) && *nameEnd != '>' && *nameEnd != '/') nameEnd++;
+    element->name = BenchCopy(p, (size_t)(nameEnd - p));
+    p = nameEnd;
+    for (;;) {
+        while (p < end && isspace((unsigned char)*p)) p++;
+        if (p >= end || *p == '>' || *p == '/') {
+            break;
+        }
+        const char *equals = memchr(p, '=', (size_t)(end - p));
+        const char *valueStart = equals + 2;
+        const char *valueEnd = memchr(valueStart, equals[1], (size_t)(end - valueStart));
+        element->attributes = realloc(element->attributes, (element->attributeCount + 1) * 2 * sizeof(char *));
+        element->attributes[element->attributeCount * 2] = BenchCopy(p, (size_t)(equals - p));
+        element->attributes[element->attributeCount * 2 + 1] = BenchDecode(valueStart, (size_t)(valueEnd - valueStart));
+        element->attributeCount++;
+        p = valueEnd + 1;
+    }
+    return p;
+}
+
+static size_t BenchBaseline(BenchGuide *guide, size_t *bytes) {
+    // Downloaded whole before parsing starts
+    size_t capacity = 1 << 20;
+    char *document = malloc(capacity);
+    size_t length = 0;
+    for (;;) {
+        if (length + 65536 > capacity) {
+            capacity *= 2;
+            document = realloc(document, capacity);
+        }
+        size_t written = BenchReadGuide(guide, document + length, 65536);
+        if (written == 0) {
+            break;
+        }
+        length += written;
+    }
+    *bytes = length;
+
+    BenchProgram *programs = NULL;
+    size_t programCount = 0;
+    size_t channelCount = 0;
+    BenchProgram *current = NULL;
+    char *text = NULL;              // foundCharacters: appends to one mutable string
+    size_t textLength = 0;
+    const char *p = document;
+    const char *end = document + length;
+    while (p < end) {
+        const char *open = memchr(p, '<', (size_t)(end - p));
+        if (!open) {
+            break;
+        }
+        if (open > p) {
+            char *decoded = BenchDecode(p, (size_t)(open - p));
+            size_t decodedLength = strlen(decoded);
+            text = realloc(text, textLength + decodedLength + 1);
+            memcpy(text + textLength, decoded, decodedLength + 1);
+            textLength += decodedLength;
+            free(decoded);
+        }
+        const char *close = memchr(open, '>', (size_t)(end - open));
+        if (open[1] == '?' || open[1] == '!') {
+            p = close + 1;
+            continue;
+        }
+        if (open[1] == '/') {
+            // didEndElement: trims the text into a new string and compares the name
+            char *name = BenchCopy(open + 2, (size_t)(close - open - 2));
+            const char *start = text ? text : "";
+            const char *stop = start + textLength;
+            while (start < stop && isspace((unsigned char)*start)) start++;
+            while (stop > start && isspace((unsigned char)stop[-1])) stop--;
+            char *trimmed = BenchCopy(start, (size_t)(stop - start));
+            if (current && strcmp(name, "title") == 0 && !current->title) {
+                current->title = trimmed;
+                trimmed = NULL;
+            } else if (current && strcmp(name, "desc") == 0 && !current->desc) {
+                current->desc = trimmed;
+                trimmed = NULL;
+            } else if (strcmp(name, "programme") == 0) {
+                current = NULL;
+            } else if (strcmp(name, "channel") == 0) {
+                channelCount++;
+            }
+            free(trimmed);
+            free(name);
+            textLength = 0;
+            p = close + 1;
+            continue;
+        }
+        BenchElement element = { 0 };
+        BenchReadElement(open + 1, close, &element);
+        if (strcmp(element.name, "programme") == 0) {
+            if ((programCount & (programCount - 1)) == 0) {
+                programs = realloc(programs, (programCount ? programCount * 2 : 1) * sizeof(BenchProgram));
+            }
+            current = &programs[programCount++];
+            memset(current, 0, sizeof(*current));
+            const char *channel = BenchAttribute(&element, "channel");
+            current->channel = BenchCopy(channel, strlen(channel));
+            current->start = BenchFormatterDate(BenchAttribute(&element, "start"));
+            current->stop = BenchFormatterDate(BenchAttribute(&element, "stop"));
+        }
+        BenchFreeElement(&element);
+        textLength = 0;
+        p = close + 1;
+    }
+    BenchCheck(programCount > 0 && programs[0].start == 1735686000 && programs[0].stop == 1735687740,
+               "first programme decoded to %lld-%lld", (long long)programs[0].start, (long long)programs[0].stop);
+    BenchCheck(channelCount == guide->channels, "%zu channels of %zu", channelCount, guide->channels);
+
+    for (size_t i = 0; i < programCount; i++) {
+        free(programs[i].channel);
+        free(programs[i].title);
+        free(programs[i].desc);
+    }
+    free(programs);
+    free(text);
+    free(document);
+    return programCount;
+}
+
+#pragma mark - Main
+
+int main(int argc, char **argv) {
+    const char *mode = "parser";
+    BenchGuide guide = { .channels = 400, .programmes = 500 };
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--mode") == 0) {
+            mode = argv[i + 1];
+        } else if (strcmp(argv[i], "--channels") == 0) {
+            guide.channels = strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--programmes") == 0) {
+            guide.programmes = strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    BenchCheck(guide.channels > 0 && guide.programmes > 0, "counts must be positive");
+    double baseRSS = BenchPeakRSSMegabytes();
+
+    size_t bytes = 0;
+    size_t programmes = 0;
+    double start = BenchNow();
+    if (strcmp(mode, "parser") == 0) {
+        programmes = BenchParse(&guide, &bytes);
+    } else if (strcmp(mode, "baseline") == 0) {
+        programmes = BenchBaseline(&guide, &bytes);
+    } else {
+        fprintf(stderr, "unknown mode %s\n", mode);
+        return 2;
+    }
+    double seconds = BenchNow() - start;
+
+    printf("%-9s %zu programmes, %.1f MB in %.3f s: %.0f programmes/s, %.1f MB/s, peak RSS %.1f MB (%.1f MB over the start)\n",
+           mode, programmes, (double)bytes / (1024.0 * 1024.0), seconds,
+           seconds > 0 ? (double)programmes / seconds : 0.0,
+           seconds > 0 ? (double)bytes / (1024.0 * 1024.0) / seconds : 0.0,
+           BenchPeakRSSMegabytes(), BenchPeakRSSMegabytes() - baseRSS);
+    BenchCheck(programmes == guide.channels * guide.programmes, "%zu programmes parsed, %zu generated",
+               programmes, guide.channels * guide.programmes);
+    return 0;
+}
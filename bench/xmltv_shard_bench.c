@@ -0,0 +1,140 @@
+//
+//  xmltv_shard_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Programmes/s of a generated guide cut into pieces with VLCXMLTVShardBoundary, as
+//  VLCEPGManager cuts a download, and parsed with VLCXMLTVShardParse on 1, 2, 4 and 8 threads.
+//  Threads take the next piece as they finish one; the pieces are then walked in document
+//  order, which is what the merge does. Every run must find every programme.
+//
+//  xmltv_shard_bench [--channels N] [--programmes N] [--piece-kb N]
+//
+//  Defaults are 400 channels with 500 programmes each in pieces of 4096 KB, the piece size of
+//  VLCEPGManager.
+//
+
+#include "bench_support.h"
+#include "VLCXMLTVShard.h"
+#include "xmltv_synthetic_guide.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct {
+    const char *bytes;
+    const size_t *starts;       // pieceCount + 1 offsets
+    size_t pieceCount;
+    VLCXMLTVShard **shards;
+    size_t next;                // Next piece to take, shared by the threads
+} BenchWork;
+
+static void *BenchParsePieces(void *context) {
+    BenchWork *work = context;
+    for (;;) {
+        size_t piece = __atomic_fetch_add(&work->next, 1, __ATOMIC_RELAXED);
+        if (piece >= work->pieceCount) {
+            return NULL;
+        }
+        work->shards[piece] = VLCXMLTVShardParse(work->bytes + work->starts[piece],
+                                                 work->starts[piece + 1] - work->starts[piece]);
+    }
+}
+
+// Programmes found, with every piece parsed on threadCount threads
+static size_t BenchParseOnThreads(BenchWork *work, size_t threadCount) {
+    pthread_t threads[8];
+    work->next = 0;
+    memset(work->shards, 0, work->pieceCount * sizeof(VLCXMLTVShard *));
+    for (size_t i = 0; i < threadCount; i++) {
+        BenchCheck(pthread_create(&threads[i], NULL, BenchParsePieces, work) == 0, "cannot start thread %zu", i);
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    size_t programmes = 0;
+    for (size_t piece = 0; piece < work->pieceCount; piece++) {
+        BenchCheck(work->shards[piece], "out of memory");
+        BenchCheck(VLCXMLTVShardGetResult(work->shards[piece]) == VLCXMLTVShardParsed,
+                   "piece %zu did not parse whole", piece);
+        size_t count = 0;
+        VLCXMLTVShardProgrammes(work->shards[piece], &count);
+        programmes += count;
+        VLCXMLTVShardFree(work->shards[piece]);
+    }
+    return programmes;
+}
+
+int main(int argc, char **argv) {
+    BenchGuide guide = { .channels = 400, .programmes = 500 };
+    size_t pieceBytes = 4096 * 1024;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--channels") == 0) {
+            guide.channels = strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--programmes") == 0) {
+            guide.programmes = strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--piece-kb") == 0) {
+            pieceBytes = strtoul(argv[i + 1], NULL, 10) * 1024;
+        }
+    }
+    BenchCheck(guide.channels > 0 && guide.programmes > 0 && pieceBytes > 0, "sizes must be positive");
+    size_t expected = guide.channels * guide.programmes;
+
+    size_t capacity = 1 << 20;
+    size_t length = 0;
+    char *bytes = malloc(capacity);
+    for (;;) {
+        if (capacity - length < 65536) {
+            capacity *= 2;
+            bytes = realloc(bytes, capacity);
+        }
+        size_t read = BenchReadGuide(&guide, bytes + length, 65536);
+        if (read == 0) {
+            break;
+        }
+        length += read;
+    }
+
+    // Cut where appendToSegment: would once a piece worth of the download has arrived
+    size_t startCapacity = length / pieceBytes + 2;
+    size_t *starts = malloc(startCapacity * sizeof(size_t));
+    size_t pieceCount = 0;
+    starts[0] = 0;
+    while (length - starts[pieceCount] > pieceBytes) {
+        size_t boundary = VLCXMLTVShardBoundary(bytes + starts[pieceCount], pieceBytes);
+        if (boundary == 0) {
+            break;
+        }
+        if (pieceCount + 2 > startCapacity) {
+            startCapacity *= 2;
+            starts = realloc(starts, startCapacity * sizeof(size_t));
+        }
+        starts[pieceCount + 1] = starts[pieceCount] + boundary;
+        pieceCount++;
+    }
+    starts[++pieceCount] = length;
+
+    BenchWork work = { bytes, starts, pieceCount, calloc(pieceCount, sizeof(VLCXMLTVShard *)), 0 };
+    double megabytes = (double)length / (1024.0 * 1024.0);
+    // More threads than processors only shows what the cutting and the merge walk cost
+    printf("guide     %zu programmes, %.1f MB in %zu pieces, %ld processors online\n",
+           expected, megabytes, pieceCount, sysconf(_SC_NPROCESSORS_ONLN));
+    double oneThread = 0;
+    static const size_t threadCounts[] = { 1, 2, 4, 8 };
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+        double start = BenchNow();
+        size_t programmes = BenchParseOnThreads(&work, threadCounts[i]);
+        double seconds = BenchNow() - start;
+        if (i == 0) {
+            oneThread = seconds;
+        }
+        printf("shard     %zu threads: %.3f s, %.1f MB/s, %.0f programmes/s (%.2fx one thread)\n",
+               threadCounts[i], seconds, seconds > 0 ? megabytes / seconds : 0.0,
+               seconds > 0 ? (double)programmes / seconds : 0.0, seconds > 0 ? oneThread / seconds : 0.0);
+        BenchCheck(programmes == expected, "%zu threads: %zu programmes instead of %zu", threadCounts[i], programmes, expected);
+    }
+
+    free(work.shards);
+    free(starts);
+    free(bytes);
+    return 0;
+}
@@ -0,0 +1,197 @@
+//
+//  xmltv_shard_check.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Cuts a recorded guide into pieces with VLCXMLTVShardBoundary the way VLCEPGManager does
+//  while a guide downloads and parses every piece with VLCXMLTVShardParse. For every cut,
+//  including ones inside a <programme> open tag, its attributes or its title, the boundary must
+//  be the start of the last whole programme before it, and the pieces merged in order must give
+//  exactly what one serial parse of the document gives. A piece that ends inside an element
+//  must come back CutShort.
+//
+//  xmltv_shard_check fixtures/guide.xml
+//
+
+#include "bench_support.h"
+#include "VLCXMLTVShard.h"
+
+typedef struct {
+    char **rows;                // One string per channel or programme, in document order
+    size_t count;
+    size_t capacity;
+} BenchRowList;
+
+static void BenchAddRow(BenchRowList *list, char *row) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 64;
+        list->rows = realloc(list->rows, list->capacity * sizeof(char *));
+    }
+    list->rows[list->count++] = row;
+}
+
+static void BenchFreeRows(BenchRowList *list) {
+    for (size_t i = 0; i < list->count; i++) {
+        free(list->rows[i]);
+    }
+    free(list->rows);
+    memset(list, 0, sizeof(*list));
+}
+
+// Channels and programmes of a shard with their channel ids spelled out, as the merge sees them.
+// Channels come before programmes in a guide, so listing them first keeps document order.
+static void BenchCollectShard(const VLCXMLTVShard *shard, BenchRowList *list) {
+    char row[2048];
+    size_t count = 0;
+    const VLCXMLTVShardChannel *channels = VLCXMLTVShardChannels(shard, &count);
+    for (size_t i = 0; i < count; i++) {
+        VLCXMLTVSpan id = VLCXMLTVShardChannelId(shard, channels[i].channel);
+        int used = snprintf(row, sizeof(row), "channel %.*s", (int)id.length, id.bytes);
+        for (size_t j = 0; j < channels[i].displayNameCount; j++) {
+            used += snprintf(row + used, sizeof(row) - (size_t)used, "|%.*s",
+                             (int)channels[i].displayNames[j].length, channels[i].displayNames[j].bytes);
+        }
+        BenchAddRow(list, strdup(row));
+    }
+    const VLCXMLTVShardProgramme *programmes = VLCXMLTVShardProgrammes(shard, &count);
+    for (size_t i = 0; i < count; i++) {
+        VLCXMLTVSpan id = VLCXMLTVShardChannelId(shard, programmes[i].channel);
+        snprintf(row, sizeof(row), "programme %.*s|%lld|%lld|%.*s|%.*s", (int)id.length, id.bytes,
+                 (long long)programmes[i].start, (long long)programmes[i].stop,
+                 (int)programmes[i].title.length, programmes[i].title.bytes,
+                 (int)programmes[i].desc.length, programmes[i].desc.bytes);
+        BenchAddRow(list, strdup(row));
+    }
+}
+
+static VLCXMLTVShardResult BenchParsePiece(const char *bytes, size_t length, BenchRowList *list) {
+    // A piece of its own, so reads past its end show up under the sanitizers
+    char *piece = malloc(length ? length : 1);
+    memcpy(piece, bytes, length);
+    VLCXMLTVShard *shard = VLCXMLTVShardParse(piece, length);
+    BenchCheck(shard, "out of memory");
+    VLCXMLTVShardResult result = VLCXMLTVShardGetResult(shard);
+    if (list) {
+        BenchCollectShard(shard, list);
+    }
+    VLCXMLTVShardFree(shard);
+    free(piece);
+    return result;
+}
+
+static void BenchCompare(const BenchRowList *expected, const BenchRowList *actual, const char *how) {
+    BenchCheck(actual->count == expected->count, "%s: %zu rows instead of %zu", how, actual->count, expected->count);
+    for (size_t i = 0; i < expected->count; i++) {
+        BenchCheck(strcmp(actual->rows[i], expected->rows[i]) == 0,
+                   "%s: row %zu is\n  %s\ninstead of\n  %s", how, i, actual->rows[i], expected->rows[i]);
+    }
+}
+
+// appendToSegment: with a piece size of pieceBytes, the document arriving in chunks of chunk bytes
+static void BenchParseInPieces(const char *bytes, size_t length, size_t pieceBytes, size_t chunk, BenchRowList *list) {
+    size_t start = 0;
+    size_t segmentEnd = 0;
+    while (segmentEnd < length) {
+        segmentEnd = segmentEnd + chunk < length ? segmentEnd + chunk : length;
+        if (segmentEnd - start < pieceBytes) {
+            continue;
+        }
+        size_t boundary = VLCXMLTVShardBoundary(bytes + start, segmentEnd - start);
+        if (boundary > 0) {
+            BenchCheck(BenchParsePiece(bytes + start, boundary, list) == VLCXMLTVShardParsed,
+                       "piece [%zu, %zu) did not parse whole", start, start + boundary);
+            start += boundary;
+        }
+    }
+    BenchCheck(BenchParsePiece(bytes + start, length - start, list) == VLCXMLTVShardParsed,
+               "last piece [%zu, %zu) did not parse whole", start, length);
+}
+
+int main(int argc, char **argv) {
+    BenchCheck(argc == 2, "usage: xmltv_shard_check guide.xml");
+    size_t length = 0;
+    char *bytes = BenchReadFile(argv[1], &length);
+    BenchCheck(bytes && length > 0, "cannot read %s", argv[1]);
+
+    BenchRowList expected = { 0 };
+    BenchCheck(BenchParsePiece(bytes, length, &expected) == VLCXMLTVShardParsed, "the whole fixture did not parse");
+    // What the fixture is made of: 4 channels and 12 programmes, one of them for a
+    // channel that was never declared, one open tag spread over several lines
+    BenchCheck(expected.count == 16, "%zu rows in the fixture, expected 16", expected.count);
+
+    // Where every <programme> starts and ends in the document
+    size_t starts[64];
+    size_t ends[64];
+    size_t programmeCount = 0;
+    for (const char *found = bytes; (found = strstr(found, "<programme")) != NULL; found++) {
+        BenchCheck(programmeCount < 64, "too many programmes in the fixture");
+        starts[programmeCount] = (size_t)(found - bytes);
+        ends[programmeCount] = (size_t)(strstr(found, "</programme>") - bytes) + strlen("</programme>");
+        programmeCount++;
+    }
+
+    char how[64];
+    size_t insideElement = 0;
+    for (size_t cut = 1; cut <= length; cut++) {
+        // The last <programme with at least one byte after it, as the boundary only knows a
+        // tag name once the byte following it has arrived
+        size_t wanted = 0;
+        size_t within = SIZE_MAX;
+        for (size_t i = 0; i < programmeCount; i++) {
+            if (cut > starts[i] + strlen("<programme")) {
+                wanted = starts[i];
+            }
+            if (cut > starts[i] && cut < ends[i]) {
+                within = i;
+            }
+        }
+        size_t boundary = VLCXMLTVShardBoundary(bytes, cut);
+        BenchCheck(boundary == wanted, "cut at byte %zu: boundary %zu instead of %zu", cut, boundary, wanted);
+        if (boundary > 0) {
+            BenchRowList actual = { 0 };
+            BenchCheck(BenchParsePiece(bytes, boundary, &actual) == VLCXMLTVShardParsed,
+                       "cut at byte %zu: piece before the boundary did not parse whole", cut);
+            BenchCheck(BenchParsePiece(bytes + boundary, length - boundary, &actual) == VLCXMLTVShardParsed,
+                       "cut at byte %zu: piece after the boundary did not parse whole", cut);
+            snprintf(how, sizeof(how), "boundary at byte %zu", boundary);
+            BenchCompare(&expected, &actual, how);
+            BenchFreeRows(&actual);
+        }
+        if (within != SIZE_MAX) {
+            BenchCheck(BenchParsePiece(bytes, cut, NULL) == VLCXMLTVShardCutShort,
+                       "piece cut at byte %zu inside programme %zu did not come back cut short", cut, within);
+            insideElement++;
+        }
+    }
+
+    // "<programme" in CDATA or a comment is text, not a place to cut
+    static const char quoted[] =
+        "<tv>\n"
+        "  <programme start=\"20250101060000 +0000\" channel=\"a\">\n"
+        "    <title>A</title>\n"
+        "    <desc><![CDATA[Listings: <programme start=\"later\">]]></desc>\n"
+        "  </programme>\n"
+        "  <!-- dropped: <programme channel=\"b\"> -->\n"
+        "</tv>\n";
+    size_t quotedStart = (size_t)(strstr(quoted, "<programme") - quoted);
+    for (size_t cut = 1; cut < sizeof(quoted); cut++) {
+        size_t boundary = VLCXMLTVShardBoundary(quoted, cut);
+        BenchCheck(boundary == (cut > quotedStart + strlen("<programme") ? quotedStart : 0),
+                   "quoted <programme> cut at byte %zu: boundary %zu", cut, boundary);
+    }
+
+    for (size_t pieceBytes = 64; pieceBytes <= length; pieceBytes += 61) {
+        for (size_t chunk = 1; chunk <= 256; chunk *= 4) {
+            BenchRowList actual = { 0 };
+            BenchParseInPieces(bytes, length, pieceBytes, chunk, &actual);
+            snprintf(how, sizeof(how), "pieces of %zu bytes in chunks of %zu", pieceBytes, chunk);
+            BenchCompare(&expected, &actual, how);
+            BenchFreeRows(&actual);
+        }
+    }
+
+    printf("xmltv_shard_check: boundary right for all %zu cuts, %zu pieces ending inside a programme cut short, "
+           "pieces merge to the serial parse\n", length, insideElement);
+    BenchFreeRows(&expected);
+    free(bytes);
+    return 0;
+}
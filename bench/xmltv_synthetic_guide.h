@@ -0,0 +1,101 @@
+//
+//  xmltv_synthetic_guide.h
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  The generated guide the XMLTV benchmarks parse: channels declared first, then programmes
+//  with the children real guides carry, produced a piece at a time so it never has to exist
+//  whole unless a benchmark wants it to
+//
+
+#ifndef xmltv_synthetic_guide_h
+#define xmltv_synthetic_guide_h
+
+#include "bench_support.h"
+
+typedef struct {
+    size_t channels;
+    size_t programmes;          // Per channel
+    size_t channel;             // Next to write; channels are declared first, then programmed
+    size_t programme;
+    int declared;
+    int done;
+    char staged[4096];          // Generated but not yet read
+    size_t stagedOffset;
+    size_t stagedLength;
+} BenchGuide;
+
+static inline size_t BenchWriteGuide(BenchGuide *guide, char *out, size_t capacity) {
+    size_t used = 0;
+    if (guide->channel == 0 && guide->programme == 0 && !guide->declared) {
+        used += (size_t)snprintf(out, capacity,
+                                 "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                 "<!DOCTYPE tv SYSTEM \"xmltv.dtd\">\n"
+                                 "<tv generator-info-name=\"bench\">\n");
+    }
+    // Each element is well under 2 KB
+    while (!guide->done && used + 2048 < capacity) {
+        if (!guide->declared) {
+            used += (size_t)snprintf(out + used, capacity - used,
+                                     "  <channel id=\"channel%zu.uk\">\n"
+                                     "    <display-name lang=\"en\">Channel %zu HD</display-name>\n"
+                                     "    <display-name>Channel %zu</display-name>\n"
+                                     "    <icon src=\"http://img.example.com/c/%zu.png\" />\n"
+                                     "  </channel>\n",
+                                     guide->channel, guide->channel, guide->channel, guide->channel);
+            if (++guide->channel == guide->channels) {
+                guide->channel = 0;
+                guide->declared = 1;
+            }
+            continue;
+        }
+        size_t slot = guide->programme;
+        unsigned hour = (unsigned)(slot / 2) % 24;
+        unsigned day = 1 + (unsigned)(slot / 48) % 28;
+        unsigned minute = (unsigned)(slot % 2) * 30;
+        used += (size_t)snprintf(out + used, capacity - used,
+                                 "  <programme start=\"202501%02u%02u%02u00 +0100\" stop=\"202501%02u%02u%02u00 +0100\" channel=\"channel%zu.uk\">\n"
+                                 "    <title lang=\"en\">Programme %zu &amp; Friends</title>\n"
+                                 "    <sub-title lang=\"en\">Episode %zu</sub-title>\n"
+                                 "    <desc lang=\"en\">Programme %zu follows a group of friends through a week of small adventures, "
+                                 "told over several episodes with the same cast &amp; crew.</desc>\n"
+                                 "    <credits><director>Jane Doe</director><actor>John Roe</actor><actor>Ann Poe</actor></credits>\n"
+                                 "    <category lang=\"en\">Series</category>\n"
+                                 "    <icon src=\"http://img.example.com/p/%zu.jpg\" />\n"
+                                 "    <episode-num system=\"xmltv_ns\">1.%zu.</episode-num>\n"
+                                 "  </programme>\n",
+                                 day, hour, minute, day, hour, minute + 29, guide->channel,
+                                 slot, slot, slot, slot, slot);
+        if (++guide->programme == guide->programmes) {
+            guide->programme = 0;
+            if (++guide->channel == guide->channels) {
+                used += (size_t)snprintf(out + used, capacity - used, "</tv>\n");
+                guide->done = 1;
+            }
+        }
+    }
+    return used;
+}
+
+// Exactly capacity bytes until the guide ends, so chunks cut through elements as downloads do
+static inline size_t BenchReadGuide(BenchGuide *guide, char *out, size_t capacity) {
+    size_t used = 0;
+    while (used < capacity) {
+        if (guide->stagedOffset == guide->stagedLength) {
+            guide->stagedOffset = 0;
+            guide->stagedLength = BenchWriteGuide(guide, guide->staged, sizeof(guide->staged));
+            if (guide->stagedLength == 0) {
+                break;
+            }
+        }
+        size_t step = guide->stagedLength - guide->stagedOffset;
+        if (step > capacity - used) {
+            step = capacity - used;
+        }
+        memcpy(out + used, guide->staged + guide->stagedOffset, step);
+        guide->stagedOffset += step;
+        used += step;
+    }
+    return used;
+}
+
+#endif /* xmltv_synthetic_guide_h */
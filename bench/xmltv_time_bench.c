@@ -0,0 +1,67 @@
+//
+//  xmltv_time_bench.c
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  Nanoseconds per timestamp for VLCXMLTVParseTime against the formatter path it replaced
+//  (xmltv_time_reference.h), over the start and stop times of a generated guide. Both must
+//  decode every timestamp to the same second.
+//
+//  xmltv_time_bench [--timestamps N]
+//
+
+#include "bench_support.h"
+#include "VLCXMLTVParser.h"
+#include "xmltv_time_reference.h"
+
+#define BENCH_TIMESTAMP_LENGTH 20
+
+int main(int argc, char **argv) {
+    size_t count = 2000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--timestamps") == 0) {
+            count = strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    BenchCheck(count > 0, "--timestamps must be positive");
+
+    // Half-hour slots across a few years with the offsets real guides carry
+    static const char *offsets[] = { "+0000", "+0100", "+0200", "+0300", "-0500", "+0530", "-0330", "+1000" };
+    char *timestamps = malloc(count * (BENCH_TIMESTAMP_LENGTH + 1));
+    uint64_t seed = 42;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t random = BenchRandom(&seed);
+        time_t slot = (time_t)1700000000 + (time_t)(i % 100000) * 1800;
+        struct tm fields;
+        gmtime_r(&slot, &fields);
+        char *timestamp = timestamps + i * (BENCH_TIMESTAMP_LENGTH + 1);
+        strftime(timestamp, BENCH_TIMESTAMP_LENGTH + 1, "%Y%m%d%H%M%S ", &fields);
+        memcpy(timestamp + 15, offsets[random % 8], 6);
+    }
+
+    int64_t decodedSum = 0;
+    double start = BenchNow();
+    for (size_t i = 0; i < count; i++) {
+        int64_t seconds = 0;
+        BenchCheck(VLCXMLTVParseTime(timestamps + i * (BENCH_TIMESTAMP_LENGTH + 1), BENCH_TIMESTAMP_LENGTH, &seconds),
+                   "timestamp %zu rejected", i);
+        decodedSum += seconds;
+    }
+    double decoderSeconds = BenchNow() - start;
+
+    int64_t formatterSum = 0;
+    start = BenchNow();
+    for (size_t i = 0; i < count; i++) {
+        int64_t seconds = 0;
+        BenchCheck(BenchFormatterTime(timestamps + i * (BENCH_TIMESTAMP_LENGTH + 1), BENCH_TIMESTAMP_LENGTH, &seconds),
+                   "timestamp %zu rejected by the formatter", i);
+        formatterSum += seconds;
+    }
+    double formatterSeconds = BenchNow() - start;
+
+    printf("decoder   %zu timestamps in %.3f s: %.1f ns each\n", count, decoderSeconds, decoderSeconds * 1e9 / (double)count);
+    printf("formatter %zu timestamps in %.3f s: %.1f ns each (%.1fx the decoder)\n", count, formatterSeconds,
+           formatterSeconds * 1e9 / (double)count, decoderSeconds > 0 ? formatterSeconds / decoderSeconds : 0.0);
+    BenchCheck(decodedSum == formatterSum, "the decoder and the formatter disagree");
+    free(timestamps);
+    return 0;
+}
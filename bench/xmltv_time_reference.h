@@ -0,0 +1,66 @@
+//
+//  xmltv_time_reference.h
+//  BasicPlayerWithPlaylist benchmarks
+//
+//  parseXMLTVTime: as it was before VLCXMLTVParseTime, in C: the first 14 characters through a
+//  strict yyyyMMddHHmmss formatter in UTC, then a "+HHMM" offset read from index 15. The fuzz
+//  target compares against it and the micro-benchmark times it.
+//
+
+#ifndef xmltv_time_reference_h
+#define xmltv_time_reference_h
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static inline int BenchFormatterTime(const char *bytes, size_t length, int64_t *epochSeconds) {
+    if (length < 14) {
+        return 0;
+    }
+    // substringToIndex:14
+    char date[15];
+    memcpy(date, bytes, 14);
+    date[14] = '\0';
+    for (size_t i = 0; i < 14; i++) {
+        if (!isdigit((unsigned char)date[i])) {
+            return 0;
+        }
+    }
+    int year, month, day, hour, minute, second;
+    sscanf(date, "%4d%2d%2d%2d%2d%2d", &year, &month, &day, &hour, &minute, &second);
+    struct tm fields;
+    memset(&fields, 0, sizeof(fields));
+    fields.tm_year = year - 1900;
+    fields.tm_mon = month - 1;
+    fields.tm_mday = day;
+    fields.tm_hour = hour;
+    fields.tm_min = minute;
+    fields.tm_sec = second;
+    time_t seconds = timegm(&fields);
+
+    // The formatter is not lenient: 30 February is no date at all rather than 2 March
+    struct tm check;
+    if (!gmtime_r(&seconds, &check) || check.tm_year != year - 1900 || check.tm_mon != month - 1 ||
+        check.tm_mday != day || check.tm_hour != hour || check.tm_min != minute || check.tm_sec != second) {
+        return 0;
+    }
+
+    int64_t offset = 0;
+    if (length > 15 && length - 15 >= 5) {
+        const char *zone = bytes + 15;
+        char hours[3] = { zone[1], zone[2], '\0' };
+        char minutes[3] = { zone[3], zone[4], '\0' };
+        offset = (int64_t)atoi(hours) * 3600 + (int64_t)atoi(minutes) * 60;
+        if (zone[0] == '-') {
+            offset = -offset;
+        }
+    }
+    *epochSeconds = (int64_t)seconds - offset;
+    return 1;
+}
+
+#endif /* xmltv_time_reference_h */